@@ -2,13 +2,23 @@
 //!
 //! Compares:
 //! 1. Direct Fortran BLAS call (baseline)
-//! 2. cblas-trampoline call (measures overhead)
-//! 3. Pure Rust implementation (for reference)
+//! 2. Simulated trampoline (a bare function pointer indirection)
+//! 3. cblas-inject before `cblas_inject_finalize` (per-call provider lookup)
+//! 4. cblas-inject after `cblas_inject_finalize` (frozen dispatch table)
+//! 5. cblas-inject with the native BLAS Level 1 kernels enabled for every `n`
+//! 6. Pure Rust implementation (for reference)
 
-use std::ffi::c_char;
+use std::ffi::c_void;
 use std::hint::black_box;
 use std::time::{Duration, Instant};
 
+use cblas_inject::{
+    cblas_daxpy, cblas_ddot, cblas_dnrm2, cblas_dscal, cblas_inject_finalize,
+    cblas_inject_register_daxpy_lp64, cblas_inject_register_ddot_lp64,
+    cblas_inject_register_dnrm2_lp64, cblas_inject_register_dscal_lp64,
+    cblas_inject_set_native_blas1_max_n, CBLAS_INJECT_STATUS_OK,
+};
+
 // Link against OpenBLAS
 #[link(name = "openblas")]
 extern "C" {
@@ -33,15 +43,6 @@ extern "C" {
     fn dnrm2_(n: *const i32, x: *const f64, incx: *const i32) -> f64;
 
     fn dscal_(n: *const i32, alpha: *const f64, x: *mut f64, incx: *const i32);
-
-    // CBLAS (for comparison)
-    fn cblas_daxpy(n: i32, alpha: f64, x: *const f64, incx: i32, y: *mut f64, incy: i32);
-
-    fn cblas_ddot(n: i32, x: *const f64, incx: i32, y: *const f64, incy: i32) -> f64;
-
-    fn cblas_dnrm2(n: i32, x: *const f64, incx: i32) -> f64;
-
-    fn cblas_dscal(n: i32, alpha: f64, x: *mut f64, incx: i32);
 }
 
 // Trampoline types matching cblas-trampoline
@@ -122,7 +123,7 @@ fn rust_dscal(n: usize, alpha: f64, x: &mut [f64]) {
     }
 }
 
-fn benchmark<F>(name: &str, iterations: usize, mut f: F) -> Duration
+fn benchmark<F>(iterations: usize, mut f: F) -> Duration
 where
     F: FnMut(),
 {
@@ -135,34 +136,135 @@ where
     for _ in 0..iterations {
         f();
     }
-    let elapsed = start.elapsed();
+    start.elapsed()
+}
+
+fn per_call_ns(elapsed: Duration, iterations: usize) -> f64 {
+    elapsed.as_nanos() as f64 / iterations as f64
+}
+
+fn test_vectors(n: usize) -> (Vec<f64>, Vec<f64>) {
+    let x: Vec<f64> = (0..n).map(|i| i as f64 * 0.001).collect();
+    let y: Vec<f64> = (0..n).map(|i| (n - i) as f64 * 0.001).collect();
+    (x, y)
+}
 
-    elapsed
+/// Per-call times of the cblas-inject entry points, in `[daxpy, ddot, dnrm2, dscal]` order.
+fn measure_cblas_inject(n: usize, iterations: usize) -> [f64; 4] {
+    let (x, y) = test_vectors(n);
+    let alpha = 2.5;
+    let n_i32 = n as i32;
+    let inc: i32 = 1;
+
+    let mut y_copy = y.clone();
+    let daxpy = benchmark(iterations, || unsafe {
+        cblas_daxpy(n_i32, alpha, x.as_ptr(), inc, y_copy.as_mut_ptr(), inc);
+        black_box(&y_copy);
+    });
+    let ddot = benchmark(iterations, || unsafe {
+        black_box(cblas_ddot(n_i32, x.as_ptr(), inc, y.as_ptr(), inc));
+    });
+    let dnrm2 = benchmark(iterations, || unsafe {
+        black_box(cblas_dnrm2(n_i32, x.as_ptr(), inc));
+    });
+    let mut x_copy = x.clone();
+    let dscal = benchmark(iterations, || unsafe {
+        cblas_dscal(n_i32, alpha, x_copy.as_mut_ptr(), inc);
+        black_box(&x_copy);
+    });
+
+    [
+        per_call_ns(daxpy, iterations),
+        per_call_ns(ddot, iterations),
+        per_call_ns(dnrm2, iterations),
+        per_call_ns(dscal, iterations),
+    ]
+}
+
+fn print_row(label: &str, direct_ns: f64, trampoline_ns: f64, inject: [f64; 3], rust_ns: f64) {
+    let [unfrozen_ns, frozen_ns, native_ns] = inject;
+    println!(
+        "  {label:<6} direct={direct_ns:.1}ns, trampoline={trampoline_ns:.1}ns, \
+         inject={unfrozen_ns:.1}ns, frozen={frozen_ns:.1}ns, native={native_ns:.1}ns, \
+         rust={rust_ns:.1}ns"
+    );
+    println!(
+        "         overhead: trampoline={:.1}%, inject={:.1}%, frozen={:.1}%, native={:.1}%",
+        (trampoline_ns - direct_ns) / direct_ns * 100.0,
+        (unfrozen_ns - direct_ns) / direct_ns * 100.0,
+        (frozen_ns - direct_ns) / direct_ns * 100.0,
+        (native_ns - direct_ns) / direct_ns * 100.0
+    );
 }
 
 fn main() {
-    // Initialize trampoline pointers
+    // Initialize trampoline pointers and register the same OpenBLAS symbols
+    // with cblas-inject.
     unsafe {
         DAXPY_PTR = Some(std::mem::transmute(daxpy_ as *const ()));
         DDOT_PTR = Some(std::mem::transmute(ddot_ as *const ()));
         DNRM2_PTR = Some(std::mem::transmute(dnrm2_ as *const ()));
         DSCAL_PTR = Some(std::mem::transmute(dscal_ as *const ()));
+
+        assert_eq!(
+            cblas_inject_register_daxpy_lp64(daxpy_ as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(
+            cblas_inject_register_ddot_lp64(ddot_ as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(
+            cblas_inject_register_dnrm2_lp64(dnrm2_ as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(
+            cblas_inject_register_dscal_lp64(dscal_ as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
     }
 
     let sizes = [10, 100, 1000, 10000, 100000, 1000000];
     let iterations = 10000;
 
+    // Finalizing is one-way, so measure every size before and then after it.
+    let unfrozen: Vec<[f64; 4]> = sizes
+        .iter()
+        .map(|&n| measure_cblas_inject(n, iterations))
+        .collect();
+    assert_eq!(cblas_inject_finalize(), CBLAS_INJECT_STATUS_OK);
+    let frozen: Vec<[f64; 4]> = sizes
+        .iter()
+        .map(|&n| measure_cblas_inject(n, iterations))
+        .collect();
+    assert_eq!(
+        cblas_inject_set_native_blas1_max_n(i64::MAX),
+        CBLAS_INJECT_STATUS_OK
+    );
+    let native: Vec<[f64; 4]> = sizes
+        .iter()
+        .map(|&n| measure_cblas_inject(n, iterations))
+        .collect();
+
     println!("BLAS Level 1 Trampoline Overhead Benchmark");
     println!("==========================================");
     println!("Iterations per measurement: {}", iterations);
+    println!("inject = cblas-inject before cblas_inject_finalize(), frozen = after");
+    println!("native = cblas-inject with the built-in kernels for every n");
     println!();
 
-    for &n in &sizes {
-        let mut x: Vec<f64> = (0..n).map(|i| i as f64 * 0.001).collect();
-        let mut y: Vec<f64> = (0..n).map(|i| (n - i) as f64 * 0.001).collect();
+    for (idx, &n) in sizes.iter().enumerate() {
+        let (x, y) = test_vectors(n);
         let alpha = 2.5;
         let n_i32 = n as i32;
         let inc: i32 = 1;
+        let inject = |routine: usize| {
+            [
+                unfrozen[idx][routine],
+                frozen[idx][routine],
+                native[idx][routine],
+            ]
+        };
 
         println!("n = {}", n);
         println!("---------");
@@ -170,160 +272,104 @@ fn main() {
         // DAXPY benchmark
         {
             let mut y_copy = y.clone();
-            let direct = benchmark("direct", iterations, || unsafe {
+            let direct = benchmark(iterations, || unsafe {
                 daxpy_(&n_i32, &alpha, x.as_ptr(), &inc, y_copy.as_mut_ptr(), &inc);
                 black_box(&y_copy);
             });
 
             y_copy = y.clone();
-            let cblas = benchmark("cblas", iterations, || unsafe {
-                cblas_daxpy(n_i32, alpha, x.as_ptr(), inc, y_copy.as_mut_ptr(), inc);
-                black_box(&y_copy);
-            });
-
-            y_copy = y.clone();
-            let trampoline = benchmark("trampoline", iterations, || unsafe {
+            let trampoline = benchmark(iterations, || unsafe {
                 trampoline_daxpy(n_i32, alpha, x.as_ptr(), inc, y_copy.as_mut_ptr(), inc);
                 black_box(&y_copy);
             });
 
             y_copy = y.clone();
-            let rust = benchmark("rust", iterations, || {
+            let rust = benchmark(iterations, || {
                 rust_daxpy(n, alpha, &x, &mut y_copy);
                 black_box(&y_copy);
             });
 
-            let direct_ns = direct.as_nanos() as f64 / iterations as f64;
-            let cblas_ns = cblas.as_nanos() as f64 / iterations as f64;
-            let trampoline_ns = trampoline.as_nanos() as f64 / iterations as f64;
-            let rust_ns = rust.as_nanos() as f64 / iterations as f64;
-
-            println!(
-                "  DAXPY: direct={:.1}ns, cblas={:.1}ns, trampoline={:.1}ns, rust={:.1}ns",
-                direct_ns, cblas_ns, trampoline_ns, rust_ns
-            );
-            println!(
-                "         overhead: cblas={:.1}%, trampoline={:.1}%",
-                (cblas_ns - direct_ns) / direct_ns * 100.0,
-                (trampoline_ns - direct_ns) / direct_ns * 100.0
+            print_row(
+                "DAXPY:",
+                per_call_ns(direct, iterations),
+                per_call_ns(trampoline, iterations),
+                inject(0),
+                per_call_ns(rust, iterations),
             );
         }
 
         // DDOT benchmark
         {
-            let direct = benchmark("direct", iterations, || unsafe {
-                let result = ddot_(&n_i32, x.as_ptr(), &inc, y.as_ptr(), &inc);
-                black_box(result);
+            let direct = benchmark(iterations, || unsafe {
+                black_box(ddot_(&n_i32, x.as_ptr(), &inc, y.as_ptr(), &inc));
             });
 
-            let cblas = benchmark("cblas", iterations, || unsafe {
-                let result = cblas_ddot(n_i32, x.as_ptr(), inc, y.as_ptr(), inc);
-                black_box(result);
+            let trampoline = benchmark(iterations, || unsafe {
+                black_box(trampoline_ddot(n_i32, x.as_ptr(), inc, y.as_ptr(), inc));
             });
 
-            let trampoline = benchmark("trampoline", iterations, || unsafe {
-                let result = trampoline_ddot(n_i32, x.as_ptr(), inc, y.as_ptr(), inc);
-                black_box(result);
+            let rust = benchmark(iterations, || {
+                black_box(rust_ddot(n, &x, &y));
             });
 
-            let rust = benchmark("rust", iterations, || {
-                let result = rust_ddot(n, &x, &y);
-                black_box(result);
-            });
-
-            let direct_ns = direct.as_nanos() as f64 / iterations as f64;
-            let cblas_ns = cblas.as_nanos() as f64 / iterations as f64;
-            let trampoline_ns = trampoline.as_nanos() as f64 / iterations as f64;
-            let rust_ns = rust.as_nanos() as f64 / iterations as f64;
-
-            println!(
-                "  DDOT:  direct={:.1}ns, cblas={:.1}ns, trampoline={:.1}ns, rust={:.1}ns",
-                direct_ns, cblas_ns, trampoline_ns, rust_ns
-            );
-            println!(
-                "         overhead: cblas={:.1}%, trampoline={:.1}%",
-                (cblas_ns - direct_ns) / direct_ns * 100.0,
-                (trampoline_ns - direct_ns) / direct_ns * 100.0
+            print_row(
+                "DDOT:",
+                per_call_ns(direct, iterations),
+                per_call_ns(trampoline, iterations),
+                inject(1),
+                per_call_ns(rust, iterations),
             );
         }
 
         // DNRM2 benchmark
         {
-            let direct = benchmark("direct", iterations, || unsafe {
-                let result = dnrm2_(&n_i32, x.as_ptr(), &inc);
-                black_box(result);
-            });
-
-            let cblas = benchmark("cblas", iterations, || unsafe {
-                let result = cblas_dnrm2(n_i32, x.as_ptr(), inc);
-                black_box(result);
+            let direct = benchmark(iterations, || unsafe {
+                black_box(dnrm2_(&n_i32, x.as_ptr(), &inc));
             });
 
-            let trampoline = benchmark("trampoline", iterations, || unsafe {
-                let result = trampoline_dnrm2(n_i32, x.as_ptr(), inc);
-                black_box(result);
+            let trampoline = benchmark(iterations, || unsafe {
+                black_box(trampoline_dnrm2(n_i32, x.as_ptr(), inc));
             });
 
-            let rust = benchmark("rust", iterations, || {
-                let result = rust_dnrm2(n, &x);
-                black_box(result);
+            let rust = benchmark(iterations, || {
+                black_box(rust_dnrm2(n, &x));
             });
 
-            let direct_ns = direct.as_nanos() as f64 / iterations as f64;
-            let cblas_ns = cblas.as_nanos() as f64 / iterations as f64;
-            let trampoline_ns = trampoline.as_nanos() as f64 / iterations as f64;
-            let rust_ns = rust.as_nanos() as f64 / iterations as f64;
-
-            println!(
-                "  DNRM2: direct={:.1}ns, cblas={:.1}ns, trampoline={:.1}ns, rust={:.1}ns",
-                direct_ns, cblas_ns, trampoline_ns, rust_ns
-            );
-            println!(
-                "         overhead: cblas={:.1}%, trampoline={:.1}%",
-                (cblas_ns - direct_ns) / direct_ns * 100.0,
-                (trampoline_ns - direct_ns) / direct_ns * 100.0
+            print_row(
+                "DNRM2:",
+                per_call_ns(direct, iterations),
+                per_call_ns(trampoline, iterations),
+                inject(2),
+                per_call_ns(rust, iterations),
             );
         }
 
         // DSCAL benchmark
         {
             let mut x_copy = x.clone();
-            let direct = benchmark("direct", iterations, || unsafe {
+            let direct = benchmark(iterations, || unsafe {
                 dscal_(&n_i32, &alpha, x_copy.as_mut_ptr(), &inc);
                 black_box(&x_copy);
             });
 
             x_copy = x.clone();
-            let cblas = benchmark("cblas", iterations, || unsafe {
-                cblas_dscal(n_i32, alpha, x_copy.as_mut_ptr(), inc);
-                black_box(&x_copy);
-            });
-
-            x_copy = x.clone();
-            let trampoline = benchmark("trampoline", iterations, || unsafe {
+            let trampoline = benchmark(iterations, || unsafe {
                 trampoline_dscal(n_i32, alpha, x_copy.as_mut_ptr(), inc);
                 black_box(&x_copy);
             });
 
             x_copy = x.clone();
-            let rust = benchmark("rust", iterations, || {
+            let rust = benchmark(iterations, || {
                 rust_dscal(n, alpha, &mut x_copy);
                 black_box(&x_copy);
             });
 
-            let direct_ns = direct.as_nanos() as f64 / iterations as f64;
-            let cblas_ns = cblas.as_nanos() as f64 / iterations as f64;
-            let trampoline_ns = trampoline.as_nanos() as f64 / iterations as f64;
-            let rust_ns = rust.as_nanos() as f64 / iterations as f64;
-
-            println!(
-                "  DSCAL: direct={:.1}ns, cblas={:.1}ns, trampoline={:.1}ns, rust={:.1}ns",
-                direct_ns, cblas_ns, trampoline_ns, rust_ns
-            );
-            println!(
-                "         overhead: cblas={:.1}%, trampoline={:.1}%",
-                (cblas_ns - direct_ns) / direct_ns * 100.0,
-                (trampoline_ns - direct_ns) / direct_ns * 100.0
+            print_row(
+                "DSCAL:",
+                per_call_ns(direct, iterations),
+                per_call_ns(trampoline, iterations),
+                inject(3),
+                per_call_ns(rust, iterations),
             );
         }
 
@@ -0,0 +1,550 @@
+//! Dispatch overhead of every exported `cblas_*` and `cblas_*_64` entry point.
+//!
+//! Every routine slot is registered with a provider that returns at once, and
+//! each entry point is called at the smallest non-trivial size (n = 1, unit
+//! increments and leading dimensions, column-major, alpha = beta = 1) so the
+//! time is that of the dispatch layer alone. Each configuration runs in a
+//! child process, because providers can only be registered once:
+//!
+//! - `lp64`: LP64 provider. `cblas_*` passes the integers through and
+//!   `cblas_*_64` narrows them with range checks.
+//! - `ilp64`: ILP64 provider only, so `cblas_*` takes the widening fallback
+//!   of `get_*_for_lp64_cblas` and `cblas_*_64` passes through.
+//! - `lp64-hidden` / `ilp64-hidden`: the complex dot products again, with
+//!   the hidden-argument return convention.
+//!
+//! Every configuration is timed before and after `cblas_inject_finalize`.
+//! `overhead` is the time per call minus that of calling the same no-op
+//! through a plain function pointer.
+//!
+//! ```text
+//! cargo bench --bench dispatch_overhead            # table
+//! cargo bench --bench dispatch_overhead -- --csv   # CSV on stdout
+//! ```
+//!
+//! CSV columns: `routine,provider,style,entry,frozen,ns_per_call,overhead_ns`.
+//! `CBLAS_INJECT_BENCH_MIN_MS` sets the minimum measuring time per entry
+//! point (default 2). The bench exits with status 1 when any overhead exceeds
+//! `CBLAS_INJECT_BENCH_BUDGET_NS` (default 200), listing the offenders, so it
+//! can gate changes to the dispatch layer.
+
+use std::hint::black_box;
+use std::process::Command;
+use std::ptr::addr_of_mut;
+use std::time::{Duration, Instant};
+
+use cblas_inject::*;
+use num_complex::{Complex32, Complex64};
+
+/// Selects the configuration of a child process.
+const CHILD_ENV: &str = "CBLAS_INJECT_BENCH_DISPATCH_CHILD";
+const CONFIGS: [&str; 4] = ["lp64", "ilp64", "lp64-hidden", "ilp64-hidden"];
+const COMPLEX_DOTS: [&str; 4] = ["cdotu_sub", "zdotu_sub", "cdotc_sub", "zdotc_sub"];
+const DEFAULT_BUDGET_NS: f64 = 200.0;
+
+const COL: CBLAS_ORDER = CblasColMajor;
+const NT: CBLAS_TRANSPOSE = CblasNoTrans;
+const UP: CBLAS_UPLO = CblasUpper;
+const NU: CBLAS_DIAG = CblasNonUnit;
+const LEFT: CBLAS_SIDE = CblasLeft;
+
+/// The provider of every routine. It reads no arguments and writes nothing,
+/// so under the C calling convention of the supported targets it stands in
+/// for any Fortran BLAS signature; the value-returning dots and norms just
+/// get an unspecified result, which is never checked.
+extern "C" fn noop() {}
+
+// Operands: a few elements of ones per type, shared by every argument.
+static mut S: [f32; 8] = [1.0; 8];
+static mut D: [f64; 8] = [1.0; 8];
+static mut C: [Complex32; 8] = [Complex32::new(1.0, 0.0); 8];
+static mut Z: [Complex64; 8] = [Complex64::new(1.0, 0.0); 8];
+
+/// A pointer argument of any element type.
+trait Operand {
+    fn operand() -> Self;
+}
+
+macro_rules! impl_operand {
+    ($($t:ty => $buf:ident),*) => {$(
+        impl Operand for *const $t {
+            fn operand() -> Self {
+                addr_of_mut!($buf).cast()
+            }
+        }
+
+        impl Operand for *mut $t {
+            fn operand() -> Self {
+                addr_of_mut!($buf).cast()
+            }
+        }
+    )*};
+}
+
+impl_operand!(f32 => S, f64 => D, Complex32 => C, Complex64 => Z);
+
+fn p<P: Operand>() -> P {
+    P::operand()
+}
+
+struct Routine {
+    name: &'static str,
+    lp64: fn(),
+    ilp64: Option<fn()>,
+}
+
+/// One [`Routine`] per `cblas_<name>` / `cblas_<name>_64` pair; the same
+/// argument list serves both, the integer literals taking either width.
+macro_rules! routines {
+    ($($name:ident($($arg:expr),* $(,)?);)*) => {
+        paste::paste! {
+            const ROUTINES: &[Routine] = &[$(Routine {
+                name: stringify!($name),
+                lp64: || unsafe {
+                    black_box([<cblas_ $name>]($($arg),*));
+                },
+                ilp64: Some(|| unsafe {
+                    black_box([<cblas_ $name _64>]($($arg),*));
+                }),
+            },)*];
+        }
+    };
+}
+
+/// Routines without integer arguments, which have no `_64` symbol.
+macro_rules! lp64_only_routines {
+    ($($name:ident($($arg:expr),* $(,)?);)*) => {
+        paste::paste! {
+            const LP64_ONLY_ROUTINES: &[Routine] = &[$(Routine {
+                name: stringify!($name),
+                lp64: || unsafe {
+                    black_box([<cblas_ $name>]($($arg),*));
+                },
+                ilp64: None,
+            },)*];
+        }
+    };
+}
+
+routines! {
+    sdot(1, p(), 1, p(), 1);
+    ddot(1, p(), 1, p(), 1);
+    cdotu_sub(1, p(), 1, p(), 1, p());
+    zdotu_sub(1, p(), 1, p(), 1, p());
+    cdotc_sub(1, p(), 1, p(), 1, p());
+    zdotc_sub(1, p(), 1, p(), 1, p());
+    sdsdot(1, 1.0, p(), 1, p(), 1);
+    dsdot(1, p(), 1, p(), 1);
+    snrm2(1, p(), 1);
+    dnrm2(1, p(), 1);
+    scnrm2(1, p(), 1);
+    dznrm2(1, p(), 1);
+    sasum(1, p(), 1);
+    dasum(1, p(), 1);
+    scasum(1, p(), 1);
+    dzasum(1, p(), 1);
+    isamax(1, p(), 1);
+    idamax(1, p(), 1);
+    icamax(1, p(), 1);
+    izamax(1, p(), 1);
+    drot(1, p(), 1, p(), 1, 1.0, 1.0);
+    srot(1, p(), 1, p(), 1, 1.0, 1.0);
+    drotm(1, p(), 1, p(), 1, p());
+    srotm(1, p(), 1, p(), 1, p());
+    sswap(1, p(), 1, p(), 1);
+    dswap(1, p(), 1, p(), 1);
+    cswap(1, p(), 1, p(), 1);
+    zswap(1, p(), 1, p(), 1);
+    scopy(1, p(), 1, p(), 1);
+    dcopy(1, p(), 1, p(), 1);
+    ccopy(1, p(), 1, p(), 1);
+    zcopy(1, p(), 1, p(), 1);
+    saxpy(1, 1.0, p(), 1, p(), 1);
+    daxpy(1, 1.0, p(), 1, p(), 1);
+    caxpy(1, p(), p(), 1, p(), 1);
+    zaxpy(1, p(), p(), 1, p(), 1);
+    saxpby(1, 1.0, p(), 1, 1.0, p(), 1);
+    daxpby(1, 1.0, p(), 1, 1.0, p(), 1);
+    caxpby(1, p(), p(), 1, p(), p(), 1);
+    zaxpby(1, p(), p(), 1, p(), p(), 1);
+    sscal(1, 1.0, p(), 1);
+    dscal(1, 1.0, p(), 1);
+    cscal(1, p(), p(), 1);
+    zscal(1, p(), p(), 1);
+    csscal(1, 1.0, p(), 1);
+    zdscal(1, 1.0, p(), 1);
+    sgbmv(COL, NT, 1, 1, 0, 0, 1.0, p(), 1, p(), 1, 1.0, p(), 1);
+    dgbmv(COL, NT, 1, 1, 0, 0, 1.0, p(), 1, p(), 1, 1.0, p(), 1);
+    cgbmv(COL, NT, 1, 1, 0, 0, p(), p(), 1, p(), 1, p(), p(), 1);
+    zgbmv(COL, NT, 1, 1, 0, 0, p(), p(), 1, p(), 1, p(), p(), 1);
+    sgemv(COL, NT, 1, 1, 1.0, p(), 1, p(), 1, 1.0, p(), 1);
+    dgemv(COL, NT, 1, 1, 1.0, p(), 1, p(), 1, 1.0, p(), 1);
+    cgemv(COL, NT, 1, 1, p(), p(), 1, p(), 1, p(), p(), 1);
+    zgemv(COL, NT, 1, 1, p(), p(), 1, p(), 1, p(), p(), 1);
+    sger(COL, 1, 1, 1.0, p(), 1, p(), 1, p(), 1);
+    dger(COL, 1, 1, 1.0, p(), 1, p(), 1, p(), 1);
+    cgeru(COL, 1, 1, p(), p(), 1, p(), 1, p(), 1);
+    zgeru(COL, 1, 1, p(), p(), 1, p(), 1, p(), 1);
+    cgerc(COL, 1, 1, p(), p(), 1, p(), 1, p(), 1);
+    zgerc(COL, 1, 1, p(), p(), 1, p(), 1, p(), 1);
+    ssbmv(COL, UP, 1, 0, 1.0, p(), 1, p(), 1, 1.0, p(), 1);
+    dsbmv(COL, UP, 1, 0, 1.0, p(), 1, p(), 1, 1.0, p(), 1);
+    chbmv(COL, UP, 1, 0, p(), p(), 1, p(), 1, p(), p(), 1);
+    zhbmv(COL, UP, 1, 0, p(), p(), 1, p(), 1, p(), p(), 1);
+    sspmv(COL, UP, 1, 1.0, p(), p(), 1, 1.0, p(), 1);
+    dspmv(COL, UP, 1, 1.0, p(), p(), 1, 1.0, p(), 1);
+    chpmv(COL, UP, 1, p(), p(), p(), 1, p(), p(), 1);
+    zhpmv(COL, UP, 1, p(), p(), p(), 1, p(), p(), 1);
+    sspr(COL, UP, 1, 1.0, p(), 1, p());
+    dspr(COL, UP, 1, 1.0, p(), 1, p());
+    chpr(COL, UP, 1, 1.0, p(), 1, p());
+    zhpr(COL, UP, 1, 1.0, p(), 1, p());
+    sspr2(COL, UP, 1, 1.0, p(), 1, p(), 1, p());
+    dspr2(COL, UP, 1, 1.0, p(), 1, p(), 1, p());
+    chpr2(COL, UP, 1, p(), p(), 1, p(), 1, p());
+    zhpr2(COL, UP, 1, p(), p(), 1, p(), 1, p());
+    ssymv(COL, UP, 1, 1.0, p(), 1, p(), 1, 1.0, p(), 1);
+    dsymv(COL, UP, 1, 1.0, p(), 1, p(), 1, 1.0, p(), 1);
+    chemv(COL, UP, 1, p(), p(), 1, p(), 1, p(), p(), 1);
+    zhemv(COL, UP, 1, p(), p(), 1, p(), 1, p(), p(), 1);
+    ssyr(COL, UP, 1, 1.0, p(), 1, p(), 1);
+    dsyr(COL, UP, 1, 1.0, p(), 1, p(), 1);
+    cher(COL, UP, 1, 1.0, p(), 1, p(), 1);
+    zher(COL, UP, 1, 1.0, p(), 1, p(), 1);
+    ssyr2(COL, UP, 1, 1.0, p(), 1, p(), 1, p(), 1);
+    dsyr2(COL, UP, 1, 1.0, p(), 1, p(), 1, p(), 1);
+    cher2(COL, UP, 1, p(), p(), 1, p(), 1, p(), 1);
+    zher2(COL, UP, 1, p(), p(), 1, p(), 1, p(), 1);
+    stbmv(COL, UP, NT, NU, 1, 0, p(), 1, p(), 1);
+    dtbmv(COL, UP, NT, NU, 1, 0, p(), 1, p(), 1);
+    ctbmv(COL, UP, NT, NU, 1, 0, p(), 1, p(), 1);
+    ztbmv(COL, UP, NT, NU, 1, 0, p(), 1, p(), 1);
+    stbsv(COL, UP, NT, NU, 1, 0, p(), 1, p(), 1);
+    dtbsv(COL, UP, NT, NU, 1, 0, p(), 1, p(), 1);
+    ctbsv(COL, UP, NT, NU, 1, 0, p(), 1, p(), 1);
+    ztbsv(COL, UP, NT, NU, 1, 0, p(), 1, p(), 1);
+    stpmv(COL, UP, NT, NU, 1, p(), p(), 1);
+    dtpmv(COL, UP, NT, NU, 1, p(), p(), 1);
+    ctpmv(COL, UP, NT, NU, 1, p(), p(), 1);
+    ztpmv(COL, UP, NT, NU, 1, p(), p(), 1);
+    stpsv(COL, UP, NT, NU, 1, p(), p(), 1);
+    dtpsv(COL, UP, NT, NU, 1, p(), p(), 1);
+    ctpsv(COL, UP, NT, NU, 1, p(), p(), 1);
+    ztpsv(COL, UP, NT, NU, 1, p(), p(), 1);
+    strmv(COL, UP, NT, NU, 1, p(), 1, p(), 1);
+    dtrmv(COL, UP, NT, NU, 1, p(), 1, p(), 1);
+    ctrmv(COL, UP, NT, NU, 1, p(), 1, p(), 1);
+    ztrmv(COL, UP, NT, NU, 1, p(), 1, p(), 1);
+    strsv(COL, UP, NT, NU, 1, p(), 1, p(), 1);
+    dtrsv(COL, UP, NT, NU, 1, p(), 1, p(), 1);
+    ctrsv(COL, UP, NT, NU, 1, p(), 1, p(), 1);
+    ztrsv(COL, UP, NT, NU, 1, p(), 1, p(), 1);
+    dgemm(COL, NT, NT, 1, 1, 1, 1.0, p(), 1, p(), 1, 1.0, p(), 1);
+    sgemm(COL, NT, NT, 1, 1, 1, 1.0, p(), 1, p(), 1, 1.0, p(), 1);
+    zgemm(COL, NT, NT, 1, 1, 1, p(), p(), 1, p(), 1, p(), p(), 1);
+    cgemm(COL, NT, NT, 1, 1, 1, p(), p(), 1, p(), 1, p(), p(), 1);
+    cgemm3m(COL, NT, NT, 1, 1, 1, p(), p(), 1, p(), 1, p(), p(), 1);
+    zgemm3m(COL, NT, NT, 1, 1, 1, p(), p(), 1, p(), 1, p(), p(), 1);
+    chemm(COL, LEFT, UP, 1, 1, p(), p(), 1, p(), 1, p(), p(), 1);
+    zhemm(COL, LEFT, UP, 1, 1, p(), p(), 1, p(), 1, p(), p(), 1);
+    cher2k(COL, UP, NT, 1, 1, p(), p(), 1, p(), 1, 1.0, p(), 1);
+    zher2k(COL, UP, NT, 1, 1, p(), p(), 1, p(), 1, 1.0, p(), 1);
+    cherk(COL, UP, NT, 1, 1, 1.0, p(), 1, 1.0, p(), 1);
+    zherk(COL, UP, NT, 1, 1, 1.0, p(), 1, 1.0, p(), 1);
+    dsymm(COL, LEFT, UP, 1, 1, 1.0, p(), 1, p(), 1, 1.0, p(), 1);
+    ssymm(COL, LEFT, UP, 1, 1, 1.0, p(), 1, p(), 1, 1.0, p(), 1);
+    csymm(COL, LEFT, UP, 1, 1, p(), p(), 1, p(), 1, p(), p(), 1);
+    zsymm(COL, LEFT, UP, 1, 1, p(), p(), 1, p(), 1, p(), p(), 1);
+    dsyr2k(COL, UP, NT, 1, 1, 1.0, p(), 1, p(), 1, 1.0, p(), 1);
+    ssyr2k(COL, UP, NT, 1, 1, 1.0, p(), 1, p(), 1, 1.0, p(), 1);
+    csyr2k(COL, UP, NT, 1, 1, p(), p(), 1, p(), 1, p(), p(), 1);
+    zsyr2k(COL, UP, NT, 1, 1, p(), p(), 1, p(), 1, p(), p(), 1);
+    dsyrk(COL, UP, NT, 1, 1, 1.0, p(), 1, 1.0, p(), 1);
+    ssyrk(COL, UP, NT, 1, 1, 1.0, p(), 1, 1.0, p(), 1);
+    csyrk(COL, UP, NT, 1, 1, p(), p(), 1, p(), p(), 1);
+    zsyrk(COL, UP, NT, 1, 1, p(), p(), 1, p(), p(), 1);
+    dtrmm(COL, LEFT, UP, NT, NU, 1, 1, 1.0, p(), 1, p(), 1);
+    strmm(COL, LEFT, UP, NT, NU, 1, 1, 1.0, p(), 1, p(), 1);
+    ctrmm(COL, LEFT, UP, NT, NU, 1, 1, p(), p(), 1, p(), 1);
+    ztrmm(COL, LEFT, UP, NT, NU, 1, 1, p(), p(), 1, p(), 1);
+    dtrsm(COL, LEFT, UP, NT, NU, 1, 1, 1.0, p(), 1, p(), 1);
+    strsm(COL, LEFT, UP, NT, NU, 1, 1, 1.0, p(), 1, p(), 1);
+    ctrsm(COL, LEFT, UP, NT, NU, 1, 1, p(), p(), 1, p(), 1);
+    ztrsm(COL, LEFT, UP, NT, NU, 1, 1, p(), p(), 1, p(), 1);
+    sgemmt(COL, UP, NT, NT, 1, 1, 1.0, p(), 1, p(), 1, 1.0, p(), 1);
+    dgemmt(COL, UP, NT, NT, 1, 1, 1.0, p(), 1, p(), 1, 1.0, p(), 1);
+    cgemmt(COL, UP, NT, NT, 1, 1, p(), p(), 1, p(), 1, p(), p(), 1);
+    zgemmt(COL, UP, NT, NT, 1, 1, p(), p(), 1, p(), 1, p(), p(), 1);
+    sgemm_batch_strided(COL, NT, NT, 1, 1, 1, 1.0, p(), 1, 1, p(), 1, 1, 1.0, p(), 1, 1, 1);
+    dgemm_batch_strided(COL, NT, NT, 1, 1, 1, 1.0, p(), 1, 1, p(), 1, 1, 1.0, p(), 1, 1, 1);
+    cgemm_batch_strided(COL, NT, NT, 1, 1, 1, p(), p(), 1, 1, p(), 1, 1, p(), p(), 1, 1, 1);
+    zgemm_batch_strided(COL, NT, NT, 1, 1, 1, p(), p(), 1, 1, p(), 1, 1, p(), p(), 1, 1, 1);
+    somatcopy(COL, NT, 1, 1, 1.0, p(), 1, p(), 1);
+    domatcopy(COL, NT, 1, 1, 1.0, p(), 1, p(), 1);
+    comatcopy(COL, NT, 1, 1, p(), p(), 1, p(), 1);
+    zomatcopy(COL, NT, 1, 1, p(), p(), 1, p(), 1);
+    simatcopy(COL, NT, 1, 1, 1.0, p(), 1, 1);
+    dimatcopy(COL, NT, 1, 1, 1.0, p(), 1, 1);
+    cimatcopy(COL, NT, 1, 1, p(), p(), 1, 1);
+    zimatcopy(COL, NT, 1, 1, p(), p(), 1, 1);
+    sgemm_batch(
+        COL, [NT].as_ptr(), [NT].as_ptr(), [1].as_ptr(), [1].as_ptr(), [1].as_ptr(),
+        p(), [p()].as_ptr(), [1].as_ptr(), [p()].as_ptr(), [1].as_ptr(),
+        p(), [p()].as_ptr(), [1].as_ptr(), 1, [1].as_ptr()
+    );
+    dgemm_batch(
+        COL, [NT].as_ptr(), [NT].as_ptr(), [1].as_ptr(), [1].as_ptr(), [1].as_ptr(),
+        p(), [p()].as_ptr(), [1].as_ptr(), [p()].as_ptr(), [1].as_ptr(),
+        p(), [p()].as_ptr(), [1].as_ptr(), 1, [1].as_ptr()
+    );
+    cgemm_batch(
+        COL, [NT].as_ptr(), [NT].as_ptr(), [1].as_ptr(), [1].as_ptr(), [1].as_ptr(),
+        p(), [p()].as_ptr(), [1].as_ptr(), [p()].as_ptr(), [1].as_ptr(),
+        p(), [p()].as_ptr(), [1].as_ptr(), 1, [1].as_ptr()
+    );
+    zgemm_batch(
+        COL, [NT].as_ptr(), [NT].as_ptr(), [1].as_ptr(), [1].as_ptr(), [1].as_ptr(),
+        p(), [p()].as_ptr(), [1].as_ptr(), [p()].as_ptr(), [1].as_ptr(),
+        p(), [p()].as_ptr(), [1].as_ptr(), 1, [1].as_ptr()
+    );
+}
+
+lp64_only_routines! {
+    drotg(p(), p(), p(), p());
+    srotg(p(), p(), p(), p());
+    drotmg(p(), p(), p(), 1.0, p());
+    srotmg(p(), p(), p(), 1.0, p());
+    dcabs1(p());
+    scabs1(p());
+}
+
+/// Mean time per call, doubling the batch until it runs for `min_time`.
+fn time_per_call(min_time: Duration, mut f: impl FnMut()) -> f64 {
+    f();
+    let mut iters = 1u64;
+    loop {
+        let start = Instant::now();
+        for _ in 0..iters {
+            f();
+        }
+        let elapsed = start.elapsed();
+        if elapsed >= min_time || iters >= 1 << 24 {
+            return elapsed.as_nanos() as f64 / iters as f64;
+        }
+        iters *= 2;
+    }
+}
+
+fn min_time() -> Duration {
+    Duration::from_millis(
+        std::env::var("CBLAS_INJECT_BENCH_MIN_MS")
+            .ok()
+            .and_then(|s| s.parse().ok())
+            .unwrap_or(2),
+    )
+}
+
+/// Register `noop` for every routine slot with the given ABI.
+fn register_noop(abi: i32) {
+    let mut table: CblasInjectProviderTable = unsafe { std::mem::zeroed() };
+    table.version = CBLAS_INJECT_PROVIDER_TABLE_VERSION;
+    table.abi = abi;
+    // The routine slots are consecutive pointers after the header.
+    let first: *mut *const std::ffi::c_void = addr_of_mut!(table.sswap);
+    for i in 0..CBLAS_INJECT_PROVIDER_TABLE_SLOTS {
+        unsafe { *first.add(i) = noop as *const std::ffi::c_void };
+    }
+    let size = std::mem::size_of::<CblasInjectProviderTable>();
+    let status = unsafe { cblas_inject_register_table(&table, size) };
+    assert_eq!(status, CBLAS_INJECT_STATUS_OK);
+
+    // The routines without integer arguments only look at the slots of their
+    // single-ABI register_* functions, which the table does not fill.
+    let f = noop as extern "C" fn();
+    unsafe {
+        register_srotg(std::mem::transmute::<extern "C" fn(), SrotgFnPtr>(f));
+        register_drotg(std::mem::transmute::<extern "C" fn(), DrotgFnPtr>(f));
+        register_srotmg(std::mem::transmute::<extern "C" fn(), SrotmgFnPtr>(f));
+        register_drotmg(std::mem::transmute::<extern "C" fn(), DrotmgFnPtr>(f));
+        register_scabs1(std::mem::transmute::<extern "C" fn(), Scabs1FnPtr>(f));
+        register_dcabs1(std::mem::transmute::<extern "C" fn(), Dcabs1FnPtr>(f));
+    }
+}
+
+/// Time the routines of one configuration and print them as CSV rows.
+fn child(config: &str) {
+    let (abi, hidden) = match config {
+        "lp64" => (CBLAS_INJECT_ABI_LP64, false),
+        "ilp64" => (CBLAS_INJECT_ABI_ILP64, false),
+        "lp64-hidden" => (CBLAS_INJECT_ABI_LP64, true),
+        "ilp64-hidden" => (CBLAS_INJECT_ABI_ILP64, true),
+        _ => panic!("unknown configuration {config}"),
+    };
+    if hidden {
+        unsafe { set_complex_return_style(ComplexReturnStyle::HiddenArgument) };
+    }
+    register_noop(abi);
+    // Keep every call on the provider.
+    assert_eq!(
+        cblas_inject_set_small_gemm_max_dim(0),
+        CBLAS_INJECT_STATUS_OK
+    );
+    assert_eq!(
+        cblas_inject_set_native_blas1_max_n(0),
+        CBLAS_INJECT_STATUS_OK
+    );
+
+    let min_time = min_time();
+    let direct = || {
+        let f: extern "C" fn() = black_box(noop);
+        f();
+    };
+    let routines: Vec<&Routine> = ROUTINES
+        .iter()
+        .chain(LP64_ONLY_ROUTINES)
+        .filter(|r| !hidden || COMPLEX_DOTS.contains(&r.name))
+        .collect();
+    let style = if hidden { "hidden" } else { "value" };
+    let provider = config.trim_end_matches("-hidden");
+    for frozen in [false, true] {
+        if frozen {
+            assert_eq!(cblas_inject_finalize(), CBLAS_INJECT_STATUS_OK);
+        }
+        let direct_ns = time_per_call(min_time, direct);
+        for r in &routines {
+            for (entry, f) in [("cblas", Some(r.lp64)), ("cblas_64", r.ilp64)] {
+                let Some(f) = f else { continue };
+                let ns = time_per_call(min_time, f);
+                println!(
+                    "{},{provider},{style},{entry},{frozen},{ns:.1},{:.1}",
+                    r.name,
+                    ns - direct_ns
+                );
+            }
+        }
+    }
+}
+
+struct Row {
+    routine: String,
+    provider: String,
+    style: String,
+    entry: String,
+    frozen: bool,
+    ns: f64,
+    overhead: f64,
+}
+
+impl Row {
+    fn parse(line: &str) -> Self {
+        let f: Vec<&str> = line.split(',').collect();
+        Row {
+            routine: f[0].to_owned(),
+            provider: f[1].to_owned(),
+            style: f[2].to_owned(),
+            entry: f[3].to_owned(),
+            frozen: f[4] == "true",
+            ns: f[5].parse().unwrap(),
+            overhead: f[6].parse().unwrap(),
+        }
+    }
+
+    fn label(&self) -> String {
+        let style = if self.style == "hidden" {
+            " (hidden)"
+        } else {
+            ""
+        };
+        format!("{}{style}", self.routine)
+    }
+
+    fn column(&self) -> String {
+        let frozen = if self.frozen { "/frozen" } else { "" };
+        format!("{}:{}{frozen}", self.provider, self.entry)
+    }
+}
+
+fn main() {
+    if let Ok(config) = std::env::var(CHILD_ENV) {
+        child(&config);
+        return;
+    }
+    let csv = std::env::args().any(|a| a == "--csv");
+    let budget: f64 = std::env::var("CBLAS_INJECT_BENCH_BUDGET_NS")
+        .ok()
+        .and_then(|s| s.parse().ok())
+        .unwrap_or(DEFAULT_BUDGET_NS);
+
+    let exe = std::env::current_exe().expect("bench executable path");
+    let mut rows = Vec::new();
+    for config in CONFIGS {
+        let output = Command::new(&exe)
+            .env(CHILD_ENV, config)
+            .output()
+            .expect("spawn bench child");
+        assert!(
+            output.status.success(),
+            "{config} run failed:\n{}",
+            String::from_utf8_lossy(&output.stderr)
+        );
+        rows.extend(
+            String::from_utf8_lossy(&output.stdout)
+                .lines()
+                .map(Row::parse),
+        );
+    }
+
+    if csv {
+        println!("routine,provider,style,entry,frozen,ns_per_call,overhead_ns");
+        for r in &rows {
+            println!(
+                "{},{},{},{},{},{:.1},{:.1}",
+                r.routine, r.provider, r.style, r.entry, r.frozen, r.ns, r.overhead
+            );
+        }
+    } else {
+        let mut columns: Vec<String> = Vec::new();
+        let mut labels: Vec<String> = Vec::new();
+        for r in &rows {
+            for (list, key) in [(&mut columns, r.column()), (&mut labels, r.label())] {
+                if !list.contains(&key) {
+                    list.push(key);
+                }
+            }
+        }
+        println!("Dispatch Overhead Benchmark (ns per call over a no-op provider)");
+        println!("===============================================================");
+        println!("Budget: {budget:.1} ns");
+        println!();
+        print!("{:<22}", "routine");
+        for c in &columns {
+            print!(" {c:>22}");
+        }
+        println!();
+        for label in &labels {
+            print!("{label:<22}");
+            for c in &columns {
+                match rows
+                    .iter()
+                    .find(|r| &r.label() == label && &r.column() == c)
+                {
+                    Some(r) => print!(" {:>22.1}", r.overhead),
+                    None => print!(" {:>22}", "-"),
+                }
+            }
+            println!();
+        }
+    }
+
+    let over: Vec<&Row> = rows.iter().filter(|r| r.overhead > budget).collect();
+    if !over.is_empty() {
+        eprintln!(
+            "{} entry points over the {budget:.1} ns budget:",
+            over.len()
+        );
+        for r in over {
+            eprintln!("  {} {}: {:.1} ns", r.label(), r.column(), r.overhead);
+        }
+        std::process::exit(1);
+    }
+}
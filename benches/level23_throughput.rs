@@ -0,0 +1,839 @@
+//! Throughput of the BLAS Level 2/3 entry points against direct Fortran calls.
+//!
+//! For every Level 2/3 family (double and double complex) and a sweep of
+//! square sizes, measures:
+//!
+//! 1. `direct`: the OpenBLAS Fortran symbol (column-major baseline)
+//! 2. `inject`: the `cblas_*` wrapper with OpenBLAS registered as LP64, in
+//!    both orders; the row-major Hermitian Level 2 rows include the
+//!    conjugation passes
+//!
+//! and, for `dgemm`/`zgemm`:
+//!
+//! 3. `narrowed`: the `cblas_*_64` symbol routed to the LP64 provider
+//!    (range checks and `i64` to `i32` conversion)
+//! 4. `widened`: the LP64 `cblas_*` symbol of a private cdylib copy whose
+//!    provider is ILP64, so dimensions are widened with `BlasInt64::from`.
+//!    The ILP64 provider is a shim that narrows back to OpenBLAS, so this
+//!    row includes one extra call.
+//!
+//! ```text
+//! cargo build --release
+//! cargo bench --bench level23_throughput            # table
+//! cargo bench --bench level23_throughput -- --csv   # CSV on stdout
+//! ```
+//!
+//! CSV columns: `level,routine,order,n,mode,ns_per_call,gflops,overhead_pct`,
+//! where `overhead_pct` is relative to `direct` at the same `n`.
+//! `CBLAS_INJECT_BENCH_MIN_MS` sets the minimum measuring time per point
+//! (default 20).
+
+use std::ffi::{c_char, c_int, c_void};
+use std::hint::black_box;
+use std::path::PathBuf;
+use std::time::{Duration, Instant};
+
+use cblas_inject::*;
+use libloading::Library;
+use num_complex::Complex64;
+
+type C64 = Complex64;
+
+// Link against OpenBLAS
+#[link(name = "openblas")]
+extern "C" {
+    fn dgemm_(
+        transa: *const c_char,
+        transb: *const c_char,
+        m: *const i32,
+        n: *const i32,
+        k: *const i32,
+        alpha: *const f64,
+        a: *const f64,
+        lda: *const i32,
+        b: *const f64,
+        ldb: *const i32,
+        beta: *const f64,
+        c: *mut f64,
+        ldc: *const i32,
+    );
+    fn zgemm_(
+        transa: *const c_char,
+        transb: *const c_char,
+        m: *const i32,
+        n: *const i32,
+        k: *const i32,
+        alpha: *const C64,
+        a: *const C64,
+        lda: *const i32,
+        b: *const C64,
+        ldb: *const i32,
+        beta: *const C64,
+        c: *mut C64,
+        ldc: *const i32,
+    );
+    fn dsymm_(
+        side: *const c_char,
+        uplo: *const c_char,
+        m: *const i32,
+        n: *const i32,
+        alpha: *const f64,
+        a: *const f64,
+        lda: *const i32,
+        b: *const f64,
+        ldb: *const i32,
+        beta: *const f64,
+        c: *mut f64,
+        ldc: *const i32,
+    );
+    fn zhemm_(
+        side: *const c_char,
+        uplo: *const c_char,
+        m: *const i32,
+        n: *const i32,
+        alpha: *const C64,
+        a: *const C64,
+        lda: *const i32,
+        b: *const C64,
+        ldb: *const i32,
+        beta: *const C64,
+        c: *mut C64,
+        ldc: *const i32,
+    );
+    fn dsyrk_(
+        uplo: *const c_char,
+        trans: *const c_char,
+        n: *const i32,
+        k: *const i32,
+        alpha: *const f64,
+        a: *const f64,
+        lda: *const i32,
+        beta: *const f64,
+        c: *mut f64,
+        ldc: *const i32,
+    );
+    fn zherk_(
+        uplo: *const c_char,
+        trans: *const c_char,
+        n: *const i32,
+        k: *const i32,
+        alpha: *const f64,
+        a: *const C64,
+        lda: *const i32,
+        beta: *const f64,
+        c: *mut C64,
+        ldc: *const i32,
+    );
+    fn dsyr2k_(
+        uplo: *const c_char,
+        trans: *const c_char,
+        n: *const i32,
+        k: *const i32,
+        alpha: *const f64,
+        a: *const f64,
+        lda: *const i32,
+        b: *const f64,
+        ldb: *const i32,
+        beta: *const f64,
+        c: *mut f64,
+        ldc: *const i32,
+    );
+    fn zher2k_(
+        uplo: *const c_char,
+        trans: *const c_char,
+        n: *const i32,
+        k: *const i32,
+        alpha: *const C64,
+        a: *const C64,
+        lda: *const i32,
+        b: *const C64,
+        ldb: *const i32,
+        beta: *const f64,
+        c: *mut C64,
+        ldc: *const i32,
+    );
+    fn dtrmm_(
+        side: *const c_char,
+        uplo: *const c_char,
+        transa: *const c_char,
+        diag: *const c_char,
+        m: *const i32,
+        n: *const i32,
+        alpha: *const f64,
+        a: *const f64,
+        lda: *const i32,
+        b: *mut f64,
+        ldb: *const i32,
+    );
+    fn dtrsm_(
+        side: *const c_char,
+        uplo: *const c_char,
+        transa: *const c_char,
+        diag: *const c_char,
+        m: *const i32,
+        n: *const i32,
+        alpha: *const f64,
+        a: *const f64,
+        lda: *const i32,
+        b: *mut f64,
+        ldb: *const i32,
+    );
+    fn ztrsm_(
+        side: *const c_char,
+        uplo: *const c_char,
+        transa: *const c_char,
+        diag: *const c_char,
+        m: *const i32,
+        n: *const i32,
+        alpha: *const C64,
+        a: *const C64,
+        lda: *const i32,
+        b: *mut C64,
+        ldb: *const i32,
+    );
+    fn dgemv_(
+        trans: *const c_char,
+        m: *const i32,
+        n: *const i32,
+        alpha: *const f64,
+        a: *const f64,
+        lda: *const i32,
+        x: *const f64,
+        incx: *const i32,
+        beta: *const f64,
+        y: *mut f64,
+        incy: *const i32,
+    );
+    fn zgemv_(
+        trans: *const c_char,
+        m: *const i32,
+        n: *const i32,
+        alpha: *const C64,
+        a: *const C64,
+        lda: *const i32,
+        x: *const C64,
+        incx: *const i32,
+        beta: *const C64,
+        y: *mut C64,
+        incy: *const i32,
+    );
+    fn dsymv_(
+        uplo: *const c_char,
+        n: *const i32,
+        alpha: *const f64,
+        a: *const f64,
+        lda: *const i32,
+        x: *const f64,
+        incx: *const i32,
+        beta: *const f64,
+        y: *mut f64,
+        incy: *const i32,
+    );
+    fn zhemv_(
+        uplo: *const c_char,
+        n: *const i32,
+        alpha: *const C64,
+        a: *const C64,
+        lda: *const i32,
+        x: *const C64,
+        incx: *const i32,
+        beta: *const C64,
+        y: *mut C64,
+        incy: *const i32,
+    );
+    fn dtrmv_(
+        uplo: *const c_char,
+        trans: *const c_char,
+        diag: *const c_char,
+        n: *const i32,
+        a: *const f64,
+        lda: *const i32,
+        x: *mut f64,
+        incx: *const i32,
+    );
+    fn dtrsv_(
+        uplo: *const c_char,
+        trans: *const c_char,
+        diag: *const c_char,
+        n: *const i32,
+        a: *const f64,
+        lda: *const i32,
+        x: *mut f64,
+        incx: *const i32,
+    );
+    fn dger_(
+        m: *const i32,
+        n: *const i32,
+        alpha: *const f64,
+        x: *const f64,
+        incx: *const i32,
+        y: *const f64,
+        incy: *const i32,
+        a: *mut f64,
+        lda: *const i32,
+    );
+    fn zher_(
+        uplo: *const c_char,
+        n: *const i32,
+        alpha: *const f64,
+        x: *const C64,
+        incx: *const i32,
+        a: *mut C64,
+        lda: *const i32,
+    );
+    fn zher2_(
+        uplo: *const c_char,
+        n: *const i32,
+        alpha: *const C64,
+        x: *const C64,
+        incx: *const i32,
+        y: *const C64,
+        incy: *const i32,
+        a: *mut C64,
+        lda: *const i32,
+    );
+}
+
+/// `dgemm_` behind an ILP64 signature, for the widened rows.
+unsafe extern "C" fn dgemm_ilp64_shim(
+    transa: *const c_char,
+    transb: *const c_char,
+    m: *const i64,
+    n: *const i64,
+    k: *const i64,
+    alpha: *const f64,
+    a: *const f64,
+    lda: *const i64,
+    b: *const f64,
+    ldb: *const i64,
+    beta: *const f64,
+    c: *mut f64,
+    ldc: *const i64,
+) {
+    let [m, n, k, lda, ldb, ldc] = [m, n, k, lda, ldb, ldc].map(|p| unsafe { *p } as i32);
+    unsafe {
+        dgemm_(
+            transa, transb, &m, &n, &k, alpha, a, &lda, b, &ldb, beta, c, &ldc,
+        )
+    }
+}
+
+/// `zgemm_` behind an ILP64 signature, for the widened rows.
+unsafe extern "C" fn zgemm_ilp64_shim(
+    transa: *const c_char,
+    transb: *const c_char,
+    m: *const i64,
+    n: *const i64,
+    k: *const i64,
+    alpha: *const C64,
+    a: *const C64,
+    lda: *const i64,
+    b: *const C64,
+    ldb: *const i64,
+    beta: *const C64,
+    c: *mut C64,
+    ldc: *const i64,
+) {
+    let [m, n, k, lda, ldb, ldc] = [m, n, k, lda, ldb, ldc].map(|p| unsafe { *p } as i32);
+    unsafe {
+        zgemm_(
+            transa, transb, &m, &n, &k, alpha, a, &lda, b, &ldb, beta, c, &ldc,
+        )
+    }
+}
+
+type CblasDgemm = unsafe extern "C" fn(
+    CBLAS_ORDER,
+    CBLAS_TRANSPOSE,
+    CBLAS_TRANSPOSE,
+    i32,
+    i32,
+    i32,
+    f64,
+    *const f64,
+    i32,
+    *const f64,
+    i32,
+    f64,
+    *mut f64,
+    i32,
+);
+type CblasZgemm = unsafe extern "C" fn(
+    CBLAS_ORDER,
+    CBLAS_TRANSPOSE,
+    CBLAS_TRANSPOSE,
+    i32,
+    i32,
+    i32,
+    *const C64,
+    *const C64,
+    i32,
+    *const C64,
+    i32,
+    *const C64,
+    *mut C64,
+    i32,
+);
+
+/// A private copy of the cdylib with the ILP64 shims registered.
+struct Widened {
+    dgemm: CblasDgemm,
+    zgemm: CblasZgemm,
+    _lib: Library,
+    copy: PathBuf,
+}
+
+impl Widened {
+    unsafe fn load() -> Option<Self> {
+        let cdylib = find_cdylib()?;
+        let copy = std::env::temp_dir().join(format!(
+            "cblas_inject_level23_{}_{}",
+            std::process::id(),
+            cdylib_file_name()
+        ));
+        std::fs::copy(&cdylib, &copy).ok()?;
+        type Register = unsafe extern "C" fn(*const c_void) -> c_int;
+        unsafe {
+            let lib = Library::new(&copy).ok()?;
+            let register_d = *lib
+                .get::<Register>(b"cblas_inject_register_dgemm_ilp64\0")
+                .ok()?;
+            let register_z = *lib
+                .get::<Register>(b"cblas_inject_register_zgemm_ilp64\0")
+                .ok()?;
+            assert_eq!(
+                register_d(dgemm_ilp64_shim as *const c_void),
+                CBLAS_INJECT_STATUS_OK
+            );
+            assert_eq!(
+                register_z(zgemm_ilp64_shim as *const c_void),
+                CBLAS_INJECT_STATUS_OK
+            );
+            Some(Widened {
+                dgemm: *lib.get::<CblasDgemm>(b"cblas_dgemm\0").ok()?,
+                zgemm: *lib.get::<CblasZgemm>(b"cblas_zgemm\0").ok()?,
+                _lib: lib,
+                copy,
+            })
+        }
+    }
+}
+
+impl Drop for Widened {
+    fn drop(&mut self) {
+        let _ = std::fs::remove_file(&self.copy);
+    }
+}
+
+fn cdylib_file_name() -> &'static str {
+    #[cfg(target_os = "windows")]
+    {
+        "cblas_inject.dll"
+    }
+    #[cfg(target_os = "macos")]
+    {
+        "libcblas_inject.dylib"
+    }
+    #[cfg(all(unix, not(target_os = "macos")))]
+    {
+        "libcblas_inject.so"
+    }
+}
+
+fn find_cdylib() -> Option<PathBuf> {
+    let mut candidates = Vec::new();
+    if let Ok(exe) = std::env::current_exe() {
+        for dir in exe.ancestors().skip(1).take(2) {
+            candidates.push(dir.join(cdylib_file_name()));
+        }
+    }
+    let target = std::env::var_os("CARGO_TARGET_DIR")
+        .map(PathBuf::from)
+        .unwrap_or_else(|| PathBuf::from(env!("CARGO_MANIFEST_DIR")).join("target"));
+    candidates.push(target.join("release").join(cdylib_file_name()));
+    candidates.push(target.join("debug").join(cdylib_file_name()));
+    candidates.into_iter().find(|p| p.is_file())
+}
+
+fn register_openblas() {
+    let providers: [(unsafe extern "C" fn(*const c_void) -> i32, *const c_void); 20] = [
+        (cblas_inject_register_dgemm_lp64, dgemm_ as *const c_void),
+        (cblas_inject_register_zgemm_lp64, zgemm_ as *const c_void),
+        (cblas_inject_register_dsymm_lp64, dsymm_ as *const c_void),
+        (cblas_inject_register_zhemm_lp64, zhemm_ as *const c_void),
+        (cblas_inject_register_dsyrk_lp64, dsyrk_ as *const c_void),
+        (cblas_inject_register_zherk_lp64, zherk_ as *const c_void),
+        (cblas_inject_register_dsyr2k_lp64, dsyr2k_ as *const c_void),
+        (cblas_inject_register_zher2k_lp64, zher2k_ as *const c_void),
+        (cblas_inject_register_dtrmm_lp64, dtrmm_ as *const c_void),
+        (cblas_inject_register_dtrsm_lp64, dtrsm_ as *const c_void),
+        (cblas_inject_register_ztrsm_lp64, ztrsm_ as *const c_void),
+        (cblas_inject_register_dgemv_lp64, dgemv_ as *const c_void),
+        (cblas_inject_register_zgemv_lp64, zgemv_ as *const c_void),
+        (cblas_inject_register_dsymv_lp64, dsymv_ as *const c_void),
+        (cblas_inject_register_zhemv_lp64, zhemv_ as *const c_void),
+        (cblas_inject_register_dtrmv_lp64, dtrmv_ as *const c_void),
+        (cblas_inject_register_dtrsv_lp64, dtrsv_ as *const c_void),
+        (cblas_inject_register_dger_lp64, dger_ as *const c_void),
+        (cblas_inject_register_zher_lp64, zher_ as *const c_void),
+        (cblas_inject_register_zher2_lp64, zher2_ as *const c_void),
+    ];
+    for (register, f) in providers {
+        assert_eq!(unsafe { register(f) }, CBLAS_INJECT_STATUS_OK);
+    }
+}
+
+/// Operands for one size: `n x n` matrices and length-`n` vectors.
+///
+/// `tri` is the identity, so repeated in-place triangular calls neither grow
+/// nor decay into subnormals; the providers do the same work either way.
+struct Operands {
+    n: i32,
+    a: Vec<f64>,
+    b: Vec<f64>,
+    c: Vec<f64>,
+    tri: Vec<f64>,
+    x: Vec<f64>,
+    y: Vec<f64>,
+    za: Vec<C64>,
+    zb: Vec<C64>,
+    zc: Vec<C64>,
+    ztri: Vec<C64>,
+    zx: Vec<C64>,
+    zy: Vec<C64>,
+}
+
+impl Operands {
+    fn new(n: usize) -> Self {
+        let d = |len: usize, s: f64| (0..len).map(|i| s / (1 + i % 7) as f64).collect();
+        let z = |len: usize, s: f64| {
+            (0..len)
+                .map(|i| C64::new(s / (1 + i % 5) as f64, s / (2 + i % 3) as f64))
+                .collect()
+        };
+        let tri: Vec<f64> = (0..n * n)
+            .map(|i| if i % (n + 1) == 0 { 1.0 } else { 0.0 })
+            .collect();
+        Operands {
+            n: n as i32,
+            a: d(n * n, 1.0),
+            b: d(n * n, 0.5),
+            c: d(n * n, 0.25),
+            ztri: tri.iter().map(|&v| C64::new(v, 0.0)).collect(),
+            tri,
+            x: d(n, 1.0),
+            y: d(n, 0.5),
+            za: z(n * n, 1.0),
+            zb: z(n * n, 0.5),
+            zc: z(n * n, 0.25),
+            zx: z(n, 1.0),
+            zy: z(n, 0.5),
+        }
+    }
+}
+
+const N: c_char = b'N' as c_char;
+const T: c_char = b'T' as c_char;
+const L: c_char = b'L' as c_char;
+const U: c_char = b'U' as c_char;
+
+const ALPHA: f64 = 1.0;
+const BETA: f64 = 0.0;
+const ZALPHA: C64 = C64::new(1.0, 0.5);
+const ZBETA: C64 = C64::new(0.0, 0.0);
+
+/// Routines in report order: `(level, name, real flops / n^level)`.
+const ROUTINES: [(u8, &str, f64); 20] = [
+    (2, "dgemv", 2.0),
+    (2, "zgemv", 8.0),
+    (2, "dsymv", 2.0),
+    (2, "zhemv", 8.0),
+    (2, "dtrmv", 1.0),
+    (2, "dtrsv", 1.0),
+    (2, "dger", 2.0),
+    (2, "zher", 4.0),
+    (2, "zher2", 8.0),
+    (3, "dgemm", 2.0),
+    (3, "zgemm", 8.0),
+    (3, "dsymm", 2.0),
+    (3, "zhemm", 8.0),
+    (3, "dsyrk", 1.0),
+    (3, "zherk", 4.0),
+    (3, "dsyr2k", 2.0),
+    (3, "zher2k", 8.0),
+    (3, "dtrmm", 1.0),
+    (3, "dtrsm", 1.0),
+    (3, "ztrsm", 4.0),
+];
+
+/// One column-major Fortran call of `routine` on `o`.
+unsafe fn direct(routine: &str, o: &mut Operands) {
+    let n = &o.n;
+    let one = &1;
+    let (a, b, c, tri) = (o.a.as_ptr(), o.b.as_ptr(), o.c.as_mut_ptr(), o.tri.as_ptr());
+    let (x, y) = (o.x.as_ptr(), o.y.as_mut_ptr());
+    let (za, zb, zc, ztri) = (
+        o.za.as_ptr(),
+        o.zb.as_ptr(),
+        o.zc.as_mut_ptr(),
+        o.ztri.as_ptr(),
+    );
+    let (zx, zy) = (o.zx.as_ptr(), o.zy.as_mut_ptr());
+    let xm = o.x.as_mut_ptr();
+    let bm = o.b.as_mut_ptr();
+    let zbm = o.zb.as_mut_ptr();
+    unsafe {
+        match routine {
+            "dgemv" => dgemv_(&N, n, n, &ALPHA, a, n, x, one, &BETA, y, one),
+            "zgemv" => zgemv_(&N, n, n, &ZALPHA, za, n, zx, one, &ZBETA, zy, one),
+            "dsymv" => dsymv_(&U, n, &ALPHA, a, n, x, one, &BETA, y, one),
+            "zhemv" => zhemv_(&U, n, &ZALPHA, za, n, zx, one, &ZBETA, zy, one),
+            "dtrmv" => dtrmv_(&U, &N, &N, n, tri, n, xm, one),
+            "dtrsv" => dtrsv_(&U, &N, &N, n, tri, n, xm, one),
+            "dger" => dger_(n, n, &ALPHA, x, one, y, one, c, n),
+            "zher" => zher_(&U, n, &ALPHA, zx, one, zc, n),
+            "zher2" => zher2_(&U, n, &ZALPHA, zx, one, zy, one, zc, n),
+            "dgemm" => dgemm_(&N, &N, n, n, n, &ALPHA, a, n, b, n, &BETA, c, n),
+            "zgemm" => zgemm_(&N, &N, n, n, n, &ZALPHA, za, n, zb, n, &ZBETA, zc, n),
+            "dsymm" => dsymm_(&L, &U, n, n, &ALPHA, a, n, b, n, &BETA, c, n),
+            "zhemm" => zhemm_(&L, &U, n, n, &ZALPHA, za, n, zb, n, &ZBETA, zc, n),
+            "dsyrk" => dsyrk_(&U, &N, n, n, &ALPHA, a, n, &BETA, c, n),
+            "zherk" => zherk_(&U, &N, n, n, &ALPHA, za, n, &BETA, zc, n),
+            "dsyr2k" => dsyr2k_(&U, &N, n, n, &ALPHA, a, n, b, n, &BETA, c, n),
+            "zher2k" => zher2k_(&U, &N, n, n, &ZALPHA, za, n, zb, n, &BETA, zc, n),
+            "dtrmm" => dtrmm_(&L, &U, &N, &N, n, n, &ALPHA, tri, n, bm, n),
+            "dtrsm" => dtrsm_(&L, &U, &T, &N, n, n, &ALPHA, tri, n, bm, n),
+            _ => ztrsm_(&L, &U, &T, &N, n, n, &ZALPHA, ztri, n, zbm, n),
+        }
+    }
+}
+
+/// One `cblas_*` call of `routine` on `o` in `order`.
+unsafe fn inject(routine: &str, order: CBLAS_ORDER, o: &mut Operands) {
+    let n = o.n;
+    let (a, b, c, tri) = (o.a.as_ptr(), o.b.as_ptr(), o.c.as_mut_ptr(), o.tri.as_ptr());
+    let (x, y) = (o.x.as_ptr(), o.y.as_mut_ptr());
+    let (za, zb, zc, ztri) = (
+        o.za.as_ptr(),
+        o.zb.as_ptr(),
+        o.zc.as_mut_ptr(),
+        o.ztri.as_ptr(),
+    );
+    let (zx, zy) = (o.zx.as_ptr(), o.zy.as_mut_ptr());
+    let xm = o.x.as_mut_ptr();
+    let bm = o.b.as_mut_ptr();
+    let zbm = o.zb.as_mut_ptr();
+    let (nt, up, left, nu) = (CblasNoTrans, CblasUpper, CblasLeft, CblasNonUnit);
+    unsafe {
+        match routine {
+            "dgemv" => cblas_dgemv(order, nt, n, n, ALPHA, a, n, x, 1, BETA, y, 1),
+            "zgemv" => cblas_zgemv(order, nt, n, n, &ZALPHA, za, n, zx, 1, &ZBETA, zy, 1),
+            "dsymv" => cblas_dsymv(order, up, n, ALPHA, a, n, x, 1, BETA, y, 1),
+            "zhemv" => cblas_zhemv(order, up, n, &ZALPHA, za, n, zx, 1, &ZBETA, zy, 1),
+            "dtrmv" => cblas_dtrmv(order, up, nt, nu, n, tri, n, xm, 1),
+            "dtrsv" => cblas_dtrsv(order, up, nt, nu, n, tri, n, xm, 1),
+            "dger" => cblas_dger(order, n, n, ALPHA, x, 1, y, 1, c, n),
+            "zher" => cblas_zher(order, up, n, ALPHA, zx, 1, zc, n),
+            "zher2" => cblas_zher2(order, up, n, &ZALPHA, zx, 1, zy, 1, zc, n),
+            "dgemm" => cblas_dgemm(order, nt, nt, n, n, n, ALPHA, a, n, b, n, BETA, c, n),
+            "zgemm" => cblas_zgemm(order, nt, nt, n, n, n, &ZALPHA, za, n, zb, n, &ZBETA, zc, n),
+            "dsymm" => cblas_dsymm(order, left, up, n, n, ALPHA, a, n, b, n, BETA, c, n),
+            "zhemm" => cblas_zhemm(order, left, up, n, n, &ZALPHA, za, n, zb, n, &ZBETA, zc, n),
+            "dsyrk" => cblas_dsyrk(order, up, nt, n, n, ALPHA, a, n, BETA, c, n),
+            "zherk" => cblas_zherk(order, up, nt, n, n, ALPHA, za, n, BETA, zc, n),
+            "dsyr2k" => cblas_dsyr2k(order, up, nt, n, n, ALPHA, a, n, b, n, BETA, c, n),
+            "zher2k" => cblas_zher2k(order, up, nt, n, n, &ZALPHA, za, n, zb, n, BETA, zc, n),
+            "dtrmm" => cblas_dtrmm(order, left, up, nt, nu, n, n, ALPHA, tri, n, bm, n),
+            "dtrsm" => cblas_dtrsm(order, left, up, CblasTrans, nu, n, n, ALPHA, tri, n, bm, n),
+            _ => cblas_ztrsm(
+                order, left, up, CblasTrans, nu, n, n, &ZALPHA, ztri, n, zbm, n,
+            ),
+        }
+    }
+}
+
+/// Mean time per call, doubling the batch until it runs for `min_time`.
+fn time_per_call(min_time: Duration, mut f: impl FnMut()) -> f64 {
+    f();
+    let mut iters = 1u64;
+    loop {
+        let start = Instant::now();
+        for _ in 0..iters {
+            f();
+        }
+        let elapsed = start.elapsed();
+        if elapsed >= min_time || iters >= 1 << 24 {
+            return elapsed.as_nanos() as f64 / iters as f64;
+        }
+        iters *= 2;
+    }
+}
+
+struct Row {
+    level: u8,
+    routine: &'static str,
+    order: &'static str,
+    n: usize,
+    mode: &'static str,
+    ns: f64,
+    flops: f64,
+    direct_ns: f64,
+}
+
+impl Row {
+    fn gflops(&self) -> f64 {
+        self.flops / self.ns
+    }
+
+    fn overhead_pct(&self) -> f64 {
+        (self.ns - self.direct_ns) / self.direct_ns * 100.0
+    }
+}
+
+fn main() {
+    let csv = std::env::args().any(|a| a == "--csv");
+    let min_time = Duration::from_millis(
+        std::env::var("CBLAS_INJECT_BENCH_MIN_MS")
+            .ok()
+            .and_then(|s| s.parse().ok())
+            .unwrap_or(20),
+    );
+    register_openblas();
+    // Keep every GEMM on the provider so the rows compare like with like.
+    assert_eq!(
+        cblas_inject_set_small_gemm_max_dim(0),
+        CBLAS_INJECT_STATUS_OK
+    );
+    let widened = unsafe { Widened::load() };
+    if widened.is_none() {
+        eprintln!("libcblas_inject cdylib not found; widened rows skipped");
+    }
+
+    let level2_sizes = [16, 64, 256, 1024, 2048];
+    let level3_sizes = [16, 64, 256, 512];
+    let mut rows = Vec::new();
+    for &(level, routine, flops_per) in &ROUTINES {
+        let sizes: &[usize] = if level == 2 {
+            &level2_sizes
+        } else {
+            &level3_sizes
+        };
+        for &n in sizes {
+            let mut o = Operands::new(n);
+            let flops = flops_per * (n as f64).powi(level.into());
+            let direct_ns = time_per_call(min_time, || unsafe {
+                direct(routine, &mut o);
+                black_box(&o);
+            });
+            let mut push = |order, mode, ns| {
+                rows.push(Row {
+                    level,
+                    routine,
+                    order,
+                    n,
+                    mode,
+                    ns,
+                    flops,
+                    direct_ns,
+                })
+            };
+            push("col", "direct", direct_ns);
+            for (order, label) in [(CblasColMajor, "col"), (CblasRowMajor, "row")] {
+                let ns = time_per_call(min_time, || unsafe {
+                    inject(routine, order, &mut o);
+                    black_box(&o);
+                });
+                push(label, "inject", ns);
+            }
+
+            let ni = n as i32;
+            let nl = n as i64;
+            let (a, b, c) = (o.a.as_ptr(), o.b.as_ptr(), o.c.as_mut_ptr());
+            let (za, zb, zc) = (o.za.as_ptr(), o.zb.as_ptr(), o.zc.as_mut_ptr());
+            let nt = CblasNoTrans;
+            let col = CblasColMajor;
+            let extra = match routine {
+                "dgemm" => Some((
+                    time_per_call(min_time, || unsafe {
+                        cblas_dgemm_64(col, nt, nt, nl, nl, nl, ALPHA, a, nl, b, nl, BETA, c, nl);
+                        black_box(c);
+                    }),
+                    widened.as_ref().map(|w| {
+                        time_per_call(min_time, || unsafe {
+                            (w.dgemm)(col, nt, nt, ni, ni, ni, ALPHA, a, ni, b, ni, BETA, c, ni);
+                            black_box(c);
+                        })
+                    }),
+                )),
+                "zgemm" => Some((
+                    time_per_call(min_time, || unsafe {
+                        cblas_zgemm_64(
+                            col, nt, nt, nl, nl, nl, &ZALPHA, za, nl, zb, nl, &ZBETA, zc, nl,
+                        );
+                        black_box(zc);
+                    }),
+                    widened.as_ref().map(|w| {
+                        time_per_call(min_time, || unsafe {
+                            (w.zgemm)(
+                                col, nt, nt, ni, ni, ni, &ZALPHA, za, ni, zb, ni, &ZBETA, zc, ni,
+                            );
+                            black_box(zc);
+                        })
+                    }),
+                )),
+                _ => None,
+            };
+            if let Some((narrowed, widened)) = extra {
+                push("col", "narrowed", narrowed);
+                if let Some(ns) = widened {
+                    push("col", "widened", ns);
+                }
+            }
+        }
+    }
+
+    if csv {
+        println!("level,routine,order,n,mode,ns_per_call,gflops,overhead_pct");
+        for r in &rows {
+            println!(
+                "{},{},{},{},{},{:.1},{:.3},{:.2}",
+                r.level,
+                r.routine,
+                r.order,
+                r.n,
+                r.mode,
+                r.ns,
+                r.gflops(),
+                r.overhead_pct()
+            );
+        }
+        return;
+    }
+
+    println!("BLAS Level 2/3 Throughput Benchmark");
+    println!("===================================");
+    println!("Minimum time per point: {:?}", min_time);
+    println!("overhead = time relative to the column-major Fortran call at the same n");
+    println!();
+    println!(
+        "{:<7} {:>5} {:>6} {:<9} {:>12} {:>9} {:>9}",
+        "routine", "n", "order", "mode", "ns/call", "GFLOP/s", "overhead"
+    );
+    let mut last = "";
+    for r in &rows {
+        if r.routine != last && !last.is_empty() {
+            println!();
+        }
+        last = r.routine;
+        println!(
+            "{:<7} {:>5} {:>6} {:<9} {:>12.1} {:>9.2} {:>8.1}%",
+            r.routine,
+            r.n,
+            r.order,
+            r.mode,
+            r.ns,
+            r.gflops(),
+            r.overhead_pct()
+        );
+    }
+}
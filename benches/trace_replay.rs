@@ -0,0 +1,952 @@
+//! Replay a recorded call trace against several BLAS backends.
+//!
+//! Reads a file written by `cblas_inject_trace_start` (or `CBLAS_INJECT_TRACE`)
+//! and replays every record with synthetic data against:
+//!
+//! 1. `direct`: the provider's Fortran symbols, row-major records converted by
+//!    the harness (baseline)
+//! 2. `lp64`: a fresh copy of the cblas-inject cdylib with the provider
+//!    registered as LP64
+//! 3. `widened`: a fresh copy with an ILP64 provider behind the LP64 symbols
+//!    (skipped unless one is found)
+//! 4. `native`: a fresh copy with the LP64 provider and the native small GEMM
+//!    enabled up to `CBLAS_INJECT_SMALL_GEMM_DIM_LIMIT`
+//!
+//! The difference between a cblas-inject column and `direct` is the time lost
+//! in the wrapper layer; `direct` itself is the provider's share.
+//!
+//! ```text
+//! cargo build --release
+//! cargo bench --bench trace_replay -- trace.bin
+//! ```
+//!
+//! Without a trace argument a small synthetic workload is replayed.
+//! Environment:
+//! - `CBLAS_INJECT_REPLAY_PROVIDER`: LP64 Fortran BLAS (default: OpenBLAS)
+//! - `CBLAS_INJECT_REPLAY_PROVIDER64`: ILP64 Fortran BLAS (default: the LP64
+//!   library, if it exports suffixed ILP64 symbols)
+//! - `CBLAS_INJECT_REPLAY_SUFFIX64`: ILP64 symbol suffix (default `_64_`)
+//! - `CBLAS_INJECT_REPLAY_REPS`: passes over the trace (default 3)
+//!
+//! Replayed routines: d/z gemm, gemv, trsm and trmm, dsymm, zhemm, dsyrk and
+//! zherk. Other records are counted and skipped. Every record reuses the same
+//! synthetic operands, sized for the largest call in the trace.
+
+use std::collections::BTreeMap;
+use std::ffi::{c_char, c_int, c_void};
+use std::hint::black_box;
+use std::path::{Path, PathBuf};
+use std::time::{Duration, Instant};
+use std::{fs, mem, ptr};
+
+use cblas_inject::{
+    CblasInjectTraceHeader, CblasInjectTraceRecord, CBLAS_INJECT_SMALL_GEMM_DIM_LIMIT,
+    CBLAS_INJECT_STATUS_OK, CBLAS_INJECT_TRACE_MAGIC,
+};
+use libloading::Library;
+use num_complex::Complex64;
+
+const ROW_MAJOR: u8 = 101;
+const COL_MAJOR: u8 = 102;
+const NO_TRANS: u8 = 111;
+const TRANS: u8 = 112;
+const CONJ_TRANS: u8 = 113;
+const UPPER: u8 = 121;
+const LOWER: u8 = 122;
+const NON_UNIT: u8 = 131;
+const LEFT: u8 = 141;
+const RIGHT: u8 = 142;
+
+// Fortran BLAS signatures, generic over the element and integer type.
+type FGemm<T, I> = unsafe extern "C" fn(
+    *const c_char,
+    *const c_char,
+    *const I,
+    *const I,
+    *const I,
+    *const T,
+    *const T,
+    *const I,
+    *const T,
+    *const I,
+    *const T,
+    *mut T,
+    *const I,
+);
+type FGemv<T, I> = unsafe extern "C" fn(
+    *const c_char,
+    *const I,
+    *const I,
+    *const T,
+    *const T,
+    *const I,
+    *const T,
+    *const I,
+    *const T,
+    *mut T,
+    *const I,
+);
+type FSymm<T, I> = unsafe extern "C" fn(
+    *const c_char,
+    *const c_char,
+    *const I,
+    *const I,
+    *const T,
+    *const T,
+    *const I,
+    *const T,
+    *const I,
+    *const T,
+    *mut T,
+    *const I,
+);
+type FSyrk<T, R, I> = unsafe extern "C" fn(
+    *const c_char,
+    *const c_char,
+    *const I,
+    *const I,
+    *const R,
+    *const T,
+    *const I,
+    *const R,
+    *mut T,
+    *const I,
+);
+type FTrxm<T, I> = unsafe extern "C" fn(
+    *const c_char,
+    *const c_char,
+    *const c_char,
+    *const c_char,
+    *const I,
+    *const I,
+    *const T,
+    *const T,
+    *const I,
+    *mut T,
+    *const I,
+);
+
+// CBLAS signatures exported by the cdylib (LP64 symbols).
+type CDgemm = unsafe extern "C" fn(
+    c_int,
+    c_int,
+    c_int,
+    i32,
+    i32,
+    i32,
+    f64,
+    *const f64,
+    i32,
+    *const f64,
+    i32,
+    f64,
+    *mut f64,
+    i32,
+);
+type CZgemm = unsafe extern "C" fn(
+    c_int,
+    c_int,
+    c_int,
+    i32,
+    i32,
+    i32,
+    *const Complex64,
+    *const Complex64,
+    i32,
+    *const Complex64,
+    i32,
+    *const Complex64,
+    *mut Complex64,
+    i32,
+);
+type CDgemv = unsafe extern "C" fn(
+    c_int,
+    c_int,
+    i32,
+    i32,
+    f64,
+    *const f64,
+    i32,
+    *const f64,
+    i32,
+    f64,
+    *mut f64,
+    i32,
+);
+type CZgemv = unsafe extern "C" fn(
+    c_int,
+    c_int,
+    i32,
+    i32,
+    *const Complex64,
+    *const Complex64,
+    i32,
+    *const Complex64,
+    i32,
+    *const Complex64,
+    *mut Complex64,
+    i32,
+);
+type CDsymm = unsafe extern "C" fn(
+    c_int,
+    c_int,
+    c_int,
+    i32,
+    i32,
+    f64,
+    *const f64,
+    i32,
+    *const f64,
+    i32,
+    f64,
+    *mut f64,
+    i32,
+);
+type CZhemm = unsafe extern "C" fn(
+    c_int,
+    c_int,
+    c_int,
+    i32,
+    i32,
+    *const Complex64,
+    *const Complex64,
+    i32,
+    *const Complex64,
+    i32,
+    *const Complex64,
+    *mut Complex64,
+    i32,
+);
+type CSyrk<T> =
+    unsafe extern "C" fn(c_int, c_int, c_int, i32, i32, f64, *const T, i32, f64, *mut T, i32);
+type CDtrxm = unsafe extern "C" fn(
+    c_int,
+    c_int,
+    c_int,
+    c_int,
+    c_int,
+    i32,
+    i32,
+    f64,
+    *const f64,
+    i32,
+    *mut f64,
+    i32,
+);
+type CZtrxm = unsafe extern "C" fn(
+    c_int,
+    c_int,
+    c_int,
+    c_int,
+    c_int,
+    i32,
+    i32,
+    *const Complex64,
+    *const Complex64,
+    i32,
+    *mut Complex64,
+    i32,
+);
+
+/// The replayable routines, in report order.
+const ROUTINES: [&str; 12] = [
+    "dgemm", "zgemm", "dgemv", "zgemv", "dsymm", "zhemm", "dsyrk", "zherk", "dtrsm", "ztrsm",
+    "dtrmm", "ztrmm",
+];
+
+unsafe fn symbol<T: Copy>(lib: &Library, name: &str) -> Option<T> {
+    let name = format!("{name}\0");
+    unsafe { lib.get::<T>(name.as_bytes()).ok().map(|s| *s) }
+}
+
+unsafe fn required<T: Copy>(lib: &Library, name: &str) -> T {
+    unsafe { symbol(lib, name) }.unwrap_or_else(|| panic!("{name} missing from the cdylib"))
+}
+
+/// Fortran entry points of one provider.
+struct Fortran<I> {
+    dgemm: FGemm<f64, I>,
+    zgemm: FGemm<Complex64, I>,
+    dgemv: FGemv<f64, I>,
+    zgemv: FGemv<Complex64, I>,
+    dsymm: FSymm<f64, I>,
+    zhemm: FSymm<Complex64, I>,
+    dsyrk: FSyrk<f64, f64, I>,
+    zherk: FSyrk<Complex64, f64, I>,
+    dtrsm: FTrxm<f64, I>,
+    ztrsm: FTrxm<Complex64, I>,
+    dtrmm: FTrxm<f64, I>,
+    ztrmm: FTrxm<Complex64, I>,
+    _lib: Library,
+}
+
+impl<I> Fortran<I> {
+    unsafe fn load(path: &Path, suffix: &str) -> Option<Self> {
+        let lib = unsafe { Library::new(path) }.ok()?;
+        unsafe {
+            Some(Fortran {
+                dgemm: symbol(&lib, &format!("dgemm{suffix}"))?,
+                zgemm: symbol(&lib, &format!("zgemm{suffix}"))?,
+                dgemv: symbol(&lib, &format!("dgemv{suffix}"))?,
+                zgemv: symbol(&lib, &format!("zgemv{suffix}"))?,
+                dsymm: symbol(&lib, &format!("dsymm{suffix}"))?,
+                zhemm: symbol(&lib, &format!("zhemm{suffix}"))?,
+                dsyrk: symbol(&lib, &format!("dsyrk{suffix}"))?,
+                zherk: symbol(&lib, &format!("zherk{suffix}"))?,
+                dtrsm: symbol(&lib, &format!("dtrsm{suffix}"))?,
+                ztrsm: symbol(&lib, &format!("ztrsm{suffix}"))?,
+                dtrmm: symbol(&lib, &format!("dtrmm{suffix}"))?,
+                ztrmm: symbol(&lib, &format!("ztrmm{suffix}"))?,
+                _lib: lib,
+            })
+        }
+    }
+
+    /// The entry points as `(routine, pointer)` pairs in `ROUTINES` order.
+    fn pointers(&self) -> [(&'static str, *const c_void); 12] {
+        [
+            ("dgemm", self.dgemm as *const c_void),
+            ("zgemm", self.zgemm as *const c_void),
+            ("dgemv", self.dgemv as *const c_void),
+            ("zgemv", self.zgemv as *const c_void),
+            ("dsymm", self.dsymm as *const c_void),
+            ("zhemm", self.zhemm as *const c_void),
+            ("dsyrk", self.dsyrk as *const c_void),
+            ("zherk", self.zherk as *const c_void),
+            ("dtrsm", self.dtrsm as *const c_void),
+            ("ztrsm", self.ztrsm as *const c_void),
+            ("dtrmm", self.dtrmm as *const c_void),
+            ("ztrmm", self.ztrmm as *const c_void),
+        ]
+    }
+}
+
+/// CBLAS entry points of one private copy of the cdylib.
+struct Inject {
+    dgemm: CDgemm,
+    zgemm: CZgemm,
+    dgemv: CDgemv,
+    zgemv: CZgemv,
+    dsymm: CDsymm,
+    zhemm: CZhemm,
+    dsyrk: CSyrk<f64>,
+    zherk: CSyrk<Complex64>,
+    dtrsm: CDtrxm,
+    ztrsm: CZtrxm,
+    dtrmm: CDtrxm,
+    ztrmm: CZtrxm,
+    lib: Library,
+    copy: PathBuf,
+}
+
+impl Inject {
+    /// Load a private copy of `cdylib` so each mode has its own registrations.
+    unsafe fn load(cdylib: &Path, mode: &str) -> Self {
+        let copy = std::env::temp_dir().join(format!(
+            "cblas_inject_replay_{mode}_{}_{}",
+            std::process::id(),
+            cdylib.file_name().unwrap().to_string_lossy()
+        ));
+        fs::copy(cdylib, &copy).expect("copy cdylib");
+        let lib = unsafe { Library::new(&copy) }.expect("load cdylib copy");
+        unsafe {
+            Inject {
+                dgemm: required(&lib, "cblas_dgemm"),
+                zgemm: required(&lib, "cblas_zgemm"),
+                dgemv: required(&lib, "cblas_dgemv"),
+                zgemv: required(&lib, "cblas_zgemv"),
+                dsymm: required(&lib, "cblas_dsymm"),
+                zhemm: required(&lib, "cblas_zhemm"),
+                dsyrk: required(&lib, "cblas_dsyrk"),
+                zherk: required(&lib, "cblas_zherk"),
+                dtrsm: required(&lib, "cblas_dtrsm"),
+                ztrsm: required(&lib, "cblas_ztrsm"),
+                dtrmm: required(&lib, "cblas_dtrmm"),
+                ztrmm: required(&lib, "cblas_ztrmm"),
+                lib,
+                copy,
+            }
+        }
+    }
+
+    unsafe fn register<I>(&self, provider: &Fortran<I>, abi: &str) {
+        type Register = unsafe extern "C" fn(*const c_void) -> c_int;
+        for (name, f) in provider.pointers() {
+            let symbol = format!("cblas_inject_register_{name}_{abi}");
+            let register: Register = unsafe { required(&self.lib, &symbol) };
+            assert_eq!(unsafe { register(f) }, CBLAS_INJECT_STATUS_OK, "{symbol}");
+        }
+    }
+
+    unsafe fn set_small_gemm_max_dim(&self, max_dim: i32) {
+        type Set = unsafe extern "C" fn(i32) -> c_int;
+        let set: Set = unsafe { required(&self.lib, "cblas_inject_set_small_gemm_max_dim") };
+        assert_eq!(unsafe { set(max_dim) }, CBLAS_INJECT_STATUS_OK);
+    }
+}
+
+impl Drop for Inject {
+    fn drop(&mut self) {
+        let _ = fs::remove_file(&self.copy);
+    }
+}
+
+enum Backend {
+    Direct(Fortran<i32>),
+    Inject(Inject),
+}
+
+/// Operands shared by every replayed call.
+struct Operands {
+    d: [Vec<f64>; 3],
+    z: [Vec<Complex64>; 3],
+}
+
+impl Operands {
+    fn new(len: usize) -> Self {
+        let d = |s: f64| (0..len).map(|i| s / (1 + i % 7) as f64).collect::<Vec<_>>();
+        let z = |s: f64| {
+            (0..len)
+                .map(|i| Complex64::new(s / (1 + i % 5) as f64, s / (2 + i % 3) as f64))
+                .collect::<Vec<_>>()
+        };
+        Operands {
+            d: [d(1.0), d(0.5), d(0.25)],
+            z: [z(1.0), z(0.5), z(0.25)],
+        }
+    }
+}
+
+fn trans_char(t: u8) -> c_char {
+    (match t {
+        TRANS => b'T',
+        CONJ_TRANS => b'C',
+        _ => b'N',
+    }) as c_char
+}
+
+fn uplo_char(u: u8) -> c_char {
+    (if u == LOWER { b'L' } else { b'U' }) as c_char
+}
+
+fn side_char(s: u8) -> c_char {
+    (if s == RIGHT { b'R' } else { b'L' }) as c_char
+}
+
+fn diag_char(d: u8) -> c_char {
+    (if d == NON_UNIT { b'N' } else { b'U' }) as c_char
+}
+
+fn flip_uplo(u: u8) -> u8 {
+    if u == UPPER {
+        LOWER
+    } else {
+        UPPER
+    }
+}
+
+fn flip_side(s: u8) -> u8 {
+    if s == LEFT {
+        RIGHT
+    } else {
+        LEFT
+    }
+}
+
+/// Transpose flag after a row-major swap: `NoTrans` becomes `trans` (`T`, or
+/// `C` for a Hermitian update), anything else `NoTrans`.
+fn flip_trans(t: u8, trans: u8) -> u8 {
+    if t == NO_TRANS {
+        trans
+    } else {
+        NO_TRANS
+    }
+}
+
+/// Elements an operand of this record may touch.
+fn operand_len(r: &CblasInjectTraceRecord) -> usize {
+    let dim = r.dims.iter().copied().max().unwrap_or(0).max(1) as usize;
+    let ld = r
+        .lds
+        .iter()
+        .map(|l| l.unsigned_abs())
+        .max()
+        .unwrap_or(0)
+        .max(1) as usize;
+    ld * dim + 1
+}
+
+/// Whether the record is a valid call this harness can replay.
+fn replayable(r: &CblasInjectTraceRecord, name: &str) -> bool {
+    let used_lds = match name {
+        "dsyrk" | "zherk" | "dtrsm" | "ztrsm" | "dtrmm" | "ztrmm" => 2,
+        _ => 3,
+    };
+    ROUTINES.contains(&name)
+        && (r.order == ROW_MAJOR || r.order == COL_MAJOR)
+        && r.dims.iter().all(|&d| d >= 0 && d <= i64::from(i32::MAX))
+        && r.lds[..used_lds]
+            .iter()
+            .all(|&l| l != 0 && l.unsigned_abs() <= i32::MAX as u64)
+}
+
+/// Replay one record through the provider's Fortran symbols.
+unsafe fn replay_direct(
+    f: &Fortran<i32>,
+    name: &str,
+    r: &CblasInjectTraceRecord,
+    ops: &mut Operands,
+) {
+    let [d0, d1, d2, _] = r.dims.map(|d| d as i32);
+    let [l0, l1, l2] = r.lds.map(|l| l as i32);
+    let row = r.order == ROW_MAJOR;
+    let [f0, f1, f2, f3] = r.flags;
+    let (da, db, dc) = (ops.d[0].as_ptr(), ops.d[1].as_ptr(), ops.d[2].as_mut_ptr());
+    let (za, zb, zc) = (ops.z[0].as_ptr(), ops.z[1].as_ptr(), ops.z[2].as_mut_ptr());
+    let (dalpha, dbeta) = (1.0f64, 0.5f64);
+    let (zalpha, zbeta) = (Complex64::new(1.0, 0.5), Complex64::new(0.5, 0.0));
+    unsafe {
+        match name {
+            "dgemm" | "zgemm" => {
+                // Row-major: swap A↔B, m↔n, lda↔ldb, TransA↔TransB
+                let (ta, tb, m, n, lda, ldb) = if row {
+                    (f1, f0, d1, d0, l1, l0)
+                } else {
+                    (f0, f1, d0, d1, l0, l1)
+                };
+                let (ta, tb) = (trans_char(ta), trans_char(tb));
+                if name == "dgemm" {
+                    (f.dgemm)(
+                        &ta, &tb, &m, &n, &d2, &dalpha, da, &lda, db, &ldb, &dbeta, dc, &l2,
+                    );
+                } else {
+                    (f.zgemm)(
+                        &ta, &tb, &m, &n, &d2, &zalpha, za, &lda, zb, &ldb, &zbeta, zc, &l2,
+                    );
+                }
+            }
+            "dgemv" | "zgemv" => {
+                let (t, m, n) = if row {
+                    (flip_trans(f0, TRANS), d1, d0)
+                } else {
+                    (f0, d0, d1)
+                };
+                let t = trans_char(t);
+                if name == "dgemv" {
+                    (f.dgemv)(&t, &m, &n, &dalpha, da, &l0, db, &l1, &dbeta, dc, &l2);
+                } else {
+                    (f.zgemv)(&t, &m, &n, &zalpha, za, &l0, zb, &l1, &zbeta, zc, &l2);
+                }
+            }
+            "dsymm" | "zhemm" => {
+                let (side, uplo, m, n) = if row {
+                    (flip_side(f0), flip_uplo(f1), d1, d0)
+                } else {
+                    (f0, f1, d0, d1)
+                };
+                let (side, uplo) = (side_char(side), uplo_char(uplo));
+                if name == "dsymm" {
+                    (f.dsymm)(
+                        &side, &uplo, &m, &n, &dalpha, da, &l0, db, &l1, &dbeta, dc, &l2,
+                    );
+                } else {
+                    (f.zhemm)(
+                        &side, &uplo, &m, &n, &zalpha, za, &l0, zb, &l1, &zbeta, zc, &l2,
+                    );
+                }
+            }
+            "dsyrk" | "zherk" => {
+                let conj = if name == "dsyrk" { TRANS } else { CONJ_TRANS };
+                let (uplo, t) = if row {
+                    (flip_uplo(f0), flip_trans(f1, conj))
+                } else {
+                    (f0, f1)
+                };
+                let (uplo, t) = (uplo_char(uplo), trans_char(t));
+                if name == "dsyrk" {
+                    (f.dsyrk)(&uplo, &t, &d0, &d1, &dalpha, da, &l0, &dbeta, dc, &l1);
+                } else {
+                    (f.zherk)(&uplo, &t, &d0, &d1, &dalpha, za, &l0, &dbeta, zc, &l1);
+                }
+            }
+            _ => {
+                let (side, uplo, m, n) = if row {
+                    (flip_side(f0), flip_uplo(f1), d1, d0)
+                } else {
+                    (f0, f1, d0, d1)
+                };
+                let (side, uplo) = (side_char(side), uplo_char(uplo));
+                let (t, diag) = (trans_char(f2), diag_char(f3));
+                let (dt, zt) = match name {
+                    "dtrsm" | "ztrsm" => (f.dtrsm, f.ztrsm),
+                    _ => (f.dtrmm, f.ztrmm),
+                };
+                if name.starts_with('d') {
+                    dt(&side, &uplo, &t, &diag, &m, &n, &dalpha, da, &l0, dc, &l1);
+                } else {
+                    zt(&side, &uplo, &t, &diag, &m, &n, &zalpha, za, &l0, zc, &l1);
+                }
+            }
+        }
+    }
+}
+
+/// Replay one record through the cblas-inject LP64 entry points.
+unsafe fn replay_inject(c: &Inject, name: &str, r: &CblasInjectTraceRecord, ops: &mut Operands) {
+    let [d0, d1, d2, _] = r.dims.map(|d| d as i32);
+    let [l0, l1, l2] = r.lds.map(|l| l as i32);
+    let o = c_int::from(r.order);
+    let [f0, f1, f2, f3] = r.flags.map(c_int::from);
+    let (da, db, dc) = (ops.d[0].as_ptr(), ops.d[1].as_ptr(), ops.d[2].as_mut_ptr());
+    let (za, zb, zc) = (ops.z[0].as_ptr(), ops.z[1].as_ptr(), ops.z[2].as_mut_ptr());
+    let (dalpha, dbeta) = (1.0f64, 0.5f64);
+    let (zalpha, zbeta) = (Complex64::new(1.0, 0.5), Complex64::new(0.5, 0.0));
+    unsafe {
+        match name {
+            "dgemm" => (c.dgemm)(o, f0, f1, d0, d1, d2, dalpha, da, l0, db, l1, dbeta, dc, l2),
+            "zgemm" => (c.zgemm)(
+                o, f0, f1, d0, d1, d2, &zalpha, za, l0, zb, l1, &zbeta, zc, l2,
+            ),
+            "dgemv" => (c.dgemv)(o, f0, d0, d1, dalpha, da, l0, db, l1, dbeta, dc, l2),
+            "zgemv" => (c.zgemv)(o, f0, d0, d1, &zalpha, za, l0, zb, l1, &zbeta, zc, l2),
+            "dsymm" => (c.dsymm)(o, f0, f1, d0, d1, dalpha, da, l0, db, l1, dbeta, dc, l2),
+            "zhemm" => (c.zhemm)(o, f0, f1, d0, d1, &zalpha, za, l0, zb, l1, &zbeta, zc, l2),
+            "dsyrk" => (c.dsyrk)(o, f0, f1, d0, d1, dalpha, da, l0, dbeta, dc, l1),
+            "zherk" => (c.zherk)(o, f0, f1, d0, d1, dalpha, za, l0, dbeta, zc, l1),
+            "dtrsm" => (c.dtrsm)(o, f0, f1, f2, f3, d0, d1, dalpha, da, l0, dc, l1),
+            "ztrsm" => (c.ztrsm)(o, f0, f1, f2, f3, d0, d1, &zalpha, za, l0, zc, l1),
+            "dtrmm" => (c.dtrmm)(o, f0, f1, f2, f3, d0, d1, dalpha, da, l0, dc, l1),
+            _ => (c.ztrmm)(o, f0, f1, f2, f3, d0, d1, &zalpha, za, l0, zc, l1),
+        }
+    }
+}
+
+struct Trace {
+    names: Vec<String>,
+    records: Vec<CblasInjectTraceRecord>,
+}
+
+fn read_trace(path: &Path) -> Trace {
+    let bytes = fs::read(path).unwrap_or_else(|e| panic!("read {}: {e}", path.display()));
+    let header_len = mem::size_of::<CblasInjectTraceHeader>();
+    assert!(bytes.len() >= header_len, "truncated trace header");
+    let header: CblasInjectTraceHeader = unsafe { ptr::read_unaligned(bytes.as_ptr().cast()) };
+    assert_eq!(
+        header.magic, CBLAS_INJECT_TRACE_MAGIC,
+        "not a cblas-inject trace"
+    );
+    assert_eq!(
+        header.record_size as usize,
+        mem::size_of::<CblasInjectTraceRecord>(),
+        "unsupported trace version {}",
+        header.version
+    );
+    let name_len = header.name_len as usize;
+    let body = header_len + header.routine_count as usize * name_len;
+    let names = bytes[header_len..body]
+        .chunks(name_len)
+        .map(|s| {
+            let end = s.iter().position(|&b| b == 0).unwrap_or(s.len());
+            String::from_utf8_lossy(&s[..end]).into_owned()
+        })
+        .collect();
+    let records = bytes[body..]
+        .chunks_exact(header.record_size as usize)
+        .map(|r| unsafe { ptr::read_unaligned(r.as_ptr().cast()) })
+        .collect();
+    Trace { names, records }
+}
+
+/// A Lanczos-like mix of small GEMMs, matrix-vector products and solves.
+fn synthetic_trace() -> Trace {
+    let names: Vec<String> = ROUTINES.iter().map(|s| s.to_string()).collect();
+    let index = |name: &str| ROUTINES.iter().position(|&r| r == name).unwrap() as u16;
+    let record = |name, order, flags, dims, lds| CblasInjectTraceRecord {
+        routine: index(name),
+        order,
+        flags,
+        dims,
+        lds,
+        ..Default::default()
+    };
+    let mut records = Vec::new();
+    for _ in 0..200 {
+        records.push(record(
+            "dgemv",
+            COL_MAJOR,
+            [NO_TRANS, 0, 0, 0],
+            [512, 512, 0, 0],
+            [512, 1, 1],
+        ));
+        records.push(record(
+            "dgemm",
+            ROW_MAJOR,
+            [NO_TRANS, TRANS, 0, 0],
+            [8, 8, 8, 0],
+            [8, 8, 8],
+        ));
+        records.push(record(
+            "zgemm",
+            COL_MAJOR,
+            [NO_TRANS, NO_TRANS, 0, 0],
+            [4, 4, 4, 0],
+            [4, 4, 4],
+        ));
+    }
+    for _ in 0..20 {
+        records.push(record(
+            "dgemm",
+            COL_MAJOR,
+            [NO_TRANS, NO_TRANS, 0, 0],
+            [256, 256, 256, 0],
+            [256, 256, 256],
+        ));
+        records.push(record(
+            "dtrsm",
+            COL_MAJOR,
+            [LEFT, LOWER, NO_TRANS, NON_UNIT],
+            [128, 16, 0, 0],
+            [128, 128, 0],
+        ));
+        records.push(record(
+            "zherk",
+            ROW_MAJOR,
+            [UPPER, NO_TRANS, 0, 0],
+            [64, 32, 0, 0],
+            [32, 64, 0],
+        ));
+    }
+    Trace { names, records }
+}
+
+fn cdylib_file_name() -> &'static str {
+    #[cfg(target_os = "windows")]
+    {
+        "cblas_inject.dll"
+    }
+    #[cfg(target_os = "macos")]
+    {
+        "libcblas_inject.dylib"
+    }
+    #[cfg(all(unix, not(target_os = "macos")))]
+    {
+        "libcblas_inject.so"
+    }
+}
+
+fn openblas_file_name() -> &'static str {
+    #[cfg(target_os = "windows")]
+    {
+        "libopenblas.dll"
+    }
+    #[cfg(target_os = "macos")]
+    {
+        "libopenblas.dylib"
+    }
+    #[cfg(all(unix, not(target_os = "macos")))]
+    {
+        "libopenblas.so"
+    }
+}
+
+fn find_cdylib() -> Option<PathBuf> {
+    let mut candidates = Vec::new();
+    if let Ok(exe) = std::env::current_exe() {
+        for dir in exe.ancestors().skip(1).take(2) {
+            candidates.push(dir.join(cdylib_file_name()));
+        }
+    }
+    let target = std::env::var_os("CARGO_TARGET_DIR")
+        .map(PathBuf::from)
+        .unwrap_or_else(|| PathBuf::from(env!("CARGO_MANIFEST_DIR")).join("target"));
+    candidates.push(target.join("release").join(cdylib_file_name()));
+    candidates.push(target.join("debug").join(cdylib_file_name()));
+    candidates.into_iter().find(|p| p.is_file())
+}
+
+#[derive(Default, Clone, Copy)]
+struct Tally {
+    calls: u64,
+    time: Duration,
+}
+
+/// Replay the whole trace once, adding per-routine times to `tallies`.
+fn run_pass(backend: &Backend, trace: &Trace, ops: &mut Operands, tallies: Option<&mut [Tally]>) {
+    let mut tallies = tallies;
+    for r in &trace.records {
+        let name = trace.names[r.routine as usize].as_str();
+        if !replayable(r, name) {
+            continue;
+        }
+        let start = Instant::now();
+        unsafe {
+            match backend {
+                Backend::Direct(f) => replay_direct(f, name, r, ops),
+                Backend::Inject(c) => replay_inject(c, name, r, ops),
+            }
+        }
+        let elapsed = start.elapsed();
+        if let Some(tallies) = tallies.as_deref_mut() {
+            let t = &mut tallies[ROUTINES.iter().position(|&n| n == name).unwrap()];
+            t.calls += 1;
+            t.time += elapsed;
+        }
+    }
+    black_box(&ops.d[2]);
+    black_box(&ops.z[2]);
+}
+
+fn main() {
+    let trace_path = std::env::args().skip(1).find(|a| !a.starts_with('-'));
+    let trace = match &trace_path {
+        Some(path) => read_trace(Path::new(path)),
+        None => synthetic_trace(),
+    };
+    let reps = std::env::var("CBLAS_INJECT_REPLAY_REPS")
+        .ok()
+        .and_then(|s| s.parse().ok())
+        .unwrap_or(3usize);
+
+    let provider_path = std::env::var_os("CBLAS_INJECT_REPLAY_PROVIDER")
+        .map(PathBuf::from)
+        .unwrap_or_else(|| PathBuf::from(openblas_file_name()));
+    let Some(direct) = (unsafe { Fortran::<i32>::load(&provider_path, "_") }) else {
+        eprintln!(
+            "cannot load an LP64 BLAS from {}; set CBLAS_INJECT_REPLAY_PROVIDER",
+            provider_path.display()
+        );
+        return;
+    };
+    let Some(cdylib) = find_cdylib() else {
+        eprintln!("libcblas_inject cdylib not found; run `cargo build --release` first");
+        return;
+    };
+    let suffix64 =
+        std::env::var("CBLAS_INJECT_REPLAY_SUFFIX64").unwrap_or_else(|_| "_64_".to_string());
+    let provider64_path = std::env::var_os("CBLAS_INJECT_REPLAY_PROVIDER64")
+        .map(PathBuf::from)
+        .unwrap_or_else(|| provider_path.clone());
+
+    // Loaded before the modes so it outlives the copy it is registered with.
+    let provider64 = unsafe { Fortran::<i64>::load(&provider64_path, &suffix64) };
+
+    let mut modes: Vec<(&str, Backend)> = Vec::new();
+    unsafe {
+        let lp64 = Inject::load(&cdylib, "lp64");
+        lp64.register(&direct, "lp64");
+        lp64.set_small_gemm_max_dim(0);
+        modes.push(("lp64", Backend::Inject(lp64)));
+
+        match &provider64 {
+            Some(provider64) => {
+                let widened = Inject::load(&cdylib, "widened");
+                widened.register(provider64, "ilp64");
+                widened.set_small_gemm_max_dim(0);
+                modes.push(("widened", Backend::Inject(widened)));
+            }
+            None => eprintln!(
+                "widened: no ILP64 symbols `*{suffix64}` in {}; skipped",
+                provider64_path.display()
+            ),
+        }
+
+        let native = Inject::load(&cdylib, "native");
+        native.register(&direct, "lp64");
+        native.set_small_gemm_max_dim(CBLAS_INJECT_SMALL_GEMM_DIM_LIMIT);
+        modes.push(("native", Backend::Inject(native)));
+    }
+    modes.insert(0, ("direct", Backend::Direct(direct)));
+
+    let len = trace.records.iter().map(operand_len).max().unwrap_or(1);
+    let mut ops = Operands::new(len);
+    // One warmup pass per mode, then round-robin passes so drift in clocks
+    // or provider thread state is spread evenly across the modes.
+    let mut results = vec![vec![Tally::default(); ROUTINES.len()]; modes.len()];
+    for (_, backend) in &modes {
+        run_pass(backend, &trace, &mut ops, None);
+    }
+    for _ in 0..reps {
+        for ((_, backend), tallies) in modes.iter().zip(&mut results) {
+            run_pass(backend, &trace, &mut ops, Some(tallies));
+        }
+    }
+
+    let skipped = trace
+        .records
+        .iter()
+        .filter(|r| !replayable(r, &trace.names[r.routine as usize]))
+        .count();
+    let mut skipped_by_name = BTreeMap::new();
+    for r in &trace.records {
+        let name = &trace.names[r.routine as usize];
+        if !replayable(r, name) {
+            *skipped_by_name.entry(name.as_str()).or_insert(0usize) += 1;
+        }
+    }
+
+    println!("Trace Replay Benchmark");
+    println!("======================");
+    match &trace_path {
+        Some(path) => println!("Trace: {path}"),
+        None => println!("Trace: synthetic workload"),
+    }
+    println!(
+        "Records: {} ({} skipped), passes: {reps}",
+        trace.records.len(),
+        skipped
+    );
+    for (name, count) in &skipped_by_name {
+        println!("  skipped {name}: {count}");
+    }
+    println!("Provider: {}", provider_path.display());
+    println!("Times are per pass; overhead is versus direct.");
+    println!();
+
+    print!("{:<8} {:>8}", "routine", "calls");
+    for (mode, _) in &modes {
+        print!(" {:>12}", format!("{mode} (us)"));
+    }
+    println!();
+    let per_pass_us = |t: Tally| t.time.as_secs_f64() * 1e6 / reps.max(1) as f64;
+    for (i, routine) in ROUTINES.iter().enumerate() {
+        let calls = results[0][i].calls / reps.max(1) as u64;
+        if calls == 0 {
+            continue;
+        }
+        print!("{routine:<8} {calls:>8}");
+        for mode in &results {
+            print!(" {:>12.1}", per_pass_us(mode[i]));
+        }
+        println!();
+        let direct_us = per_pass_us(results[0][i]);
+        print!("{:<8} {:>8}", "", "ns/call");
+        for mode in &results {
+            let delta = (per_pass_us(mode[i]) - direct_us) * 1e3 / calls as f64;
+            print!(" {:>12}", format!("{delta:+.1}"));
+        }
+        println!();
+    }
+
+    let total = |mode: &[Tally]| {
+        mode.iter().fold(Tally::default(), |a, t| Tally {
+            calls: a.calls + t.calls,
+            time: a.time + t.time,
+        })
+    };
+    let direct_total = per_pass_us(total(&results[0]));
+    print!(
+        "{:<8} {:>8}",
+        "total",
+        total(&results[0]).calls / reps.max(1) as u64
+    );
+    for mode in &results {
+        print!(" {:>12.1}", per_pass_us(total(mode)));
+    }
+    println!();
+    print!("{:<8} {:>8}", "", "overhead");
+    for mode in &results {
+        let pct = (per_pass_us(total(mode)) - direct_total) / direct_total * 100.0;
+        print!(" {:>12}", format!("{pct:+.1}%"));
+    }
+    println!();
+}
@@ -1,6 +1,7 @@
 #ifndef CBLAS_INJECT_H
 #define CBLAS_INJECT_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -10,6 +11,12 @@ extern "C" {
 #define CBLAS_INJECT_STATUS_OK 0
 #define CBLAS_INJECT_STATUS_NULL_POINTER 1
 #define CBLAS_INJECT_STATUS_ALREADY_REGISTERED 2
+#define CBLAS_INJECT_STATUS_ALREADY_FINALIZED 3
+#define CBLAS_INJECT_STATUS_INVALID_ARGUMENT 4
+#define CBLAS_INJECT_STATUS_ROUTE_TABLE_FULL 5
+#define CBLAS_INJECT_STATUS_IO_ERROR 6
+#define CBLAS_INJECT_STATUS_LOAD_FAILED 7
+#define CBLAS_INJECT_STATUS_NOT_REGISTERED 8
 
 /*
  * CBLAS layout and transpose values. These are prefixed to avoid conflicts
@@ -131,6 +138,357 @@ int cblas_inject_register_dgemm_ilp64(const void *dgemm);
 int cblas_inject_register_zgemm_lp64(const void *zgemm);
 int cblas_inject_register_zgemm_ilp64(const void *zgemm);
 
+/*
+ * 3M complex GEMM providers (cgemm3m_, zgemm3m_ in OpenBLAS and MKL), with the
+ * zgemm signatures above. cblas_cgemm3m and cblas_zgemm3m use them, falling
+ * back to the regular cgemm/zgemm provider when none is registered.
+ */
+int cblas_inject_register_cgemm3m_lp64(const void *cgemm3m);
+int cblas_inject_register_cgemm3m_ilp64(const void *cgemm3m);
+int cblas_inject_register_zgemm3m_lp64(const void *zgemm3m);
+int cblas_inject_register_zgemm3m_ilp64(const void *zgemm3m);
+
+/*
+ * GEMMT providers (?gemmt_ in MKL, OpenBLAS 0.3.22+ and reference BLAS 3.11+):
+ * uplo, transa, transb, n, k, alpha, a, lda, b, ldb, beta, c, ldc. Without
+ * one, cblas_?gemmt runs blocked calls to the gemm provider. The same entry
+ * points exist for sgemmt and cgemmt.
+ */
+int cblas_inject_register_dgemmt_lp64(const void *dgemmt);
+int cblas_inject_register_dgemmt_ilp64(const void *dgemmt);
+int cblas_inject_register_zgemmt_lp64(const void *zgemmt);
+int cblas_inject_register_zgemmt_ilp64(const void *zgemmt);
+
+/*
+ * Scaled copy/transpose providers (?omatcopy_, ?imatcopy_ in OpenBLAS and
+ * MKL): order, trans, rows, cols, alpha, a, lda, b, ldb for omatcopy and
+ * order, trans, rows, cols, alpha, a, lda, ldb for imatcopy, with order 'C'
+ * or 'R'. Without one, cblas_?omatcopy and cblas_?imatcopy use built-in
+ * kernels. The same entry points exist for the s and c routines.
+ */
+int cblas_inject_register_domatcopy_lp64(const void *domatcopy);
+int cblas_inject_register_domatcopy_ilp64(const void *domatcopy);
+int cblas_inject_register_zomatcopy_lp64(const void *zomatcopy);
+int cblas_inject_register_zomatcopy_ilp64(const void *zomatcopy);
+int cblas_inject_register_dimatcopy_lp64(const void *dimatcopy);
+int cblas_inject_register_dimatcopy_ilp64(const void *dimatcopy);
+int cblas_inject_register_zimatcopy_lp64(const void *zimatcopy);
+int cblas_inject_register_zimatcopy_ilp64(const void *zimatcopy);
+
+/*
+ * Scale-and-add providers (?axpby_ in OpenBLAS and MKL): n, alpha, x, incx,
+ * beta, y, incy. Without one, cblas_?axpby uses a built-in kernel. The same
+ * entry points exist for the s and c routines.
+ */
+int cblas_inject_register_daxpby_lp64(const void *daxpby);
+int cblas_inject_register_daxpby_ilp64(const void *daxpby);
+int cblas_inject_register_zaxpby_lp64(const void *zaxpby);
+int cblas_inject_register_zaxpby_ilp64(const void *zaxpby);
+
+/*
+ * Register an additional provider used for calls of at least min_flops
+ * floating-point operations (2*m*n*k for dgemm, 8*m*n*k for zgemm). The route
+ * with the largest qualifying threshold wins; smaller calls keep using the
+ * provider registered above. Up to four routes per routine are accepted.
+ * The same entry points exist for sgemm, cgemm and the s/d/c/z gemv routines
+ * (2*m*n or 8*m*n flops).
+ */
+int cblas_inject_register_dgemm_route_lp64(const void *dgemm, double min_flops);
+int cblas_inject_register_dgemm_route_ilp64(const void *dgemm, double min_flops);
+int cblas_inject_register_zgemm_route_lp64(const void *zgemm, double min_flops);
+int cblas_inject_register_zgemm_route_ilp64(const void *zgemm, double min_flops);
+
+/*
+ * Compute GEMMs with m, n and k all at most max_dim with built-in SIMD
+ * kernels instead of the registered provider. 0 (the default) disables this;
+ * the largest accepted value is CBLAS_INJECT_SMALL_GEMM_DIM_LIMIT.
+ */
+#define CBLAS_INJECT_SMALL_GEMM_DIM_LIMIT 32
+int cblas_inject_set_small_gemm_max_dim(int max_dim);
+int cblas_inject_small_gemm_max_dim(void);
+
+/*
+ * Run the real swap, copy, axpy, scal, dot, nrm2, asum and i?amax routines
+ * with built-in SIMD kernels when n <= max_n (0, the default, disables this).
+ * The built-in kernels are also used whenever no provider is registered for
+ * one of these routines.
+ */
+int cblas_inject_set_native_blas1_max_n(int64_t max_n);
+int64_t cblas_inject_native_blas1_max_n(void);
+
+/*
+ * Time the registered dgemm, ddot and daxpy against the built-in kernels and
+ * set the small GEMM and native Level 1 thresholds to the measured
+ * crossovers. cache may be NULL; otherwise thresholds stored there for the
+ * same CPU model and provider library are applied without measuring, and a
+ * missing or stale cache is rewritten. Call at startup, before other threads
+ * issue BLAS calls. Returns CBLAS_INJECT_STATUS_IO_ERROR if the cache could
+ * not be written (the tuned thresholds are applied anyway).
+ */
+int cblas_inject_autotune(const char *cache);
+
+/*
+ * Rewrite degenerate GEMM, GEMV, GER and SYRK shapes (on when nonzero; off
+ * by default). Empty outputs, k == 0 and alpha == 0 are handled natively,
+ * one-row or one-column GEMMs go to the registered ?gemv, and single-element
+ * outputs and rank-1 vector updates use built-in dot and axpy kernels.
+ * beta == 0 still overwrites the output without reading it.
+ */
+int cblas_inject_set_shape_rewrite(int on);
+int cblas_inject_shape_rewrite(void);
+
+/*
+ * Freeze all registrations into an immutable dispatch table. Call once after
+ * every provider (and the complex return style) has been registered; later
+ * CBLAS calls then skip the per-routine registration lookups. Routines that
+ * were not registered at this point keep resolving lazily.
+ *
+ * Returns CBLAS_INJECT_STATUS_OK, or CBLAS_INJECT_STATUS_ALREADY_FINALIZED on
+ * repeated calls.
+ */
+int cblas_inject_finalize(void);
+int cblas_inject_is_finalized(void);
+
+/*
+ * Number of threads, including the caller, that cblas-inject uses for work it
+ * splits itself (the items of the batched GEMM entry points, the LP64
+ * blocks of Level 1 and Level 3 _64 calls, and parallel tiles). 0 or 1 (the
+ * default) runs everything on the calling thread; only raise it when the
+ * registered provider is single-threaded.
+ */
+int cblas_inject_set_worker_threads(int threads);
+int cblas_inject_worker_threads(void);
+
+/*
+ * Provider thread-count controls: a global setter, void f(int), such as
+ * openblas_set_num_threads or omp_set_num_threads; a per-thread setter,
+ * int f(int) returning the previous per-thread value, such as
+ * mkl_set_num_threads_local; a getter, int f(void), such as
+ * openblas_get_num_threads; and a probe, int f(void), that is nonzero on a
+ * thread already inside a parallel region, such as omp_in_parallel.
+ * cblas_inject_load_provider registers the controls the library exports.
+ */
+int cblas_inject_register_set_num_threads(const void *set_num_threads);
+int cblas_inject_register_set_num_threads_local(const void *set_num_threads_local);
+int cblas_inject_register_get_num_threads(const void *get_num_threads);
+int cblas_inject_register_parallel_probe(const void *in_parallel);
+
+/*
+ * Set the provider's global thread count (CBLAS_INJECT_STATUS_NOT_REGISTERED
+ * without a global setter), and read it back (0 if unknown).
+ */
+int cblas_inject_set_num_threads(int threads);
+int cblas_inject_num_threads(void);
+
+/*
+ * Make the provider single-threaded on the calling thread until the matching
+ * end call; regions nest. With only a global setter, the provider is
+ * single-threaded for every thread while any region is active.
+ */
+int cblas_inject_begin_single_threaded(void);
+int cblas_inject_end_single_threaded(void);
+
+/*
+ * With the nested guard on, jobs of the cblas-inject worker pool and cblas_*
+ * calls on threads the probe reports as inside a parallel region run in a
+ * single-threaded region. Off (0) by default.
+ */
+int cblas_inject_set_nested_guard(int on);
+int cblas_inject_nested_guard(void);
+
+/*
+ * Largest extent of a split dimension when a _64 call goes to an LP64
+ * provider. Dimensions that can be split (n for the dot, nrm2, asum and
+ * i?amax reductions; m, n and k for gemm; the side of B/C that A does not act
+ * on for trsm, trmm, symm and hemm; k for the rank-k updates) are cut into blocks this size or smaller, and independent blocks
+ * run on the worker pool. The default, INT32_MAX, only splits calls that
+ * could not be narrowed otherwise. The setter returns
+ * CBLAS_INJECT_STATUS_INVALID_ARGUMENT unless max is positive.
+ */
+int cblas_inject_set_lp64_split_max(int max);
+int cblas_inject_lp64_split_max(void);
+
+/*
+ * Tile edge of the parallel driver for single-threaded providers. With a
+ * positive tile and more than one worker thread, cblas_?gemm calls the
+ * provider once per tile x tile block of C, and cblas_?trsm / cblas_?trmm
+ * step through tile-wide diagonal blocks with tiled provider trsm/trmm and
+ * gemm calls. 0 (the default) turns the driver off. The setter returns
+ * CBLAS_INJECT_STATUS_INVALID_ARGUMENT for a negative tile.
+ */
+int cblas_inject_set_parallel_tile(int tile);
+int cblas_inject_parallel_tile(void);
+
+/*
+ * Send cblas_cgemm / cblas_zgemm calls of at least min_flops (8*m*n*k) to the
+ * registered 3M provider, ahead of size routes. 0 (the default) turns this
+ * off; calls without a 3M provider are unaffected. The setter returns
+ * CBLAS_INJECT_STATUS_INVALID_ARGUMENT for a negative or NaN threshold.
+ */
+int cblas_inject_set_gemm3m_min_flops(double min_flops);
+double cblas_inject_gemm3m_min_flops(void);
+
+/*
+ * Opt-in call statistics for every cblas_* routine (the _64 symbols, the 3M
+ * variants and batched GEMM items share their routine's entry). Off by
+ * default, which costs one relaxed atomic load per call. Dimensions are
+ * recorded as passed by the caller, before any row-major swap.
+ *
+ * shape_hist[b] counts calls whose largest dimension d has
+ * 2^(b-1) <= d < 2^b (b = 0 for d = 0); time_hist[b] does the same for the
+ * wall time in microseconds. The last bucket of each is open-ended.
+ */
+#define CBLAS_INJECT_STATS_OFF 0
+#define CBLAS_INJECT_STATS_COUNTS 1
+#define CBLAS_INJECT_STATS_TIMING 2
+#define CBLAS_INJECT_STATS_BUCKETS 16
+
+typedef struct {
+    const char *name;
+    uint64_t calls;
+    uint64_t flops;
+    uint64_t time_ns;
+    uint64_t shape_hist[CBLAS_INJECT_STATS_BUCKETS];
+    uint64_t time_hist[CBLAS_INJECT_STATS_BUCKETS];
+} cblas_inject_routine_stats;
+
+int cblas_inject_set_stats_mode(int mode);
+int cblas_inject_stats_mode(void);
+/* Copies up to len entries and returns the number of routines. */
+int cblas_inject_stats_snapshot(cblas_inject_routine_stats *out, int len);
+void cblas_inject_stats_reset(void);
+
+/*
+ * Binary call trace of the same routines. cblas_inject_trace_start(path), or
+ * CBLAS_INJECT_TRACE=path in the environment, writes a
+ * cblas_inject_trace_header, header.routine_count routine names of
+ * CBLAS_INJECT_TRACE_NAME_LEN bytes (NUL-padded), then one
+ * cblas_inject_trace_record per call in native byte order. Records are
+ * buffered per thread; cblas_inject_trace_stop() drains every buffer and closes
+ * the file (an environment-started trace is also stopped at exit).
+ *
+ * flags holds the CBLAS enum arguments after order, dims the sizes (m, n, k,
+ * kl, ku, or rows and cols) and lds the leading dimensions and increments,
+ * each in signature order (gemv: lda, incx, incy). Unused slots are zero, and
+ * order is 0 for Level 1. Records are grouped by thread; sort by timestamp_ns.
+ */
+#define CBLAS_INJECT_TRACE_VERSION 2
+#define CBLAS_INJECT_TRACE_NAME_LEN 16
+#define CBLAS_INJECT_TRACE_PATH_NATIVE 0   /* built-in kernel */
+#define CBLAS_INJECT_TRACE_PATH_LP64 1     /* LP64 symbol, LP64 provider */
+#define CBLAS_INJECT_TRACE_PATH_ILP64 2    /* _64 symbol, ILP64 provider */
+#define CBLAS_INJECT_TRACE_PATH_WIDENED 3  /* LP64 symbol, ILP64 provider */
+#define CBLAS_INJECT_TRACE_PATH_NARROWED 4 /* _64 symbol, LP64 provider */
+#define CBLAS_INJECT_TRACE_PATH_DEFERRED 5 /* cblas_inject_begin_coalesce */
+
+typedef struct {
+    char magic[8]; /* "CBITRACE" */
+    uint32_t version;
+    uint32_t record_size;
+    uint32_t routine_count;
+    uint32_t name_len;
+} cblas_inject_trace_header;
+
+typedef struct {
+    uint64_t timestamp_ns;
+    uint32_t thread;
+    uint16_t routine;
+    uint8_t path;
+    uint8_t order;
+    uint8_t flags[4];
+    uint32_t reserved;
+    int64_t dims[4];
+    int64_t lds[3];
+} cblas_inject_trace_record;
+
+int cblas_inject_trace_start(const char *path);
+int cblas_inject_trace_stop(void);
+int cblas_inject_trace_active(void);
+
+/*
+ * Open a Fortran BLAS shared library and register every routine it exports
+ * (dgemm_ for CBLAS_INJECT_ABI_LP64; dgemm_64_, dgemm_64 or dgemm_ for
+ * CBLAS_INJECT_ABI_ILP64), detecting the complex return style from zdotc.
+ * Slots that already have a provider keep it. The library is never closed.
+ *
+ * CBLAS_INJECT_PROVIDER=path (and CBLAS_INJECT_PROVIDER_ABI=ilp64) in the
+ * environment does the same the first time a routine is found unregistered.
+ *
+ * Returns CBLAS_INJECT_STATUS_OK, or CBLAS_INJECT_STATUS_LOAD_FAILED if the
+ * library cannot be opened or exports no BLAS symbol.
+ */
+#define CBLAS_INJECT_ABI_LP64 32
+#define CBLAS_INJECT_ABI_ILP64 64
+int cblas_inject_load_provider(const char *path, int abi);
+
+/*
+ * Register one pointer per Fortran routine in a single call, under a single
+ * acquisition of the registration lock. Null slots are skipped. Pass
+ * sizeof(cblas_inject_provider_table) as size; routines are only appended in
+ * later revisions, so slots past size count as null. If status is non-null it
+ * receives CBLAS_INJECT_PROVIDER_TABLE_SLOTS statuses in slot order.
+ * CBLAS_INJECT_PROVIDER_TABLE_FINALIZE also finalizes the dispatch table
+ * before the lock is released. Complex dot slots use the complex return style
+ * set beforehand.
+ *
+ * Returns CBLAS_INJECT_STATUS_OK if every non-null slot was registered,
+ * otherwise the first failing status (CBLAS_INJECT_STATUS_INVALID_ARGUMENT
+ * for a bad version, abi or size).
+ */
+#define CBLAS_INJECT_PROVIDER_TABLE_VERSION 1
+#define CBLAS_INJECT_PROVIDER_TABLE_SLOTS 162
+#define CBLAS_INJECT_PROVIDER_TABLE_FINALIZE 1
+#define CBLAS_INJECT_PROVIDER_TABLE_NATIVE 2
+
+typedef struct {
+    uint32_t version; /* CBLAS_INJECT_PROVIDER_TABLE_VERSION */
+    int32_t abi;      /* CBLAS_INJECT_ABI_LP64 or CBLAS_INJECT_ABI_ILP64 */
+    uint32_t flags;
+    uint32_t reserved;
+    int32_t *status;
+    const void *sswap, *dswap, *cswap, *zswap, *scopy, *dcopy, *ccopy, *zcopy;
+    const void *saxpy, *daxpy, *caxpy, *zaxpy, *sscal, *dscal, *cscal, *zscal,
+        *csscal, *zdscal;
+    const void *srot, *drot, *srotg, *drotg, *srotm, *drotm, *srotmg, *drotmg,
+        *scabs1, *dcabs1;
+    const void *sdot, *ddot, *sdsdot, *dsdot, *snrm2, *dnrm2, *scnrm2, *dznrm2;
+    const void *sasum, *dasum, *scasum, *dzasum, *isamax, *idamax, *icamax,
+        *izamax;
+    const void *sgemv, *dgemv, *cgemv, *zgemv, *sgbmv, *dgbmv, *cgbmv, *zgbmv;
+    const void *ssymv, *dsymv, *chemv, *zhemv, *ssbmv, *dsbmv, *chbmv, *zhbmv;
+    const void *strmv, *dtrmv, *ctrmv, *ztrmv, *strsv, *dtrsv, *ctrsv, *ztrsv;
+    const void *stbmv, *dtbmv, *ctbmv, *ztbmv, *stbsv, *dtbsv, *ctbsv, *ztbsv;
+    const void *sger, *dger, *cgeru, *cgerc, *zgeru, *zgerc, *ssyr, *dsyr,
+        *cher, *zher, *ssyr2, *dsyr2, *cher2, *zher2;
+    const void *sspmv, *dspmv, *chpmv, *zhpmv, *stpmv, *dtpmv, *ctpmv, *ztpmv,
+        *stpsv, *dtpsv, *ctpsv, *ztpsv;
+    const void *sspr, *dspr, *chpr, *zhpr, *sspr2, *dspr2, *chpr2, *zhpr2;
+    const void *sgemm, *dgemm, *cgemm, *zgemm, *ssymm, *dsymm, *csymm, *zsymm,
+        *chemm, *zhemm;
+    const void *ssyrk, *dsyrk, *csyrk, *zsyrk, *cherk, *zherk, *ssyr2k, *dsyr2k,
+        *csyr2k, *zsyr2k, *cher2k, *zher2k;
+    const void *strmm, *dtrmm, *ctrmm, *ztrmm, *strsm, *dtrsm, *ctrsm, *ztrsm;
+    const void *cdotu, *zdotu, *cdotc, *zdotc;
+    const void *cgemm3m, *zgemm3m, *sgemmt, *dgemmt, *cgemmt, *zgemmt;
+    const void *somatcopy, *domatcopy, *comatcopy, *zomatcopy, *simatcopy,
+        *dimatcopy, *cimatcopy, *zimatcopy;
+    const void *saxpby, *daxpby, *caxpby, *zaxpby;
+} cblas_inject_provider_table;
+
+int cblas_inject_register_table(const cblas_inject_provider_table *table, size_t size);
+
+/*
+ * Route the calling thread's CBLAS calls through table until the matching
+ * pop, without affecting other threads. Null slots keep the enclosing scope's
+ * provider, or the global one; CBLAS_INJECT_PROVIDER_TABLE_NATIVE in flags
+ * makes routines with built-in kernels use them at every size they support.
+ * Scopes nest, and the table is copied on push. While no thread has a scope,
+ * the check costs one relaxed load per call.
+ */
+int cblas_inject_push_provider_scope(const cblas_inject_provider_table *table, size_t size);
+int cblas_inject_pop_provider_scope(void);
+int cblas_inject_provider_scope_depth(void);
+
 void cblas_dgemm_64(
     int order,
     int transa,
@@ -163,6 +521,904 @@ void cblas_zgemm_64(
     void *c,
     int64_t ldc);
 
+/*
+ * 3M complex GEMM, with the cblas_?gemm arguments. Unprefixed symbols take
+ * int, _64 symbols take int64_t.
+ */
+void cblas_cgemm3m(
+    int order,
+    int transa,
+    int transb,
+    int m,
+    int n,
+    int k,
+    const void *alpha,
+    const void *a,
+    int lda,
+    const void *b,
+    int ldb,
+    const void *beta,
+    void *c,
+    int ldc);
+
+void cblas_cgemm3m_64(
+    int order,
+    int transa,
+    int transb,
+    int64_t m,
+    int64_t n,
+    int64_t k,
+    const void *alpha,
+    const void *a,
+    int64_t lda,
+    const void *b,
+    int64_t ldb,
+    const void *beta,
+    void *c,
+    int64_t ldc);
+
+void cblas_zgemm3m(
+    int order,
+    int transa,
+    int transb,
+    int m,
+    int n,
+    int k,
+    const void *alpha,
+    const void *a,
+    int lda,
+    const void *b,
+    int ldb,
+    const void *beta,
+    void *c,
+    int ldc);
+
+void cblas_zgemm3m_64(
+    int order,
+    int transa,
+    int transb,
+    int64_t m,
+    int64_t n,
+    int64_t k,
+    const void *alpha,
+    const void *a,
+    int64_t lda,
+    const void *b,
+    int64_t ldb,
+    const void *beta,
+    void *c,
+    int64_t ldc);
+
+/*
+ * C = alpha*op(A)*op(B) + beta*C on the uplo triangle of the n x n matrix C.
+ * The same entry points exist for sgemmt and cgemmt. Unprefixed symbols take
+ * int, _64 symbols take int64_t.
+ */
+void cblas_dgemmt(
+    int order,
+    int uplo,
+    int transa,
+    int transb,
+    int n,
+    int k,
+    double alpha,
+    const double *a,
+    int lda,
+    const double *b,
+    int ldb,
+    double beta,
+    double *c,
+    int ldc);
+
+void cblas_dgemmt_64(
+    int order,
+    int uplo,
+    int transa,
+    int transb,
+    int64_t n,
+    int64_t k,
+    double alpha,
+    const double *a,
+    int64_t lda,
+    const double *b,
+    int64_t ldb,
+    double beta,
+    double *c,
+    int64_t ldc);
+
+void cblas_zgemmt(
+    int order,
+    int uplo,
+    int transa,
+    int transb,
+    int n,
+    int k,
+    const void *alpha,
+    const void *a,
+    int lda,
+    const void *b,
+    int ldb,
+    const void *beta,
+    void *c,
+    int ldc);
+
+void cblas_zgemmt_64(
+    int order,
+    int uplo,
+    int transa,
+    int transb,
+    int64_t n,
+    int64_t k,
+    const void *alpha,
+    const void *a,
+    int64_t lda,
+    const void *b,
+    int64_t ldb,
+    const void *beta,
+    void *c,
+    int64_t ldc);
+
+/*
+ * MKL-compatible batched GEMM. The grouped form takes per-group arrays of
+ * group_count entries and per-item pointer arrays covering every group; the
+ * strided form offsets a, b and c by stridea, strideb and stridec elements
+ * per item. Unprefixed symbols take int, _64 symbols take int64_t.
+ */
+void cblas_dgemm_batch(
+    int order,
+    const int *transa_array,
+    const int *transb_array,
+    const int *m_array,
+    const int *n_array,
+    const int *k_array,
+    const double *alpha_array,
+    const double **a_array,
+    const int *lda_array,
+    const double **b_array,
+    const int *ldb_array,
+    const double *beta_array,
+    double **c_array,
+    const int *ldc_array,
+    int group_count,
+    const int *group_size);
+
+void cblas_dgemm_batch_64(
+    int order,
+    const int *transa_array,
+    const int *transb_array,
+    const int64_t *m_array,
+    const int64_t *n_array,
+    const int64_t *k_array,
+    const double *alpha_array,
+    const double **a_array,
+    const int64_t *lda_array,
+    const double **b_array,
+    const int64_t *ldb_array,
+    const double *beta_array,
+    double **c_array,
+    const int64_t *ldc_array,
+    int64_t group_count,
+    const int64_t *group_size);
+
+void cblas_dgemm_batch_strided(
+    int order,
+    int transa,
+    int transb,
+    int m,
+    int n,
+    int k,
+    double alpha,
+    const double *a,
+    int lda,
+    int stridea,
+    const double *b,
+    int ldb,
+    int strideb,
+    double beta,
+    double *c,
+    int ldc,
+    int stridec,
+    int batch_size);
+
+void cblas_dgemm_batch_strided_64(
+    int order,
+    int transa,
+    int transb,
+    int64_t m,
+    int64_t n,
+    int64_t k,
+    double alpha,
+    const double *a,
+    int64_t lda,
+    int64_t stridea,
+    const double *b,
+    int64_t ldb,
+    int64_t strideb,
+    double beta,
+    double *c,
+    int64_t ldc,
+    int64_t stridec,
+    int64_t batch_size);
+
+void cblas_zgemm_batch(
+    int order,
+    const int *transa_array,
+    const int *transb_array,
+    const int *m_array,
+    const int *n_array,
+    const int *k_array,
+    const void *alpha_array,
+    const void **a_array,
+    const int *lda_array,
+    const void **b_array,
+    const int *ldb_array,
+    const void *beta_array,
+    void **c_array,
+    const int *ldc_array,
+    int group_count,
+    const int *group_size);
+
+void cblas_zgemm_batch_64(
+    int order,
+    const int *transa_array,
+    const int *transb_array,
+    const int64_t *m_array,
+    const int64_t *n_array,
+    const int64_t *k_array,
+    const void *alpha_array,
+    const void **a_array,
+    const int64_t *lda_array,
+    const void **b_array,
+    const int64_t *ldb_array,
+    const void *beta_array,
+    void **c_array,
+    const int64_t *ldc_array,
+    int64_t group_count,
+    const int64_t *group_size);
+
+void cblas_zgemm_batch_strided(
+    int order,
+    int transa,
+    int transb,
+    int m,
+    int n,
+    int k,
+    const void *alpha,
+    const void *a,
+    int lda,
+    int stridea,
+    const void *b,
+    int ldb,
+    int strideb,
+    const void *beta,
+    void *c,
+    int ldc,
+    int stridec,
+    int batch_size);
+
+void cblas_zgemm_batch_strided_64(
+    int order,
+    int transa,
+    int transb,
+    int64_t m,
+    int64_t n,
+    int64_t k,
+    const void *alpha,
+    const void *a,
+    int64_t lda,
+    int64_t stridea,
+    const void *b,
+    int64_t ldb,
+    int64_t strideb,
+    const void *beta,
+    void *c,
+    int64_t ldc,
+    int64_t stridec,
+    int64_t batch_size);
+
+/*
+ * Asynchronous GEMM and TRSM. The _async entry points take the cblas_?gemm /
+ * cblas_?trsm arguments, queue the call on background threads and return at
+ * once; when handle is non-null it receives a completion handle. A queued
+ * call waits for earlier unfinished calls whose matrices overlap memory it
+ * writes, or whose output overlaps memory it reads. Ready calls of equal
+ * shape and scalars run together across the worker pool, each through its
+ * _64 entry point. Scalars are copied; matrices must stay
+ * valid until the call completes. Argument errors go to cblas_xerbla when
+ * the call runs.
+ *
+ * cblas_inject_async_test returns 1 once the call has completed (or for a
+ * null handle); cblas_inject_async_wait blocks until it has and releases the
+ * handle; cblas_inject_async_wait_all blocks until the queue is empty.
+ */
+typedef struct cblas_inject_async cblas_inject_async;
+
+int cblas_inject_dgemm_async(
+    int order,
+    int transa,
+    int transb,
+    int m,
+    int n,
+    int k,
+    double alpha,
+    const double *a,
+    int lda,
+    const double *b,
+    int ldb,
+    double beta,
+    double *c,
+    int ldc,
+    cblas_inject_async **handle);
+
+int cblas_inject_dgemm_async_64(
+    int order,
+    int transa,
+    int transb,
+    int64_t m,
+    int64_t n,
+    int64_t k,
+    double alpha,
+    const double *a,
+    int64_t lda,
+    const double *b,
+    int64_t ldb,
+    double beta,
+    double *c,
+    int64_t ldc,
+    cblas_inject_async **handle);
+
+int cblas_inject_zgemm_async(
+    int order,
+    int transa,
+    int transb,
+    int m,
+    int n,
+    int k,
+    const void *alpha,
+    const void *a,
+    int lda,
+    const void *b,
+    int ldb,
+    const void *beta,
+    void *c,
+    int ldc,
+    cblas_inject_async **handle);
+
+int cblas_inject_zgemm_async_64(
+    int order,
+    int transa,
+    int transb,
+    int64_t m,
+    int64_t n,
+    int64_t k,
+    const void *alpha,
+    const void *a,
+    int64_t lda,
+    const void *b,
+    int64_t ldb,
+    const void *beta,
+    void *c,
+    int64_t ldc,
+    cblas_inject_async **handle);
+
+int cblas_inject_dtrsm_async(
+    int order,
+    int side,
+    int uplo,
+    int trans,
+    int diag,
+    int m,
+    int n,
+    double alpha,
+    const double *a,
+    int lda,
+    double *b,
+    int ldb,
+    cblas_inject_async **handle);
+
+int cblas_inject_dtrsm_async_64(
+    int order,
+    int side,
+    int uplo,
+    int trans,
+    int diag,
+    int64_t m,
+    int64_t n,
+    double alpha,
+    const double *a,
+    int64_t lda,
+    double *b,
+    int64_t ldb,
+    cblas_inject_async **handle);
+
+int cblas_inject_ztrsm_async(
+    int order,
+    int side,
+    int uplo,
+    int trans,
+    int diag,
+    int m,
+    int n,
+    const void *alpha,
+    const void *a,
+    int lda,
+    void *b,
+    int ldb,
+    cblas_inject_async **handle);
+
+int cblas_inject_ztrsm_async_64(
+    int order,
+    int side,
+    int uplo,
+    int trans,
+    int diag,
+    int64_t m,
+    int64_t n,
+    const void *alpha,
+    const void *a,
+    int64_t lda,
+    void *b,
+    int64_t ldb,
+    cblas_inject_async **handle);
+
+int cblas_inject_async_test(const cblas_inject_async *handle);
+int cblas_inject_async_wait(cblas_inject_async *handle);
+int cblas_inject_async_wait_all(void);
+
+/*
+ * Coalesce same-matrix Level 2 calls on the calling thread. After
+ * cblas_inject_begin_coalesce, cblas_?gemv, cblas_?trsv and cblas_?tbsv
+ * calls (and their _64 forms) are deferred. Consecutive calls with the same
+ * matrix and arguments but independent vectors are grouped, and each group
+ * runs as one ?gemm, one left-sided ?trsm, or one built-in multi-vector band
+ * solve. A call that reads or writes an earlier deferred call's output
+ * starts a new group. cblas_inject_flush_coalesce runs what is pending and
+ * stops deferring. Until then the caller must not use the outputs of
+ * deferred calls, or change their inputs, other than through these routines.
+ */
+int cblas_inject_begin_coalesce(void);
+int cblas_inject_flush_coalesce(void);
+
+/*
+ * OpenBLAS-compatible scaled matrix copy: B = alpha*op(A) out of place, and
+ * A = alpha*op(A) in place with the leading dimension changing from lda to
+ * ldb. trans may also be CblasConjNoTrans. The same entry points exist for
+ * the s and c routines. Unprefixed symbols take int, _64 symbols take int64_t.
+ */
+void cblas_domatcopy(
+    int order,
+    int trans,
+    int rows,
+    int cols,
+    double alpha,
+    const double *a,
+    int lda,
+    double *b,
+    int ldb);
+
+void cblas_domatcopy_64(
+    int order,
+    int trans,
+    int64_t rows,
+    int64_t cols,
+    double alpha,
+    const double *a,
+    int64_t lda,
+    double *b,
+    int64_t ldb);
+
+void cblas_zomatcopy(
+    int order,
+    int trans,
+    int rows,
+    int cols,
+    const void *alpha,
+    const void *a,
+    int lda,
+    void *b,
+    int ldb);
+
+void cblas_zomatcopy_64(
+    int order,
+    int trans,
+    int64_t rows,
+    int64_t cols,
+    const void *alpha,
+    const void *a,
+    int64_t lda,
+    void *b,
+    int64_t ldb);
+
+void cblas_dimatcopy(
+    int order,
+    int trans,
+    int rows,
+    int cols,
+    double alpha,
+    double *a,
+    int lda,
+    int ldb);
+
+void cblas_dimatcopy_64(
+    int order,
+    int trans,
+    int64_t rows,
+    int64_t cols,
+    double alpha,
+    double *a,
+    int64_t lda,
+    int64_t ldb);
+
+void cblas_zimatcopy(
+    int order,
+    int trans,
+    int rows,
+    int cols,
+    const void *alpha,
+    void *a,
+    int lda,
+    int ldb);
+
+void cblas_zimatcopy_64(
+    int order,
+    int trans,
+    int64_t rows,
+    int64_t cols,
+    const void *alpha,
+    void *a,
+    int64_t lda,
+    int64_t ldb);
+
+/*
+ * Dense to packed (_tp) and band (_gb, _tb with k off-diagonals) storage and
+ * back. a_order is the layout of the dense matrix and p_order the order the
+ * packed or band routine will be called with; they may differ. Unpacking a
+ * band zeroes the dense elements outside it, while unpacking _tp leaves the
+ * other triangle alone. Always computed by the built-in kernels. The same
+ * entry points exist for the s and c routines. Unprefixed symbols take int,
+ * _64 symbols take int64_t.
+ */
+void cblas_inject_dpack_tp(
+    int a_order,
+    int p_order,
+    int uplo,
+    int n,
+    const double *a,
+    int lda,
+    double *ap);
+
+void cblas_inject_dpack_tp_64(
+    int a_order,
+    int p_order,
+    int uplo,
+    int64_t n,
+    const double *a,
+    int64_t lda,
+    double *ap);
+
+void cblas_inject_zpack_tp(
+    int a_order,
+    int p_order,
+    int uplo,
+    int n,
+    const void *a,
+    int lda,
+    void *ap);
+
+void cblas_inject_zpack_tp_64(
+    int a_order,
+    int p_order,
+    int uplo,
+    int64_t n,
+    const void *a,
+    int64_t lda,
+    void *ap);
+
+void cblas_inject_dunpack_tp(
+    int a_order,
+    int p_order,
+    int uplo,
+    int n,
+    const double *ap,
+    double *a,
+    int lda);
+
+void cblas_inject_dunpack_tp_64(
+    int a_order,
+    int p_order,
+    int uplo,
+    int64_t n,
+    const double *ap,
+    double *a,
+    int64_t lda);
+
+void cblas_inject_zunpack_tp(
+    int a_order,
+    int p_order,
+    int uplo,
+    int n,
+    const void *ap,
+    void *a,
+    int lda);
+
+void cblas_inject_zunpack_tp_64(
+    int a_order,
+    int p_order,
+    int uplo,
+    int64_t n,
+    const void *ap,
+    void *a,
+    int64_t lda);
+
+void cblas_inject_dpack_gb(
+    int a_order,
+    int p_order,
+    int m,
+    int n,
+    int kl,
+    int ku,
+    const double *a,
+    int lda,
+    double *ab,
+    int ldab);
+
+void cblas_inject_dpack_gb_64(
+    int a_order,
+    int p_order,
+    int64_t m,
+    int64_t n,
+    int64_t kl,
+    int64_t ku,
+    const double *a,
+    int64_t lda,
+    double *ab,
+    int64_t ldab);
+
+void cblas_inject_zpack_gb(
+    int a_order,
+    int p_order,
+    int m,
+    int n,
+    int kl,
+    int ku,
+    const void *a,
+    int lda,
+    void *ab,
+    int ldab);
+
+void cblas_inject_zpack_gb_64(
+    int a_order,
+    int p_order,
+    int64_t m,
+    int64_t n,
+    int64_t kl,
+    int64_t ku,
+    const void *a,
+    int64_t lda,
+    void *ab,
+    int64_t ldab);
+
+void cblas_inject_dunpack_gb(
+    int a_order,
+    int p_order,
+    int m,
+    int n,
+    int kl,
+    int ku,
+    const double *ab,
+    int ldab,
+    double *a,
+    int lda);
+
+void cblas_inject_dunpack_gb_64(
+    int a_order,
+    int p_order,
+    int64_t m,
+    int64_t n,
+    int64_t kl,
+    int64_t ku,
+    const double *ab,
+    int64_t ldab,
+    double *a,
+    int64_t lda);
+
+void cblas_inject_zunpack_gb(
+    int a_order,
+    int p_order,
+    int m,
+    int n,
+    int kl,
+    int ku,
+    const void *ab,
+    int ldab,
+    void *a,
+    int lda);
+
+void cblas_inject_zunpack_gb_64(
+    int a_order,
+    int p_order,
+    int64_t m,
+    int64_t n,
+    int64_t kl,
+    int64_t ku,
+    const void *ab,
+    int64_t ldab,
+    void *a,
+    int64_t lda);
+
+void cblas_inject_dpack_tb(
+    int a_order,
+    int p_order,
+    int uplo,
+    int n,
+    int k,
+    const double *a,
+    int lda,
+    double *ab,
+    int ldab);
+
+void cblas_inject_dpack_tb_64(
+    int a_order,
+    int p_order,
+    int uplo,
+    int64_t n,
+    int64_t k,
+    const double *a,
+    int64_t lda,
+    double *ab,
+    int64_t ldab);
+
+void cblas_inject_zpack_tb(
+    int a_order,
+    int p_order,
+    int uplo,
+    int n,
+    int k,
+    const void *a,
+    int lda,
+    void *ab,
+    int ldab);
+
+void cblas_inject_zpack_tb_64(
+    int a_order,
+    int p_order,
+    int uplo,
+    int64_t n,
+    int64_t k,
+    const void *a,
+    int64_t lda,
+    void *ab,
+    int64_t ldab);
+
+void cblas_inject_dunpack_tb(
+    int a_order,
+    int p_order,
+    int uplo,
+    int n,
+    int k,
+    const double *ab,
+    int ldab,
+    double *a,
+    int lda);
+
+void cblas_inject_dunpack_tb_64(
+    int a_order,
+    int p_order,
+    int uplo,
+    int64_t n,
+    int64_t k,
+    const double *ab,
+    int64_t ldab,
+    double *a,
+    int64_t lda);
+
+void cblas_inject_zunpack_tb(
+    int a_order,
+    int p_order,
+    int uplo,
+    int n,
+    int k,
+    const void *ab,
+    int ldab,
+    void *a,
+    int lda);
+
+void cblas_inject_zunpack_tb_64(
+    int a_order,
+    int p_order,
+    int uplo,
+    int64_t n,
+    int64_t k,
+    const void *ab,
+    int64_t ldab,
+    void *a,
+    int64_t lda);
+
+/*
+ * OpenBLAS-compatible y = alpha*x + beta*y. The same entry points exist for
+ * the s and c routines. Unprefixed symbols take int, _64 symbols take int64_t.
+ */
+void cblas_daxpby(
+    int n,
+    double alpha,
+    const double *x,
+    int incx,
+    double beta,
+    double *y,
+    int incy);
+
+void cblas_daxpby_64(
+    int64_t n,
+    double alpha,
+    const double *x,
+    int64_t incx,
+    double beta,
+    double *y,
+    int64_t incy);
+
+void cblas_zaxpby(
+    int n,
+    const void *alpha,
+    const void *x,
+    int incx,
+    const void *beta,
+    void *y,
+    int incy);
+
+void cblas_zaxpby_64(
+    int64_t n,
+    const void *alpha,
+    const void *x,
+    int64_t incx,
+    const void *beta,
+    void *y,
+    int64_t incy);
+
+/*
+ * Fused y = alpha*x + y followed by the dot product of z with the updated y,
+ * in one sweep over y. z may be y itself (with incz == incy); otherwise it
+ * must not overlap y. Always computed by the built-in kernel.
+ */
+float cblas_inject_saxpy_dot(
+    int n,
+    float alpha,
+    const float *x,
+    int incx,
+    float *y,
+    int incy,
+    const float *z,
+    int incz);
+
+float cblas_inject_saxpy_dot_64(
+    int64_t n,
+    float alpha,
+    const float *x,
+    int64_t incx,
+    float *y,
+    int64_t incy,
+    const float *z,
+    int64_t incz);
+
+double cblas_inject_daxpy_dot(
+    int n,
+    double alpha,
+    const double *x,
+    int incx,
+    double *y,
+    int incy,
+    const double *z,
+    int incz);
+
+double cblas_inject_daxpy_dot_64(
+    int64_t n,
+    double alpha,
+    const double *x,
+    int64_t incx,
+    double *y,
+    int64_t incy,
+    const double *z,
+    int64_t incz);
+
 #ifdef __cplusplus
 }
 #endif
@@ -3,6 +3,11 @@
 //! This module uses the `ctor` crate to automatically register Fortran BLAS
 //! function pointers when the library is loaded. This is required for the
 //! cdylib build to work with OpenBLAS ctest.
+//!
+//! With `openblas-lazy` nothing runs at load time. Each routine registers its
+//! OpenBLAS symbol the first time a call finds its slot empty, so startup
+//! does not depend on the number of routines, and later calls take the same
+//! `OnceLock` fast path as with eager registration.
 
 use crate::backend::*;
 use crate::types::ComplexReturnStyle;
@@ -235,6 +240,158 @@ extern "C" {
         c: *mut (),
         ldc: *const i32,
     );
+    fn cgemm3m_(
+        transa: *const i8,
+        transb: *const i8,
+        m: *const i32,
+        n: *const i32,
+        k: *const i32,
+        alpha: *const (),
+        a: *const (),
+        lda: *const i32,
+        b: *const (),
+        ldb: *const i32,
+        beta: *const (),
+        c: *mut (),
+        ldc: *const i32,
+    );
+    fn zgemm3m_(
+        transa: *const i8,
+        transb: *const i8,
+        m: *const i32,
+        n: *const i32,
+        k: *const i32,
+        alpha: *const (),
+        a: *const (),
+        lda: *const i32,
+        b: *const (),
+        ldb: *const i32,
+        beta: *const (),
+        c: *mut (),
+        ldc: *const i32,
+    );
+    fn saxpby_(
+        n: *const i32,
+        alpha: *const (),
+        x: *const (),
+        incx: *const i32,
+        beta: *const (),
+        y: *mut (),
+        incy: *const i32,
+    );
+    fn daxpby_(
+        n: *const i32,
+        alpha: *const (),
+        x: *const (),
+        incx: *const i32,
+        beta: *const (),
+        y: *mut (),
+        incy: *const i32,
+    );
+    fn caxpby_(
+        n: *const i32,
+        alpha: *const (),
+        x: *const (),
+        incx: *const i32,
+        beta: *const (),
+        y: *mut (),
+        incy: *const i32,
+    );
+    fn openblas_set_num_threads(threads: i32);
+    fn openblas_get_num_threads() -> i32;
+    fn zaxpby_(
+        n: *const i32,
+        alpha: *const (),
+        x: *const (),
+        incx: *const i32,
+        beta: *const (),
+        y: *mut (),
+        incy: *const i32,
+    );
+    fn somatcopy_(
+        order: *const i8,
+        trans: *const i8,
+        rows: *const i32,
+        cols: *const i32,
+        alpha: *const (),
+        a: *const (),
+        lda: *const i32,
+        b: *mut (),
+        ldb: *const i32,
+    );
+    fn simatcopy_(
+        order: *const i8,
+        trans: *const i8,
+        rows: *const i32,
+        cols: *const i32,
+        alpha: *const (),
+        a: *mut (),
+        lda: *const i32,
+        ldb: *const i32,
+    );
+    fn domatcopy_(
+        order: *const i8,
+        trans: *const i8,
+        rows: *const i32,
+        cols: *const i32,
+        alpha: *const (),
+        a: *const (),
+        lda: *const i32,
+        b: *mut (),
+        ldb: *const i32,
+    );
+    fn dimatcopy_(
+        order: *const i8,
+        trans: *const i8,
+        rows: *const i32,
+        cols: *const i32,
+        alpha: *const (),
+        a: *mut (),
+        lda: *const i32,
+        ldb: *const i32,
+    );
+    fn comatcopy_(
+        order: *const i8,
+        trans: *const i8,
+        rows: *const i32,
+        cols: *const i32,
+        alpha: *const (),
+        a: *const (),
+        lda: *const i32,
+        b: *mut (),
+        ldb: *const i32,
+    );
+    fn cimatcopy_(
+        order: *const i8,
+        trans: *const i8,
+        rows: *const i32,
+        cols: *const i32,
+        alpha: *const (),
+        a: *mut (),
+        lda: *const i32,
+        ldb: *const i32,
+    );
+    fn zomatcopy_(
+        order: *const i8,
+        trans: *const i8,
+        rows: *const i32,
+        cols: *const i32,
+        alpha: *const (),
+        a: *const (),
+        lda: *const i32,
+        b: *mut (),
+        ldb: *const i32,
+    );
+    fn zimatcopy_(
+        order: *const i8,
+        trans: *const i8,
+        rows: *const i32,
+        cols: *const i32,
+        alpha: *const (),
+        a: *mut (),
+        lda: *const i32,
+        ldb: *const i32,
+    );
 
     fn ssymm_(
         side: *const i8,
@@ -1328,6 +1485,7 @@ extern "C" {
     );
 }
 
+#[cfg(not(feature = "openblas-lazy"))]
 #[ctor::ctor]
 fn register_all_blas() {
     unsafe {
@@ -1491,6 +1649,8 @@ fn register_all_blas() {
         register_dgemm(std::mem::transmute(dgemm_ as *const ()));
         register_cgemm(std::mem::transmute(cgemm_ as *const ()));
         register_zgemm(std::mem::transmute(zgemm_ as *const ()));
+        cblas_inject_register_cgemm3m_lp64(cgemm3m_ as *const std::ffi::c_void);
+        cblas_inject_register_zgemm3m_lp64(zgemm3m_ as *const std::ffi::c_void);
         register_ssymm(std::mem::transmute(ssymm_ as *const ()));
         register_dsymm(std::mem::transmute(dsymm_ as *const ()));
         register_csymm(std::mem::transmute(csymm_ as *const ()));
@@ -1517,5 +1677,92 @@ fn register_all_blas() {
         register_strsm(std::mem::transmute(strsm_ as *const ()));
         register_ctrsm(std::mem::transmute(ctrsm_ as *const ()));
         register_ztrsm(std::mem::transmute(ztrsm_ as *const ()));
+        cblas_inject_register_somatcopy_lp64(somatcopy_ as *const std::ffi::c_void);
+        cblas_inject_register_domatcopy_lp64(domatcopy_ as *const std::ffi::c_void);
+        cblas_inject_register_comatcopy_lp64(comatcopy_ as *const std::ffi::c_void);
+        cblas_inject_register_zomatcopy_lp64(zomatcopy_ as *const std::ffi::c_void);
+        cblas_inject_register_simatcopy_lp64(simatcopy_ as *const std::ffi::c_void);
+        cblas_inject_register_dimatcopy_lp64(dimatcopy_ as *const std::ffi::c_void);
+        cblas_inject_register_cimatcopy_lp64(cimatcopy_ as *const std::ffi::c_void);
+        cblas_inject_register_zimatcopy_lp64(zimatcopy_ as *const std::ffi::c_void);
+        cblas_inject_register_saxpby_lp64(saxpby_ as *const std::ffi::c_void);
+        cblas_inject_register_daxpby_lp64(daxpby_ as *const std::ffi::c_void);
+        cblas_inject_register_caxpby_lp64(caxpby_ as *const std::ffi::c_void);
+        cblas_inject_register_zaxpby_lp64(zaxpby_ as *const std::ffi::c_void);
+
+        // Thread-count control
+        crate::threads::cblas_inject_register_set_num_threads(
+            openblas_set_num_threads as *const std::ffi::c_void,
+        );
+        crate::threads::cblas_inject_register_get_num_threads(
+            openblas_get_num_threads as *const std::ffi::c_void,
+        );
+    }
+}
+
+macro_rules! define_lazy_symbols {
+    ($($name:ident)*) => {
+        paste::paste! {
+            /// Routines [`register_lazy`] can register.
+            #[cfg(feature = "openblas-lazy")]
+            const LAZY_ROUTINES: &[&str] = &[$(stringify!($name),)*];
+
+            /// Address of the OpenBLAS symbol for routine `name`.
+            #[cfg(feature = "openblas-lazy")]
+            fn openblas_symbol(name: &str) -> Option<*const std::ffi::c_void> {
+                match name {
+                    $(stringify!($name) => Some([<$name _>] as *const std::ffi::c_void),)*
+                    _ => None,
+                }
+            }
+        }
+    };
+}
+
+define_lazy_symbols! {
+    srot srotg srotm srotmg sswap scopy saxpy sscal sdot sdsdot snrm2 sasum isamax
+    drot drotg drotm drotmg dswap dcopy daxpy dscal ddot dsdot dnrm2 dasum idamax
+    cswap ccopy caxpy cscal csscal cdotu cdotc scnrm2 scasum icamax
+    zswap zcopy zaxpy zscal zdscal zdotu zdotc dznrm2 dzasum izamax
+    sgemv dgemv cgemv zgemv sgbmv dgbmv cgbmv zgbmv
+    ssymv dsymv chemv zhemv ssbmv dsbmv chbmv zhbmv
+    strmv dtrmv ctrmv ztrmv strsv dtrsv ctrsv ztrsv
+    stbmv dtbmv ctbmv ztbmv stbsv dtbsv ctbsv ztbsv
+    sger dger cgeru cgerc zgeru zgerc ssyr dsyr cher zher ssyr2 dsyr2 cher2 zher2
+    sspmv dspmv chpmv zhpmv stpmv dtpmv ctpmv ztpmv stpsv dtpsv ctpsv ztpsv
+    sspr dspr chpr zhpr sspr2 dspr2 chpr2 zhpr2
+    sgemm dgemm cgemm zgemm ssymm dsymm csymm zsymm chemm zhemm
+    ssyrk dsyrk csyrk zsyrk cherk zherk ssyr2k dsyr2k csyr2k zsyr2k cher2k zher2k
+    strmm dtrmm ctrmm ztrmm strsm dtrsm ctrsm ztrsm
+    cgemm3m zgemm3m
+    somatcopy domatcopy comatcopy zomatcopy simatcopy dimatcopy cimatcopy zimatcopy
+    saxpby daxpby caxpby zaxpby
+}
+
+/// Register routine `name` from OpenBLAS; true if its LP64 slot is filled.
+#[cfg(feature = "openblas-lazy")]
+#[cold]
+pub(crate) fn register_lazy(name: &str) -> bool {
+    let Some(f) = openblas_symbol(name) else {
+        return false;
+    };
+    // OpenBLAS returns complex dots by value; a different style set by the
+    // host would make those calls unsound.
+    if matches!(name, "cdotu" | "zdotu" | "cdotc" | "zdotc")
+        && !try_set_complex_return_style(ComplexReturnStyle::ReturnValue)
+    {
+        return false;
+    }
+    matches!(
+        unsafe { crate::provider::register_lp64(name, f) },
+        CBLAS_INJECT_STATUS_OK | CBLAS_INJECT_STATUS_ALREADY_REGISTERED
+    )
+}
+
+/// Register every routine that is still unregistered, before finalizing.
+#[cfg(feature = "openblas-lazy")]
+pub(crate) fn register_all_lazy() {
+    for name in LAZY_ROUTINES {
+        register_lazy(name);
     }
 }
@@ -0,0 +1,296 @@
+//! Runtime tuning of the native-versus-provider crossover thresholds.
+//!
+//! `cblas_inject_autotune(cache)` times square `cblas_dgemm` calls and
+//! `cblas_ddot` / `cblas_daxpy` calls of growing size, once on the
+//! registered provider and once on the built-in kernels, and sets the small
+//! GEMM and native Level 1 thresholds to the largest measured size up to
+//! which the built-in path won at every size. The timing loop is the one of
+//! `benches/blas1_overhead.rs`, run through the public entry points so both
+//! sides pay the same wrapper overhead.
+//!
+//! With a cache path, thresholds found earlier for the same CPU model and
+//! provider library are loaded instead of measured, so a host can call this
+//! at every startup and only the first run on a machine spends time tuning.
+//! The cache is a small `key=value` text file:
+//!
+//! ```text
+//! format=1
+//! cpu=<model name from /proc/cpuinfo, or the target architecture>
+//! provider=<library loaded by cblas_inject_load_provider, or ->
+//! small_gemm_max_dim=12
+//! native_blas1_max_n=64
+//! ```
+//!
+//! A routine family without a registered provider is not tuned and keeps
+//! its current threshold; its line is then missing from the cache.
+
+use std::ffi::{c_char, CStr};
+use std::fs;
+use std::hint::black_box;
+use std::sync::Mutex;
+use std::time::{Duration, Instant};
+
+use crate::backend::{
+    resolve_dgemm_for_current_cblas, try_get_daxpy_for_lp64_cblas, try_get_ddot_for_lp64_cblas,
+    CBLAS_INJECT_STATUS_IO_ERROR, CBLAS_INJECT_STATUS_OK,
+};
+use crate::blas1::dot::cblas_ddot;
+use crate::blas1::vector::cblas_daxpy;
+use crate::blas3::gemm::cblas_dgemm;
+use crate::native::blas1::{cblas_inject_native_blas1_max_n, cblas_inject_set_native_blas1_max_n};
+use crate::native::gemm::{
+    cblas_inject_set_small_gemm_max_dim, cblas_inject_small_gemm_max_dim,
+    CBLAS_INJECT_SMALL_GEMM_DIM_LIMIT,
+};
+use crate::provider;
+use crate::types::{CblasColMajor, CblasNoTrans};
+
+const CACHE_FORMAT: &str = "1";
+/// Square GEMM orders timed for the small GEMM crossover.
+const GEMM_DIMS: [i32; 12] = [1, 2, 3, 4, 6, 8, 12, 16, 20, 24, 28, 32];
+/// Vector lengths timed for the Level 1 crossover.
+const BLAS1_LENGTHS: [i32; 13] = [1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096];
+const ROUNDS: usize = 3;
+const ROUND_TIME: Duration = Duration::from_micros(200);
+
+/// Serializes tuning runs, which flip the process-wide thresholds.
+static TUNING: Mutex<()> = Mutex::new(());
+
+struct Thresholds {
+    small_gemm_max_dim: Option<i32>,
+    native_blas1_max_n: Option<i64>,
+}
+
+impl Thresholds {
+    fn apply(&self) {
+        if let Some(d) = self.small_gemm_max_dim {
+            cblas_inject_set_small_gemm_max_dim(d);
+        }
+        if let Some(n) = self.native_blas1_max_n {
+            cblas_inject_set_native_blas1_max_n(n);
+        }
+    }
+}
+
+/// Best time per call over a few rounds, each long enough to swamp timer
+/// resolution.
+fn time_per_call(mut f: impl FnMut()) -> f64 {
+    f();
+    let mut best = f64::INFINITY;
+    for _ in 0..ROUNDS {
+        let start = Instant::now();
+        let mut calls = 0u32;
+        while start.elapsed() < ROUND_TIME || calls == 0 {
+            f();
+            calls += 1;
+        }
+        best = best.min(start.elapsed().as_secs_f64() / f64::from(calls));
+    }
+    best
+}
+
+/// Largest size up to which the built-in path won at every size (0 if it
+/// lost at the first).
+fn crossover(sizes: &[i32], mut native_wins: impl FnMut(i32) -> bool) -> i32 {
+    let mut best = 0;
+    for &size in sizes {
+        if !native_wins(size) {
+            break;
+        }
+        best = size;
+    }
+    best
+}
+
+fn tune_small_gemm() -> i32 {
+    crossover(&GEMM_DIMS, |d| {
+        let len = (d * d) as usize;
+        let (a, b, mut c) = (vec![0.5; len], vec![0.25; len], vec![0.0; len]);
+        let mut run = |max_dim| {
+            cblas_inject_set_small_gemm_max_dim(max_dim);
+            time_per_call(|| unsafe {
+                cblas_dgemm(
+                    CblasColMajor,
+                    CblasNoTrans,
+                    CblasNoTrans,
+                    d,
+                    d,
+                    d,
+                    1.0,
+                    a.as_ptr(),
+                    d,
+                    b.as_ptr(),
+                    d,
+                    0.0,
+                    c.as_mut_ptr(),
+                    d,
+                );
+                black_box(c.as_mut_ptr());
+            })
+        };
+        let provider = run(0);
+        run(CBLAS_INJECT_SMALL_GEMM_DIM_LIMIT) < provider
+    })
+}
+
+fn tune_native_blas1(with_axpy: bool) -> i64 {
+    let n = crossover(&BLAS1_LENGTHS, |n| {
+        let (x, mut y) = (vec![0.5; n as usize], vec![0.25; n as usize]);
+        let mut run = |max_n| {
+            cblas_inject_set_native_blas1_max_n(max_n);
+            let dot = time_per_call(|| unsafe {
+                black_box(cblas_ddot(n, x.as_ptr(), 1, y.as_ptr(), 1));
+            });
+            let axpy = if with_axpy {
+                time_per_call(|| unsafe {
+                    cblas_daxpy(n, 1e-9, x.as_ptr(), 1, y.as_mut_ptr(), 1);
+                    black_box(y.as_mut_ptr());
+                })
+            } else {
+                0.0
+            };
+            dot + axpy
+        };
+        let provider = run(0);
+        run(i64::MAX) < provider
+    });
+    i64::from(n)
+}
+
+fn dgemm_registered() -> bool {
+    resolve_dgemm_for_current_cblas()
+        .or_else(|| provider::resolve_missing("dgemm", resolve_dgemm_for_current_cblas))
+        .is_some()
+}
+
+fn ddot_registered() -> bool {
+    try_get_ddot_for_lp64_cblas().is_some()
+}
+
+/// Measure every family that has a provider; the thresholds in effect are
+/// left as they were.
+fn tune() -> Thresholds {
+    let (gemm_before, blas1_before) = (
+        cblas_inject_small_gemm_max_dim(),
+        cblas_inject_native_blas1_max_n(),
+    );
+    let tuned = Thresholds {
+        small_gemm_max_dim: dgemm_registered().then(tune_small_gemm),
+        native_blas1_max_n: ddot_registered()
+            .then(|| tune_native_blas1(try_get_daxpy_for_lp64_cblas().is_some())),
+    };
+    cblas_inject_set_small_gemm_max_dim(gemm_before);
+    cblas_inject_set_native_blas1_max_n(blas1_before);
+    tuned
+}
+
+fn cpu_model() -> String {
+    fs::read_to_string("/proc/cpuinfo")
+        .ok()
+        .and_then(|info| {
+            info.lines().find_map(|line| {
+                let (key, value) = line.split_once(':')?;
+                matches!(key.trim(), "model name" | "Model" | "cpu model")
+                    .then(|| value.trim().to_owned())
+            })
+        })
+        .unwrap_or_else(|| std::env::consts::ARCH.to_owned())
+}
+
+/// The `cpu` and `provider` lines a cache must match.
+fn cache_key() -> [(&'static str, String); 3] {
+    let library = provider::loaded_library().map_or_else(
+        || "-".to_owned(),
+        |path| path.to_string_lossy().into_owned(),
+    );
+    [
+        ("format", CACHE_FORMAT.to_owned()),
+        ("cpu", cpu_model()),
+        ("provider", library),
+    ]
+}
+
+fn parse_cache(text: &str, key: &[(&str, String)]) -> Option<Thresholds> {
+    let lines: Vec<(&str, &str)> = text.lines().filter_map(|l| l.split_once('=')).collect();
+    let get = |name: &str| lines.iter().find(|(k, _)| *k == name).map(|(_, v)| *v);
+    if key
+        .iter()
+        .any(|(name, value)| get(name) != Some(value.as_str()))
+    {
+        return None;
+    }
+    Some(Thresholds {
+        small_gemm_max_dim: get("small_gemm_max_dim")
+            .and_then(|v| v.parse().ok())
+            .filter(|d| (0..=CBLAS_INJECT_SMALL_GEMM_DIM_LIMIT).contains(d)),
+        native_blas1_max_n: get("native_blas1_max_n")
+            .and_then(|v| v.parse().ok())
+            .filter(|n| *n >= 0),
+    })
+}
+
+fn format_cache(key: &[(&str, String)], t: &Thresholds) -> String {
+    let mut text = String::new();
+    for (name, value) in key {
+        text += &format!("{name}={value}\n");
+    }
+    if let Some(d) = t.small_gemm_max_dim {
+        text += &format!("small_gemm_max_dim={d}\n");
+    }
+    if let Some(n) = t.native_blas1_max_n {
+        text += &format!("native_blas1_max_n={n}\n");
+    }
+    text
+}
+
+/// Tune the small GEMM and native Level 1 crossover thresholds for the
+/// registered providers and apply them.
+///
+/// `cache` may be NULL. Otherwise thresholds stored there for the same CPU
+/// model and provider library are applied without measuring, and a missing,
+/// stale or incomplete cache is replaced by the freshly tuned values.
+/// Tuning takes a few tens of milliseconds and switches the thresholds
+/// process-wide while it runs, so call it at startup, before other threads
+/// issue BLAS calls and before enabling statistics or tracing (the timed
+/// calls are recorded like any other).
+///
+/// Returns `CBLAS_INJECT_STATUS_OK`, or `CBLAS_INJECT_STATUS_IO_ERROR` if the
+/// cache could not be written (the tuned thresholds are applied anyway).
+///
+/// # Safety
+///
+/// `cache` must be NULL or a NUL-terminated string.
+#[no_mangle]
+pub unsafe extern "C" fn cblas_inject_autotune(cache: *const c_char) -> i32 {
+    let _tuning = TUNING.lock().unwrap_or_else(|e| e.into_inner());
+    let path = (!cache.is_null()).then(|| {
+        unsafe { CStr::from_ptr(cache) }
+            .to_string_lossy()
+            .into_owned()
+    });
+    let key = cache_key();
+    let cached = path
+        .as_ref()
+        .and_then(|p| fs::read_to_string(p).ok())
+        .and_then(|text| parse_cache(&text, &key))
+        .filter(|t| !incomplete(t));
+    if let Some(thresholds) = cached {
+        thresholds.apply();
+        return CBLAS_INJECT_STATUS_OK;
+    }
+
+    let tuned = tune();
+    tuned.apply();
+    match path {
+        Some(p) if fs::write(&p, format_cache(&key, &tuned)).is_err() => {
+            CBLAS_INJECT_STATUS_IO_ERROR
+        }
+        _ => CBLAS_INJECT_STATUS_OK,
+    }
+}
+
+/// Whether a cache lacks a family that has a provider now.
+fn incomplete(t: &Thresholds) -> bool {
+    (dgemm_registered() && t.small_gemm_max_dim.is_none())
+        || (ddot_registered() && t.native_blas1_max_n.is_none())
+}
@@ -6,7 +6,9 @@
 
 #![allow(dead_code, clippy::useless_transmute)]
 
+use std::cell::Cell;
 use std::ffi::{c_char, c_void};
+use std::sync::atomic::{AtomicUsize, Ordering};
 use std::sync::{Mutex, MutexGuard, OnceLock};
 
 use num_complex::{Complex32, Complex64};
@@ -31,6 +33,7 @@ macro_rules! define_dual_backend {
             pub unsafe extern "C" fn [<cblas_inject_register_ $name_str _lp64>](f: *const std::ffi::c_void) -> i32 {
                 if f.is_null() { return crate::backend::CBLAS_INJECT_STATUS_NULL_POINTER; }
                 let f: $lp64_type = unsafe { std::mem::transmute(f) };
+                let _guard = crate::backend::registration_guard();
                 match paste::paste!([<$name _LP64>]).set(f) {
                     Ok(()) => crate::backend::CBLAS_INJECT_STATUS_OK,
                     Err(_) => crate::backend::CBLAS_INJECT_STATUS_ALREADY_REGISTERED,
@@ -41,6 +44,7 @@ macro_rules! define_dual_backend {
             pub unsafe extern "C" fn [<cblas_inject_register_ $name_str _ilp64>](f: *const std::ffi::c_void) -> i32 {
                 if f.is_null() { return crate::backend::CBLAS_INJECT_STATUS_NULL_POINTER; }
                 let f: $ilp64_type = unsafe { std::mem::transmute(f) };
+                let _guard = crate::backend::registration_guard();
                 match paste::paste!([<$name _ILP64>]).set(f) {
                     Ok(()) => crate::backend::CBLAS_INJECT_STATUS_OK,
                     Err(_) => crate::backend::CBLAS_INJECT_STATUS_ALREADY_REGISTERED,
@@ -54,25 +58,71 @@ macro_rules! define_dual_backend {
             Ilp64($ilp64_type),
         }
 
+        impl crate::backend::ProviderAbi for $provider {
+            fn ilp64(&self) -> bool {
+                matches!(self, $provider::Ilp64(_))
+            }
+        }
+
+        impl crate::backend::FromRaw for $provider {
+            unsafe fn from_raw(ilp64: bool, f: *const std::ffi::c_void) -> Self {
+                unsafe {
+                    if ilp64 {
+                        $provider::Ilp64(std::mem::transmute::<*const std::ffi::c_void, $ilp64_type>(f))
+                    } else {
+                        $provider::Lp64(std::mem::transmute::<*const std::ffi::c_void, $lp64_type>(f))
+                    }
+                }
+            }
+        }
+
         paste::paste! {
-            pub(crate) fn [<get_ $name:lower _for_lp64_cblas>]() -> $provider {
+            pub(crate) fn [<resolve_ $name:lower _for_lp64_cblas>]() -> Option<$provider> {
                 if let Some(f) = [<$name _LP64>].get() {
-                    return $provider::Lp64(*f);
+                    return Some($provider::Lp64(*f));
                 }
+                [<$name _ILP64>].get().map(|f| $provider::Ilp64(*f))
+            }
+
+            pub(crate) fn [<resolve_ $name:lower _for_ilp64_cblas>]() -> Option<$provider> {
                 if let Some(f) = [<$name _ILP64>].get() {
-                    return $provider::Ilp64(*f);
+                    return Some($provider::Ilp64(*f));
                 }
-                panic!("{} not registered: call cblas_inject_register_{}_lp64() or cblas_inject_register_{}_ilp64() first", stringify!($name), $name_str, $name_str);
+                [<$name _LP64>].get().map(|f| $provider::Lp64(*f))
             }
 
-            pub(crate) fn [<get_ $name:lower _for_ilp64_cblas>]() -> $provider {
-                if let Some(f) = [<$name _ILP64>].get() {
-                    return $provider::Ilp64(*f);
+            #[inline]
+            pub(crate) fn [<try_get_ $name:lower _for_lp64_cblas>]() -> Option<$provider> {
+                crate::dispatch::scoped(|t| t.[<$name:lower>].lp64_cblas)
+                    .or_else(|| crate::dispatch::frozen_dispatch().and_then(|t| t.[<$name:lower>].lp64_cblas))
+                    .or_else([<resolve_ $name:lower _for_lp64_cblas>])
+                    .or_else(|| crate::provider::resolve_missing($name_str, [<resolve_ $name:lower _for_lp64_cblas>]))
+                    .map(crate::trace::lp64_provider)
+            }
+
+            #[inline]
+            pub(crate) fn [<get_ $name:lower _for_lp64_cblas>]() -> $provider {
+                match [<try_get_ $name:lower _for_lp64_cblas>]() {
+                    Some(p) => p,
+                    None => panic!("{} not registered: call cblas_inject_register_{}_lp64() or cblas_inject_register_{}_ilp64() first", stringify!($name), $name_str, $name_str),
                 }
-                if let Some(f) = [<$name _LP64>].get() {
-                    return $provider::Lp64(*f);
+            }
+
+            #[inline]
+            pub(crate) fn [<try_get_ $name:lower _for_ilp64_cblas>]() -> Option<$provider> {
+                crate::dispatch::scoped(|t| t.[<$name:lower>].ilp64_cblas)
+                    .or_else(|| crate::dispatch::frozen_dispatch().and_then(|t| t.[<$name:lower>].ilp64_cblas))
+                    .or_else([<resolve_ $name:lower _for_ilp64_cblas>])
+                    .or_else(|| crate::provider::resolve_missing($name_str, [<resolve_ $name:lower _for_ilp64_cblas>]))
+                    .map(crate::trace::ilp64_provider)
+            }
+
+            #[inline]
+            pub(crate) fn [<get_ $name:lower _for_ilp64_cblas>]() -> $provider {
+                match [<try_get_ $name:lower _for_ilp64_cblas>]() {
+                    Some(p) => p,
+                    None => panic!("{} not registered", stringify!($name)),
                 }
-                panic!("{} not registered", stringify!($name));
             }
         }
     };
@@ -84,6 +134,55 @@ pub const CBLAS_INJECT_STATUS_OK: i32 = 0;
 pub const CBLAS_INJECT_STATUS_NULL_POINTER: i32 = 1;
 /// C API status code for a function that has already been registered.
 pub const CBLAS_INJECT_STATUS_ALREADY_REGISTERED: i32 = 2;
+/// C API status code for a dispatch table that has already been finalized.
+pub const CBLAS_INJECT_STATUS_ALREADY_FINALIZED: i32 = 3;
+/// C API status code for an out-of-range argument (e.g. a negative threshold).
+pub const CBLAS_INJECT_STATUS_INVALID_ARGUMENT: i32 = 4;
+/// C API status code for a routine whose size routes are all in use.
+pub const CBLAS_INJECT_STATUS_ROUTE_TABLE_FULL: i32 = 5;
+/// C API status code for a file that could not be created or written.
+pub const CBLAS_INJECT_STATUS_IO_ERROR: i32 = 6;
+/// C API status code for a provider library that could not be opened or
+/// exports no BLAS symbol.
+pub const CBLAS_INJECT_STATUS_LOAD_FAILED: i32 = 7;
+/// C API status code for an operation that needs a hook (such as a provider
+/// thread-count setter) that has not been registered.
+pub const CBLAS_INJECT_STATUS_NOT_REGISTERED: i32 = 8;
+
+/// Build a provider from a pointer registered for one Fortran integer ABI.
+pub(crate) trait FromRaw {
+    /// # Safety
+    ///
+    /// `f` must be the routine's Fortran function for that ABI.
+    unsafe fn from_raw(ilp64: bool, f: *const c_void) -> Self;
+}
+
+/// Integer ABI of a resolved provider, for the dispatch path of a trace.
+pub(crate) trait ProviderAbi: Copy {
+    fn ilp64(&self) -> bool;
+}
+
+macro_rules! impl_from_raw {
+    ($provider:ident, $lp64_type:ty, $ilp64_type:ty) => {
+        impl ProviderAbi for $provider {
+            fn ilp64(&self) -> bool {
+                matches!(self, $provider::Ilp64(_))
+            }
+        }
+
+        impl FromRaw for $provider {
+            unsafe fn from_raw(ilp64: bool, f: *const c_void) -> Self {
+                unsafe {
+                    if ilp64 {
+                        $provider::Ilp64(std::mem::transmute::<*const c_void, $ilp64_type>(f))
+                    } else {
+                        $provider::Lp64(std::mem::transmute::<*const c_void, $lp64_type>(f))
+                    }
+                }
+            }
+        }
+    };
+}
 
 // =============================================================================
 // Fortran BLAS function pointer types
@@ -3764,51 +3863,13 @@ pub type CgemmIlp64FnPtr = unsafe extern "C" fn(
     ldc: *const BlasInt64,
 );
 
-#[derive(Clone, Copy)]
-pub(crate) enum DgemmProvider {
-    Lp64(DgemmLp64FnPtr),
-    Ilp64(DgemmIlp64FnPtr),
-}
-
-#[derive(Clone, Copy)]
-pub(crate) enum SgemmProvider {
-    Lp64(SgemmLp64FnPtr),
-    Ilp64(SgemmIlp64FnPtr),
-}
-
-#[derive(Clone, Copy)]
-pub(crate) enum ZgemmProvider {
-    Lp64(ZgemmLp64FnPtr),
-    Ilp64(ZgemmIlp64FnPtr),
-}
-
-#[derive(Clone, Copy)]
-pub(crate) enum CgemmProvider {
-    Lp64(CgemmLp64FnPtr),
-    Ilp64(CgemmIlp64FnPtr),
-}
-
-/// Fortran ssymm function pointer type (single precision symmetric matrix multiply)
-pub type SsymmFnPtr = unsafe extern "C" fn(
-    side: *const c_char,
-    uplo: *const c_char,
-    m: *const blasint,
-    n: *const blasint,
-    alpha: *const f32,
-    a: *const f32,
-    lda: *const blasint,
-    b: *const f32,
-    ldb: *const blasint,
-    beta: *const f32,
-    c: *mut f32,
-    ldc: *const blasint,
-);
-
-pub type SsymmLp64FnPtr = unsafe extern "C" fn(
-    side: *const c_char,
+/// Fortran sgemmt LP64 function pointer type (single precision triangular-output GEMM)
+pub type SgemmtLp64FnPtr = unsafe extern "C" fn(
     uplo: *const c_char,
-    m: *const BlasInt32,
+    transa: *const c_char,
+    transb: *const c_char,
     n: *const BlasInt32,
+    k: *const BlasInt32,
     alpha: *const f32,
     a: *const f32,
     lda: *const BlasInt32,
@@ -3819,11 +3880,13 @@ pub type SsymmLp64FnPtr = unsafe extern "C" fn(
     ldc: *const BlasInt32,
 );
 
-pub type SsymmIlp64FnPtr = unsafe extern "C" fn(
-    side: *const c_char,
+/// Fortran sgemmt ILP64 function pointer type (single precision triangular-output GEMM)
+pub type SgemmtIlp64FnPtr = unsafe extern "C" fn(
     uplo: *const c_char,
-    m: *const BlasInt64,
+    transa: *const c_char,
+    transb: *const c_char,
     n: *const BlasInt64,
+    k: *const BlasInt64,
     alpha: *const f32,
     a: *const f32,
     lda: *const BlasInt64,
@@ -3834,27 +3897,13 @@ pub type SsymmIlp64FnPtr = unsafe extern "C" fn(
     ldc: *const BlasInt64,
 );
 
-/// Fortran dsymm function pointer type (double precision symmetric matrix multiply)
-pub type DsymmFnPtr = unsafe extern "C" fn(
-    side: *const c_char,
-    uplo: *const c_char,
-    m: *const blasint,
-    n: *const blasint,
-    alpha: *const f64,
-    a: *const f64,
-    lda: *const blasint,
-    b: *const f64,
-    ldb: *const blasint,
-    beta: *const f64,
-    c: *mut f64,
-    ldc: *const blasint,
-);
-
-pub type DsymmLp64FnPtr = unsafe extern "C" fn(
-    side: *const c_char,
+/// Fortran dgemmt LP64 function pointer type (double precision triangular-output GEMM)
+pub type DgemmtLp64FnPtr = unsafe extern "C" fn(
     uplo: *const c_char,
-    m: *const BlasInt32,
+    transa: *const c_char,
+    transb: *const c_char,
     n: *const BlasInt32,
+    k: *const BlasInt32,
     alpha: *const f64,
     a: *const f64,
     lda: *const BlasInt32,
@@ -3865,11 +3914,13 @@ pub type DsymmLp64FnPtr = unsafe extern "C" fn(
     ldc: *const BlasInt32,
 );
 
-pub type DsymmIlp64FnPtr = unsafe extern "C" fn(
-    side: *const c_char,
+/// Fortran dgemmt ILP64 function pointer type (double precision triangular-output GEMM)
+pub type DgemmtIlp64FnPtr = unsafe extern "C" fn(
     uplo: *const c_char,
-    m: *const BlasInt64,
+    transa: *const c_char,
+    transb: *const c_char,
     n: *const BlasInt64,
+    k: *const BlasInt64,
     alpha: *const f64,
     a: *const f64,
     lda: *const BlasInt64,
@@ -3880,27 +3931,13 @@ pub type DsymmIlp64FnPtr = unsafe extern "C" fn(
     ldc: *const BlasInt64,
 );
 
-/// Fortran csymm function pointer type (single precision complex symmetric matrix multiply)
-pub type CsymmFnPtr = unsafe extern "C" fn(
-    side: *const c_char,
-    uplo: *const c_char,
-    m: *const blasint,
-    n: *const blasint,
-    alpha: *const Complex32,
-    a: *const Complex32,
-    lda: *const blasint,
-    b: *const Complex32,
-    ldb: *const blasint,
-    beta: *const Complex32,
-    c: *mut Complex32,
-    ldc: *const blasint,
-);
-
-pub type CsymmLp64FnPtr = unsafe extern "C" fn(
-    side: *const c_char,
+/// Fortran cgemmt LP64 function pointer type (single precision complex triangular-output GEMM)
+pub type CgemmtLp64FnPtr = unsafe extern "C" fn(
     uplo: *const c_char,
-    m: *const BlasInt32,
+    transa: *const c_char,
+    transb: *const c_char,
     n: *const BlasInt32,
+    k: *const BlasInt32,
     alpha: *const Complex32,
     a: *const Complex32,
     lda: *const BlasInt32,
@@ -3911,11 +3948,13 @@ pub type CsymmLp64FnPtr = unsafe extern "C" fn(
     ldc: *const BlasInt32,
 );
 
-pub type CsymmIlp64FnPtr = unsafe extern "C" fn(
-    side: *const c_char,
+/// Fortran cgemmt ILP64 function pointer type (single precision complex triangular-output GEMM)
+pub type CgemmtIlp64FnPtr = unsafe extern "C" fn(
     uplo: *const c_char,
-    m: *const BlasInt64,
+    transa: *const c_char,
+    transb: *const c_char,
     n: *const BlasInt64,
+    k: *const BlasInt64,
     alpha: *const Complex32,
     a: *const Complex32,
     lda: *const BlasInt64,
@@ -3926,27 +3965,13 @@ pub type CsymmIlp64FnPtr = unsafe extern "C" fn(
     ldc: *const BlasInt64,
 );
 
-/// Fortran zsymm function pointer type (double precision complex symmetric matrix multiply)
-pub type ZsymmFnPtr = unsafe extern "C" fn(
-    side: *const c_char,
-    uplo: *const c_char,
-    m: *const blasint,
-    n: *const blasint,
-    alpha: *const Complex64,
-    a: *const Complex64,
-    lda: *const blasint,
-    b: *const Complex64,
-    ldb: *const blasint,
-    beta: *const Complex64,
-    c: *mut Complex64,
-    ldc: *const blasint,
-);
-
-pub type ZsymmLp64FnPtr = unsafe extern "C" fn(
-    side: *const c_char,
+/// Fortran zgemmt LP64 function pointer type (double precision complex triangular-output GEMM)
+pub type ZgemmtLp64FnPtr = unsafe extern "C" fn(
     uplo: *const c_char,
-    m: *const BlasInt32,
+    transa: *const c_char,
+    transb: *const c_char,
     n: *const BlasInt32,
+    k: *const BlasInt32,
     alpha: *const Complex64,
     a: *const Complex64,
     lda: *const BlasInt32,
@@ -3957,11 +3982,13 @@ pub type ZsymmLp64FnPtr = unsafe extern "C" fn(
     ldc: *const BlasInt32,
 );
 
-pub type ZsymmIlp64FnPtr = unsafe extern "C" fn(
-    side: *const c_char,
+/// Fortran zgemmt ILP64 function pointer type (double precision complex triangular-output GEMM)
+pub type ZgemmtIlp64FnPtr = unsafe extern "C" fn(
     uplo: *const c_char,
-    m: *const BlasInt64,
+    transa: *const c_char,
+    transb: *const c_char,
     n: *const BlasInt64,
+    k: *const BlasInt64,
     alpha: *const Complex64,
     a: *const Complex64,
     lda: *const BlasInt64,
@@ -3972,78 +3999,579 @@ pub type ZsymmIlp64FnPtr = unsafe extern "C" fn(
     ldc: *const BlasInt64,
 );
 
-/// Fortran chemm function pointer type (single precision complex Hermitian matrix multiply)
-pub type ChemmFnPtr = unsafe extern "C" fn(
-    side: *const c_char,
-    uplo: *const c_char,
-    m: *const blasint,
-    n: *const blasint,
-    alpha: *const Complex32,
-    a: *const Complex32,
-    lda: *const blasint,
-    b: *const Complex32,
-    ldb: *const blasint,
-    beta: *const Complex32,
-    c: *mut Complex32,
-    ldc: *const blasint,
+/// Fortran somatcopy LP64 function pointer type (single precision out-of-place scaled copy/transpose)
+pub type SomatcopyLp64FnPtr = unsafe extern "C" fn(
+    order: *const c_char,
+    trans: *const c_char,
+    rows: *const BlasInt32,
+    cols: *const BlasInt32,
+    alpha: *const f32,
+    a: *const f32,
+    lda: *const BlasInt32,
+    b: *mut f32,
+    ldb: *const BlasInt32,
 );
 
-pub type ChemmLp64FnPtr = unsafe extern "C" fn(
-    side: *const c_char,
-    uplo: *const c_char,
-    m: *const BlasInt32,
-    n: *const BlasInt32,
+/// Fortran somatcopy ILP64 function pointer type (single precision out-of-place scaled copy/transpose)
+pub type SomatcopyIlp64FnPtr = unsafe extern "C" fn(
+    order: *const c_char,
+    trans: *const c_char,
+    rows: *const BlasInt64,
+    cols: *const BlasInt64,
+    alpha: *const f32,
+    a: *const f32,
+    lda: *const BlasInt64,
+    b: *mut f32,
+    ldb: *const BlasInt64,
+);
+
+/// Fortran domatcopy LP64 function pointer type (double precision out-of-place scaled copy/transpose)
+pub type DomatcopyLp64FnPtr = unsafe extern "C" fn(
+    order: *const c_char,
+    trans: *const c_char,
+    rows: *const BlasInt32,
+    cols: *const BlasInt32,
+    alpha: *const f64,
+    a: *const f64,
+    lda: *const BlasInt32,
+    b: *mut f64,
+    ldb: *const BlasInt32,
+);
+
+/// Fortran domatcopy ILP64 function pointer type (double precision out-of-place scaled copy/transpose)
+pub type DomatcopyIlp64FnPtr = unsafe extern "C" fn(
+    order: *const c_char,
+    trans: *const c_char,
+    rows: *const BlasInt64,
+    cols: *const BlasInt64,
+    alpha: *const f64,
+    a: *const f64,
+    lda: *const BlasInt64,
+    b: *mut f64,
+    ldb: *const BlasInt64,
+);
+
+/// Fortran comatcopy LP64 function pointer type (single precision complex out-of-place scaled copy/transpose)
+pub type ComatcopyLp64FnPtr = unsafe extern "C" fn(
+    order: *const c_char,
+    trans: *const c_char,
+    rows: *const BlasInt32,
+    cols: *const BlasInt32,
     alpha: *const Complex32,
     a: *const Complex32,
     lda: *const BlasInt32,
-    b: *const Complex32,
+    b: *mut Complex32,
     ldb: *const BlasInt32,
-    beta: *const Complex32,
-    c: *mut Complex32,
-    ldc: *const BlasInt32,
 );
 
-pub type ChemmIlp64FnPtr = unsafe extern "C" fn(
-    side: *const c_char,
-    uplo: *const c_char,
-    m: *const BlasInt64,
-    n: *const BlasInt64,
+/// Fortran comatcopy ILP64 function pointer type (single precision complex out-of-place scaled copy/transpose)
+pub type ComatcopyIlp64FnPtr = unsafe extern "C" fn(
+    order: *const c_char,
+    trans: *const c_char,
+    rows: *const BlasInt64,
+    cols: *const BlasInt64,
     alpha: *const Complex32,
     a: *const Complex32,
     lda: *const BlasInt64,
-    b: *const Complex32,
+    b: *mut Complex32,
     ldb: *const BlasInt64,
-    beta: *const Complex32,
-    c: *mut Complex32,
-    ldc: *const BlasInt64,
 );
 
-/// Fortran zhemm function pointer type (double precision complex Hermitian matrix multiply)
-pub type ZhemmFnPtr = unsafe extern "C" fn(
-    side: *const c_char,
-    uplo: *const c_char,
-    m: *const blasint,
-    n: *const blasint,
+/// Fortran zomatcopy LP64 function pointer type (double precision complex out-of-place scaled copy/transpose)
+pub type ZomatcopyLp64FnPtr = unsafe extern "C" fn(
+    order: *const c_char,
+    trans: *const c_char,
+    rows: *const BlasInt32,
+    cols: *const BlasInt32,
     alpha: *const Complex64,
     a: *const Complex64,
-    lda: *const blasint,
-    b: *const Complex64,
-    ldb: *const blasint,
-    beta: *const Complex64,
-    c: *mut Complex64,
-    ldc: *const blasint,
+    lda: *const BlasInt32,
+    b: *mut Complex64,
+    ldb: *const BlasInt32,
 );
 
-pub type ZhemmLp64FnPtr = unsafe extern "C" fn(
-    side: *const c_char,
-    uplo: *const c_char,
-    m: *const BlasInt32,
-    n: *const BlasInt32,
+/// Fortran zomatcopy ILP64 function pointer type (double precision complex out-of-place scaled copy/transpose)
+pub type ZomatcopyIlp64FnPtr = unsafe extern "C" fn(
+    order: *const c_char,
+    trans: *const c_char,
+    rows: *const BlasInt64,
+    cols: *const BlasInt64,
     alpha: *const Complex64,
     a: *const Complex64,
-    lda: *const BlasInt32,
-    b: *const Complex64,
-    ldb: *const BlasInt32,
+    lda: *const BlasInt64,
+    b: *mut Complex64,
+    ldb: *const BlasInt64,
+);
+
+/// Fortran simatcopy LP64 function pointer type (single precision in-place scaled copy/transpose)
+pub type SimatcopyLp64FnPtr = unsafe extern "C" fn(
+    order: *const c_char,
+    trans: *const c_char,
+    rows: *const BlasInt32,
+    cols: *const BlasInt32,
+    alpha: *const f32,
+    a: *mut f32,
+    lda: *const BlasInt32,
+    ldb: *const BlasInt32,
+);
+
+/// Fortran simatcopy ILP64 function pointer type (single precision in-place scaled copy/transpose)
+pub type SimatcopyIlp64FnPtr = unsafe extern "C" fn(
+    order: *const c_char,
+    trans: *const c_char,
+    rows: *const BlasInt64,
+    cols: *const BlasInt64,
+    alpha: *const f32,
+    a: *mut f32,
+    lda: *const BlasInt64,
+    ldb: *const BlasInt64,
+);
+
+/// Fortran dimatcopy LP64 function pointer type (double precision in-place scaled copy/transpose)
+pub type DimatcopyLp64FnPtr = unsafe extern "C" fn(
+    order: *const c_char,
+    trans: *const c_char,
+    rows: *const BlasInt32,
+    cols: *const BlasInt32,
+    alpha: *const f64,
+    a: *mut f64,
+    lda: *const BlasInt32,
+    ldb: *const BlasInt32,
+);
+
+/// Fortran dimatcopy ILP64 function pointer type (double precision in-place scaled copy/transpose)
+pub type DimatcopyIlp64FnPtr = unsafe extern "C" fn(
+    order: *const c_char,
+    trans: *const c_char,
+    rows: *const BlasInt64,
+    cols: *const BlasInt64,
+    alpha: *const f64,
+    a: *mut f64,
+    lda: *const BlasInt64,
+    ldb: *const BlasInt64,
+);
+
+/// Fortran cimatcopy LP64 function pointer type (single precision complex in-place scaled copy/transpose)
+pub type CimatcopyLp64FnPtr = unsafe extern "C" fn(
+    order: *const c_char,
+    trans: *const c_char,
+    rows: *const BlasInt32,
+    cols: *const BlasInt32,
+    alpha: *const Complex32,
+    a: *mut Complex32,
+    lda: *const BlasInt32,
+    ldb: *const BlasInt32,
+);
+
+/// Fortran cimatcopy ILP64 function pointer type (single precision complex in-place scaled copy/transpose)
+pub type CimatcopyIlp64FnPtr = unsafe extern "C" fn(
+    order: *const c_char,
+    trans: *const c_char,
+    rows: *const BlasInt64,
+    cols: *const BlasInt64,
+    alpha: *const Complex32,
+    a: *mut Complex32,
+    lda: *const BlasInt64,
+    ldb: *const BlasInt64,
+);
+
+/// Fortran zimatcopy LP64 function pointer type (double precision complex in-place scaled copy/transpose)
+pub type ZimatcopyLp64FnPtr = unsafe extern "C" fn(
+    order: *const c_char,
+    trans: *const c_char,
+    rows: *const BlasInt32,
+    cols: *const BlasInt32,
+    alpha: *const Complex64,
+    a: *mut Complex64,
+    lda: *const BlasInt32,
+    ldb: *const BlasInt32,
+);
+
+/// Fortran zimatcopy ILP64 function pointer type (double precision complex in-place scaled copy/transpose)
+pub type ZimatcopyIlp64FnPtr = unsafe extern "C" fn(
+    order: *const c_char,
+    trans: *const c_char,
+    rows: *const BlasInt64,
+    cols: *const BlasInt64,
+    alpha: *const Complex64,
+    a: *mut Complex64,
+    lda: *const BlasInt64,
+    ldb: *const BlasInt64,
+);
+
+/// Fortran saxpby LP64 function pointer type (single precision y = alpha*x + beta*y)
+pub type SaxpbyLp64FnPtr = unsafe extern "C" fn(
+    n: *const BlasInt32,
+    alpha: *const f32,
+    x: *const f32,
+    incx: *const BlasInt32,
+    beta: *const f32,
+    y: *mut f32,
+    incy: *const BlasInt32,
+);
+
+/// Fortran saxpby ILP64 function pointer type (single precision y = alpha*x + beta*y)
+pub type SaxpbyIlp64FnPtr = unsafe extern "C" fn(
+    n: *const BlasInt64,
+    alpha: *const f32,
+    x: *const f32,
+    incx: *const BlasInt64,
+    beta: *const f32,
+    y: *mut f32,
+    incy: *const BlasInt64,
+);
+
+/// Fortran daxpby LP64 function pointer type (double precision y = alpha*x + beta*y)
+pub type DaxpbyLp64FnPtr = unsafe extern "C" fn(
+    n: *const BlasInt32,
+    alpha: *const f64,
+    x: *const f64,
+    incx: *const BlasInt32,
+    beta: *const f64,
+    y: *mut f64,
+    incy: *const BlasInt32,
+);
+
+/// Fortran daxpby ILP64 function pointer type (double precision y = alpha*x + beta*y)
+pub type DaxpbyIlp64FnPtr = unsafe extern "C" fn(
+    n: *const BlasInt64,
+    alpha: *const f64,
+    x: *const f64,
+    incx: *const BlasInt64,
+    beta: *const f64,
+    y: *mut f64,
+    incy: *const BlasInt64,
+);
+
+/// Fortran caxpby LP64 function pointer type (single precision complex y = alpha*x + beta*y)
+pub type CaxpbyLp64FnPtr = unsafe extern "C" fn(
+    n: *const BlasInt32,
+    alpha: *const Complex32,
+    x: *const Complex32,
+    incx: *const BlasInt32,
+    beta: *const Complex32,
+    y: *mut Complex32,
+    incy: *const BlasInt32,
+);
+
+/// Fortran caxpby ILP64 function pointer type (single precision complex y = alpha*x + beta*y)
+pub type CaxpbyIlp64FnPtr = unsafe extern "C" fn(
+    n: *const BlasInt64,
+    alpha: *const Complex32,
+    x: *const Complex32,
+    incx: *const BlasInt64,
+    beta: *const Complex32,
+    y: *mut Complex32,
+    incy: *const BlasInt64,
+);
+
+/// Fortran zaxpby LP64 function pointer type (double precision complex y = alpha*x + beta*y)
+pub type ZaxpbyLp64FnPtr = unsafe extern "C" fn(
+    n: *const BlasInt32,
+    alpha: *const Complex64,
+    x: *const Complex64,
+    incx: *const BlasInt32,
+    beta: *const Complex64,
+    y: *mut Complex64,
+    incy: *const BlasInt32,
+);
+
+/// Fortran zaxpby ILP64 function pointer type (double precision complex y = alpha*x + beta*y)
+pub type ZaxpbyIlp64FnPtr = unsafe extern "C" fn(
+    n: *const BlasInt64,
+    alpha: *const Complex64,
+    x: *const Complex64,
+    incx: *const BlasInt64,
+    beta: *const Complex64,
+    y: *mut Complex64,
+    incy: *const BlasInt64,
+);
+
+#[derive(Clone, Copy)]
+pub(crate) enum DgemmProvider {
+    Lp64(DgemmLp64FnPtr),
+    Ilp64(DgemmIlp64FnPtr),
+}
+
+#[derive(Clone, Copy)]
+pub(crate) enum SgemmProvider {
+    Lp64(SgemmLp64FnPtr),
+    Ilp64(SgemmIlp64FnPtr),
+}
+
+#[derive(Clone, Copy)]
+pub(crate) enum ZgemmProvider {
+    Lp64(ZgemmLp64FnPtr),
+    Ilp64(ZgemmIlp64FnPtr),
+}
+
+#[derive(Clone, Copy)]
+pub(crate) enum CgemmProvider {
+    Lp64(CgemmLp64FnPtr),
+    Ilp64(CgemmIlp64FnPtr),
+}
+
+impl_from_raw!(SgemmProvider, SgemmLp64FnPtr, SgemmIlp64FnPtr);
+impl_from_raw!(DgemmProvider, DgemmLp64FnPtr, DgemmIlp64FnPtr);
+impl_from_raw!(CgemmProvider, CgemmLp64FnPtr, CgemmIlp64FnPtr);
+impl_from_raw!(ZgemmProvider, ZgemmLp64FnPtr, ZgemmIlp64FnPtr);
+
+/// Fortran ssymm function pointer type (single precision symmetric matrix multiply)
+pub type SsymmFnPtr = unsafe extern "C" fn(
+    side: *const c_char,
+    uplo: *const c_char,
+    m: *const blasint,
+    n: *const blasint,
+    alpha: *const f32,
+    a: *const f32,
+    lda: *const blasint,
+    b: *const f32,
+    ldb: *const blasint,
+    beta: *const f32,
+    c: *mut f32,
+    ldc: *const blasint,
+);
+
+pub type SsymmLp64FnPtr = unsafe extern "C" fn(
+    side: *const c_char,
+    uplo: *const c_char,
+    m: *const BlasInt32,
+    n: *const BlasInt32,
+    alpha: *const f32,
+    a: *const f32,
+    lda: *const BlasInt32,
+    b: *const f32,
+    ldb: *const BlasInt32,
+    beta: *const f32,
+    c: *mut f32,
+    ldc: *const BlasInt32,
+);
+
+pub type SsymmIlp64FnPtr = unsafe extern "C" fn(
+    side: *const c_char,
+    uplo: *const c_char,
+    m: *const BlasInt64,
+    n: *const BlasInt64,
+    alpha: *const f32,
+    a: *const f32,
+    lda: *const BlasInt64,
+    b: *const f32,
+    ldb: *const BlasInt64,
+    beta: *const f32,
+    c: *mut f32,
+    ldc: *const BlasInt64,
+);
+
+/// Fortran dsymm function pointer type (double precision symmetric matrix multiply)
+pub type DsymmFnPtr = unsafe extern "C" fn(
+    side: *const c_char,
+    uplo: *const c_char,
+    m: *const blasint,
+    n: *const blasint,
+    alpha: *const f64,
+    a: *const f64,
+    lda: *const blasint,
+    b: *const f64,
+    ldb: *const blasint,
+    beta: *const f64,
+    c: *mut f64,
+    ldc: *const blasint,
+);
+
+pub type DsymmLp64FnPtr = unsafe extern "C" fn(
+    side: *const c_char,
+    uplo: *const c_char,
+    m: *const BlasInt32,
+    n: *const BlasInt32,
+    alpha: *const f64,
+    a: *const f64,
+    lda: *const BlasInt32,
+    b: *const f64,
+    ldb: *const BlasInt32,
+    beta: *const f64,
+    c: *mut f64,
+    ldc: *const BlasInt32,
+);
+
+pub type DsymmIlp64FnPtr = unsafe extern "C" fn(
+    side: *const c_char,
+    uplo: *const c_char,
+    m: *const BlasInt64,
+    n: *const BlasInt64,
+    alpha: *const f64,
+    a: *const f64,
+    lda: *const BlasInt64,
+    b: *const f64,
+    ldb: *const BlasInt64,
+    beta: *const f64,
+    c: *mut f64,
+    ldc: *const BlasInt64,
+);
+
+/// Fortran csymm function pointer type (single precision complex symmetric matrix multiply)
+pub type CsymmFnPtr = unsafe extern "C" fn(
+    side: *const c_char,
+    uplo: *const c_char,
+    m: *const blasint,
+    n: *const blasint,
+    alpha: *const Complex32,
+    a: *const Complex32,
+    lda: *const blasint,
+    b: *const Complex32,
+    ldb: *const blasint,
+    beta: *const Complex32,
+    c: *mut Complex32,
+    ldc: *const blasint,
+);
+
+pub type CsymmLp64FnPtr = unsafe extern "C" fn(
+    side: *const c_char,
+    uplo: *const c_char,
+    m: *const BlasInt32,
+    n: *const BlasInt32,
+    alpha: *const Complex32,
+    a: *const Complex32,
+    lda: *const BlasInt32,
+    b: *const Complex32,
+    ldb: *const BlasInt32,
+    beta: *const Complex32,
+    c: *mut Complex32,
+    ldc: *const BlasInt32,
+);
+
+pub type CsymmIlp64FnPtr = unsafe extern "C" fn(
+    side: *const c_char,
+    uplo: *const c_char,
+    m: *const BlasInt64,
+    n: *const BlasInt64,
+    alpha: *const Complex32,
+    a: *const Complex32,
+    lda: *const BlasInt64,
+    b: *const Complex32,
+    ldb: *const BlasInt64,
+    beta: *const Complex32,
+    c: *mut Complex32,
+    ldc: *const BlasInt64,
+);
+
+/// Fortran zsymm function pointer type (double precision complex symmetric matrix multiply)
+pub type ZsymmFnPtr = unsafe extern "C" fn(
+    side: *const c_char,
+    uplo: *const c_char,
+    m: *const blasint,
+    n: *const blasint,
+    alpha: *const Complex64,
+    a: *const Complex64,
+    lda: *const blasint,
+    b: *const Complex64,
+    ldb: *const blasint,
+    beta: *const Complex64,
+    c: *mut Complex64,
+    ldc: *const blasint,
+);
+
+pub type ZsymmLp64FnPtr = unsafe extern "C" fn(
+    side: *const c_char,
+    uplo: *const c_char,
+    m: *const BlasInt32,
+    n: *const BlasInt32,
+    alpha: *const Complex64,
+    a: *const Complex64,
+    lda: *const BlasInt32,
+    b: *const Complex64,
+    ldb: *const BlasInt32,
+    beta: *const Complex64,
+    c: *mut Complex64,
+    ldc: *const BlasInt32,
+);
+
+pub type ZsymmIlp64FnPtr = unsafe extern "C" fn(
+    side: *const c_char,
+    uplo: *const c_char,
+    m: *const BlasInt64,
+    n: *const BlasInt64,
+    alpha: *const Complex64,
+    a: *const Complex64,
+    lda: *const BlasInt64,
+    b: *const Complex64,
+    ldb: *const BlasInt64,
+    beta: *const Complex64,
+    c: *mut Complex64,
+    ldc: *const BlasInt64,
+);
+
+/// Fortran chemm function pointer type (single precision complex Hermitian matrix multiply)
+pub type ChemmFnPtr = unsafe extern "C" fn(
+    side: *const c_char,
+    uplo: *const c_char,
+    m: *const blasint,
+    n: *const blasint,
+    alpha: *const Complex32,
+    a: *const Complex32,
+    lda: *const blasint,
+    b: *const Complex32,
+    ldb: *const blasint,
+    beta: *const Complex32,
+    c: *mut Complex32,
+    ldc: *const blasint,
+);
+
+pub type ChemmLp64FnPtr = unsafe extern "C" fn(
+    side: *const c_char,
+    uplo: *const c_char,
+    m: *const BlasInt32,
+    n: *const BlasInt32,
+    alpha: *const Complex32,
+    a: *const Complex32,
+    lda: *const BlasInt32,
+    b: *const Complex32,
+    ldb: *const BlasInt32,
+    beta: *const Complex32,
+    c: *mut Complex32,
+    ldc: *const BlasInt32,
+);
+
+pub type ChemmIlp64FnPtr = unsafe extern "C" fn(
+    side: *const c_char,
+    uplo: *const c_char,
+    m: *const BlasInt64,
+    n: *const BlasInt64,
+    alpha: *const Complex32,
+    a: *const Complex32,
+    lda: *const BlasInt64,
+    b: *const Complex32,
+    ldb: *const BlasInt64,
+    beta: *const Complex32,
+    c: *mut Complex32,
+    ldc: *const BlasInt64,
+);
+
+/// Fortran zhemm function pointer type (double precision complex Hermitian matrix multiply)
+pub type ZhemmFnPtr = unsafe extern "C" fn(
+    side: *const c_char,
+    uplo: *const c_char,
+    m: *const blasint,
+    n: *const blasint,
+    alpha: *const Complex64,
+    a: *const Complex64,
+    lda: *const blasint,
+    b: *const Complex64,
+    ldb: *const blasint,
+    beta: *const Complex64,
+    c: *mut Complex64,
+    ldc: *const blasint,
+);
+
+pub type ZhemmLp64FnPtr = unsafe extern "C" fn(
+    side: *const c_char,
+    uplo: *const c_char,
+    m: *const BlasInt32,
+    n: *const BlasInt32,
+    alpha: *const Complex64,
+    a: *const Complex64,
+    lda: *const BlasInt32,
+    b: *const Complex64,
+    ldb: *const BlasInt32,
     beta: *const Complex64,
     c: *mut Complex64,
     ldc: *const BlasInt32,
@@ -4951,6 +5479,7 @@ static COMPLEX_RETURN_STYLE: OnceLock<ComplexReturnStyle> = OnceLock::new();
 /// Panics if the style has already been set.
 #[no_mangle]
 pub unsafe extern "C" fn set_complex_return_style(style: ComplexReturnStyle) {
+    let _guard = registration_guard();
     COMPLEX_RETURN_STYLE
         .set(style)
         .expect("complex return style already set (can only be set once)");
@@ -4967,6 +5496,15 @@ pub extern "C" fn get_complex_return_style() -> ComplexReturnStyle {
         .unwrap_or(ComplexReturnStyle::ReturnValue)
 }
 
+/// Set the complex return style unless one was already set.
+///
+/// Returns whether the style in effect is `style`.
+pub(crate) fn try_set_complex_return_style(style: ComplexReturnStyle) -> bool {
+    let _guard = registration_guard();
+    let _ = COMPLEX_RETURN_STYLE.set(style);
+    COMPLEX_RETURN_STYLE.get() == Some(&style)
+}
+
 // =============================================================================
 // Function pointer storage (OnceLock per function)
 // =============================================================================
@@ -6015,16 +6553,168 @@ define_dual_backend!(
     ZtrsmIlp64FnPtr,
     ZtrsmProvider
 );
+// 3M complex GEMM (`cgemm3m_`, `zgemm3m_`) shares the GEMM signature.
+define_dual_backend!(
+    Cgemm3m,
+    "cgemm3m",
+    CgemmLp64FnPtr,
+    CgemmIlp64FnPtr,
+    Cgemm3mProvider
+);
+define_dual_backend!(
+    Zgemm3m,
+    "zgemm3m",
+    ZgemmLp64FnPtr,
+    ZgemmIlp64FnPtr,
+    Zgemm3mProvider
+);
+define_dual_backend!(
+    Sgemmt,
+    "sgemmt",
+    SgemmtLp64FnPtr,
+    SgemmtIlp64FnPtr,
+    SgemmtProvider
+);
+define_dual_backend!(
+    Dgemmt,
+    "dgemmt",
+    DgemmtLp64FnPtr,
+    DgemmtIlp64FnPtr,
+    DgemmtProvider
+);
+define_dual_backend!(
+    Cgemmt,
+    "cgemmt",
+    CgemmtLp64FnPtr,
+    CgemmtIlp64FnPtr,
+    CgemmtProvider
+);
+define_dual_backend!(
+    Zgemmt,
+    "zgemmt",
+    ZgemmtLp64FnPtr,
+    ZgemmtIlp64FnPtr,
+    ZgemmtProvider
+);
+define_dual_backend!(
+    Somatcopy,
+    "somatcopy",
+    SomatcopyLp64FnPtr,
+    SomatcopyIlp64FnPtr,
+    SomatcopyProvider
+);
+define_dual_backend!(
+    Domatcopy,
+    "domatcopy",
+    DomatcopyLp64FnPtr,
+    DomatcopyIlp64FnPtr,
+    DomatcopyProvider
+);
+define_dual_backend!(
+    Comatcopy,
+    "comatcopy",
+    ComatcopyLp64FnPtr,
+    ComatcopyIlp64FnPtr,
+    ComatcopyProvider
+);
+define_dual_backend!(
+    Zomatcopy,
+    "zomatcopy",
+    ZomatcopyLp64FnPtr,
+    ZomatcopyIlp64FnPtr,
+    ZomatcopyProvider
+);
+define_dual_backend!(
+    Simatcopy,
+    "simatcopy",
+    SimatcopyLp64FnPtr,
+    SimatcopyIlp64FnPtr,
+    SimatcopyProvider
+);
+define_dual_backend!(
+    Dimatcopy,
+    "dimatcopy",
+    DimatcopyLp64FnPtr,
+    DimatcopyIlp64FnPtr,
+    DimatcopyProvider
+);
+define_dual_backend!(
+    Cimatcopy,
+    "cimatcopy",
+    CimatcopyLp64FnPtr,
+    CimatcopyIlp64FnPtr,
+    CimatcopyProvider
+);
+define_dual_backend!(
+    Zimatcopy,
+    "zimatcopy",
+    ZimatcopyLp64FnPtr,
+    ZimatcopyIlp64FnPtr,
+    ZimatcopyProvider
+);
+define_dual_backend!(
+    Saxpby,
+    "saxpby",
+    SaxpbyLp64FnPtr,
+    SaxpbyIlp64FnPtr,
+    SaxpbyProvider
+);
+define_dual_backend!(
+    Daxpby,
+    "daxpby",
+    DaxpbyLp64FnPtr,
+    DaxpbyIlp64FnPtr,
+    DaxpbyProvider
+);
+define_dual_backend!(
+    Caxpby,
+    "caxpby",
+    CaxpbyLp64FnPtr,
+    CaxpbyIlp64FnPtr,
+    CaxpbyProvider
+);
+define_dual_backend!(
+    Zaxpby,
+    "zaxpby",
+    ZaxpbyLp64FnPtr,
+    ZaxpbyIlp64FnPtr,
+    ZaxpbyProvider
+);
 
 // =============================================================================
 // Registration functions
 // =============================================================================
 
-fn registration_guard() -> MutexGuard<'static, ()> {
-    match REGISTRATION_LOCK.lock() {
+thread_local! {
+    /// Number of live `RegistrationGuard`s on this thread.
+    static REGISTRATION_DEPTH: Cell<usize> = const { Cell::new(0) };
+}
+
+/// Holds `REGISTRATION_LOCK` for the outermost guard on a thread.
+///
+/// Nested guards are no-ops, so bulk registration can take the lock once and
+/// call the per-routine entry points, which take it themselves.
+pub(crate) struct RegistrationGuard {
+    _lock: Option<MutexGuard<'static, ()>>,
+}
+
+impl Drop for RegistrationGuard {
+    fn drop(&mut self) {
+        REGISTRATION_DEPTH.with(|depth| depth.set(depth.get() - 1));
+    }
+}
+
+pub(crate) fn registration_guard() -> RegistrationGuard {
+    let outermost = REGISTRATION_DEPTH.with(|depth| {
+        let outermost = depth.get() == 0;
+        depth.set(depth.get() + 1);
+        outermost
+    });
+    let lock = outermost.then(|| match REGISTRATION_LOCK.lock() {
         Ok(guard) => guard,
         Err(poisoned) => poisoned.into_inner(),
-    }
+    });
+    RegistrationGuard { _lock: lock }
 }
 
 unsafe fn register_dgemm_lp64_ptr(f: *const c_void) -> i32 {
@@ -6157,6 +6847,7 @@ pub unsafe extern "C" fn cblas_inject_register_sgemm_ilp64(f: *const c_void) ->
         return CBLAS_INJECT_STATUS_NULL_POINTER;
     }
     let f: SgemmIlp64FnPtr = unsafe { std::mem::transmute(f) };
+    let _guard = registration_guard();
     match SGEMM_ILP64.set(f) {
         Ok(()) => CBLAS_INJECT_STATUS_OK,
         Err(_) => CBLAS_INJECT_STATUS_ALREADY_REGISTERED,
@@ -6185,6 +6876,7 @@ pub unsafe extern "C" fn cblas_inject_register_cgemm_ilp64(f: *const c_void) ->
         return CBLAS_INJECT_STATUS_NULL_POINTER;
     }
     let f: CgemmIlp64FnPtr = unsafe { std::mem::transmute(f) };
+    let _guard = registration_guard();
     match CGEMM_ILP64.set(f) {
         Ok(()) => CBLAS_INJECT_STATUS_OK,
         Err(_) => CBLAS_INJECT_STATUS_ALREADY_REGISTERED,
@@ -6227,6 +6919,7 @@ pub extern "C" fn cblas_inject_supports_ilp64() -> i32 {
 #[no_mangle]
 pub unsafe extern "C" fn register_sswap(f: SswapFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<SSWAP>].set(f) };
     let _ =
         paste::paste! { [<Sswap_LP64>].set(std::mem::transmute::<SswapFnPtr, SswapLp64FnPtr>(f)) };
@@ -6235,6 +6928,7 @@ pub unsafe extern "C" fn register_sswap(f: SswapFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dswap(f: DswapFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DSWAP>].set(f) };
     let _ =
         paste::paste! { [<Dswap_LP64>].set(std::mem::transmute::<DswapFnPtr, DswapLp64FnPtr>(f)) };
@@ -6243,6 +6937,7 @@ pub unsafe extern "C" fn register_dswap(f: DswapFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_cswap(f: CswapFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CSWAP>].set(f) };
     let _ =
         paste::paste! { [<Cswap_LP64>].set(std::mem::transmute::<CswapFnPtr, CswapLp64FnPtr>(f)) };
@@ -6251,6 +6946,7 @@ pub unsafe extern "C" fn register_cswap(f: CswapFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_zswap(f: ZswapFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZSWAP>].set(f) };
     let _ =
         paste::paste! { [<Zswap_LP64>].set(std::mem::transmute::<ZswapFnPtr, ZswapLp64FnPtr>(f)) };
@@ -6259,6 +6955,7 @@ pub unsafe extern "C" fn register_zswap(f: ZswapFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_scopy(f: ScopyFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<SCOPY>].set(f) };
     let _ =
         paste::paste! { [<Scopy_LP64>].set(std::mem::transmute::<ScopyFnPtr, ScopyLp64FnPtr>(f)) };
@@ -6267,6 +6964,7 @@ pub unsafe extern "C" fn register_scopy(f: ScopyFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dcopy(f: DcopyFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DCOPY>].set(f) };
     let _ =
         paste::paste! { [<Dcopy_LP64>].set(std::mem::transmute::<DcopyFnPtr, DcopyLp64FnPtr>(f)) };
@@ -6275,6 +6973,7 @@ pub unsafe extern "C" fn register_dcopy(f: DcopyFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_ccopy(f: CcopyFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CCOPY>].set(f) };
     let _ =
         paste::paste! { [<Ccopy_LP64>].set(std::mem::transmute::<CcopyFnPtr, CcopyLp64FnPtr>(f)) };
@@ -6283,6 +6982,7 @@ pub unsafe extern "C" fn register_ccopy(f: CcopyFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_zcopy(f: ZcopyFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZCOPY>].set(f) };
     let _ =
         paste::paste! { [<Zcopy_LP64>].set(std::mem::transmute::<ZcopyFnPtr, ZcopyLp64FnPtr>(f)) };
@@ -6291,6 +6991,7 @@ pub unsafe extern "C" fn register_zcopy(f: ZcopyFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_saxpy(f: SaxpyFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<SAXPY>].set(f) };
     let _ =
         paste::paste! { [<Saxpy_LP64>].set(std::mem::transmute::<SaxpyFnPtr, SaxpyLp64FnPtr>(f)) };
@@ -6299,6 +7000,7 @@ pub unsafe extern "C" fn register_saxpy(f: SaxpyFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_daxpy(f: DaxpyFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DAXPY>].set(f) };
     let _ =
         paste::paste! { [<Daxpy_LP64>].set(std::mem::transmute::<DaxpyFnPtr, DaxpyLp64FnPtr>(f)) };
@@ -6307,6 +7009,7 @@ pub unsafe extern "C" fn register_daxpy(f: DaxpyFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_caxpy(f: CaxpyFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CAXPY>].set(f) };
     let _ =
         paste::paste! { [<Caxpy_LP64>].set(std::mem::transmute::<CaxpyFnPtr, CaxpyLp64FnPtr>(f)) };
@@ -6315,6 +7018,7 @@ pub unsafe extern "C" fn register_caxpy(f: CaxpyFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_zaxpy(f: ZaxpyFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZAXPY>].set(f) };
     let _ =
         paste::paste! { [<Zaxpy_LP64>].set(std::mem::transmute::<ZaxpyFnPtr, ZaxpyLp64FnPtr>(f)) };
@@ -6323,6 +7027,7 @@ pub unsafe extern "C" fn register_zaxpy(f: ZaxpyFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_sscal(f: SscalFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<SSCAL>].set(f) };
     let _ =
         paste::paste! { [<Sscal_LP64>].set(std::mem::transmute::<SscalFnPtr, SscalLp64FnPtr>(f)) };
@@ -6331,6 +7036,7 @@ pub unsafe extern "C" fn register_sscal(f: SscalFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dscal(f: DscalFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DSCAL>].set(f) };
     let _ =
         paste::paste! { [<Dscal_LP64>].set(std::mem::transmute::<DscalFnPtr, DscalLp64FnPtr>(f)) };
@@ -6339,6 +7045,7 @@ pub unsafe extern "C" fn register_dscal(f: DscalFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_cscal(f: CscalFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CSCAL>].set(f) };
     let _ =
         paste::paste! { [<Cscal_LP64>].set(std::mem::transmute::<CscalFnPtr, CscalLp64FnPtr>(f)) };
@@ -6347,6 +7054,7 @@ pub unsafe extern "C" fn register_cscal(f: CscalFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_zscal(f: ZscalFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZSCAL>].set(f) };
     let _ =
         paste::paste! { [<Zscal_LP64>].set(std::mem::transmute::<ZscalFnPtr, ZscalLp64FnPtr>(f)) };
@@ -6355,6 +7063,7 @@ pub unsafe extern "C" fn register_zscal(f: ZscalFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_csscal(f: CsscalFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CSSCAL>].set(f) };
     let _ = paste::paste! { [<Csscal_LP64>].set(std::mem::transmute::<CsscalFnPtr, CsscalLp64FnPtr>(f)) };
 }
@@ -6362,6 +7071,7 @@ pub unsafe extern "C" fn register_csscal(f: CsscalFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_zdscal(f: ZdscalFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZDSCAL>].set(f) };
     let _ = paste::paste! { [<Zdscal_LP64>].set(std::mem::transmute::<ZdscalFnPtr, ZdscalLp64FnPtr>(f)) };
 }
@@ -6369,6 +7079,7 @@ pub unsafe extern "C" fn register_zdscal(f: ZdscalFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_srot(f: SrotFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<SROT>].set(f) };
     let _ = paste::paste! { [<Srot_LP64>].set(std::mem::transmute::<SrotFnPtr, SrotLp64FnPtr>(f)) };
 }
@@ -6376,6 +7087,7 @@ pub unsafe extern "C" fn register_srot(f: SrotFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_drot(f: DrotFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DROT>].set(f) };
     let _ = paste::paste! { [<Drot_LP64>].set(std::mem::transmute::<DrotFnPtr, DrotLp64FnPtr>(f)) };
 }
@@ -6383,6 +7095,7 @@ pub unsafe extern "C" fn register_drot(f: DrotFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_srotg(f: SrotgFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<SROTG>].set(f) };
     let _ =
         paste::paste! { [<Srotg_LP64>].set(std::mem::transmute::<SrotgFnPtr, SrotgLp64FnPtr>(f)) };
@@ -6391,6 +7104,7 @@ pub unsafe extern "C" fn register_srotg(f: SrotgFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_drotg(f: DrotgFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DROTG>].set(f) };
     let _ =
         paste::paste! { [<Drotg_LP64>].set(std::mem::transmute::<DrotgFnPtr, DrotgLp64FnPtr>(f)) };
@@ -6399,6 +7113,7 @@ pub unsafe extern "C" fn register_drotg(f: DrotgFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_srotm(f: SrotmFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<SROTM>].set(f) };
     let _ =
         paste::paste! { [<Srotm_LP64>].set(std::mem::transmute::<SrotmFnPtr, SrotmLp64FnPtr>(f)) };
@@ -6407,6 +7122,7 @@ pub unsafe extern "C" fn register_srotm(f: SrotmFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_drotm(f: DrotmFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DROTM>].set(f) };
     let _ =
         paste::paste! { [<Drotm_LP64>].set(std::mem::transmute::<DrotmFnPtr, DrotmLp64FnPtr>(f)) };
@@ -6415,6 +7131,7 @@ pub unsafe extern "C" fn register_drotm(f: DrotmFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_srotmg(f: SrotmgFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<SROTMG>].set(f) };
     let _ = paste::paste! { [<Srotmg_LP64>].set(std::mem::transmute::<SrotmgFnPtr, SrotmgLp64FnPtr>(f)) };
 }
@@ -6422,6 +7139,7 @@ pub unsafe extern "C" fn register_srotmg(f: SrotmgFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_drotmg(f: DrotmgFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DROTMG>].set(f) };
     let _ = paste::paste! { [<Drotmg_LP64>].set(std::mem::transmute::<DrotmgFnPtr, DrotmgLp64FnPtr>(f)) };
 }
@@ -6429,6 +7147,7 @@ pub unsafe extern "C" fn register_drotmg(f: DrotmgFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_scabs1(f: Scabs1FnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<SCABS1>].set(f) };
     let _ = paste::paste! { [<Scabs1_LP64>].set(std::mem::transmute::<Scabs1FnPtr, Scabs1Lp64FnPtr>(f)) };
 }
@@ -6436,6 +7155,7 @@ pub unsafe extern "C" fn register_scabs1(f: Scabs1FnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dcabs1(f: Dcabs1FnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DCABS1>].set(f) };
     let _ = paste::paste! { [<Dcabs1_LP64>].set(std::mem::transmute::<Dcabs1FnPtr, Dcabs1Lp64FnPtr>(f)) };
 }
@@ -6443,6 +7163,7 @@ pub unsafe extern "C" fn register_dcabs1(f: Dcabs1FnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_sdot(f: SdotFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<SDOT>].set(f) };
     let _ = paste::paste! { [<Sdot_LP64>].set(std::mem::transmute::<SdotFnPtr, SdotLp64FnPtr>(f)) };
 }
@@ -6450,6 +7171,7 @@ pub unsafe extern "C" fn register_sdot(f: SdotFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_ddot(f: DdotFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DDOT>].set(f) };
     let _ = paste::paste! { [<Ddot_LP64>].set(std::mem::transmute::<DdotFnPtr, DdotLp64FnPtr>(f)) };
 }
@@ -6457,6 +7179,7 @@ pub unsafe extern "C" fn register_ddot(f: DdotFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_sdsdot(f: SdsdotFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<SDSDOT>].set(f) };
     let _ = paste::paste! { [<Sdsdot_LP64>].set(std::mem::transmute::<SdsdotFnPtr, SdsdotLp64FnPtr>(f)) };
 }
@@ -6464,6 +7187,7 @@ pub unsafe extern "C" fn register_sdsdot(f: SdsdotFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dsdot(f: DsdotFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DSDOT>].set(f) };
     let _ =
         paste::paste! { [<Dsdot_LP64>].set(std::mem::transmute::<DsdotFnPtr, DsdotLp64FnPtr>(f)) };
@@ -6472,6 +7196,7 @@ pub unsafe extern "C" fn register_dsdot(f: DsdotFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_snrm2(f: Snrm2FnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<SNRM2>].set(f) };
     let _ =
         paste::paste! { [<Snrm2_LP64>].set(std::mem::transmute::<Snrm2FnPtr, Snrm2Lp64FnPtr>(f)) };
@@ -6480,6 +7205,7 @@ pub unsafe extern "C" fn register_snrm2(f: Snrm2FnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dnrm2(f: Dnrm2FnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DNRM2>].set(f) };
     let _ =
         paste::paste! { [<Dnrm2_LP64>].set(std::mem::transmute::<Dnrm2FnPtr, Dnrm2Lp64FnPtr>(f)) };
@@ -6488,6 +7214,7 @@ pub unsafe extern "C" fn register_dnrm2(f: Dnrm2FnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_scnrm2(f: Scnrm2FnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<SCNRM2>].set(f) };
     let _ = paste::paste! { [<Scnrm2_LP64>].set(std::mem::transmute::<Scnrm2FnPtr, Scnrm2Lp64FnPtr>(f)) };
 }
@@ -6495,6 +7222,7 @@ pub unsafe extern "C" fn register_scnrm2(f: Scnrm2FnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dznrm2(f: Dznrm2FnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DZNRM2>].set(f) };
     let _ = paste::paste! { [<Dznrm2_LP64>].set(std::mem::transmute::<Dznrm2FnPtr, Dznrm2Lp64FnPtr>(f)) };
 }
@@ -6502,6 +7230,7 @@ pub unsafe extern "C" fn register_dznrm2(f: Dznrm2FnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_sasum(f: SasumFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<SASUM>].set(f) };
     let _ =
         paste::paste! { [<Sasum_LP64>].set(std::mem::transmute::<SasumFnPtr, SasumLp64FnPtr>(f)) };
@@ -6510,6 +7239,7 @@ pub unsafe extern "C" fn register_sasum(f: SasumFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dasum(f: DasumFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DASUM>].set(f) };
     let _ =
         paste::paste! { [<Dasum_LP64>].set(std::mem::transmute::<DasumFnPtr, DasumLp64FnPtr>(f)) };
@@ -6518,6 +7248,7 @@ pub unsafe extern "C" fn register_dasum(f: DasumFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_scasum(f: ScasumFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<SCASUM>].set(f) };
     let _ = paste::paste! { [<Scasum_LP64>].set(std::mem::transmute::<ScasumFnPtr, ScasumLp64FnPtr>(f)) };
 }
@@ -6525,6 +7256,7 @@ pub unsafe extern "C" fn register_scasum(f: ScasumFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dzasum(f: DzasumFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DZASUM>].set(f) };
     let _ = paste::paste! { [<Dzasum_LP64>].set(std::mem::transmute::<DzasumFnPtr, DzasumLp64FnPtr>(f)) };
 }
@@ -6532,6 +7264,7 @@ pub unsafe extern "C" fn register_dzasum(f: DzasumFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_isamax(f: IsamaxFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ISAMAX>].set(f) };
     let _ = paste::paste! { [<Isamax_LP64>].set(std::mem::transmute::<IsamaxFnPtr, IsamaxLp64FnPtr>(f)) };
 }
@@ -6539,6 +7272,7 @@ pub unsafe extern "C" fn register_isamax(f: IsamaxFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_idamax(f: IdamaxFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<IDAMAX>].set(f) };
     let _ = paste::paste! { [<Idamax_LP64>].set(std::mem::transmute::<IdamaxFnPtr, IdamaxLp64FnPtr>(f)) };
 }
@@ -6546,6 +7280,7 @@ pub unsafe extern "C" fn register_idamax(f: IdamaxFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_icamax(f: IcamaxFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ICAMAX>].set(f) };
     let _ = paste::paste! { [<Icamax_LP64>].set(std::mem::transmute::<IcamaxFnPtr, IcamaxLp64FnPtr>(f)) };
 }
@@ -6553,6 +7288,7 @@ pub unsafe extern "C" fn register_icamax(f: IcamaxFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_izamax(f: IzamaxFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<IZAMAX>].set(f) };
     let _ = paste::paste! { [<Izamax_LP64>].set(std::mem::transmute::<IzamaxFnPtr, IzamaxLp64FnPtr>(f)) };
 }
@@ -6560,6 +7296,7 @@ pub unsafe extern "C" fn register_izamax(f: IzamaxFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_sgemv(f: SgemvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<SGEMV>].set(f) };
     let _ =
         paste::paste! { [<Sgemv_LP64>].set(std::mem::transmute::<SgemvFnPtr, SgemvLp64FnPtr>(f)) };
@@ -6568,6 +7305,7 @@ pub unsafe extern "C" fn register_sgemv(f: SgemvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dgemv(f: DgemvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DGEMV>].set(f) };
     let _ =
         paste::paste! { [<Dgemv_LP64>].set(std::mem::transmute::<DgemvFnPtr, DgemvLp64FnPtr>(f)) };
@@ -6576,6 +7314,7 @@ pub unsafe extern "C" fn register_dgemv(f: DgemvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_cgemv(f: CgemvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CGEMV>].set(f) };
     let _ =
         paste::paste! { [<Cgemv_LP64>].set(std::mem::transmute::<CgemvFnPtr, CgemvLp64FnPtr>(f)) };
@@ -6584,6 +7323,7 @@ pub unsafe extern "C" fn register_cgemv(f: CgemvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_zgemv(f: ZgemvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZGEMV>].set(f) };
     let _ =
         paste::paste! { [<Zgemv_LP64>].set(std::mem::transmute::<ZgemvFnPtr, ZgemvLp64FnPtr>(f)) };
@@ -6592,6 +7332,7 @@ pub unsafe extern "C" fn register_zgemv(f: ZgemvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_sgbmv(f: SgbmvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<SGBMV>].set(f) };
     let _ =
         paste::paste! { [<Sgbmv_LP64>].set(std::mem::transmute::<SgbmvFnPtr, SgbmvLp64FnPtr>(f)) };
@@ -6600,6 +7341,7 @@ pub unsafe extern "C" fn register_sgbmv(f: SgbmvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dgbmv(f: DgbmvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DGBMV>].set(f) };
     let _ =
         paste::paste! { [<Dgbmv_LP64>].set(std::mem::transmute::<DgbmvFnPtr, DgbmvLp64FnPtr>(f)) };
@@ -6608,6 +7350,7 @@ pub unsafe extern "C" fn register_dgbmv(f: DgbmvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_cgbmv(f: CgbmvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CGBMV>].set(f) };
     let _ =
         paste::paste! { [<Cgbmv_LP64>].set(std::mem::transmute::<CgbmvFnPtr, CgbmvLp64FnPtr>(f)) };
@@ -6616,6 +7359,7 @@ pub unsafe extern "C" fn register_cgbmv(f: CgbmvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_zgbmv(f: ZgbmvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZGBMV>].set(f) };
     let _ =
         paste::paste! { [<Zgbmv_LP64>].set(std::mem::transmute::<ZgbmvFnPtr, ZgbmvLp64FnPtr>(f)) };
@@ -6624,6 +7368,7 @@ pub unsafe extern "C" fn register_zgbmv(f: ZgbmvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_ssymv(f: SsymvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<SSYMV>].set(f) };
     let _ =
         paste::paste! { [<Ssymv_LP64>].set(std::mem::transmute::<SsymvFnPtr, SsymvLp64FnPtr>(f)) };
@@ -6632,6 +7377,7 @@ pub unsafe extern "C" fn register_ssymv(f: SsymvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dsymv(f: DsymvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DSYMV>].set(f) };
     let _ =
         paste::paste! { [<Dsymv_LP64>].set(std::mem::transmute::<DsymvFnPtr, DsymvLp64FnPtr>(f)) };
@@ -6640,6 +7386,7 @@ pub unsafe extern "C" fn register_dsymv(f: DsymvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_chemv(f: ChemvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CHEMV>].set(f) };
     let _ =
         paste::paste! { [<Chemv_LP64>].set(std::mem::transmute::<ChemvFnPtr, ChemvLp64FnPtr>(f)) };
@@ -6648,6 +7395,7 @@ pub unsafe extern "C" fn register_chemv(f: ChemvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_zhemv(f: ZhemvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZHEMV>].set(f) };
     let _ =
         paste::paste! { [<Zhemv_LP64>].set(std::mem::transmute::<ZhemvFnPtr, ZhemvLp64FnPtr>(f)) };
@@ -6656,6 +7404,7 @@ pub unsafe extern "C" fn register_zhemv(f: ZhemvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_ssbmv(f: SsbmvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<SSBMV>].set(f) };
     let _ =
         paste::paste! { [<Ssbmv_LP64>].set(std::mem::transmute::<SsbmvFnPtr, SsbmvLp64FnPtr>(f)) };
@@ -6664,6 +7413,7 @@ pub unsafe extern "C" fn register_ssbmv(f: SsbmvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dsbmv(f: DsbmvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DSBMV>].set(f) };
     let _ =
         paste::paste! { [<Dsbmv_LP64>].set(std::mem::transmute::<DsbmvFnPtr, DsbmvLp64FnPtr>(f)) };
@@ -6672,6 +7422,7 @@ pub unsafe extern "C" fn register_dsbmv(f: DsbmvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_chbmv(f: ChbmvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CHBMV>].set(f) };
     let _ =
         paste::paste! { [<Chbmv_LP64>].set(std::mem::transmute::<ChbmvFnPtr, ChbmvLp64FnPtr>(f)) };
@@ -6680,6 +7431,7 @@ pub unsafe extern "C" fn register_chbmv(f: ChbmvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_zhbmv(f: ZhbmvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZHBMV>].set(f) };
     let _ =
         paste::paste! { [<Zhbmv_LP64>].set(std::mem::transmute::<ZhbmvFnPtr, ZhbmvLp64FnPtr>(f)) };
@@ -6688,6 +7440,7 @@ pub unsafe extern "C" fn register_zhbmv(f: ZhbmvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_strmv(f: StrmvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<STRMV>].set(f) };
     let _ =
         paste::paste! { [<Strmv_LP64>].set(std::mem::transmute::<StrmvFnPtr, StrmvLp64FnPtr>(f)) };
@@ -6696,6 +7449,7 @@ pub unsafe extern "C" fn register_strmv(f: StrmvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dtrmv(f: DtrmvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DTRMV>].set(f) };
     let _ =
         paste::paste! { [<Dtrmv_LP64>].set(std::mem::transmute::<DtrmvFnPtr, DtrmvLp64FnPtr>(f)) };
@@ -6704,6 +7458,7 @@ pub unsafe extern "C" fn register_dtrmv(f: DtrmvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_ctrmv(f: CtrmvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CTRMV>].set(f) };
     let _ =
         paste::paste! { [<Ctrmv_LP64>].set(std::mem::transmute::<CtrmvFnPtr, CtrmvLp64FnPtr>(f)) };
@@ -6712,6 +7467,7 @@ pub unsafe extern "C" fn register_ctrmv(f: CtrmvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_ztrmv(f: ZtrmvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZTRMV>].set(f) };
     let _ =
         paste::paste! { [<Ztrmv_LP64>].set(std::mem::transmute::<ZtrmvFnPtr, ZtrmvLp64FnPtr>(f)) };
@@ -6720,6 +7476,7 @@ pub unsafe extern "C" fn register_ztrmv(f: ZtrmvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_strsv(f: StrsvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<STRSV>].set(f) };
     let _ =
         paste::paste! { [<Strsv_LP64>].set(std::mem::transmute::<StrsvFnPtr, StrsvLp64FnPtr>(f)) };
@@ -6728,6 +7485,7 @@ pub unsafe extern "C" fn register_strsv(f: StrsvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dtrsv(f: DtrsvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DTRSV>].set(f) };
     let _ =
         paste::paste! { [<Dtrsv_LP64>].set(std::mem::transmute::<DtrsvFnPtr, DtrsvLp64FnPtr>(f)) };
@@ -6736,6 +7494,7 @@ pub unsafe extern "C" fn register_dtrsv(f: DtrsvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_ctrsv(f: CtrsvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CTRSV>].set(f) };
     let _ =
         paste::paste! { [<Ctrsv_LP64>].set(std::mem::transmute::<CtrsvFnPtr, CtrsvLp64FnPtr>(f)) };
@@ -6744,6 +7503,7 @@ pub unsafe extern "C" fn register_ctrsv(f: CtrsvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_ztrsv(f: ZtrsvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZTRSV>].set(f) };
     let _ =
         paste::paste! { [<Ztrsv_LP64>].set(std::mem::transmute::<ZtrsvFnPtr, ZtrsvLp64FnPtr>(f)) };
@@ -6752,6 +7512,7 @@ pub unsafe extern "C" fn register_ztrsv(f: ZtrsvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_stbmv(f: StbmvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<STBMV>].set(f) };
     let _ =
         paste::paste! { [<Stbmv_LP64>].set(std::mem::transmute::<StbmvFnPtr, StbmvLp64FnPtr>(f)) };
@@ -6760,6 +7521,7 @@ pub unsafe extern "C" fn register_stbmv(f: StbmvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dtbmv(f: DtbmvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DTBMV>].set(f) };
     let _ =
         paste::paste! { [<Dtbmv_LP64>].set(std::mem::transmute::<DtbmvFnPtr, DtbmvLp64FnPtr>(f)) };
@@ -6768,6 +7530,7 @@ pub unsafe extern "C" fn register_dtbmv(f: DtbmvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_ctbmv(f: CtbmvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CTBMV>].set(f) };
     let _ =
         paste::paste! { [<Ctbmv_LP64>].set(std::mem::transmute::<CtbmvFnPtr, CtbmvLp64FnPtr>(f)) };
@@ -6776,6 +7539,7 @@ pub unsafe extern "C" fn register_ctbmv(f: CtbmvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_ztbmv(f: ZtbmvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZTBMV>].set(f) };
     let _ =
         paste::paste! { [<Ztbmv_LP64>].set(std::mem::transmute::<ZtbmvFnPtr, ZtbmvLp64FnPtr>(f)) };
@@ -6784,6 +7548,7 @@ pub unsafe extern "C" fn register_ztbmv(f: ZtbmvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_stbsv(f: StbsvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<STBSV>].set(f) };
     let _ =
         paste::paste! { [<Stbsv_LP64>].set(std::mem::transmute::<StbsvFnPtr, StbsvLp64FnPtr>(f)) };
@@ -6792,6 +7557,7 @@ pub unsafe extern "C" fn register_stbsv(f: StbsvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dtbsv(f: DtbsvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DTBSV>].set(f) };
     let _ =
         paste::paste! { [<Dtbsv_LP64>].set(std::mem::transmute::<DtbsvFnPtr, DtbsvLp64FnPtr>(f)) };
@@ -6800,6 +7566,7 @@ pub unsafe extern "C" fn register_dtbsv(f: DtbsvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_ctbsv(f: CtbsvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CTBSV>].set(f) };
     let _ =
         paste::paste! { [<Ctbsv_LP64>].set(std::mem::transmute::<CtbsvFnPtr, CtbsvLp64FnPtr>(f)) };
@@ -6808,6 +7575,7 @@ pub unsafe extern "C" fn register_ctbsv(f: CtbsvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_ztbsv(f: ZtbsvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZTBSV>].set(f) };
     let _ =
         paste::paste! { [<Ztbsv_LP64>].set(std::mem::transmute::<ZtbsvFnPtr, ZtbsvLp64FnPtr>(f)) };
@@ -6816,6 +7584,7 @@ pub unsafe extern "C" fn register_ztbsv(f: ZtbsvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_sger(f: SgerFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<SGER>].set(f) };
     let _ = paste::paste! { [<Sger_LP64>].set(std::mem::transmute::<SgerFnPtr, SgerLp64FnPtr>(f)) };
 }
@@ -6823,6 +7592,7 @@ pub unsafe extern "C" fn register_sger(f: SgerFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dger(f: DgerFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DGER>].set(f) };
     let _ = paste::paste! { [<Dger_LP64>].set(std::mem::transmute::<DgerFnPtr, DgerLp64FnPtr>(f)) };
 }
@@ -6830,6 +7600,7 @@ pub unsafe extern "C" fn register_dger(f: DgerFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_cgeru(f: CgeruFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CGERU>].set(f) };
     let _ =
         paste::paste! { [<Cgeru_LP64>].set(std::mem::transmute::<CgeruFnPtr, CgeruLp64FnPtr>(f)) };
@@ -6838,6 +7609,7 @@ pub unsafe extern "C" fn register_cgeru(f: CgeruFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_cgerc(f: CgercFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CGERC>].set(f) };
     let _ =
         paste::paste! { [<Cgerc_LP64>].set(std::mem::transmute::<CgercFnPtr, CgercLp64FnPtr>(f)) };
@@ -6846,6 +7618,7 @@ pub unsafe extern "C" fn register_cgerc(f: CgercFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_zgeru(f: ZgeruFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZGERU>].set(f) };
     let _ =
         paste::paste! { [<Zgeru_LP64>].set(std::mem::transmute::<ZgeruFnPtr, ZgeruLp64FnPtr>(f)) };
@@ -6854,6 +7627,7 @@ pub unsafe extern "C" fn register_zgeru(f: ZgeruFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_zgerc(f: ZgercFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZGERC>].set(f) };
     let _ =
         paste::paste! { [<Zgerc_LP64>].set(std::mem::transmute::<ZgercFnPtr, ZgercLp64FnPtr>(f)) };
@@ -6862,6 +7636,7 @@ pub unsafe extern "C" fn register_zgerc(f: ZgercFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_ssyr(f: SsyrFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<SSYR>].set(f) };
     let _ = paste::paste! { [<Ssyr_LP64>].set(std::mem::transmute::<SsyrFnPtr, SsyrLp64FnPtr>(f)) };
 }
@@ -6869,6 +7644,7 @@ pub unsafe extern "C" fn register_ssyr(f: SsyrFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dsyr(f: DsyrFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DSYR>].set(f) };
     let _ = paste::paste! { [<Dsyr_LP64>].set(std::mem::transmute::<DsyrFnPtr, DsyrLp64FnPtr>(f)) };
 }
@@ -6876,6 +7652,7 @@ pub unsafe extern "C" fn register_dsyr(f: DsyrFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_cher(f: CherFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CHER>].set(f) };
     let _ = paste::paste! { [<Cher_LP64>].set(std::mem::transmute::<CherFnPtr, CherLp64FnPtr>(f)) };
 }
@@ -6883,6 +7660,7 @@ pub unsafe extern "C" fn register_cher(f: CherFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_zher(f: ZherFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZHER>].set(f) };
     let _ = paste::paste! { [<Zher_LP64>].set(std::mem::transmute::<ZherFnPtr, ZherLp64FnPtr>(f)) };
 }
@@ -6890,6 +7668,7 @@ pub unsafe extern "C" fn register_zher(f: ZherFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_ssyr2(f: Ssyr2FnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<SSYR2>].set(f) };
     let _ =
         paste::paste! { [<Ssyr2_LP64>].set(std::mem::transmute::<Ssyr2FnPtr, Ssyr2Lp64FnPtr>(f)) };
@@ -6898,6 +7677,7 @@ pub unsafe extern "C" fn register_ssyr2(f: Ssyr2FnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dsyr2(f: Dsyr2FnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DSYR2>].set(f) };
     let _ =
         paste::paste! { [<Dsyr2_LP64>].set(std::mem::transmute::<Dsyr2FnPtr, Dsyr2Lp64FnPtr>(f)) };
@@ -6906,6 +7686,7 @@ pub unsafe extern "C" fn register_dsyr2(f: Dsyr2FnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_cher2(f: Cher2FnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CHER2>].set(f) };
     let _ =
         paste::paste! { [<Cher2_LP64>].set(std::mem::transmute::<Cher2FnPtr, Cher2Lp64FnPtr>(f)) };
@@ -6914,6 +7695,7 @@ pub unsafe extern "C" fn register_cher2(f: Cher2FnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_zher2(f: Zher2FnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZHER2>].set(f) };
     let _ =
         paste::paste! { [<Zher2_LP64>].set(std::mem::transmute::<Zher2FnPtr, Zher2Lp64FnPtr>(f)) };
@@ -6922,6 +7704,7 @@ pub unsafe extern "C" fn register_zher2(f: Zher2FnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_sspmv(f: SspmvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<SSPMV>].set(f) };
     let _ =
         paste::paste! { [<Sspmv_LP64>].set(std::mem::transmute::<SspmvFnPtr, SspmvLp64FnPtr>(f)) };
@@ -6930,6 +7713,7 @@ pub unsafe extern "C" fn register_sspmv(f: SspmvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dspmv(f: DspmvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DSPMV>].set(f) };
     let _ =
         paste::paste! { [<Dspmv_LP64>].set(std::mem::transmute::<DspmvFnPtr, DspmvLp64FnPtr>(f)) };
@@ -6938,6 +7722,7 @@ pub unsafe extern "C" fn register_dspmv(f: DspmvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_chpmv(f: ChpmvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CHPMV>].set(f) };
     let _ =
         paste::paste! { [<Chpmv_LP64>].set(std::mem::transmute::<ChpmvFnPtr, ChpmvLp64FnPtr>(f)) };
@@ -6946,6 +7731,7 @@ pub unsafe extern "C" fn register_chpmv(f: ChpmvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_zhpmv(f: ZhpmvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZHPMV>].set(f) };
     let _ =
         paste::paste! { [<Zhpmv_LP64>].set(std::mem::transmute::<ZhpmvFnPtr, ZhpmvLp64FnPtr>(f)) };
@@ -6954,6 +7740,7 @@ pub unsafe extern "C" fn register_zhpmv(f: ZhpmvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_stpmv(f: StpmvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<STPMV>].set(f) };
     let _ =
         paste::paste! { [<Stpmv_LP64>].set(std::mem::transmute::<StpmvFnPtr, StpmvLp64FnPtr>(f)) };
@@ -6962,6 +7749,7 @@ pub unsafe extern "C" fn register_stpmv(f: StpmvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dtpmv(f: DtpmvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DTPMV>].set(f) };
     let _ =
         paste::paste! { [<Dtpmv_LP64>].set(std::mem::transmute::<DtpmvFnPtr, DtpmvLp64FnPtr>(f)) };
@@ -6970,6 +7758,7 @@ pub unsafe extern "C" fn register_dtpmv(f: DtpmvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_ctpmv(f: CtpmvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CTPMV>].set(f) };
     let _ =
         paste::paste! { [<Ctpmv_LP64>].set(std::mem::transmute::<CtpmvFnPtr, CtpmvLp64FnPtr>(f)) };
@@ -6978,6 +7767,7 @@ pub unsafe extern "C" fn register_ctpmv(f: CtpmvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_ztpmv(f: ZtpmvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZTPMV>].set(f) };
     let _ =
         paste::paste! { [<Ztpmv_LP64>].set(std::mem::transmute::<ZtpmvFnPtr, ZtpmvLp64FnPtr>(f)) };
@@ -6986,6 +7776,7 @@ pub unsafe extern "C" fn register_ztpmv(f: ZtpmvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_stpsv(f: StpsvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<STPSV>].set(f) };
     let _ =
         paste::paste! { [<Stpsv_LP64>].set(std::mem::transmute::<StpsvFnPtr, StpsvLp64FnPtr>(f)) };
@@ -6994,6 +7785,7 @@ pub unsafe extern "C" fn register_stpsv(f: StpsvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dtpsv(f: DtpsvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DTPSV>].set(f) };
     let _ =
         paste::paste! { [<Dtpsv_LP64>].set(std::mem::transmute::<DtpsvFnPtr, DtpsvLp64FnPtr>(f)) };
@@ -7002,6 +7794,7 @@ pub unsafe extern "C" fn register_dtpsv(f: DtpsvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_ctpsv(f: CtpsvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CTPSV>].set(f) };
     let _ =
         paste::paste! { [<Ctpsv_LP64>].set(std::mem::transmute::<CtpsvFnPtr, CtpsvLp64FnPtr>(f)) };
@@ -7010,6 +7803,7 @@ pub unsafe extern "C" fn register_ctpsv(f: CtpsvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_ztpsv(f: ZtpsvFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZTPSV>].set(f) };
     let _ =
         paste::paste! { [<Ztpsv_LP64>].set(std::mem::transmute::<ZtpsvFnPtr, ZtpsvLp64FnPtr>(f)) };
@@ -7018,6 +7812,7 @@ pub unsafe extern "C" fn register_ztpsv(f: ZtpsvFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_sspr(f: SsprFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<SSPR>].set(f) };
     let _ = paste::paste! { [<Sspr_LP64>].set(std::mem::transmute::<SsprFnPtr, SsprLp64FnPtr>(f)) };
 }
@@ -7025,6 +7820,7 @@ pub unsafe extern "C" fn register_sspr(f: SsprFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dspr(f: DsprFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DSPR>].set(f) };
     let _ = paste::paste! { [<Dspr_LP64>].set(std::mem::transmute::<DsprFnPtr, DsprLp64FnPtr>(f)) };
 }
@@ -7032,6 +7828,7 @@ pub unsafe extern "C" fn register_dspr(f: DsprFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_chpr(f: ChprFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CHPR>].set(f) };
     let _ = paste::paste! { [<Chpr_LP64>].set(std::mem::transmute::<ChprFnPtr, ChprLp64FnPtr>(f)) };
 }
@@ -7039,6 +7836,7 @@ pub unsafe extern "C" fn register_chpr(f: ChprFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_zhpr(f: ZhprFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZHPR>].set(f) };
     let _ = paste::paste! { [<Zhpr_LP64>].set(std::mem::transmute::<ZhprFnPtr, ZhprLp64FnPtr>(f)) };
 }
@@ -7046,6 +7844,7 @@ pub unsafe extern "C" fn register_zhpr(f: ZhprFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_sspr2(f: Sspr2FnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<SSPR2>].set(f) };
     let _ =
         paste::paste! { [<Sspr2_LP64>].set(std::mem::transmute::<Sspr2FnPtr, Sspr2Lp64FnPtr>(f)) };
@@ -7054,6 +7853,7 @@ pub unsafe extern "C" fn register_sspr2(f: Sspr2FnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dspr2(f: Dspr2FnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DSPR2>].set(f) };
     let _ =
         paste::paste! { [<Dspr2_LP64>].set(std::mem::transmute::<Dspr2FnPtr, Dspr2Lp64FnPtr>(f)) };
@@ -7062,6 +7862,7 @@ pub unsafe extern "C" fn register_dspr2(f: Dspr2FnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_chpr2(f: Chpr2FnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CHPR2>].set(f) };
     let _ =
         paste::paste! { [<Chpr2_LP64>].set(std::mem::transmute::<Chpr2FnPtr, Chpr2Lp64FnPtr>(f)) };
@@ -7070,6 +7871,7 @@ pub unsafe extern "C" fn register_chpr2(f: Chpr2FnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_zhpr2(f: Zhpr2FnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZHPR2>].set(f) };
     let _ =
         paste::paste! { [<Zhpr2_LP64>].set(std::mem::transmute::<Zhpr2FnPtr, Zhpr2Lp64FnPtr>(f)) };
@@ -7078,6 +7880,7 @@ pub unsafe extern "C" fn register_zhpr2(f: Zhpr2FnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_ssymm(f: SsymmFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<SSYMM>].set(f) };
     let _ =
         paste::paste! { [<Ssymm_LP64>].set(std::mem::transmute::<SsymmFnPtr, SsymmLp64FnPtr>(f)) };
@@ -7086,6 +7889,7 @@ pub unsafe extern "C" fn register_ssymm(f: SsymmFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dsymm(f: DsymmFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DSYMM>].set(f) };
     let _ =
         paste::paste! { [<Dsymm_LP64>].set(std::mem::transmute::<DsymmFnPtr, DsymmLp64FnPtr>(f)) };
@@ -7094,6 +7898,7 @@ pub unsafe extern "C" fn register_dsymm(f: DsymmFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_csymm(f: CsymmFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CSYMM>].set(f) };
     let _ =
         paste::paste! { [<Csymm_LP64>].set(std::mem::transmute::<CsymmFnPtr, CsymmLp64FnPtr>(f)) };
@@ -7102,6 +7907,7 @@ pub unsafe extern "C" fn register_csymm(f: CsymmFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_zsymm(f: ZsymmFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZSYMM>].set(f) };
     let _ =
         paste::paste! { [<Zsymm_LP64>].set(std::mem::transmute::<ZsymmFnPtr, ZsymmLp64FnPtr>(f)) };
@@ -7110,6 +7916,7 @@ pub unsafe extern "C" fn register_zsymm(f: ZsymmFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_chemm(f: ChemmFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CHEMM>].set(f) };
     let _ =
         paste::paste! { [<Chemm_LP64>].set(std::mem::transmute::<ChemmFnPtr, ChemmLp64FnPtr>(f)) };
@@ -7118,6 +7925,7 @@ pub unsafe extern "C" fn register_chemm(f: ChemmFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_zhemm(f: ZhemmFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZHEMM>].set(f) };
     let _ =
         paste::paste! { [<Zhemm_LP64>].set(std::mem::transmute::<ZhemmFnPtr, ZhemmLp64FnPtr>(f)) };
@@ -7126,6 +7934,7 @@ pub unsafe extern "C" fn register_zhemm(f: ZhemmFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_ssyrk(f: SsyrkFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<SSYRK>].set(f) };
     let _ =
         paste::paste! { [<Ssyrk_LP64>].set(std::mem::transmute::<SsyrkFnPtr, SsyrkLp64FnPtr>(f)) };
@@ -7134,6 +7943,7 @@ pub unsafe extern "C" fn register_ssyrk(f: SsyrkFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dsyrk(f: DsyrkFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DSYRK>].set(f) };
     let _ =
         paste::paste! { [<Dsyrk_LP64>].set(std::mem::transmute::<DsyrkFnPtr, DsyrkLp64FnPtr>(f)) };
@@ -7142,6 +7952,7 @@ pub unsafe extern "C" fn register_dsyrk(f: DsyrkFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_csyrk(f: CsyrkFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CSYRK>].set(f) };
     let _ =
         paste::paste! { [<Csyrk_LP64>].set(std::mem::transmute::<CsyrkFnPtr, CsyrkLp64FnPtr>(f)) };
@@ -7150,6 +7961,7 @@ pub unsafe extern "C" fn register_csyrk(f: CsyrkFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_zsyrk(f: ZsyrkFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZSYRK>].set(f) };
     let _ =
         paste::paste! { [<Zsyrk_LP64>].set(std::mem::transmute::<ZsyrkFnPtr, ZsyrkLp64FnPtr>(f)) };
@@ -7158,6 +7970,7 @@ pub unsafe extern "C" fn register_zsyrk(f: ZsyrkFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_cherk(f: CherkFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CHERK>].set(f) };
     let _ =
         paste::paste! { [<Cherk_LP64>].set(std::mem::transmute::<CherkFnPtr, CherkLp64FnPtr>(f)) };
@@ -7166,6 +7979,7 @@ pub unsafe extern "C" fn register_cherk(f: CherkFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_zherk(f: ZherkFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZHERK>].set(f) };
     let _ =
         paste::paste! { [<Zherk_LP64>].set(std::mem::transmute::<ZherkFnPtr, ZherkLp64FnPtr>(f)) };
@@ -7174,6 +7988,7 @@ pub unsafe extern "C" fn register_zherk(f: ZherkFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_ssyr2k(f: Ssyr2kFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<SSYR2K>].set(f) };
     let _ = paste::paste! { [<Ssyr2k_LP64>].set(std::mem::transmute::<Ssyr2kFnPtr, Ssyr2kLp64FnPtr>(f)) };
 }
@@ -7181,6 +7996,7 @@ pub unsafe extern "C" fn register_ssyr2k(f: Ssyr2kFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dsyr2k(f: Dsyr2kFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DSYR2K>].set(f) };
     let _ = paste::paste! { [<Dsyr2k_LP64>].set(std::mem::transmute::<Dsyr2kFnPtr, Dsyr2kLp64FnPtr>(f)) };
 }
@@ -7188,6 +8004,7 @@ pub unsafe extern "C" fn register_dsyr2k(f: Dsyr2kFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_csyr2k(f: Csyr2kFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CSYR2K>].set(f) };
     let _ = paste::paste! { [<Csyr2k_LP64>].set(std::mem::transmute::<Csyr2kFnPtr, Csyr2kLp64FnPtr>(f)) };
 }
@@ -7195,6 +8012,7 @@ pub unsafe extern "C" fn register_csyr2k(f: Csyr2kFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_zsyr2k(f: Zsyr2kFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZSYR2K>].set(f) };
     let _ = paste::paste! { [<Zsyr2k_LP64>].set(std::mem::transmute::<Zsyr2kFnPtr, Zsyr2kLp64FnPtr>(f)) };
 }
@@ -7202,6 +8020,7 @@ pub unsafe extern "C" fn register_zsyr2k(f: Zsyr2kFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_cher2k(f: Cher2kFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CHER2K>].set(f) };
     let _ = paste::paste! { [<Cher2k_LP64>].set(std::mem::transmute::<Cher2kFnPtr, Cher2kLp64FnPtr>(f)) };
 }
@@ -7209,6 +8028,7 @@ pub unsafe extern "C" fn register_cher2k(f: Cher2kFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_zher2k(f: Zher2kFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZHER2K>].set(f) };
     let _ = paste::paste! { [<Zher2k_LP64>].set(std::mem::transmute::<Zher2kFnPtr, Zher2kLp64FnPtr>(f)) };
 }
@@ -7216,6 +8036,7 @@ pub unsafe extern "C" fn register_zher2k(f: Zher2kFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_strmm(f: StrmmFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<STRMM>].set(f) };
     let _ =
         paste::paste! { [<Strmm_LP64>].set(std::mem::transmute::<StrmmFnPtr, StrmmLp64FnPtr>(f)) };
@@ -7224,6 +8045,7 @@ pub unsafe extern "C" fn register_strmm(f: StrmmFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dtrmm(f: DtrmmFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DTRMM>].set(f) };
     let _ =
         paste::paste! { [<Dtrmm_LP64>].set(std::mem::transmute::<DtrmmFnPtr, DtrmmLp64FnPtr>(f)) };
@@ -7232,6 +8054,7 @@ pub unsafe extern "C" fn register_dtrmm(f: DtrmmFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_ctrmm(f: CtrmmFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CTRMM>].set(f) };
     let _ =
         paste::paste! { [<Ctrmm_LP64>].set(std::mem::transmute::<CtrmmFnPtr, CtrmmLp64FnPtr>(f)) };
@@ -7240,6 +8063,7 @@ pub unsafe extern "C" fn register_ctrmm(f: CtrmmFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_ztrmm(f: ZtrmmFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZTRMM>].set(f) };
     let _ =
         paste::paste! { [<Ztrmm_LP64>].set(std::mem::transmute::<ZtrmmFnPtr, ZtrmmLp64FnPtr>(f)) };
@@ -7248,6 +8072,7 @@ pub unsafe extern "C" fn register_ztrmm(f: ZtrmmFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_strsm(f: StrsmFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<STRSM>].set(f) };
     let _ =
         paste::paste! { [<Strsm_LP64>].set(std::mem::transmute::<StrsmFnPtr, StrsmLp64FnPtr>(f)) };
@@ -7256,6 +8081,7 @@ pub unsafe extern "C" fn register_strsm(f: StrsmFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_dtrsm(f: DtrsmFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<DTRSM>].set(f) };
     let _ =
         paste::paste! { [<Dtrsm_LP64>].set(std::mem::transmute::<DtrsmFnPtr, DtrsmLp64FnPtr>(f)) };
@@ -7264,6 +8090,7 @@ pub unsafe extern "C" fn register_dtrsm(f: DtrsmFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_ctrsm(f: CtrsmFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<CTRSM>].set(f) };
     let _ =
         paste::paste! { [<Ctrsm_LP64>].set(std::mem::transmute::<CtrsmFnPtr, CtrsmLp64FnPtr>(f)) };
@@ -7272,6 +8099,7 @@ pub unsafe extern "C" fn register_ctrsm(f: CtrsmFnPtr) {
 #[no_mangle]
 pub unsafe extern "C" fn register_ztrsm(f: ZtrsmFnPtr) {
     // Legacy LP64 registration - populate both old static and new LP64 storage
+    let _guard = registration_guard();
     let _ = paste::paste! { [<ZTRSM>].set(f) };
     let _ =
         paste::paste! { [<Ztrsm_LP64>].set(std::mem::transmute::<ZtrsmFnPtr, ZtrsmLp64FnPtr>(f)) };
@@ -7345,6 +8173,7 @@ pub unsafe extern "C" fn register_cgemm(f: CgemmFnPtr) {
 /// using the return value convention, accepting i32 blasint parameters.
 #[no_mangle]
 pub unsafe extern "C" fn register_cdotu(f: CdotuFnPtr) {
+    let _guard = registration_guard();
     CDOTU_LP64_PTR
         .set(FnPtrWrapper(f as *const ()))
         .expect("cdotu already registered (can only be set once)");
@@ -7358,6 +8187,7 @@ pub unsafe extern "C" fn register_cdotu(f: CdotuFnPtr) {
 /// accepting i32 blasint parameters.
 #[no_mangle]
 pub unsafe extern "C" fn register_cdotu_raw(ptr: *const ()) {
+    let _guard = registration_guard();
     CDOTU_LP64_PTR
         .set(FnPtrWrapper(ptr))
         .expect("cdotu already registered (can only be set once)");
@@ -7371,6 +8201,7 @@ pub unsafe extern "C" fn register_cdotu_raw(ptr: *const ()) {
 /// using the return value convention, accepting i32 blasint parameters.
 #[no_mangle]
 pub unsafe extern "C" fn register_zdotu(f: ZdotuFnPtr) {
+    let _guard = registration_guard();
     ZDOTU_LP64_PTR
         .set(FnPtrWrapper(f as *const ()))
         .expect("zdotu already registered (can only be set once)");
@@ -7384,6 +8215,7 @@ pub unsafe extern "C" fn register_zdotu(f: ZdotuFnPtr) {
 /// accepting i32 blasint parameters.
 #[no_mangle]
 pub unsafe extern "C" fn register_zdotu_raw(ptr: *const ()) {
+    let _guard = registration_guard();
     ZDOTU_LP64_PTR
         .set(FnPtrWrapper(ptr))
         .expect("zdotu already registered (can only be set once)");
@@ -7397,6 +8229,7 @@ pub unsafe extern "C" fn register_zdotu_raw(ptr: *const ()) {
 /// using the return value convention, accepting i32 blasint parameters.
 #[no_mangle]
 pub unsafe extern "C" fn register_cdotc(f: CdotcFnPtr) {
+    let _guard = registration_guard();
     CDOTC_LP64_PTR
         .set(FnPtrWrapper(f as *const ()))
         .expect("cdotc already registered (can only be set once)");
@@ -7410,6 +8243,7 @@ pub unsafe extern "C" fn register_cdotc(f: CdotcFnPtr) {
 /// accepting i32 blasint parameters.
 #[no_mangle]
 pub unsafe extern "C" fn register_cdotc_raw(ptr: *const ()) {
+    let _guard = registration_guard();
     CDOTC_LP64_PTR
         .set(FnPtrWrapper(ptr))
         .expect("cdotc already registered (can only be set once)");
@@ -7423,6 +8257,7 @@ pub unsafe extern "C" fn register_cdotc_raw(ptr: *const ()) {
 /// using the return value convention, accepting i32 blasint parameters.
 #[no_mangle]
 pub unsafe extern "C" fn register_zdotc(f: ZdotcFnPtr) {
+    let _guard = registration_guard();
     ZDOTC_LP64_PTR
         .set(FnPtrWrapper(f as *const ()))
         .expect("zdotc already registered (can only be set once)");
@@ -7436,6 +8271,7 @@ pub unsafe extern "C" fn register_zdotc(f: ZdotcFnPtr) {
 /// accepting i32 blasint parameters.
 #[no_mangle]
 pub unsafe extern "C" fn register_zdotc_raw(ptr: *const ()) {
+    let _guard = registration_guard();
     ZDOTC_LP64_PTR
         .set(FnPtrWrapper(ptr))
         .expect("zdotc already registered (can only be set once)");
@@ -7448,6 +8284,7 @@ pub unsafe extern "C" fn cblas_inject_register_cdotu_lp64(f: *const std::ffi::c_
     if f.is_null() {
         return CBLAS_INJECT_STATUS_NULL_POINTER;
     }
+    let _guard = registration_guard();
     match CDOTU_LP64_PTR.set(FnPtrWrapper(f as *const ())) {
         Ok(()) => CBLAS_INJECT_STATUS_OK,
         Err(_) => CBLAS_INJECT_STATUS_ALREADY_REGISTERED,
@@ -7459,6 +8296,7 @@ pub unsafe extern "C" fn cblas_inject_register_cdotu_ilp64(f: *const std::ffi::c
     if f.is_null() {
         return CBLAS_INJECT_STATUS_NULL_POINTER;
     }
+    let _guard = registration_guard();
     match CDOTU_ILP64_PTR.set(FnPtrWrapper(f as *const ())) {
         Ok(()) => CBLAS_INJECT_STATUS_OK,
         Err(_) => CBLAS_INJECT_STATUS_ALREADY_REGISTERED,
@@ -7470,6 +8308,7 @@ pub unsafe extern "C" fn cblas_inject_register_zdotu_lp64(f: *const std::ffi::c_
     if f.is_null() {
         return CBLAS_INJECT_STATUS_NULL_POINTER;
     }
+    let _guard = registration_guard();
     match ZDOTU_LP64_PTR.set(FnPtrWrapper(f as *const ())) {
         Ok(()) => CBLAS_INJECT_STATUS_OK,
         Err(_) => CBLAS_INJECT_STATUS_ALREADY_REGISTERED,
@@ -7481,6 +8320,7 @@ pub unsafe extern "C" fn cblas_inject_register_zdotu_ilp64(f: *const std::ffi::c
     if f.is_null() {
         return CBLAS_INJECT_STATUS_NULL_POINTER;
     }
+    let _guard = registration_guard();
     match ZDOTU_ILP64_PTR.set(FnPtrWrapper(f as *const ())) {
         Ok(()) => CBLAS_INJECT_STATUS_OK,
         Err(_) => CBLAS_INJECT_STATUS_ALREADY_REGISTERED,
@@ -7492,6 +8332,7 @@ pub unsafe extern "C" fn cblas_inject_register_cdotc_lp64(f: *const std::ffi::c_
     if f.is_null() {
         return CBLAS_INJECT_STATUS_NULL_POINTER;
     }
+    let _guard = registration_guard();
     match CDOTC_LP64_PTR.set(FnPtrWrapper(f as *const ())) {
         Ok(()) => CBLAS_INJECT_STATUS_OK,
         Err(_) => CBLAS_INJECT_STATUS_ALREADY_REGISTERED,
@@ -7503,6 +8344,7 @@ pub unsafe extern "C" fn cblas_inject_register_cdotc_ilp64(f: *const std::ffi::c
     if f.is_null() {
         return CBLAS_INJECT_STATUS_NULL_POINTER;
     }
+    let _guard = registration_guard();
     match CDOTC_ILP64_PTR.set(FnPtrWrapper(f as *const ())) {
         Ok(()) => CBLAS_INJECT_STATUS_OK,
         Err(_) => CBLAS_INJECT_STATUS_ALREADY_REGISTERED,
@@ -7514,6 +8356,7 @@ pub unsafe extern "C" fn cblas_inject_register_zdotc_lp64(f: *const std::ffi::c_
     if f.is_null() {
         return CBLAS_INJECT_STATUS_NULL_POINTER;
     }
+    let _guard = registration_guard();
     match ZDOTC_LP64_PTR.set(FnPtrWrapper(f as *const ())) {
         Ok(()) => CBLAS_INJECT_STATUS_OK,
         Err(_) => CBLAS_INJECT_STATUS_ALREADY_REGISTERED,
@@ -7525,6 +8368,7 @@ pub unsafe extern "C" fn cblas_inject_register_zdotc_ilp64(f: *const std::ffi::c
     if f.is_null() {
         return CBLAS_INJECT_STATUS_NULL_POINTER;
     }
+    let _guard = registration_guard();
     match ZDOTC_ILP64_PTR.set(FnPtrWrapper(f as *const ())) {
         Ok(()) => CBLAS_INJECT_STATUS_OK,
         Err(_) => CBLAS_INJECT_STATUS_ALREADY_REGISTERED,
@@ -7638,6 +8482,391 @@ pub(crate) fn get_zdotc_for_ilp64_cblas() -> ZdotcProvider {
     panic!("zdotc not registered")
 }
 
+/// Macro to generate the style-resolved form of one complex dot provider.
+///
+/// The raw pointer is transmuted to the signature matching both the
+/// registered integer width and the configured `ComplexReturnStyle` once, so
+/// the CBLAS wrappers only match on a plain typed function pointer.
+macro_rules! define_complex_dot_dispatch {
+    (
+        $name:ident,
+        $provider:ident,
+        $dispatch:ident,
+        $lp64:ty,
+        $lp64_hidden:ty,
+        $ilp64:ty,
+        $ilp64_hidden:ty
+    ) => {
+        #[derive(Clone, Copy)]
+        pub(crate) enum $dispatch {
+            Lp64($lp64),
+            Lp64Hidden($lp64_hidden),
+            Ilp64($ilp64),
+            Ilp64Hidden($ilp64_hidden),
+        }
+
+        impl ProviderAbi for $dispatch {
+            fn ilp64(&self) -> bool {
+                matches!(self, $dispatch::Ilp64(_) | $dispatch::Ilp64Hidden(_))
+            }
+        }
+
+        impl FromRaw for $dispatch {
+            unsafe fn from_raw(ilp64: bool, f: *const c_void) -> Self {
+                let f = f.cast::<()>();
+                let provider = if ilp64 {
+                    $provider::Ilp64(f)
+                } else {
+                    $provider::Lp64(f)
+                };
+                $dispatch::resolve(provider, get_complex_return_style())
+            }
+        }
+
+        impl $dispatch {
+            fn resolve(provider: $provider, style: ComplexReturnStyle) -> Self {
+                unsafe {
+                    match (provider, style) {
+                        ($provider::Lp64(ptr), ComplexReturnStyle::ReturnValue) => {
+                            $dispatch::Lp64(std::mem::transmute::<*const (), $lp64>(ptr))
+                        }
+                        ($provider::Lp64(ptr), ComplexReturnStyle::HiddenArgument) => {
+                            $dispatch::Lp64Hidden(std::mem::transmute::<*const (), $lp64_hidden>(
+                                ptr,
+                            ))
+                        }
+                        ($provider::Ilp64(ptr), ComplexReturnStyle::ReturnValue) => {
+                            $dispatch::Ilp64(std::mem::transmute::<*const (), $ilp64>(ptr))
+                        }
+                        ($provider::Ilp64(ptr), ComplexReturnStyle::HiddenArgument) => {
+                            $dispatch::Ilp64Hidden(std::mem::transmute::<*const (), $ilp64_hidden>(
+                                ptr,
+                            ))
+                        }
+                    }
+                }
+            }
+        }
+
+        paste::paste! {
+            pub(crate) fn [<resolve_ $name _dispatch_for_lp64_cblas>]() -> Option<$dispatch> {
+                let provider = if let Some(p) = [<$name:upper _LP64_PTR>].get() {
+                    $provider::Lp64(p.0)
+                } else {
+                    $provider::Ilp64([<$name:upper _ILP64_PTR>].get()?.0)
+                };
+                Some($dispatch::resolve(provider, get_complex_return_style()))
+            }
+
+            pub(crate) fn [<resolve_ $name _dispatch_for_ilp64_cblas>]() -> Option<$dispatch> {
+                let provider = if let Some(p) = [<$name:upper _ILP64_PTR>].get() {
+                    $provider::Ilp64(p.0)
+                } else {
+                    $provider::Lp64([<$name:upper _LP64_PTR>].get()?.0)
+                };
+                Some($dispatch::resolve(provider, get_complex_return_style()))
+            }
+
+            #[inline]
+            pub(crate) fn [<get_ $name _dispatch_for_lp64_cblas>]() -> $dispatch {
+                match crate::dispatch::scoped(|t| t.$name.lp64_cblas)
+                    .or_else(|| crate::dispatch::frozen_dispatch().and_then(|t| t.$name.lp64_cblas))
+                    .or_else([<resolve_ $name _dispatch_for_lp64_cblas>])
+                    .or_else(|| crate::provider::resolve_missing(stringify!($name), [<resolve_ $name _dispatch_for_lp64_cblas>]))
+                {
+                    Some(d) => crate::trace::lp64_provider(d),
+                    None => panic!("{} not registered", stringify!($name)),
+                }
+            }
+
+            #[inline]
+            pub(crate) fn [<get_ $name _dispatch_for_ilp64_cblas>]() -> $dispatch {
+                match crate::dispatch::scoped(|t| t.$name.ilp64_cblas)
+                    .or_else(|| crate::dispatch::frozen_dispatch().and_then(|t| t.$name.ilp64_cblas))
+                    .or_else([<resolve_ $name _dispatch_for_ilp64_cblas>])
+                    .or_else(|| crate::provider::resolve_missing(stringify!($name), [<resolve_ $name _dispatch_for_ilp64_cblas>]))
+                {
+                    Some(d) => crate::trace::ilp64_provider(d),
+                    None => panic!("{} not registered", stringify!($name)),
+                }
+            }
+        }
+    };
+}
+
+define_complex_dot_dispatch!(
+    cdotu,
+    CdotuProvider,
+    CdotuDispatch,
+    CdotuLp64FnPtr,
+    CdotuHiddenLp64FnPtr,
+    CdotuIlp64FnPtr,
+    CdotuHiddenIlp64FnPtr
+);
+define_complex_dot_dispatch!(
+    zdotu,
+    ZdotuProvider,
+    ZdotuDispatch,
+    ZdotuLp64FnPtr,
+    ZdotuHiddenLp64FnPtr,
+    ZdotuIlp64FnPtr,
+    ZdotuHiddenIlp64FnPtr
+);
+define_complex_dot_dispatch!(
+    cdotc,
+    CdotcProvider,
+    CdotcDispatch,
+    CdotcLp64FnPtr,
+    CdotcHiddenLp64FnPtr,
+    CdotcIlp64FnPtr,
+    CdotcHiddenIlp64FnPtr
+);
+define_complex_dot_dispatch!(
+    zdotc,
+    ZdotcProvider,
+    ZdotcDispatch,
+    ZdotcLp64FnPtr,
+    ZdotcHiddenLp64FnPtr,
+    ZdotcIlp64FnPtr,
+    ZdotcHiddenIlp64FnPtr
+);
+
+// =============================================================================
+// Size-based provider routing
+// =============================================================================
+
+/// Maximum number of size routes that can be registered per routine.
+pub const CBLAS_INJECT_MAX_SIZE_ROUTES: usize = 4;
+
+/// Additional providers for one routine, each selected above a flop threshold.
+///
+/// Routes are appended under the registration lock and never removed, so the
+/// call path only needs an acquire load of `len` followed by a short linear
+/// scan. An empty route set costs that single load.
+pub(crate) struct SizeRoutes<P> {
+    len: AtomicUsize,
+    slots: [OnceLock<(f64, P)>; CBLAS_INJECT_MAX_SIZE_ROUTES],
+}
+
+impl<P: Copy> SizeRoutes<P> {
+    const fn new() -> Self {
+        Self {
+            len: AtomicUsize::new(0),
+            slots: [
+                OnceLock::new(),
+                OnceLock::new(),
+                OnceLock::new(),
+                OnceLock::new(),
+            ],
+        }
+    }
+
+    fn insert(&self, min_flops: f64, provider: P) -> i32 {
+        if !min_flops.is_finite() || min_flops < 0.0 {
+            return CBLAS_INJECT_STATUS_INVALID_ARGUMENT;
+        }
+
+        let _guard = registration_guard();
+        let len = self.len.load(Ordering::Relaxed);
+        let duplicate = self.slots[..len]
+            .iter()
+            .filter_map(OnceLock::get)
+            .any(|(threshold, _)| *threshold == min_flops);
+        if duplicate {
+            return CBLAS_INJECT_STATUS_ALREADY_REGISTERED;
+        }
+        if len == CBLAS_INJECT_MAX_SIZE_ROUTES {
+            return CBLAS_INJECT_STATUS_ROUTE_TABLE_FULL;
+        }
+        if self.slots[len].set((min_flops, provider)).is_err() {
+            return CBLAS_INJECT_STATUS_ALREADY_REGISTERED;
+        }
+        self.len.store(len + 1, Ordering::Release);
+        CBLAS_INJECT_STATUS_OK
+    }
+
+    /// Return the route with the largest threshold not exceeding `flops`.
+    #[inline]
+    fn select(&self, flops: f64) -> Option<P> {
+        let len = self.len.load(Ordering::Acquire);
+        if len == 0 {
+            return None;
+        }
+        let mut best: Option<(f64, P)> = None;
+        for &(threshold, provider) in self.slots[..len].iter().filter_map(OnceLock::get) {
+            if flops >= threshold && !matches!(best, Some((b, _)) if b >= threshold) {
+                best = Some((threshold, provider));
+            }
+        }
+        best.map(|(_, provider)| provider)
+    }
+}
+
+/// Macro to generate size routes for one routine.
+///
+/// Generates `cblas_inject_register_<name>_route_{lp64,ilp64}(f, min_flops)`
+/// and `route_<name>_for_{lp64,ilp64}_cblas(dims...)`. A call is served by the
+/// route with the largest `min_flops` not exceeding its flop count, and by the
+/// regularly registered provider when no route qualifies.
+macro_rules! define_size_routes {
+    (
+        $name:ident,
+        $name_str:literal,
+        $provider:ident,
+        $lp64_type:ty,
+        $ilp64_type:ty,
+        $flops_per_point:expr,
+        [$($dim:ident),+],
+        $get_lp64:ident,
+        $get_ilp64:ident
+    ) => {
+        paste::paste! {
+            #[allow(non_upper_case_globals)]
+            static [<$name:upper _ROUTES>]: SizeRoutes<$provider> = SizeRoutes::new();
+
+            #[no_mangle]
+            pub unsafe extern "C" fn [<cblas_inject_register_ $name_str _route_lp64>](
+                f: *const c_void,
+                min_flops: f64,
+            ) -> i32 {
+                if f.is_null() {
+                    return CBLAS_INJECT_STATUS_NULL_POINTER;
+                }
+                let f = unsafe { std::mem::transmute::<*const c_void, $lp64_type>(f) };
+                [<$name:upper _ROUTES>].insert(min_flops, $provider::Lp64(f))
+            }
+
+            #[no_mangle]
+            pub unsafe extern "C" fn [<cblas_inject_register_ $name_str _route_ilp64>](
+                f: *const c_void,
+                min_flops: f64,
+            ) -> i32 {
+                if f.is_null() {
+                    return CBLAS_INJECT_STATUS_NULL_POINTER;
+                }
+                let f = unsafe { std::mem::transmute::<*const c_void, $ilp64_type>(f) };
+                [<$name:upper _ROUTES>].insert(min_flops, $provider::Ilp64(f))
+            }
+
+            #[inline]
+            pub(crate) fn [<route_ $name _for_lp64_cblas>]($($dim: i64),+) -> $provider {
+                // A provider scope on this thread overrides the routes too.
+                if let Some(p) = crate::dispatch::scoped(|t| t.$name.lp64_cblas) {
+                    return crate::trace::lp64_provider(p);
+                }
+                let flops = $flops_per_point $(* $dim.max(0) as f64)+;
+                match [<$name:upper _ROUTES>].select(flops) {
+                    Some(p) => crate::trace::lp64_provider(p),
+                    None => $get_lp64(),
+                }
+            }
+
+            #[inline]
+            pub(crate) fn [<route_ $name _for_ilp64_cblas>]($($dim: i64),+) -> $provider {
+                // A provider scope on this thread overrides the routes too.
+                if let Some(p) = crate::dispatch::scoped(|t| t.$name.ilp64_cblas) {
+                    return crate::trace::ilp64_provider(p);
+                }
+                let flops = $flops_per_point $(* $dim.max(0) as f64)+;
+                match [<$name:upper _ROUTES>].select(flops) {
+                    Some(p) => crate::trace::ilp64_provider(p),
+                    None => $get_ilp64(),
+                }
+            }
+        }
+    };
+}
+
+// Complex multiply-adds count as four real ones.
+define_size_routes!(
+    sgemm,
+    "sgemm",
+    SgemmProvider,
+    SgemmLp64FnPtr,
+    SgemmIlp64FnPtr,
+    2.0,
+    [m, n, k],
+    get_sgemm_for_current_cblas,
+    get_sgemm_for_ilp64_cblas
+);
+define_size_routes!(
+    dgemm,
+    "dgemm",
+    DgemmProvider,
+    DgemmLp64FnPtr,
+    DgemmIlp64FnPtr,
+    2.0,
+    [m, n, k],
+    get_dgemm_for_current_cblas,
+    get_dgemm_for_ilp64_cblas
+);
+define_size_routes!(
+    cgemm,
+    "cgemm",
+    CgemmProvider,
+    CgemmLp64FnPtr,
+    CgemmIlp64FnPtr,
+    8.0,
+    [m, n, k],
+    get_cgemm_for_current_cblas,
+    get_cgemm_for_ilp64_cblas
+);
+define_size_routes!(
+    zgemm,
+    "zgemm",
+    ZgemmProvider,
+    ZgemmLp64FnPtr,
+    ZgemmIlp64FnPtr,
+    8.0,
+    [m, n, k],
+    get_zgemm_for_current_cblas,
+    get_zgemm_for_ilp64_cblas
+);
+define_size_routes!(
+    sgemv,
+    "sgemv",
+    SgemvProvider,
+    SgemvLp64FnPtr,
+    SgemvIlp64FnPtr,
+    2.0,
+    [m, n],
+    get_sgemv_for_lp64_cblas,
+    get_sgemv_for_ilp64_cblas
+);
+define_size_routes!(
+    dgemv,
+    "dgemv",
+    DgemvProvider,
+    DgemvLp64FnPtr,
+    DgemvIlp64FnPtr,
+    2.0,
+    [m, n],
+    get_dgemv_for_lp64_cblas,
+    get_dgemv_for_ilp64_cblas
+);
+define_size_routes!(
+    cgemv,
+    "cgemv",
+    CgemvProvider,
+    CgemvLp64FnPtr,
+    CgemvIlp64FnPtr,
+    8.0,
+    [m, n],
+    get_cgemv_for_lp64_cblas,
+    get_cgemv_for_ilp64_cblas
+);
+define_size_routes!(
+    zgemv,
+    "zgemv",
+    ZgemvProvider,
+    ZgemvLp64FnPtr,
+    ZgemvIlp64FnPtr,
+    8.0,
+    [m, n],
+    get_zgemv_for_lp64_cblas,
+    get_zgemv_for_ilp64_cblas
+);
+
 // Internal getters (used by blas2/gemv.rs, blas3/gemm.rs etc.)
 // =============================================================================
 
@@ -8061,31 +9290,63 @@ pub(crate) fn get_dgemm() -> DgemmFnPtr {
         .expect("dgemm not registered: call register_dgemm() first")
 }
 
-#[inline]
-pub(crate) fn get_dgemm_for_current_cblas() -> DgemmProvider {
+pub(crate) fn resolve_dgemm_for_current_cblas() -> Option<DgemmProvider> {
     if let Some(f) = DGEMM_LP64.get() {
-        DgemmProvider::Lp64(*f)
-    } else if let Some(f) = DGEMM_ILP64.get() {
-        DgemmProvider::Ilp64(*f)
+        Some(DgemmProvider::Lp64(*f))
     } else {
-        panic!(
-            "dgemm not registered for current CBLAS ABI: call register_dgemm(), \
-             cblas_inject_register_dgemm_lp64(), or cblas_inject_register_dgemm_ilp64() first"
-        );
+        DGEMM_ILP64.get().map(|f| DgemmProvider::Ilp64(*f))
     }
 }
 
 #[inline]
-pub(crate) fn get_dgemm_for_ilp64_cblas() -> DgemmProvider {
+pub(crate) fn try_get_dgemm_for_current_cblas() -> Option<DgemmProvider> {
+    crate::dispatch::scoped(|t| t.dgemm.lp64_cblas)
+        .or_else(|| crate::dispatch::frozen_dispatch().and_then(|t| t.dgemm.lp64_cblas))
+        .or_else(resolve_dgemm_for_current_cblas)
+        .or_else(|| crate::provider::resolve_missing("dgemm", resolve_dgemm_for_current_cblas))
+        .map(crate::trace::lp64_provider)
+}
+
+#[inline]
+pub(crate) fn get_dgemm_for_current_cblas() -> DgemmProvider {
+    match try_get_dgemm_for_current_cblas() {
+        Some(p) => p,
+        None => {
+            panic!(
+                "dgemm not registered for current CBLAS ABI: call register_dgemm(), \
+                 cblas_inject_register_dgemm_lp64(), or cblas_inject_register_dgemm_ilp64() first"
+            );
+        }
+    }
+}
+
+pub(crate) fn resolve_dgemm_for_ilp64_cblas() -> Option<DgemmProvider> {
     if let Some(f) = DGEMM_ILP64.get() {
-        DgemmProvider::Ilp64(*f)
-    } else if let Some(f) = DGEMM_LP64.get() {
-        DgemmProvider::Lp64(*f)
+        Some(DgemmProvider::Ilp64(*f))
     } else {
-        panic!(
-            "dgemm not registered for ILP64 CBLAS ABI: call register_dgemm(), \
-             cblas_inject_register_dgemm_ilp64(), or cblas_inject_register_dgemm_lp64() first"
-        );
+        DGEMM_LP64.get().map(|f| DgemmProvider::Lp64(*f))
+    }
+}
+
+#[inline]
+pub(crate) fn try_get_dgemm_for_ilp64_cblas() -> Option<DgemmProvider> {
+    crate::dispatch::scoped(|t| t.dgemm.ilp64_cblas)
+        .or_else(|| crate::dispatch::frozen_dispatch().and_then(|t| t.dgemm.ilp64_cblas))
+        .or_else(resolve_dgemm_for_ilp64_cblas)
+        .or_else(|| crate::provider::resolve_missing("dgemm", resolve_dgemm_for_ilp64_cblas))
+        .map(crate::trace::ilp64_provider)
+}
+
+#[inline]
+pub(crate) fn get_dgemm_for_ilp64_cblas() -> DgemmProvider {
+    match try_get_dgemm_for_ilp64_cblas() {
+        Some(p) => p,
+        None => {
+            panic!(
+                "dgemm not registered for ILP64 CBLAS ABI: call register_dgemm(), \
+                 cblas_inject_register_dgemm_ilp64(), or cblas_inject_register_dgemm_lp64() first"
+            );
+        }
     }
 }
 
@@ -8096,25 +9357,59 @@ pub(crate) fn get_sgemm() -> SgemmFnPtr {
         .expect("sgemm not registered: call register_sgemm() first")
 }
 
-#[inline]
-pub(crate) fn get_sgemm_for_current_cblas() -> SgemmProvider {
+pub(crate) fn resolve_sgemm_for_current_cblas() -> Option<SgemmProvider> {
     if let Some(f) = SGEMM_LP64.get() {
-        SgemmProvider::Lp64(*f)
-    } else if let Some(f) = SGEMM_ILP64.get() {
-        SgemmProvider::Ilp64(*f)
+        Some(SgemmProvider::Lp64(*f))
     } else {
-        panic!("sgemm not registered: call register_sgemm() or cblas_inject_register_sgemm_lp64()");
+        SGEMM_ILP64.get().map(|f| SgemmProvider::Ilp64(*f))
     }
 }
 
 #[inline]
-pub(crate) fn get_sgemm_for_ilp64_cblas() -> SgemmProvider {
+pub(crate) fn try_get_sgemm_for_current_cblas() -> Option<SgemmProvider> {
+    crate::dispatch::scoped(|t| t.sgemm.lp64_cblas)
+        .or_else(|| crate::dispatch::frozen_dispatch().and_then(|t| t.sgemm.lp64_cblas))
+        .or_else(resolve_sgemm_for_current_cblas)
+        .or_else(|| crate::provider::resolve_missing("sgemm", resolve_sgemm_for_current_cblas))
+        .map(crate::trace::lp64_provider)
+}
+
+#[inline]
+pub(crate) fn get_sgemm_for_current_cblas() -> SgemmProvider {
+    match try_get_sgemm_for_current_cblas() {
+        Some(p) => p,
+        None => {
+            panic!(
+                "sgemm not registered: call register_sgemm() or cblas_inject_register_sgemm_lp64()"
+            );
+        }
+    }
+}
+
+pub(crate) fn resolve_sgemm_for_ilp64_cblas() -> Option<SgemmProvider> {
     if let Some(f) = SGEMM_ILP64.get() {
-        SgemmProvider::Ilp64(*f)
-    } else if let Some(f) = SGEMM_LP64.get() {
-        SgemmProvider::Lp64(*f)
+        Some(SgemmProvider::Ilp64(*f))
     } else {
-        panic!("sgemm not registered for ILP64 CBLAS ABI");
+        SGEMM_LP64.get().map(|f| SgemmProvider::Lp64(*f))
+    }
+}
+
+#[inline]
+pub(crate) fn try_get_sgemm_for_ilp64_cblas() -> Option<SgemmProvider> {
+    crate::dispatch::scoped(|t| t.sgemm.ilp64_cblas)
+        .or_else(|| crate::dispatch::frozen_dispatch().and_then(|t| t.sgemm.ilp64_cblas))
+        .or_else(resolve_sgemm_for_ilp64_cblas)
+        .or_else(|| crate::provider::resolve_missing("sgemm", resolve_sgemm_for_ilp64_cblas))
+        .map(crate::trace::ilp64_provider)
+}
+
+#[inline]
+pub(crate) fn get_sgemm_for_ilp64_cblas() -> SgemmProvider {
+    match try_get_sgemm_for_ilp64_cblas() {
+        Some(p) => p,
+        None => {
+            panic!("sgemm not registered for ILP64 CBLAS ABI");
+        }
     }
 }
 
@@ -8126,31 +9421,63 @@ pub(crate) fn get_zgemm() -> ZgemmFnPtr {
         .expect("zgemm not registered: call register_zgemm() first")
 }
 
-#[inline]
-pub(crate) fn get_zgemm_for_current_cblas() -> ZgemmProvider {
+pub(crate) fn resolve_zgemm_for_current_cblas() -> Option<ZgemmProvider> {
     if let Some(f) = ZGEMM_LP64.get() {
-        ZgemmProvider::Lp64(*f)
-    } else if let Some(f) = ZGEMM_ILP64.get() {
-        ZgemmProvider::Ilp64(*f)
+        Some(ZgemmProvider::Lp64(*f))
     } else {
-        panic!(
-            "zgemm not registered for current CBLAS ABI: call register_zgemm(), \
-             cblas_inject_register_zgemm_lp64(), or cblas_inject_register_zgemm_ilp64() first"
-        );
+        ZGEMM_ILP64.get().map(|f| ZgemmProvider::Ilp64(*f))
     }
 }
 
 #[inline]
-pub(crate) fn get_zgemm_for_ilp64_cblas() -> ZgemmProvider {
+pub(crate) fn try_get_zgemm_for_current_cblas() -> Option<ZgemmProvider> {
+    crate::dispatch::scoped(|t| t.zgemm.lp64_cblas)
+        .or_else(|| crate::dispatch::frozen_dispatch().and_then(|t| t.zgemm.lp64_cblas))
+        .or_else(resolve_zgemm_for_current_cblas)
+        .or_else(|| crate::provider::resolve_missing("zgemm", resolve_zgemm_for_current_cblas))
+        .map(crate::trace::lp64_provider)
+}
+
+#[inline]
+pub(crate) fn get_zgemm_for_current_cblas() -> ZgemmProvider {
+    match try_get_zgemm_for_current_cblas() {
+        Some(p) => p,
+        None => {
+            panic!(
+                "zgemm not registered for current CBLAS ABI: call register_zgemm(), \
+                 cblas_inject_register_zgemm_lp64(), or cblas_inject_register_zgemm_ilp64() first"
+            );
+        }
+    }
+}
+
+pub(crate) fn resolve_zgemm_for_ilp64_cblas() -> Option<ZgemmProvider> {
     if let Some(f) = ZGEMM_ILP64.get() {
-        ZgemmProvider::Ilp64(*f)
-    } else if let Some(f) = ZGEMM_LP64.get() {
-        ZgemmProvider::Lp64(*f)
+        Some(ZgemmProvider::Ilp64(*f))
     } else {
-        panic!(
-            "zgemm not registered for ILP64 CBLAS ABI: call register_zgemm(), \
-             cblas_inject_register_zgemm_ilp64(), or cblas_inject_register_zgemm_lp64() first"
-        );
+        ZGEMM_LP64.get().map(|f| ZgemmProvider::Lp64(*f))
+    }
+}
+
+#[inline]
+pub(crate) fn try_get_zgemm_for_ilp64_cblas() -> Option<ZgemmProvider> {
+    crate::dispatch::scoped(|t| t.zgemm.ilp64_cblas)
+        .or_else(|| crate::dispatch::frozen_dispatch().and_then(|t| t.zgemm.ilp64_cblas))
+        .or_else(resolve_zgemm_for_ilp64_cblas)
+        .or_else(|| crate::provider::resolve_missing("zgemm", resolve_zgemm_for_ilp64_cblas))
+        .map(crate::trace::ilp64_provider)
+}
+
+#[inline]
+pub(crate) fn get_zgemm_for_ilp64_cblas() -> ZgemmProvider {
+    match try_get_zgemm_for_ilp64_cblas() {
+        Some(p) => p,
+        None => {
+            panic!(
+                "zgemm not registered for ILP64 CBLAS ABI: call register_zgemm(), \
+                 cblas_inject_register_zgemm_ilp64(), or cblas_inject_register_zgemm_lp64() first"
+            );
+        }
     }
 }
 
@@ -8161,25 +9488,59 @@ pub(crate) fn get_cgemm() -> CgemmFnPtr {
         .expect("cgemm not registered: call register_cgemm() first")
 }
 
-#[inline]
-pub(crate) fn get_cgemm_for_current_cblas() -> CgemmProvider {
+pub(crate) fn resolve_cgemm_for_current_cblas() -> Option<CgemmProvider> {
     if let Some(f) = CGEMM_LP64.get() {
-        CgemmProvider::Lp64(*f)
-    } else if let Some(f) = CGEMM_ILP64.get() {
-        CgemmProvider::Ilp64(*f)
+        Some(CgemmProvider::Lp64(*f))
     } else {
-        panic!("cgemm not registered: call register_cgemm() or cblas_inject_register_cgemm_lp64()");
+        CGEMM_ILP64.get().map(|f| CgemmProvider::Ilp64(*f))
     }
 }
 
 #[inline]
-pub(crate) fn get_cgemm_for_ilp64_cblas() -> CgemmProvider {
+pub(crate) fn try_get_cgemm_for_current_cblas() -> Option<CgemmProvider> {
+    crate::dispatch::scoped(|t| t.cgemm.lp64_cblas)
+        .or_else(|| crate::dispatch::frozen_dispatch().and_then(|t| t.cgemm.lp64_cblas))
+        .or_else(resolve_cgemm_for_current_cblas)
+        .or_else(|| crate::provider::resolve_missing("cgemm", resolve_cgemm_for_current_cblas))
+        .map(crate::trace::lp64_provider)
+}
+
+#[inline]
+pub(crate) fn get_cgemm_for_current_cblas() -> CgemmProvider {
+    match try_get_cgemm_for_current_cblas() {
+        Some(p) => p,
+        None => {
+            panic!(
+                "cgemm not registered: call register_cgemm() or cblas_inject_register_cgemm_lp64()"
+            );
+        }
+    }
+}
+
+pub(crate) fn resolve_cgemm_for_ilp64_cblas() -> Option<CgemmProvider> {
     if let Some(f) = CGEMM_ILP64.get() {
-        CgemmProvider::Ilp64(*f)
-    } else if let Some(f) = CGEMM_LP64.get() {
-        CgemmProvider::Lp64(*f)
+        Some(CgemmProvider::Ilp64(*f))
     } else {
-        panic!("cgemm not registered for ILP64 CBLAS ABI");
+        CGEMM_LP64.get().map(|f| CgemmProvider::Lp64(*f))
+    }
+}
+
+#[inline]
+pub(crate) fn try_get_cgemm_for_ilp64_cblas() -> Option<CgemmProvider> {
+    crate::dispatch::scoped(|t| t.cgemm.ilp64_cblas)
+        .or_else(|| crate::dispatch::frozen_dispatch().and_then(|t| t.cgemm.ilp64_cblas))
+        .or_else(resolve_cgemm_for_ilp64_cblas)
+        .or_else(|| crate::provider::resolve_missing("cgemm", resolve_cgemm_for_ilp64_cblas))
+        .map(crate::trace::ilp64_provider)
+}
+
+#[inline]
+pub(crate) fn get_cgemm_for_ilp64_cblas() -> CgemmProvider {
+    match try_get_cgemm_for_ilp64_cblas() {
+        Some(p) => p,
+        None => {
+            panic!("cgemm not registered for ILP64 CBLAS ABI");
+        }
     }
 }
 
@@ -0,0 +1,827 @@
+//! Safe generic Rust API over the CBLAS entry points.
+//!
+//! Matrices are borrowed as [`MatRef`] / [`MatMut`] views whose storage order
+//! is a type parameter ([`ColMajor`] or [`RowMajor`]), and vectors as
+//! [`VecRef`] / [`VecMut`]. Transposing a view ([`MatRef::t`]) only swaps its
+//! dimensions and flips the layout type, and [`MatRef::h`] additionally marks
+//! it [`Conjugated`]. The routines below turn the layouts of their operands
+//! into the column-major transpose flags at compile time, so every call
+//! reaches the column-major path of the `cblas_?*_64` wrapper with constant
+//! `order` and `trans` arguments, and the row-major swaps of the C API are
+//! never evaluated at run time.
+//!
+//! ```no_run
+//! use cblas_inject::blas::{self, MatMut, MatRef, RowMajor};
+//!
+//! let a = [1.0, 2.0, 3.0, 4.0, 5.0, 6.0];
+//! let b = [1.0, 0.0, 0.0, 1.0, 1.0, 1.0];
+//! let mut c = [0.0; 4];
+//! // C = A * B^T with 2 x 3 row-major A and B (needs a registered dgemm).
+//! blas::gemm(
+//!     1.0,
+//!     MatRef::<_, RowMajor>::new(&a, 2, 3),
+//!     MatRef::<_, RowMajor>::new(&b, 2, 3).t(),
+//!     0.0,
+//!     MatMut::<_, RowMajor>::new(&mut c, 2, 2),
+//! );
+//! ```
+//!
+//! Dimension and storage mismatches panic, as slice indexing does. A
+//! conjugated view works where BLAS has a flag for it: `h()` of storage in
+//! the same order as the output of `gemm`, and of column-major storage for
+//! `gemv` and `trmv`. The other combinations would need `CblasConjNoTrans`,
+//! which Fortran BLAS lacks, and panic as well. For real element types
+//! conjugation is a no-op.
+
+use std::marker::PhantomData;
+
+use num_complex::{Complex32, Complex64};
+
+use crate::blas1::vector::{cblas_caxpy_64, cblas_daxpy_64, cblas_saxpy_64, cblas_zaxpy_64};
+use crate::blas2::gemv::{cblas_cgemv_64, cblas_dgemv_64, cblas_sgemv_64, cblas_zgemv_64};
+use crate::blas2::trmv::{cblas_ctrmv_64, cblas_dtrmv_64, cblas_strmv_64, cblas_ztrmv_64};
+use crate::blas3::gemm::{cblas_cgemm_64, cblas_dgemm_64, cblas_sgemm_64, cblas_zgemm_64};
+use crate::types::{
+    CblasColMajor, CblasConjTrans, CblasLower, CblasNoTrans, CblasTrans, CblasUpper, CBLAS_DIAG,
+    CBLAS_TRANSPOSE, CBLAS_UPLO,
+};
+
+mod sealed {
+    pub trait Sealed {}
+}
+
+/// Element type of the safe API: `f32`, `f64`, `Complex32` or `Complex64`.
+///
+/// The methods are the column-major `cblas_?*_64` entry points; callers use
+/// the generic functions of this module instead.
+pub trait Scalar: sealed::Sealed + Copy {
+    #[doc(hidden)]
+    const IS_COMPLEX: bool;
+
+    #[doc(hidden)]
+    #[allow(clippy::too_many_arguments)]
+    unsafe fn gemm(
+        transa: CBLAS_TRANSPOSE,
+        transb: CBLAS_TRANSPOSE,
+        m: i64,
+        n: i64,
+        k: i64,
+        alpha: Self,
+        a: *const Self,
+        lda: i64,
+        b: *const Self,
+        ldb: i64,
+        beta: Self,
+        c: *mut Self,
+        ldc: i64,
+    );
+
+    #[doc(hidden)]
+    #[allow(clippy::too_many_arguments)]
+    unsafe fn gemv(
+        trans: CBLAS_TRANSPOSE,
+        m: i64,
+        n: i64,
+        alpha: Self,
+        a: *const Self,
+        lda: i64,
+        x: *const Self,
+        incx: i64,
+        beta: Self,
+        y: *mut Self,
+        incy: i64,
+    );
+
+    #[doc(hidden)]
+    #[allow(clippy::too_many_arguments)]
+    unsafe fn trmv(
+        uplo: CBLAS_UPLO,
+        trans: CBLAS_TRANSPOSE,
+        diag: CBLAS_DIAG,
+        n: i64,
+        a: *const Self,
+        lda: i64,
+        x: *mut Self,
+        incx: i64,
+    );
+
+    #[doc(hidden)]
+    unsafe fn axpy(n: i64, alpha: Self, x: *const Self, incx: i64, y: *mut Self, incy: i64);
+}
+
+/// Real scalars go to the C API by value.
+macro_rules! impl_real_scalar {
+    ($t:ty, $gemm:ident, $gemv:ident, $trmv:ident, $axpy:ident) => {
+        impl sealed::Sealed for $t {}
+
+        impl Scalar for $t {
+            const IS_COMPLEX: bool = false;
+
+            #[inline]
+            unsafe fn gemm(
+                transa: CBLAS_TRANSPOSE,
+                transb: CBLAS_TRANSPOSE,
+                m: i64,
+                n: i64,
+                k: i64,
+                alpha: Self,
+                a: *const Self,
+                lda: i64,
+                b: *const Self,
+                ldb: i64,
+                beta: Self,
+                c: *mut Self,
+                ldc: i64,
+            ) {
+                unsafe {
+                    $gemm(
+                        CblasColMajor,
+                        transa,
+                        transb,
+                        m,
+                        n,
+                        k,
+                        alpha,
+                        a,
+                        lda,
+                        b,
+                        ldb,
+                        beta,
+                        c,
+                        ldc,
+                    )
+                }
+            }
+
+            #[inline]
+            unsafe fn gemv(
+                trans: CBLAS_TRANSPOSE,
+                m: i64,
+                n: i64,
+                alpha: Self,
+                a: *const Self,
+                lda: i64,
+                x: *const Self,
+                incx: i64,
+                beta: Self,
+                y: *mut Self,
+                incy: i64,
+            ) {
+                unsafe {
+                    $gemv(
+                        CblasColMajor,
+                        trans,
+                        m,
+                        n,
+                        alpha,
+                        a,
+                        lda,
+                        x,
+                        incx,
+                        beta,
+                        y,
+                        incy,
+                    )
+                }
+            }
+
+            #[inline]
+            unsafe fn trmv(
+                uplo: CBLAS_UPLO,
+                trans: CBLAS_TRANSPOSE,
+                diag: CBLAS_DIAG,
+                n: i64,
+                a: *const Self,
+                lda: i64,
+                x: *mut Self,
+                incx: i64,
+            ) {
+                unsafe { $trmv(CblasColMajor, uplo, trans, diag, n, a, lda, x, incx) }
+            }
+
+            #[inline]
+            unsafe fn axpy(
+                n: i64,
+                alpha: Self,
+                x: *const Self,
+                incx: i64,
+                y: *mut Self,
+                incy: i64,
+            ) {
+                unsafe { $axpy(n, alpha, x, incx, y, incy) }
+            }
+        }
+    };
+}
+
+/// Complex scalars go to the C API by pointer.
+macro_rules! impl_complex_scalar {
+    ($t:ty, $gemm:ident, $gemv:ident, $trmv:ident, $axpy:ident) => {
+        impl sealed::Sealed for $t {}
+
+        impl Scalar for $t {
+            const IS_COMPLEX: bool = true;
+
+            #[inline]
+            unsafe fn gemm(
+                transa: CBLAS_TRANSPOSE,
+                transb: CBLAS_TRANSPOSE,
+                m: i64,
+                n: i64,
+                k: i64,
+                alpha: Self,
+                a: *const Self,
+                lda: i64,
+                b: *const Self,
+                ldb: i64,
+                beta: Self,
+                c: *mut Self,
+                ldc: i64,
+            ) {
+                unsafe {
+                    $gemm(
+                        CblasColMajor,
+                        transa,
+                        transb,
+                        m,
+                        n,
+                        k,
+                        &alpha,
+                        a,
+                        lda,
+                        b,
+                        ldb,
+                        &beta,
+                        c,
+                        ldc,
+                    )
+                }
+            }
+
+            #[inline]
+            unsafe fn gemv(
+                trans: CBLAS_TRANSPOSE,
+                m: i64,
+                n: i64,
+                alpha: Self,
+                a: *const Self,
+                lda: i64,
+                x: *const Self,
+                incx: i64,
+                beta: Self,
+                y: *mut Self,
+                incy: i64,
+            ) {
+                unsafe {
+                    $gemv(
+                        CblasColMajor,
+                        trans,
+                        m,
+                        n,
+                        &alpha,
+                        a,
+                        lda,
+                        x,
+                        incx,
+                        &beta,
+                        y,
+                        incy,
+                    )
+                }
+            }
+
+            #[inline]
+            unsafe fn trmv(
+                uplo: CBLAS_UPLO,
+                trans: CBLAS_TRANSPOSE,
+                diag: CBLAS_DIAG,
+                n: i64,
+                a: *const Self,
+                lda: i64,
+                x: *mut Self,
+                incx: i64,
+            ) {
+                unsafe { $trmv(CblasColMajor, uplo, trans, diag, n, a, lda, x, incx) }
+            }
+
+            #[inline]
+            unsafe fn axpy(
+                n: i64,
+                alpha: Self,
+                x: *const Self,
+                incx: i64,
+                y: *mut Self,
+                incy: i64,
+            ) {
+                unsafe { $axpy(n, &alpha, x, incx, y, incy) }
+            }
+        }
+    };
+}
+
+impl_real_scalar!(
+    f32,
+    cblas_sgemm_64,
+    cblas_sgemv_64,
+    cblas_strmv_64,
+    cblas_saxpy_64
+);
+impl_real_scalar!(
+    f64,
+    cblas_dgemm_64,
+    cblas_dgemv_64,
+    cblas_dtrmv_64,
+    cblas_daxpy_64
+);
+impl_complex_scalar!(
+    Complex32,
+    cblas_cgemm_64,
+    cblas_cgemv_64,
+    cblas_ctrmv_64,
+    cblas_caxpy_64
+);
+impl_complex_scalar!(
+    Complex64,
+    cblas_zgemm_64,
+    cblas_zgemv_64,
+    cblas_ztrmv_64,
+    cblas_zaxpy_64
+);
+
+/// Storage order of a matrix view.
+pub trait Layout: sealed::Sealed {
+    /// The layout of the transposed view of the same storage.
+    type Transposed: Layout;
+    #[doc(hidden)]
+    const COL_MAJOR: bool;
+}
+
+/// Column-major storage: element `(i, j)` at `i + j * ld`.
+pub enum ColMajor {}
+/// Row-major storage: element `(i, j)` at `i * ld + j`.
+pub enum RowMajor {}
+
+impl sealed::Sealed for ColMajor {}
+impl sealed::Sealed for RowMajor {}
+
+impl Layout for ColMajor {
+    type Transposed = RowMajor;
+    const COL_MAJOR: bool = true;
+}
+
+impl Layout for RowMajor {
+    type Transposed = ColMajor;
+    const COL_MAJOR: bool = false;
+}
+
+/// Whether a matrix view reads the conjugate of its storage.
+pub trait Conj: sealed::Sealed {
+    /// The opposite conjugation.
+    type Toggled: Conj;
+    #[doc(hidden)]
+    const CONJ: bool;
+}
+
+/// A view of the stored elements as they are.
+pub enum Plain {}
+/// A view of the complex conjugates of the stored elements.
+pub enum Conjugated {}
+
+impl sealed::Sealed for Plain {}
+impl sealed::Sealed for Conjugated {}
+
+impl Conj for Plain {
+    type Toggled = Conjugated;
+    const CONJ: bool = false;
+}
+
+impl Conj for Conjugated {
+    type Toggled = Plain;
+    const CONJ: bool = true;
+}
+
+/// Minimum storage length of a `rows x cols` view with leading dimension `ld`.
+fn required_len(major: usize, minor: usize, ld: usize) -> usize {
+    if major == 0 || minor == 0 {
+        0
+    } else {
+        (minor - 1) * ld + major
+    }
+}
+
+/// `(major, minor)` extents of a `rows x cols` matrix stored in layout `L`.
+fn extents<L: Layout>(rows: usize, cols: usize) -> (usize, usize) {
+    if L::COL_MAJOR {
+        (rows, cols)
+    } else {
+        (cols, rows)
+    }
+}
+
+fn check_storage<L: Layout>(len: usize, rows: usize, cols: usize, ld: usize) {
+    let (major, minor) = extents::<L>(rows, cols);
+    assert!(
+        ld >= major.max(1),
+        "leading dimension {ld} < {} for a {rows} x {cols} view",
+        major.max(1)
+    );
+    assert!(
+        len >= required_len(major, minor, ld),
+        "{len} elements cannot hold a {rows} x {cols} view with leading dimension {ld}"
+    );
+}
+
+/// The column-major transpose flag that reads a view in layout `L` with
+/// conjugation `C`.
+fn trans<T: Scalar, L: Layout, C: Conj>() -> CBLAS_TRANSPOSE {
+    let conj = T::IS_COMPLEX && C::CONJ;
+    match (L::COL_MAJOR, conj) {
+        (true, false) => CblasNoTrans,
+        (false, false) => CblasTrans,
+        (false, true) => CblasConjTrans,
+        (true, true) => panic!("a conjugated column-major operand has no BLAS transpose flag"),
+    }
+}
+
+/// Immutable matrix view.
+pub struct MatRef<'a, T, L: Layout = ColMajor, C: Conj = Plain> {
+    data: &'a [T],
+    rows: usize,
+    cols: usize,
+    ld: usize,
+    _layout: PhantomData<(L, C)>,
+}
+
+impl<T, L: Layout, C: Conj> Clone for MatRef<'_, T, L, C> {
+    fn clone(&self) -> Self {
+        *self
+    }
+}
+
+impl<T, L: Layout, C: Conj> Copy for MatRef<'_, T, L, C> {}
+
+impl<'a, T, L: Layout> MatRef<'a, T, L> {
+    /// A densely stored `rows x cols` matrix.
+    pub fn new(data: &'a [T], rows: usize, cols: usize) -> Self {
+        Self::with_ld(data, rows, cols, extents::<L>(rows, cols).0.max(1))
+    }
+
+    /// A `rows x cols` matrix with leading dimension `ld`.
+    pub fn with_ld(data: &'a [T], rows: usize, cols: usize, ld: usize) -> Self {
+        check_storage::<L>(data.len(), rows, cols, ld);
+        MatRef {
+            data,
+            rows,
+            cols,
+            ld,
+            _layout: PhantomData,
+        }
+    }
+}
+
+impl<'a, T, L: Layout, C: Conj> MatRef<'a, T, L, C> {
+    pub fn rows(&self) -> usize {
+        self.rows
+    }
+
+    pub fn cols(&self) -> usize {
+        self.cols
+    }
+
+    /// The transpose, viewing the same storage.
+    pub fn t(self) -> MatRef<'a, T, L::Transposed, C> {
+        MatRef {
+            data: self.data,
+            rows: self.cols,
+            cols: self.rows,
+            ld: self.ld,
+            _layout: PhantomData,
+        }
+    }
+
+    /// The conjugate transpose, viewing the same storage.
+    pub fn h(self) -> MatRef<'a, T, L::Transposed, C::Toggled> {
+        MatRef {
+            data: self.data,
+            rows: self.cols,
+            cols: self.rows,
+            ld: self.ld,
+            _layout: PhantomData,
+        }
+    }
+
+    /// `(rows, cols)` of the column-major matrix the BLAS call sees.
+    fn stored(&self) -> (i64, i64) {
+        let (major, minor) = extents::<L>(self.rows, self.cols);
+        (major as i64, minor as i64)
+    }
+}
+
+/// Mutable matrix view.
+pub struct MatMut<'a, T, L: Layout = ColMajor> {
+    data: &'a mut [T],
+    rows: usize,
+    cols: usize,
+    ld: usize,
+    _layout: PhantomData<L>,
+}
+
+impl<'a, T, L: Layout> MatMut<'a, T, L> {
+    /// A densely stored `rows x cols` matrix.
+    pub fn new(data: &'a mut [T], rows: usize, cols: usize) -> Self {
+        let ld = extents::<L>(rows, cols).0.max(1);
+        Self::with_ld(data, rows, cols, ld)
+    }
+
+    /// A `rows x cols` matrix with leading dimension `ld`.
+    pub fn with_ld(data: &'a mut [T], rows: usize, cols: usize, ld: usize) -> Self {
+        check_storage::<L>(data.len(), rows, cols, ld);
+        MatMut {
+            data,
+            rows,
+            cols,
+            ld,
+            _layout: PhantomData,
+        }
+    }
+
+    pub fn rows(&self) -> usize {
+        self.rows
+    }
+
+    pub fn cols(&self) -> usize {
+        self.cols
+    }
+
+    /// The transpose, viewing the same storage.
+    pub fn t(self) -> MatMut<'a, T, L::Transposed> {
+        MatMut {
+            data: self.data,
+            rows: self.cols,
+            cols: self.rows,
+            ld: self.ld,
+            _layout: PhantomData,
+        }
+    }
+
+    /// A shorter-lived view of the same storage.
+    pub fn rb_mut(&mut self) -> MatMut<'_, T, L> {
+        MatMut {
+            data: &mut *self.data,
+            rows: self.rows,
+            cols: self.cols,
+            ld: self.ld,
+            _layout: PhantomData,
+        }
+    }
+
+    /// An immutable view of the same storage.
+    pub fn rb(&self) -> MatRef<'_, T, L> {
+        MatRef {
+            data: &*self.data,
+            rows: self.rows,
+            cols: self.cols,
+            ld: self.ld,
+            _layout: PhantomData,
+        }
+    }
+}
+
+/// Immutable strided vector view.
+pub struct VecRef<'a, T> {
+    data: &'a [T],
+    len: usize,
+    inc: usize,
+}
+
+impl<T> Clone for VecRef<'_, T> {
+    fn clone(&self) -> Self {
+        *self
+    }
+}
+
+impl<T> Copy for VecRef<'_, T> {}
+
+impl<'a, T> VecRef<'a, T> {
+    /// `len` elements `inc` apart, starting at `data[0]`.
+    pub fn strided(data: &'a [T], len: usize, inc: usize) -> Self {
+        assert!(inc > 0, "vector increment must be positive");
+        assert!(
+            data.len() >= required_len(1, len, inc),
+            "{} elements cannot hold {len} elements {inc} apart",
+            data.len()
+        );
+        VecRef { data, len, inc }
+    }
+
+    pub fn len(&self) -> usize {
+        self.len
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+}
+
+impl<'a, T> From<&'a [T]> for VecRef<'a, T> {
+    fn from(data: &'a [T]) -> Self {
+        VecRef {
+            data,
+            len: data.len(),
+            inc: 1,
+        }
+    }
+}
+
+/// Mutable strided vector view.
+pub struct VecMut<'a, T> {
+    data: &'a mut [T],
+    len: usize,
+    inc: usize,
+}
+
+impl<'a, T> VecMut<'a, T> {
+    /// `len` elements `inc` apart, starting at `data[0]`.
+    pub fn strided(data: &'a mut [T], len: usize, inc: usize) -> Self {
+        assert!(inc > 0, "vector increment must be positive");
+        assert!(
+            data.len() >= required_len(1, len, inc),
+            "{} elements cannot hold {len} elements {inc} apart",
+            data.len()
+        );
+        VecMut { data, len, inc }
+    }
+
+    pub fn len(&self) -> usize {
+        self.len
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+}
+
+impl<'a, T> From<&'a mut [T]> for VecMut<'a, T> {
+    fn from(data: &'a mut [T]) -> Self {
+        VecMut {
+            len: data.len(),
+            data,
+            inc: 1,
+        }
+    }
+}
+
+/// `C = alpha * A * B + beta * C`.
+///
+/// Transposed and conjugated operands are passed as [`MatRef::t`] and
+/// [`MatRef::h`] views. With `beta == 0`, C is overwritten without being read.
+pub fn gemm<T, LA, CA, LB, CB, LC>(
+    alpha: T,
+    a: MatRef<'_, T, LA, CA>,
+    b: MatRef<'_, T, LB, CB>,
+    beta: T,
+    c: MatMut<'_, T, LC>,
+) where
+    T: Scalar,
+    LA: Layout,
+    CA: Conj,
+    LB: Layout,
+    CB: Conj,
+    LC: Layout,
+{
+    assert!(
+        a.rows == c.rows && b.cols == c.cols && a.cols == b.rows,
+        "gemm shapes ({} x {}) * ({} x {}) -> ({} x {}) do not match",
+        a.rows,
+        a.cols,
+        b.rows,
+        b.cols,
+        c.rows,
+        c.cols
+    );
+    let (m, n, k) = (c.rows as i64, c.cols as i64, a.cols as i64);
+    let (lda, ldb, ldc) = (a.ld as i64, b.ld as i64, c.ld as i64);
+    let (a, b, c) = (a.data.as_ptr(), b.data.as_ptr(), c.data.as_mut_ptr());
+    // A row-major C is the column-major C^T = B^T * A^T.
+    unsafe {
+        if LC::COL_MAJOR {
+            T::gemm(
+                trans::<T, LA, CA>(),
+                trans::<T, LB, CB>(),
+                m,
+                n,
+                k,
+                alpha,
+                a,
+                lda,
+                b,
+                ldb,
+                beta,
+                c,
+                ldc,
+            );
+        } else {
+            T::gemm(
+                trans::<T, LB::Transposed, CB>(),
+                trans::<T, LA::Transposed, CA>(),
+                n,
+                m,
+                k,
+                alpha,
+                b,
+                ldb,
+                a,
+                lda,
+                beta,
+                c,
+                ldc,
+            );
+        }
+    }
+}
+
+/// `y = alpha * A * x + beta * y`.
+pub fn gemv<T: Scalar, L: Layout, C: Conj>(
+    alpha: T,
+    a: MatRef<'_, T, L, C>,
+    x: VecRef<'_, T>,
+    beta: T,
+    y: VecMut<'_, T>,
+) {
+    assert!(
+        a.cols == x.len && a.rows == y.len,
+        "gemv shapes ({} x {}) * {} -> {} do not match",
+        a.rows,
+        a.cols,
+        x.len,
+        y.len
+    );
+    let (m, n) = a.stored();
+    unsafe {
+        T::gemv(
+            trans::<T, L, C>(),
+            m,
+            n,
+            alpha,
+            a.data.as_ptr(),
+            a.ld as i64,
+            x.data.as_ptr(),
+            x.inc as i64,
+            beta,
+            y.data.as_mut_ptr(),
+            y.inc as i64,
+        );
+    }
+}
+
+/// `x = A * x` for a triangular `A`.
+///
+/// `uplo` names the triangle of `A` as viewed, so the upper triangle of a
+/// [`MatRef::t`] view is the lower triangle of its storage.
+pub fn trmv<T: Scalar, L: Layout, C: Conj>(
+    uplo: CBLAS_UPLO,
+    diag: CBLAS_DIAG,
+    a: MatRef<'_, T, L, C>,
+    x: VecMut<'_, T>,
+) {
+    assert!(
+        a.rows == a.cols && a.cols == x.len,
+        "trmv shapes ({} x {}) * {} do not match",
+        a.rows,
+        a.cols,
+        x.len
+    );
+    // The storage of a row-major view is its transpose in column-major.
+    let uplo = match (L::COL_MAJOR, uplo) {
+        (true, uplo) => uplo,
+        (false, CblasUpper) => CblasLower,
+        (false, CblasLower) => CblasUpper,
+    };
+    unsafe {
+        T::trmv(
+            uplo,
+            trans::<T, L, C>(),
+            diag,
+            a.rows as i64,
+            a.data.as_ptr(),
+            a.ld as i64,
+            x.data.as_mut_ptr(),
+            x.inc as i64,
+        );
+    }
+}
+
+/// `y = alpha * x + y`.
+pub fn axpy<T: Scalar>(alpha: T, x: VecRef<'_, T>, y: VecMut<'_, T>) {
+    assert_eq!(x.len, y.len, "axpy lengths do not match");
+    unsafe {
+        T::axpy(
+            x.len as i64,
+            alpha,
+            x.data.as_ptr(),
+            x.inc as i64,
+            y.data.as_mut_ptr(),
+            y.inc as i64,
+        );
+    }
+}
@@ -4,44 +4,117 @@
 //! so no row-major conversion is needed - arguments are passed directly
 //! to the Fortran BLAS functions.
 
+use std::ops::Add;
+
 use num_complex::{Complex32, Complex64};
 
 use crate::backend::{
-    get_cdotc_for_ilp64_cblas, get_cdotc_for_lp64_cblas, get_cdotu_for_ilp64_cblas,
-    get_cdotu_for_lp64_cblas, get_complex_return_style, get_dasum_for_ilp64_cblas,
-    get_dasum_for_lp64_cblas, get_ddot_for_ilp64_cblas, get_ddot_for_lp64_cblas,
-    get_dnrm2_for_ilp64_cblas, get_dnrm2_for_lp64_cblas, get_dsdot_for_ilp64_cblas,
-    get_dsdot_for_lp64_cblas, get_dzasum_for_ilp64_cblas, get_dzasum_for_lp64_cblas,
-    get_dznrm2_for_ilp64_cblas, get_dznrm2_for_lp64_cblas, get_icamax_for_ilp64_cblas,
-    get_icamax_for_lp64_cblas, get_idamax_for_ilp64_cblas, get_idamax_for_lp64_cblas,
-    get_isamax_for_ilp64_cblas, get_isamax_for_lp64_cblas, get_izamax_for_ilp64_cblas,
-    get_izamax_for_lp64_cblas, get_sasum_for_ilp64_cblas, get_sasum_for_lp64_cblas,
-    get_scasum_for_ilp64_cblas, get_scasum_for_lp64_cblas, get_scnrm2_for_ilp64_cblas,
-    get_scnrm2_for_lp64_cblas, get_sdot_for_ilp64_cblas, get_sdot_for_lp64_cblas,
-    get_sdsdot_for_ilp64_cblas, get_sdsdot_for_lp64_cblas, get_snrm2_for_ilp64_cblas,
-    get_snrm2_for_lp64_cblas, get_zdotc_for_ilp64_cblas, get_zdotc_for_lp64_cblas,
-    get_zdotu_for_ilp64_cblas, get_zdotu_for_lp64_cblas, BlasInt32, BlasInt64,
-    CdotcHiddenIlp64FnPtr, CdotcHiddenLp64FnPtr, CdotcIlp64FnPtr, CdotcLp64FnPtr, CdotcProvider,
-    CdotuHiddenIlp64FnPtr, CdotuHiddenLp64FnPtr, CdotuIlp64FnPtr, CdotuLp64FnPtr, CdotuProvider,
-    DasumProvider, DdotProvider, Dnrm2Provider, DsdotProvider, DzasumProvider, Dznrm2Provider,
-    IcamaxProvider, IdamaxProvider, IsamaxProvider, IzamaxProvider, SasumProvider, ScasumProvider,
-    Scnrm2Provider, SdotProvider, SdsdotProvider, Snrm2Provider, ZdotcHiddenIlp64FnPtr,
-    ZdotcHiddenLp64FnPtr, ZdotcIlp64FnPtr, ZdotcLp64FnPtr, ZdotcProvider, ZdotuHiddenIlp64FnPtr,
-    ZdotuHiddenLp64FnPtr, ZdotuIlp64FnPtr, ZdotuLp64FnPtr, ZdotuProvider,
+    get_cdotc_dispatch_for_ilp64_cblas, get_cdotc_dispatch_for_lp64_cblas,
+    get_cdotu_dispatch_for_ilp64_cblas, get_cdotu_dispatch_for_lp64_cblas,
+    get_dsdot_for_ilp64_cblas, get_dsdot_for_lp64_cblas, get_dzasum_for_ilp64_cblas,
+    get_dzasum_for_lp64_cblas, get_dznrm2_for_ilp64_cblas, get_dznrm2_for_lp64_cblas,
+    get_icamax_for_ilp64_cblas, get_icamax_for_lp64_cblas, get_izamax_for_ilp64_cblas,
+    get_izamax_for_lp64_cblas, get_scasum_for_ilp64_cblas, get_scasum_for_lp64_cblas,
+    get_scnrm2_for_ilp64_cblas, get_scnrm2_for_lp64_cblas, get_sdsdot_for_ilp64_cblas,
+    get_sdsdot_for_lp64_cblas, get_zdotc_dispatch_for_ilp64_cblas,
+    get_zdotc_dispatch_for_lp64_cblas, get_zdotu_dispatch_for_ilp64_cblas,
+    get_zdotu_dispatch_for_lp64_cblas, try_get_dasum_for_ilp64_cblas, try_get_dasum_for_lp64_cblas,
+    try_get_ddot_for_ilp64_cblas, try_get_ddot_for_lp64_cblas, try_get_dnrm2_for_ilp64_cblas,
+    try_get_dnrm2_for_lp64_cblas, try_get_idamax_for_ilp64_cblas, try_get_idamax_for_lp64_cblas,
+    try_get_isamax_for_ilp64_cblas, try_get_isamax_for_lp64_cblas, try_get_sasum_for_ilp64_cblas,
+    try_get_sasum_for_lp64_cblas, try_get_sdot_for_ilp64_cblas, try_get_sdot_for_lp64_cblas,
+    try_get_snrm2_for_ilp64_cblas, try_get_snrm2_for_lp64_cblas, BlasInt32, BlasInt64,
+    CdotcDispatch, CdotuDispatch, DasumProvider, DdotProvider, Dnrm2Provider, DsdotProvider,
+    DzasumProvider, Dznrm2Provider, IcamaxProvider, IdamaxProvider, IsamaxProvider, IzamaxProvider,
+    SasumProvider, ScasumProvider, Scnrm2Provider, SdotProvider, SdsdotProvider, Snrm2Provider,
+    ZdotcDispatch, ZdotuDispatch,
 };
-use crate::types::ComplexReturnStyle;
-
-#[inline]
-fn complex_dot_to_lp64_i64(
+use crate::dispatch;
+use crate::int_convert::unchecked_lp64_i64;
+use crate::lp64_split::{self, Shared};
+use crate::native::blas1 as native;
+use crate::stats::Routine;
+
+/// A `_64` dot product on an LP64 provider, summed over chunks of `n`.
+unsafe fn dot_lp64<T, R>(
     n: i64,
+    x: *const T,
     incx: i64,
+    y: *const T,
     incy: i64,
-) -> Option<(BlasInt32, BlasInt32, BlasInt32)> {
-    Some((
-        BlasInt32::try_from(n).ok()?,
-        BlasInt32::try_from(incx).ok()?,
-        BlasInt32::try_from(incy).ok()?,
-    ))
+    call: impl Fn(&BlasInt32, *const T, &BlasInt32, *const T, &BlasInt32) -> R + Sync,
+) -> R
+where
+    R: Add<Output = R> + Send + Sync,
+{
+    let (x, y) = (Shared::new(x), Shared::new(y));
+    let (lp64_incx, lp64_incy) = (unchecked_lp64_i64(incx), unchecked_lp64_i64(incy));
+    lp64_split::vector(
+        n,
+        &|start, len| unsafe {
+            call(
+                &len,
+                x.chunk(n, incx, start, len),
+                &lp64_incx,
+                y.chunk(n, incy, start, len),
+                &lp64_incy,
+            )
+        },
+        |a, b| a + b,
+    )
+}
+
+/// A `_64` reduction of one vector on an LP64 provider, merging the results
+/// for chunks of `n` with `merge`.
+unsafe fn reduce_lp64<T, R: Send + Sync>(
+    n: i64,
+    x: *const T,
+    incx: i64,
+    call: impl Fn(&BlasInt32, *const T, &BlasInt32) -> R + Sync,
+    merge: impl Fn(R, R) -> R,
+) -> R {
+    let x = Shared::new(x);
+    let lp64_incx = unchecked_lp64_i64(incx);
+    lp64_split::vector(
+        n,
+        &|start, len| unsafe { call(&len, x.chunk(n, incx, start, len), &lp64_incx) },
+        merge,
+    )
+}
+
+/// A `_64` I?AMAX on an LP64 provider, as a 0-based index.
+///
+/// Each chunk's 1-based index is offset by the chunk start, and a later
+/// chunk only wins with a strictly larger `magnitude`, which keeps the first
+/// maximum as BLAS does.
+unsafe fn iamax_lp64<T: Copy, M: PartialOrd + Send + Sync>(
+    n: i64,
+    x: *const T,
+    incx: i64,
+    call: impl Fn(&BlasInt32, *const T, &BlasInt32) -> BlasInt32 + Sync,
+    magnitude: impl Fn(T) -> M + Sync,
+) -> i64 {
+    let x = Shared::new(x);
+    let lp64_incx = unchecked_lp64_i64(incx);
+    let best = lp64_split::vector(
+        n,
+        &|start, len| unsafe {
+            let chunk = x.chunk(n, incx, start, len);
+            let idx = i64::from(call(&len, chunk, &lp64_incx));
+            (idx > 0).then(|| {
+                (
+                    start + idx - 1,
+                    magnitude(*chunk.offset(((idx - 1) * incx) as isize)),
+                )
+            })
+        },
+        |first, next| match (&first, &next) {
+            (Some((_, a)), Some((_, b))) if b > a => next,
+            (None, _) => next,
+            _ => first,
+        },
+    );
+    best.map_or(0, |(idx, _)| idx)
 }
 
 // =============================================================================
@@ -65,7 +138,10 @@ pub unsafe extern "C" fn cblas_sdot(
     y: *const f32,
     incy: i32,
 ) -> f32 {
-    let p = get_sdot_for_lp64_cblas();
+    let _call = dispatch::enter(Routine::Sdot, None, [], [n], [incx, incy]);
+    let Some(p) = native::select_provider(i64::from(n), try_get_sdot_for_lp64_cblas) else {
+        return native::dot(i64::from(n), x, i64::from(incx), y, i64::from(incy));
+    };
     match p {
         SdotProvider::Lp64(f) => f(&n, x, &incx, y, &incy),
         SdotProvider::Ilp64(f) => f(&(n as i64), x, &(incx as i64), y, &(incy as i64)),
@@ -81,17 +157,21 @@ pub unsafe extern "C" fn cblas_sdot_64(
     y: *const f32,
     incy: i64,
 ) -> f32 {
-    let p = get_sdot_for_ilp64_cblas();
+    let _call = dispatch::enter(Routine::Sdot, None, [], [n], [incx, incy]);
+    let Some(p) = native::select_provider(n, try_get_sdot_for_ilp64_cblas) else {
+        return native::dot(n, x, incx, y, incy);
+    };
     if matches!(p, SdotProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(b"cblas_sdot_64\0", [(1, n), (3, incx), (5, incy)])
-            .is_none()
+        && !lp64_split::check_i64(b"cblas_sdot_64\0", [(3, incx), (5, incy)], [(1, n)])
     {
         return 0.0;
     }
 
     match p {
         SdotProvider::Ilp64(f) => f(&n, x, &incx, y, &incy),
-        SdotProvider::Lp64(f) => f(&(n as i32), x, &(incx as i32), y, &(incy as i32)),
+        SdotProvider::Lp64(f) => dot_lp64(n, x, incx, y, incy, |n, x, incx, y, incy| {
+            f(n, x, incx, y, incy)
+        }),
     }
 }
 
@@ -112,7 +192,10 @@ pub unsafe extern "C" fn cblas_ddot(
     y: *const f64,
     incy: i32,
 ) -> f64 {
-    let p = get_ddot_for_lp64_cblas();
+    let _call = dispatch::enter(Routine::Ddot, None, [], [n], [incx, incy]);
+    let Some(p) = native::select_provider(i64::from(n), try_get_ddot_for_lp64_cblas) else {
+        return native::dot(i64::from(n), x, i64::from(incx), y, i64::from(incy));
+    };
     match p {
         DdotProvider::Lp64(f) => f(&n, x, &incx, y, &incy),
         DdotProvider::Ilp64(f) => f(&(n as i64), x, &(incx as i64), y, &(incy as i64)),
@@ -128,17 +211,21 @@ pub unsafe extern "C" fn cblas_ddot_64(
     y: *const f64,
     incy: i64,
 ) -> f64 {
-    let p = get_ddot_for_ilp64_cblas();
+    let _call = dispatch::enter(Routine::Ddot, None, [], [n], [incx, incy]);
+    let Some(p) = native::select_provider(n, try_get_ddot_for_ilp64_cblas) else {
+        return native::dot(n, x, incx, y, incy);
+    };
     if matches!(p, DdotProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(b"cblas_ddot_64\0", [(1, n), (3, incx), (5, incy)])
-            .is_none()
+        && !lp64_split::check_i64(b"cblas_ddot_64\0", [(3, incx), (5, incy)], [(1, n)])
     {
         return 0.0;
     }
 
     match p {
         DdotProvider::Ilp64(f) => f(&n, x, &incx, y, &incy),
-        DdotProvider::Lp64(f) => f(&(n as i32), x, &(incx as i32), y, &(incy as i32)),
+        DdotProvider::Lp64(f) => dot_lp64(n, x, incx, y, incy, |n, x, incx, y, incy| {
+            f(n, x, incx, y, incy)
+        }),
     }
 }
 
@@ -160,33 +247,28 @@ pub unsafe extern "C" fn cblas_cdotu_sub(
     incy: i32,
     dotu: *mut Complex32,
 ) {
-    match get_cdotu_for_lp64_cblas() {
-        CdotuProvider::Lp64(ptr) => match get_complex_return_style() {
-            ComplexReturnStyle::ReturnValue => {
-                let f: CdotuLp64FnPtr = std::mem::transmute(ptr);
-                *dotu = f(&n, x, &incx, y, &incy);
-            }
-            ComplexReturnStyle::HiddenArgument => {
-                let f: CdotuHiddenLp64FnPtr = std::mem::transmute(ptr);
-                f(dotu, &n, x, &incx, y, &incy);
-            }
-        },
-        CdotuProvider::Ilp64(ptr) => {
-            let n = BlasInt64::from(n);
-            let incx = BlasInt64::from(incx);
-            let incy = BlasInt64::from(incy);
-            match get_complex_return_style() {
-                ComplexReturnStyle::ReturnValue => {
-                    let f: CdotuIlp64FnPtr = std::mem::transmute(ptr);
-                    *dotu = f(&n, x, &incx, y, &incy);
-                }
-                ComplexReturnStyle::HiddenArgument => {
-                    let f: CdotuHiddenIlp64FnPtr = std::mem::transmute(ptr);
-                    f(dotu, &n, x, &incx, y, &incy);
-                }
-            }
+    let _call = dispatch::enter(Routine::CdotuSub, None, [], [n], [incx, incy]);
+    match get_cdotu_dispatch_for_lp64_cblas() {
+        CdotuDispatch::Lp64(f) => *dotu = f(&n, x, &incx, y, &incy),
+        CdotuDispatch::Lp64Hidden(f) => f(dotu, &n, x, &incx, y, &incy),
+        CdotuDispatch::Ilp64(f) => {
+            *dotu = f(
+                &BlasInt64::from(n),
+                x,
+                &BlasInt64::from(incx),
+                y,
+                &BlasInt64::from(incy),
+            )
         }
-    };
+        CdotuDispatch::Ilp64Hidden(f) => f(
+            dotu,
+            &BlasInt64::from(n),
+            x,
+            &BlasInt64::from(incx),
+            y,
+            &BlasInt64::from(incy),
+        ),
+    }
 }
 
 /// Complex single precision dot product (unconjugated) with ILP64 integer ABI.
@@ -199,33 +281,29 @@ pub unsafe extern "C" fn cblas_cdotu_sub_64(
     incy: i64,
     dotu: *mut Complex32,
 ) {
-    match get_cdotu_for_ilp64_cblas() {
-        CdotuProvider::Ilp64(ptr) => match get_complex_return_style() {
-            ComplexReturnStyle::ReturnValue => {
-                let f: CdotuIlp64FnPtr = std::mem::transmute(ptr);
-                *dotu = f(&n, x, &incx, y, &incy);
-            }
-            ComplexReturnStyle::HiddenArgument => {
-                let f: CdotuHiddenIlp64FnPtr = std::mem::transmute(ptr);
-                f(dotu, &n, x, &incx, y, &incy);
+    let _call = dispatch::enter(Routine::CdotuSub, None, [], [n], [incx, incy]);
+    match get_cdotu_dispatch_for_ilp64_cblas() {
+        CdotuDispatch::Ilp64(f) => *dotu = f(&n, x, &incx, y, &incy),
+        CdotuDispatch::Ilp64Hidden(f) => f(dotu, &n, x, &incx, y, &incy),
+        CdotuDispatch::Lp64(f) => {
+            if !lp64_split::check_i64(b"cblas_cdotu_sub_64\0", [(3, incx), (5, incy)], [(1, n)]) {
+                return;
             }
-        },
-        CdotuProvider::Lp64(ptr) => {
-            let Some((n, incx, incy)) = complex_dot_to_lp64_i64(n, incx, incy) else {
+            *dotu = dot_lp64(n, x, incx, y, incy, |n, x, incx, y, incy| {
+                f(n, x, incx, y, incy)
+            });
+        }
+        CdotuDispatch::Lp64Hidden(f) => {
+            if !lp64_split::check_i64(b"cblas_cdotu_sub_64\0", [(3, incx), (5, incy)], [(1, n)]) {
                 return;
-            };
-            match get_complex_return_style() {
-                ComplexReturnStyle::ReturnValue => {
-                    let f: CdotuLp64FnPtr = std::mem::transmute(ptr);
-                    *dotu = f(&n, x, &incx, y, &incy);
-                }
-                ComplexReturnStyle::HiddenArgument => {
-                    let f: CdotuHiddenLp64FnPtr = std::mem::transmute(ptr);
-                    f(dotu, &n, x, &incx, y, &incy);
-                }
             }
+            *dotu = dot_lp64(n, x, incx, y, incy, |n, x, incx, y, incy| {
+                let mut dot = Complex32::new(0.0, 0.0);
+                f(&mut dot, n, x, incx, y, incy);
+                dot
+            });
         }
-    };
+    }
 }
 
 /// Complex double precision dot product (unconjugated).
@@ -246,33 +324,28 @@ pub unsafe extern "C" fn cblas_zdotu_sub(
     incy: i32,
     dotu: *mut Complex64,
 ) {
-    match get_zdotu_for_lp64_cblas() {
-        ZdotuProvider::Lp64(ptr) => match get_complex_return_style() {
-            ComplexReturnStyle::ReturnValue => {
-                let f: ZdotuLp64FnPtr = std::mem::transmute(ptr);
-                *dotu = f(&n, x, &incx, y, &incy);
-            }
-            ComplexReturnStyle::HiddenArgument => {
-                let f: ZdotuHiddenLp64FnPtr = std::mem::transmute(ptr);
-                f(dotu, &n, x, &incx, y, &incy);
-            }
-        },
-        ZdotuProvider::Ilp64(ptr) => {
-            let n = BlasInt64::from(n);
-            let incx = BlasInt64::from(incx);
-            let incy = BlasInt64::from(incy);
-            match get_complex_return_style() {
-                ComplexReturnStyle::ReturnValue => {
-                    let f: ZdotuIlp64FnPtr = std::mem::transmute(ptr);
-                    *dotu = f(&n, x, &incx, y, &incy);
-                }
-                ComplexReturnStyle::HiddenArgument => {
-                    let f: ZdotuHiddenIlp64FnPtr = std::mem::transmute(ptr);
-                    f(dotu, &n, x, &incx, y, &incy);
-                }
-            }
+    let _call = dispatch::enter(Routine::ZdotuSub, None, [], [n], [incx, incy]);
+    match get_zdotu_dispatch_for_lp64_cblas() {
+        ZdotuDispatch::Lp64(f) => *dotu = f(&n, x, &incx, y, &incy),
+        ZdotuDispatch::Lp64Hidden(f) => f(dotu, &n, x, &incx, y, &incy),
+        ZdotuDispatch::Ilp64(f) => {
+            *dotu = f(
+                &BlasInt64::from(n),
+                x,
+                &BlasInt64::from(incx),
+                y,
+                &BlasInt64::from(incy),
+            )
         }
-    };
+        ZdotuDispatch::Ilp64Hidden(f) => f(
+            dotu,
+            &BlasInt64::from(n),
+            x,
+            &BlasInt64::from(incx),
+            y,
+            &BlasInt64::from(incy),
+        ),
+    }
 }
 
 /// Complex double precision dot product (unconjugated) with ILP64 integer ABI.
@@ -285,33 +358,29 @@ pub unsafe extern "C" fn cblas_zdotu_sub_64(
     incy: i64,
     dotu: *mut Complex64,
 ) {
-    match get_zdotu_for_ilp64_cblas() {
-        ZdotuProvider::Ilp64(ptr) => match get_complex_return_style() {
-            ComplexReturnStyle::ReturnValue => {
-                let f: ZdotuIlp64FnPtr = std::mem::transmute(ptr);
-                *dotu = f(&n, x, &incx, y, &incy);
-            }
-            ComplexReturnStyle::HiddenArgument => {
-                let f: ZdotuHiddenIlp64FnPtr = std::mem::transmute(ptr);
-                f(dotu, &n, x, &incx, y, &incy);
+    let _call = dispatch::enter(Routine::ZdotuSub, None, [], [n], [incx, incy]);
+    match get_zdotu_dispatch_for_ilp64_cblas() {
+        ZdotuDispatch::Ilp64(f) => *dotu = f(&n, x, &incx, y, &incy),
+        ZdotuDispatch::Ilp64Hidden(f) => f(dotu, &n, x, &incx, y, &incy),
+        ZdotuDispatch::Lp64(f) => {
+            if !lp64_split::check_i64(b"cblas_zdotu_sub_64\0", [(3, incx), (5, incy)], [(1, n)]) {
+                return;
             }
-        },
-        ZdotuProvider::Lp64(ptr) => {
-            let Some((n, incx, incy)) = complex_dot_to_lp64_i64(n, incx, incy) else {
+            *dotu = dot_lp64(n, x, incx, y, incy, |n, x, incx, y, incy| {
+                f(n, x, incx, y, incy)
+            });
+        }
+        ZdotuDispatch::Lp64Hidden(f) => {
+            if !lp64_split::check_i64(b"cblas_zdotu_sub_64\0", [(3, incx), (5, incy)], [(1, n)]) {
                 return;
-            };
-            match get_complex_return_style() {
-                ComplexReturnStyle::ReturnValue => {
-                    let f: ZdotuLp64FnPtr = std::mem::transmute(ptr);
-                    *dotu = f(&n, x, &incx, y, &incy);
-                }
-                ComplexReturnStyle::HiddenArgument => {
-                    let f: ZdotuHiddenLp64FnPtr = std::mem::transmute(ptr);
-                    f(dotu, &n, x, &incx, y, &incy);
-                }
             }
+            *dotu = dot_lp64(n, x, incx, y, incy, |n, x, incx, y, incy| {
+                let mut dot = Complex64::new(0.0, 0.0);
+                f(&mut dot, n, x, incx, y, incy);
+                dot
+            });
         }
-    };
+    }
 }
 
 /// Complex single precision dot product (conjugated).
@@ -332,33 +401,28 @@ pub unsafe extern "C" fn cblas_cdotc_sub(
     incy: i32,
     dotc: *mut Complex32,
 ) {
-    match get_cdotc_for_lp64_cblas() {
-        CdotcProvider::Lp64(ptr) => match get_complex_return_style() {
-            ComplexReturnStyle::ReturnValue => {
-                let f: CdotcLp64FnPtr = std::mem::transmute(ptr);
-                *dotc = f(&n, x, &incx, y, &incy);
-            }
-            ComplexReturnStyle::HiddenArgument => {
-                let f: CdotcHiddenLp64FnPtr = std::mem::transmute(ptr);
-                f(dotc, &n, x, &incx, y, &incy);
-            }
-        },
-        CdotcProvider::Ilp64(ptr) => {
-            let n = BlasInt64::from(n);
-            let incx = BlasInt64::from(incx);
-            let incy = BlasInt64::from(incy);
-            match get_complex_return_style() {
-                ComplexReturnStyle::ReturnValue => {
-                    let f: CdotcIlp64FnPtr = std::mem::transmute(ptr);
-                    *dotc = f(&n, x, &incx, y, &incy);
-                }
-                ComplexReturnStyle::HiddenArgument => {
-                    let f: CdotcHiddenIlp64FnPtr = std::mem::transmute(ptr);
-                    f(dotc, &n, x, &incx, y, &incy);
-                }
-            }
+    let _call = dispatch::enter(Routine::CdotcSub, None, [], [n], [incx, incy]);
+    match get_cdotc_dispatch_for_lp64_cblas() {
+        CdotcDispatch::Lp64(f) => *dotc = f(&n, x, &incx, y, &incy),
+        CdotcDispatch::Lp64Hidden(f) => f(dotc, &n, x, &incx, y, &incy),
+        CdotcDispatch::Ilp64(f) => {
+            *dotc = f(
+                &BlasInt64::from(n),
+                x,
+                &BlasInt64::from(incx),
+                y,
+                &BlasInt64::from(incy),
+            )
         }
-    };
+        CdotcDispatch::Ilp64Hidden(f) => f(
+            dotc,
+            &BlasInt64::from(n),
+            x,
+            &BlasInt64::from(incx),
+            y,
+            &BlasInt64::from(incy),
+        ),
+    }
 }
 
 /// Complex double precision dot product (conjugated).
@@ -379,33 +443,28 @@ pub unsafe extern "C" fn cblas_zdotc_sub(
     incy: i32,
     dotc: *mut Complex64,
 ) {
-    match get_zdotc_for_lp64_cblas() {
-        ZdotcProvider::Lp64(ptr) => match get_complex_return_style() {
-            ComplexReturnStyle::ReturnValue => {
-                let f: ZdotcLp64FnPtr = std::mem::transmute(ptr);
-                *dotc = f(&n, x, &incx, y, &incy);
-            }
-            ComplexReturnStyle::HiddenArgument => {
-                let f: ZdotcHiddenLp64FnPtr = std::mem::transmute(ptr);
-                f(dotc, &n, x, &incx, y, &incy);
-            }
-        },
-        ZdotcProvider::Ilp64(ptr) => {
-            let n = BlasInt64::from(n);
-            let incx = BlasInt64::from(incx);
-            let incy = BlasInt64::from(incy);
-            match get_complex_return_style() {
-                ComplexReturnStyle::ReturnValue => {
-                    let f: ZdotcIlp64FnPtr = std::mem::transmute(ptr);
-                    *dotc = f(&n, x, &incx, y, &incy);
-                }
-                ComplexReturnStyle::HiddenArgument => {
-                    let f: ZdotcHiddenIlp64FnPtr = std::mem::transmute(ptr);
-                    f(dotc, &n, x, &incx, y, &incy);
-                }
-            }
+    let _call = dispatch::enter(Routine::ZdotcSub, None, [], [n], [incx, incy]);
+    match get_zdotc_dispatch_for_lp64_cblas() {
+        ZdotcDispatch::Lp64(f) => *dotc = f(&n, x, &incx, y, &incy),
+        ZdotcDispatch::Lp64Hidden(f) => f(dotc, &n, x, &incx, y, &incy),
+        ZdotcDispatch::Ilp64(f) => {
+            *dotc = f(
+                &BlasInt64::from(n),
+                x,
+                &BlasInt64::from(incx),
+                y,
+                &BlasInt64::from(incy),
+            )
         }
-    };
+        ZdotcDispatch::Ilp64Hidden(f) => f(
+            dotc,
+            &BlasInt64::from(n),
+            x,
+            &BlasInt64::from(incx),
+            y,
+            &BlasInt64::from(incy),
+        ),
+    }
 }
 
 /// Complex single precision dot product (conjugated) with ILP64 integer ABI.
@@ -418,33 +477,29 @@ pub unsafe extern "C" fn cblas_cdotc_sub_64(
     incy: i64,
     dotc: *mut Complex32,
 ) {
-    match get_cdotc_for_ilp64_cblas() {
-        CdotcProvider::Ilp64(ptr) => match get_complex_return_style() {
-            ComplexReturnStyle::ReturnValue => {
-                let f: CdotcIlp64FnPtr = std::mem::transmute(ptr);
-                *dotc = f(&n, x, &incx, y, &incy);
-            }
-            ComplexReturnStyle::HiddenArgument => {
-                let f: CdotcHiddenIlp64FnPtr = std::mem::transmute(ptr);
-                f(dotc, &n, x, &incx, y, &incy);
+    let _call = dispatch::enter(Routine::CdotcSub, None, [], [n], [incx, incy]);
+    match get_cdotc_dispatch_for_ilp64_cblas() {
+        CdotcDispatch::Ilp64(f) => *dotc = f(&n, x, &incx, y, &incy),
+        CdotcDispatch::Ilp64Hidden(f) => f(dotc, &n, x, &incx, y, &incy),
+        CdotcDispatch::Lp64(f) => {
+            if !lp64_split::check_i64(b"cblas_cdotc_sub_64\0", [(3, incx), (5, incy)], [(1, n)]) {
+                return;
             }
-        },
-        CdotcProvider::Lp64(ptr) => {
-            let Some((n, incx, incy)) = complex_dot_to_lp64_i64(n, incx, incy) else {
+            *dotc = dot_lp64(n, x, incx, y, incy, |n, x, incx, y, incy| {
+                f(n, x, incx, y, incy)
+            });
+        }
+        CdotcDispatch::Lp64Hidden(f) => {
+            if !lp64_split::check_i64(b"cblas_cdotc_sub_64\0", [(3, incx), (5, incy)], [(1, n)]) {
                 return;
-            };
-            match get_complex_return_style() {
-                ComplexReturnStyle::ReturnValue => {
-                    let f: CdotcLp64FnPtr = std::mem::transmute(ptr);
-                    *dotc = f(&n, x, &incx, y, &incy);
-                }
-                ComplexReturnStyle::HiddenArgument => {
-                    let f: CdotcHiddenLp64FnPtr = std::mem::transmute(ptr);
-                    f(dotc, &n, x, &incx, y, &incy);
-                }
             }
+            *dotc = dot_lp64(n, x, incx, y, incy, |n, x, incx, y, incy| {
+                let mut dot = Complex32::new(0.0, 0.0);
+                f(&mut dot, n, x, incx, y, incy);
+                dot
+            });
         }
-    };
+    }
 }
 
 /// Complex double precision dot product (conjugated) with ILP64 integer ABI.
@@ -457,33 +512,119 @@ pub unsafe extern "C" fn cblas_zdotc_sub_64(
     incy: i64,
     dotc: *mut Complex64,
 ) {
-    match get_zdotc_for_ilp64_cblas() {
-        ZdotcProvider::Ilp64(ptr) => match get_complex_return_style() {
-            ComplexReturnStyle::ReturnValue => {
-                let f: ZdotcIlp64FnPtr = std::mem::transmute(ptr);
-                *dotc = f(&n, x, &incx, y, &incy);
-            }
-            ComplexReturnStyle::HiddenArgument => {
-                let f: ZdotcHiddenIlp64FnPtr = std::mem::transmute(ptr);
-                f(dotc, &n, x, &incx, y, &incy);
+    let _call = dispatch::enter(Routine::ZdotcSub, None, [], [n], [incx, incy]);
+    match get_zdotc_dispatch_for_ilp64_cblas() {
+        ZdotcDispatch::Ilp64(f) => *dotc = f(&n, x, &incx, y, &incy),
+        ZdotcDispatch::Ilp64Hidden(f) => f(dotc, &n, x, &incx, y, &incy),
+        ZdotcDispatch::Lp64(f) => {
+            if !lp64_split::check_i64(b"cblas_zdotc_sub_64\0", [(3, incx), (5, incy)], [(1, n)]) {
+                return;
             }
-        },
-        ZdotcProvider::Lp64(ptr) => {
-            let Some((n, incx, incy)) = complex_dot_to_lp64_i64(n, incx, incy) else {
+            *dotc = dot_lp64(n, x, incx, y, incy, |n, x, incx, y, incy| {
+                f(n, x, incx, y, incy)
+            });
+        }
+        ZdotcDispatch::Lp64Hidden(f) => {
+            if !lp64_split::check_i64(b"cblas_zdotc_sub_64\0", [(3, incx), (5, incy)], [(1, n)]) {
                 return;
-            };
-            match get_complex_return_style() {
-                ComplexReturnStyle::ReturnValue => {
-                    let f: ZdotcLp64FnPtr = std::mem::transmute(ptr);
-                    *dotc = f(&n, x, &incx, y, &incy);
-                }
-                ComplexReturnStyle::HiddenArgument => {
-                    let f: ZdotcHiddenLp64FnPtr = std::mem::transmute(ptr);
-                    f(dotc, &n, x, &incx, y, &incy);
-                }
             }
+            *dotc = dot_lp64(n, x, incx, y, incy, |n, x, incx, y, incy| {
+                let mut dot = Complex64::new(0.0, 0.0);
+                f(&mut dot, n, x, incx, y, incy);
+                dot
+            });
         }
-    };
+    }
+}
+
+// =============================================================================
+// Fused axpy and dot product
+// =============================================================================
+
+/// Single precision fused axpy and dot product.
+///
+/// Computes y = alpha*x + y and returns sum(z[i] * y[i]) over the updated
+/// y, streaming y through memory once instead of twice. Pass y as z (with
+/// incy as incz) for the squared norm of the update, as in a CG residual;
+/// otherwise z must not overlap y. Always computed natively.
+///
+/// # Safety
+///
+/// - All pointers must be valid and properly aligned
+/// - Vector dimensions and increments must be consistent
+#[no_mangle]
+#[allow(clippy::too_many_arguments)]
+pub unsafe extern "C" fn cblas_inject_saxpy_dot(
+    n: i32,
+    alpha: f32,
+    x: *const f32,
+    incx: i32,
+    y: *mut f32,
+    incy: i32,
+    z: *const f32,
+    incz: i32,
+) -> f32 {
+    let [n, incx, incy, incz] = [n, incx, incy, incz].map(i64::from);
+    native::axpy_dot(n, alpha, x, incx, y, incy, z, incz)
+}
+
+/// Single precision fused axpy and dot product with ILP64 integer ABI.
+#[no_mangle]
+#[allow(clippy::too_many_arguments)]
+pub unsafe extern "C" fn cblas_inject_saxpy_dot_64(
+    n: i64,
+    alpha: f32,
+    x: *const f32,
+    incx: i64,
+    y: *mut f32,
+    incy: i64,
+    z: *const f32,
+    incz: i64,
+) -> f32 {
+    native::axpy_dot(n, alpha, x, incx, y, incy, z, incz)
+}
+
+/// Double precision fused axpy and dot product.
+///
+/// Computes y = alpha*x + y and returns sum(z[i] * y[i]) over the updated
+/// y, streaming y through memory once instead of twice. Pass y as z (with
+/// incy as incz) for the squared norm of the update, as in a CG residual;
+/// otherwise z must not overlap y. Always computed natively.
+///
+/// # Safety
+///
+/// - All pointers must be valid and properly aligned
+/// - Vector dimensions and increments must be consistent
+#[no_mangle]
+#[allow(clippy::too_many_arguments)]
+pub unsafe extern "C" fn cblas_inject_daxpy_dot(
+    n: i32,
+    alpha: f64,
+    x: *const f64,
+    incx: i32,
+    y: *mut f64,
+    incy: i32,
+    z: *const f64,
+    incz: i32,
+) -> f64 {
+    let [n, incx, incy, incz] = [n, incx, incy, incz].map(i64::from);
+    native::axpy_dot(n, alpha, x, incx, y, incy, z, incz)
+}
+
+/// Double precision fused axpy and dot product with ILP64 integer ABI.
+#[no_mangle]
+#[allow(clippy::too_many_arguments)]
+pub unsafe extern "C" fn cblas_inject_daxpy_dot_64(
+    n: i64,
+    alpha: f64,
+    x: *const f64,
+    incx: i64,
+    y: *mut f64,
+    incy: i64,
+    z: *const f64,
+    incz: i64,
+) -> f64 {
+    native::axpy_dot(n, alpha, x, incx, y, incy, z, incz)
 }
 
 // =============================================================================
@@ -508,6 +649,7 @@ pub unsafe extern "C" fn cblas_sdsdot(
     y: *const f32,
     incy: i32,
 ) -> f32 {
+    let _call = dispatch::enter(Routine::Sdsdot, None, [], [n], [incx, incy]);
     let p = get_sdsdot_for_lp64_cblas();
     match p {
         SdsdotProvider::Lp64(f) => f(&n, &sb, x, &incx, y, &incy),
@@ -525,20 +667,21 @@ pub unsafe extern "C" fn cblas_sdsdot_64(
     y: *const f32,
     incy: i64,
 ) -> f32 {
+    let _call = dispatch::enter(Routine::Sdsdot, None, [], [n], [incx, incy]);
     let p = get_sdsdot_for_ilp64_cblas();
     if matches!(p, SdsdotProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(
-            b"cblas_sdsdot_64\0",
-            [(1, n), (4, incx), (6, incy)],
-        )
-        .is_none()
+        && !lp64_split::check_i64(b"cblas_sdsdot_64\0", [(4, incx), (6, incy)], [(1, n)])
     {
         return 0.0;
     }
 
     match p {
         SdsdotProvider::Ilp64(f) => f(&n, &sb, x, &incx, y, &incy),
-        SdsdotProvider::Lp64(f) => f(&(n as i32), &sb, x, &(incx as i32), y, &(incy as i32)),
+        SdsdotProvider::Lp64(f) => {
+            sb + dot_lp64(n, x, incx, y, incy, |n, x, incx, y, incy| {
+                f(n, &0.0, x, incx, y, incy)
+            })
+        }
     }
 }
 
@@ -559,6 +702,7 @@ pub unsafe extern "C" fn cblas_dsdot(
     y: *const f32,
     incy: i32,
 ) -> f64 {
+    let _call = dispatch::enter(Routine::Dsdot, None, [], [n], [incx, incy]);
     let p = get_dsdot_for_lp64_cblas();
     match p {
         DsdotProvider::Lp64(f) => f(&n, x, &incx, y, &incy),
@@ -575,20 +719,19 @@ pub unsafe extern "C" fn cblas_dsdot_64(
     y: *const f32,
     incy: i64,
 ) -> f64 {
+    let _call = dispatch::enter(Routine::Dsdot, None, [], [n], [incx, incy]);
     let p = get_dsdot_for_ilp64_cblas();
     if matches!(p, DsdotProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(
-            b"cblas_dsdot_64\0",
-            [(1, n), (3, incx), (5, incy)],
-        )
-        .is_none()
+        && !lp64_split::check_i64(b"cblas_dsdot_64\0", [(3, incx), (5, incy)], [(1, n)])
     {
         return 0.0;
     }
 
     match p {
         DsdotProvider::Ilp64(f) => f(&n, x, &incx, y, &incy),
-        DsdotProvider::Lp64(f) => f(&(n as i32), x, &(incx as i32), y, &(incy as i32)),
+        DsdotProvider::Lp64(f) => dot_lp64(n, x, incx, y, incy, |n, x, incx, y, incy| {
+            f(n, x, incx, y, incy)
+        }),
     }
 }
 
@@ -607,7 +750,10 @@ pub unsafe extern "C" fn cblas_dsdot_64(
 /// - snrm2 must be registered via `register_snrm2`
 #[no_mangle]
 pub unsafe extern "C" fn cblas_snrm2(n: i32, x: *const f32, incx: i32) -> f32 {
-    let p = get_snrm2_for_lp64_cblas();
+    let _call = dispatch::enter(Routine::Snrm2, None, [], [n], [incx]);
+    let Some(p) = native::select_provider(i64::from(n), try_get_snrm2_for_lp64_cblas) else {
+        return native::nrm2(i64::from(n), x, i64::from(incx));
+    };
     match p {
         Snrm2Provider::Lp64(f) => f(&n, x, &incx),
         Snrm2Provider::Ilp64(f) => f(&(n as i64), x, &(incx as i64)),
@@ -617,16 +763,21 @@ pub unsafe extern "C" fn cblas_snrm2(n: i32, x: *const f32, incx: i32) -> f32 {
 /// Single precision Euclidean norm with ILP64 integer ABI.
 #[no_mangle]
 pub unsafe extern "C" fn cblas_snrm2_64(n: i64, x: *const f32, incx: i64) -> f32 {
-    let p = get_snrm2_for_ilp64_cblas();
+    let _call = dispatch::enter(Routine::Snrm2, None, [], [n], [incx]);
+    let Some(p) = native::select_provider(n, try_get_snrm2_for_ilp64_cblas) else {
+        return native::nrm2(n, x, incx);
+    };
     if matches!(p, Snrm2Provider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(b"cblas_snrm2_64\0", [(1, n), (3, incx)]).is_none()
+        && !lp64_split::check_i64(b"cblas_snrm2_64\0", [(3, incx)], [(1, n)])
     {
         return 0.0;
     }
 
     match p {
         Snrm2Provider::Ilp64(f) => f(&n, x, &incx),
-        Snrm2Provider::Lp64(f) => f(&(n as i32), x, &(incx as i32)),
+        Snrm2Provider::Lp64(f) => {
+            reduce_lp64(n, x, incx, |n, x, incx| f(n, x, incx), |a, b| a.hypot(b))
+        }
     }
 }
 
@@ -641,7 +792,10 @@ pub unsafe extern "C" fn cblas_snrm2_64(n: i64, x: *const f32, incx: i64) -> f32
 /// - dnrm2 must be registered via `register_dnrm2`
 #[no_mangle]
 pub unsafe extern "C" fn cblas_dnrm2(n: i32, x: *const f64, incx: i32) -> f64 {
-    let p = get_dnrm2_for_lp64_cblas();
+    let _call = dispatch::enter(Routine::Dnrm2, None, [], [n], [incx]);
+    let Some(p) = native::select_provider(i64::from(n), try_get_dnrm2_for_lp64_cblas) else {
+        return native::nrm2(i64::from(n), x, i64::from(incx));
+    };
     match p {
         Dnrm2Provider::Lp64(f) => f(&n, x, &incx),
         Dnrm2Provider::Ilp64(f) => f(&(n as i64), x, &(incx as i64)),
@@ -651,16 +805,21 @@ pub unsafe extern "C" fn cblas_dnrm2(n: i32, x: *const f64, incx: i32) -> f64 {
 /// Double precision Euclidean norm with ILP64 integer ABI.
 #[no_mangle]
 pub unsafe extern "C" fn cblas_dnrm2_64(n: i64, x: *const f64, incx: i64) -> f64 {
-    let p = get_dnrm2_for_ilp64_cblas();
+    let _call = dispatch::enter(Routine::Dnrm2, None, [], [n], [incx]);
+    let Some(p) = native::select_provider(n, try_get_dnrm2_for_ilp64_cblas) else {
+        return native::nrm2(n, x, incx);
+    };
     if matches!(p, Dnrm2Provider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(b"cblas_dnrm2_64\0", [(1, n), (3, incx)]).is_none()
+        && !lp64_split::check_i64(b"cblas_dnrm2_64\0", [(3, incx)], [(1, n)])
     {
         return 0.0;
     }
 
     match p {
         Dnrm2Provider::Ilp64(f) => f(&n, x, &incx),
-        Dnrm2Provider::Lp64(f) => f(&(n as i32), x, &(incx as i32)),
+        Dnrm2Provider::Lp64(f) => {
+            reduce_lp64(n, x, incx, |n, x, incx| f(n, x, incx), |a, b| a.hypot(b))
+        }
     }
 }
 
@@ -675,6 +834,7 @@ pub unsafe extern "C" fn cblas_dnrm2_64(n: i64, x: *const f64, incx: i64) -> f64
 /// - scnrm2 must be registered via `register_scnrm2`
 #[no_mangle]
 pub unsafe extern "C" fn cblas_scnrm2(n: i32, x: *const Complex32, incx: i32) -> f32 {
+    let _call = dispatch::enter(Routine::Scnrm2, None, [], [n], [incx]);
     let p = get_scnrm2_for_lp64_cblas();
     match p {
         Scnrm2Provider::Lp64(f) => f(&n, x, &incx),
@@ -685,17 +845,19 @@ pub unsafe extern "C" fn cblas_scnrm2(n: i32, x: *const Complex32, incx: i32) ->
 /// Complex single precision Euclidean norm with ILP64 integer ABI.
 #[no_mangle]
 pub unsafe extern "C" fn cblas_scnrm2_64(n: i64, x: *const Complex32, incx: i64) -> f32 {
+    let _call = dispatch::enter(Routine::Scnrm2, None, [], [n], [incx]);
     let p = get_scnrm2_for_ilp64_cblas();
     if matches!(p, Scnrm2Provider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(b"cblas_scnrm2_64\0", [(1, n), (3, incx)])
-            .is_none()
+        && !lp64_split::check_i64(b"cblas_scnrm2_64\0", [(3, incx)], [(1, n)])
     {
         return 0.0;
     }
 
     match p {
         Scnrm2Provider::Ilp64(f) => f(&n, x, &incx),
-        Scnrm2Provider::Lp64(f) => f(&(n as i32), x, &(incx as i32)),
+        Scnrm2Provider::Lp64(f) => {
+            reduce_lp64(n, x, incx, |n, x, incx| f(n, x, incx), |a, b| a.hypot(b))
+        }
     }
 }
 
@@ -710,6 +872,7 @@ pub unsafe extern "C" fn cblas_scnrm2_64(n: i64, x: *const Complex32, incx: i64)
 /// - dznrm2 must be registered via `register_dznrm2`
 #[no_mangle]
 pub unsafe extern "C" fn cblas_dznrm2(n: i32, x: *const Complex64, incx: i32) -> f64 {
+    let _call = dispatch::enter(Routine::Dznrm2, None, [], [n], [incx]);
     let p = get_dznrm2_for_lp64_cblas();
     match p {
         Dznrm2Provider::Lp64(f) => f(&n, x, &incx),
@@ -720,17 +883,19 @@ pub unsafe extern "C" fn cblas_dznrm2(n: i32, x: *const Complex64, incx: i32) ->
 /// Complex double precision Euclidean norm with ILP64 integer ABI.
 #[no_mangle]
 pub unsafe extern "C" fn cblas_dznrm2_64(n: i64, x: *const Complex64, incx: i64) -> f64 {
+    let _call = dispatch::enter(Routine::Dznrm2, None, [], [n], [incx]);
     let p = get_dznrm2_for_ilp64_cblas();
     if matches!(p, Dznrm2Provider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(b"cblas_dznrm2_64\0", [(1, n), (3, incx)])
-            .is_none()
+        && !lp64_split::check_i64(b"cblas_dznrm2_64\0", [(3, incx)], [(1, n)])
     {
         return 0.0;
     }
 
     match p {
         Dznrm2Provider::Ilp64(f) => f(&n, x, &incx),
-        Dznrm2Provider::Lp64(f) => f(&(n as i32), x, &(incx as i32)),
+        Dznrm2Provider::Lp64(f) => {
+            reduce_lp64(n, x, incx, |n, x, incx| f(n, x, incx), |a, b| a.hypot(b))
+        }
     }
 }
 
@@ -749,7 +914,10 @@ pub unsafe extern "C" fn cblas_dznrm2_64(n: i64, x: *const Complex64, incx: i64)
 /// - sasum must be registered via `register_sasum`
 #[no_mangle]
 pub unsafe extern "C" fn cblas_sasum(n: i32, x: *const f32, incx: i32) -> f32 {
-    let p = get_sasum_for_lp64_cblas();
+    let _call = dispatch::enter(Routine::Sasum, None, [], [n], [incx]);
+    let Some(p) = native::select_provider(i64::from(n), try_get_sasum_for_lp64_cblas) else {
+        return native::asum(i64::from(n), x, i64::from(incx));
+    };
     match p {
         SasumProvider::Lp64(f) => f(&n, x, &incx),
         SasumProvider::Ilp64(f) => f(&(n as i64), x, &(incx as i64)),
@@ -759,16 +927,19 @@ pub unsafe extern "C" fn cblas_sasum(n: i32, x: *const f32, incx: i32) -> f32 {
 /// Single precision sum of absolute values with ILP64 integer ABI.
 #[no_mangle]
 pub unsafe extern "C" fn cblas_sasum_64(n: i64, x: *const f32, incx: i64) -> f32 {
-    let p = get_sasum_for_ilp64_cblas();
+    let _call = dispatch::enter(Routine::Sasum, None, [], [n], [incx]);
+    let Some(p) = native::select_provider(n, try_get_sasum_for_ilp64_cblas) else {
+        return native::asum(n, x, incx);
+    };
     if matches!(p, SasumProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(b"cblas_sasum_64\0", [(1, n), (3, incx)]).is_none()
+        && !lp64_split::check_i64(b"cblas_sasum_64\0", [(3, incx)], [(1, n)])
     {
         return 0.0;
     }
 
     match p {
         SasumProvider::Ilp64(f) => f(&n, x, &incx),
-        SasumProvider::Lp64(f) => f(&(n as i32), x, &(incx as i32)),
+        SasumProvider::Lp64(f) => reduce_lp64(n, x, incx, |n, x, incx| f(n, x, incx), |a, b| a + b),
     }
 }
 
@@ -783,7 +954,10 @@ pub unsafe extern "C" fn cblas_sasum_64(n: i64, x: *const f32, incx: i64) -> f32
 /// - dasum must be registered via `register_dasum`
 #[no_mangle]
 pub unsafe extern "C" fn cblas_dasum(n: i32, x: *const f64, incx: i32) -> f64 {
-    let p = get_dasum_for_lp64_cblas();
+    let _call = dispatch::enter(Routine::Dasum, None, [], [n], [incx]);
+    let Some(p) = native::select_provider(i64::from(n), try_get_dasum_for_lp64_cblas) else {
+        return native::asum(i64::from(n), x, i64::from(incx));
+    };
     match p {
         DasumProvider::Lp64(f) => f(&n, x, &incx),
         DasumProvider::Ilp64(f) => f(&(n as i64), x, &(incx as i64)),
@@ -793,16 +967,19 @@ pub unsafe extern "C" fn cblas_dasum(n: i32, x: *const f64, incx: i32) -> f64 {
 /// Double precision sum of absolute values with ILP64 integer ABI.
 #[no_mangle]
 pub unsafe extern "C" fn cblas_dasum_64(n: i64, x: *const f64, incx: i64) -> f64 {
-    let p = get_dasum_for_ilp64_cblas();
+    let _call = dispatch::enter(Routine::Dasum, None, [], [n], [incx]);
+    let Some(p) = native::select_provider(n, try_get_dasum_for_ilp64_cblas) else {
+        return native::asum(n, x, incx);
+    };
     if matches!(p, DasumProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(b"cblas_dasum_64\0", [(1, n), (3, incx)]).is_none()
+        && !lp64_split::check_i64(b"cblas_dasum_64\0", [(3, incx)], [(1, n)])
     {
         return 0.0;
     }
 
     match p {
         DasumProvider::Ilp64(f) => f(&n, x, &incx),
-        DasumProvider::Lp64(f) => f(&(n as i32), x, &(incx as i32)),
+        DasumProvider::Lp64(f) => reduce_lp64(n, x, incx, |n, x, incx| f(n, x, incx), |a, b| a + b),
     }
 }
 
@@ -817,6 +994,7 @@ pub unsafe extern "C" fn cblas_dasum_64(n: i64, x: *const f64, incx: i64) -> f64
 /// - scasum must be registered via `register_scasum`
 #[no_mangle]
 pub unsafe extern "C" fn cblas_scasum(n: i32, x: *const Complex32, incx: i32) -> f32 {
+    let _call = dispatch::enter(Routine::Scasum, None, [], [n], [incx]);
     let p = get_scasum_for_lp64_cblas();
     match p {
         ScasumProvider::Lp64(f) => f(&n, x, &incx),
@@ -827,17 +1005,19 @@ pub unsafe extern "C" fn cblas_scasum(n: i32, x: *const Complex32, incx: i32) ->
 /// Complex single precision sum of absolute values with ILP64 integer ABI.
 #[no_mangle]
 pub unsafe extern "C" fn cblas_scasum_64(n: i64, x: *const Complex32, incx: i64) -> f32 {
+    let _call = dispatch::enter(Routine::Scasum, None, [], [n], [incx]);
     let p = get_scasum_for_ilp64_cblas();
     if matches!(p, ScasumProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(b"cblas_scasum_64\0", [(1, n), (3, incx)])
-            .is_none()
+        && !lp64_split::check_i64(b"cblas_scasum_64\0", [(3, incx)], [(1, n)])
     {
         return 0.0;
     }
 
     match p {
         ScasumProvider::Ilp64(f) => f(&n, x, &incx),
-        ScasumProvider::Lp64(f) => f(&(n as i32), x, &(incx as i32)),
+        ScasumProvider::Lp64(f) => {
+            reduce_lp64(n, x, incx, |n, x, incx| f(n, x, incx), |a, b| a + b)
+        }
     }
 }
 
@@ -852,6 +1032,7 @@ pub unsafe extern "C" fn cblas_scasum_64(n: i64, x: *const Complex32, incx: i64)
 /// - dzasum must be registered via `register_dzasum`
 #[no_mangle]
 pub unsafe extern "C" fn cblas_dzasum(n: i32, x: *const Complex64, incx: i32) -> f64 {
+    let _call = dispatch::enter(Routine::Dzasum, None, [], [n], [incx]);
     let p = get_dzasum_for_lp64_cblas();
     match p {
         DzasumProvider::Lp64(f) => f(&n, x, &incx),
@@ -862,17 +1043,19 @@ pub unsafe extern "C" fn cblas_dzasum(n: i32, x: *const Complex64, incx: i32) ->
 /// Complex double precision sum of absolute values with ILP64 integer ABI.
 #[no_mangle]
 pub unsafe extern "C" fn cblas_dzasum_64(n: i64, x: *const Complex64, incx: i64) -> f64 {
+    let _call = dispatch::enter(Routine::Dzasum, None, [], [n], [incx]);
     let p = get_dzasum_for_ilp64_cblas();
     if matches!(p, DzasumProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(b"cblas_dzasum_64\0", [(1, n), (3, incx)])
-            .is_none()
+        && !lp64_split::check_i64(b"cblas_dzasum_64\0", [(3, incx)], [(1, n)])
     {
         return 0.0;
     }
 
     match p {
         DzasumProvider::Ilp64(f) => f(&n, x, &incx),
-        DzasumProvider::Lp64(f) => f(&(n as i32), x, &(incx as i32)),
+        DzasumProvider::Lp64(f) => {
+            reduce_lp64(n, x, incx, |n, x, incx| f(n, x, incx), |a, b| a + b)
+        }
     }
 }
 
@@ -893,7 +1076,10 @@ pub unsafe extern "C" fn cblas_dzasum_64(n: i64, x: *const Complex64, incx: i64)
 /// - isamax must be registered via `register_isamax`
 #[no_mangle]
 pub unsafe extern "C" fn cblas_isamax(n: i32, x: *const f32, incx: i32) -> i32 {
-    let p = get_isamax_for_lp64_cblas();
+    let _call = dispatch::enter(Routine::Isamax, None, [], [n], [incx]);
+    let Some(p) = native::select_provider(i64::from(n), try_get_isamax_for_lp64_cblas) else {
+        return native::iamax(i64::from(n), x, i64::from(incx)) as i32;
+    };
     match p {
         IsamaxProvider::Lp64(f) => {
             let idx = f(&n, x, &incx);
@@ -917,10 +1103,12 @@ pub unsafe extern "C" fn cblas_isamax(n: i32, x: *const f32, incx: i32) -> i32 {
 /// Index of maximum absolute value (single precision) with ILP64 integer ABI.
 #[no_mangle]
 pub unsafe extern "C" fn cblas_isamax_64(n: i64, x: *const f32, incx: i64) -> i64 {
-    let p = get_isamax_for_ilp64_cblas();
+    let _call = dispatch::enter(Routine::Isamax, None, [], [n], [incx]);
+    let Some(p) = native::select_provider(n, try_get_isamax_for_ilp64_cblas) else {
+        return native::iamax(n, x, incx);
+    };
     if matches!(p, IsamaxProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(b"cblas_isamax_64\0", [(1, n), (3, incx)])
-            .is_none()
+        && !lp64_split::check_i64(b"cblas_isamax_64\0", [(3, incx)], [(1, n)])
     {
         return 0;
     }
@@ -934,14 +1122,7 @@ pub unsafe extern "C" fn cblas_isamax_64(n: i64, x: *const f32, incx: i64) -> i6
                 0
             }
         }
-        IsamaxProvider::Lp64(f) => {
-            let idx = f(&(n as i32), x, &(incx as i32));
-            if idx > 0 {
-                (idx - 1) as i64
-            } else {
-                0
-            }
-        }
+        IsamaxProvider::Lp64(f) => iamax_lp64(n, x, incx, |n, x, incx| f(n, x, incx), f32::abs),
     }
 }
 
@@ -958,7 +1139,10 @@ pub unsafe extern "C" fn cblas_isamax_64(n: i64, x: *const f32, incx: i64) -> i6
 /// - idamax must be registered via `register_idamax`
 #[no_mangle]
 pub unsafe extern "C" fn cblas_idamax(n: i32, x: *const f64, incx: i32) -> i32 {
-    let p = get_idamax_for_lp64_cblas();
+    let _call = dispatch::enter(Routine::Idamax, None, [], [n], [incx]);
+    let Some(p) = native::select_provider(i64::from(n), try_get_idamax_for_lp64_cblas) else {
+        return native::iamax(i64::from(n), x, i64::from(incx)) as i32;
+    };
     match p {
         IdamaxProvider::Lp64(f) => {
             let idx = f(&n, x, &incx);
@@ -982,10 +1166,12 @@ pub unsafe extern "C" fn cblas_idamax(n: i32, x: *const f64, incx: i32) -> i32 {
 /// Index of maximum absolute value (double precision) with ILP64 integer ABI.
 #[no_mangle]
 pub unsafe extern "C" fn cblas_idamax_64(n: i64, x: *const f64, incx: i64) -> i64 {
-    let p = get_idamax_for_ilp64_cblas();
+    let _call = dispatch::enter(Routine::Idamax, None, [], [n], [incx]);
+    let Some(p) = native::select_provider(n, try_get_idamax_for_ilp64_cblas) else {
+        return native::iamax(n, x, incx);
+    };
     if matches!(p, IdamaxProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(b"cblas_idamax_64\0", [(1, n), (3, incx)])
-            .is_none()
+        && !lp64_split::check_i64(b"cblas_idamax_64\0", [(3, incx)], [(1, n)])
     {
         return 0;
     }
@@ -999,14 +1185,7 @@ pub unsafe extern "C" fn cblas_idamax_64(n: i64, x: *const f64, incx: i64) -> i6
                 0
             }
         }
-        IdamaxProvider::Lp64(f) => {
-            let idx = f(&(n as i32), x, &(incx as i32));
-            if idx > 0 {
-                (idx - 1) as i64
-            } else {
-                0
-            }
-        }
+        IdamaxProvider::Lp64(f) => iamax_lp64(n, x, incx, |n, x, incx| f(n, x, incx), f64::abs),
     }
 }
 
@@ -1023,6 +1202,7 @@ pub unsafe extern "C" fn cblas_idamax_64(n: i64, x: *const f64, incx: i64) -> i6
 /// - icamax must be registered via `register_icamax`
 #[no_mangle]
 pub unsafe extern "C" fn cblas_icamax(n: i32, x: *const Complex32, incx: i32) -> i32 {
+    let _call = dispatch::enter(Routine::Icamax, None, [], [n], [incx]);
     let p = get_icamax_for_lp64_cblas();
     match p {
         IcamaxProvider::Lp64(f) => {
@@ -1047,10 +1227,10 @@ pub unsafe extern "C" fn cblas_icamax(n: i32, x: *const Complex32, incx: i32) ->
 /// Index of maximum absolute value (complex single precision) with ILP64 integer ABI.
 #[no_mangle]
 pub unsafe extern "C" fn cblas_icamax_64(n: i64, x: *const Complex32, incx: i64) -> i64 {
+    let _call = dispatch::enter(Routine::Icamax, None, [], [n], [incx]);
     let p = get_icamax_for_ilp64_cblas();
     if matches!(p, IcamaxProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(b"cblas_icamax_64\0", [(1, n), (3, incx)])
-            .is_none()
+        && !lp64_split::check_i64(b"cblas_icamax_64\0", [(3, incx)], [(1, n)])
     {
         return 0;
     }
@@ -1064,14 +1244,13 @@ pub unsafe extern "C" fn cblas_icamax_64(n: i64, x: *const Complex32, incx: i64)
                 0
             }
         }
-        IcamaxProvider::Lp64(f) => {
-            let idx = f(&(n as i32), x, &(incx as i32));
-            if idx > 0 {
-                (idx - 1) as i64
-            } else {
-                0
-            }
-        }
+        IcamaxProvider::Lp64(f) => iamax_lp64(
+            n,
+            x,
+            incx,
+            |n, x, incx| f(n, x, incx),
+            |x| x.re.abs() + x.im.abs(),
+        ),
     }
 }
 
@@ -1088,6 +1267,7 @@ pub unsafe extern "C" fn cblas_icamax_64(n: i64, x: *const Complex32, incx: i64)
 /// - izamax must be registered via `register_izamax`
 #[no_mangle]
 pub unsafe extern "C" fn cblas_izamax(n: i32, x: *const Complex64, incx: i32) -> i32 {
+    let _call = dispatch::enter(Routine::Izamax, None, [], [n], [incx]);
     let p = get_izamax_for_lp64_cblas();
     match p {
         IzamaxProvider::Lp64(f) => {
@@ -1112,10 +1292,10 @@ pub unsafe extern "C" fn cblas_izamax(n: i32, x: *const Complex64, incx: i32) ->
 /// Index of maximum absolute value (complex double precision) with ILP64 integer ABI.
 #[no_mangle]
 pub unsafe extern "C" fn cblas_izamax_64(n: i64, x: *const Complex64, incx: i64) -> i64 {
+    let _call = dispatch::enter(Routine::Izamax, None, [], [n], [incx]);
     let p = get_izamax_for_ilp64_cblas();
     if matches!(p, IzamaxProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(b"cblas_izamax_64\0", [(1, n), (3, incx)])
-            .is_none()
+        && !lp64_split::check_i64(b"cblas_izamax_64\0", [(3, incx)], [(1, n)])
     {
         return 0;
     }
@@ -1129,13 +1309,12 @@ pub unsafe extern "C" fn cblas_izamax_64(n: i64, x: *const Complex64, incx: i64)
                 0
             }
         }
-        IzamaxProvider::Lp64(f) => {
-            let idx = f(&(n as i32), x, &(incx as i32));
-            if idx > 0 {
-                (idx - 1) as i64
-            } else {
-                0
-            }
-        }
+        IzamaxProvider::Lp64(f) => iamax_lp64(
+            n,
+            x,
+            incx,
+            |n, x, incx| f(n, x, incx),
+            |x| x.re.abs() + x.im.abs(),
+        ),
     }
 }
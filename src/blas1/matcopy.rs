@@ -0,0 +1,436 @@
+//! Scaled matrix copy and transpose (`?omatcopy`, `?imatcopy`) - CBLAS
+//! interface.
+//!
+//! These are the OpenBLAS/MKL extensions
+//! `B = alpha * op(A)` (out of place) and `A = alpha * op(A)` (in place,
+//! with the leading dimension changing from `lda` to `ldb`), where op is
+//! one of identity, transpose, conjugate transpose and conjugate
+//! (`CblasConjNoTrans`).
+//!
+//! Calls go to a registered `?omatcopy_`/`?imatcopy_` provider, which takes
+//! the storage order itself as `'C'` or `'R'`. Without one they run the
+//! native blocked kernels, which see a row-major `rows x cols` matrix as the
+//! column-major `cols x rows` one.
+
+use std::ffi::{c_char, c_int};
+
+use num_complex::{Complex32, Complex64};
+
+use crate::backend::{
+    try_get_cimatcopy_for_ilp64_cblas, try_get_cimatcopy_for_lp64_cblas,
+    try_get_comatcopy_for_ilp64_cblas, try_get_comatcopy_for_lp64_cblas,
+    try_get_dimatcopy_for_ilp64_cblas, try_get_dimatcopy_for_lp64_cblas,
+    try_get_domatcopy_for_ilp64_cblas, try_get_domatcopy_for_lp64_cblas,
+    try_get_simatcopy_for_ilp64_cblas, try_get_simatcopy_for_lp64_cblas,
+    try_get_somatcopy_for_ilp64_cblas, try_get_somatcopy_for_lp64_cblas,
+    try_get_zimatcopy_for_ilp64_cblas, try_get_zimatcopy_for_lp64_cblas,
+    try_get_zomatcopy_for_ilp64_cblas, try_get_zomatcopy_for_lp64_cblas, CimatcopyProvider,
+    ComatcopyProvider, DimatcopyProvider, DomatcopyProvider, SimatcopyProvider, SomatcopyProvider,
+    ZimatcopyProvider, ZomatcopyProvider,
+};
+use crate::dispatch;
+use crate::int_convert::to_lp64_array_i64;
+use crate::native::transpose as native;
+use crate::stats::Routine;
+use crate::types::{
+    transpose_to_char, CblasColMajor, CblasConjNoTrans, CblasConjTrans, CblasNoTrans,
+    CblasRowMajor, CblasTrans, CBLAS_ORDER, CBLAS_TRANSPOSE,
+};
+use crate::xerbla::cblas_xerbla;
+
+#[inline]
+fn order_to_char(order: CBLAS_ORDER) -> c_char {
+    match order {
+        CblasColMajor => b'C' as c_char,
+        CblasRowMajor => b'R' as c_char,
+    }
+}
+
+/// Whether op transposes and whether it conjugates.
+#[inline]
+fn op(trans: CBLAS_TRANSPOSE) -> (bool, bool) {
+    match trans {
+        CblasNoTrans => (false, false),
+        CblasTrans => (true, false),
+        CblasConjTrans => (true, true),
+        CblasConjNoTrans => (false, true),
+    }
+}
+
+/// Column-major `(rows, cols)` of A for the native kernels, or `None` after
+/// reporting the first invalid argument through `xerbla`. `ldb_param` is the
+/// position of `ldb` (9 for omatcopy, 8 for imatcopy).
+#[allow(clippy::too_many_arguments)]
+fn check(
+    routine: &[u8],
+    order: CBLAS_ORDER,
+    trans: CBLAS_TRANSPOSE,
+    rows: i64,
+    cols: i64,
+    lda: i64,
+    ldb: i64,
+    ldb_param: c_int,
+) -> Option<(i64, i64)> {
+    let (a_rows, a_cols) = match order {
+        CblasColMajor => (rows, cols),
+        CblasRowMajor => (cols, rows),
+    };
+    let b_rows = if op(trans).0 { a_cols } else { a_rows };
+    let param = if rows < 0 {
+        3
+    } else if cols < 0 {
+        4
+    } else if lda < a_rows.max(1) {
+        7
+    } else if ldb < b_rows.max(1) {
+        ldb_param
+    } else {
+        return Some((a_rows, a_cols));
+    };
+    unsafe { cblas_xerbla(param, routine.as_ptr().cast(), std::ptr::null()) };
+    None
+}
+
+macro_rules! define_matcopy {
+    (
+        $t:ty,
+        $scalar:ty,
+        $value:expr,
+        $omatcopy:ident,
+        $omatcopy_64:ident,
+        $omatcopy_routine:ident,
+        $omatcopy_provider:ident,
+        $try_omatcopy_lp64:ident,
+        $try_omatcopy_ilp64:ident,
+        $imatcopy:ident,
+        $imatcopy_64:ident,
+        $imatcopy_routine:ident,
+        $imatcopy_provider:ident,
+        $try_imatcopy_lp64:ident,
+        $try_imatcopy_ilp64:ident
+    ) => {
+        /// Out-of-place scaled matrix copy or transpose: B = alpha * op(A).
+        ///
+        /// # Safety
+        ///
+        /// - All pointers must be valid and properly aligned
+        /// - A and B must not overlap
+        /// - Matrix dimensions and leading dimensions must be consistent
+        #[no_mangle]
+        #[allow(clippy::too_many_arguments)]
+        pub unsafe extern "C" fn $omatcopy(
+            order: CBLAS_ORDER,
+            trans: CBLAS_TRANSPOSE,
+            rows: i32,
+            cols: i32,
+            alpha: $scalar,
+            a: *const $t,
+            lda: i32,
+            b: *mut $t,
+            ldb: i32,
+        ) {
+            let _call = dispatch::enter(
+                Routine::$omatcopy_routine,
+                Some(order),
+                [trans as u8],
+                [rows, cols],
+                [lda, ldb],
+            );
+            let alpha: $t = ($value)(alpha);
+            let (order_char, trans_char) = (order_to_char(order), transpose_to_char(trans));
+            if let Some(p) = $try_omatcopy_lp64() {
+                match p {
+                    $omatcopy_provider::Lp64(f) => f(
+                        &order_char,
+                        &trans_char,
+                        &rows,
+                        &cols,
+                        &alpha,
+                        a,
+                        &lda,
+                        b,
+                        &ldb,
+                    ),
+                    $omatcopy_provider::Ilp64(f) => f(
+                        &order_char,
+                        &trans_char,
+                        &i64::from(rows),
+                        &i64::from(cols),
+                        &alpha,
+                        a,
+                        &i64::from(lda),
+                        b,
+                        &i64::from(ldb),
+                    ),
+                }
+                return;
+            }
+            let routine = concat!(stringify!($omatcopy), "\0").as_bytes();
+            let [rows, cols, lda, ldb] = [rows, cols, lda, ldb].map(i64::from);
+            let Some((rows, cols)) = check(routine, order, trans, rows, cols, lda, ldb, 9) else {
+                return;
+            };
+            let (transpose, conj) = op(trans);
+            native::omatcopy(rows, cols, alpha, transpose, conj, a, lda, b, ldb);
+        }
+
+        /// Out-of-place scaled matrix copy or transpose with ILP64 integer ABI.
+        #[no_mangle]
+        #[allow(clippy::too_many_arguments)]
+        pub unsafe extern "C" fn $omatcopy_64(
+            order: CBLAS_ORDER,
+            trans: CBLAS_TRANSPOSE,
+            rows: i64,
+            cols: i64,
+            alpha: $scalar,
+            a: *const $t,
+            lda: i64,
+            b: *mut $t,
+            ldb: i64,
+        ) {
+            let _call = dispatch::enter(
+                Routine::$omatcopy_routine,
+                Some(order),
+                [trans as u8],
+                [rows, cols],
+                [lda, ldb],
+            );
+            let alpha: $t = ($value)(alpha);
+            let (order_char, trans_char) = (order_to_char(order), transpose_to_char(trans));
+            let routine = concat!(stringify!($omatcopy_64), "\0").as_bytes();
+            if let Some(p) = $try_omatcopy_ilp64() {
+                match p {
+                    $omatcopy_provider::Ilp64(f) => f(
+                        &order_char,
+                        &trans_char,
+                        &rows,
+                        &cols,
+                        &alpha,
+                        a,
+                        &lda,
+                        b,
+                        &ldb,
+                    ),
+                    $omatcopy_provider::Lp64(f) => {
+                        let Some([rows, cols, lda, ldb]) =
+                            to_lp64_array_i64(routine, [(3, rows), (4, cols), (7, lda), (9, ldb)])
+                        else {
+                            return;
+                        };
+                        f(
+                            &order_char,
+                            &trans_char,
+                            &rows,
+                            &cols,
+                            &alpha,
+                            a,
+                            &lda,
+                            b,
+                            &ldb,
+                        )
+                    }
+                }
+                return;
+            }
+            let Some((rows, cols)) = check(routine, order, trans, rows, cols, lda, ldb, 9) else {
+                return;
+            };
+            let (transpose, conj) = op(trans);
+            native::omatcopy(rows, cols, alpha, transpose, conj, a, lda, b, ldb);
+        }
+
+        /// In-place scaled matrix copy or transpose: A = alpha * op(A), with
+        /// leading dimension `lda` on entry and `ldb` on return.
+        ///
+        /// # Safety
+        ///
+        /// - All pointers must be valid and properly aligned
+        /// - A must hold the matrix under both leading dimensions
+        #[no_mangle]
+        pub unsafe extern "C" fn $imatcopy(
+            order: CBLAS_ORDER,
+            trans: CBLAS_TRANSPOSE,
+            rows: i32,
+            cols: i32,
+            alpha: $scalar,
+            a: *mut $t,
+            lda: i32,
+            ldb: i32,
+        ) {
+            let _call = dispatch::enter(
+                Routine::$imatcopy_routine,
+                Some(order),
+                [trans as u8],
+                [rows, cols],
+                [lda, ldb],
+            );
+            let alpha: $t = ($value)(alpha);
+            let (order_char, trans_char) = (order_to_char(order), transpose_to_char(trans));
+            if let Some(p) = $try_imatcopy_lp64() {
+                match p {
+                    $imatcopy_provider::Lp64(f) => f(
+                        &order_char,
+                        &trans_char,
+                        &rows,
+                        &cols,
+                        &alpha,
+                        a,
+                        &lda,
+                        &ldb,
+                    ),
+                    $imatcopy_provider::Ilp64(f) => f(
+                        &order_char,
+                        &trans_char,
+                        &i64::from(rows),
+                        &i64::from(cols),
+                        &alpha,
+                        a,
+                        &i64::from(lda),
+                        &i64::from(ldb),
+                    ),
+                }
+                return;
+            }
+            let routine = concat!(stringify!($imatcopy), "\0").as_bytes();
+            let [rows, cols, lda, ldb] = [rows, cols, lda, ldb].map(i64::from);
+            let Some((rows, cols)) = check(routine, order, trans, rows, cols, lda, ldb, 8) else {
+                return;
+            };
+            let (transpose, conj) = op(trans);
+            native::imatcopy(rows, cols, alpha, transpose, conj, a, lda, ldb);
+        }
+
+        /// In-place scaled matrix copy or transpose with ILP64 integer ABI.
+        #[no_mangle]
+        pub unsafe extern "C" fn $imatcopy_64(
+            order: CBLAS_ORDER,
+            trans: CBLAS_TRANSPOSE,
+            rows: i64,
+            cols: i64,
+            alpha: $scalar,
+            a: *mut $t,
+            lda: i64,
+            ldb: i64,
+        ) {
+            let _call = dispatch::enter(
+                Routine::$imatcopy_routine,
+                Some(order),
+                [trans as u8],
+                [rows, cols],
+                [lda, ldb],
+            );
+            let alpha: $t = ($value)(alpha);
+            let (order_char, trans_char) = (order_to_char(order), transpose_to_char(trans));
+            let routine = concat!(stringify!($imatcopy_64), "\0").as_bytes();
+            if let Some(p) = $try_imatcopy_ilp64() {
+                match p {
+                    $imatcopy_provider::Ilp64(f) => f(
+                        &order_char,
+                        &trans_char,
+                        &rows,
+                        &cols,
+                        &alpha,
+                        a,
+                        &lda,
+                        &ldb,
+                    ),
+                    $imatcopy_provider::Lp64(f) => {
+                        let Some([rows, cols, lda, ldb]) =
+                            to_lp64_array_i64(routine, [(3, rows), (4, cols), (7, lda), (8, ldb)])
+                        else {
+                            return;
+                        };
+                        f(
+                            &order_char,
+                            &trans_char,
+                            &rows,
+                            &cols,
+                            &alpha,
+                            a,
+                            &lda,
+                            &ldb,
+                        )
+                    }
+                }
+                return;
+            }
+            let Some((rows, cols)) = check(routine, order, trans, rows, cols, lda, ldb, 8) else {
+                return;
+            };
+            let (transpose, conj) = op(trans);
+            native::imatcopy(rows, cols, alpha, transpose, conj, a, lda, ldb);
+        }
+    };
+}
+
+define_matcopy!(
+    f32,
+    f32,
+    |x: f32| x,
+    cblas_somatcopy,
+    cblas_somatcopy_64,
+    Somatcopy,
+    SomatcopyProvider,
+    try_get_somatcopy_for_lp64_cblas,
+    try_get_somatcopy_for_ilp64_cblas,
+    cblas_simatcopy,
+    cblas_simatcopy_64,
+    Simatcopy,
+    SimatcopyProvider,
+    try_get_simatcopy_for_lp64_cblas,
+    try_get_simatcopy_for_ilp64_cblas
+);
+
+define_matcopy!(
+    f64,
+    f64,
+    |x: f64| x,
+    cblas_domatcopy,
+    cblas_domatcopy_64,
+    Domatcopy,
+    DomatcopyProvider,
+    try_get_domatcopy_for_lp64_cblas,
+    try_get_domatcopy_for_ilp64_cblas,
+    cblas_dimatcopy,
+    cblas_dimatcopy_64,
+    Dimatcopy,
+    DimatcopyProvider,
+    try_get_dimatcopy_for_lp64_cblas,
+    try_get_dimatcopy_for_ilp64_cblas
+);
+
+define_matcopy!(
+    Complex32,
+    *const Complex32,
+    |x: *const Complex32| unsafe { *x },
+    cblas_comatcopy,
+    cblas_comatcopy_64,
+    Comatcopy,
+    ComatcopyProvider,
+    try_get_comatcopy_for_lp64_cblas,
+    try_get_comatcopy_for_ilp64_cblas,
+    cblas_cimatcopy,
+    cblas_cimatcopy_64,
+    Cimatcopy,
+    CimatcopyProvider,
+    try_get_cimatcopy_for_lp64_cblas,
+    try_get_cimatcopy_for_ilp64_cblas
+);
+
+define_matcopy!(
+    Complex64,
+    *const Complex64,
+    |x: *const Complex64| unsafe { *x },
+    cblas_zomatcopy,
+    cblas_zomatcopy_64,
+    Zomatcopy,
+    ZomatcopyProvider,
+    try_get_zomatcopy_for_lp64_cblas,
+    try_get_zomatcopy_for_ilp64_cblas,
+    cblas_zimatcopy,
+    cblas_zimatcopy_64,
+    Zimatcopy,
+    ZimatcopyProvider,
+    try_get_zimatcopy_for_lp64_cblas,
+    try_get_zimatcopy_for_ilp64_cblas
+);
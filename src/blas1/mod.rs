@@ -1,5 +1,6 @@
 //! BLAS Level 1 operations (vector-vector).
 
 pub mod dot;
+pub mod matcopy;
 pub mod rot;
 pub mod vector;
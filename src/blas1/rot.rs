@@ -8,6 +8,9 @@ use crate::backend::{
     get_srot_for_ilp64_cblas, get_srot_for_lp64_cblas, get_srotg, get_srotm_for_ilp64_cblas,
     get_srotm_for_lp64_cblas, get_srotmg, DrotProvider, DrotmProvider, SrotProvider, SrotmProvider,
 };
+use crate::dispatch;
+use crate::stats::Routine;
+use crate::trace::{self, Path};
 
 /// Apply Givens rotation (double precision).
 ///
@@ -32,6 +35,7 @@ pub unsafe extern "C" fn cblas_drot(
     c: f64,
     s: f64,
 ) {
+    let _call = dispatch::enter(Routine::Drot, None, [], [n], [incx, incy]);
     let p = get_drot_for_lp64_cblas();
     match p {
         DrotProvider::Lp64(f) => f(&n, x, &incx, y, &incy, &c, &s),
@@ -50,6 +54,7 @@ pub unsafe extern "C" fn cblas_drot_64(
     c: f64,
     s: f64,
 ) {
+    let _call = dispatch::enter(Routine::Drot, None, [], [n], [incx, incy]);
     let p = get_drot_for_ilp64_cblas();
     if matches!(p, DrotProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_drot_64\0", [(1, n), (3, incx), (5, incy)])
@@ -87,6 +92,7 @@ pub unsafe extern "C" fn cblas_srot(
     c: f32,
     s: f32,
 ) {
+    let _call = dispatch::enter(Routine::Srot, None, [], [n], [incx, incy]);
     let p = get_srot_for_lp64_cblas();
     match p {
         SrotProvider::Lp64(f) => f(&n, x, &incx, y, &incy, &c, &s),
@@ -105,6 +111,7 @@ pub unsafe extern "C" fn cblas_srot_64(
     c: f32,
     s: f32,
 ) {
+    let _call = dispatch::enter(Routine::Srot, None, [], [n], [incx, incy]);
     let p = get_srot_for_ilp64_cblas();
     if matches!(p, SrotProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_srot_64\0", [(1, n), (3, incx), (5, incy)])
@@ -136,7 +143,9 @@ pub unsafe extern "C" fn cblas_srot_64(
 /// - drotg must be registered via `register_drotg`
 #[no_mangle]
 pub unsafe extern "C" fn cblas_drotg(a: *mut f64, b: *mut f64, c: *mut f64, s: *mut f64) {
+    let _call = dispatch::enter::<i32, 0, 0, 0>(Routine::Drotg, None, [], [], []);
     let drotg = get_drotg();
+    trace::dispatched(Path::Lp64);
     drotg(a, b, c, s);
 }
 
@@ -157,7 +166,9 @@ pub unsafe extern "C" fn cblas_drotg(a: *mut f64, b: *mut f64, c: *mut f64, s: *
 /// - srotg must be registered via `register_srotg`
 #[no_mangle]
 pub unsafe extern "C" fn cblas_srotg(a: *mut f32, b: *mut f32, c: *mut f32, s: *mut f32) {
+    let _call = dispatch::enter::<i32, 0, 0, 0>(Routine::Srotg, None, [], [], []);
     let srotg = get_srotg();
+    trace::dispatched(Path::Lp64);
     srotg(a, b, c, s);
 }
 
@@ -182,6 +193,7 @@ pub unsafe extern "C" fn cblas_drotm(
     incy: i32,
     p: *const f64,
 ) {
+    let _call = dispatch::enter(Routine::Drotm, None, [], [n], [incx, incy]);
     let pv = get_drotm_for_lp64_cblas();
     match pv {
         DrotmProvider::Lp64(f) => f(&n, x, &incx, y, &incy, p),
@@ -199,6 +211,7 @@ pub unsafe extern "C" fn cblas_drotm_64(
     incy: i64,
     p: *const f64,
 ) {
+    let _call = dispatch::enter(Routine::Drotm, None, [], [n], [incx, incy]);
     let pv = get_drotm_for_ilp64_cblas();
     if matches!(pv, DrotmProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -237,6 +250,7 @@ pub unsafe extern "C" fn cblas_srotm(
     incy: i32,
     p: *const f32,
 ) {
+    let _call = dispatch::enter(Routine::Srotm, None, [], [n], [incx, incy]);
     let pv = get_srotm_for_lp64_cblas();
     match pv {
         SrotmProvider::Lp64(f) => f(&n, x, &incx, y, &incy, p),
@@ -254,6 +268,7 @@ pub unsafe extern "C" fn cblas_srotm_64(
     incy: i64,
     p: *const f32,
 ) {
+    let _call = dispatch::enter(Routine::Srotm, None, [], [n], [incx, incy]);
     let pv = get_srotm_for_ilp64_cblas();
     if matches!(pv, SrotmProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -296,7 +311,9 @@ pub unsafe extern "C" fn cblas_drotmg(
     b2: f64,
     p: *mut f64,
 ) {
+    let _call = dispatch::enter::<i32, 0, 0, 0>(Routine::Drotmg, None, [], [], []);
     let drotmg = get_drotmg();
+    trace::dispatched(Path::Lp64);
     drotmg(d1, d2, b1, &b2, p);
 }
 
@@ -325,7 +342,9 @@ pub unsafe extern "C" fn cblas_srotmg(
     b2: f32,
     p: *mut f32,
 ) {
+    let _call = dispatch::enter::<i32, 0, 0, 0>(Routine::Srotmg, None, [], [], []);
     let srotmg = get_srotmg();
+    trace::dispatched(Path::Lp64);
     srotmg(d1, d2, b1, &b2, p);
 }
 
@@ -340,7 +359,9 @@ pub unsafe extern "C" fn cblas_srotmg(
 /// - dcabs1 must be registered via `register_dcabs1`
 #[no_mangle]
 pub unsafe extern "C" fn cblas_dcabs1(z: *const Complex64) -> f64 {
+    let _call = dispatch::enter::<i32, 0, 0, 0>(Routine::Dcabs1, None, [], [], []);
     let dcabs1 = get_dcabs1();
+    trace::dispatched(Path::Lp64);
     dcabs1(z)
 }
 
@@ -355,6 +376,8 @@ pub unsafe extern "C" fn cblas_dcabs1(z: *const Complex64) -> f64 {
 /// - scabs1 must be registered via `register_scabs1`
 #[no_mangle]
 pub unsafe extern "C" fn cblas_scabs1(z: *const Complex32) -> f32 {
+    let _call = dispatch::enter::<i32, 0, 0, 0>(Routine::Scabs1, None, [], [], []);
     let scabs1 = get_scabs1();
+    trace::dispatched(Path::Lp64);
     scabs1(z)
 }
@@ -1,4 +1,4 @@
-//! BLAS Level 1: Vector operations (swap, copy, axpy, scal).
+//! BLAS Level 1: Vector operations (swap, copy, axpy, axpby, scal).
 //!
 //! These functions operate on vectors and do not require row-major conversion.
 
@@ -8,19 +8,26 @@ use crate::backend::{
     get_caxpy_for_ilp64_cblas, get_caxpy_for_lp64_cblas, get_ccopy_for_ilp64_cblas,
     get_ccopy_for_lp64_cblas, get_cscal_for_ilp64_cblas, get_cscal_for_lp64_cblas,
     get_csscal_for_ilp64_cblas, get_csscal_for_lp64_cblas, get_cswap_for_ilp64_cblas,
-    get_cswap_for_lp64_cblas, get_daxpy_for_ilp64_cblas, get_daxpy_for_lp64_cblas,
-    get_dcopy_for_ilp64_cblas, get_dcopy_for_lp64_cblas, get_dscal_for_ilp64_cblas,
-    get_dscal_for_lp64_cblas, get_dswap_for_ilp64_cblas, get_dswap_for_lp64_cblas,
-    get_saxpy_for_ilp64_cblas, get_saxpy_for_lp64_cblas, get_scopy_for_ilp64_cblas,
-    get_scopy_for_lp64_cblas, get_sscal_for_ilp64_cblas, get_sscal_for_lp64_cblas,
-    get_sswap_for_ilp64_cblas, get_sswap_for_lp64_cblas, get_zaxpy_for_ilp64_cblas,
-    get_zaxpy_for_lp64_cblas, get_zcopy_for_ilp64_cblas, get_zcopy_for_lp64_cblas,
-    get_zdscal_for_ilp64_cblas, get_zdscal_for_lp64_cblas, get_zscal_for_ilp64_cblas,
-    get_zscal_for_lp64_cblas, get_zswap_for_ilp64_cblas, get_zswap_for_lp64_cblas, CaxpyProvider,
-    CcopyProvider, CscalProvider, CsscalProvider, CswapProvider, DaxpyProvider, DcopyProvider,
-    DscalProvider, DswapProvider, SaxpyProvider, ScopyProvider, SscalProvider, SswapProvider,
-    ZaxpyProvider, ZcopyProvider, ZdscalProvider, ZscalProvider, ZswapProvider,
+    get_cswap_for_lp64_cblas, get_zaxpy_for_ilp64_cblas, get_zaxpy_for_lp64_cblas,
+    get_zcopy_for_ilp64_cblas, get_zcopy_for_lp64_cblas, get_zdscal_for_ilp64_cblas,
+    get_zdscal_for_lp64_cblas, get_zscal_for_ilp64_cblas, get_zscal_for_lp64_cblas,
+    get_zswap_for_ilp64_cblas, get_zswap_for_lp64_cblas, try_get_caxpby_for_ilp64_cblas,
+    try_get_caxpby_for_lp64_cblas, try_get_daxpby_for_ilp64_cblas, try_get_daxpby_for_lp64_cblas,
+    try_get_daxpy_for_ilp64_cblas, try_get_daxpy_for_lp64_cblas, try_get_dcopy_for_ilp64_cblas,
+    try_get_dcopy_for_lp64_cblas, try_get_dscal_for_ilp64_cblas, try_get_dscal_for_lp64_cblas,
+    try_get_dswap_for_ilp64_cblas, try_get_dswap_for_lp64_cblas, try_get_saxpby_for_ilp64_cblas,
+    try_get_saxpby_for_lp64_cblas, try_get_saxpy_for_ilp64_cblas, try_get_saxpy_for_lp64_cblas,
+    try_get_scopy_for_ilp64_cblas, try_get_scopy_for_lp64_cblas, try_get_sscal_for_ilp64_cblas,
+    try_get_sscal_for_lp64_cblas, try_get_sswap_for_ilp64_cblas, try_get_sswap_for_lp64_cblas,
+    try_get_zaxpby_for_ilp64_cblas, try_get_zaxpby_for_lp64_cblas, CaxpbyProvider, CaxpyProvider,
+    CcopyProvider, CscalProvider, CsscalProvider, CswapProvider, DaxpbyProvider, DaxpyProvider,
+    DcopyProvider, DscalProvider, DswapProvider, SaxpbyProvider, SaxpyProvider, ScopyProvider,
+    SscalProvider, SswapProvider, ZaxpbyProvider, ZaxpyProvider, ZcopyProvider, ZdscalProvider,
+    ZscalProvider, ZswapProvider,
 };
+use crate::dispatch;
+use crate::native::blas1 as native;
+use crate::stats::Routine;
 
 // =============================================================================
 // Vector swap (exchange x and y)
@@ -36,7 +43,10 @@ use crate::backend::{
 /// - sswap must be registered via `register_sswap`
 #[no_mangle]
 pub unsafe extern "C" fn cblas_sswap(n: i32, x: *mut f32, incx: i32, y: *mut f32, incy: i32) {
-    let p = get_sswap_for_lp64_cblas();
+    let _call = dispatch::enter(Routine::Sswap, None, [], [n], [incx, incy]);
+    let Some(p) = native::select_provider(i64::from(n), try_get_sswap_for_lp64_cblas) else {
+        return native::swap(i64::from(n), x, i64::from(incx), y, i64::from(incy));
+    };
     match p {
         SswapProvider::Lp64(f) => f(&n, x, &incx, y, &incy),
         SswapProvider::Ilp64(f) => f(&(n as i64), x, &(incx as i64), y, &(incy as i64)),
@@ -46,7 +56,10 @@ pub unsafe extern "C" fn cblas_sswap(n: i32, x: *mut f32, incx: i32, y: *mut f32
 /// Single precision vector swap with ILP64 integer ABI.
 #[no_mangle]
 pub unsafe extern "C" fn cblas_sswap_64(n: i64, x: *mut f32, incx: i64, y: *mut f32, incy: i64) {
-    let p = get_sswap_for_ilp64_cblas();
+    let _call = dispatch::enter(Routine::Sswap, None, [], [n], [incx, incy]);
+    let Some(p) = native::select_provider(n, try_get_sswap_for_ilp64_cblas) else {
+        return native::swap(n, x, incx, y, incy);
+    };
     if matches!(p, SswapProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
             b"cblas_sswap_64\0",
@@ -73,7 +86,10 @@ pub unsafe extern "C" fn cblas_sswap_64(n: i64, x: *mut f32, incx: i64, y: *mut
 /// - dswap must be registered via `register_dswap`
 #[no_mangle]
 pub unsafe extern "C" fn cblas_dswap(n: i32, x: *mut f64, incx: i32, y: *mut f64, incy: i32) {
-    let p = get_dswap_for_lp64_cblas();
+    let _call = dispatch::enter(Routine::Dswap, None, [], [n], [incx, incy]);
+    let Some(p) = native::select_provider(i64::from(n), try_get_dswap_for_lp64_cblas) else {
+        return native::swap(i64::from(n), x, i64::from(incx), y, i64::from(incy));
+    };
     match p {
         DswapProvider::Lp64(f) => f(&n, x, &incx, y, &incy),
         DswapProvider::Ilp64(f) => f(&(n as i64), x, &(incx as i64), y, &(incy as i64)),
@@ -83,7 +99,10 @@ pub unsafe extern "C" fn cblas_dswap(n: i32, x: *mut f64, incx: i32, y: *mut f64
 /// Double precision vector swap with ILP64 integer ABI.
 #[no_mangle]
 pub unsafe extern "C" fn cblas_dswap_64(n: i64, x: *mut f64, incx: i64, y: *mut f64, incy: i64) {
-    let p = get_dswap_for_ilp64_cblas();
+    let _call = dispatch::enter(Routine::Dswap, None, [], [n], [incx, incy]);
+    let Some(p) = native::select_provider(n, try_get_dswap_for_ilp64_cblas) else {
+        return native::swap(n, x, incx, y, incy);
+    };
     if matches!(p, DswapProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
             b"cblas_dswap_64\0",
@@ -116,6 +135,7 @@ pub unsafe extern "C" fn cblas_cswap(
     y: *mut Complex32,
     incy: i32,
 ) {
+    let _call = dispatch::enter(Routine::Cswap, None, [], [n], [incx, incy]);
     let p = get_cswap_for_lp64_cblas();
     match p {
         CswapProvider::Lp64(f) => f(&n, x, &incx, y, &incy),
@@ -132,6 +152,7 @@ pub unsafe extern "C" fn cblas_cswap_64(
     y: *mut Complex32,
     incy: i64,
 ) {
+    let _call = dispatch::enter(Routine::Cswap, None, [], [n], [incx, incy]);
     let p = get_cswap_for_ilp64_cblas();
     if matches!(p, CswapProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -165,6 +186,7 @@ pub unsafe extern "C" fn cblas_zswap(
     y: *mut Complex64,
     incy: i32,
 ) {
+    let _call = dispatch::enter(Routine::Zswap, None, [], [n], [incx, incy]);
     let p = get_zswap_for_lp64_cblas();
     match p {
         ZswapProvider::Lp64(f) => f(&n, x, &incx, y, &incy),
@@ -181,6 +203,7 @@ pub unsafe extern "C" fn cblas_zswap_64(
     y: *mut Complex64,
     incy: i64,
 ) {
+    let _call = dispatch::enter(Routine::Zswap, None, [], [n], [incx, incy]);
     let p = get_zswap_for_ilp64_cblas();
     if matches!(p, ZswapProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -212,7 +235,10 @@ pub unsafe extern "C" fn cblas_zswap_64(
 /// - scopy must be registered via `register_scopy`
 #[no_mangle]
 pub unsafe extern "C" fn cblas_scopy(n: i32, x: *const f32, incx: i32, y: *mut f32, incy: i32) {
-    let p = get_scopy_for_lp64_cblas();
+    let _call = dispatch::enter(Routine::Scopy, None, [], [n], [incx, incy]);
+    let Some(p) = native::select_provider(i64::from(n), try_get_scopy_for_lp64_cblas) else {
+        return native::copy(i64::from(n), x, i64::from(incx), y, i64::from(incy));
+    };
     match p {
         ScopyProvider::Lp64(f) => f(&n, x, &incx, y, &incy),
         ScopyProvider::Ilp64(f) => f(&(n as i64), x, &(incx as i64), y, &(incy as i64)),
@@ -222,7 +248,10 @@ pub unsafe extern "C" fn cblas_scopy(n: i32, x: *const f32, incx: i32, y: *mut f
 /// Single precision vector copy with ILP64 integer ABI.
 #[no_mangle]
 pub unsafe extern "C" fn cblas_scopy_64(n: i64, x: *const f32, incx: i64, y: *mut f32, incy: i64) {
-    let p = get_scopy_for_ilp64_cblas();
+    let _call = dispatch::enter(Routine::Scopy, None, [], [n], [incx, incy]);
+    let Some(p) = native::select_provider(n, try_get_scopy_for_ilp64_cblas) else {
+        return native::copy(n, x, incx, y, incy);
+    };
     if matches!(p, ScopyProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
             b"cblas_scopy_64\0",
@@ -249,7 +278,10 @@ pub unsafe extern "C" fn cblas_scopy_64(n: i64, x: *const f32, incx: i64, y: *mu
 /// - dcopy must be registered via `register_dcopy`
 #[no_mangle]
 pub unsafe extern "C" fn cblas_dcopy(n: i32, x: *const f64, incx: i32, y: *mut f64, incy: i32) {
-    let p = get_dcopy_for_lp64_cblas();
+    let _call = dispatch::enter(Routine::Dcopy, None, [], [n], [incx, incy]);
+    let Some(p) = native::select_provider(i64::from(n), try_get_dcopy_for_lp64_cblas) else {
+        return native::copy(i64::from(n), x, i64::from(incx), y, i64::from(incy));
+    };
     match p {
         DcopyProvider::Lp64(f) => f(&n, x, &incx, y, &incy),
         DcopyProvider::Ilp64(f) => f(&(n as i64), x, &(incx as i64), y, &(incy as i64)),
@@ -259,7 +291,10 @@ pub unsafe extern "C" fn cblas_dcopy(n: i32, x: *const f64, incx: i32, y: *mut f
 /// Double precision vector copy with ILP64 integer ABI.
 #[no_mangle]
 pub unsafe extern "C" fn cblas_dcopy_64(n: i64, x: *const f64, incx: i64, y: *mut f64, incy: i64) {
-    let p = get_dcopy_for_ilp64_cblas();
+    let _call = dispatch::enter(Routine::Dcopy, None, [], [n], [incx, incy]);
+    let Some(p) = native::select_provider(n, try_get_dcopy_for_ilp64_cblas) else {
+        return native::copy(n, x, incx, y, incy);
+    };
     if matches!(p, DcopyProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
             b"cblas_dcopy_64\0",
@@ -292,6 +327,7 @@ pub unsafe extern "C" fn cblas_ccopy(
     y: *mut Complex32,
     incy: i32,
 ) {
+    let _call = dispatch::enter(Routine::Ccopy, None, [], [n], [incx, incy]);
     let p = get_ccopy_for_lp64_cblas();
     match p {
         CcopyProvider::Lp64(f) => f(&n, x, &incx, y, &incy),
@@ -308,6 +344,7 @@ pub unsafe extern "C" fn cblas_ccopy_64(
     y: *mut Complex32,
     incy: i64,
 ) {
+    let _call = dispatch::enter(Routine::Ccopy, None, [], [n], [incx, incy]);
     let p = get_ccopy_for_ilp64_cblas();
     if matches!(p, CcopyProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -341,6 +378,7 @@ pub unsafe extern "C" fn cblas_zcopy(
     y: *mut Complex64,
     incy: i32,
 ) {
+    let _call = dispatch::enter(Routine::Zcopy, None, [], [n], [incx, incy]);
     let p = get_zcopy_for_lp64_cblas();
     match p {
         ZcopyProvider::Lp64(f) => f(&n, x, &incx, y, &incy),
@@ -357,6 +395,7 @@ pub unsafe extern "C" fn cblas_zcopy_64(
     y: *mut Complex64,
     incy: i64,
 ) {
+    let _call = dispatch::enter(Routine::Zcopy, None, [], [n], [incx, incy]);
     let p = get_zcopy_for_ilp64_cblas();
     if matches!(p, ZcopyProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -393,7 +432,10 @@ pub unsafe extern "C" fn cblas_saxpy(
     y: *mut f32,
     incy: i32,
 ) {
-    let p = get_saxpy_for_lp64_cblas();
+    let _call = dispatch::enter(Routine::Saxpy, None, [], [n], [incx, incy]);
+    let Some(p) = native::select_provider(i64::from(n), try_get_saxpy_for_lp64_cblas) else {
+        return native::axpy(i64::from(n), alpha, x, i64::from(incx), y, i64::from(incy));
+    };
     match p {
         SaxpyProvider::Lp64(f) => f(&n, &alpha, x, &incx, y, &incy),
         SaxpyProvider::Ilp64(f) => f(&(n as i64), &alpha, x, &(incx as i64), y, &(incy as i64)),
@@ -410,7 +452,10 @@ pub unsafe extern "C" fn cblas_saxpy_64(
     y: *mut f32,
     incy: i64,
 ) {
-    let p = get_saxpy_for_ilp64_cblas();
+    let _call = dispatch::enter(Routine::Saxpy, None, [], [n], [incx, incy]);
+    let Some(p) = native::select_provider(n, try_get_saxpy_for_ilp64_cblas) else {
+        return native::axpy(n, alpha, x, incx, y, incy);
+    };
     if matches!(p, SaxpyProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
             b"cblas_saxpy_64\0",
@@ -442,7 +487,10 @@ pub unsafe extern "C" fn cblas_daxpy(
     y: *mut f64,
     incy: i32,
 ) {
-    let p = get_daxpy_for_lp64_cblas();
+    let _call = dispatch::enter(Routine::Daxpy, None, [], [n], [incx, incy]);
+    let Some(p) = native::select_provider(i64::from(n), try_get_daxpy_for_lp64_cblas) else {
+        return native::axpy(i64::from(n), alpha, x, i64::from(incx), y, i64::from(incy));
+    };
     match p {
         DaxpyProvider::Lp64(f) => f(&n, &alpha, x, &incx, y, &incy),
         DaxpyProvider::Ilp64(f) => f(&(n as i64), &alpha, x, &(incx as i64), y, &(incy as i64)),
@@ -459,7 +507,10 @@ pub unsafe extern "C" fn cblas_daxpy_64(
     y: *mut f64,
     incy: i64,
 ) {
-    let p = get_daxpy_for_ilp64_cblas();
+    let _call = dispatch::enter(Routine::Daxpy, None, [], [n], [incx, incy]);
+    let Some(p) = native::select_provider(n, try_get_daxpy_for_ilp64_cblas) else {
+        return native::axpy(n, alpha, x, incx, y, incy);
+    };
     if matches!(p, DaxpyProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
             b"cblas_daxpy_64\0",
@@ -491,6 +542,7 @@ pub unsafe extern "C" fn cblas_caxpy(
     y: *mut Complex32,
     incy: i32,
 ) {
+    let _call = dispatch::enter(Routine::Caxpy, None, [], [n], [incx, incy]);
     let p = get_caxpy_for_lp64_cblas();
     match p {
         CaxpyProvider::Lp64(f) => f(&n, alpha, x, &incx, y, &incy),
@@ -508,6 +560,7 @@ pub unsafe extern "C" fn cblas_caxpy_64(
     y: *mut Complex32,
     incy: i64,
 ) {
+    let _call = dispatch::enter(Routine::Caxpy, None, [], [n], [incx, incy]);
     let p = get_caxpy_for_ilp64_cblas();
     if matches!(p, CaxpyProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -540,6 +593,7 @@ pub unsafe extern "C" fn cblas_zaxpy(
     y: *mut Complex64,
     incy: i32,
 ) {
+    let _call = dispatch::enter(Routine::Zaxpy, None, [], [n], [incx, incy]);
     let p = get_zaxpy_for_lp64_cblas();
     match p {
         ZaxpyProvider::Lp64(f) => f(&n, alpha, x, &incx, y, &incy),
@@ -557,6 +611,7 @@ pub unsafe extern "C" fn cblas_zaxpy_64(
     y: *mut Complex64,
     incy: i64,
 ) {
+    let _call = dispatch::enter(Routine::Zaxpy, None, [], [n], [incx, incy]);
     let p = get_zaxpy_for_ilp64_cblas();
     if matches!(p, ZaxpyProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -574,6 +629,334 @@ pub unsafe extern "C" fn cblas_zaxpy_64(
     }
 }
 
+// =============================================================================
+// Vector scale-and-add (y = alpha*x + beta*y)
+// =============================================================================
+
+/// Single precision vector scale-and-add: y = alpha*x + beta*y
+///
+/// # Safety
+///
+/// - All pointers must be valid and properly aligned
+#[no_mangle]
+pub unsafe extern "C" fn cblas_saxpby(
+    n: i32,
+    alpha: f32,
+    x: *const f32,
+    incx: i32,
+    beta: f32,
+    y: *mut f32,
+    incy: i32,
+) {
+    let _call = dispatch::enter(Routine::Saxpby, None, [], [n], [incx, incy]);
+    let Some(p) = native::select_provider(i64::from(n), try_get_saxpby_for_lp64_cblas) else {
+        return native::axpby(
+            i64::from(n),
+            alpha,
+            x,
+            i64::from(incx),
+            beta,
+            y,
+            i64::from(incy),
+        );
+    };
+    match p {
+        SaxpbyProvider::Lp64(f) => f(&n, &alpha, x, &incx, &beta, y, &incy),
+        SaxpbyProvider::Ilp64(f) => f(
+            &(n as i64),
+            &alpha,
+            x,
+            &(incx as i64),
+            &beta,
+            y,
+            &(incy as i64),
+        ),
+    }
+}
+
+/// Single precision axpby with ILP64 integer ABI.
+#[no_mangle]
+pub unsafe extern "C" fn cblas_saxpby_64(
+    n: i64,
+    alpha: f32,
+    x: *const f32,
+    incx: i64,
+    beta: f32,
+    y: *mut f32,
+    incy: i64,
+) {
+    let _call = dispatch::enter(Routine::Saxpby, None, [], [n], [incx, incy]);
+    let Some(p) = native::select_provider(n, try_get_saxpby_for_ilp64_cblas) else {
+        return native::axpby(n, alpha, x, incx, beta, y, incy);
+    };
+    if matches!(p, SaxpbyProvider::Lp64(_))
+        && crate::int_convert::to_lp64_array_i64(
+            b"cblas_saxpby_64\0",
+            [(1, n), (4, incx), (7, incy)],
+        )
+        .is_none()
+    {
+        return;
+    }
+
+    match p {
+        SaxpbyProvider::Ilp64(f) => f(&n, &alpha, x, &incx, &beta, y, &incy),
+        SaxpbyProvider::Lp64(f) => f(
+            &(n as i32),
+            &alpha,
+            x,
+            &(incx as i32),
+            &beta,
+            y,
+            &(incy as i32),
+        ),
+    }
+}
+
+/// Double precision vector scale-and-add: y = alpha*x + beta*y
+///
+/// # Safety
+///
+/// - All pointers must be valid and properly aligned
+#[no_mangle]
+pub unsafe extern "C" fn cblas_daxpby(
+    n: i32,
+    alpha: f64,
+    x: *const f64,
+    incx: i32,
+    beta: f64,
+    y: *mut f64,
+    incy: i32,
+) {
+    let _call = dispatch::enter(Routine::Daxpby, None, [], [n], [incx, incy]);
+    let Some(p) = native::select_provider(i64::from(n), try_get_daxpby_for_lp64_cblas) else {
+        return native::axpby(
+            i64::from(n),
+            alpha,
+            x,
+            i64::from(incx),
+            beta,
+            y,
+            i64::from(incy),
+        );
+    };
+    match p {
+        DaxpbyProvider::Lp64(f) => f(&n, &alpha, x, &incx, &beta, y, &incy),
+        DaxpbyProvider::Ilp64(f) => f(
+            &(n as i64),
+            &alpha,
+            x,
+            &(incx as i64),
+            &beta,
+            y,
+            &(incy as i64),
+        ),
+    }
+}
+
+/// Double precision axpby with ILP64 integer ABI.
+#[no_mangle]
+pub unsafe extern "C" fn cblas_daxpby_64(
+    n: i64,
+    alpha: f64,
+    x: *const f64,
+    incx: i64,
+    beta: f64,
+    y: *mut f64,
+    incy: i64,
+) {
+    let _call = dispatch::enter(Routine::Daxpby, None, [], [n], [incx, incy]);
+    let Some(p) = native::select_provider(n, try_get_daxpby_for_ilp64_cblas) else {
+        return native::axpby(n, alpha, x, incx, beta, y, incy);
+    };
+    if matches!(p, DaxpbyProvider::Lp64(_))
+        && crate::int_convert::to_lp64_array_i64(
+            b"cblas_daxpby_64\0",
+            [(1, n), (4, incx), (7, incy)],
+        )
+        .is_none()
+    {
+        return;
+    }
+
+    match p {
+        DaxpbyProvider::Ilp64(f) => f(&n, &alpha, x, &incx, &beta, y, &incy),
+        DaxpbyProvider::Lp64(f) => f(
+            &(n as i32),
+            &alpha,
+            x,
+            &(incx as i32),
+            &beta,
+            y,
+            &(incy as i32),
+        ),
+    }
+}
+
+/// Single precision complex vector scale-and-add: y = alpha*x + beta*y
+///
+/// Runs natively when no caxpby provider is registered.
+///
+/// # Safety
+///
+/// - All pointers must be valid and properly aligned
+#[no_mangle]
+pub unsafe extern "C" fn cblas_caxpby(
+    n: i32,
+    alpha: *const Complex32,
+    x: *const Complex32,
+    incx: i32,
+    beta: *const Complex32,
+    y: *mut Complex32,
+    incy: i32,
+) {
+    let _call = dispatch::enter(Routine::Caxpby, None, [], [n], [incx, incy]);
+    let Some(p) = try_get_caxpby_for_lp64_cblas() else {
+        return native::axpby(
+            i64::from(n),
+            *alpha,
+            x,
+            i64::from(incx),
+            *beta,
+            y,
+            i64::from(incy),
+        );
+    };
+    match p {
+        CaxpbyProvider::Lp64(f) => f(&n, alpha, x, &incx, beta, y, &incy),
+        CaxpbyProvider::Ilp64(f) => f(
+            &(n as i64),
+            alpha,
+            x,
+            &(incx as i64),
+            beta,
+            y,
+            &(incy as i64),
+        ),
+    }
+}
+
+/// Single precision complex axpby with ILP64 integer ABI.
+#[no_mangle]
+pub unsafe extern "C" fn cblas_caxpby_64(
+    n: i64,
+    alpha: *const Complex32,
+    x: *const Complex32,
+    incx: i64,
+    beta: *const Complex32,
+    y: *mut Complex32,
+    incy: i64,
+) {
+    let _call = dispatch::enter(Routine::Caxpby, None, [], [n], [incx, incy]);
+    let Some(p) = try_get_caxpby_for_ilp64_cblas() else {
+        return native::axpby(n, *alpha, x, incx, *beta, y, incy);
+    };
+    if matches!(p, CaxpbyProvider::Lp64(_))
+        && crate::int_convert::to_lp64_array_i64(
+            b"cblas_caxpby_64\0",
+            [(1, n), (4, incx), (7, incy)],
+        )
+        .is_none()
+    {
+        return;
+    }
+
+    match p {
+        CaxpbyProvider::Ilp64(f) => f(&n, alpha, x, &incx, beta, y, &incy),
+        CaxpbyProvider::Lp64(f) => f(
+            &(n as i32),
+            alpha,
+            x,
+            &(incx as i32),
+            beta,
+            y,
+            &(incy as i32),
+        ),
+    }
+}
+
+/// Double precision complex vector scale-and-add: y = alpha*x + beta*y
+///
+/// Runs natively when no zaxpby provider is registered.
+///
+/// # Safety
+///
+/// - All pointers must be valid and properly aligned
+#[no_mangle]
+pub unsafe extern "C" fn cblas_zaxpby(
+    n: i32,
+    alpha: *const Complex64,
+    x: *const Complex64,
+    incx: i32,
+    beta: *const Complex64,
+    y: *mut Complex64,
+    incy: i32,
+) {
+    let _call = dispatch::enter(Routine::Zaxpby, None, [], [n], [incx, incy]);
+    let Some(p) = try_get_zaxpby_for_lp64_cblas() else {
+        return native::axpby(
+            i64::from(n),
+            *alpha,
+            x,
+            i64::from(incx),
+            *beta,
+            y,
+            i64::from(incy),
+        );
+    };
+    match p {
+        ZaxpbyProvider::Lp64(f) => f(&n, alpha, x, &incx, beta, y, &incy),
+        ZaxpbyProvider::Ilp64(f) => f(
+            &(n as i64),
+            alpha,
+            x,
+            &(incx as i64),
+            beta,
+            y,
+            &(incy as i64),
+        ),
+    }
+}
+
+/// Double precision complex axpby with ILP64 integer ABI.
+#[no_mangle]
+pub unsafe extern "C" fn cblas_zaxpby_64(
+    n: i64,
+    alpha: *const Complex64,
+    x: *const Complex64,
+    incx: i64,
+    beta: *const Complex64,
+    y: *mut Complex64,
+    incy: i64,
+) {
+    let _call = dispatch::enter(Routine::Zaxpby, None, [], [n], [incx, incy]);
+    let Some(p) = try_get_zaxpby_for_ilp64_cblas() else {
+        return native::axpby(n, *alpha, x, incx, *beta, y, incy);
+    };
+    if matches!(p, ZaxpbyProvider::Lp64(_))
+        && crate::int_convert::to_lp64_array_i64(
+            b"cblas_zaxpby_64\0",
+            [(1, n), (4, incx), (7, incy)],
+        )
+        .is_none()
+    {
+        return;
+    }
+
+    match p {
+        ZaxpbyProvider::Ilp64(f) => f(&n, alpha, x, &incx, beta, y, &incy),
+        ZaxpbyProvider::Lp64(f) => f(
+            &(n as i32),
+            alpha,
+            x,
+            &(incx as i32),
+            beta,
+            y,
+            &(incy as i32),
+        ),
+    }
+}
+
 // =============================================================================
 // Vector scale (x = alpha*x)
 // =============================================================================
@@ -586,7 +969,10 @@ pub unsafe extern "C" fn cblas_zaxpy_64(
 /// - sscal must be registered via `register_sscal`
 #[no_mangle]
 pub unsafe extern "C" fn cblas_sscal(n: i32, alpha: f32, x: *mut f32, incx: i32) {
-    let p = get_sscal_for_lp64_cblas();
+    let _call = dispatch::enter(Routine::Sscal, None, [], [n], [incx]);
+    let Some(p) = native::select_provider(i64::from(n), try_get_sscal_for_lp64_cblas) else {
+        return native::scal(i64::from(n), alpha, x, i64::from(incx));
+    };
     match p {
         SscalProvider::Lp64(f) => f(&n, &alpha, x, &incx),
         SscalProvider::Ilp64(f) => f(&(n as i64), &alpha, x, &(incx as i64)),
@@ -596,7 +982,10 @@ pub unsafe extern "C" fn cblas_sscal(n: i32, alpha: f32, x: *mut f32, incx: i32)
 /// Single precision vector scaling with ILP64 integer ABI.
 #[no_mangle]
 pub unsafe extern "C" fn cblas_sscal_64(n: i64, alpha: f32, x: *mut f32, incx: i64) {
-    let p = get_sscal_for_ilp64_cblas();
+    let _call = dispatch::enter(Routine::Sscal, None, [], [n], [incx]);
+    let Some(p) = native::select_provider(n, try_get_sscal_for_ilp64_cblas) else {
+        return native::scal(n, alpha, x, incx);
+    };
     if matches!(p, SscalProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_sscal_64\0", [(1, n), (4, incx)]).is_none()
     {
@@ -617,7 +1006,10 @@ pub unsafe extern "C" fn cblas_sscal_64(n: i64, alpha: f32, x: *mut f32, incx: i
 /// - dscal must be registered via `register_dscal`
 #[no_mangle]
 pub unsafe extern "C" fn cblas_dscal(n: i32, alpha: f64, x: *mut f64, incx: i32) {
-    let p = get_dscal_for_lp64_cblas();
+    let _call = dispatch::enter(Routine::Dscal, None, [], [n], [incx]);
+    let Some(p) = native::select_provider(i64::from(n), try_get_dscal_for_lp64_cblas) else {
+        return native::scal(i64::from(n), alpha, x, i64::from(incx));
+    };
     match p {
         DscalProvider::Lp64(f) => f(&n, &alpha, x, &incx),
         DscalProvider::Ilp64(f) => f(&(n as i64), &alpha, x, &(incx as i64)),
@@ -627,7 +1019,10 @@ pub unsafe extern "C" fn cblas_dscal(n: i32, alpha: f64, x: *mut f64, incx: i32)
 /// Double precision vector scaling with ILP64 integer ABI.
 #[no_mangle]
 pub unsafe extern "C" fn cblas_dscal_64(n: i64, alpha: f64, x: *mut f64, incx: i64) {
-    let p = get_dscal_for_ilp64_cblas();
+    let _call = dispatch::enter(Routine::Dscal, None, [], [n], [incx]);
+    let Some(p) = native::select_provider(n, try_get_dscal_for_ilp64_cblas) else {
+        return native::scal(n, alpha, x, incx);
+    };
     if matches!(p, DscalProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_dscal_64\0", [(1, n), (4, incx)]).is_none()
     {
@@ -653,6 +1048,7 @@ pub unsafe extern "C" fn cblas_cscal(
     x: *mut Complex32,
     incx: i32,
 ) {
+    let _call = dispatch::enter(Routine::Cscal, None, [], [n], [incx]);
     let p = get_cscal_for_lp64_cblas();
     match p {
         CscalProvider::Lp64(f) => f(&n, alpha, x, &incx),
@@ -668,6 +1064,7 @@ pub unsafe extern "C" fn cblas_cscal_64(
     x: *mut Complex32,
     incx: i64,
 ) {
+    let _call = dispatch::enter(Routine::Cscal, None, [], [n], [incx]);
     let p = get_cscal_for_ilp64_cblas();
     if matches!(p, CscalProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_cscal_64\0", [(1, n), (4, incx)]).is_none()
@@ -694,6 +1091,7 @@ pub unsafe extern "C" fn cblas_zscal(
     x: *mut Complex64,
     incx: i32,
 ) {
+    let _call = dispatch::enter(Routine::Zscal, None, [], [n], [incx]);
     let p = get_zscal_for_lp64_cblas();
     match p {
         ZscalProvider::Lp64(f) => f(&n, alpha, x, &incx),
@@ -709,6 +1107,7 @@ pub unsafe extern "C" fn cblas_zscal_64(
     x: *mut Complex64,
     incx: i64,
 ) {
+    let _call = dispatch::enter(Routine::Zscal, None, [], [n], [incx]);
     let p = get_zscal_for_ilp64_cblas();
     if matches!(p, ZscalProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_zscal_64\0", [(1, n), (4, incx)]).is_none()
@@ -730,6 +1129,7 @@ pub unsafe extern "C" fn cblas_zscal_64(
 /// - csscal must be registered via `register_csscal`
 #[no_mangle]
 pub unsafe extern "C" fn cblas_csscal(n: i32, alpha: f32, x: *mut Complex32, incx: i32) {
+    let _call = dispatch::enter(Routine::Csscal, None, [], [n], [incx]);
     let p = get_csscal_for_lp64_cblas();
     match p {
         CsscalProvider::Lp64(f) => f(&n, &alpha, x, &incx),
@@ -740,6 +1140,7 @@ pub unsafe extern "C" fn cblas_csscal(n: i32, alpha: f32, x: *mut Complex32, inc
 /// Scale complex vector by real scalar with ILP64 integer ABI.
 #[no_mangle]
 pub unsafe extern "C" fn cblas_csscal_64(n: i64, alpha: f32, x: *mut Complex32, incx: i64) {
+    let _call = dispatch::enter(Routine::Csscal, None, [], [n], [incx]);
     let p = get_csscal_for_ilp64_cblas();
     if matches!(p, CsscalProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_csscal_64\0", [(1, n), (4, incx)])
@@ -762,6 +1163,7 @@ pub unsafe extern "C" fn cblas_csscal_64(n: i64, alpha: f32, x: *mut Complex32,
 /// - zdscal must be registered via `register_zdscal`
 #[no_mangle]
 pub unsafe extern "C" fn cblas_zdscal(n: i32, alpha: f64, x: *mut Complex64, incx: i32) {
+    let _call = dispatch::enter(Routine::Zdscal, None, [], [n], [incx]);
     let p = get_zdscal_for_lp64_cblas();
     match p {
         ZdscalProvider::Lp64(f) => f(&n, &alpha, x, &incx),
@@ -772,6 +1174,7 @@ pub unsafe extern "C" fn cblas_zdscal(n: i32, alpha: f64, x: *mut Complex64, inc
 /// Scale complex vector by real scalar with ILP64 integer ABI.
 #[no_mangle]
 pub unsafe extern "C" fn cblas_zdscal_64(n: i64, alpha: f64, x: *mut Complex64, incx: i64) {
+    let _call = dispatch::enter(Routine::Zdscal, None, [], [n], [incx]);
     let p = get_zdscal_for_ilp64_cblas();
     if matches!(p, ZdscalProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_zdscal_64\0", [(1, n), (4, incx)])
@@ -20,6 +20,8 @@ use crate::backend::{
     get_zgbmv_for_ilp64_cblas, get_zgbmv_for_lp64_cblas, CgbmvProvider, DgbmvProvider,
     SgbmvProvider, ZgbmvProvider,
 };
+use crate::dispatch;
+use crate::stats::Routine;
 use crate::types::{
     normalize_transpose_real, transpose_to_char, CblasColMajor, CblasConjNoTrans, CblasConjTrans,
     CblasNoTrans, CblasRowMajor, CblasTrans, CBLAS_ORDER, CBLAS_TRANSPOSE,
@@ -65,6 +67,13 @@ pub unsafe extern "C" fn cblas_sgbmv(
     y: *mut f32,
     incy: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Sgbmv,
+        Some(order),
+        [trans as u8],
+        [m, n, kl, ku],
+        [lda, incx, incy],
+    );
     let p = get_sgbmv_for_lp64_cblas();
     match p {
         SgbmvProvider::Lp64(sgbmv) => {
@@ -182,6 +191,13 @@ pub unsafe extern "C" fn cblas_sgbmv_64(
     y: *mut f32,
     incy: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Sgbmv,
+        Some(order),
+        [trans as u8],
+        [m, n, kl, ku],
+        [lda, incx, incy],
+    );
     let p = get_sgbmv_for_ilp64_cblas();
     if matches!(p, SgbmvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -327,6 +343,13 @@ pub unsafe extern "C" fn cblas_dgbmv(
     y: *mut f64,
     incy: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Dgbmv,
+        Some(order),
+        [trans as u8],
+        [m, n, kl, ku],
+        [lda, incx, incy],
+    );
     let p = get_dgbmv_for_lp64_cblas();
     match p {
         DgbmvProvider::Lp64(dgbmv) => match order {
@@ -436,6 +459,13 @@ pub unsafe extern "C" fn cblas_dgbmv_64(
     y: *mut f64,
     incy: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Dgbmv,
+        Some(order),
+        [trans as u8],
+        [m, n, kl, ku],
+        [lda, incx, incy],
+    );
     let p = get_dgbmv_for_ilp64_cblas();
     if matches!(p, DgbmvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -573,6 +603,13 @@ pub unsafe extern "C" fn cblas_cgbmv(
     y: *mut Complex32,
     incy: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Cgbmv,
+        Some(order),
+        [trans as u8],
+        [m, n, kl, ku],
+        [lda, incx, incy],
+    );
     let p = get_cgbmv_for_lp64_cblas();
     match p {
         CgbmvProvider::Lp64(cgbmv) => {
@@ -700,6 +737,13 @@ pub unsafe extern "C" fn cblas_cgbmv_64(
     y: *mut Complex32,
     incy: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Cgbmv,
+        Some(order),
+        [trans as u8],
+        [m, n, kl, ku],
+        [lda, incx, incy],
+    );
     let p = get_cgbmv_for_ilp64_cblas();
     if matches!(p, CgbmvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -855,6 +899,13 @@ pub unsafe extern "C" fn cblas_zgbmv(
     y: *mut Complex64,
     incy: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Zgbmv,
+        Some(order),
+        [trans as u8],
+        [m, n, kl, ku],
+        [lda, incx, incy],
+    );
     let p = get_zgbmv_for_lp64_cblas();
     match p {
         ZgbmvProvider::Lp64(zgbmv) => {
@@ -980,6 +1031,13 @@ pub unsafe extern "C" fn cblas_zgbmv_64(
     y: *mut Complex64,
     incy: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Zgbmv,
+        Some(order),
+        [trans as u8],
+        [m, n, kl, ku],
+        [lda, incx, incy],
+    );
     let p = get_zgbmv_for_ilp64_cblas();
     if matches!(p, ZgbmvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -13,11 +13,16 @@
 use num_complex::{Complex32, Complex64};
 
 use crate::backend::{
-    get_cgemv_for_ilp64_cblas, get_cgemv_for_lp64_cblas, get_dgemv_for_ilp64_cblas,
-    get_dgemv_for_lp64_cblas, get_sgemv_for_ilp64_cblas, get_sgemv_for_lp64_cblas,
-    get_zgemv_for_ilp64_cblas, get_zgemv_for_lp64_cblas, CgemvProvider, DgemvProvider,
+    route_cgemv_for_ilp64_cblas, route_cgemv_for_lp64_cblas, route_dgemv_for_ilp64_cblas,
+    route_dgemv_for_lp64_cblas, route_sgemv_for_ilp64_cblas, route_sgemv_for_lp64_cblas,
+    route_zgemv_for_ilp64_cblas, route_zgemv_for_lp64_cblas, CgemvProvider, DgemvProvider,
     SgemvProvider, ZgemvProvider,
 };
+use crate::coalesce;
+use crate::degenerate;
+use crate::dispatch;
+use crate::stats::Routine;
+use crate::trace::{self, Path};
 use crate::types::{
     normalize_transpose_real, transpose_to_char, CblasColMajor, CblasConjNoTrans, CblasConjTrans,
     CblasNoTrans, CblasRowMajor, CblasTrans, CBLAS_ORDER, CBLAS_TRANSPOSE,
@@ -62,7 +67,51 @@ pub unsafe extern "C" fn cblas_sgemv(
     y: *mut f32,
     incy: i32,
 ) {
-    let p = get_sgemv_for_lp64_cblas();
+    let _call = dispatch::enter(
+        Routine::Sgemv,
+        Some(order),
+        [trans as u8],
+        [m, n],
+        [lda, incx, incy],
+    );
+    if unsafe {
+        coalesce::gemv(
+            order,
+            trans,
+            i64::from(m),
+            i64::from(n),
+            alpha,
+            a,
+            i64::from(lda),
+            x,
+            i64::from(incx),
+            beta,
+            y,
+            i64::from(incy),
+        )
+    } {
+        return;
+    }
+    if unsafe {
+        degenerate::gemv(
+            order,
+            trans,
+            i64::from(m),
+            i64::from(n),
+            alpha,
+            a,
+            i64::from(lda),
+            x,
+            i64::from(incx),
+            beta,
+            y,
+            i64::from(incy),
+        )
+    } {
+        trace::dispatched(Path::Native);
+        return;
+    }
+    let p = route_sgemv_for_lp64_cblas(i64::from(m), i64::from(n));
     match p {
         SgemvProvider::Lp64(sgemv) => {
             match order {
@@ -167,7 +216,21 @@ pub unsafe extern "C" fn cblas_sgemv_64(
     y: *mut f32,
     incy: i64,
 ) {
-    let p = get_sgemv_for_ilp64_cblas();
+    let _call = dispatch::enter(
+        Routine::Sgemv,
+        Some(order),
+        [trans as u8],
+        [m, n],
+        [lda, incx, incy],
+    );
+    if unsafe { coalesce::gemv(order, trans, m, n, alpha, a, lda, x, incx, beta, y, incy) } {
+        return;
+    }
+    if unsafe { degenerate::gemv(order, trans, m, n, alpha, a, lda, x, incx, beta, y, incy) } {
+        trace::dispatched(Path::Native);
+        return;
+    }
+    let p = route_sgemv_for_ilp64_cblas(m, n);
     if matches!(p, SgemvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
             b"cblas_sgemv_64\0",
@@ -291,7 +354,51 @@ pub unsafe extern "C" fn cblas_dgemv(
     y: *mut f64,
     incy: i32,
 ) {
-    let p = get_dgemv_for_lp64_cblas();
+    let _call = dispatch::enter(
+        Routine::Dgemv,
+        Some(order),
+        [trans as u8],
+        [m, n],
+        [lda, incx, incy],
+    );
+    if unsafe {
+        coalesce::gemv(
+            order,
+            trans,
+            i64::from(m),
+            i64::from(n),
+            alpha,
+            a,
+            i64::from(lda),
+            x,
+            i64::from(incx),
+            beta,
+            y,
+            i64::from(incy),
+        )
+    } {
+        return;
+    }
+    if unsafe {
+        degenerate::gemv(
+            order,
+            trans,
+            i64::from(m),
+            i64::from(n),
+            alpha,
+            a,
+            i64::from(lda),
+            x,
+            i64::from(incx),
+            beta,
+            y,
+            i64::from(incy),
+        )
+    } {
+        trace::dispatched(Path::Native);
+        return;
+    }
+    let p = route_dgemv_for_lp64_cblas(i64::from(m), i64::from(n));
     match p {
         DgemvProvider::Lp64(dgemv) => match order {
             CblasColMajor => {
@@ -388,7 +495,21 @@ pub unsafe extern "C" fn cblas_dgemv_64(
     y: *mut f64,
     incy: i64,
 ) {
-    let p = get_dgemv_for_ilp64_cblas();
+    let _call = dispatch::enter(
+        Routine::Dgemv,
+        Some(order),
+        [trans as u8],
+        [m, n],
+        [lda, incx, incy],
+    );
+    if unsafe { coalesce::gemv(order, trans, m, n, alpha, a, lda, x, incx, beta, y, incy) } {
+        return;
+    }
+    if unsafe { degenerate::gemv(order, trans, m, n, alpha, a, lda, x, incx, beta, y, incy) } {
+        trace::dispatched(Path::Native);
+        return;
+    }
+    let p = route_dgemv_for_ilp64_cblas(m, n);
     if matches!(p, DgemvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
             b"cblas_dgemv_64\0",
@@ -504,7 +625,51 @@ pub unsafe extern "C" fn cblas_cgemv(
     y: *mut Complex32,
     incy: i32,
 ) {
-    let p = get_cgemv_for_lp64_cblas();
+    let _call = dispatch::enter(
+        Routine::Cgemv,
+        Some(order),
+        [trans as u8],
+        [m, n],
+        [lda, incx, incy],
+    );
+    if unsafe {
+        coalesce::gemv(
+            order,
+            trans,
+            i64::from(m),
+            i64::from(n),
+            *alpha,
+            a,
+            i64::from(lda),
+            x,
+            i64::from(incx),
+            *beta,
+            y,
+            i64::from(incy),
+        )
+    } {
+        return;
+    }
+    if unsafe {
+        degenerate::gemv(
+            order,
+            trans,
+            i64::from(m),
+            i64::from(n),
+            *alpha,
+            a,
+            i64::from(lda),
+            x,
+            i64::from(incx),
+            *beta,
+            y,
+            i64::from(incy),
+        )
+    } {
+        trace::dispatched(Path::Native);
+        return;
+    }
+    let p = route_cgemv_for_lp64_cblas(i64::from(m), i64::from(n));
     match p {
         CgemvProvider::Lp64(cgemv) => {
             match order {
@@ -619,7 +784,21 @@ pub unsafe extern "C" fn cblas_cgemv_64(
     y: *mut Complex32,
     incy: i64,
 ) {
-    let p = get_cgemv_for_ilp64_cblas();
+    let _call = dispatch::enter(
+        Routine::Cgemv,
+        Some(order),
+        [trans as u8],
+        [m, n],
+        [lda, incx, incy],
+    );
+    if unsafe { coalesce::gemv(order, trans, m, n, *alpha, a, lda, x, incx, *beta, y, incy) } {
+        return;
+    }
+    if unsafe { degenerate::gemv(order, trans, m, n, *alpha, a, lda, x, incx, *beta, y, incy) } {
+        trace::dispatched(Path::Native);
+        return;
+    }
+    let p = route_cgemv_for_ilp64_cblas(m, n);
     if matches!(p, CgemvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
             b"cblas_cgemv_64\0",
@@ -753,7 +932,51 @@ pub unsafe extern "C" fn cblas_zgemv(
     y: *mut Complex64,
     incy: i32,
 ) {
-    let p = get_zgemv_for_lp64_cblas();
+    let _call = dispatch::enter(
+        Routine::Zgemv,
+        Some(order),
+        [trans as u8],
+        [m, n],
+        [lda, incx, incy],
+    );
+    if unsafe {
+        coalesce::gemv(
+            order,
+            trans,
+            i64::from(m),
+            i64::from(n),
+            *alpha,
+            a,
+            i64::from(lda),
+            x,
+            i64::from(incx),
+            *beta,
+            y,
+            i64::from(incy),
+        )
+    } {
+        return;
+    }
+    if unsafe {
+        degenerate::gemv(
+            order,
+            trans,
+            i64::from(m),
+            i64::from(n),
+            *alpha,
+            a,
+            i64::from(lda),
+            x,
+            i64::from(incx),
+            *beta,
+            y,
+            i64::from(incy),
+        )
+    } {
+        trace::dispatched(Path::Native);
+        return;
+    }
+    let p = route_zgemv_for_lp64_cblas(i64::from(m), i64::from(n));
     match p {
         ZgemvProvider::Lp64(zgemv) => {
             match order {
@@ -866,7 +1089,21 @@ pub unsafe extern "C" fn cblas_zgemv_64(
     y: *mut Complex64,
     incy: i64,
 ) {
-    let p = get_zgemv_for_ilp64_cblas();
+    let _call = dispatch::enter(
+        Routine::Zgemv,
+        Some(order),
+        [trans as u8],
+        [m, n],
+        [lda, incx, incy],
+    );
+    if unsafe { coalesce::gemv(order, trans, m, n, *alpha, a, lda, x, incx, *beta, y, incy) } {
+        return;
+    }
+    if unsafe { degenerate::gemv(order, trans, m, n, *alpha, a, lda, x, incx, *beta, y, incy) } {
+        trace::dispatched(Path::Native);
+        return;
+    }
+    let p = route_zgemv_for_ilp64_cblas(m, n);
     if matches!(p, ZgemvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
             b"cblas_zgemv_64\0",
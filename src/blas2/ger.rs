@@ -17,6 +17,9 @@ use crate::backend::{
     get_zgerc_for_lp64_cblas, get_zgeru_for_ilp64_cblas, get_zgeru_for_lp64_cblas, CgercProvider,
     CgeruProvider, DgerProvider, SgerProvider, ZgercProvider, ZgeruProvider,
 };
+use crate::degenerate;
+use crate::dispatch;
+use crate::stats::Routine;
 use crate::types::{CblasColMajor, CblasRowMajor, CBLAS_ORDER};
 
 // =============================================================================
@@ -44,6 +47,23 @@ pub unsafe extern "C" fn cblas_sger(
     a: *mut f32,
     lda: i32,
 ) {
+    let _call = dispatch::enter(Routine::Sger, Some(order), [], [m, n], [incx, incy, lda]);
+    if unsafe {
+        degenerate::ger(
+            order,
+            i64::from(m),
+            i64::from(n),
+            alpha,
+            x,
+            i64::from(incx),
+            y,
+            i64::from(incy),
+            a,
+            i64::from(lda),
+        )
+    } {
+        return;
+    }
     let p = get_sger_for_lp64_cblas();
     match p {
         SgerProvider::Lp64(sger) => {
@@ -95,6 +115,10 @@ pub unsafe extern "C" fn cblas_sger_64(
     a: *mut f32,
     lda: i64,
 ) {
+    let _call = dispatch::enter(Routine::Sger, Some(order), [], [m, n], [incx, incy, lda]);
+    if unsafe { degenerate::ger(order, m, n, alpha, x, incx, y, incy, a, lda) } {
+        return;
+    }
     let p = get_sger_for_ilp64_cblas();
     if matches!(p, SgerProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -163,6 +187,23 @@ pub unsafe extern "C" fn cblas_dger(
     a: *mut f64,
     lda: i32,
 ) {
+    let _call = dispatch::enter(Routine::Dger, Some(order), [], [m, n], [incx, incy, lda]);
+    if unsafe {
+        degenerate::ger(
+            order,
+            i64::from(m),
+            i64::from(n),
+            alpha,
+            x,
+            i64::from(incx),
+            y,
+            i64::from(incy),
+            a,
+            i64::from(lda),
+        )
+    } {
+        return;
+    }
     let p = get_dger_for_lp64_cblas();
     match p {
         DgerProvider::Lp64(dger) => {
@@ -210,6 +251,10 @@ pub unsafe extern "C" fn cblas_dger_64(
     a: *mut f64,
     lda: i64,
 ) {
+    let _call = dispatch::enter(Routine::Dger, Some(order), [], [m, n], [incx, incy, lda]);
+    if unsafe { degenerate::ger(order, m, n, alpha, x, incx, y, incy, a, lda) } {
+        return;
+    }
     let p = get_dger_for_ilp64_cblas();
     if matches!(p, DgerProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -278,6 +323,7 @@ pub unsafe extern "C" fn cblas_cgeru(
     a: *mut Complex32,
     lda: i32,
 ) {
+    let _call = dispatch::enter(Routine::Cgeru, Some(order), [], [m, n], [incx, incy, lda]);
     let p = get_cgeru_for_lp64_cblas();
     match p {
         CgeruProvider::Lp64(cgeru) => {
@@ -325,6 +371,7 @@ pub unsafe extern "C" fn cblas_cgeru_64(
     a: *mut Complex32,
     lda: i64,
 ) {
+    let _call = dispatch::enter(Routine::Cgeru, Some(order), [], [m, n], [incx, incy, lda]);
     let p = get_cgeru_for_ilp64_cblas();
     if matches!(p, CgeruProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -389,6 +436,7 @@ pub unsafe extern "C" fn cblas_zgeru(
     a: *mut Complex64,
     lda: i32,
 ) {
+    let _call = dispatch::enter(Routine::Zgeru, Some(order), [], [m, n], [incx, incy, lda]);
     let p = get_zgeru_for_lp64_cblas();
     match p {
         ZgeruProvider::Lp64(zgeru) => {
@@ -436,6 +484,7 @@ pub unsafe extern "C" fn cblas_zgeru_64(
     a: *mut Complex64,
     lda: i64,
 ) {
+    let _call = dispatch::enter(Routine::Zgeru, Some(order), [], [m, n], [incx, incy, lda]);
     let p = get_zgeru_for_ilp64_cblas();
     if matches!(p, ZgeruProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -504,6 +553,7 @@ pub unsafe extern "C" fn cblas_cgerc(
     a: *mut Complex32,
     lda: i32,
 ) {
+    let _call = dispatch::enter(Routine::Cgerc, Some(order), [], [m, n], [incx, incy, lda]);
     let p = get_cgerc_for_lp64_cblas();
     match p {
         CgercProvider::Lp64(cgerc) => {
@@ -557,6 +607,7 @@ pub unsafe extern "C" fn cblas_cgerc_64(
     a: *mut Complex32,
     lda: i64,
 ) {
+    let _call = dispatch::enter(Routine::Cgerc, Some(order), [], [m, n], [incx, incy, lda]);
     let p = get_cgerc_for_ilp64_cblas();
     if matches!(p, CgercProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -627,6 +678,7 @@ pub unsafe extern "C" fn cblas_zgerc(
     a: *mut Complex64,
     lda: i32,
 ) {
+    let _call = dispatch::enter(Routine::Zgerc, Some(order), [], [m, n], [incx, incy, lda]);
     let p = get_zgerc_for_lp64_cblas();
     match p {
         ZgercProvider::Lp64(zgerc) => {
@@ -674,6 +726,7 @@ pub unsafe extern "C" fn cblas_zgerc_64(
     a: *mut Complex64,
     lda: i64,
 ) {
+    let _call = dispatch::enter(Routine::Zgerc, Some(order), [], [m, n], [incx, incy, lda]);
     let p = get_zgerc_for_ilp64_cblas();
     if matches!(p, ZgercProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
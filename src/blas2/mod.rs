@@ -3,6 +3,7 @@
 pub mod gbmv;
 pub mod gemv;
 pub mod ger;
+pub mod pack;
 pub mod sbmv;
 pub mod spmv;
 pub mod spr;
@@ -0,0 +1,491 @@
+//! Conversion between dense and packed or band storage
+//! (`cblas_inject_?pack_*`, `cblas_inject_?unpack_*`).
+//!
+//! These prepare the operands of the packed (`?tpmv`, `?spmv`, `?spr`, ...)
+//! and band (`?gbmv`, `?sbmv`, `?tbmv`, `?tbsv`) routines from a dense
+//! matrix, and turn them back. `a_order` is the layout of the dense matrix
+//! and `p_order` the layout of the compact storage, that is the `order`
+//! later passed to the BLAS call. Row-major compact storage is what the
+//! CBLAS wrappers hand to Fortran BLAS as the column-major transpose, with
+//! uplo flipped or `kl` and `ku` swapped. The two orders may differ, in
+//! which case the conversion transposes on the fly.
+//!
+//! - `_tp`: packed triangle of an `n x n` matrix (tp, sp and hp routines).
+//! - `_gb`: general band with `kl` sub- and `ku` superdiagonals (gbmv).
+//! - `_tb`: triangular band with `k` off-diagonals (tb, sb and hb routines).
+//!
+//! Always computed by the built-in kernels.
+
+use std::ffi::c_int;
+
+use num_complex::{Complex32, Complex64};
+
+use crate::native::pack::{self as native, Shape};
+use crate::native::Scalar;
+use crate::types::{CblasColMajor, CblasRowMajor, CblasUpper, CBLAS_ORDER, CBLAS_UPLO};
+use crate::xerbla::cblas_xerbla;
+
+fn report(param: c_int, routine: &[u8]) -> Option<(Shape, bool)> {
+    unsafe { cblas_xerbla(param, routine.as_ptr().cast(), std::ptr::null()) };
+    None
+}
+
+/// Column-major packed shape and whether the dense matrix is read across
+/// its rows, or `None` after reporting the first invalid argument through
+/// `xerbla`. `lda_param` is the position of `lda`.
+fn tp_shape(
+    routine: &[u8],
+    a_order: CBLAS_ORDER,
+    p_order: CBLAS_ORDER,
+    uplo: CBLAS_UPLO,
+    n: i64,
+    lda: i64,
+    lda_param: c_int,
+) -> Option<(Shape, bool)> {
+    if n < 0 {
+        return report(4, routine);
+    }
+    if lda < n.max(1) {
+        return report(lda_param, routine);
+    }
+    let n = n as usize;
+    let upper = (uplo == CblasUpper) != (p_order == CblasRowMajor);
+    let shape = if upper {
+        Shape::Upper { n }
+    } else {
+        Shape::Lower { n }
+    };
+    Some((shape, a_order != p_order))
+}
+
+/// As [`tp_shape`] for band storage. `params` are the positions of `m`,
+/// `n`, `kl`, `ku`, `lda` and `ldab`.
+#[allow(clippy::too_many_arguments)]
+fn gb_shape(
+    routine: &[u8],
+    a_order: CBLAS_ORDER,
+    p_order: CBLAS_ORDER,
+    m: i64,
+    n: i64,
+    kl: i64,
+    ku: i64,
+    lda: i64,
+    ldab: i64,
+    params: [c_int; 6],
+) -> Option<(Shape, bool)> {
+    let dense_rows = match a_order {
+        CblasColMajor => m,
+        CblasRowMajor => n,
+    };
+    let bad = [
+        m < 0,
+        n < 0,
+        kl < 0,
+        ku < 0,
+        lda < dense_rows.max(1),
+        ldab < kl.saturating_add(ku).saturating_add(1),
+    ];
+    if let Some(i) = bad.iter().position(|&b| b) {
+        return report(params[i], routine);
+    }
+    let [m, n, kl, ku, ldab] = [m, n, kl, ku, ldab].map(|v| v as usize);
+    let shape = match p_order {
+        CblasColMajor => Shape::Band { m, n, kl, ku, ldab },
+        CblasRowMajor => Shape::Band {
+            m: n,
+            n: m,
+            kl: ku,
+            ku: kl,
+            ldab,
+        },
+    };
+    Some((shape, a_order != p_order))
+}
+
+/// As [`gb_shape`] for the triangular band with `k` off-diagonals.
+/// `params` are the positions of `lda` and `ldab`.
+#[allow(clippy::too_many_arguments)]
+fn tb_shape(
+    routine: &[u8],
+    a_order: CBLAS_ORDER,
+    p_order: CBLAS_ORDER,
+    uplo: CBLAS_UPLO,
+    n: i64,
+    k: i64,
+    lda: i64,
+    ldab: i64,
+    params: [c_int; 2],
+) -> Option<(Shape, bool)> {
+    let (kl, ku) = if uplo == CblasUpper { (0, k) } else { (k, 0) };
+    let [lda_param, ldab_param] = params;
+    let params = [4, 4, 5, 5, lda_param, ldab_param];
+    gb_shape(routine, a_order, p_order, n, n, kl, ku, lda, ldab, params)
+}
+
+unsafe fn pack<T: Scalar>(shape: Option<(Shape, bool)>, a: *const T, lda: i64, p: *mut T) {
+    if let Some((shape, across)) = shape {
+        unsafe { native::pack(shape, across, a, lda as usize, p) };
+    }
+}
+
+unsafe fn unpack<T: Scalar>(shape: Option<(Shape, bool)>, p: *const T, a: *mut T, lda: i64) {
+    if let Some((shape, across)) = shape {
+        unsafe { native::unpack(shape, across, p, a, lda as usize) };
+    }
+}
+
+macro_rules! define_pack {
+    (
+        $t:ty,
+        $pack_tp:ident,
+        $pack_tp_64:ident,
+        $unpack_tp:ident,
+        $unpack_tp_64:ident,
+        $pack_gb:ident,
+        $pack_gb_64:ident,
+        $unpack_gb:ident,
+        $unpack_gb_64:ident,
+        $pack_tb:ident,
+        $pack_tb_64:ident,
+        $unpack_tb:ident,
+        $unpack_tb_64:ident
+    ) => {
+        /// Pack the uplo triangle of the dense `n x n` A into `ap`, laid out
+        /// for a packed routine called with `p_order`.
+        ///
+        /// # Safety
+        ///
+        /// - `a` must hold the matrix under `a_order` and `lda`
+        /// - `ap` must hold n*(n+1)/2 elements and not overlap `a`
+        #[no_mangle]
+        pub unsafe extern "C" fn $pack_tp(
+            a_order: CBLAS_ORDER,
+            p_order: CBLAS_ORDER,
+            uplo: CBLAS_UPLO,
+            n: i32,
+            a: *const $t,
+            lda: i32,
+            ap: *mut $t,
+        ) {
+            let routine = concat!(stringify!($pack_tp), "\0").as_bytes();
+            let [n, lda] = [n, lda].map(i64::from);
+            let shape = tp_shape(routine, a_order, p_order, uplo, n, lda, 6);
+            pack(shape, a, lda, ap);
+        }
+
+        /// Pack a triangle into packed storage with ILP64 integer ABI.
+        #[no_mangle]
+        pub unsafe extern "C" fn $pack_tp_64(
+            a_order: CBLAS_ORDER,
+            p_order: CBLAS_ORDER,
+            uplo: CBLAS_UPLO,
+            n: i64,
+            a: *const $t,
+            lda: i64,
+            ap: *mut $t,
+        ) {
+            let routine = concat!(stringify!($pack_tp_64), "\0").as_bytes();
+            let shape = tp_shape(routine, a_order, p_order, uplo, n, lda, 6);
+            pack(shape, a, lda, ap);
+        }
+
+        /// Unpack `ap`, laid out for a packed routine called with `p_order`,
+        /// into the uplo triangle of the dense `n x n` A. The other triangle
+        /// is not written.
+        ///
+        /// # Safety
+        ///
+        /// - `ap` must hold n*(n+1)/2 elements and not overlap `a`
+        /// - `a` must hold the matrix under `a_order` and `lda`
+        #[no_mangle]
+        pub unsafe extern "C" fn $unpack_tp(
+            a_order: CBLAS_ORDER,
+            p_order: CBLAS_ORDER,
+            uplo: CBLAS_UPLO,
+            n: i32,
+            ap: *const $t,
+            a: *mut $t,
+            lda: i32,
+        ) {
+            let routine = concat!(stringify!($unpack_tp), "\0").as_bytes();
+            let [n, lda] = [n, lda].map(i64::from);
+            let shape = tp_shape(routine, a_order, p_order, uplo, n, lda, 7);
+            unpack(shape, ap, a, lda);
+        }
+
+        /// Unpack packed storage into a triangle with ILP64 integer ABI.
+        #[no_mangle]
+        pub unsafe extern "C" fn $unpack_tp_64(
+            a_order: CBLAS_ORDER,
+            p_order: CBLAS_ORDER,
+            uplo: CBLAS_UPLO,
+            n: i64,
+            ap: *const $t,
+            a: *mut $t,
+            lda: i64,
+        ) {
+            let routine = concat!(stringify!($unpack_tp_64), "\0").as_bytes();
+            let shape = tp_shape(routine, a_order, p_order, uplo, n, lda, 7);
+            unpack(shape, ap, a, lda);
+        }
+
+        /// Pack the `kl` sub- and `ku` superdiagonals of the dense `m x n` A
+        /// into `ab`, laid out for `?gbmv` called with `p_order`. The
+        /// unused corners of `ab` are not written.
+        ///
+        /// # Safety
+        ///
+        /// - `a` must hold the matrix under `a_order` and `lda`
+        /// - `ab` must hold the band under `p_order` and `ldab` and not
+        ///   overlap `a`
+        #[no_mangle]
+        #[allow(clippy::too_many_arguments)]
+        pub unsafe extern "C" fn $pack_gb(
+            a_order: CBLAS_ORDER,
+            p_order: CBLAS_ORDER,
+            m: i32,
+            n: i32,
+            kl: i32,
+            ku: i32,
+            a: *const $t,
+            lda: i32,
+            ab: *mut $t,
+            ldab: i32,
+        ) {
+            let routine = concat!(stringify!($pack_gb), "\0").as_bytes();
+            let [m, n, kl, ku, lda, ldab] = [m, n, kl, ku, lda, ldab].map(i64::from);
+            let params = [3, 4, 5, 6, 8, 10];
+            let shape = gb_shape(routine, a_order, p_order, m, n, kl, ku, lda, ldab, params);
+            pack(shape, a, lda, ab);
+        }
+
+        /// Pack a general band with ILP64 integer ABI.
+        #[no_mangle]
+        #[allow(clippy::too_many_arguments)]
+        pub unsafe extern "C" fn $pack_gb_64(
+            a_order: CBLAS_ORDER,
+            p_order: CBLAS_ORDER,
+            m: i64,
+            n: i64,
+            kl: i64,
+            ku: i64,
+            a: *const $t,
+            lda: i64,
+            ab: *mut $t,
+            ldab: i64,
+        ) {
+            let routine = concat!(stringify!($pack_gb_64), "\0").as_bytes();
+            let params = [3, 4, 5, 6, 8, 10];
+            let shape = gb_shape(routine, a_order, p_order, m, n, kl, ku, lda, ldab, params);
+            pack(shape, a, lda, ab);
+        }
+
+        /// Unpack the band `ab`, laid out for `?gbmv` called with `p_order`,
+        /// into the dense `m x n` A, zeroing the elements outside the band.
+        ///
+        /// # Safety
+        ///
+        /// - `ab` must hold the band under `p_order` and `ldab` and not
+        ///   overlap `a`
+        /// - `a` must hold the matrix under `a_order` and `lda`
+        #[no_mangle]
+        #[allow(clippy::too_many_arguments)]
+        pub unsafe extern "C" fn $unpack_gb(
+            a_order: CBLAS_ORDER,
+            p_order: CBLAS_ORDER,
+            m: i32,
+            n: i32,
+            kl: i32,
+            ku: i32,
+            ab: *const $t,
+            ldab: i32,
+            a: *mut $t,
+            lda: i32,
+        ) {
+            let routine = concat!(stringify!($unpack_gb), "\0").as_bytes();
+            let [m, n, kl, ku, ldab, lda] = [m, n, kl, ku, ldab, lda].map(i64::from);
+            let params = [3, 4, 5, 6, 10, 8];
+            let shape = gb_shape(routine, a_order, p_order, m, n, kl, ku, lda, ldab, params);
+            unpack(shape, ab, a, lda);
+        }
+
+        /// Unpack a general band with ILP64 integer ABI.
+        #[no_mangle]
+        #[allow(clippy::too_many_arguments)]
+        pub unsafe extern "C" fn $unpack_gb_64(
+            a_order: CBLAS_ORDER,
+            p_order: CBLAS_ORDER,
+            m: i64,
+            n: i64,
+            kl: i64,
+            ku: i64,
+            ab: *const $t,
+            ldab: i64,
+            a: *mut $t,
+            lda: i64,
+        ) {
+            let routine = concat!(stringify!($unpack_gb_64), "\0").as_bytes();
+            let params = [3, 4, 5, 6, 10, 8];
+            let shape = gb_shape(routine, a_order, p_order, m, n, kl, ku, lda, ldab, params);
+            unpack(shape, ab, a, lda);
+        }
+
+        /// Pack the diagonal and the `k` off-diagonals of the uplo triangle
+        /// of the dense `n x n` A into `ab`, laid out for `?tbmv`, `?tbsv`
+        /// and `?sbmv` / `?hbmv` called with `p_order`.
+        ///
+        /// # Safety
+        ///
+        /// - `a` must hold the matrix under `a_order` and `lda`
+        /// - `ab` must hold the band under `p_order` and `ldab` and not
+        ///   overlap `a`
+        #[no_mangle]
+        #[allow(clippy::too_many_arguments)]
+        pub unsafe extern "C" fn $pack_tb(
+            a_order: CBLAS_ORDER,
+            p_order: CBLAS_ORDER,
+            uplo: CBLAS_UPLO,
+            n: i32,
+            k: i32,
+            a: *const $t,
+            lda: i32,
+            ab: *mut $t,
+            ldab: i32,
+        ) {
+            let routine = concat!(stringify!($pack_tb), "\0").as_bytes();
+            let [n, k, lda, ldab] = [n, k, lda, ldab].map(i64::from);
+            let shape = tb_shape(routine, a_order, p_order, uplo, n, k, lda, ldab, [7, 9]);
+            pack(shape, a, lda, ab);
+        }
+
+        /// Pack a triangular band with ILP64 integer ABI.
+        #[no_mangle]
+        #[allow(clippy::too_many_arguments)]
+        pub unsafe extern "C" fn $pack_tb_64(
+            a_order: CBLAS_ORDER,
+            p_order: CBLAS_ORDER,
+            uplo: CBLAS_UPLO,
+            n: i64,
+            k: i64,
+            a: *const $t,
+            lda: i64,
+            ab: *mut $t,
+            ldab: i64,
+        ) {
+            let routine = concat!(stringify!($pack_tb_64), "\0").as_bytes();
+            let shape = tb_shape(routine, a_order, p_order, uplo, n, k, lda, ldab, [7, 9]);
+            pack(shape, a, lda, ab);
+        }
+
+        /// Unpack the triangular band `ab`, laid out for `?tbmv` called with
+        /// `p_order`, into the dense `n x n` A. Every element outside the
+        /// band is zeroed, the other triangle included.
+        ///
+        /// # Safety
+        ///
+        /// - `ab` must hold the band under `p_order` and `ldab` and not
+        ///   overlap `a`
+        /// - `a` must hold the matrix under `a_order` and `lda`
+        #[no_mangle]
+        #[allow(clippy::too_many_arguments)]
+        pub unsafe extern "C" fn $unpack_tb(
+            a_order: CBLAS_ORDER,
+            p_order: CBLAS_ORDER,
+            uplo: CBLAS_UPLO,
+            n: i32,
+            k: i32,
+            ab: *const $t,
+            ldab: i32,
+            a: *mut $t,
+            lda: i32,
+        ) {
+            let routine = concat!(stringify!($unpack_tb), "\0").as_bytes();
+            let [n, k, ldab, lda] = [n, k, ldab, lda].map(i64::from);
+            let shape = tb_shape(routine, a_order, p_order, uplo, n, k, lda, ldab, [9, 7]);
+            unpack(shape, ab, a, lda);
+        }
+
+        /// Unpack a triangular band with ILP64 integer ABI.
+        #[no_mangle]
+        #[allow(clippy::too_many_arguments)]
+        pub unsafe extern "C" fn $unpack_tb_64(
+            a_order: CBLAS_ORDER,
+            p_order: CBLAS_ORDER,
+            uplo: CBLAS_UPLO,
+            n: i64,
+            k: i64,
+            ab: *const $t,
+            ldab: i64,
+            a: *mut $t,
+            lda: i64,
+        ) {
+            let routine = concat!(stringify!($unpack_tb_64), "\0").as_bytes();
+            let shape = tb_shape(routine, a_order, p_order, uplo, n, k, lda, ldab, [9, 7]);
+            unpack(shape, ab, a, lda);
+        }
+    };
+}
+
+define_pack!(
+    f32,
+    cblas_inject_spack_tp,
+    cblas_inject_spack_tp_64,
+    cblas_inject_sunpack_tp,
+    cblas_inject_sunpack_tp_64,
+    cblas_inject_spack_gb,
+    cblas_inject_spack_gb_64,
+    cblas_inject_sunpack_gb,
+    cblas_inject_sunpack_gb_64,
+    cblas_inject_spack_tb,
+    cblas_inject_spack_tb_64,
+    cblas_inject_sunpack_tb,
+    cblas_inject_sunpack_tb_64
+);
+
+define_pack!(
+    f64,
+    cblas_inject_dpack_tp,
+    cblas_inject_dpack_tp_64,
+    cblas_inject_dunpack_tp,
+    cblas_inject_dunpack_tp_64,
+    cblas_inject_dpack_gb,
+    cblas_inject_dpack_gb_64,
+    cblas_inject_dunpack_gb,
+    cblas_inject_dunpack_gb_64,
+    cblas_inject_dpack_tb,
+    cblas_inject_dpack_tb_64,
+    cblas_inject_dunpack_tb,
+    cblas_inject_dunpack_tb_64
+);
+
+define_pack!(
+    Complex32,
+    cblas_inject_cpack_tp,
+    cblas_inject_cpack_tp_64,
+    cblas_inject_cunpack_tp,
+    cblas_inject_cunpack_tp_64,
+    cblas_inject_cpack_gb,
+    cblas_inject_cpack_gb_64,
+    cblas_inject_cunpack_gb,
+    cblas_inject_cunpack_gb_64,
+    cblas_inject_cpack_tb,
+    cblas_inject_cpack_tb_64,
+    cblas_inject_cunpack_tb,
+    cblas_inject_cunpack_tb_64
+);
+
+define_pack!(
+    Complex64,
+    cblas_inject_zpack_tp,
+    cblas_inject_zpack_tp_64,
+    cblas_inject_zunpack_tp,
+    cblas_inject_zunpack_tp_64,
+    cblas_inject_zpack_gb,
+    cblas_inject_zpack_gb_64,
+    cblas_inject_zunpack_gb,
+    cblas_inject_zunpack_gb_64,
+    cblas_inject_zpack_tb,
+    cblas_inject_zpack_tb_64,
+    cblas_inject_zunpack_tb,
+    cblas_inject_zunpack_tb_64
+);
@@ -16,6 +16,10 @@ use crate::backend::{
     get_zhbmv_for_ilp64_cblas, get_zhbmv_for_lp64_cblas, ChbmvProvider, DsbmvProvider,
     SsbmvProvider, ZhbmvProvider,
 };
+use crate::dispatch;
+use crate::native::conj;
+use crate::scratch;
+use crate::stats::Routine;
 use crate::types::{
     uplo_to_char, CblasColMajor, CblasLower, CblasRowMajor, CblasUpper, CBLAS_ORDER, CBLAS_UPLO,
 };
@@ -46,6 +50,13 @@ pub unsafe extern "C" fn cblas_ssbmv(
     y: *mut f32,
     incy: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ssbmv,
+        Some(order),
+        [uplo as u8],
+        [n, k],
+        [lda, incx, incy],
+    );
     let p = get_ssbmv_for_lp64_cblas();
     match p {
         SsbmvProvider::Lp64(ssbmv) => {
@@ -117,6 +128,13 @@ pub unsafe extern "C" fn cblas_ssbmv_64(
     y: *mut f32,
     incy: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ssbmv,
+        Some(order),
+        [uplo as u8],
+        [n, k],
+        [lda, incx, incy],
+    );
     let p = get_ssbmv_for_ilp64_cblas();
     if matches!(p, SsbmvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -208,6 +226,13 @@ pub unsafe extern "C" fn cblas_dsbmv(
     y: *mut f64,
     incy: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Dsbmv,
+        Some(order),
+        [uplo as u8],
+        [n, k],
+        [lda, incx, incy],
+    );
     let p = get_dsbmv_for_lp64_cblas();
     match p {
         DsbmvProvider::Lp64(dsbmv) => {
@@ -277,6 +302,13 @@ pub unsafe extern "C" fn cblas_dsbmv_64(
     y: *mut f64,
     incy: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Dsbmv,
+        Some(order),
+        [uplo as u8],
+        [n, k],
+        [lda, incx, incy],
+    );
     let p = get_dsbmv_for_ilp64_cblas();
     if matches!(p, DsbmvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -373,6 +405,13 @@ pub unsafe extern "C" fn cblas_chbmv(
     y: *mut Complex32,
     incy: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Chbmv,
+        Some(order),
+        [uplo as u8],
+        [n, k],
+        [lda, incx, incy],
+    );
     let p = get_chbmv_for_lp64_cblas();
     match p {
         ChbmvProvider::Lp64(chbmv) => {
@@ -399,31 +438,16 @@ pub unsafe extern "C" fn cblas_chbmv(
                     // For row-major Hermitian operations, we need to conjugate input x
                     // and conjugate output y before and after the operation
                     if n > 0 {
-                        // Conjugate y (in-place before operation)
-                        let abs_incy = if incy < 0 { -incy } else { incy };
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex32::new(val.re, -val.im);
-                        }
-
-                        // Create conjugated copy of x
-                        let abs_incx = if incx < 0 { -incx } else { incx };
-                        let mut x_conj = vec![Complex32::new(0.0, 0.0); n as usize];
-                        for i in 0..n {
-                            let idx = if incx < 0 {
-                                ((n - 1 - i) * abs_incx) as isize
-                            } else {
-                                (i * abs_incx) as isize
-                            };
-                            let val = *x.offset(idx);
-                            x_conj[i as usize] = Complex32::new(val.re, -val.im);
-                        }
+                        // Conjugate y in place and take a conjugated copy of x in one pass
+                        let mut x_conj = scratch::take::<Complex32>(n as usize);
+                        conj::conj_copy_and_conj(
+                            i64::from(n),
+                            x,
+                            i64::from(incx),
+                            &mut x_conj,
+                            y,
+                            i64::from(incy),
+                        );
 
                         // Call Fortran HBMV with conjugated values
                         chbmv(
@@ -441,16 +465,7 @@ pub unsafe extern "C" fn cblas_chbmv(
                         );
 
                         // Conjugate y (in-place after operation)
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex32::new(val.re, -val.im);
-                        }
+                        conj::conj_in_place(i64::from(n), y, i64::from(incy));
                     }
                 }
             }
@@ -485,31 +500,9 @@ pub unsafe extern "C" fn cblas_chbmv(
                     // For row-major Hermitian operations, we need to conjugate input x
                     // and conjugate output y before and after the operation
                     if n > 0 {
-                        // Conjugate y (in-place before operation)
-                        let abs_incy = if incy < 0 { -incy } else { incy };
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex32::new(val.re, -val.im);
-                        }
-
-                        // Create conjugated copy of x
-                        let abs_incx = if incx < 0 { -incx } else { incx };
-                        let mut x_conj = vec![Complex32::new(0.0, 0.0); n as usize];
-                        for i in 0..n {
-                            let idx = if incx < 0 {
-                                ((n - 1 - i) * abs_incx) as isize
-                            } else {
-                                (i * abs_incx) as isize
-                            };
-                            let val = *x.offset(idx);
-                            x_conj[i as usize] = Complex32::new(val.re, -val.im);
-                        }
+                        // Conjugate y in place and take a conjugated copy of x in one pass
+                        let mut x_conj = scratch::take::<Complex32>(n as usize);
+                        conj::conj_copy_and_conj(n, x, incx, &mut x_conj, y, incy);
 
                         // Call Fortran HBMV with conjugated values
                         chbmv(
@@ -527,16 +520,7 @@ pub unsafe extern "C" fn cblas_chbmv(
                         );
 
                         // Conjugate y (in-place after operation)
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex32::new(val.re, -val.im);
-                        }
+                        conj::conj_in_place(n, y, incy);
                     }
                 }
             }
@@ -560,6 +544,13 @@ pub unsafe extern "C" fn cblas_chbmv_64(
     y: *mut Complex32,
     incy: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Chbmv,
+        Some(order),
+        [uplo as u8],
+        [n, k],
+        [lda, incx, incy],
+    );
     let p = get_chbmv_for_ilp64_cblas();
     if matches!(p, ChbmvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -596,31 +587,9 @@ pub unsafe extern "C" fn cblas_chbmv_64(
                     // For row-major Hermitian operations, we need to conjugate input x
                     // and conjugate output y before and after the operation
                     if n > 0 {
-                        // Conjugate y (in-place before operation)
-                        let abs_incy = if incy < 0 { -incy } else { incy };
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex32::new(val.re, -val.im);
-                        }
-
-                        // Create conjugated copy of x
-                        let abs_incx = if incx < 0 { -incx } else { incx };
-                        let mut x_conj = vec![Complex32::new(0.0, 0.0); n as usize];
-                        for i in 0..n {
-                            let idx = if incx < 0 {
-                                ((n - 1 - i) * abs_incx) as isize
-                            } else {
-                                (i * abs_incx) as isize
-                            };
-                            let val = *x.offset(idx);
-                            x_conj[i as usize] = Complex32::new(val.re, -val.im);
-                        }
+                        // Conjugate y in place and take a conjugated copy of x in one pass
+                        let mut x_conj = scratch::take::<Complex32>(n as usize);
+                        conj::conj_copy_and_conj(n, x, incx, &mut x_conj, y, incy);
 
                         // Call Fortran HBMV with conjugated values
                         chbmv(
@@ -638,16 +607,7 @@ pub unsafe extern "C" fn cblas_chbmv_64(
                         );
 
                         // Conjugate y (in-place after operation)
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex32::new(val.re, -val.im);
-                        }
+                        conj::conj_in_place(n, y, incy);
                     }
                 }
             }
@@ -682,31 +642,16 @@ pub unsafe extern "C" fn cblas_chbmv_64(
                     // For row-major Hermitian operations, we need to conjugate input x
                     // and conjugate output y before and after the operation
                     if n > 0 {
-                        // Conjugate y (in-place before operation)
-                        let abs_incy = if incy < 0 { -incy } else { incy };
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex32::new(val.re, -val.im);
-                        }
-
-                        // Create conjugated copy of x
-                        let abs_incx = if incx < 0 { -incx } else { incx };
-                        let mut x_conj = vec![Complex32::new(0.0, 0.0); n as usize];
-                        for i in 0..n {
-                            let idx = if incx < 0 {
-                                ((n - 1 - i) * abs_incx) as isize
-                            } else {
-                                (i * abs_incx) as isize
-                            };
-                            let val = *x.offset(idx);
-                            x_conj[i as usize] = Complex32::new(val.re, -val.im);
-                        }
+                        // Conjugate y in place and take a conjugated copy of x in one pass
+                        let mut x_conj = scratch::take::<Complex32>(n as usize);
+                        conj::conj_copy_and_conj(
+                            i64::from(n),
+                            x,
+                            i64::from(incx),
+                            &mut x_conj,
+                            y,
+                            i64::from(incy),
+                        );
 
                         // Call Fortran HBMV with conjugated values
                         chbmv(
@@ -724,16 +669,7 @@ pub unsafe extern "C" fn cblas_chbmv_64(
                         );
 
                         // Conjugate y (in-place after operation)
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex32::new(val.re, -val.im);
-                        }
+                        conj::conj_in_place(i64::from(n), y, i64::from(incy));
                     }
                 }
             }
@@ -774,6 +710,13 @@ pub unsafe extern "C" fn cblas_zhbmv(
     y: *mut Complex64,
     incy: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Zhbmv,
+        Some(order),
+        [uplo as u8],
+        [n, k],
+        [lda, incx, incy],
+    );
     let p = get_zhbmv_for_lp64_cblas();
     match p {
         ZhbmvProvider::Lp64(zhbmv) => {
@@ -800,31 +743,16 @@ pub unsafe extern "C" fn cblas_zhbmv(
                     // For row-major Hermitian operations, we need to conjugate input x
                     // and conjugate output y before and after the operation
                     if n > 0 {
-                        // Conjugate y (in-place before operation)
-                        let abs_incy = if incy < 0 { -incy } else { incy };
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex64::new(val.re, -val.im);
-                        }
-
-                        // Create conjugated copy of x
-                        let abs_incx = if incx < 0 { -incx } else { incx };
-                        let mut x_conj = vec![Complex64::new(0.0, 0.0); n as usize];
-                        for i in 0..n {
-                            let idx = if incx < 0 {
-                                ((n - 1 - i) * abs_incx) as isize
-                            } else {
-                                (i * abs_incx) as isize
-                            };
-                            let val = *x.offset(idx);
-                            x_conj[i as usize] = Complex64::new(val.re, -val.im);
-                        }
+                        // Conjugate y in place and take a conjugated copy of x in one pass
+                        let mut x_conj = scratch::take::<Complex64>(n as usize);
+                        conj::conj_copy_and_conj(
+                            i64::from(n),
+                            x,
+                            i64::from(incx),
+                            &mut x_conj,
+                            y,
+                            i64::from(incy),
+                        );
 
                         // Call Fortran HBMV with conjugated values
                         zhbmv(
@@ -842,16 +770,7 @@ pub unsafe extern "C" fn cblas_zhbmv(
                         );
 
                         // Conjugate y (in-place after operation)
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex64::new(val.re, -val.im);
-                        }
+                        conj::conj_in_place(i64::from(n), y, i64::from(incy));
                     }
                 }
             }
@@ -886,31 +805,9 @@ pub unsafe extern "C" fn cblas_zhbmv(
                     // For row-major Hermitian operations, we need to conjugate input x
                     // and conjugate output y before and after the operation
                     if n > 0 {
-                        // Conjugate y (in-place before operation)
-                        let abs_incy = if incy < 0 { -incy } else { incy };
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex64::new(val.re, -val.im);
-                        }
-
-                        // Create conjugated copy of x
-                        let abs_incx = if incx < 0 { -incx } else { incx };
-                        let mut x_conj = vec![Complex64::new(0.0, 0.0); n as usize];
-                        for i in 0..n {
-                            let idx = if incx < 0 {
-                                ((n - 1 - i) * abs_incx) as isize
-                            } else {
-                                (i * abs_incx) as isize
-                            };
-                            let val = *x.offset(idx);
-                            x_conj[i as usize] = Complex64::new(val.re, -val.im);
-                        }
+                        // Conjugate y in place and take a conjugated copy of x in one pass
+                        let mut x_conj = scratch::take::<Complex64>(n as usize);
+                        conj::conj_copy_and_conj(n, x, incx, &mut x_conj, y, incy);
 
                         // Call Fortran HBMV with conjugated values
                         zhbmv(
@@ -928,16 +825,7 @@ pub unsafe extern "C" fn cblas_zhbmv(
                         );
 
                         // Conjugate y (in-place after operation)
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex64::new(val.re, -val.im);
-                        }
+                        conj::conj_in_place(n, y, incy);
                     }
                 }
             }
@@ -961,6 +849,13 @@ pub unsafe extern "C" fn cblas_zhbmv_64(
     y: *mut Complex64,
     incy: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Zhbmv,
+        Some(order),
+        [uplo as u8],
+        [n, k],
+        [lda, incx, incy],
+    );
     let p = get_zhbmv_for_ilp64_cblas();
     if matches!(p, ZhbmvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -997,31 +892,9 @@ pub unsafe extern "C" fn cblas_zhbmv_64(
                     // For row-major Hermitian operations, we need to conjugate input x
                     // and conjugate output y before and after the operation
                     if n > 0 {
-                        // Conjugate y (in-place before operation)
-                        let abs_incy = if incy < 0 { -incy } else { incy };
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex64::new(val.re, -val.im);
-                        }
-
-                        // Create conjugated copy of x
-                        let abs_incx = if incx < 0 { -incx } else { incx };
-                        let mut x_conj = vec![Complex64::new(0.0, 0.0); n as usize];
-                        for i in 0..n {
-                            let idx = if incx < 0 {
-                                ((n - 1 - i) * abs_incx) as isize
-                            } else {
-                                (i * abs_incx) as isize
-                            };
-                            let val = *x.offset(idx);
-                            x_conj[i as usize] = Complex64::new(val.re, -val.im);
-                        }
+                        // Conjugate y in place and take a conjugated copy of x in one pass
+                        let mut x_conj = scratch::take::<Complex64>(n as usize);
+                        conj::conj_copy_and_conj(n, x, incx, &mut x_conj, y, incy);
 
                         // Call Fortran HBMV with conjugated values
                         zhbmv(
@@ -1039,16 +912,7 @@ pub unsafe extern "C" fn cblas_zhbmv_64(
                         );
 
                         // Conjugate y (in-place after operation)
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex64::new(val.re, -val.im);
-                        }
+                        conj::conj_in_place(n, y, incy);
                     }
                 }
             }
@@ -1083,31 +947,16 @@ pub unsafe extern "C" fn cblas_zhbmv_64(
                     // For row-major Hermitian operations, we need to conjugate input x
                     // and conjugate output y before and after the operation
                     if n > 0 {
-                        // Conjugate y (in-place before operation)
-                        let abs_incy = if incy < 0 { -incy } else { incy };
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex64::new(val.re, -val.im);
-                        }
-
-                        // Create conjugated copy of x
-                        let abs_incx = if incx < 0 { -incx } else { incx };
-                        let mut x_conj = vec![Complex64::new(0.0, 0.0); n as usize];
-                        for i in 0..n {
-                            let idx = if incx < 0 {
-                                ((n - 1 - i) * abs_incx) as isize
-                            } else {
-                                (i * abs_incx) as isize
-                            };
-                            let val = *x.offset(idx);
-                            x_conj[i as usize] = Complex64::new(val.re, -val.im);
-                        }
+                        // Conjugate y in place and take a conjugated copy of x in one pass
+                        let mut x_conj = scratch::take::<Complex64>(n as usize);
+                        conj::conj_copy_and_conj(
+                            i64::from(n),
+                            x,
+                            i64::from(incx),
+                            &mut x_conj,
+                            y,
+                            i64::from(incy),
+                        );
 
                         // Call Fortran HBMV with conjugated values
                         zhbmv(
@@ -1125,16 +974,7 @@ pub unsafe extern "C" fn cblas_zhbmv_64(
                         );
 
                         // Conjugate y (in-place after operation)
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex64::new(val.re, -val.im);
-                        }
+                        conj::conj_in_place(i64::from(n), y, i64::from(incy));
                     }
                 }
             }
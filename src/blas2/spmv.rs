@@ -16,6 +16,10 @@ use crate::backend::{
     get_zhpmv_for_ilp64_cblas, get_zhpmv_for_lp64_cblas, ChpmvProvider, DspmvProvider,
     SspmvProvider, ZhpmvProvider,
 };
+use crate::dispatch;
+use crate::native::conj;
+use crate::scratch;
+use crate::stats::Routine;
 use crate::types::{
     uplo_to_char, CblasColMajor, CblasLower, CblasRowMajor, CblasUpper, CBLAS_ORDER, CBLAS_UPLO,
 };
@@ -44,6 +48,7 @@ pub unsafe extern "C" fn cblas_sspmv(
     y: *mut f32,
     incy: i32,
 ) {
+    let _call = dispatch::enter(Routine::Sspmv, Some(order), [uplo as u8], [n], [incx, incy]);
     let p = get_sspmv_for_lp64_cblas();
     match p {
         SspmvProvider::Lp64(sspmv) => {
@@ -101,6 +106,7 @@ pub unsafe extern "C" fn cblas_sspmv_64(
     y: *mut f32,
     incy: i64,
 ) {
+    let _call = dispatch::enter(Routine::Sspmv, Some(order), [uplo as u8], [n], [incx, incy]);
     let p = get_sspmv_for_ilp64_cblas();
     if matches!(p, SspmvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -178,6 +184,7 @@ pub unsafe extern "C" fn cblas_dspmv(
     y: *mut f64,
     incy: i32,
 ) {
+    let _call = dispatch::enter(Routine::Dspmv, Some(order), [uplo as u8], [n], [incx, incy]);
     let p = get_dspmv_for_lp64_cblas();
     match p {
         DspmvProvider::Lp64(dspmv) => {
@@ -235,6 +242,7 @@ pub unsafe extern "C" fn cblas_dspmv_64(
     y: *mut f64,
     incy: i64,
 ) {
+    let _call = dispatch::enter(Routine::Dspmv, Some(order), [uplo as u8], [n], [incx, incy]);
     let p = get_dspmv_for_ilp64_cblas();
     if matches!(p, DspmvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -312,6 +320,7 @@ pub unsafe extern "C" fn cblas_chpmv(
     y: *mut Complex32,
     incy: i32,
 ) {
+    let _call = dispatch::enter(Routine::Chpmv, Some(order), [uplo as u8], [n], [incx, incy]);
     let p = get_chpmv_for_lp64_cblas();
     match p {
         ChpmvProvider::Lp64(chpmv) => {
@@ -335,31 +344,16 @@ pub unsafe extern "C" fn cblas_chpmv(
                     let conj_beta = Complex32::new(beta_val.re, -beta_val.im);
 
                     if n > 0 {
-                        // Conjugate y (in-place before operation)
-                        let abs_incy = if incy < 0 { -incy } else { incy };
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex32::new(val.re, -val.im);
-                        }
-
-                        // Create conjugated copy of x
-                        let abs_incx = if incx < 0 { -incx } else { incx };
-                        let mut x_conj = vec![Complex32::new(0.0, 0.0); n as usize];
-                        for i in 0..n {
-                            let idx = if incx < 0 {
-                                ((n - 1 - i) * abs_incx) as isize
-                            } else {
-                                (i * abs_incx) as isize
-                            };
-                            let val = *x.offset(idx);
-                            x_conj[i as usize] = Complex32::new(val.re, -val.im);
-                        }
+                        // Conjugate y in place and take a conjugated copy of x in one pass
+                        let mut x_conj = scratch::take::<Complex32>(n as usize);
+                        conj::conj_copy_and_conj(
+                            i64::from(n),
+                            x,
+                            i64::from(incx),
+                            &mut x_conj,
+                            y,
+                            i64::from(incy),
+                        );
 
                         // Call Fortran HPMV with conjugated values
                         chpmv(
@@ -375,16 +369,7 @@ pub unsafe extern "C" fn cblas_chpmv(
                         );
 
                         // Conjugate y (in-place after operation)
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex32::new(val.re, -val.im);
-                        }
+                        conj::conj_in_place(i64::from(n), y, i64::from(incy));
                     }
                 }
             }
@@ -414,31 +399,9 @@ pub unsafe extern "C" fn cblas_chpmv(
                     let conj_beta = Complex32::new(beta_val.re, -beta_val.im);
 
                     if n > 0 {
-                        // Conjugate y (in-place before operation)
-                        let abs_incy = if incy < 0 { -incy } else { incy };
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex32::new(val.re, -val.im);
-                        }
-
-                        // Create conjugated copy of x
-                        let abs_incx = if incx < 0 { -incx } else { incx };
-                        let mut x_conj = vec![Complex32::new(0.0, 0.0); n as usize];
-                        for i in 0..n {
-                            let idx = if incx < 0 {
-                                ((n - 1 - i) * abs_incx) as isize
-                            } else {
-                                (i * abs_incx) as isize
-                            };
-                            let val = *x.offset(idx);
-                            x_conj[i as usize] = Complex32::new(val.re, -val.im);
-                        }
+                        // Conjugate y in place and take a conjugated copy of x in one pass
+                        let mut x_conj = scratch::take::<Complex32>(n as usize);
+                        conj::conj_copy_and_conj(n, x, incx, &mut x_conj, y, incy);
 
                         // Call Fortran HPMV with conjugated values
                         chpmv(
@@ -454,16 +417,7 @@ pub unsafe extern "C" fn cblas_chpmv(
                         );
 
                         // Conjugate y (in-place after operation)
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex32::new(val.re, -val.im);
-                        }
+                        conj::conj_in_place(n, y, incy);
                     }
                 }
             }
@@ -485,6 +439,7 @@ pub unsafe extern "C" fn cblas_chpmv_64(
     y: *mut Complex32,
     incy: i64,
 ) {
+    let _call = dispatch::enter(Routine::Chpmv, Some(order), [uplo as u8], [n], [incx, incy]);
     let p = get_chpmv_for_ilp64_cblas();
     if matches!(p, ChpmvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -518,31 +473,9 @@ pub unsafe extern "C" fn cblas_chpmv_64(
                     let conj_beta = Complex32::new(beta_val.re, -beta_val.im);
 
                     if n > 0 {
-                        // Conjugate y (in-place before operation)
-                        let abs_incy = if incy < 0 { -incy } else { incy };
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex32::new(val.re, -val.im);
-                        }
-
-                        // Create conjugated copy of x
-                        let abs_incx = if incx < 0 { -incx } else { incx };
-                        let mut x_conj = vec![Complex32::new(0.0, 0.0); n as usize];
-                        for i in 0..n {
-                            let idx = if incx < 0 {
-                                ((n - 1 - i) * abs_incx) as isize
-                            } else {
-                                (i * abs_incx) as isize
-                            };
-                            let val = *x.offset(idx);
-                            x_conj[i as usize] = Complex32::new(val.re, -val.im);
-                        }
+                        // Conjugate y in place and take a conjugated copy of x in one pass
+                        let mut x_conj = scratch::take::<Complex32>(n as usize);
+                        conj::conj_copy_and_conj(n, x, incx, &mut x_conj, y, incy);
 
                         // Call Fortran HPMV with conjugated values
                         chpmv(
@@ -558,16 +491,7 @@ pub unsafe extern "C" fn cblas_chpmv_64(
                         );
 
                         // Conjugate y (in-place after operation)
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex32::new(val.re, -val.im);
-                        }
+                        conj::conj_in_place(n, y, incy);
                     }
                 }
             }
@@ -597,31 +521,16 @@ pub unsafe extern "C" fn cblas_chpmv_64(
                     let conj_beta = Complex32::new(beta_val.re, -beta_val.im);
 
                     if n > 0 {
-                        // Conjugate y (in-place before operation)
-                        let abs_incy = if incy < 0 { -incy } else { incy };
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex32::new(val.re, -val.im);
-                        }
-
-                        // Create conjugated copy of x
-                        let abs_incx = if incx < 0 { -incx } else { incx };
-                        let mut x_conj = vec![Complex32::new(0.0, 0.0); n as usize];
-                        for i in 0..n {
-                            let idx = if incx < 0 {
-                                ((n - 1 - i) * abs_incx) as isize
-                            } else {
-                                (i * abs_incx) as isize
-                            };
-                            let val = *x.offset(idx);
-                            x_conj[i as usize] = Complex32::new(val.re, -val.im);
-                        }
+                        // Conjugate y in place and take a conjugated copy of x in one pass
+                        let mut x_conj = scratch::take::<Complex32>(n as usize);
+                        conj::conj_copy_and_conj(
+                            i64::from(n),
+                            x,
+                            i64::from(incx),
+                            &mut x_conj,
+                            y,
+                            i64::from(incy),
+                        );
 
                         // Call Fortran HPMV with conjugated values
                         chpmv(
@@ -637,16 +546,7 @@ pub unsafe extern "C" fn cblas_chpmv_64(
                         );
 
                         // Conjugate y (in-place after operation)
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex32::new(val.re, -val.im);
-                        }
+                        conj::conj_in_place(i64::from(n), y, i64::from(incy));
                     }
                 }
             }
@@ -678,6 +578,7 @@ pub unsafe extern "C" fn cblas_zhpmv(
     y: *mut Complex64,
     incy: i32,
 ) {
+    let _call = dispatch::enter(Routine::Zhpmv, Some(order), [uplo as u8], [n], [incx, incy]);
     let p = get_zhpmv_for_lp64_cblas();
     match p {
         ZhpmvProvider::Lp64(zhpmv) => {
@@ -701,31 +602,16 @@ pub unsafe extern "C" fn cblas_zhpmv(
                     let conj_beta = Complex64::new(beta_val.re, -beta_val.im);
 
                     if n > 0 {
-                        // Conjugate y (in-place before operation)
-                        let abs_incy = if incy < 0 { -incy } else { incy };
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex64::new(val.re, -val.im);
-                        }
-
-                        // Create conjugated copy of x
-                        let abs_incx = if incx < 0 { -incx } else { incx };
-                        let mut x_conj = vec![Complex64::new(0.0, 0.0); n as usize];
-                        for i in 0..n {
-                            let idx = if incx < 0 {
-                                ((n - 1 - i) * abs_incx) as isize
-                            } else {
-                                (i * abs_incx) as isize
-                            };
-                            let val = *x.offset(idx);
-                            x_conj[i as usize] = Complex64::new(val.re, -val.im);
-                        }
+                        // Conjugate y in place and take a conjugated copy of x in one pass
+                        let mut x_conj = scratch::take::<Complex64>(n as usize);
+                        conj::conj_copy_and_conj(
+                            i64::from(n),
+                            x,
+                            i64::from(incx),
+                            &mut x_conj,
+                            y,
+                            i64::from(incy),
+                        );
 
                         // Call Fortran HPMV with conjugated values
                         zhpmv(
@@ -741,16 +627,7 @@ pub unsafe extern "C" fn cblas_zhpmv(
                         );
 
                         // Conjugate y (in-place after operation)
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex64::new(val.re, -val.im);
-                        }
+                        conj::conj_in_place(i64::from(n), y, i64::from(incy));
                     }
                 }
             }
@@ -780,31 +657,9 @@ pub unsafe extern "C" fn cblas_zhpmv(
                     let conj_beta = Complex64::new(beta_val.re, -beta_val.im);
 
                     if n > 0 {
-                        // Conjugate y (in-place before operation)
-                        let abs_incy = if incy < 0 { -incy } else { incy };
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex64::new(val.re, -val.im);
-                        }
-
-                        // Create conjugated copy of x
-                        let abs_incx = if incx < 0 { -incx } else { incx };
-                        let mut x_conj = vec![Complex64::new(0.0, 0.0); n as usize];
-                        for i in 0..n {
-                            let idx = if incx < 0 {
-                                ((n - 1 - i) * abs_incx) as isize
-                            } else {
-                                (i * abs_incx) as isize
-                            };
-                            let val = *x.offset(idx);
-                            x_conj[i as usize] = Complex64::new(val.re, -val.im);
-                        }
+                        // Conjugate y in place and take a conjugated copy of x in one pass
+                        let mut x_conj = scratch::take::<Complex64>(n as usize);
+                        conj::conj_copy_and_conj(n, x, incx, &mut x_conj, y, incy);
 
                         // Call Fortran HPMV with conjugated values
                         zhpmv(
@@ -820,16 +675,7 @@ pub unsafe extern "C" fn cblas_zhpmv(
                         );
 
                         // Conjugate y (in-place after operation)
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex64::new(val.re, -val.im);
-                        }
+                        conj::conj_in_place(n, y, incy);
                     }
                 }
             }
@@ -851,6 +697,7 @@ pub unsafe extern "C" fn cblas_zhpmv_64(
     y: *mut Complex64,
     incy: i64,
 ) {
+    let _call = dispatch::enter(Routine::Zhpmv, Some(order), [uplo as u8], [n], [incx, incy]);
     let p = get_zhpmv_for_ilp64_cblas();
     if matches!(p, ZhpmvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -884,31 +731,9 @@ pub unsafe extern "C" fn cblas_zhpmv_64(
                     let conj_beta = Complex64::new(beta_val.re, -beta_val.im);
 
                     if n > 0 {
-                        // Conjugate y (in-place before operation)
-                        let abs_incy = if incy < 0 { -incy } else { incy };
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex64::new(val.re, -val.im);
-                        }
-
-                        // Create conjugated copy of x
-                        let abs_incx = if incx < 0 { -incx } else { incx };
-                        let mut x_conj = vec![Complex64::new(0.0, 0.0); n as usize];
-                        for i in 0..n {
-                            let idx = if incx < 0 {
-                                ((n - 1 - i) * abs_incx) as isize
-                            } else {
-                                (i * abs_incx) as isize
-                            };
-                            let val = *x.offset(idx);
-                            x_conj[i as usize] = Complex64::new(val.re, -val.im);
-                        }
+                        // Conjugate y in place and take a conjugated copy of x in one pass
+                        let mut x_conj = scratch::take::<Complex64>(n as usize);
+                        conj::conj_copy_and_conj(n, x, incx, &mut x_conj, y, incy);
 
                         // Call Fortran HPMV with conjugated values
                         zhpmv(
@@ -924,16 +749,7 @@ pub unsafe extern "C" fn cblas_zhpmv_64(
                         );
 
                         // Conjugate y (in-place after operation)
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex64::new(val.re, -val.im);
-                        }
+                        conj::conj_in_place(n, y, incy);
                     }
                 }
             }
@@ -963,31 +779,16 @@ pub unsafe extern "C" fn cblas_zhpmv_64(
                     let conj_beta = Complex64::new(beta_val.re, -beta_val.im);
 
                     if n > 0 {
-                        // Conjugate y (in-place before operation)
-                        let abs_incy = if incy < 0 { -incy } else { incy };
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex64::new(val.re, -val.im);
-                        }
-
-                        // Create conjugated copy of x
-                        let abs_incx = if incx < 0 { -incx } else { incx };
-                        let mut x_conj = vec![Complex64::new(0.0, 0.0); n as usize];
-                        for i in 0..n {
-                            let idx = if incx < 0 {
-                                ((n - 1 - i) * abs_incx) as isize
-                            } else {
-                                (i * abs_incx) as isize
-                            };
-                            let val = *x.offset(idx);
-                            x_conj[i as usize] = Complex64::new(val.re, -val.im);
-                        }
+                        // Conjugate y in place and take a conjugated copy of x in one pass
+                        let mut x_conj = scratch::take::<Complex64>(n as usize);
+                        conj::conj_copy_and_conj(
+                            i64::from(n),
+                            x,
+                            i64::from(incx),
+                            &mut x_conj,
+                            y,
+                            i64::from(incy),
+                        );
 
                         // Call Fortran HPMV with conjugated values
                         zhpmv(
@@ -1003,16 +804,7 @@ pub unsafe extern "C" fn cblas_zhpmv_64(
                         );
 
                         // Conjugate y (in-place after operation)
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex64::new(val.re, -val.im);
-                        }
+                        conj::conj_in_place(i64::from(n), y, i64::from(incy));
                     }
                 }
             }
@@ -23,6 +23,10 @@ use crate::backend::{
     get_zhpr_for_lp64_cblas, Chpr2Provider, ChprProvider, Dspr2Provider, DsprProvider,
     Sspr2Provider, SsprProvider, Zhpr2Provider, ZhprProvider,
 };
+use crate::dispatch;
+use crate::native::conj;
+use crate::scratch;
+use crate::stats::Routine;
 use crate::types::{
     uplo_to_char, CblasColMajor, CblasLower, CblasRowMajor, CblasUpper, CBLAS_ORDER, CBLAS_UPLO,
 };
@@ -48,6 +52,7 @@ pub unsafe extern "C" fn cblas_sspr(
     incx: i32,
     ap: *mut f32,
 ) {
+    let _call = dispatch::enter(Routine::Sspr, Some(order), [uplo as u8], [n], [incx]);
     let p = get_sspr_for_lp64_cblas();
     match p {
         SsprProvider::Lp64(sspr) => {
@@ -100,6 +105,7 @@ pub unsafe extern "C" fn cblas_sspr_64(
     incx: i64,
     ap: *mut f32,
 ) {
+    let _call = dispatch::enter(Routine::Sspr, Some(order), [uplo as u8], [n], [incx]);
     let p = get_sspr_for_ilp64_cblas();
     if matches!(p, SsprProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_sspr_64\0", [(3, n), (6, incx)]).is_none()
@@ -165,6 +171,7 @@ pub unsafe extern "C" fn cblas_dspr(
     incx: i32,
     ap: *mut f64,
 ) {
+    let _call = dispatch::enter(Routine::Dspr, Some(order), [uplo as u8], [n], [incx]);
     let p = get_dspr_for_lp64_cblas();
     match p {
         DsprProvider::Lp64(dspr) => {
@@ -217,6 +224,7 @@ pub unsafe extern "C" fn cblas_dspr_64(
     incx: i64,
     ap: *mut f64,
 ) {
+    let _call = dispatch::enter(Routine::Dspr, Some(order), [uplo as u8], [n], [incx]);
     let p = get_dspr_for_ilp64_cblas();
     if matches!(p, DsprProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_dspr_64\0", [(3, n), (6, incx)]).is_none()
@@ -288,6 +296,7 @@ pub unsafe extern "C" fn cblas_chpr(
     incx: i32,
     ap: *mut Complex32,
 ) {
+    let _call = dispatch::enter(Routine::Chpr, Some(order), [uplo as u8], [n], [incx]);
     let p = get_chpr_for_lp64_cblas();
     match p {
         ChprProvider::Lp64(chpr) => {
@@ -303,7 +312,10 @@ pub unsafe extern "C" fn cblas_chpr(
                         CblasLower => CblasUpper,
                     };
                     let uplo_char = uplo_to_char(new_uplo);
-                    chpr(&uplo_char, &n, &alpha, x, &incx, ap);
+                    // Updating conj(A) needs conj(x) in place of x
+                    let mut x_conj = scratch::take::<Complex32>(n.max(0) as usize);
+                    conj::conj_copy(i64::from(n), x, i64::from(incx), &mut x_conj);
+                    chpr(&uplo_char, &n, &alpha, x_conj.as_ptr(), &1, ap);
                 }
             }
         }
@@ -323,7 +335,10 @@ pub unsafe extern "C" fn cblas_chpr(
                         CblasLower => CblasUpper,
                     };
                     let uplo_char = uplo_to_char(new_uplo);
-                    chpr(&uplo_char, &n, &alpha, x, &incx, ap);
+                    // Updating conj(A) needs conj(x) in place of x
+                    let mut x_conj = scratch::take::<Complex32>(n.max(0) as usize);
+                    conj::conj_copy(n, x, incx, &mut x_conj);
+                    chpr(&uplo_char, &n, &alpha, x_conj.as_ptr(), &1, ap);
                 }
             }
         }
@@ -340,6 +355,7 @@ pub unsafe extern "C" fn cblas_chpr_64(
     incx: i64,
     ap: *mut Complex32,
 ) {
+    let _call = dispatch::enter(Routine::Chpr, Some(order), [uplo as u8], [n], [incx]);
     let p = get_chpr_for_ilp64_cblas();
     if matches!(p, ChprProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_chpr_64\0", [(3, n), (6, incx)]).is_none()
@@ -361,7 +377,10 @@ pub unsafe extern "C" fn cblas_chpr_64(
                         CblasLower => CblasUpper,
                     };
                     let uplo_char = uplo_to_char(new_uplo);
-                    chpr(&uplo_char, &n, &alpha, x, &incx, ap);
+                    // Updating conj(A) needs conj(x) in place of x
+                    let mut x_conj = scratch::take::<Complex32>(n.max(0) as usize);
+                    conj::conj_copy(n, x, incx, &mut x_conj);
+                    chpr(&uplo_char, &n, &alpha, x_conj.as_ptr(), &1, ap);
                 }
             }
         }
@@ -381,7 +400,10 @@ pub unsafe extern "C" fn cblas_chpr_64(
                         CblasLower => CblasUpper,
                     };
                     let uplo_char = uplo_to_char(new_uplo);
-                    chpr(&uplo_char, &n, &alpha, x, &incx, ap);
+                    // Updating conj(A) needs conj(x) in place of x
+                    let mut x_conj = scratch::take::<Complex32>(n.max(0) as usize);
+                    conj::conj_copy(i64::from(n), x, i64::from(incx), &mut x_conj);
+                    chpr(&uplo_char, &n, &alpha, x_conj.as_ptr(), &1, ap);
                 }
             }
         }
@@ -407,6 +429,7 @@ pub unsafe extern "C" fn cblas_zhpr(
     incx: i32,
     ap: *mut Complex64,
 ) {
+    let _call = dispatch::enter(Routine::Zhpr, Some(order), [uplo as u8], [n], [incx]);
     let p = get_zhpr_for_lp64_cblas();
     match p {
         ZhprProvider::Lp64(zhpr) => {
@@ -422,7 +445,10 @@ pub unsafe extern "C" fn cblas_zhpr(
                         CblasLower => CblasUpper,
                     };
                     let uplo_char = uplo_to_char(new_uplo);
-                    zhpr(&uplo_char, &n, &alpha, x, &incx, ap);
+                    // Updating conj(A) needs conj(x) in place of x
+                    let mut x_conj = scratch::take::<Complex64>(n.max(0) as usize);
+                    conj::conj_copy(i64::from(n), x, i64::from(incx), &mut x_conj);
+                    zhpr(&uplo_char, &n, &alpha, x_conj.as_ptr(), &1, ap);
                 }
             }
         }
@@ -442,7 +468,10 @@ pub unsafe extern "C" fn cblas_zhpr(
                         CblasLower => CblasUpper,
                     };
                     let uplo_char = uplo_to_char(new_uplo);
-                    zhpr(&uplo_char, &n, &alpha, x, &incx, ap);
+                    // Updating conj(A) needs conj(x) in place of x
+                    let mut x_conj = scratch::take::<Complex64>(n.max(0) as usize);
+                    conj::conj_copy(n, x, incx, &mut x_conj);
+                    zhpr(&uplo_char, &n, &alpha, x_conj.as_ptr(), &1, ap);
                 }
             }
         }
@@ -459,6 +488,7 @@ pub unsafe extern "C" fn cblas_zhpr_64(
     incx: i64,
     ap: *mut Complex64,
 ) {
+    let _call = dispatch::enter(Routine::Zhpr, Some(order), [uplo as u8], [n], [incx]);
     let p = get_zhpr_for_ilp64_cblas();
     if matches!(p, ZhprProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_zhpr_64\0", [(3, n), (6, incx)]).is_none()
@@ -480,7 +510,10 @@ pub unsafe extern "C" fn cblas_zhpr_64(
                         CblasLower => CblasUpper,
                     };
                     let uplo_char = uplo_to_char(new_uplo);
-                    zhpr(&uplo_char, &n, &alpha, x, &incx, ap);
+                    // Updating conj(A) needs conj(x) in place of x
+                    let mut x_conj = scratch::take::<Complex64>(n.max(0) as usize);
+                    conj::conj_copy(n, x, incx, &mut x_conj);
+                    zhpr(&uplo_char, &n, &alpha, x_conj.as_ptr(), &1, ap);
                 }
             }
         }
@@ -500,7 +533,10 @@ pub unsafe extern "C" fn cblas_zhpr_64(
                         CblasLower => CblasUpper,
                     };
                     let uplo_char = uplo_to_char(new_uplo);
-                    zhpr(&uplo_char, &n, &alpha, x, &incx, ap);
+                    // Updating conj(A) needs conj(x) in place of x
+                    let mut x_conj = scratch::take::<Complex64>(n.max(0) as usize);
+                    conj::conj_copy(i64::from(n), x, i64::from(incx), &mut x_conj);
+                    zhpr(&uplo_char, &n, &alpha, x_conj.as_ptr(), &1, ap);
                 }
             }
         }
@@ -531,6 +567,7 @@ pub unsafe extern "C" fn cblas_sspr2(
     incy: i32,
     ap: *mut f32,
 ) {
+    let _call = dispatch::enter(Routine::Sspr2, Some(order), [uplo as u8], [n], [incx, incy]);
     let p = get_sspr2_for_lp64_cblas();
     match p {
         Sspr2Provider::Lp64(sspr2) => {
@@ -587,6 +624,7 @@ pub unsafe extern "C" fn cblas_sspr2_64(
     incy: i64,
     ap: *mut f32,
 ) {
+    let _call = dispatch::enter(Routine::Sspr2, Some(order), [uplo as u8], [n], [incx, incy]);
     let p = get_sspr2_for_ilp64_cblas();
     if matches!(p, Sspr2Provider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -660,6 +698,7 @@ pub unsafe extern "C" fn cblas_dspr2(
     incy: i32,
     ap: *mut f64,
 ) {
+    let _call = dispatch::enter(Routine::Dspr2, Some(order), [uplo as u8], [n], [incx, incy]);
     let p = get_dspr2_for_lp64_cblas();
     match p {
         Dspr2Provider::Lp64(dspr2) => {
@@ -716,6 +755,7 @@ pub unsafe extern "C" fn cblas_dspr2_64(
     incy: i64,
     ap: *mut f64,
 ) {
+    let _call = dispatch::enter(Routine::Dspr2, Some(order), [uplo as u8], [n], [incx, incy]);
     let p = get_dspr2_for_ilp64_cblas();
     if matches!(p, Dspr2Provider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -795,6 +835,7 @@ pub unsafe extern "C" fn cblas_chpr2(
     incy: i32,
     ap: *mut Complex32,
 ) {
+    let _call = dispatch::enter(Routine::Chpr2, Some(order), [uplo as u8], [n], [incx, incy]);
     let p = get_chpr2_for_lp64_cblas();
     match p {
         Chpr2Provider::Lp64(chpr2) => {
@@ -810,8 +851,21 @@ pub unsafe extern "C" fn cblas_chpr2(
                         CblasLower => CblasUpper,
                     };
                     let uplo_char = uplo_to_char(new_uplo);
-                    // For HPR2 in row-major, we swap x and y
-                    chpr2(&uplo_char, &n, alpha, y, &incy, x, &incx, ap);
+                    // For HPR2 in row-major, we swap x and y and conjugate both
+                    let mut conj_buf = scratch::take::<Complex32>(2 * n.max(0) as usize);
+                    let (x_conj, y_conj) = conj_buf.split_at_mut(n.max(0) as usize);
+                    conj::conj_copy(i64::from(n), x, i64::from(incx), x_conj);
+                    conj::conj_copy(i64::from(n), y, i64::from(incy), y_conj);
+                    chpr2(
+                        &uplo_char,
+                        &n,
+                        alpha,
+                        y_conj.as_ptr(),
+                        &1,
+                        x_conj.as_ptr(),
+                        &1,
+                        ap,
+                    );
                 }
             }
         }
@@ -832,8 +886,21 @@ pub unsafe extern "C" fn cblas_chpr2(
                         CblasLower => CblasUpper,
                     };
                     let uplo_char = uplo_to_char(new_uplo);
-                    // For HPR2 in row-major, we swap x and y
-                    chpr2(&uplo_char, &n, alpha, y, &incy, x, &incx, ap);
+                    // For HPR2 in row-major, we swap x and y and conjugate both
+                    let mut conj_buf = scratch::take::<Complex32>(2 * n.max(0) as usize);
+                    let (x_conj, y_conj) = conj_buf.split_at_mut(n.max(0) as usize);
+                    conj::conj_copy(n, x, incx, x_conj);
+                    conj::conj_copy(n, y, incy, y_conj);
+                    chpr2(
+                        &uplo_char,
+                        &n,
+                        alpha,
+                        y_conj.as_ptr(),
+                        &1,
+                        x_conj.as_ptr(),
+                        &1,
+                        ap,
+                    );
                 }
             }
         }
@@ -853,6 +920,7 @@ pub unsafe extern "C" fn cblas_chpr2_64(
     incy: i64,
     ap: *mut Complex32,
 ) {
+    let _call = dispatch::enter(Routine::Chpr2, Some(order), [uplo as u8], [n], [incx, incy]);
     let p = get_chpr2_for_ilp64_cblas();
     if matches!(p, Chpr2Provider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -878,8 +946,21 @@ pub unsafe extern "C" fn cblas_chpr2_64(
                         CblasLower => CblasUpper,
                     };
                     let uplo_char = uplo_to_char(new_uplo);
-                    // For HPR2 in row-major, we swap x and y
-                    chpr2(&uplo_char, &n, alpha, y, &incy, x, &incx, ap);
+                    // For HPR2 in row-major, we swap x and y and conjugate both
+                    let mut conj_buf = scratch::take::<Complex32>(2 * n.max(0) as usize);
+                    let (x_conj, y_conj) = conj_buf.split_at_mut(n.max(0) as usize);
+                    conj::conj_copy(n, x, incx, x_conj);
+                    conj::conj_copy(n, y, incy, y_conj);
+                    chpr2(
+                        &uplo_char,
+                        &n,
+                        alpha,
+                        y_conj.as_ptr(),
+                        &1,
+                        x_conj.as_ptr(),
+                        &1,
+                        ap,
+                    );
                 }
             }
         }
@@ -900,8 +981,21 @@ pub unsafe extern "C" fn cblas_chpr2_64(
                         CblasLower => CblasUpper,
                     };
                     let uplo_char = uplo_to_char(new_uplo);
-                    // For HPR2 in row-major, we swap x and y
-                    chpr2(&uplo_char, &n, alpha, y, &incy, x, &incx, ap);
+                    // For HPR2 in row-major, we swap x and y and conjugate both
+                    let mut conj_buf = scratch::take::<Complex32>(2 * n.max(0) as usize);
+                    let (x_conj, y_conj) = conj_buf.split_at_mut(n.max(0) as usize);
+                    conj::conj_copy(i64::from(n), x, i64::from(incx), x_conj);
+                    conj::conj_copy(i64::from(n), y, i64::from(incy), y_conj);
+                    chpr2(
+                        &uplo_char,
+                        &n,
+                        alpha,
+                        y_conj.as_ptr(),
+                        &1,
+                        x_conj.as_ptr(),
+                        &1,
+                        ap,
+                    );
                 }
             }
         }
@@ -930,6 +1024,7 @@ pub unsafe extern "C" fn cblas_zhpr2(
     incy: i32,
     ap: *mut Complex64,
 ) {
+    let _call = dispatch::enter(Routine::Zhpr2, Some(order), [uplo as u8], [n], [incx, incy]);
     let p = get_zhpr2_for_lp64_cblas();
     match p {
         Zhpr2Provider::Lp64(zhpr2) => {
@@ -945,8 +1040,21 @@ pub unsafe extern "C" fn cblas_zhpr2(
                         CblasLower => CblasUpper,
                     };
                     let uplo_char = uplo_to_char(new_uplo);
-                    // For HPR2 in row-major, we swap x and y
-                    zhpr2(&uplo_char, &n, alpha, y, &incy, x, &incx, ap);
+                    // For HPR2 in row-major, we swap x and y and conjugate both
+                    let mut conj_buf = scratch::take::<Complex64>(2 * n.max(0) as usize);
+                    let (x_conj, y_conj) = conj_buf.split_at_mut(n.max(0) as usize);
+                    conj::conj_copy(i64::from(n), x, i64::from(incx), x_conj);
+                    conj::conj_copy(i64::from(n), y, i64::from(incy), y_conj);
+                    zhpr2(
+                        &uplo_char,
+                        &n,
+                        alpha,
+                        y_conj.as_ptr(),
+                        &1,
+                        x_conj.as_ptr(),
+                        &1,
+                        ap,
+                    );
                 }
             }
         }
@@ -967,8 +1075,21 @@ pub unsafe extern "C" fn cblas_zhpr2(
                         CblasLower => CblasUpper,
                     };
                     let uplo_char = uplo_to_char(new_uplo);
-                    // For HPR2 in row-major, we swap x and y
-                    zhpr2(&uplo_char, &n, alpha, y, &incy, x, &incx, ap);
+                    // For HPR2 in row-major, we swap x and y and conjugate both
+                    let mut conj_buf = scratch::take::<Complex64>(2 * n.max(0) as usize);
+                    let (x_conj, y_conj) = conj_buf.split_at_mut(n.max(0) as usize);
+                    conj::conj_copy(n, x, incx, x_conj);
+                    conj::conj_copy(n, y, incy, y_conj);
+                    zhpr2(
+                        &uplo_char,
+                        &n,
+                        alpha,
+                        y_conj.as_ptr(),
+                        &1,
+                        x_conj.as_ptr(),
+                        &1,
+                        ap,
+                    );
                 }
             }
         }
@@ -988,6 +1109,7 @@ pub unsafe extern "C" fn cblas_zhpr2_64(
     incy: i64,
     ap: *mut Complex64,
 ) {
+    let _call = dispatch::enter(Routine::Zhpr2, Some(order), [uplo as u8], [n], [incx, incy]);
     let p = get_zhpr2_for_ilp64_cblas();
     if matches!(p, Zhpr2Provider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -1013,8 +1135,21 @@ pub unsafe extern "C" fn cblas_zhpr2_64(
                         CblasLower => CblasUpper,
                     };
                     let uplo_char = uplo_to_char(new_uplo);
-                    // For HPR2 in row-major, we swap x and y
-                    zhpr2(&uplo_char, &n, alpha, y, &incy, x, &incx, ap);
+                    // For HPR2 in row-major, we swap x and y and conjugate both
+                    let mut conj_buf = scratch::take::<Complex64>(2 * n.max(0) as usize);
+                    let (x_conj, y_conj) = conj_buf.split_at_mut(n.max(0) as usize);
+                    conj::conj_copy(n, x, incx, x_conj);
+                    conj::conj_copy(n, y, incy, y_conj);
+                    zhpr2(
+                        &uplo_char,
+                        &n,
+                        alpha,
+                        y_conj.as_ptr(),
+                        &1,
+                        x_conj.as_ptr(),
+                        &1,
+                        ap,
+                    );
                 }
             }
         }
@@ -1035,8 +1170,21 @@ pub unsafe extern "C" fn cblas_zhpr2_64(
                         CblasLower => CblasUpper,
                     };
                     let uplo_char = uplo_to_char(new_uplo);
-                    // For HPR2 in row-major, we swap x and y
-                    zhpr2(&uplo_char, &n, alpha, y, &incy, x, &incx, ap);
+                    // For HPR2 in row-major, we swap x and y and conjugate both
+                    let mut conj_buf = scratch::take::<Complex64>(2 * n.max(0) as usize);
+                    let (x_conj, y_conj) = conj_buf.split_at_mut(n.max(0) as usize);
+                    conj::conj_copy(i64::from(n), x, i64::from(incx), x_conj);
+                    conj::conj_copy(i64::from(n), y, i64::from(incy), y_conj);
+                    zhpr2(
+                        &uplo_char,
+                        &n,
+                        alpha,
+                        y_conj.as_ptr(),
+                        &1,
+                        x_conj.as_ptr(),
+                        &1,
+                        ap,
+                    );
                 }
             }
         }
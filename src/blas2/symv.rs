@@ -16,6 +16,10 @@ use crate::backend::{
     get_zhemv_for_ilp64_cblas, get_zhemv_for_lp64_cblas, ChemvProvider, DsymvProvider,
     SsymvProvider, ZhemvProvider,
 };
+use crate::dispatch;
+use crate::native::conj;
+use crate::scratch;
+use crate::stats::Routine;
 use crate::types::{
     uplo_to_char, CblasColMajor, CblasLower, CblasRowMajor, CblasUpper, CBLAS_ORDER, CBLAS_UPLO,
 };
@@ -45,6 +49,13 @@ pub unsafe extern "C" fn cblas_ssymv(
     y: *mut f32,
     incy: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ssymv,
+        Some(order),
+        [uplo as u8],
+        [n],
+        [lda, incx, incy],
+    );
     let p = get_ssymv_for_lp64_cblas();
     match p {
         SsymvProvider::Lp64(ssymv) => {
@@ -106,6 +117,13 @@ pub unsafe extern "C" fn cblas_ssymv_64(
     y: *mut f32,
     incy: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ssymv,
+        Some(order),
+        [uplo as u8],
+        [n],
+        [lda, incx, incy],
+    );
     let p = get_ssymv_for_ilp64_cblas();
     if matches!(p, SsymvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -187,6 +205,13 @@ pub unsafe extern "C" fn cblas_dsymv(
     y: *mut f64,
     incy: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Dsymv,
+        Some(order),
+        [uplo as u8],
+        [n],
+        [lda, incx, incy],
+    );
     let p = get_dsymv_for_lp64_cblas();
     match p {
         DsymvProvider::Lp64(dsymv) => {
@@ -246,6 +271,13 @@ pub unsafe extern "C" fn cblas_dsymv_64(
     y: *mut f64,
     incy: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Dsymv,
+        Some(order),
+        [uplo as u8],
+        [n],
+        [lda, incx, incy],
+    );
     let p = get_dsymv_for_ilp64_cblas();
     if matches!(p, DsymvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -332,6 +364,13 @@ pub unsafe extern "C" fn cblas_chemv(
     y: *mut Complex32,
     incy: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Chemv,
+        Some(order),
+        [uplo as u8],
+        [n],
+        [lda, incx, incy],
+    );
     let p = get_chemv_for_lp64_cblas();
     match p {
         ChemvProvider::Lp64(chemv) => {
@@ -358,31 +397,16 @@ pub unsafe extern "C" fn cblas_chemv(
                     // For row-major Hermitian operations, we need to conjugate input x
                     // and conjugate output y before and after the operation
                     if n > 0 {
-                        // Conjugate y (in-place before operation)
-                        let abs_incy = if incy < 0 { -incy } else { incy };
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex32::new(val.re, -val.im);
-                        }
-
-                        // Create conjugated copy of x
-                        let abs_incx = if incx < 0 { -incx } else { incx };
-                        let mut x_conj = vec![Complex32::new(0.0, 0.0); n as usize];
-                        for i in 0..n {
-                            let idx = if incx < 0 {
-                                ((n - 1 - i) * abs_incx) as isize
-                            } else {
-                                (i * abs_incx) as isize
-                            };
-                            let val = *x.offset(idx);
-                            x_conj[i as usize] = Complex32::new(val.re, -val.im);
-                        }
+                        // Conjugate y in place and take a conjugated copy of x in one pass
+                        let mut x_conj = scratch::take::<Complex32>(n as usize);
+                        conj::conj_copy_and_conj(
+                            i64::from(n),
+                            x,
+                            i64::from(incx),
+                            &mut x_conj,
+                            y,
+                            i64::from(incy),
+                        );
 
                         // Call Fortran HEMV with conjugated values
                         chemv(
@@ -399,16 +423,7 @@ pub unsafe extern "C" fn cblas_chemv(
                         );
 
                         // Conjugate y (in-place after operation)
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex32::new(val.re, -val.im);
-                        }
+                        conj::conj_in_place(i64::from(n), y, i64::from(incy));
                     }
                 }
             }
@@ -442,31 +457,9 @@ pub unsafe extern "C" fn cblas_chemv(
                     // For row-major Hermitian operations, we need to conjugate input x
                     // and conjugate output y before and after the operation
                     if n > 0 {
-                        // Conjugate y (in-place before operation)
-                        let abs_incy = if incy < 0 { -incy } else { incy };
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex32::new(val.re, -val.im);
-                        }
-
-                        // Create conjugated copy of x
-                        let abs_incx = if incx < 0 { -incx } else { incx };
-                        let mut x_conj = vec![Complex32::new(0.0, 0.0); n as usize];
-                        for i in 0..n {
-                            let idx = if incx < 0 {
-                                ((n - 1 - i) * abs_incx) as isize
-                            } else {
-                                (i * abs_incx) as isize
-                            };
-                            let val = *x.offset(idx);
-                            x_conj[i as usize] = Complex32::new(val.re, -val.im);
-                        }
+                        // Conjugate y in place and take a conjugated copy of x in one pass
+                        let mut x_conj = scratch::take::<Complex32>(n as usize);
+                        conj::conj_copy_and_conj(n, x, incx, &mut x_conj, y, incy);
 
                         // Call Fortran HEMV with conjugated values
                         chemv(
@@ -483,16 +476,7 @@ pub unsafe extern "C" fn cblas_chemv(
                         );
 
                         // Conjugate y (in-place after operation)
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex32::new(val.re, -val.im);
-                        }
+                        conj::conj_in_place(n, y, incy);
                     }
                 }
             }
@@ -515,6 +499,13 @@ pub unsafe extern "C" fn cblas_chemv_64(
     y: *mut Complex32,
     incy: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Chemv,
+        Some(order),
+        [uplo as u8],
+        [n],
+        [lda, incx, incy],
+    );
     let p = get_chemv_for_ilp64_cblas();
     if matches!(p, ChemvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -551,31 +542,9 @@ pub unsafe extern "C" fn cblas_chemv_64(
                     // For row-major Hermitian operations, we need to conjugate input x
                     // and conjugate output y before and after the operation
                     if n > 0 {
-                        // Conjugate y (in-place before operation)
-                        let abs_incy = if incy < 0 { -incy } else { incy };
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex32::new(val.re, -val.im);
-                        }
-
-                        // Create conjugated copy of x
-                        let abs_incx = if incx < 0 { -incx } else { incx };
-                        let mut x_conj = vec![Complex32::new(0.0, 0.0); n as usize];
-                        for i in 0..n {
-                            let idx = if incx < 0 {
-                                ((n - 1 - i) * abs_incx) as isize
-                            } else {
-                                (i * abs_incx) as isize
-                            };
-                            let val = *x.offset(idx);
-                            x_conj[i as usize] = Complex32::new(val.re, -val.im);
-                        }
+                        // Conjugate y in place and take a conjugated copy of x in one pass
+                        let mut x_conj = scratch::take::<Complex32>(n as usize);
+                        conj::conj_copy_and_conj(n, x, incx, &mut x_conj, y, incy);
 
                         // Call Fortran HEMV with conjugated values
                         chemv(
@@ -592,16 +561,7 @@ pub unsafe extern "C" fn cblas_chemv_64(
                         );
 
                         // Conjugate y (in-place after operation)
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex32::new(val.re, -val.im);
-                        }
+                        conj::conj_in_place(n, y, incy);
                     }
                 }
             }
@@ -635,31 +595,16 @@ pub unsafe extern "C" fn cblas_chemv_64(
                     // For row-major Hermitian operations, we need to conjugate input x
                     // and conjugate output y before and after the operation
                     if n > 0 {
-                        // Conjugate y (in-place before operation)
-                        let abs_incy = if incy < 0 { -incy } else { incy };
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex32::new(val.re, -val.im);
-                        }
-
-                        // Create conjugated copy of x
-                        let abs_incx = if incx < 0 { -incx } else { incx };
-                        let mut x_conj = vec![Complex32::new(0.0, 0.0); n as usize];
-                        for i in 0..n {
-                            let idx = if incx < 0 {
-                                ((n - 1 - i) * abs_incx) as isize
-                            } else {
-                                (i * abs_incx) as isize
-                            };
-                            let val = *x.offset(idx);
-                            x_conj[i as usize] = Complex32::new(val.re, -val.im);
-                        }
+                        // Conjugate y in place and take a conjugated copy of x in one pass
+                        let mut x_conj = scratch::take::<Complex32>(n as usize);
+                        conj::conj_copy_and_conj(
+                            i64::from(n),
+                            x,
+                            i64::from(incx),
+                            &mut x_conj,
+                            y,
+                            i64::from(incy),
+                        );
 
                         // Call Fortran HEMV with conjugated values
                         chemv(
@@ -676,16 +621,7 @@ pub unsafe extern "C" fn cblas_chemv_64(
                         );
 
                         // Conjugate y (in-place after operation)
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex32::new(val.re, -val.im);
-                        }
+                        conj::conj_in_place(i64::from(n), y, i64::from(incy));
                     }
                 }
             }
@@ -725,6 +661,13 @@ pub unsafe extern "C" fn cblas_zhemv(
     y: *mut Complex64,
     incy: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Zhemv,
+        Some(order),
+        [uplo as u8],
+        [n],
+        [lda, incx, incy],
+    );
     let p = get_zhemv_for_lp64_cblas();
     match p {
         ZhemvProvider::Lp64(zhemv) => {
@@ -751,31 +694,16 @@ pub unsafe extern "C" fn cblas_zhemv(
                     // For row-major Hermitian operations, we need to conjugate input x
                     // and conjugate output y before and after the operation
                     if n > 0 {
-                        // Conjugate y (in-place before operation)
-                        let abs_incy = if incy < 0 { -incy } else { incy };
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex64::new(val.re, -val.im);
-                        }
-
-                        // Create conjugated copy of x
-                        let abs_incx = if incx < 0 { -incx } else { incx };
-                        let mut x_conj = vec![Complex64::new(0.0, 0.0); n as usize];
-                        for i in 0..n {
-                            let idx = if incx < 0 {
-                                ((n - 1 - i) * abs_incx) as isize
-                            } else {
-                                (i * abs_incx) as isize
-                            };
-                            let val = *x.offset(idx);
-                            x_conj[i as usize] = Complex64::new(val.re, -val.im);
-                        }
+                        // Conjugate y in place and take a conjugated copy of x in one pass
+                        let mut x_conj = scratch::take::<Complex64>(n as usize);
+                        conj::conj_copy_and_conj(
+                            i64::from(n),
+                            x,
+                            i64::from(incx),
+                            &mut x_conj,
+                            y,
+                            i64::from(incy),
+                        );
 
                         // Call Fortran HEMV with conjugated values
                         zhemv(
@@ -792,16 +720,7 @@ pub unsafe extern "C" fn cblas_zhemv(
                         );
 
                         // Conjugate y (in-place after operation)
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex64::new(val.re, -val.im);
-                        }
+                        conj::conj_in_place(i64::from(n), y, i64::from(incy));
                     }
                 }
             }
@@ -835,31 +754,9 @@ pub unsafe extern "C" fn cblas_zhemv(
                     // For row-major Hermitian operations, we need to conjugate input x
                     // and conjugate output y before and after the operation
                     if n > 0 {
-                        // Conjugate y (in-place before operation)
-                        let abs_incy = if incy < 0 { -incy } else { incy };
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex64::new(val.re, -val.im);
-                        }
-
-                        // Create conjugated copy of x
-                        let abs_incx = if incx < 0 { -incx } else { incx };
-                        let mut x_conj = vec![Complex64::new(0.0, 0.0); n as usize];
-                        for i in 0..n {
-                            let idx = if incx < 0 {
-                                ((n - 1 - i) * abs_incx) as isize
-                            } else {
-                                (i * abs_incx) as isize
-                            };
-                            let val = *x.offset(idx);
-                            x_conj[i as usize] = Complex64::new(val.re, -val.im);
-                        }
+                        // Conjugate y in place and take a conjugated copy of x in one pass
+                        let mut x_conj = scratch::take::<Complex64>(n as usize);
+                        conj::conj_copy_and_conj(n, x, incx, &mut x_conj, y, incy);
 
                         // Call Fortran HEMV with conjugated values
                         zhemv(
@@ -876,16 +773,7 @@ pub unsafe extern "C" fn cblas_zhemv(
                         );
 
                         // Conjugate y (in-place after operation)
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex64::new(val.re, -val.im);
-                        }
+                        conj::conj_in_place(n, y, incy);
                     }
                 }
             }
@@ -908,6 +796,13 @@ pub unsafe extern "C" fn cblas_zhemv_64(
     y: *mut Complex64,
     incy: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Zhemv,
+        Some(order),
+        [uplo as u8],
+        [n],
+        [lda, incx, incy],
+    );
     let p = get_zhemv_for_ilp64_cblas();
     if matches!(p, ZhemvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -944,31 +839,9 @@ pub unsafe extern "C" fn cblas_zhemv_64(
                     // For row-major Hermitian operations, we need to conjugate input x
                     // and conjugate output y before and after the operation
                     if n > 0 {
-                        // Conjugate y (in-place before operation)
-                        let abs_incy = if incy < 0 { -incy } else { incy };
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex64::new(val.re, -val.im);
-                        }
-
-                        // Create conjugated copy of x
-                        let abs_incx = if incx < 0 { -incx } else { incx };
-                        let mut x_conj = vec![Complex64::new(0.0, 0.0); n as usize];
-                        for i in 0..n {
-                            let idx = if incx < 0 {
-                                ((n - 1 - i) * abs_incx) as isize
-                            } else {
-                                (i * abs_incx) as isize
-                            };
-                            let val = *x.offset(idx);
-                            x_conj[i as usize] = Complex64::new(val.re, -val.im);
-                        }
+                        // Conjugate y in place and take a conjugated copy of x in one pass
+                        let mut x_conj = scratch::take::<Complex64>(n as usize);
+                        conj::conj_copy_and_conj(n, x, incx, &mut x_conj, y, incy);
 
                         // Call Fortran HEMV with conjugated values
                         zhemv(
@@ -985,16 +858,7 @@ pub unsafe extern "C" fn cblas_zhemv_64(
                         );
 
                         // Conjugate y (in-place after operation)
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex64::new(val.re, -val.im);
-                        }
+                        conj::conj_in_place(n, y, incy);
                     }
                 }
             }
@@ -1028,31 +892,16 @@ pub unsafe extern "C" fn cblas_zhemv_64(
                     // For row-major Hermitian operations, we need to conjugate input x
                     // and conjugate output y before and after the operation
                     if n > 0 {
-                        // Conjugate y (in-place before operation)
-                        let abs_incy = if incy < 0 { -incy } else { incy };
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex64::new(val.re, -val.im);
-                        }
-
-                        // Create conjugated copy of x
-                        let abs_incx = if incx < 0 { -incx } else { incx };
-                        let mut x_conj = vec![Complex64::new(0.0, 0.0); n as usize];
-                        for i in 0..n {
-                            let idx = if incx < 0 {
-                                ((n - 1 - i) * abs_incx) as isize
-                            } else {
-                                (i * abs_incx) as isize
-                            };
-                            let val = *x.offset(idx);
-                            x_conj[i as usize] = Complex64::new(val.re, -val.im);
-                        }
+                        // Conjugate y in place and take a conjugated copy of x in one pass
+                        let mut x_conj = scratch::take::<Complex64>(n as usize);
+                        conj::conj_copy_and_conj(
+                            i64::from(n),
+                            x,
+                            i64::from(incx),
+                            &mut x_conj,
+                            y,
+                            i64::from(incy),
+                        );
 
                         // Call Fortran HEMV with conjugated values
                         zhemv(
@@ -1069,16 +918,7 @@ pub unsafe extern "C" fn cblas_zhemv_64(
                         );
 
                         // Conjugate y (in-place after operation)
-                        for i in 0..n {
-                            let idx = if incy < 0 {
-                                ((n - 1 - i) * abs_incy) as isize
-                            } else {
-                                (i * abs_incy) as isize
-                            };
-                            let y_ptr = y.offset(idx);
-                            let val = *y_ptr;
-                            *y_ptr = Complex64::new(val.re, -val.im);
-                        }
+                        conj::conj_in_place(i64::from(n), y, i64::from(incy));
                     }
                 }
             }
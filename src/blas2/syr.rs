@@ -23,6 +23,10 @@ use crate::backend::{
     get_zher_for_lp64_cblas, Cher2Provider, CherProvider, Dsyr2Provider, DsyrProvider,
     Ssyr2Provider, SsyrProvider, Zher2Provider, ZherProvider,
 };
+use crate::dispatch;
+use crate::native::conj;
+use crate::scratch;
+use crate::stats::Routine;
 use crate::types::{
     uplo_to_char, CblasColMajor, CblasLower, CblasRowMajor, CblasUpper, CBLAS_ORDER, CBLAS_UPLO,
 };
@@ -49,6 +53,7 @@ pub unsafe extern "C" fn cblas_ssyr(
     a: *mut f32,
     lda: i32,
 ) {
+    let _call = dispatch::enter(Routine::Ssyr, Some(order), [uplo as u8], [n], [incx, lda]);
     let p = get_ssyr_for_lp64_cblas();
     match p {
         SsyrProvider::Lp64(ssyr) => {
@@ -103,6 +108,7 @@ pub unsafe extern "C" fn cblas_ssyr_64(
     a: *mut f32,
     lda: i64,
 ) {
+    let _call = dispatch::enter(Routine::Ssyr, Some(order), [uplo as u8], [n], [incx, lda]);
     let p = get_ssyr_for_ilp64_cblas();
     if matches!(p, SsyrProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_ssyr_64\0", [(3, n), (6, incx), (8, lda)])
@@ -171,6 +177,7 @@ pub unsafe extern "C" fn cblas_dsyr(
     a: *mut f64,
     lda: i32,
 ) {
+    let _call = dispatch::enter(Routine::Dsyr, Some(order), [uplo as u8], [n], [incx, lda]);
     let p = get_dsyr_for_lp64_cblas();
     match p {
         DsyrProvider::Lp64(dsyr) => {
@@ -225,6 +232,7 @@ pub unsafe extern "C" fn cblas_dsyr_64(
     a: *mut f64,
     lda: i64,
 ) {
+    let _call = dispatch::enter(Routine::Dsyr, Some(order), [uplo as u8], [n], [incx, lda]);
     let p = get_dsyr_for_ilp64_cblas();
     if matches!(p, DsyrProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_dsyr_64\0", [(3, n), (6, incx), (8, lda)])
@@ -299,6 +307,7 @@ pub unsafe extern "C" fn cblas_cher(
     a: *mut Complex32,
     lda: i32,
 ) {
+    let _call = dispatch::enter(Routine::Cher, Some(order), [uplo as u8], [n], [incx, lda]);
     let p = get_cher_for_lp64_cblas();
     match p {
         CherProvider::Lp64(cher) => {
@@ -316,7 +325,10 @@ pub unsafe extern "C" fn cblas_cher(
                         CblasLower => CblasUpper,
                     };
                     let uplo_char = uplo_to_char(new_uplo);
-                    cher(&uplo_char, &n, &alpha, x, &incx, a, &lda);
+                    // Updating conj(A) needs conj(x) in place of x
+                    let mut x_conj = scratch::take::<Complex32>(n.max(0) as usize);
+                    conj::conj_copy(i64::from(n), x, i64::from(incx), &mut x_conj);
+                    cher(&uplo_char, &n, &alpha, x_conj.as_ptr(), &1, a, &lda);
                 }
             }
         }
@@ -339,7 +351,10 @@ pub unsafe extern "C" fn cblas_cher(
                         CblasLower => CblasUpper,
                     };
                     let uplo_char = uplo_to_char(new_uplo);
-                    cher(&uplo_char, &n, &alpha, x, &incx, a, &lda);
+                    // Updating conj(A) needs conj(x) in place of x
+                    let mut x_conj = scratch::take::<Complex32>(n.max(0) as usize);
+                    conj::conj_copy(n, x, incx, &mut x_conj);
+                    cher(&uplo_char, &n, &alpha, x_conj.as_ptr(), &1, a, &lda);
                 }
             }
         }
@@ -357,6 +372,7 @@ pub unsafe extern "C" fn cblas_cher_64(
     a: *mut Complex32,
     lda: i64,
 ) {
+    let _call = dispatch::enter(Routine::Cher, Some(order), [uplo as u8], [n], [incx, lda]);
     let p = get_cher_for_ilp64_cblas();
     if matches!(p, CherProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_cher_64\0", [(3, n), (6, incx), (8, lda)])
@@ -381,7 +397,10 @@ pub unsafe extern "C" fn cblas_cher_64(
                         CblasLower => CblasUpper,
                     };
                     let uplo_char = uplo_to_char(new_uplo);
-                    cher(&uplo_char, &n, &alpha, x, &incx, a, &lda);
+                    // Updating conj(A) needs conj(x) in place of x
+                    let mut x_conj = scratch::take::<Complex32>(n.max(0) as usize);
+                    conj::conj_copy(n, x, incx, &mut x_conj);
+                    cher(&uplo_char, &n, &alpha, x_conj.as_ptr(), &1, a, &lda);
                 }
             }
         }
@@ -404,7 +423,10 @@ pub unsafe extern "C" fn cblas_cher_64(
                         CblasLower => CblasUpper,
                     };
                     let uplo_char = uplo_to_char(new_uplo);
-                    cher(&uplo_char, &n, &alpha, x, &incx, a, &lda);
+                    // Updating conj(A) needs conj(x) in place of x
+                    let mut x_conj = scratch::take::<Complex32>(n.max(0) as usize);
+                    conj::conj_copy(i64::from(n), x, i64::from(incx), &mut x_conj);
+                    cher(&uplo_char, &n, &alpha, x_conj.as_ptr(), &1, a, &lda);
                 }
             }
         }
@@ -431,6 +453,7 @@ pub unsafe extern "C" fn cblas_zher(
     a: *mut Complex64,
     lda: i32,
 ) {
+    let _call = dispatch::enter(Routine::Zher, Some(order), [uplo as u8], [n], [incx, lda]);
     let p = get_zher_for_lp64_cblas();
     match p {
         ZherProvider::Lp64(zher) => {
@@ -446,7 +469,10 @@ pub unsafe extern "C" fn cblas_zher(
                         CblasLower => CblasUpper,
                     };
                     let uplo_char = uplo_to_char(new_uplo);
-                    zher(&uplo_char, &n, &alpha, x, &incx, a, &lda);
+                    // Updating conj(A) needs conj(x) in place of x
+                    let mut x_conj = scratch::take::<Complex64>(n.max(0) as usize);
+                    conj::conj_copy(i64::from(n), x, i64::from(incx), &mut x_conj);
+                    zher(&uplo_char, &n, &alpha, x_conj.as_ptr(), &1, a, &lda);
                 }
             }
         }
@@ -467,7 +493,10 @@ pub unsafe extern "C" fn cblas_zher(
                         CblasLower => CblasUpper,
                     };
                     let uplo_char = uplo_to_char(new_uplo);
-                    zher(&uplo_char, &n, &alpha, x, &incx, a, &lda);
+                    // Updating conj(A) needs conj(x) in place of x
+                    let mut x_conj = scratch::take::<Complex64>(n.max(0) as usize);
+                    conj::conj_copy(n, x, incx, &mut x_conj);
+                    zher(&uplo_char, &n, &alpha, x_conj.as_ptr(), &1, a, &lda);
                 }
             }
         }
@@ -485,6 +514,7 @@ pub unsafe extern "C" fn cblas_zher_64(
     a: *mut Complex64,
     lda: i64,
 ) {
+    let _call = dispatch::enter(Routine::Zher, Some(order), [uplo as u8], [n], [incx, lda]);
     let p = get_zher_for_ilp64_cblas();
     if matches!(p, ZherProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_zher_64\0", [(3, n), (6, incx), (8, lda)])
@@ -507,7 +537,10 @@ pub unsafe extern "C" fn cblas_zher_64(
                         CblasLower => CblasUpper,
                     };
                     let uplo_char = uplo_to_char(new_uplo);
-                    zher(&uplo_char, &n, &alpha, x, &incx, a, &lda);
+                    // Updating conj(A) needs conj(x) in place of x
+                    let mut x_conj = scratch::take::<Complex64>(n.max(0) as usize);
+                    conj::conj_copy(n, x, incx, &mut x_conj);
+                    zher(&uplo_char, &n, &alpha, x_conj.as_ptr(), &1, a, &lda);
                 }
             }
         }
@@ -528,7 +561,10 @@ pub unsafe extern "C" fn cblas_zher_64(
                         CblasLower => CblasUpper,
                     };
                     let uplo_char = uplo_to_char(new_uplo);
-                    zher(&uplo_char, &n, &alpha, x, &incx, a, &lda);
+                    // Updating conj(A) needs conj(x) in place of x
+                    let mut x_conj = scratch::take::<Complex64>(n.max(0) as usize);
+                    conj::conj_copy(i64::from(n), x, i64::from(incx), &mut x_conj);
+                    zher(&uplo_char, &n, &alpha, x_conj.as_ptr(), &1, a, &lda);
                 }
             }
         }
@@ -560,6 +596,13 @@ pub unsafe extern "C" fn cblas_ssyr2(
     a: *mut f32,
     lda: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ssyr2,
+        Some(order),
+        [uplo as u8],
+        [n],
+        [incx, incy, lda],
+    );
     let p = get_ssyr2_for_lp64_cblas();
     match p {
         Ssyr2Provider::Lp64(ssyr2) => {
@@ -618,6 +661,13 @@ pub unsafe extern "C" fn cblas_ssyr2_64(
     a: *mut f32,
     lda: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ssyr2,
+        Some(order),
+        [uplo as u8],
+        [n],
+        [incx, incy, lda],
+    );
     let p = get_ssyr2_for_ilp64_cblas();
     if matches!(p, Ssyr2Provider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -693,6 +743,13 @@ pub unsafe extern "C" fn cblas_dsyr2(
     a: *mut f64,
     lda: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Dsyr2,
+        Some(order),
+        [uplo as u8],
+        [n],
+        [incx, incy, lda],
+    );
     let p = get_dsyr2_for_lp64_cblas();
     match p {
         Dsyr2Provider::Lp64(dsyr2) => {
@@ -751,6 +808,13 @@ pub unsafe extern "C" fn cblas_dsyr2_64(
     a: *mut f64,
     lda: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Dsyr2,
+        Some(order),
+        [uplo as u8],
+        [n],
+        [incx, incy, lda],
+    );
     let p = get_dsyr2_for_ilp64_cblas();
     if matches!(p, Dsyr2Provider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -832,6 +896,13 @@ pub unsafe extern "C" fn cblas_cher2(
     a: *mut Complex32,
     lda: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Cher2,
+        Some(order),
+        [uplo as u8],
+        [n],
+        [incx, incy, lda],
+    );
     let p = get_cher2_for_lp64_cblas();
     match p {
         Cher2Provider::Lp64(cher2) => {
@@ -848,8 +919,22 @@ pub unsafe extern "C" fn cblas_cher2(
                     };
                     let uplo_char = uplo_to_char(new_uplo);
                     // For HER2 in row-major, we also need to swap x and y
-                    // and use conjugate of alpha (handled by the property of HER2)
-                    cher2(&uplo_char, &n, alpha, y, &incy, x, &incx, a, &lda);
+                    // and conjugate both, following the reference CBLAS
+                    let mut conj_buf = scratch::take::<Complex32>(2 * n.max(0) as usize);
+                    let (x_conj, y_conj) = conj_buf.split_at_mut(n.max(0) as usize);
+                    conj::conj_copy(i64::from(n), x, i64::from(incx), x_conj);
+                    conj::conj_copy(i64::from(n), y, i64::from(incy), y_conj);
+                    cher2(
+                        &uplo_char,
+                        &n,
+                        alpha,
+                        y_conj.as_ptr(),
+                        &1,
+                        x_conj.as_ptr(),
+                        &1,
+                        a,
+                        &lda,
+                    );
                 }
             }
         }
@@ -872,8 +957,22 @@ pub unsafe extern "C" fn cblas_cher2(
                     };
                     let uplo_char = uplo_to_char(new_uplo);
                     // For HER2 in row-major, we also need to swap x and y
-                    // and use conjugate of alpha (handled by the property of HER2)
-                    cher2(&uplo_char, &n, alpha, y, &incy, x, &incx, a, &lda);
+                    // and conjugate both, following the reference CBLAS
+                    let mut conj_buf = scratch::take::<Complex32>(2 * n.max(0) as usize);
+                    let (x_conj, y_conj) = conj_buf.split_at_mut(n.max(0) as usize);
+                    conj::conj_copy(n, x, incx, x_conj);
+                    conj::conj_copy(n, y, incy, y_conj);
+                    cher2(
+                        &uplo_char,
+                        &n,
+                        alpha,
+                        y_conj.as_ptr(),
+                        &1,
+                        x_conj.as_ptr(),
+                        &1,
+                        a,
+                        &lda,
+                    );
                 }
             }
         }
@@ -894,6 +993,13 @@ pub unsafe extern "C" fn cblas_cher2_64(
     a: *mut Complex32,
     lda: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Cher2,
+        Some(order),
+        [uplo as u8],
+        [n],
+        [incx, incy, lda],
+    );
     let p = get_cher2_for_ilp64_cblas();
     if matches!(p, Cher2Provider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -920,8 +1026,22 @@ pub unsafe extern "C" fn cblas_cher2_64(
                     };
                     let uplo_char = uplo_to_char(new_uplo);
                     // For HER2 in row-major, we also need to swap x and y
-                    // and use conjugate of alpha (handled by the property of HER2)
-                    cher2(&uplo_char, &n, alpha, y, &incy, x, &incx, a, &lda);
+                    // and conjugate both, following the reference CBLAS
+                    let mut conj_buf = scratch::take::<Complex32>(2 * n.max(0) as usize);
+                    let (x_conj, y_conj) = conj_buf.split_at_mut(n.max(0) as usize);
+                    conj::conj_copy(n, x, incx, x_conj);
+                    conj::conj_copy(n, y, incy, y_conj);
+                    cher2(
+                        &uplo_char,
+                        &n,
+                        alpha,
+                        y_conj.as_ptr(),
+                        &1,
+                        x_conj.as_ptr(),
+                        &1,
+                        a,
+                        &lda,
+                    );
                 }
             }
         }
@@ -944,8 +1064,22 @@ pub unsafe extern "C" fn cblas_cher2_64(
                     };
                     let uplo_char = uplo_to_char(new_uplo);
                     // For HER2 in row-major, we also need to swap x and y
-                    // and use conjugate of alpha (handled by the property of HER2)
-                    cher2(&uplo_char, &n, alpha, y, &incy, x, &incx, a, &lda);
+                    // and conjugate both, following the reference CBLAS
+                    let mut conj_buf = scratch::take::<Complex32>(2 * n.max(0) as usize);
+                    let (x_conj, y_conj) = conj_buf.split_at_mut(n.max(0) as usize);
+                    conj::conj_copy(i64::from(n), x, i64::from(incx), x_conj);
+                    conj::conj_copy(i64::from(n), y, i64::from(incy), y_conj);
+                    cher2(
+                        &uplo_char,
+                        &n,
+                        alpha,
+                        y_conj.as_ptr(),
+                        &1,
+                        x_conj.as_ptr(),
+                        &1,
+                        a,
+                        &lda,
+                    );
                 }
             }
         }
@@ -975,6 +1109,13 @@ pub unsafe extern "C" fn cblas_zher2(
     a: *mut Complex64,
     lda: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Zher2,
+        Some(order),
+        [uplo as u8],
+        [n],
+        [incx, incy, lda],
+    );
     let p = get_zher2_for_lp64_cblas();
     match p {
         Zher2Provider::Lp64(zher2) => {
@@ -990,7 +1131,21 @@ pub unsafe extern "C" fn cblas_zher2(
                         CblasLower => CblasUpper,
                     };
                     let uplo_char = uplo_to_char(new_uplo);
-                    zher2(&uplo_char, &n, alpha, y, &incy, x, &incx, a, &lda);
+                    let mut conj_buf = scratch::take::<Complex64>(2 * n.max(0) as usize);
+                    let (x_conj, y_conj) = conj_buf.split_at_mut(n.max(0) as usize);
+                    conj::conj_copy(i64::from(n), x, i64::from(incx), x_conj);
+                    conj::conj_copy(i64::from(n), y, i64::from(incy), y_conj);
+                    zher2(
+                        &uplo_char,
+                        &n,
+                        alpha,
+                        y_conj.as_ptr(),
+                        &1,
+                        x_conj.as_ptr(),
+                        &1,
+                        a,
+                        &lda,
+                    );
                 }
             }
         }
@@ -1012,7 +1167,21 @@ pub unsafe extern "C" fn cblas_zher2(
                         CblasLower => CblasUpper,
                     };
                     let uplo_char = uplo_to_char(new_uplo);
-                    zher2(&uplo_char, &n, alpha, y, &incy, x, &incx, a, &lda);
+                    let mut conj_buf = scratch::take::<Complex64>(2 * n.max(0) as usize);
+                    let (x_conj, y_conj) = conj_buf.split_at_mut(n.max(0) as usize);
+                    conj::conj_copy(n, x, incx, x_conj);
+                    conj::conj_copy(n, y, incy, y_conj);
+                    zher2(
+                        &uplo_char,
+                        &n,
+                        alpha,
+                        y_conj.as_ptr(),
+                        &1,
+                        x_conj.as_ptr(),
+                        &1,
+                        a,
+                        &lda,
+                    );
                 }
             }
         }
@@ -1033,6 +1202,13 @@ pub unsafe extern "C" fn cblas_zher2_64(
     a: *mut Complex64,
     lda: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Zher2,
+        Some(order),
+        [uplo as u8],
+        [n],
+        [incx, incy, lda],
+    );
     let p = get_zher2_for_ilp64_cblas();
     if matches!(p, Zher2Provider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -1058,7 +1234,21 @@ pub unsafe extern "C" fn cblas_zher2_64(
                         CblasLower => CblasUpper,
                     };
                     let uplo_char = uplo_to_char(new_uplo);
-                    zher2(&uplo_char, &n, alpha, y, &incy, x, &incx, a, &lda);
+                    let mut conj_buf = scratch::take::<Complex64>(2 * n.max(0) as usize);
+                    let (x_conj, y_conj) = conj_buf.split_at_mut(n.max(0) as usize);
+                    conj::conj_copy(n, x, incx, x_conj);
+                    conj::conj_copy(n, y, incy, y_conj);
+                    zher2(
+                        &uplo_char,
+                        &n,
+                        alpha,
+                        y_conj.as_ptr(),
+                        &1,
+                        x_conj.as_ptr(),
+                        &1,
+                        a,
+                        &lda,
+                    );
                 }
             }
         }
@@ -1080,7 +1270,21 @@ pub unsafe extern "C" fn cblas_zher2_64(
                         CblasLower => CblasUpper,
                     };
                     let uplo_char = uplo_to_char(new_uplo);
-                    zher2(&uplo_char, &n, alpha, y, &incy, x, &incx, a, &lda);
+                    let mut conj_buf = scratch::take::<Complex64>(2 * n.max(0) as usize);
+                    let (x_conj, y_conj) = conj_buf.split_at_mut(n.max(0) as usize);
+                    conj::conj_copy(i64::from(n), x, i64::from(incx), x_conj);
+                    conj::conj_copy(i64::from(n), y, i64::from(incy), y_conj);
+                    zher2(
+                        &uplo_char,
+                        &n,
+                        alpha,
+                        y_conj.as_ptr(),
+                        &1,
+                        x_conj.as_ptr(),
+                        &1,
+                        a,
+                        &lda,
+                    );
                 }
             }
         }
@@ -15,6 +15,8 @@ use crate::backend::{
     get_ztbmv_for_ilp64_cblas, get_ztbmv_for_lp64_cblas, CtbmvProvider, DtbmvProvider,
     StbmvProvider, ZtbmvProvider,
 };
+use crate::dispatch;
+use crate::stats::Routine;
 use crate::types::{
     diag_to_char, normalize_transpose_real, transpose_to_char, uplo_to_char, CblasColMajor,
     CblasConjNoTrans, CblasConjTrans, CblasLower, CblasNoTrans, CblasRowMajor, CblasTrans,
@@ -43,6 +45,13 @@ pub unsafe extern "C" fn cblas_stbmv(
     x: *mut f32,
     incx: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Stbmv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n, k],
+        [lda, incx],
+    );
     let p = get_stbmv_for_lp64_cblas();
     match p {
         StbmvProvider::Lp64(stbmv) => {
@@ -160,6 +169,13 @@ pub unsafe extern "C" fn cblas_stbmv_64(
     x: *mut f32,
     incx: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Stbmv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n, k],
+        [lda, incx],
+    );
     let p = get_stbmv_for_ilp64_cblas();
     if matches!(p, StbmvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -296,6 +312,13 @@ pub unsafe extern "C" fn cblas_dtbmv(
     x: *mut f64,
     incx: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Dtbmv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n, k],
+        [lda, incx],
+    );
     let p = get_dtbmv_for_lp64_cblas();
     match p {
         DtbmvProvider::Lp64(dtbmv) => {
@@ -411,6 +434,13 @@ pub unsafe extern "C" fn cblas_dtbmv_64(
     x: *mut f64,
     incx: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Dtbmv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n, k],
+        [lda, incx],
+    );
     let p = get_dtbmv_for_ilp64_cblas();
     if matches!(p, DtbmvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -545,6 +575,13 @@ pub unsafe extern "C" fn cblas_ctbmv(
     x: *mut Complex32,
     incx: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ctbmv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n, k],
+        [lda, incx],
+    );
     let p = get_ctbmv_for_lp64_cblas();
     match p {
         CtbmvProvider::Lp64(ctbmv) => {
@@ -664,6 +701,13 @@ pub unsafe extern "C" fn cblas_ctbmv_64(
     x: *mut Complex32,
     incx: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ctbmv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n, k],
+        [lda, incx],
+    );
     let p = get_ctbmv_for_ilp64_cblas();
     if matches!(p, CtbmvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -802,6 +846,13 @@ pub unsafe extern "C" fn cblas_ztbmv(
     x: *mut Complex64,
     incx: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ztbmv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n, k],
+        [lda, incx],
+    );
     let p = get_ztbmv_for_lp64_cblas();
     match p {
         ZtbmvProvider::Lp64(ztbmv) => {
@@ -921,6 +972,13 @@ pub unsafe extern "C" fn cblas_ztbmv_64(
     x: *mut Complex64,
     incx: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ztbmv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n, k],
+        [lda, incx],
+    );
     let p = get_ztbmv_for_ilp64_cblas();
     if matches!(p, ZtbmvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -16,6 +16,9 @@ use crate::backend::{
     get_ztbsv_for_ilp64_cblas, get_ztbsv_for_lp64_cblas, CtbsvProvider, DtbsvProvider,
     StbsvProvider, ZtbsvProvider,
 };
+use crate::coalesce;
+use crate::dispatch;
+use crate::stats::Routine;
 use crate::types::{
     diag_to_char, normalize_transpose_real, transpose_to_char, uplo_to_char, CblasColMajor,
     CblasConjNoTrans, CblasConjTrans, CblasLower, CblasNoTrans, CblasRowMajor, CblasTrans,
@@ -44,6 +47,29 @@ pub unsafe extern "C" fn cblas_stbsv(
     x: *mut f32,
     incx: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Stbsv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n, k],
+        [lda, incx],
+    );
+    if unsafe {
+        coalesce::tbsv(
+            order,
+            uplo,
+            trans,
+            diag,
+            i64::from(n),
+            i64::from(k),
+            a,
+            i64::from(lda),
+            x,
+            i64::from(incx),
+        )
+    } {
+        return;
+    }
     let p = get_stbsv_for_lp64_cblas();
     match p {
         StbsvProvider::Lp64(stbsv) => {
@@ -161,6 +187,16 @@ pub unsafe extern "C" fn cblas_stbsv_64(
     x: *mut f32,
     incx: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Stbsv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n, k],
+        [lda, incx],
+    );
+    if unsafe { coalesce::tbsv(order, uplo, trans, diag, n, k, a, lda, x, incx) } {
+        return;
+    }
     let p = get_stbsv_for_ilp64_cblas();
     if matches!(p, StbsvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -297,6 +333,29 @@ pub unsafe extern "C" fn cblas_dtbsv(
     x: *mut f64,
     incx: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Dtbsv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n, k],
+        [lda, incx],
+    );
+    if unsafe {
+        coalesce::tbsv(
+            order,
+            uplo,
+            trans,
+            diag,
+            i64::from(n),
+            i64::from(k),
+            a,
+            i64::from(lda),
+            x,
+            i64::from(incx),
+        )
+    } {
+        return;
+    }
     let p = get_dtbsv_for_lp64_cblas();
     match p {
         DtbsvProvider::Lp64(dtbsv) => {
@@ -412,6 +471,16 @@ pub unsafe extern "C" fn cblas_dtbsv_64(
     x: *mut f64,
     incx: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Dtbsv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n, k],
+        [lda, incx],
+    );
+    if unsafe { coalesce::tbsv(order, uplo, trans, diag, n, k, a, lda, x, incx) } {
+        return;
+    }
     let p = get_dtbsv_for_ilp64_cblas();
     if matches!(p, DtbsvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -546,6 +615,29 @@ pub unsafe extern "C" fn cblas_ctbsv(
     x: *mut Complex32,
     incx: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ctbsv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n, k],
+        [lda, incx],
+    );
+    if unsafe {
+        coalesce::tbsv(
+            order,
+            uplo,
+            trans,
+            diag,
+            i64::from(n),
+            i64::from(k),
+            a,
+            i64::from(lda),
+            x,
+            i64::from(incx),
+        )
+    } {
+        return;
+    }
     let p = get_ctbsv_for_lp64_cblas();
     match p {
         CtbsvProvider::Lp64(ctbsv) => {
@@ -665,6 +757,16 @@ pub unsafe extern "C" fn cblas_ctbsv_64(
     x: *mut Complex32,
     incx: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ctbsv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n, k],
+        [lda, incx],
+    );
+    if unsafe { coalesce::tbsv(order, uplo, trans, diag, n, k, a, lda, x, incx) } {
+        return;
+    }
     let p = get_ctbsv_for_ilp64_cblas();
     if matches!(p, CtbsvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
@@ -803,6 +905,29 @@ pub unsafe extern "C" fn cblas_ztbsv(
     x: *mut Complex64,
     incx: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ztbsv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n, k],
+        [lda, incx],
+    );
+    if unsafe {
+        coalesce::tbsv(
+            order,
+            uplo,
+            trans,
+            diag,
+            i64::from(n),
+            i64::from(k),
+            a,
+            i64::from(lda),
+            x,
+            i64::from(incx),
+        )
+    } {
+        return;
+    }
     let p = get_ztbsv_for_lp64_cblas();
     match p {
         ZtbsvProvider::Lp64(ztbsv) => {
@@ -922,6 +1047,16 @@ pub unsafe extern "C" fn cblas_ztbsv_64(
     x: *mut Complex64,
     incx: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ztbsv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n, k],
+        [lda, incx],
+    );
+    if unsafe { coalesce::tbsv(order, uplo, trans, diag, n, k, a, lda, x, incx) } {
+        return;
+    }
     let p = get_ztbsv_for_ilp64_cblas();
     if matches!(p, ZtbsvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(
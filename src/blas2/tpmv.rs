@@ -20,6 +20,8 @@ use crate::backend::{
     get_ztpsv_for_lp64_cblas, CtpmvProvider, CtpsvProvider, DtpmvProvider, DtpsvProvider,
     StpmvProvider, StpsvProvider, ZtpmvProvider, ZtpsvProvider,
 };
+use crate::dispatch;
+use crate::stats::Routine;
 use crate::types::{
     diag_to_char, normalize_transpose_real, transpose_to_char, uplo_to_char, CblasColMajor,
     CblasConjNoTrans, CblasConjTrans, CblasLower, CblasNoTrans, CblasRowMajor, CblasTrans,
@@ -50,6 +52,13 @@ pub unsafe extern "C" fn cblas_stpmv(
     x: *mut f32,
     incx: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Stpmv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [incx],
+    );
     let p = get_stpmv_for_lp64_cblas();
     match p {
         StpmvProvider::Lp64(stpmv) => {
@@ -121,6 +130,13 @@ pub unsafe extern "C" fn cblas_stpmv_64(
     x: *mut f32,
     incx: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Stpmv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [incx],
+    );
     let p = get_stpmv_for_ilp64_cblas();
     if matches!(p, StpmvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_stpmv_64\0", [(5, n), (8, incx)]).is_none()
@@ -207,6 +223,13 @@ pub unsafe extern "C" fn cblas_dtpmv(
     x: *mut f64,
     incx: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Dtpmv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [incx],
+    );
     let p = get_dtpmv_for_lp64_cblas();
     match p {
         DtpmvProvider::Lp64(dtpmv) => {
@@ -278,6 +301,13 @@ pub unsafe extern "C" fn cblas_dtpmv_64(
     x: *mut f64,
     incx: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Dtpmv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [incx],
+    );
     let p = get_dtpmv_for_ilp64_cblas();
     if matches!(p, DtpmvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_dtpmv_64\0", [(5, n), (8, incx)]).is_none()
@@ -364,6 +394,13 @@ pub unsafe extern "C" fn cblas_ctpmv(
     x: *mut Complex32,
     incx: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ctpmv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [incx],
+    );
     let p = get_ctpmv_for_lp64_cblas();
     match p {
         CtpmvProvider::Lp64(ctpmv) => {
@@ -439,6 +476,13 @@ pub unsafe extern "C" fn cblas_ctpmv_64(
     x: *mut Complex32,
     incx: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ctpmv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [incx],
+    );
     let p = get_ctpmv_for_ilp64_cblas();
     if matches!(p, CtpmvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_ctpmv_64\0", [(5, n), (8, incx)]).is_none()
@@ -529,6 +573,13 @@ pub unsafe extern "C" fn cblas_ztpmv(
     x: *mut Complex64,
     incx: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ztpmv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [incx],
+    );
     let p = get_ztpmv_for_lp64_cblas();
     match p {
         ZtpmvProvider::Lp64(ztpmv) => {
@@ -604,6 +655,13 @@ pub unsafe extern "C" fn cblas_ztpmv_64(
     x: *mut Complex64,
     incx: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ztpmv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [incx],
+    );
     let p = get_ztpmv_for_ilp64_cblas();
     if matches!(p, ZtpmvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_ztpmv_64\0", [(5, n), (8, incx)]).is_none()
@@ -698,6 +756,13 @@ pub unsafe extern "C" fn cblas_stpsv(
     x: *mut f32,
     incx: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Stpsv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [incx],
+    );
     let p = get_stpsv_for_lp64_cblas();
     match p {
         StpsvProvider::Lp64(stpsv) => {
@@ -769,6 +834,13 @@ pub unsafe extern "C" fn cblas_stpsv_64(
     x: *mut f32,
     incx: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Stpsv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [incx],
+    );
     let p = get_stpsv_for_ilp64_cblas();
     if matches!(p, StpsvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_stpsv_64\0", [(5, n), (8, incx)]).is_none()
@@ -855,6 +927,13 @@ pub unsafe extern "C" fn cblas_dtpsv(
     x: *mut f64,
     incx: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Dtpsv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [incx],
+    );
     let p = get_dtpsv_for_lp64_cblas();
     match p {
         DtpsvProvider::Lp64(dtpsv) => {
@@ -926,6 +1005,13 @@ pub unsafe extern "C" fn cblas_dtpsv_64(
     x: *mut f64,
     incx: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Dtpsv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [incx],
+    );
     let p = get_dtpsv_for_ilp64_cblas();
     if matches!(p, DtpsvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_dtpsv_64\0", [(5, n), (8, incx)]).is_none()
@@ -1012,6 +1098,13 @@ pub unsafe extern "C" fn cblas_ctpsv(
     x: *mut Complex32,
     incx: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ctpsv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [incx],
+    );
     let p = get_ctpsv_for_lp64_cblas();
     match p {
         CtpsvProvider::Lp64(ctpsv) => {
@@ -1087,6 +1180,13 @@ pub unsafe extern "C" fn cblas_ctpsv_64(
     x: *mut Complex32,
     incx: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ctpsv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [incx],
+    );
     let p = get_ctpsv_for_ilp64_cblas();
     if matches!(p, CtpsvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_ctpsv_64\0", [(5, n), (8, incx)]).is_none()
@@ -1177,6 +1277,13 @@ pub unsafe extern "C" fn cblas_ztpsv(
     x: *mut Complex64,
     incx: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ztpsv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [incx],
+    );
     let p = get_ztpsv_for_lp64_cblas();
     match p {
         ZtpsvProvider::Lp64(ztpsv) => {
@@ -1252,6 +1359,13 @@ pub unsafe extern "C" fn cblas_ztpsv_64(
     x: *mut Complex64,
     incx: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ztpsv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [incx],
+    );
     let p = get_ztpsv_for_ilp64_cblas();
     if matches!(p, ZtpsvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_ztpsv_64\0", [(5, n), (8, incx)]).is_none()
@@ -15,6 +15,8 @@ use crate::backend::{
     get_ztrmv_for_ilp64_cblas, get_ztrmv_for_lp64_cblas, CtrmvProvider, DtrmvProvider,
     StrmvProvider, ZtrmvProvider,
 };
+use crate::dispatch;
+use crate::stats::Routine;
 use crate::types::{
     diag_to_char, normalize_transpose_real, transpose_to_char, uplo_to_char, CblasColMajor,
     CblasConjNoTrans, CblasConjTrans, CblasLower, CblasNoTrans, CblasRowMajor, CblasTrans,
@@ -42,6 +44,13 @@ pub unsafe extern "C" fn cblas_strmv(
     x: *mut f32,
     incx: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Strmv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [lda, incx],
+    );
     let p = get_strmv_for_lp64_cblas();
     match p {
         StrmvProvider::Lp64(strmv) => {
@@ -117,6 +126,13 @@ pub unsafe extern "C" fn cblas_strmv_64(
     x: *mut f32,
     incx: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Strmv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [lda, incx],
+    );
     let p = get_strmv_for_ilp64_cblas();
     if matches!(p, StrmvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_strmv_64\0", [(5, n), (7, lda), (9, incx)])
@@ -208,6 +224,13 @@ pub unsafe extern "C" fn cblas_dtrmv(
     x: *mut f64,
     incx: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Dtrmv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [lda, incx],
+    );
     let p = get_dtrmv_for_lp64_cblas();
     match p {
         DtrmvProvider::Lp64(dtrmv) => {
@@ -281,6 +304,13 @@ pub unsafe extern "C" fn cblas_dtrmv_64(
     x: *mut f64,
     incx: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Dtrmv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [lda, incx],
+    );
     let p = get_dtrmv_for_ilp64_cblas();
     if matches!(p, DtrmvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_dtrmv_64\0", [(5, n), (7, lda), (9, incx)])
@@ -370,6 +400,13 @@ pub unsafe extern "C" fn cblas_ctrmv(
     x: *mut Complex32,
     incx: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ctrmv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [lda, incx],
+    );
     let p = get_ctrmv_for_lp64_cblas();
     match p {
         CtrmvProvider::Lp64(ctrmv) => {
@@ -447,6 +484,13 @@ pub unsafe extern "C" fn cblas_ctrmv_64(
     x: *mut Complex32,
     incx: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ctrmv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [lda, incx],
+    );
     let p = get_ctrmv_for_ilp64_cblas();
     if matches!(p, CtrmvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_ctrmv_64\0", [(5, n), (7, lda), (9, incx)])
@@ -540,6 +584,13 @@ pub unsafe extern "C" fn cblas_ztrmv(
     x: *mut Complex64,
     incx: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ztrmv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [lda, incx],
+    );
     let p = get_ztrmv_for_lp64_cblas();
     match p {
         ZtrmvProvider::Lp64(ztrmv) => {
@@ -617,6 +668,13 @@ pub unsafe extern "C" fn cblas_ztrmv_64(
     x: *mut Complex64,
     incx: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ztrmv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [lda, incx],
+    );
     let p = get_ztrmv_for_ilp64_cblas();
     if matches!(p, ZtrmvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_ztrmv_64\0", [(5, n), (7, lda), (9, incx)])
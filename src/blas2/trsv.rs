@@ -16,6 +16,9 @@ use crate::backend::{
     get_ztrsv_for_ilp64_cblas, get_ztrsv_for_lp64_cblas, CtrsvProvider, DtrsvProvider,
     StrsvProvider, ZtrsvProvider,
 };
+use crate::coalesce;
+use crate::dispatch;
+use crate::stats::Routine;
 use crate::types::{
     diag_to_char, normalize_transpose_real, transpose_to_char, uplo_to_char, CblasColMajor,
     CblasConjNoTrans, CblasConjTrans, CblasLower, CblasNoTrans, CblasRowMajor, CblasTrans,
@@ -43,6 +46,28 @@ pub unsafe extern "C" fn cblas_strsv(
     x: *mut f32,
     incx: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Strsv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [lda, incx],
+    );
+    if unsafe {
+        coalesce::trsv(
+            order,
+            uplo,
+            trans,
+            diag,
+            i64::from(n),
+            a,
+            i64::from(lda),
+            x,
+            i64::from(incx),
+        )
+    } {
+        return;
+    }
     let p = get_strsv_for_lp64_cblas();
     match p {
         StrsvProvider::Lp64(strsv) => {
@@ -118,6 +143,16 @@ pub unsafe extern "C" fn cblas_strsv_64(
     x: *mut f32,
     incx: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Strsv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [lda, incx],
+    );
+    if unsafe { coalesce::trsv(order, uplo, trans, diag, n, a, lda, x, incx) } {
+        return;
+    }
     let p = get_strsv_for_ilp64_cblas();
     if matches!(p, StrsvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_strsv_64\0", [(5, n), (7, lda), (9, incx)])
@@ -209,6 +244,28 @@ pub unsafe extern "C" fn cblas_dtrsv(
     x: *mut f64,
     incx: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Dtrsv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [lda, incx],
+    );
+    if unsafe {
+        coalesce::trsv(
+            order,
+            uplo,
+            trans,
+            diag,
+            i64::from(n),
+            a,
+            i64::from(lda),
+            x,
+            i64::from(incx),
+        )
+    } {
+        return;
+    }
     let p = get_dtrsv_for_lp64_cblas();
     match p {
         DtrsvProvider::Lp64(dtrsv) => {
@@ -282,6 +339,16 @@ pub unsafe extern "C" fn cblas_dtrsv_64(
     x: *mut f64,
     incx: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Dtrsv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [lda, incx],
+    );
+    if unsafe { coalesce::trsv(order, uplo, trans, diag, n, a, lda, x, incx) } {
+        return;
+    }
     let p = get_dtrsv_for_ilp64_cblas();
     if matches!(p, DtrsvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_dtrsv_64\0", [(5, n), (7, lda), (9, incx)])
@@ -371,6 +438,28 @@ pub unsafe extern "C" fn cblas_ctrsv(
     x: *mut Complex32,
     incx: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ctrsv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [lda, incx],
+    );
+    if unsafe {
+        coalesce::trsv(
+            order,
+            uplo,
+            trans,
+            diag,
+            i64::from(n),
+            a,
+            i64::from(lda),
+            x,
+            i64::from(incx),
+        )
+    } {
+        return;
+    }
     let p = get_ctrsv_for_lp64_cblas();
     match p {
         CtrsvProvider::Lp64(ctrsv) => {
@@ -448,6 +537,16 @@ pub unsafe extern "C" fn cblas_ctrsv_64(
     x: *mut Complex32,
     incx: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ctrsv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [lda, incx],
+    );
+    if unsafe { coalesce::trsv(order, uplo, trans, diag, n, a, lda, x, incx) } {
+        return;
+    }
     let p = get_ctrsv_for_ilp64_cblas();
     if matches!(p, CtrsvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_ctrsv_64\0", [(5, n), (7, lda), (9, incx)])
@@ -541,6 +640,28 @@ pub unsafe extern "C" fn cblas_ztrsv(
     x: *mut Complex64,
     incx: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ztrsv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [lda, incx],
+    );
+    if unsafe {
+        coalesce::trsv(
+            order,
+            uplo,
+            trans,
+            diag,
+            i64::from(n),
+            a,
+            i64::from(lda),
+            x,
+            i64::from(incx),
+        )
+    } {
+        return;
+    }
     let p = get_ztrsv_for_lp64_cblas();
     match p {
         ZtrsvProvider::Lp64(ztrsv) => {
@@ -618,6 +739,16 @@ pub unsafe extern "C" fn cblas_ztrsv_64(
     x: *mut Complex64,
     incx: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ztrsv,
+        Some(order),
+        [uplo as u8, trans as u8, diag as u8],
+        [n],
+        [lda, incx],
+    );
+    if unsafe { coalesce::trsv(order, uplo, trans, diag, n, a, lda, x, incx) } {
+        return;
+    }
     let p = get_ztrsv_for_ilp64_cblas();
     if matches!(p, ZtrsvProvider::Lp64(_))
         && crate::int_convert::to_lp64_array_i64(b"cblas_ztrsv_64\0", [(5, n), (7, lda), (9, incx)])
@@ -14,12 +14,18 @@ use std::ffi::c_char;
 use num_complex::{Complex32, Complex64};
 
 use crate::backend::{
-    get_cgemm_for_current_cblas, get_cgemm_for_ilp64_cblas, get_dgemm_for_current_cblas,
-    get_dgemm_for_ilp64_cblas, get_sgemm_for_current_cblas, get_sgemm_for_ilp64_cblas,
-    get_zgemm_for_current_cblas, get_zgemm_for_ilp64_cblas, BlasInt32, BlasInt64, CgemmProvider,
+    route_cgemm_for_ilp64_cblas, route_cgemm_for_lp64_cblas, route_dgemm_for_ilp64_cblas,
+    route_dgemm_for_lp64_cblas, route_sgemm_for_ilp64_cblas, route_sgemm_for_lp64_cblas,
+    route_zgemm_for_ilp64_cblas, route_zgemm_for_lp64_cblas, BlasInt32, BlasInt64, CgemmProvider,
     DgemmProvider, SgemmProvider, ZgemmProvider,
 };
-use crate::int_convert::{to_lp64_i64, unchecked_lp64_i64};
+use crate::blas3::{gemm3m, parallel};
+use crate::degenerate;
+use crate::dispatch;
+use crate::lp64_split;
+use crate::native::gemm::try_small_gemm;
+use crate::stats::Routine;
+use crate::trace::{self, Path};
 use crate::types::{transpose_to_char, CblasColMajor, CblasRowMajor, CBLAS_ORDER, CBLAS_TRANSPOSE};
 
 const CBLAS_SGEMM_64_ROUTINE: &[u8] = b"cblas_sgemm_64\0";
@@ -27,6 +33,7 @@ const CBLAS_CGEMM_64_ROUTINE: &[u8] = b"cblas_cgemm_64\0";
 const CBLAS_DGEMM_64_ROUTINE: &[u8] = b"cblas_dgemm_64\0";
 const CBLAS_ZGEMM_64_ROUTINE: &[u8] = b"cblas_zgemm_64\0";
 
+/// Check a `_64` GEMM for an LP64 provider; `m`, `n` and `k` may be split.
 #[inline]
 fn check_lp64_gemm_i64(
     routine: &[u8],
@@ -37,16 +44,15 @@ fn check_lp64_gemm_i64(
     ldb: i64,
     ldc: i64,
 ) -> bool {
-    to_lp64_i64(routine, 4, m).is_some()
-        && to_lp64_i64(routine, 5, n).is_some()
-        && to_lp64_i64(routine, 6, k).is_some()
-        && to_lp64_i64(routine, 9, lda).is_some()
-        && to_lp64_i64(routine, 11, ldb).is_some()
-        && to_lp64_i64(routine, 14, ldc).is_some()
+    lp64_split::check_i64(
+        routine,
+        [(9, lda), (11, ldb), (14, ldc)],
+        [(4, m), (5, n), (6, k)],
+    )
 }
 
 #[allow(clippy::too_many_arguments)]
-unsafe fn call_dgemm_provider(
+pub(crate) unsafe fn call_dgemm_provider(
     provider: DgemmProvider,
     transa: c_char,
     transb: c_char,
@@ -61,16 +67,39 @@ unsafe fn call_dgemm_provider(
     beta: f64,
     c: *mut f64,
     ldc: BlasInt32,
-) -> bool {
-    match provider {
-        DgemmProvider::Lp64(dgemm) => {
-            unsafe {
-                dgemm(
-                    &transa, &transb, &m, &n, &k, &alpha, a, &lda, b, &ldb, &beta, c, &ldc,
-                );
-            }
-            true
+) {
+    if let Some(tile) = parallel::tile_for(m.into(), n.into()) {
+        unsafe {
+            parallel::gemm(
+                transa,
+                transb,
+                m,
+                n,
+                k,
+                a,
+                lda,
+                b,
+                ldb,
+                beta,
+                c,
+                ldc,
+                tile,
+                &|blk| {
+                    call_dgemm_provider(
+                        provider, transa, transb, blk.m, blk.n, blk.k, alpha, blk.a, blk.lda,
+                        blk.b, blk.ldb, blk.beta, blk.c, blk.ldc,
+                    );
+                },
+            );
         }
+        return;
+    }
+    match provider {
+        DgemmProvider::Lp64(dgemm) => unsafe {
+            dgemm(
+                &transa, &transb, &m, &n, &k, &alpha, a, &lda, b, &ldb, &beta, c, &ldc,
+            );
+        },
         DgemmProvider::Ilp64(dgemm) => {
             let m = BlasInt64::from(m);
             let n = BlasInt64::from(n);
@@ -83,13 +112,12 @@ unsafe fn call_dgemm_provider(
                     &transa, &transb, &m, &n, &k, &alpha, a, &lda, b, &ldb, &beta, c, &ldc,
                 );
             }
-            true
         }
     }
 }
 
 #[allow(clippy::too_many_arguments)]
-unsafe fn call_zgemm_provider(
+pub(crate) unsafe fn call_zgemm_provider(
     provider: ZgemmProvider,
     transa: c_char,
     transb: c_char,
@@ -104,17 +132,106 @@ unsafe fn call_zgemm_provider(
     beta: *const Complex64,
     c: *mut Complex64,
     ldc: BlasInt32,
-) -> bool {
+) {
+    if let Some(tile) = parallel::tile_for(m.into(), n.into()) {
+        let alpha = unsafe { *alpha };
+        unsafe {
+            parallel::gemm(
+                transa,
+                transb,
+                m,
+                n,
+                k,
+                a,
+                lda,
+                b,
+                ldb,
+                *beta,
+                c,
+                ldc,
+                tile,
+                &|blk| {
+                    call_zgemm_provider(
+                        provider, transa, transb, blk.m, blk.n, blk.k, &alpha, blk.a, blk.lda,
+                        blk.b, blk.ldb, &blk.beta, blk.c, blk.ldc,
+                    );
+                },
+            );
+        }
+        return;
+    }
     match provider {
-        ZgemmProvider::Lp64(zgemm) => {
+        ZgemmProvider::Lp64(zgemm) => unsafe {
+            zgemm(
+                &transa, &transb, &m, &n, &k, alpha, a, &lda, b, &ldb, beta, c, &ldc,
+            );
+        },
+        ZgemmProvider::Ilp64(zgemm) => {
+            let m = BlasInt64::from(m);
+            let n = BlasInt64::from(n);
+            let k = BlasInt64::from(k);
+            let lda = BlasInt64::from(lda);
+            let ldb = BlasInt64::from(ldb);
+            let ldc = BlasInt64::from(ldc);
             unsafe {
                 zgemm(
                     &transa, &transb, &m, &n, &k, alpha, a, &lda, b, &ldb, beta, c, &ldc,
                 );
             }
-            true
         }
-        ZgemmProvider::Ilp64(zgemm) => {
+    }
+}
+
+#[allow(clippy::too_many_arguments)]
+pub(crate) unsafe fn call_sgemm_provider(
+    provider: SgemmProvider,
+    transa: c_char,
+    transb: c_char,
+    m: BlasInt32,
+    n: BlasInt32,
+    k: BlasInt32,
+    alpha: f32,
+    a: *const f32,
+    lda: BlasInt32,
+    b: *const f32,
+    ldb: BlasInt32,
+    beta: f32,
+    c: *mut f32,
+    ldc: BlasInt32,
+) {
+    if let Some(tile) = parallel::tile_for(m.into(), n.into()) {
+        unsafe {
+            parallel::gemm(
+                transa,
+                transb,
+                m,
+                n,
+                k,
+                a,
+                lda,
+                b,
+                ldb,
+                beta,
+                c,
+                ldc,
+                tile,
+                &|blk| {
+                    call_sgemm_provider(
+                        provider, transa, transb, blk.m, blk.n, blk.k, alpha, blk.a, blk.lda,
+                        blk.b, blk.ldb, blk.beta, blk.c, blk.ldc,
+                    );
+                },
+            );
+        }
+        return;
+    }
+    match provider {
+        SgemmProvider::Lp64(sgemm) => unsafe {
+            sgemm(
+                &transa, &transb, &m, &n, &k, &alpha, a, &lda, b, &ldb, &beta, c, &ldc,
+            );
+        },
+        SgemmProvider::Ilp64(sgemm) => {
             let m = BlasInt64::from(m);
             let n = BlasInt64::from(n);
             let k = BlasInt64::from(k);
@@ -122,17 +239,82 @@ unsafe fn call_zgemm_provider(
             let ldb = BlasInt64::from(ldb);
             let ldc = BlasInt64::from(ldc);
             unsafe {
-                zgemm(
+                sgemm(
+                    &transa, &transb, &m, &n, &k, &alpha, a, &lda, b, &ldb, &beta, c, &ldc,
+                );
+            }
+        }
+    }
+}
+
+#[allow(clippy::too_many_arguments)]
+pub(crate) unsafe fn call_cgemm_provider(
+    provider: CgemmProvider,
+    transa: c_char,
+    transb: c_char,
+    m: BlasInt32,
+    n: BlasInt32,
+    k: BlasInt32,
+    alpha: *const Complex32,
+    a: *const Complex32,
+    lda: BlasInt32,
+    b: *const Complex32,
+    ldb: BlasInt32,
+    beta: *const Complex32,
+    c: *mut Complex32,
+    ldc: BlasInt32,
+) {
+    if let Some(tile) = parallel::tile_for(m.into(), n.into()) {
+        let alpha = unsafe { *alpha };
+        unsafe {
+            parallel::gemm(
+                transa,
+                transb,
+                m,
+                n,
+                k,
+                a,
+                lda,
+                b,
+                ldb,
+                *beta,
+                c,
+                ldc,
+                tile,
+                &|blk| {
+                    call_cgemm_provider(
+                        provider, transa, transb, blk.m, blk.n, blk.k, &alpha, blk.a, blk.lda,
+                        blk.b, blk.ldb, &blk.beta, blk.c, blk.ldc,
+                    );
+                },
+            );
+        }
+        return;
+    }
+    match provider {
+        CgemmProvider::Lp64(cgemm) => unsafe {
+            cgemm(
+                &transa, &transb, &m, &n, &k, alpha, a, &lda, b, &ldb, beta, c, &ldc,
+            );
+        },
+        CgemmProvider::Ilp64(cgemm) => {
+            let m = BlasInt64::from(m);
+            let n = BlasInt64::from(n);
+            let k = BlasInt64::from(k);
+            let lda = BlasInt64::from(lda);
+            let ldb = BlasInt64::from(ldb);
+            let ldc = BlasInt64::from(ldc);
+            unsafe {
+                cgemm(
                     &transa, &transb, &m, &n, &k, alpha, a, &lda, b, &ldb, beta, c, &ldc,
                 );
             }
-            true
         }
     }
 }
 
 #[allow(clippy::too_many_arguments)]
-unsafe fn call_dgemm_provider_i64(
+pub(crate) unsafe fn call_dgemm_provider_i64(
     provider: DgemmProvider,
     transa: c_char,
     transb: c_char,
@@ -149,19 +331,29 @@ unsafe fn call_dgemm_provider_i64(
     ldc: i64,
 ) {
     match provider {
-        DgemmProvider::Lp64(dgemm) => {
-            let m = unchecked_lp64_i64(m);
-            let n = unchecked_lp64_i64(n);
-            let k = unchecked_lp64_i64(k);
-            let lda = unchecked_lp64_i64(lda);
-            let ldb = unchecked_lp64_i64(ldb);
-            let ldc = unchecked_lp64_i64(ldc);
-            unsafe {
-                dgemm(
-                    &transa, &transb, &m, &n, &k, &alpha, a, &lda, b, &ldb, &beta, c, &ldc,
-                );
-            }
-        }
+        DgemmProvider::Lp64(dgemm) => unsafe {
+            lp64_split::gemm(
+                transa,
+                transb,
+                m,
+                n,
+                k,
+                a,
+                lda,
+                b,
+                ldb,
+                beta,
+                1.0,
+                c,
+                ldc,
+                &|blk| {
+                    dgemm(
+                        &transa, &transb, &blk.m, &blk.n, &blk.k, &alpha, blk.a, &blk.lda, blk.b,
+                        &blk.ldb, &blk.beta, blk.c, &blk.ldc,
+                    )
+                },
+            );
+        },
         DgemmProvider::Ilp64(dgemm) => unsafe {
             dgemm(
                 &transa, &transb, &m, &n, &k, &alpha, a, &lda, b, &ldb, &beta, c, &ldc,
@@ -171,7 +363,7 @@ unsafe fn call_dgemm_provider_i64(
 }
 
 #[allow(clippy::too_many_arguments)]
-unsafe fn call_zgemm_provider_i64(
+pub(crate) unsafe fn call_zgemm_provider_i64(
     provider: ZgemmProvider,
     transa: c_char,
     transb: c_char,
@@ -188,19 +380,30 @@ unsafe fn call_zgemm_provider_i64(
     ldc: i64,
 ) {
     match provider {
-        ZgemmProvider::Lp64(zgemm) => {
-            let m = unchecked_lp64_i64(m);
-            let n = unchecked_lp64_i64(n);
-            let k = unchecked_lp64_i64(k);
-            let lda = unchecked_lp64_i64(lda);
-            let ldb = unchecked_lp64_i64(ldb);
-            let ldc = unchecked_lp64_i64(ldc);
-            unsafe {
-                zgemm(
-                    &transa, &transb, &m, &n, &k, alpha, a, &lda, b, &ldb, beta, c, &ldc,
-                );
-            }
-        }
+        ZgemmProvider::Lp64(zgemm) => unsafe {
+            let alpha = *alpha;
+            lp64_split::gemm(
+                transa,
+                transb,
+                m,
+                n,
+                k,
+                a,
+                lda,
+                b,
+                ldb,
+                *beta,
+                Complex64::new(1.0, 0.0),
+                c,
+                ldc,
+                &|blk| {
+                    zgemm(
+                        &transa, &transb, &blk.m, &blk.n, &blk.k, &alpha, blk.a, &blk.lda, blk.b,
+                        &blk.ldb, &blk.beta, blk.c, &blk.ldc,
+                    )
+                },
+            );
+        },
         ZgemmProvider::Ilp64(zgemm) => unsafe {
             zgemm(
                 &transa, &transb, &m, &n, &k, alpha, a, &lda, b, &ldb, beta, c, &ldc,
@@ -209,6 +412,105 @@ unsafe fn call_zgemm_provider_i64(
     }
 }
 
+#[allow(clippy::too_many_arguments)]
+pub(crate) unsafe fn call_sgemm_provider_i64(
+    provider: SgemmProvider,
+    transa: c_char,
+    transb: c_char,
+    m: i64,
+    n: i64,
+    k: i64,
+    alpha: f32,
+    a: *const f32,
+    lda: i64,
+    b: *const f32,
+    ldb: i64,
+    beta: f32,
+    c: *mut f32,
+    ldc: i64,
+) {
+    match provider {
+        SgemmProvider::Lp64(sgemm) => unsafe {
+            lp64_split::gemm(
+                transa,
+                transb,
+                m,
+                n,
+                k,
+                a,
+                lda,
+                b,
+                ldb,
+                beta,
+                1.0,
+                c,
+                ldc,
+                &|blk| {
+                    sgemm(
+                        &transa, &transb, &blk.m, &blk.n, &blk.k, &alpha, blk.a, &blk.lda, blk.b,
+                        &blk.ldb, &blk.beta, blk.c, &blk.ldc,
+                    )
+                },
+            );
+        },
+        SgemmProvider::Ilp64(sgemm) => unsafe {
+            sgemm(
+                &transa, &transb, &m, &n, &k, &alpha, a, &lda, b, &ldb, &beta, c, &ldc,
+            );
+        },
+    }
+}
+
+#[allow(clippy::too_many_arguments)]
+pub(crate) unsafe fn call_cgemm_provider_i64(
+    provider: CgemmProvider,
+    transa: c_char,
+    transb: c_char,
+    m: i64,
+    n: i64,
+    k: i64,
+    alpha: *const Complex32,
+    a: *const Complex32,
+    lda: i64,
+    b: *const Complex32,
+    ldb: i64,
+    beta: *const Complex32,
+    c: *mut Complex32,
+    ldc: i64,
+) {
+    match provider {
+        CgemmProvider::Lp64(cgemm) => unsafe {
+            let alpha = *alpha;
+            lp64_split::gemm(
+                transa,
+                transb,
+                m,
+                n,
+                k,
+                a,
+                lda,
+                b,
+                ldb,
+                *beta,
+                Complex32::new(1.0, 0.0),
+                c,
+                ldc,
+                &|blk| {
+                    cgemm(
+                        &transa, &transb, &blk.m, &blk.n, &blk.k, &alpha, blk.a, &blk.lda, blk.b,
+                        &blk.ldb, &blk.beta, blk.c, &blk.ldc,
+                    )
+                },
+            );
+        },
+        CgemmProvider::Ilp64(cgemm) => unsafe {
+            cgemm(
+                &transa, &transb, &m, &n, &k, alpha, a, &lda, b, &ldb, beta, c, &ldc,
+            );
+        },
+    }
+}
+
 /// Double precision general matrix multiply.
 ///
 /// Computes: C = alpha * op(A) * op(B) + beta * C
@@ -236,7 +538,55 @@ pub unsafe extern "C" fn cblas_dgemm(
     c: *mut f64,
     ldc: i32,
 ) {
-    let dgemm = get_dgemm_for_current_cblas();
+    let _call = dispatch::enter(
+        Routine::Dgemm,
+        Some(order),
+        [transa as u8, transb as u8],
+        [m, n, k],
+        [lda, ldb, ldc],
+    );
+    if try_small_gemm(
+        order,
+        transa,
+        transb,
+        i64::from(m),
+        i64::from(n),
+        i64::from(k),
+        alpha,
+        a,
+        i64::from(lda),
+        b,
+        i64::from(ldb),
+        beta,
+        c,
+        i64::from(ldc),
+    ) {
+        trace::dispatched(Path::Native);
+        return;
+    }
+
+    if let Some(path) = degenerate::gemm(
+        false,
+        order,
+        transa,
+        transb,
+        i64::from(m),
+        i64::from(n),
+        i64::from(k),
+        alpha,
+        a,
+        i64::from(lda),
+        b,
+        i64::from(ldb),
+        beta,
+        c,
+        i64::from(ldc),
+    ) {
+        trace::dispatched(path);
+        return;
+    }
+
+    let dgemm = route_dgemm_for_lp64_cblas(i64::from(m), i64::from(n), i64::from(k));
 
     match order {
         CblasColMajor => {
@@ -313,7 +663,28 @@ pub unsafe extern "C" fn cblas_dgemm_64(
     c: *mut f64,
     ldc: i64,
 ) {
-    let dgemm = get_dgemm_for_ilp64_cblas();
+    let _call = dispatch::enter(
+        Routine::Dgemm,
+        Some(order),
+        [transa as u8, transb as u8],
+        [m, n, k],
+        [lda, ldb, ldc],
+    );
+    if try_small_gemm(
+        order, transa, transb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc,
+    ) {
+        trace::dispatched(Path::Native);
+        return;
+    }
+
+    if let Some(path) = degenerate::gemm(
+        true, order, transa, transb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc,
+    ) {
+        trace::dispatched(path);
+        return;
+    }
+
+    let dgemm = route_dgemm_for_ilp64_cblas(m, n, k);
 
     if matches!(dgemm, DgemmProvider::Lp64(_))
         && !check_lp64_gemm_i64(CBLAS_DGEMM_64_ROUTINE, m, n, k, lda, ldb, ldc)
@@ -392,79 +763,95 @@ pub unsafe extern "C" fn cblas_sgemm(
     c: *mut f32,
     ldc: i32,
 ) {
-    let p = get_sgemm_for_current_cblas();
+    let _call = dispatch::enter(
+        Routine::Sgemm,
+        Some(order),
+        [transa as u8, transb as u8],
+        [m, n, k],
+        [lda, ldb, ldc],
+    );
+    if try_small_gemm(
+        order,
+        transa,
+        transb,
+        i64::from(m),
+        i64::from(n),
+        i64::from(k),
+        alpha,
+        a,
+        i64::from(lda),
+        b,
+        i64::from(ldb),
+        beta,
+        c,
+        i64::from(ldc),
+    ) {
+        trace::dispatched(Path::Native);
+        return;
+    }
+
+    if let Some(path) = degenerate::gemm(
+        false,
+        order,
+        transa,
+        transb,
+        i64::from(m),
+        i64::from(n),
+        i64::from(k),
+        alpha,
+        a,
+        i64::from(lda),
+        b,
+        i64::from(ldb),
+        beta,
+        c,
+        i64::from(ldc),
+    ) {
+        trace::dispatched(path);
+        return;
+    }
+
+    let p = route_sgemm_for_lp64_cblas(i64::from(m), i64::from(n), i64::from(k));
     match order {
         CblasColMajor => {
             let transa_char = transpose_to_char(transa);
             let transb_char = transpose_to_char(transb);
-            match p {
-                SgemmProvider::Lp64(f) => f(
-                    &transa_char,
-                    &transb_char,
-                    &m,
-                    &n,
-                    &k,
-                    &alpha,
-                    a,
-                    &lda,
-                    b,
-                    &ldb,
-                    &beta,
-                    c,
-                    &ldc,
-                ),
-                SgemmProvider::Ilp64(f) => f(
-                    &transa_char,
-                    &transb_char,
-                    &(m as i64),
-                    &(n as i64),
-                    &(k as i64),
-                    &alpha,
-                    a,
-                    &(lda as i64),
-                    b,
-                    &(ldb as i64),
-                    &beta,
-                    c,
-                    &(ldc as i64),
-                ),
-            }
+            call_sgemm_provider(
+                p,
+                transa_char,
+                transb_char,
+                m,
+                n,
+                k,
+                alpha,
+                a,
+                lda,
+                b,
+                ldb,
+                beta,
+                c,
+                ldc,
+            );
         }
         CblasRowMajor => {
             let transa_char = transpose_to_char(transb);
             let transb_char = transpose_to_char(transa);
-            match p {
-                SgemmProvider::Lp64(f) => f(
-                    &transa_char,
-                    &transb_char,
-                    &n,
-                    &m,
-                    &k,
-                    &alpha,
-                    b,
-                    &ldb,
-                    a,
-                    &lda,
-                    &beta,
-                    c,
-                    &ldc,
-                ),
-                SgemmProvider::Ilp64(f) => f(
-                    &transa_char,
-                    &transb_char,
-                    &(n as i64),
-                    &(m as i64),
-                    &(k as i64),
-                    &alpha,
-                    b,
-                    &(ldb as i64),
-                    a,
-                    &(lda as i64),
-                    &beta,
-                    c,
-                    &(ldc as i64),
-                ),
-            }
+            call_sgemm_provider(
+                p,
+                transa_char,
+                transb_char,
+                n,
+                m,
+                k,
+                alpha,
+                b,
+                ldb,
+                a,
+                lda,
+                beta,
+                c,
+                ldc,
+            );
         }
     }
 }
@@ -488,7 +875,28 @@ pub unsafe extern "C" fn cblas_sgemm_64(
     c: *mut f32,
     ldc: i64,
 ) {
-    let p = get_sgemm_for_ilp64_cblas();
+    let _call = dispatch::enter(
+        Routine::Sgemm,
+        Some(order),
+        [transa as u8, transb as u8],
+        [m, n, k],
+        [lda, ldb, ldc],
+    );
+    if try_small_gemm(
+        order, transa, transb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc,
+    ) {
+        trace::dispatched(Path::Native);
+        return;
+    }
+
+    if let Some(path) = degenerate::gemm(
+        true, order, transa, transb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc,
+    ) {
+        trace::dispatched(path);
+        return;
+    }
+
+    let p = route_sgemm_for_ilp64_cblas(m, n, k);
 
     if matches!(p, SgemmProvider::Lp64(_))
         && !check_lp64_gemm_i64(CBLAS_SGEMM_64_ROUTINE, m, n, k, lda, ldb, ldc)
@@ -500,74 +908,42 @@ pub unsafe extern "C" fn cblas_sgemm_64(
         CblasColMajor => {
             let transa_char = transpose_to_char(transa);
             let transb_char = transpose_to_char(transb);
-            match p {
-                SgemmProvider::Ilp64(f) => f(
-                    &transa_char,
-                    &transb_char,
-                    &m,
-                    &n,
-                    &k,
-                    &alpha,
-                    a,
-                    &lda,
-                    b,
-                    &ldb,
-                    &beta,
-                    c,
-                    &ldc,
-                ),
-                SgemmProvider::Lp64(f) => f(
-                    &transa_char,
-                    &transb_char,
-                    &(m as i32),
-                    &(n as i32),
-                    &(k as i32),
-                    &alpha,
-                    a,
-                    &(lda as i32),
-                    b,
-                    &(ldb as i32),
-                    &beta,
-                    c,
-                    &(ldc as i32),
-                ),
-            }
+            call_sgemm_provider_i64(
+                p,
+                transa_char,
+                transb_char,
+                m,
+                n,
+                k,
+                alpha,
+                a,
+                lda,
+                b,
+                ldb,
+                beta,
+                c,
+                ldc,
+            );
         }
         CblasRowMajor => {
             let transa_char = transpose_to_char(transb);
             let transb_char = transpose_to_char(transa);
-            match p {
-                SgemmProvider::Ilp64(f) => f(
-                    &transa_char,
-                    &transb_char,
-                    &n,
-                    &m,
-                    &k,
-                    &alpha,
-                    b,
-                    &ldb,
-                    a,
-                    &lda,
-                    &beta,
-                    c,
-                    &ldc,
-                ),
-                SgemmProvider::Lp64(f) => f(
-                    &transa_char,
-                    &transb_char,
-                    &(n as i32),
-                    &(m as i32),
-                    &(k as i32),
-                    &alpha,
-                    b,
-                    &(ldb as i32),
-                    a,
-                    &(lda as i32),
-                    &beta,
-                    c,
-                    &(ldc as i32),
-                ),
-            }
+            call_sgemm_provider_i64(
+                p,
+                transa_char,
+                transb_char,
+                n,
+                m,
+                k,
+                alpha,
+                b,
+                ldb,
+                a,
+                lda,
+                beta,
+                c,
+                ldc,
+            );
         }
     }
 }
@@ -599,8 +975,83 @@ pub unsafe extern "C" fn cblas_zgemm(
     c: *mut Complex64,
     ldc: i32,
 ) {
-    let zgemm = get_zgemm_for_current_cblas();
+    let _call = dispatch::enter(
+        Routine::Zgemm,
+        Some(order),
+        [transa as u8, transb as u8],
+        [m, n, k],
+        [lda, ldb, ldc],
+    );
+    if try_small_gemm(
+        order,
+        transa,
+        transb,
+        i64::from(m),
+        i64::from(n),
+        i64::from(k),
+        unsafe { *alpha },
+        a,
+        i64::from(lda),
+        b,
+        i64::from(ldb),
+        unsafe { *beta },
+        c,
+        i64::from(ldc),
+    ) {
+        trace::dispatched(Path::Native);
+        return;
+    }
 
+    if let Some(path) = degenerate::gemm(
+        false,
+        order,
+        transa,
+        transb,
+        i64::from(m),
+        i64::from(n),
+        i64::from(k),
+        unsafe { *alpha },
+        a,
+        i64::from(lda),
+        b,
+        i64::from(ldb),
+        unsafe { *beta },
+        c,
+        i64::from(ldc),
+    ) {
+        trace::dispatched(path);
+        return;
+    }
+
+    let zgemm = gemm3m::zgemm_for_lp64_cblas(i64::from(m), i64::from(n), i64::from(k))
+        .unwrap_or_else(|| route_zgemm_for_lp64_cblas(i64::from(m), i64::from(n), i64::from(k)));
+    unsafe {
+        zgemm_lp64(
+            zgemm, order, transa, transb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc,
+        )
+    }
+}
+
+/// Trace and run an LP64 CBLAS ZGEMM on `zgemm`; a row-major call swaps
+/// the operands.
+#[allow(clippy::too_many_arguments)]
+pub(crate) unsafe fn zgemm_lp64(
+    zgemm: ZgemmProvider,
+    order: CBLAS_ORDER,
+    transa: CBLAS_TRANSPOSE,
+    transb: CBLAS_TRANSPOSE,
+    m: i32,
+    n: i32,
+    k: i32,
+    alpha: *const Complex64,
+    a: *const Complex64,
+    lda: i32,
+    b: *const Complex64,
+    ldb: i32,
+    beta: *const Complex64,
+    c: *mut Complex64,
+    ldc: i32,
+) {
     match order {
         CblasColMajor => {
             let transa_char = transpose_to_char(transa);
@@ -674,10 +1125,101 @@ pub unsafe extern "C" fn cblas_zgemm_64(
     c: *mut Complex64,
     ldc: i64,
 ) {
-    let zgemm = get_zgemm_for_ilp64_cblas();
+    let _call = dispatch::enter(
+        Routine::Zgemm,
+        Some(order),
+        [transa as u8, transb as u8],
+        [m, n, k],
+        [lda, ldb, ldc],
+    );
+    if try_small_gemm(
+        order,
+        transa,
+        transb,
+        m,
+        n,
+        k,
+        unsafe { *alpha },
+        a,
+        lda,
+        b,
+        ldb,
+        unsafe { *beta },
+        c,
+        ldc,
+    ) {
+        trace::dispatched(Path::Native);
+        return;
+    }
+
+    if let Some(path) = degenerate::gemm(
+        true,
+        order,
+        transa,
+        transb,
+        m,
+        n,
+        k,
+        unsafe { *alpha },
+        a,
+        lda,
+        b,
+        ldb,
+        unsafe { *beta },
+        c,
+        ldc,
+    ) {
+        trace::dispatched(path);
+        return;
+    }
+
+    let zgemm = gemm3m::zgemm_for_ilp64_cblas(m, n, k)
+        .unwrap_or_else(|| route_zgemm_for_ilp64_cblas(m, n, k));
+    unsafe {
+        zgemm_ilp64(
+            zgemm,
+            CBLAS_ZGEMM_64_ROUTINE,
+            order,
+            transa,
+            transb,
+            m,
+            n,
+            k,
+            alpha,
+            a,
+            lda,
+            b,
+            ldb,
+            beta,
+            c,
+            ldc,
+        )
+    }
+}
 
+/// Trace and run an ILP64 CBLAS ZGEMM on `zgemm`; a row-major call swaps
+/// the operands. `routine` names the entry point in argument errors.
+#[allow(clippy::too_many_arguments)]
+pub(crate) unsafe fn zgemm_ilp64(
+    zgemm: ZgemmProvider,
+    routine: &[u8],
+    order: CBLAS_ORDER,
+    transa: CBLAS_TRANSPOSE,
+    transb: CBLAS_TRANSPOSE,
+    m: i64,
+    n: i64,
+    k: i64,
+    alpha: *const Complex64,
+    a: *const Complex64,
+    lda: i64,
+    b: *const Complex64,
+    ldb: i64,
+    beta: *const Complex64,
+    c: *mut Complex64,
+    ldc: i64,
+) {
     if matches!(zgemm, ZgemmProvider::Lp64(_))
-        && !check_lp64_gemm_i64(CBLAS_ZGEMM_64_ROUTINE, m, n, k, lda, ldb, ldc)
+        && !check_lp64_gemm_i64(routine, m, n, k, lda, ldb, ldc)
     {
         return;
     }
@@ -753,79 +1295,123 @@ pub unsafe extern "C" fn cblas_cgemm(
     c: *mut Complex32,
     ldc: i32,
 ) {
-    let p = get_cgemm_for_current_cblas();
+    let _call = dispatch::enter(
+        Routine::Cgemm,
+        Some(order),
+        [transa as u8, transb as u8],
+        [m, n, k],
+        [lda, ldb, ldc],
+    );
+    if try_small_gemm(
+        order,
+        transa,
+        transb,
+        i64::from(m),
+        i64::from(n),
+        i64::from(k),
+        unsafe { *alpha },
+        a,
+        i64::from(lda),
+        b,
+        i64::from(ldb),
+        unsafe { *beta },
+        c,
+        i64::from(ldc),
+    ) {
+        trace::dispatched(Path::Native);
+        return;
+    }
+
+    if let Some(path) = degenerate::gemm(
+        false,
+        order,
+        transa,
+        transb,
+        i64::from(m),
+        i64::from(n),
+        i64::from(k),
+        unsafe { *alpha },
+        a,
+        i64::from(lda),
+        b,
+        i64::from(ldb),
+        unsafe { *beta },
+        c,
+        i64::from(ldc),
+    ) {
+        trace::dispatched(path);
+        return;
+    }
+
+    let p = gemm3m::cgemm_for_lp64_cblas(i64::from(m), i64::from(n), i64::from(k))
+        .unwrap_or_else(|| route_cgemm_for_lp64_cblas(i64::from(m), i64::from(n), i64::from(k)));
+    unsafe {
+        cgemm_lp64(
+            p, order, transa, transb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc,
+        )
+    }
+}
+
+/// Trace and run an LP64 CBLAS CGEMM on `p`; a row-major call swaps
+/// the operands.
+#[allow(clippy::too_many_arguments)]
+pub(crate) unsafe fn cgemm_lp64(
+    p: CgemmProvider,
+    order: CBLAS_ORDER,
+    transa: CBLAS_TRANSPOSE,
+    transb: CBLAS_TRANSPOSE,
+    m: i32,
+    n: i32,
+    k: i32,
+    alpha: *const Complex32,
+    a: *const Complex32,
+    lda: i32,
+    b: *const Complex32,
+    ldb: i32,
+    beta: *const Complex32,
+    c: *mut Complex32,
+    ldc: i32,
+) {
     match order {
         CblasColMajor => {
             let transa_char = transpose_to_char(transa);
             let transb_char = transpose_to_char(transb);
-            match p {
-                CgemmProvider::Lp64(f) => f(
-                    &transa_char,
-                    &transb_char,
-                    &m,
-                    &n,
-                    &k,
-                    alpha,
-                    a,
-                    &lda,
-                    b,
-                    &ldb,
-                    beta,
-                    c,
-                    &ldc,
-                ),
-                CgemmProvider::Ilp64(f) => f(
-                    &transa_char,
-                    &transb_char,
-                    &(m as i64),
-                    &(n as i64),
-                    &(k as i64),
-                    alpha,
-                    a,
-                    &(lda as i64),
-                    b,
-                    &(ldb as i64),
-                    beta,
-                    c,
-                    &(ldc as i64),
-                ),
-            }
+            call_cgemm_provider(
+                p,
+                transa_char,
+                transb_char,
+                m,
+                n,
+                k,
+                alpha,
+                a,
+                lda,
+                b,
+                ldb,
+                beta,
+                c,
+                ldc,
+            );
         }
         CblasRowMajor => {
             let transa_char = transpose_to_char(transb);
             let transb_char = transpose_to_char(transa);
-            match p {
-                CgemmProvider::Lp64(f) => f(
-                    &transa_char,
-                    &transb_char,
-                    &n,
-                    &m,
-                    &k,
-                    alpha,
-                    b,
-                    &ldb,
-                    a,
-                    &lda,
-                    beta,
-                    c,
-                    &ldc,
-                ),
-                CgemmProvider::Ilp64(f) => f(
-                    &transa_char,
-                    &transb_char,
-                    &(n as i64),
-                    &(m as i64),
-                    &(k as i64),
-                    alpha,
-                    b,
-                    &(ldb as i64),
-                    a,
-                    &(lda as i64),
-                    beta,
-                    c,
-                    &(ldc as i64),
-                ),
-            }
+            call_cgemm_provider(
+                p,
+                transa_char,
+                transb_char,
+                n,
+                m,
+                k,
+                alpha,
+                b,
+                ldb,
+                a,
+                lda,
+                beta,
+                c,
+                ldc,
+            );
         }
     }
 }
@@ -849,10 +1435,100 @@ pub unsafe extern "C" fn cblas_cgemm_64(
     c: *mut Complex32,
     ldc: i64,
 ) {
-    let p = get_cgemm_for_ilp64_cblas();
+    let _call = dispatch::enter(
+        Routine::Cgemm,
+        Some(order),
+        [transa as u8, transb as u8],
+        [m, n, k],
+        [lda, ldb, ldc],
+    );
+    if try_small_gemm(
+        order,
+        transa,
+        transb,
+        m,
+        n,
+        k,
+        unsafe { *alpha },
+        a,
+        lda,
+        b,
+        ldb,
+        unsafe { *beta },
+        c,
+        ldc,
+    ) {
+        trace::dispatched(Path::Native);
+        return;
+    }
 
-    if matches!(p, CgemmProvider::Lp64(_))
-        && !check_lp64_gemm_i64(CBLAS_CGEMM_64_ROUTINE, m, n, k, lda, ldb, ldc)
+    if let Some(path) = degenerate::gemm(
+        true,
+        order,
+        transa,
+        transb,
+        m,
+        n,
+        k,
+        unsafe { *alpha },
+        a,
+        lda,
+        b,
+        ldb,
+        unsafe { *beta },
+        c,
+        ldc,
+    ) {
+        trace::dispatched(path);
+        return;
+    }
+
+    let p = gemm3m::cgemm_for_ilp64_cblas(m, n, k)
+        .unwrap_or_else(|| route_cgemm_for_ilp64_cblas(m, n, k));
+    unsafe {
+        cgemm_ilp64(
+            p,
+            CBLAS_CGEMM_64_ROUTINE,
+            order,
+            transa,
+            transb,
+            m,
+            n,
+            k,
+            alpha,
+            a,
+            lda,
+            b,
+            ldb,
+            beta,
+            c,
+            ldc,
+        )
+    }
+}
+
+/// Trace and run an ILP64 CBLAS CGEMM on `p`; a row-major call swaps
+/// the operands. `routine` names the entry point in argument errors.
+#[allow(clippy::too_many_arguments)]
+pub(crate) unsafe fn cgemm_ilp64(
+    p: CgemmProvider,
+    routine: &[u8],
+    order: CBLAS_ORDER,
+    transa: CBLAS_TRANSPOSE,
+    transb: CBLAS_TRANSPOSE,
+    m: i64,
+    n: i64,
+    k: i64,
+    alpha: *const Complex32,
+    a: *const Complex32,
+    lda: i64,
+    b: *const Complex32,
+    ldb: i64,
+    beta: *const Complex32,
+    c: *mut Complex32,
+    ldc: i64,
+) {
+    if matches!(p, CgemmProvider::Lp64(_)) && !check_lp64_gemm_i64(routine, m, n, k, lda, ldb, ldc)
     {
         return;
     }
@@ -861,74 +1537,42 @@ pub unsafe extern "C" fn cblas_cgemm_64(
         CblasColMajor => {
             let transa_char = transpose_to_char(transa);
             let transb_char = transpose_to_char(transb);
-            match p {
-                CgemmProvider::Ilp64(f) => f(
-                    &transa_char,
-                    &transb_char,
-                    &m,
-                    &n,
-                    &k,
-                    alpha,
-                    a,
-                    &lda,
-                    b,
-                    &ldb,
-                    beta,
-                    c,
-                    &ldc,
-                ),
-                CgemmProvider::Lp64(f) => f(
-                    &transa_char,
-                    &transb_char,
-                    &(m as i32),
-                    &(n as i32),
-                    &(k as i32),
-                    alpha,
-                    a,
-                    &(lda as i32),
-                    b,
-                    &(ldb as i32),
-                    beta,
-                    c,
-                    &(ldc as i32),
-                ),
-            }
+            call_cgemm_provider_i64(
+                p,
+                transa_char,
+                transb_char,
+                m,
+                n,
+                k,
+                alpha,
+                a,
+                lda,
+                b,
+                ldb,
+                beta,
+                c,
+                ldc,
+            );
         }
         CblasRowMajor => {
             let transa_char = transpose_to_char(transb);
             let transb_char = transpose_to_char(transa);
-            match p {
-                CgemmProvider::Ilp64(f) => f(
-                    &transa_char,
-                    &transb_char,
-                    &n,
-                    &m,
-                    &k,
-                    alpha,
-                    b,
-                    &ldb,
-                    a,
-                    &lda,
-                    beta,
-                    c,
-                    &ldc,
-                ),
-                CgemmProvider::Lp64(f) => f(
-                    &transa_char,
-                    &transb_char,
-                    &(n as i32),
-                    &(m as i32),
-                    &(k as i32),
-                    alpha,
-                    b,
-                    &(ldb as i32),
-                    a,
-                    &(lda as i32),
-                    beta,
-                    c,
-                    &(ldc as i32),
-                ),
-            }
+            call_cgemm_provider_i64(
+                p,
+                transa_char,
+                transb_char,
+                n,
+                m,
+                k,
+                alpha,
+                b,
+                ldb,
+                a,
+                lda,
+                beta,
+                c,
+                ldc,
+            );
         }
     }
 }
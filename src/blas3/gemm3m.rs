@@ -0,0 +1,339 @@
+//! 3M complex GEMM (`cgemm3m_`, `zgemm3m_`) - CBLAS interface and routing.
+//!
+//! The 3M variants exported by OpenBLAS and MKL form each complex product
+//! from three real matrix multiplications instead of four, at the cost of
+//! slightly different rounding. They share the GEMM signature, so the
+//! entry points reuse the GEMM row-major swap and provider calls.
+//!
+//! `cblas_cgemm3m` and `cblas_zgemm3m` go to the registered 3M provider, or
+//! to the regular GEMM provider when none is registered. With a threshold
+//! set through `cblas_inject_set_gemm3m_min_flops`, `cblas_cgemm` and
+//! `cblas_zgemm` calls of at least that many flops (8*m*n*k, as for size
+//! routes) also go to the 3M provider. The threshold is checked before size
+//! routes, and calls below it or without a 3M provider are unaffected. A
+//! thread's provider scope that supplies a GEMM but no 3M routine keeps its
+//! GEMM for covered calls too.
+
+use std::sync::atomic::{AtomicU64, Ordering};
+
+use num_complex::{Complex32, Complex64};
+
+use crate::backend::{
+    route_cgemm_for_ilp64_cblas, route_cgemm_for_lp64_cblas, route_zgemm_for_ilp64_cblas,
+    route_zgemm_for_lp64_cblas, try_get_cgemm3m_for_ilp64_cblas, try_get_cgemm3m_for_lp64_cblas,
+    try_get_zgemm3m_for_ilp64_cblas, try_get_zgemm3m_for_lp64_cblas, Cgemm3mProvider,
+    CgemmProvider, Zgemm3mProvider, ZgemmProvider, CBLAS_INJECT_STATUS_INVALID_ARGUMENT,
+    CBLAS_INJECT_STATUS_OK,
+};
+use crate::blas3::gemm::{cgemm_ilp64, cgemm_lp64, zgemm_ilp64, zgemm_lp64};
+use crate::dispatch::{self, DispatchTable};
+use crate::stats::Routine;
+use crate::types::{CBLAS_ORDER, CBLAS_TRANSPOSE};
+
+const CBLAS_CGEMM3M_64_ROUTINE: &[u8] = b"cblas_cgemm3m_64\0";
+const CBLAS_ZGEMM3M_64_ROUTINE: &[u8] = b"cblas_zgemm3m_64\0";
+
+/// Bits of the `f64` flop threshold; 0.0 keeps GEMM calls on GEMM.
+static GEMM3M_MIN_FLOPS: AtomicU64 = AtomicU64::new(0);
+
+/// Send `cblas_cgemm`/`cblas_zgemm` calls of at least `min_flops` to 3M.
+///
+/// Flops count 8*m*n*k, as for size routes. 0 (the default) turns the
+/// policy off. Returns `CBLAS_INJECT_STATUS_INVALID_ARGUMENT` for a
+/// negative or NaN threshold.
+#[no_mangle]
+pub extern "C" fn cblas_inject_set_gemm3m_min_flops(min_flops: f64) -> i32 {
+    if min_flops.is_nan() || min_flops < 0.0 {
+        return CBLAS_INJECT_STATUS_INVALID_ARGUMENT;
+    }
+    GEMM3M_MIN_FLOPS.store(min_flops.to_bits(), Ordering::Relaxed);
+    CBLAS_INJECT_STATUS_OK
+}
+
+/// Current value set with `cblas_inject_set_gemm3m_min_flops`.
+#[no_mangle]
+pub extern "C" fn cblas_inject_gemm3m_min_flops() -> f64 {
+    f64::from_bits(GEMM3M_MIN_FLOPS.load(Ordering::Relaxed))
+}
+
+/// Whether the 3M policy covers an `m x n x k` complex GEMM.
+#[inline]
+fn above_threshold(m: i64, n: i64, k: i64) -> bool {
+    let min_flops = f64::from_bits(GEMM3M_MIN_FLOPS.load(Ordering::Relaxed));
+    min_flops > 0.0 && 8.0 * m.max(0) as f64 * n.max(0) as f64 * k.max(0) as f64 >= min_flops
+}
+
+impl From<Cgemm3mProvider> for CgemmProvider {
+    fn from(p: Cgemm3mProvider) -> Self {
+        match p {
+            Cgemm3mProvider::Lp64(f) => CgemmProvider::Lp64(f),
+            Cgemm3mProvider::Ilp64(f) => CgemmProvider::Ilp64(f),
+        }
+    }
+}
+
+impl From<Zgemm3mProvider> for ZgemmProvider {
+    fn from(p: Zgemm3mProvider) -> Self {
+        match p {
+            Zgemm3mProvider::Lp64(f) => ZgemmProvider::Lp64(f),
+            Zgemm3mProvider::Ilp64(f) => ZgemmProvider::Ilp64(f),
+        }
+    }
+}
+
+/// Whether the thread's provider scope supplies a GEMM but no 3M routine;
+/// `slots` reports whether the scope has (3M, GEMM) for the calling ABI.
+#[inline]
+fn scope_keeps_gemm(slots: impl FnOnce(&DispatchTable) -> (bool, bool)) -> bool {
+    dispatch::scoped(|t| {
+        let (gemm3m, gemm) = slots(t);
+        Some(gemm && !gemm3m)
+    })
+    .unwrap_or(false)
+}
+
+/// 3M provider for an LP64 `cblas_cgemm` covered by the policy.
+#[inline]
+pub(crate) fn cgemm_for_lp64_cblas(m: i64, n: i64, k: i64) -> Option<CgemmProvider> {
+    if !above_threshold(m, n, k)
+        || scope_keeps_gemm(|t| (t.cgemm3m.lp64_cblas.is_some(), t.cgemm.lp64_cblas.is_some()))
+    {
+        return None;
+    }
+    try_get_cgemm3m_for_lp64_cblas().map(CgemmProvider::from)
+}
+
+/// 3M provider for an ILP64 `cblas_cgemm_64` covered by the policy.
+#[inline]
+pub(crate) fn cgemm_for_ilp64_cblas(m: i64, n: i64, k: i64) -> Option<CgemmProvider> {
+    if !above_threshold(m, n, k)
+        || scope_keeps_gemm(|t| {
+            (
+                t.cgemm3m.ilp64_cblas.is_some(),
+                t.cgemm.ilp64_cblas.is_some(),
+            )
+        })
+    {
+        return None;
+    }
+    try_get_cgemm3m_for_ilp64_cblas().map(CgemmProvider::from)
+}
+
+/// 3M provider for an LP64 `cblas_zgemm` covered by the policy.
+#[inline]
+pub(crate) fn zgemm_for_lp64_cblas(m: i64, n: i64, k: i64) -> Option<ZgemmProvider> {
+    if !above_threshold(m, n, k)
+        || scope_keeps_gemm(|t| (t.zgemm3m.lp64_cblas.is_some(), t.zgemm.lp64_cblas.is_some()))
+    {
+        return None;
+    }
+    try_get_zgemm3m_for_lp64_cblas().map(ZgemmProvider::from)
+}
+
+/// 3M provider for an ILP64 `cblas_zgemm_64` covered by the policy.
+#[inline]
+pub(crate) fn zgemm_for_ilp64_cblas(m: i64, n: i64, k: i64) -> Option<ZgemmProvider> {
+    if !above_threshold(m, n, k)
+        || scope_keeps_gemm(|t| {
+            (
+                t.zgemm3m.ilp64_cblas.is_some(),
+                t.zgemm.ilp64_cblas.is_some(),
+            )
+        })
+    {
+        return None;
+    }
+    try_get_zgemm3m_for_ilp64_cblas().map(ZgemmProvider::from)
+}
+
+/// Single precision complex general matrix multiply with the 3M algorithm.
+///
+/// Computes: C = alpha * op(A) * op(B) + beta * C
+///
+/// # Safety
+///
+/// - All pointers must be valid and properly aligned
+/// - Matrix dimensions and leading dimensions must be consistent
+/// - cgemm3m or cgemm must be registered
+#[no_mangle]
+#[allow(clippy::too_many_arguments)]
+pub unsafe extern "C" fn cblas_cgemm3m(
+    order: CBLAS_ORDER,
+    transa: CBLAS_TRANSPOSE,
+    transb: CBLAS_TRANSPOSE,
+    m: i32,
+    n: i32,
+    k: i32,
+    alpha: *const Complex32,
+    a: *const Complex32,
+    lda: i32,
+    b: *const Complex32,
+    ldb: i32,
+    beta: *const Complex32,
+    c: *mut Complex32,
+    ldc: i32,
+) {
+    let _call = dispatch::enter(
+        Routine::Cgemm,
+        Some(order),
+        [transa as u8, transb as u8],
+        [m, n, k],
+        [lda, ldb, ldc],
+    );
+    let p = try_get_cgemm3m_for_lp64_cblas()
+        .map(CgemmProvider::from)
+        .unwrap_or_else(|| route_cgemm_for_lp64_cblas(i64::from(m), i64::from(n), i64::from(k)));
+    unsafe {
+        cgemm_lp64(
+            p, order, transa, transb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc,
+        )
+    }
+}
+
+/// Single precision complex 3M general matrix multiply with ILP64 CBLAS
+/// integer ABI.
+#[no_mangle]
+#[allow(clippy::too_many_arguments)]
+pub unsafe extern "C" fn cblas_cgemm3m_64(
+    order: CBLAS_ORDER,
+    transa: CBLAS_TRANSPOSE,
+    transb: CBLAS_TRANSPOSE,
+    m: i64,
+    n: i64,
+    k: i64,
+    alpha: *const Complex32,
+    a: *const Complex32,
+    lda: i64,
+    b: *const Complex32,
+    ldb: i64,
+    beta: *const Complex32,
+    c: *mut Complex32,
+    ldc: i64,
+) {
+    let _call = dispatch::enter(
+        Routine::Cgemm,
+        Some(order),
+        [transa as u8, transb as u8],
+        [m, n, k],
+        [lda, ldb, ldc],
+    );
+    let p = try_get_cgemm3m_for_ilp64_cblas()
+        .map(CgemmProvider::from)
+        .unwrap_or_else(|| route_cgemm_for_ilp64_cblas(m, n, k));
+    unsafe {
+        cgemm_ilp64(
+            p,
+            CBLAS_CGEMM3M_64_ROUTINE,
+            order,
+            transa,
+            transb,
+            m,
+            n,
+            k,
+            alpha,
+            a,
+            lda,
+            b,
+            ldb,
+            beta,
+            c,
+            ldc,
+        )
+    }
+}
+
+/// Double precision complex general matrix multiply with the 3M algorithm.
+///
+/// Computes: C = alpha * op(A) * op(B) + beta * C
+///
+/// # Safety
+///
+/// - All pointers must be valid and properly aligned
+/// - Matrix dimensions and leading dimensions must be consistent
+/// - zgemm3m or zgemm must be registered
+#[no_mangle]
+#[allow(clippy::too_many_arguments)]
+pub unsafe extern "C" fn cblas_zgemm3m(
+    order: CBLAS_ORDER,
+    transa: CBLAS_TRANSPOSE,
+    transb: CBLAS_TRANSPOSE,
+    m: i32,
+    n: i32,
+    k: i32,
+    alpha: *const Complex64,
+    a: *const Complex64,
+    lda: i32,
+    b: *const Complex64,
+    ldb: i32,
+    beta: *const Complex64,
+    c: *mut Complex64,
+    ldc: i32,
+) {
+    let _call = dispatch::enter(
+        Routine::Zgemm,
+        Some(order),
+        [transa as u8, transb as u8],
+        [m, n, k],
+        [lda, ldb, ldc],
+    );
+    let zgemm = try_get_zgemm3m_for_lp64_cblas()
+        .map(ZgemmProvider::from)
+        .unwrap_or_else(|| route_zgemm_for_lp64_cblas(i64::from(m), i64::from(n), i64::from(k)));
+    unsafe {
+        zgemm_lp64(
+            zgemm, order, transa, transb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc,
+        )
+    }
+}
+
+/// Double precision complex 3M general matrix multiply with ILP64 CBLAS
+/// integer ABI.
+#[no_mangle]
+#[allow(clippy::too_many_arguments)]
+pub unsafe extern "C" fn cblas_zgemm3m_64(
+    order: CBLAS_ORDER,
+    transa: CBLAS_TRANSPOSE,
+    transb: CBLAS_TRANSPOSE,
+    m: i64,
+    n: i64,
+    k: i64,
+    alpha: *const Complex64,
+    a: *const Complex64,
+    lda: i64,
+    b: *const Complex64,
+    ldb: i64,
+    beta: *const Complex64,
+    c: *mut Complex64,
+    ldc: i64,
+) {
+    let _call = dispatch::enter(
+        Routine::Zgemm,
+        Some(order),
+        [transa as u8, transb as u8],
+        [m, n, k],
+        [lda, ldb, ldc],
+    );
+    let zgemm = try_get_zgemm3m_for_ilp64_cblas()
+        .map(ZgemmProvider::from)
+        .unwrap_or_else(|| route_zgemm_for_ilp64_cblas(m, n, k));
+    unsafe {
+        zgemm_ilp64(
+            zgemm,
+            CBLAS_ZGEMM3M_64_ROUTINE,
+            order,
+            transa,
+            transb,
+            m,
+            n,
+            k,
+            alpha,
+            a,
+            lda,
+            b,
+            ldb,
+            beta,
+            c,
+            ldc,
+        )
+    }
+}
@@ -0,0 +1,738 @@
+//! Batched general matrix multiply - MKL-compatible CBLAS extension.
+//!
+//! Computes: C_i = alpha * op(A_i) * op(B_i) + beta * C_i for every item i
+//!
+//! Two forms are provided, following MKL's `cblas_?gemm_batch` and
+//! `cblas_?gemm_batch_strided`:
+//!
+//! - grouped: `group_count` groups, each sharing its shape, transposes and
+//!   scalars across `group_size[g]` items whose matrices come from pointer
+//!   arrays indexed over the whole batch;
+//! - strided: one shape for `batch_size` items at fixed element strides from
+//!   the base pointers.
+//!
+//! Routing, the native small GEMM crossover, row-major conversion and the
+//! LP64 range check are decided once per group rather than once per item.
+//! With `cblas_inject_set_worker_threads` above 1, items are spread across
+//! the worker pool; that is only useful with a single-threaded provider.
+//!
+//! Row-major conversion logic derived from OpenBLAS.
+//! Copyright (c) 2011-2014, The OpenBLAS Project. BSD-3-Clause License.
+//! <https://github.com/OpenMathLib/OpenBLAS/blob/develop/interface/gemm.c>
+
+use std::ffi::{c_char, c_int};
+
+use num_complex::{Complex32, Complex64};
+
+use crate::backend::{
+    route_cgemm_for_ilp64_cblas, route_cgemm_for_lp64_cblas, route_dgemm_for_ilp64_cblas,
+    route_dgemm_for_lp64_cblas, route_sgemm_for_ilp64_cblas, route_sgemm_for_lp64_cblas,
+    route_zgemm_for_ilp64_cblas, route_zgemm_for_lp64_cblas, CgemmProvider, DgemmProvider,
+    SgemmProvider, ZgemmProvider,
+};
+use crate::dispatch;
+use crate::int_convert::{to_lp64_array_i64, unchecked_lp64_i64};
+use crate::native::gemm::{small_gemm, small_gemm_eligible};
+use crate::native::Scalar;
+use crate::pool;
+use crate::stats::Routine;
+use crate::trace::{self, Path};
+use crate::types::{transpose_to_char, CblasColMajor, CblasRowMajor, CBLAS_ORDER, CBLAS_TRANSPOSE};
+use crate::xerbla::cblas_xerbla;
+
+/// `xerbla` positions of m, n, k, lda, ldb, ldc in the grouped entry points.
+const GROUPED_DIM_PARAMS: [c_int; 6] = [4, 5, 6, 9, 11, 14];
+/// `xerbla` positions of m, n, k, lda, ldb, ldc in the strided entry points.
+const STRIDED_DIM_PARAMS: [c_int; 6] = [4, 5, 6, 9, 12, 16];
+
+/// Element type of a batched GEMM and its provider.
+trait BatchGemm: Scalar + Send + Sync {
+    type Provider: Copy + Send + Sync;
+
+    const ROUTINE: Routine;
+
+    fn route(ilp64_cblas: bool, m: i64, n: i64, k: i64) -> Self::Provider;
+
+    fn is_lp64(provider: Self::Provider) -> bool;
+
+    /// Call the provider with column-major arguments that fit its ABI.
+    #[allow(clippy::too_many_arguments)]
+    unsafe fn call(
+        provider: Self::Provider,
+        transa: c_char,
+        transb: c_char,
+        m: i64,
+        n: i64,
+        k: i64,
+        alpha: &Self,
+        a: *const Self,
+        lda: i64,
+        b: *const Self,
+        ldb: i64,
+        beta: &Self,
+        c: *mut Self,
+        ldc: i64,
+    );
+}
+
+macro_rules! impl_batch_gemm {
+    ($t:ty, $routine:ident, $provider:ident, $route_lp64:ident, $route_ilp64:ident) => {
+        impl BatchGemm for $t {
+            type Provider = $provider;
+
+            const ROUTINE: Routine = Routine::$routine;
+
+            #[inline]
+            fn route(ilp64_cblas: bool, m: i64, n: i64, k: i64) -> $provider {
+                if ilp64_cblas {
+                    $route_ilp64(m, n, k)
+                } else {
+                    $route_lp64(m, n, k)
+                }
+            }
+
+            #[inline]
+            fn is_lp64(provider: $provider) -> bool {
+                matches!(provider, $provider::Lp64(_))
+            }
+
+            #[inline]
+            unsafe fn call(
+                provider: $provider,
+                transa: c_char,
+                transb: c_char,
+                m: i64,
+                n: i64,
+                k: i64,
+                alpha: &$t,
+                a: *const $t,
+                lda: i64,
+                b: *const $t,
+                ldb: i64,
+                beta: &$t,
+                c: *mut $t,
+                ldc: i64,
+            ) {
+                match provider {
+                    $provider::Lp64(gemm) => {
+                        let m = unchecked_lp64_i64(m);
+                        let n = unchecked_lp64_i64(n);
+                        let k = unchecked_lp64_i64(k);
+                        let lda = unchecked_lp64_i64(lda);
+                        let ldb = unchecked_lp64_i64(ldb);
+                        let ldc = unchecked_lp64_i64(ldc);
+                        unsafe {
+                            gemm(
+                                &transa, &transb, &m, &n, &k, alpha, a, &lda, b, &ldb, beta, c,
+                                &ldc,
+                            );
+                        }
+                    }
+                    $provider::Ilp64(gemm) => unsafe {
+                        gemm(
+                            &transa, &transb, &m, &n, &k, alpha, a, &lda, b, &ldb, beta, c, &ldc,
+                        );
+                    },
+                }
+            }
+        }
+    };
+}
+
+impl_batch_gemm!(
+    f32,
+    Sgemm,
+    SgemmProvider,
+    route_sgemm_for_lp64_cblas,
+    route_sgemm_for_ilp64_cblas
+);
+impl_batch_gemm!(
+    f64,
+    Dgemm,
+    DgemmProvider,
+    route_dgemm_for_lp64_cblas,
+    route_dgemm_for_ilp64_cblas
+);
+impl_batch_gemm!(
+    Complex32,
+    Cgemm,
+    CgemmProvider,
+    route_cgemm_for_lp64_cblas,
+    route_cgemm_for_ilp64_cblas
+);
+impl_batch_gemm!(
+    Complex64,
+    Zgemm,
+    ZgemmProvider,
+    route_zgemm_for_lp64_cblas,
+    route_zgemm_for_ilp64_cblas
+);
+
+/// How every item of a group is computed.
+#[derive(Clone, Copy)]
+enum Route<P> {
+    Native,
+    Provider(P),
+    /// Rejected by the LP64 range check, already reported via `xerbla`.
+    Skip,
+}
+
+/// One group of items sharing shape, transposes and scalars.
+struct Group<T: BatchGemm> {
+    /// Batch index of the group's first item.
+    start: usize,
+    transa: CBLAS_TRANSPOSE,
+    transb: CBLAS_TRANSPOSE,
+    m: i64,
+    n: i64,
+    k: i64,
+    alpha: T,
+    lda: i64,
+    ldb: i64,
+    beta: T,
+    ldc: i64,
+    route: Route<T::Provider>,
+    path: Path,
+}
+
+/// Where the matrices of item `i` live.
+enum Operands<T> {
+    Arrays {
+        a: *const *const T,
+        b: *const *const T,
+        c: *const *mut T,
+    },
+    Strided {
+        a: *const T,
+        stridea: i64,
+        b: *const T,
+        strideb: i64,
+        c: *mut T,
+        stridec: i64,
+    },
+}
+
+impl<T> Operands<T> {
+    #[inline]
+    unsafe fn item(&self, i: usize) -> (*const T, *const T, *mut T) {
+        match *self {
+            Operands::Arrays { a, b, c } => unsafe { (*a.add(i), *b.add(i), *c.add(i)) },
+            Operands::Strided {
+                a,
+                stridea,
+                b,
+                strideb,
+                c,
+                stridec,
+            } => {
+                let i = i as i64;
+                (
+                    a.wrapping_offset((i * stridea) as isize),
+                    b.wrapping_offset((i * strideb) as isize),
+                    c.wrapping_offset((i * stridec) as isize),
+                )
+            }
+        }
+    }
+}
+
+struct Batch<T: BatchGemm> {
+    order: CBLAS_ORDER,
+    groups: Vec<Group<T>>,
+    operands: Operands<T>,
+}
+
+// Items write disjoint C matrices (a caller requirement), so the raw operand
+// pointers may be shared across the worker pool.
+unsafe impl<T: BatchGemm> Sync for Batch<T> {}
+
+impl<T: BatchGemm> Batch<T> {
+    fn new(order: CBLAS_ORDER, operands: Operands<T>) -> Self {
+        Batch {
+            order,
+            groups: Vec::new(),
+            operands,
+        }
+    }
+
+    /// Add a group of `size` items, deciding its route once.
+    #[allow(clippy::too_many_arguments)]
+    fn push_group(
+        &mut self,
+        routine: &[u8],
+        dim_params: [c_int; 6],
+        ilp64_cblas: bool,
+        start: usize,
+        size: usize,
+        transa: CBLAS_TRANSPOSE,
+        transb: CBLAS_TRANSPOSE,
+        m: i64,
+        n: i64,
+        k: i64,
+        alpha: T,
+        lda: i64,
+        ldb: i64,
+        beta: T,
+        ldc: i64,
+    ) {
+        if size == 0 {
+            return;
+        }
+        let mut path = Path::Native;
+        let route = if small_gemm_eligible::<T>(self.order, transa, transb, m, n, k, lda, ldb, ldc)
+        {
+            Route::Native
+        } else {
+            let provider = T::route(ilp64_cblas, m, n, k);
+            path = if ilp64_cblas {
+                Path::ilp64(!T::is_lp64(provider))
+            } else {
+                Path::lp64(!T::is_lp64(provider))
+            };
+            let [pm, pn, pk, plda, pldb, pldc] = dim_params;
+            if ilp64_cblas
+                && T::is_lp64(provider)
+                && to_lp64_array_i64(
+                    routine,
+                    [
+                        (pm, m),
+                        (pn, n),
+                        (pk, k),
+                        (plda, lda),
+                        (pldb, ldb),
+                        (pldc, ldc),
+                    ],
+                )
+                .is_none()
+            {
+                Route::Skip
+            } else {
+                Route::Provider(provider)
+            }
+        };
+        self.groups.push(Group {
+            start,
+            transa,
+            transb,
+            m,
+            n,
+            k,
+            alpha,
+            lda,
+            ldb,
+            beta,
+            ldc,
+            route,
+            path,
+        });
+    }
+
+    unsafe fn run_item(&self, i: usize) {
+        let g = &self.groups[self.groups.partition_point(|g| g.start <= i) - 1];
+        let _call = dispatch::enter(
+            T::ROUTINE,
+            Some(self.order),
+            [g.transa as u8, g.transb as u8],
+            [g.m, g.n, g.k],
+            [g.lda, g.ldb, g.ldc],
+        );
+        trace::dispatched(g.path);
+        let (a, b, c) = unsafe { self.operands.item(i) };
+        match g.route {
+            Route::Skip => {}
+            Route::Native => unsafe {
+                small_gemm(
+                    self.order, g.transa, g.transb, g.m, g.n, g.k, g.alpha, a, g.lda, b, g.ldb,
+                    g.beta, c, g.ldc,
+                );
+            },
+            Route::Provider(provider) => match self.order {
+                CblasColMajor => unsafe {
+                    T::call(
+                        provider,
+                        transpose_to_char(g.transa),
+                        transpose_to_char(g.transb),
+                        g.m,
+                        g.n,
+                        g.k,
+                        &g.alpha,
+                        a,
+                        g.lda,
+                        b,
+                        g.ldb,
+                        &g.beta,
+                        c,
+                        g.ldc,
+                    );
+                },
+                CblasRowMajor => unsafe {
+                    // Row-major: swap A↔B, m↔n, lda↔ldb, TransA↔TransB
+                    // Following OpenBLAS: https://github.com/OpenMathLib/OpenBLAS/blob/develop/interface/gemm.c#L489-L537
+                    T::call(
+                        provider,
+                        transpose_to_char(g.transb),
+                        transpose_to_char(g.transa),
+                        g.n,
+                        g.m,
+                        g.k,
+                        &g.alpha,
+                        b,
+                        g.ldb,
+                        a,
+                        g.lda,
+                        &g.beta,
+                        c,
+                        g.ldc,
+                    );
+                },
+            },
+        }
+    }
+
+    /// Run all `len` items, across the worker pool when it is enabled.
+    unsafe fn run(&self, len: usize) {
+        if self.groups.is_empty() {
+            return;
+        }
+        pool::parallel_for(len, &|i| unsafe { self.run_item(i) });
+    }
+}
+
+/// Report a negative count through `xerbla`, else convert it.
+#[inline]
+fn batch_count(routine: &[u8], param: c_int, count: i64) -> Option<usize> {
+    match usize::try_from(count) {
+        Ok(count) => Some(count),
+        Err(_) => {
+            unsafe {
+                cblas_xerbla(param, routine.as_ptr().cast(), std::ptr::null());
+            }
+            None
+        }
+    }
+}
+
+#[allow(clippy::too_many_arguments)]
+unsafe fn gemm_batch<T: BatchGemm, I: Copy + Into<i64>>(
+    routine: &[u8],
+    ilp64_cblas: bool,
+    order: CBLAS_ORDER,
+    transa_array: *const CBLAS_TRANSPOSE,
+    transb_array: *const CBLAS_TRANSPOSE,
+    m_array: *const I,
+    n_array: *const I,
+    k_array: *const I,
+    alpha_array: *const T,
+    a_array: *const *const T,
+    lda_array: *const I,
+    b_array: *const *const T,
+    ldb_array: *const I,
+    beta_array: *const T,
+    c_array: *const *mut T,
+    ldc_array: *const I,
+    group_count: I,
+    group_size: *const I,
+) {
+    let Some(group_count) = batch_count(routine, 15, group_count.into()) else {
+        return;
+    };
+    let mut batch = Batch::new(
+        order,
+        Operands::Arrays {
+            a: a_array,
+            b: b_array,
+            c: c_array,
+        },
+    );
+    let mut len = 0;
+    for g in 0..group_count {
+        let Some(size) = batch_count(routine, 16, unsafe { *group_size.add(g) }.into()) else {
+            return;
+        };
+        unsafe {
+            batch.push_group(
+                routine,
+                GROUPED_DIM_PARAMS,
+                ilp64_cblas,
+                len,
+                size,
+                *transa_array.add(g),
+                *transb_array.add(g),
+                (*m_array.add(g)).into(),
+                (*n_array.add(g)).into(),
+                (*k_array.add(g)).into(),
+                *alpha_array.add(g),
+                (*lda_array.add(g)).into(),
+                (*ldb_array.add(g)).into(),
+                *beta_array.add(g),
+                (*ldc_array.add(g)).into(),
+            );
+        }
+        len += size;
+    }
+    unsafe { batch.run(len) };
+}
+
+#[allow(clippy::too_many_arguments)]
+unsafe fn gemm_batch_strided<T: BatchGemm, I: Copy + Into<i64>>(
+    routine: &[u8],
+    ilp64_cblas: bool,
+    order: CBLAS_ORDER,
+    transa: CBLAS_TRANSPOSE,
+    transb: CBLAS_TRANSPOSE,
+    m: I,
+    n: I,
+    k: I,
+    alpha: T,
+    a: *const T,
+    lda: I,
+    stridea: I,
+    b: *const T,
+    ldb: I,
+    strideb: I,
+    beta: T,
+    c: *mut T,
+    ldc: I,
+    stridec: I,
+    batch_size: I,
+) {
+    let Some(len) = batch_count(routine, 18, batch_size.into()) else {
+        return;
+    };
+    let mut batch = Batch::new(
+        order,
+        Operands::Strided {
+            a,
+            stridea: stridea.into(),
+            b,
+            strideb: strideb.into(),
+            c,
+            stridec: stridec.into(),
+        },
+    );
+    batch.push_group(
+        routine,
+        STRIDED_DIM_PARAMS,
+        ilp64_cblas,
+        0,
+        len,
+        transa,
+        transb,
+        m.into(),
+        n.into(),
+        k.into(),
+        alpha,
+        lda.into(),
+        ldb.into(),
+        beta,
+        ldc.into(),
+    );
+    unsafe { batch.run(len) };
+}
+
+/// Scalar argument of the strided entry points: by value for real types, by
+/// pointer for complex ones.
+trait ScalarArg<T> {
+    unsafe fn load(self) -> T;
+}
+
+impl ScalarArg<f32> for f32 {
+    #[inline]
+    unsafe fn load(self) -> f32 {
+        self
+    }
+}
+
+impl ScalarArg<f64> for f64 {
+    #[inline]
+    unsafe fn load(self) -> f64 {
+        self
+    }
+}
+
+impl ScalarArg<Complex32> for *const Complex32 {
+    #[inline]
+    unsafe fn load(self) -> Complex32 {
+        unsafe { *self }
+    }
+}
+
+impl ScalarArg<Complex64> for *const Complex64 {
+    #[inline]
+    unsafe fn load(self) -> Complex64 {
+        unsafe { *self }
+    }
+}
+
+macro_rules! define_gemm_batch {
+    (
+        $t:ty,
+        $scalar:ty,
+        $desc:literal,
+        $batch:ident,
+        $batch_64:ident,
+        $strided:ident,
+        $strided_64:ident
+    ) => {
+        define_gemm_batch!(@grouped $t, $desc, $batch, i32, false);
+        define_gemm_batch!(@grouped $t, $desc, $batch_64, i64, true);
+        define_gemm_batch!(@strided $t, $scalar, $desc, $strided, i32, false);
+        define_gemm_batch!(@strided $t, $scalar, $desc, $strided_64, i64, true);
+    };
+    (@grouped $t:ty, $desc:literal, $name:ident, $int:ty, $ilp64:literal) => {
+        #[doc = concat!($desc, " grouped batched general matrix multiply.")]
+        ///
+        /// Group `g` holds `group_size[g]` items that share `transa_array[g]`,
+        /// `m_array[g]`, `alpha_array[g]` and so on; `a_array`, `b_array` and
+        /// `c_array` hold one pointer per item across all groups, in order.
+        ///
+        /// # Safety
+        ///
+        /// - Every per-group array must hold `group_count` entries and every
+        ///   pointer array one entry per item
+        /// - All matrix pointers must be valid for their group's shape
+        /// - No two items may write the same C matrix
+        /// - The matching gemm must be registered unless every group is
+        ///   handled by the native small GEMM path
+        #[no_mangle]
+        #[allow(clippy::too_many_arguments)]
+        pub unsafe extern "C" fn $name(
+            order: CBLAS_ORDER,
+            transa_array: *const CBLAS_TRANSPOSE,
+            transb_array: *const CBLAS_TRANSPOSE,
+            m_array: *const $int,
+            n_array: *const $int,
+            k_array: *const $int,
+            alpha_array: *const $t,
+            a_array: *const *const $t,
+            lda_array: *const $int,
+            b_array: *const *const $t,
+            ldb_array: *const $int,
+            beta_array: *const $t,
+            c_array: *const *mut $t,
+            ldc_array: *const $int,
+            group_count: $int,
+            group_size: *const $int,
+        ) {
+            gemm_batch(
+                concat!(stringify!($name), "\0").as_bytes(),
+                $ilp64,
+                order,
+                transa_array,
+                transb_array,
+                m_array,
+                n_array,
+                k_array,
+                alpha_array,
+                a_array,
+                lda_array,
+                b_array,
+                ldb_array,
+                beta_array,
+                c_array,
+                ldc_array,
+                group_count,
+                group_size,
+            );
+        }
+    };
+    (@strided $t:ty, $scalar:ty, $desc:literal, $name:ident, $int:ty, $ilp64:literal) => {
+        #[doc = concat!($desc, " strided batched general matrix multiply.")]
+        ///
+        /// Item `i` uses `a + i * stridea`, `b + i * strideb` and
+        /// `c + i * stridec` (strides in elements) with a shared shape.
+        ///
+        /// # Safety
+        ///
+        /// - All matrix pointers must be valid for `batch_size` items
+        /// - The C matrices of different items must not overlap
+        /// - The matching gemm must be registered unless the shape is handled
+        ///   by the native small GEMM path
+        #[no_mangle]
+        #[allow(clippy::too_many_arguments)]
+        pub unsafe extern "C" fn $name(
+            order: CBLAS_ORDER,
+            transa: CBLAS_TRANSPOSE,
+            transb: CBLAS_TRANSPOSE,
+            m: $int,
+            n: $int,
+            k: $int,
+            alpha: $scalar,
+            a: *const $t,
+            lda: $int,
+            stridea: $int,
+            b: *const $t,
+            ldb: $int,
+            strideb: $int,
+            beta: $scalar,
+            c: *mut $t,
+            ldc: $int,
+            stridec: $int,
+            batch_size: $int,
+        ) {
+            let routine = concat!(stringify!($name), "\0").as_bytes();
+            if batch_size == 0 {
+                return;
+            }
+            gemm_batch_strided::<$t, $int>(
+                routine,
+                $ilp64,
+                order,
+                transa,
+                transb,
+                m,
+                n,
+                k,
+                alpha.load(),
+                a,
+                lda,
+                stridea,
+                b,
+                ldb,
+                strideb,
+                beta.load(),
+                c,
+                ldc,
+                stridec,
+                batch_size,
+            );
+        }
+    };
+}
+
+define_gemm_batch!(
+    f32,
+    f32,
+    "Single precision",
+    cblas_sgemm_batch,
+    cblas_sgemm_batch_64,
+    cblas_sgemm_batch_strided,
+    cblas_sgemm_batch_strided_64
+);
+define_gemm_batch!(
+    f64,
+    f64,
+    "Double precision",
+    cblas_dgemm_batch,
+    cblas_dgemm_batch_64,
+    cblas_dgemm_batch_strided,
+    cblas_dgemm_batch_strided_64
+);
+define_gemm_batch!(
+    Complex32,
+    *const Complex32,
+    "Single precision complex",
+    cblas_cgemm_batch,
+    cblas_cgemm_batch_64,
+    cblas_cgemm_batch_strided,
+    cblas_cgemm_batch_strided_64
+);
+define_gemm_batch!(
+    Complex64,
+    *const Complex64,
+    "Double precision complex",
+    cblas_zgemm_batch,
+    cblas_zgemm_batch_64,
+    cblas_zgemm_batch_strided,
+    cblas_zgemm_batch_strided_64
+);
@@ -0,0 +1,604 @@
+//! Triangular-output general matrix multiply (GEMMT) - CBLAS interface.
+//!
+//! Computes: C = alpha * op(A) * op(B) + beta * C
+//! for the `uplo` triangle of the n x n matrix C only; the other triangle is
+//! not referenced.
+//!
+//! Calls go to a registered `?gemmt_` provider (MKL, OpenBLAS 0.3.22+,
+//! reference BLAS 3.11+). Without one, [`blocked`] runs the product on the
+//! registered GEMM: every block column of C is one GEMM over its
+//! off-diagonal part and one GEMM into scratch for its diagonal block, of
+//! which only the requested triangle is merged into C. Block columns run on
+//! the worker pool.
+//!
+//! A row-major call is the column-major GEMMT of C^T: A and B swap along
+//! with their transpose flags, as for GEMM, and the triangle flips, as for
+//! SYRK.
+
+use std::ffi::c_char;
+use std::ops::{Add, Mul};
+
+use num_complex::{Complex32, Complex64};
+
+use crate::backend::{
+    route_cgemm_for_ilp64_cblas, route_cgemm_for_lp64_cblas, route_dgemm_for_ilp64_cblas,
+    route_dgemm_for_lp64_cblas, route_sgemm_for_ilp64_cblas, route_sgemm_for_lp64_cblas,
+    route_zgemm_for_ilp64_cblas, route_zgemm_for_lp64_cblas, try_get_cgemmt_for_ilp64_cblas,
+    try_get_cgemmt_for_lp64_cblas, try_get_dgemmt_for_ilp64_cblas, try_get_dgemmt_for_lp64_cblas,
+    try_get_sgemmt_for_ilp64_cblas, try_get_sgemmt_for_lp64_cblas, try_get_zgemmt_for_ilp64_cblas,
+    try_get_zgemmt_for_lp64_cblas, BlasInt32, CgemmProvider, CgemmtProvider, DgemmProvider,
+    DgemmtProvider, SgemmProvider, SgemmtProvider, ZgemmProvider, ZgemmtProvider,
+};
+use crate::blas3::gemm::{
+    call_cgemm_provider, call_cgemm_provider_i64, call_dgemm_provider, call_dgemm_provider_i64,
+    call_sgemm_provider, call_sgemm_provider_i64, call_zgemm_provider, call_zgemm_provider_i64,
+};
+use crate::dispatch;
+use crate::lp64_split::{self, transposed, Blocks, Shared};
+use crate::pool;
+use crate::scratch::{self, ScratchElem};
+use crate::stats::Routine;
+use crate::types::{
+    transpose_to_char, uplo_to_char, CblasColMajor, CblasLower, CblasRowMajor, CblasUpper,
+    CBLAS_ORDER, CBLAS_TRANSPOSE, CBLAS_UPLO,
+};
+use crate::xerbla::cblas_xerbla;
+
+/// Order of the diagonal blocks of the GEMM fallback.
+const BLOCK: i64 = 128;
+
+/// Fortran flags and operands of a GEMMT in column-major terms.
+struct View<T, I> {
+    uplo: c_char,
+    transa: c_char,
+    transb: c_char,
+    a: *const T,
+    lda: I,
+    b: *const T,
+    ldb: I,
+}
+
+impl<T, I> View<T, I> {
+    #[allow(clippy::too_many_arguments)]
+    fn new(
+        order: CBLAS_ORDER,
+        uplo: CBLAS_UPLO,
+        transa: CBLAS_TRANSPOSE,
+        transb: CBLAS_TRANSPOSE,
+        a: *const T,
+        lda: I,
+        b: *const T,
+        ldb: I,
+    ) -> Self {
+        match order {
+            CblasColMajor => View {
+                uplo: uplo_to_char(uplo),
+                transa: transpose_to_char(transa),
+                transb: transpose_to_char(transb),
+                a,
+                lda,
+                b,
+                ldb,
+            },
+            CblasRowMajor => View {
+                uplo: uplo_to_char(match uplo {
+                    CblasUpper => CblasLower,
+                    CblasLower => CblasUpper,
+                }),
+                transa: transpose_to_char(transb),
+                transb: transpose_to_char(transa),
+                a: b,
+                lda: ldb,
+                b: a,
+                ldb: lda,
+            },
+        }
+    }
+}
+
+/// Report the first invalid size argument through `xerbla`, as a provider
+/// GEMMT would, before the fallback splits the call into GEMMs.
+#[allow(clippy::too_many_arguments)]
+fn check(
+    routine: &[u8],
+    order: CBLAS_ORDER,
+    transa: CBLAS_TRANSPOSE,
+    transb: CBLAS_TRANSPOSE,
+    n: i64,
+    k: i64,
+    lda: i64,
+    ldb: i64,
+    ldc: i64,
+) -> bool {
+    // A is n x k and B is k x n as stored, unless transposed; row-major
+    // storage swaps which extent the leading dimension spans.
+    let row_major = matches!(order, CblasRowMajor);
+    let a_rows = if transposed(transpose_to_char(transa)) == row_major {
+        n
+    } else {
+        k
+    };
+    let b_rows = if transposed(transpose_to_char(transb)) == row_major {
+        k
+    } else {
+        n
+    };
+    let param = if n < 0 {
+        5
+    } else if k < 0 {
+        6
+    } else if lda < a_rows.max(1) {
+        9
+    } else if ldb < b_rows.max(1) {
+        11
+    } else if ldc < n.max(1) {
+        14
+    } else {
+        return true;
+    };
+    unsafe { cblas_xerbla(param, routine.as_ptr().cast(), std::ptr::null()) };
+    false
+}
+
+/// Provider GEMM `(m, n, a, b, beta, c, ldc)` on `m` rows of op(A) and `n`
+/// columns of op(B), with the call's flags, `k`, `alpha` and operand leading
+/// dimensions.
+type BlockCall<'a, T> = dyn Fn(i64, i64, *const T, *const T, T, *mut T, i64) + Sync + 'a;
+
+/// Run a column-major GEMMT with `n > 0` as GEMMs, one block column of C per
+/// task.
+#[allow(clippy::too_many_arguments)]
+unsafe fn blocked<T>(
+    uplo: c_char,
+    transa: c_char,
+    transb: c_char,
+    n: i64,
+    a: *const T,
+    lda: i64,
+    b: *const T,
+    ldb: i64,
+    beta: T,
+    zero: T,
+    c: *mut T,
+    ldc: i64,
+    gemm: &BlockCall<'_, T>,
+) where
+    T: ScratchElem + Send + Sync + PartialEq + Add<Output = T> + Mul<Output = T>,
+{
+    let lower = uplo == b'L' as c_char;
+    let (a, b, c) = (Shared::new(a), Shared::new(b), Shared::new(c));
+    // Row i of op(A) and column j of op(B).
+    let row = |i: i64| unsafe {
+        if transposed(transa) {
+            a.at(0, i, lda).cast_const()
+        } else {
+            a.at(i, 0, lda).cast_const()
+        }
+    };
+    let col = |j: i64| unsafe {
+        if transposed(transb) {
+            b.at(j, 0, ldb).cast_const()
+        } else {
+            b.at(0, j, ldb).cast_const()
+        }
+    };
+    let blocks = Blocks::new(n, BLOCK);
+    pool::parallel_for(blocks.count, &|i| {
+        let (j0, len) = blocks.get(i);
+        let len = i64::from(len);
+        let end = j0 + len;
+        let (r0, rows) = if lower { (end, n - end) } else { (0, j0) };
+        if rows > 0 {
+            gemm(
+                rows,
+                len,
+                row(r0),
+                col(j0),
+                beta,
+                unsafe { c.at(r0, j0, ldc) },
+                ldc,
+            );
+        }
+
+        // beta = 0 overwrites the whole block, so its old contents never leak.
+        let mut diag = scratch::take::<T>((len * len) as usize);
+        gemm(len, len, row(j0), col(j0), zero, diag.as_mut_ptr(), len);
+        for j in 0..len {
+            let rows = if lower { j..len } else { 0..j + 1 };
+            for i in rows {
+                let t = diag[(i + j * len) as usize];
+                let cij = unsafe { &mut *c.at(j0 + i, j0 + j, ldc) };
+                // beta = 0 must not read C, which may hold NaN.
+                *cij = if beta == zero { t } else { t + beta * *cij };
+            }
+        }
+    });
+}
+
+macro_rules! define_gemmt {
+    (
+        $doc:literal,
+        $name:ident,
+        $name_64:ident,
+        $routine:ident,
+        $t:ty,
+        $scalar:ty,
+        $value:expr,
+        $gemm_scalar:expr,
+        $zero:expr,
+        $provider:ident,
+        $try_lp64:ident,
+        $try_ilp64:ident,
+        $gemm_provider:ident,
+        $route_lp64:ident,
+        $route_ilp64:ident,
+        $call:ident,
+        $call_i64:ident
+    ) => {
+        #[doc = $doc]
+        ///
+        /// Computes: C = alpha * op(A) * op(B) + beta * C on the `uplo`
+        /// triangle of C.
+        ///
+        /// # Safety
+        ///
+        /// - All pointers must be valid and properly aligned
+        /// - Matrix dimensions and leading dimensions must be consistent
+        /// - The gemmt or gemm routine of this precision must be registered
+        #[no_mangle]
+        #[allow(clippy::too_many_arguments)]
+        pub unsafe extern "C" fn $name(
+            order: CBLAS_ORDER,
+            uplo: CBLAS_UPLO,
+            transa: CBLAS_TRANSPOSE,
+            transb: CBLAS_TRANSPOSE,
+            n: i32,
+            k: i32,
+            alpha: $scalar,
+            a: *const $t,
+            lda: i32,
+            b: *const $t,
+            ldb: i32,
+            beta: $scalar,
+            c: *mut $t,
+            ldc: i32,
+        ) {
+            let _call = dispatch::enter(
+                Routine::$routine,
+                Some(order),
+                [uplo as u8, transa as u8, transb as u8],
+                [n, k],
+                [lda, ldb, ldc],
+            );
+            let (alpha, beta): ($t, $t) = (($value)(alpha), ($value)(beta));
+            let [caller_lda, caller_ldb] = [lda, ldb].map(i64::from);
+            let View {
+                uplo: uplo_char,
+                transa: transa_char,
+                transb: transb_char,
+                a,
+                lda,
+                b,
+                ldb,
+            } = View::new(order, uplo, transa, transb, a, lda, b, ldb);
+
+            if let Some(p) = $try_lp64() {
+                match p {
+                    $provider::Lp64(f) => unsafe {
+                        f(
+                            &uplo_char,
+                            &transa_char,
+                            &transb_char,
+                            &n,
+                            &k,
+                            &alpha,
+                            a,
+                            &lda,
+                            b,
+                            &ldb,
+                            &beta,
+                            c,
+                            &ldc,
+                        )
+                    },
+                    $provider::Ilp64(f) => {
+                        let [n, k, lda, ldb, ldc] = [n, k, lda, ldb, ldc].map(i64::from);
+                        unsafe {
+                            f(
+                                &uplo_char,
+                                &transa_char,
+                                &transb_char,
+                                &n,
+                                &k,
+                                &alpha,
+                                a,
+                                &lda,
+                                b,
+                                &ldb,
+                                &beta,
+                                c,
+                                &ldc,
+                            )
+                        }
+                    }
+                }
+                return;
+            }
+
+            let gemm = $route_lp64(i64::from(n), i64::from(n), i64::from(k));
+            let routine = concat!(stringify!($name), "\0").as_bytes();
+            let [n64, k64, ldc64] = [n, k, ldc].map(i64::from);
+            if !check(
+                routine, order, transa, transb, n64, k64, caller_lda, caller_ldb, ldc64,
+            ) || n == 0
+            {
+                return;
+            }
+            unsafe {
+                blocked(
+                    uplo_char,
+                    transa_char,
+                    transb_char,
+                    n64,
+                    a,
+                    i64::from(lda),
+                    b,
+                    i64::from(ldb),
+                    beta,
+                    $zero,
+                    c,
+                    ldc64,
+                    &|m, bn, a, b, beta, c, ldc| {
+                        $call(
+                            gemm,
+                            transa_char,
+                            transb_char,
+                            m as BlasInt32,
+                            bn as BlasInt32,
+                            k,
+                            ($gemm_scalar)(&alpha),
+                            a,
+                            lda,
+                            b,
+                            ldb,
+                            ($gemm_scalar)(&beta),
+                            c,
+                            ldc as BlasInt32,
+                        );
+                    },
+                );
+            }
+        }
+
+        #[doc = $doc]
+        ///
+        /// ILP64 CBLAS integer ABI variant.
+        ///
+        /// # Safety
+        ///
+        /// - All pointers must be valid and properly aligned
+        /// - Matrix dimensions and leading dimensions must be consistent
+        /// - The gemmt or gemm routine of this precision must be registered
+        #[no_mangle]
+        #[allow(clippy::too_many_arguments)]
+        pub unsafe extern "C" fn $name_64(
+            order: CBLAS_ORDER,
+            uplo: CBLAS_UPLO,
+            transa: CBLAS_TRANSPOSE,
+            transb: CBLAS_TRANSPOSE,
+            n: i64,
+            k: i64,
+            alpha: $scalar,
+            a: *const $t,
+            lda: i64,
+            b: *const $t,
+            ldb: i64,
+            beta: $scalar,
+            c: *mut $t,
+            ldc: i64,
+        ) {
+            let _call = dispatch::enter(
+                Routine::$routine,
+                Some(order),
+                [uplo as u8, transa as u8, transb as u8],
+                [n, k],
+                [lda, ldb, ldc],
+            );
+            let (alpha, beta): ($t, $t) = (($value)(alpha), ($value)(beta));
+            let routine = concat!(stringify!($name_64), "\0").as_bytes();
+            let (caller_lda, caller_ldb) = (lda, ldb);
+            let View {
+                uplo: uplo_char,
+                transa: transa_char,
+                transb: transb_char,
+                a,
+                lda,
+                b,
+                ldb,
+            } = View::new(order, uplo, transa, transb, a, lda, b, ldb);
+
+            if let Some(p) = $try_ilp64() {
+                match p {
+                    $provider::Ilp64(f) => unsafe {
+                        f(
+                            &uplo_char,
+                            &transa_char,
+                            &transb_char,
+                            &n,
+                            &k,
+                            &alpha,
+                            a,
+                            &lda,
+                            b,
+                            &ldb,
+                            &beta,
+                            c,
+                            &ldc,
+                        )
+                    },
+                    $provider::Lp64(f) => {
+                        if !lp64_split::check_i64(
+                            routine,
+                            [(5, n), (6, k), (9, caller_lda), (11, caller_ldb), (14, ldc)],
+                            [],
+                        ) {
+                            return;
+                        }
+                        let [n, k, lda, ldb, ldc] = [n, k, lda, ldb, ldc].map(|v| v as BlasInt32);
+                        unsafe {
+                            f(
+                                &uplo_char,
+                                &transa_char,
+                                &transb_char,
+                                &n,
+                                &k,
+                                &alpha,
+                                a,
+                                &lda,
+                                b,
+                                &ldb,
+                                &beta,
+                                c,
+                                &ldc,
+                            )
+                        }
+                    }
+                }
+                return;
+            }
+
+            let gemm = $route_ilp64(n, n, k);
+            if !check(
+                routine, order, transa, transb, n, k, caller_lda, caller_ldb, ldc,
+            ) {
+                return;
+            }
+            if matches!(gemm, $gemm_provider::Lp64(_))
+                && !lp64_split::check_i64(
+                    routine,
+                    [(9, caller_lda), (11, caller_ldb), (14, ldc)],
+                    [(5, n), (6, k)],
+                )
+            {
+                return;
+            }
+            if n == 0 {
+                return;
+            }
+            unsafe {
+                blocked(
+                    uplo_char,
+                    transa_char,
+                    transb_char,
+                    n,
+                    a,
+                    lda,
+                    b,
+                    ldb,
+                    beta,
+                    $zero,
+                    c,
+                    ldc,
+                    &|m, bn, a, b, beta, c, ldc| {
+                        $call_i64(
+                            gemm,
+                            transa_char,
+                            transb_char,
+                            m,
+                            bn,
+                            k,
+                            ($gemm_scalar)(&alpha),
+                            a,
+                            lda,
+                            b,
+                            ldb,
+                            ($gemm_scalar)(&beta),
+                            c,
+                            ldc,
+                        );
+                    },
+                );
+            }
+        }
+    };
+}
+
+define_gemmt!(
+    "Single precision general matrix multiply updating one triangle of C.",
+    cblas_sgemmt,
+    cblas_sgemmt_64,
+    Sgemmt,
+    f32,
+    f32,
+    |x: f32| x,
+    |x: &f32| *x,
+    0.0,
+    SgemmtProvider,
+    try_get_sgemmt_for_lp64_cblas,
+    try_get_sgemmt_for_ilp64_cblas,
+    SgemmProvider,
+    route_sgemm_for_lp64_cblas,
+    route_sgemm_for_ilp64_cblas,
+    call_sgemm_provider,
+    call_sgemm_provider_i64
+);
+
+define_gemmt!(
+    "Double precision general matrix multiply updating one triangle of C.",
+    cblas_dgemmt,
+    cblas_dgemmt_64,
+    Dgemmt,
+    f64,
+    f64,
+    |x: f64| x,
+    |x: &f64| *x,
+    0.0,
+    DgemmtProvider,
+    try_get_dgemmt_for_lp64_cblas,
+    try_get_dgemmt_for_ilp64_cblas,
+    DgemmProvider,
+    route_dgemm_for_lp64_cblas,
+    route_dgemm_for_ilp64_cblas,
+    call_dgemm_provider,
+    call_dgemm_provider_i64
+);
+
+define_gemmt!(
+    "Single precision complex general matrix multiply updating one triangle of C.",
+    cblas_cgemmt,
+    cblas_cgemmt_64,
+    Cgemmt,
+    Complex32,
+    *const Complex32,
+    |x: *const Complex32| unsafe { *x },
+    |x: &Complex32| x as *const Complex32,
+    Complex32::new(0.0, 0.0),
+    CgemmtProvider,
+    try_get_cgemmt_for_lp64_cblas,
+    try_get_cgemmt_for_ilp64_cblas,
+    CgemmProvider,
+    route_cgemm_for_lp64_cblas,
+    route_cgemm_for_ilp64_cblas,
+    call_cgemm_provider,
+    call_cgemm_provider_i64
+);
+
+define_gemmt!(
+    "Double precision complex general matrix multiply updating one triangle of C.",
+    cblas_zgemmt,
+    cblas_zgemmt_64,
+    Zgemmt,
+    Complex64,
+    *const Complex64,
+    |x: *const Complex64| unsafe { *x },
+    |x: &Complex64| x as *const Complex64,
+    Complex64::new(0.0, 0.0),
+    ZgemmtProvider,
+    try_get_zgemmt_for_lp64_cblas,
+    try_get_zgemmt_for_ilp64_cblas,
+    ZgemmProvider,
+    route_zgemm_for_lp64_cblas,
+    route_zgemm_for_ilp64_cblas,
+    call_zgemm_provider,
+    call_zgemm_provider_i64
+);
@@ -12,6 +12,9 @@ use crate::backend::{
     get_chemm_for_ilp64_cblas, get_chemm_for_lp64_cblas, get_zhemm_for_ilp64_cblas,
     get_zhemm_for_lp64_cblas, ChemmProvider, ZhemmProvider,
 };
+use crate::dispatch;
+use crate::lp64_split::{self, Shared};
+use crate::stats::Routine;
 use crate::types::{
     side_to_char, uplo_to_char, CblasColMajor, CblasLeft, CblasLower, CblasRight, CblasRowMajor,
     CblasUpper, CBLAS_ORDER, CBLAS_SIDE, CBLAS_UPLO,
@@ -42,6 +45,13 @@ pub unsafe extern "C" fn cblas_chemm(
     c: *mut Complex32,
     ldc: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Chemm,
+        Some(order),
+        [side as u8, uplo as u8],
+        [m, n],
+        [lda, ldb, ldc],
+    );
     let p = get_chemm_for_lp64_cblas();
     match p {
         ChemmProvider::Lp64(f) => match order {
@@ -126,13 +136,24 @@ pub unsafe extern "C" fn cblas_chemm_64(
     c: *mut Complex32,
     ldc: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Chemm,
+        Some(order),
+        [side as u8, uplo as u8],
+        [m, n],
+        [lda, ldb, ldc],
+    );
     let p = get_chemm_for_ilp64_cblas();
+    let (fixed, split) = match side {
+        CblasLeft => ((4, m), (5, n)),
+        CblasRight => ((5, n), (4, m)),
+    };
     if matches!(p, ChemmProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(
+        && !lp64_split::check_i64(
             b"cblas_chemm_64\0",
-            [(4, m), (5, n), (8, lda), (10, ldb), (13, ldc)],
+            [fixed, (8, lda), (10, ldb), (13, ldc)],
+            [split],
         )
-        .is_none()
     {
         return;
     }
@@ -163,35 +184,45 @@ pub unsafe extern "C" fn cblas_chemm_64(
             }
         },
         ChemmProvider::Lp64(f) => {
-            let m = m as i32;
-            let n = n as i32;
-            let lda = lda as i32;
-            let ldb = ldb as i32;
-            let ldc = ldc as i32;
-            match order {
-                CblasColMajor => {
-                    let side_char = side_to_char(side);
-                    let uplo_char = uplo_to_char(uplo);
-                    f(
-                        &side_char, &uplo_char, &m, &n, alpha, a, &lda, b, &ldb, beta, c, &ldc,
-                    );
-                }
-                CblasRowMajor => {
-                    let new_side = match side {
+            // Blocks are cut from the column-major view, where row-major B
+            // and C are transposed: the side and triangle flip and m, n swap.
+            let (side, uplo, m, n) = match order {
+                CblasColMajor => (side, uplo, m, n),
+                CblasRowMajor => (
+                    match side {
                         CblasLeft => CblasRight,
                         CblasRight => CblasLeft,
-                    };
-                    let new_uplo = match uplo {
+                    },
+                    match uplo {
                         CblasUpper => CblasLower,
                         CblasLower => CblasUpper,
-                    };
-                    let side_char = side_to_char(new_side);
-                    let uplo_char = uplo_to_char(new_uplo);
-                    f(
-                        &side_char, &uplo_char, &n, &m, alpha, a, &lda, b, &ldb, beta, c, &ldc,
-                    );
-                }
-            }
+                    },
+                    n,
+                    m,
+                ),
+            };
+            let side_char = side_to_char(side);
+            let uplo_char = uplo_to_char(uplo);
+            let (alpha, beta) = (*alpha, *beta);
+            let (a, lda32) = (Shared::new(a), lda as i32);
+            let (b, ldb32) = (Shared::new(b), ldb as i32);
+            let (c, ldc32) = (Shared::new(c), ldc as i32);
+            lp64_split::side(side == CblasLeft, m, n, &|i0, mb, j0, nb| {
+                f(
+                    &side_char,
+                    &uplo_char,
+                    &mb,
+                    &nb,
+                    &alpha,
+                    a.get(),
+                    &lda32,
+                    b.at(i0, j0, ldb),
+                    &ldb32,
+                    &beta,
+                    c.at(i0, j0, ldc),
+                    &ldc32,
+                )
+            });
         }
     }
 }
@@ -220,6 +251,13 @@ pub unsafe extern "C" fn cblas_zhemm(
     c: *mut Complex64,
     ldc: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Zhemm,
+        Some(order),
+        [side as u8, uplo as u8],
+        [m, n],
+        [lda, ldb, ldc],
+    );
     let p = get_zhemm_for_lp64_cblas();
     match p {
         ZhemmProvider::Lp64(f) => match order {
@@ -304,13 +342,24 @@ pub unsafe extern "C" fn cblas_zhemm_64(
     c: *mut Complex64,
     ldc: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Zhemm,
+        Some(order),
+        [side as u8, uplo as u8],
+        [m, n],
+        [lda, ldb, ldc],
+    );
     let p = get_zhemm_for_ilp64_cblas();
+    let (fixed, split) = match side {
+        CblasLeft => ((4, m), (5, n)),
+        CblasRight => ((5, n), (4, m)),
+    };
     if matches!(p, ZhemmProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(
+        && !lp64_split::check_i64(
             b"cblas_zhemm_64\0",
-            [(4, m), (5, n), (8, lda), (10, ldb), (13, ldc)],
+            [fixed, (8, lda), (10, ldb), (13, ldc)],
+            [split],
         )
-        .is_none()
     {
         return;
     }
@@ -341,35 +390,45 @@ pub unsafe extern "C" fn cblas_zhemm_64(
             }
         },
         ZhemmProvider::Lp64(f) => {
-            let m = m as i32;
-            let n = n as i32;
-            let lda = lda as i32;
-            let ldb = ldb as i32;
-            let ldc = ldc as i32;
-            match order {
-                CblasColMajor => {
-                    let side_char = side_to_char(side);
-                    let uplo_char = uplo_to_char(uplo);
-                    f(
-                        &side_char, &uplo_char, &m, &n, alpha, a, &lda, b, &ldb, beta, c, &ldc,
-                    );
-                }
-                CblasRowMajor => {
-                    let new_side = match side {
+            // Blocks are cut from the column-major view, where row-major B
+            // and C are transposed: the side and triangle flip and m, n swap.
+            let (side, uplo, m, n) = match order {
+                CblasColMajor => (side, uplo, m, n),
+                CblasRowMajor => (
+                    match side {
                         CblasLeft => CblasRight,
                         CblasRight => CblasLeft,
-                    };
-                    let new_uplo = match uplo {
+                    },
+                    match uplo {
                         CblasUpper => CblasLower,
                         CblasLower => CblasUpper,
-                    };
-                    let side_char = side_to_char(new_side);
-                    let uplo_char = uplo_to_char(new_uplo);
-                    f(
-                        &side_char, &uplo_char, &n, &m, alpha, a, &lda, b, &ldb, beta, c, &ldc,
-                    );
-                }
-            }
+                    },
+                    n,
+                    m,
+                ),
+            };
+            let side_char = side_to_char(side);
+            let uplo_char = uplo_to_char(uplo);
+            let (alpha, beta) = (*alpha, *beta);
+            let (a, lda32) = (Shared::new(a), lda as i32);
+            let (b, ldb32) = (Shared::new(b), ldb as i32);
+            let (c, ldc32) = (Shared::new(c), ldc as i32);
+            lp64_split::side(side == CblasLeft, m, n, &|i0, mb, j0, nb| {
+                f(
+                    &side_char,
+                    &uplo_char,
+                    &mb,
+                    &nb,
+                    &alpha,
+                    a.get(),
+                    &lda32,
+                    b.at(i0, j0, ldb),
+                    &ldb32,
+                    &beta,
+                    c.at(i0, j0, ldc),
+                    &ldc32,
+                )
+            });
         }
     }
 }
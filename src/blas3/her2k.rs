@@ -14,6 +14,9 @@ use crate::backend::{
     get_cher2k_for_ilp64_cblas, get_cher2k_for_lp64_cblas, get_zher2k_for_ilp64_cblas,
     get_zher2k_for_lp64_cblas, Cher2kProvider, Zher2kProvider,
 };
+use crate::dispatch;
+use crate::lp64_split;
+use crate::stats::Routine;
 use crate::types::{
     transpose_to_char, uplo_to_char, CblasColMajor, CblasConjTrans, CblasLower, CblasNoTrans,
     CblasRowMajor, CblasUpper, CBLAS_ORDER, CBLAS_TRANSPOSE, CBLAS_UPLO,
@@ -46,6 +49,13 @@ pub unsafe extern "C" fn cblas_cher2k(
     c: *mut Complex32,
     ldc: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Cher2k,
+        Some(order),
+        [uplo as u8, trans as u8],
+        [n, k],
+        [lda, ldb, ldc],
+    );
     let p = get_cher2k_for_lp64_cblas();
     match p {
         Cher2kProvider::Lp64(f) => match order {
@@ -182,13 +192,20 @@ pub unsafe extern "C" fn cblas_cher2k_64(
     c: *mut Complex32,
     ldc: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Cher2k,
+        Some(order),
+        [uplo as u8, trans as u8],
+        [n, k],
+        [lda, ldb, ldc],
+    );
     let p = get_cher2k_for_ilp64_cblas();
     if matches!(p, Cher2kProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(
+        && !lp64_split::check_i64(
             b"cblas_cher2k_64\0",
-            [(4, n), (5, k), (8, lda), (10, ldb), (13, ldc)],
+            [(4, n), (8, lda), (10, ldb), (13, ldc)],
+            [(5, k)],
         )
-        .is_none()
     {
         return;
     }
@@ -244,58 +261,63 @@ pub unsafe extern "C" fn cblas_cher2k_64(
             }
         },
         Cher2kProvider::Lp64(f) => {
-            let n = n as i32;
-            let k = k as i32;
-            let lda = lda as i32;
-            let ldb = ldb as i32;
-            let ldc = ldc as i32;
-            match order {
-                CblasColMajor => {
-                    let uplo_char = uplo_to_char(uplo);
-                    let trans_char = transpose_to_char(trans);
-                    f(
-                        &uplo_char,
-                        &trans_char,
-                        &n,
-                        &k,
-                        alpha,
-                        a,
-                        &lda,
-                        b,
-                        &ldb,
-                        &beta,
-                        c,
-                        &ldc,
-                    );
-                }
-                CblasRowMajor => {
-                    let new_uplo = match uplo {
-                        CblasUpper => CblasLower,
-                        CblasLower => CblasUpper,
-                    };
-                    let new_trans = match trans {
-                        CblasNoTrans => CblasConjTrans,
-                        CblasConjTrans => CblasNoTrans,
-                        _ => CblasNoTrans,
-                    };
-                    let alpha_val = *alpha;
-                    let conj_alpha = Complex32::new(alpha_val.re, -alpha_val.im);
-                    let uplo_char = uplo_to_char(new_uplo);
-                    let trans_char = transpose_to_char(new_trans);
-                    f(
-                        &uplo_char,
-                        &trans_char,
-                        &n,
-                        &k,
-                        &conj_alpha,
-                        a,
-                        &lda,
-                        b,
-                        &ldb,
-                        &beta,
-                        c,
-                        &ldc,
-                    );
+            // k blocks accumulate into C; only the first one applies beta.
+            for (p0, k) in lp64_split::rank_k(k) {
+                let beta = if p0 == 0 { beta } else { 1.0 };
+                let a = a.offset(lp64_split::rank_k_offset(order, trans, p0, lda));
+                let b = b.offset(lp64_split::rank_k_offset(order, trans, p0, ldb));
+                let n = n as i32;
+                let lda = lda as i32;
+                let ldb = ldb as i32;
+                let ldc = ldc as i32;
+                match order {
+                    CblasColMajor => {
+                        let uplo_char = uplo_to_char(uplo);
+                        let trans_char = transpose_to_char(trans);
+                        f(
+                            &uplo_char,
+                            &trans_char,
+                            &n,
+                            &k,
+                            alpha,
+                            a,
+                            &lda,
+                            b,
+                            &ldb,
+                            &beta,
+                            c,
+                            &ldc,
+                        );
+                    }
+                    CblasRowMajor => {
+                        let new_uplo = match uplo {
+                            CblasUpper => CblasLower,
+                            CblasLower => CblasUpper,
+                        };
+                        let new_trans = match trans {
+                            CblasNoTrans => CblasConjTrans,
+                            CblasConjTrans => CblasNoTrans,
+                            _ => CblasNoTrans,
+                        };
+                        let alpha_val = *alpha;
+                        let conj_alpha = Complex32::new(alpha_val.re, -alpha_val.im);
+                        let uplo_char = uplo_to_char(new_uplo);
+                        let trans_char = transpose_to_char(new_trans);
+                        f(
+                            &uplo_char,
+                            &trans_char,
+                            &n,
+                            &k,
+                            &conj_alpha,
+                            a,
+                            &lda,
+                            b,
+                            &ldb,
+                            &beta,
+                            c,
+                            &ldc,
+                        );
+                    }
                 }
             }
         }
@@ -328,6 +350,13 @@ pub unsafe extern "C" fn cblas_zher2k(
     c: *mut Complex64,
     ldc: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Zher2k,
+        Some(order),
+        [uplo as u8, trans as u8],
+        [n, k],
+        [lda, ldb, ldc],
+    );
     let p = get_zher2k_for_lp64_cblas();
     match p {
         Zher2kProvider::Lp64(f) => match order {
@@ -464,13 +493,20 @@ pub unsafe extern "C" fn cblas_zher2k_64(
     c: *mut Complex64,
     ldc: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Zher2k,
+        Some(order),
+        [uplo as u8, trans as u8],
+        [n, k],
+        [lda, ldb, ldc],
+    );
     let p = get_zher2k_for_ilp64_cblas();
     if matches!(p, Zher2kProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(
+        && !lp64_split::check_i64(
             b"cblas_zher2k_64\0",
-            [(4, n), (5, k), (8, lda), (10, ldb), (13, ldc)],
+            [(4, n), (8, lda), (10, ldb), (13, ldc)],
+            [(5, k)],
         )
-        .is_none()
     {
         return;
     }
@@ -526,58 +562,63 @@ pub unsafe extern "C" fn cblas_zher2k_64(
             }
         },
         Zher2kProvider::Lp64(f) => {
-            let n = n as i32;
-            let k = k as i32;
-            let lda = lda as i32;
-            let ldb = ldb as i32;
-            let ldc = ldc as i32;
-            match order {
-                CblasColMajor => {
-                    let uplo_char = uplo_to_char(uplo);
-                    let trans_char = transpose_to_char(trans);
-                    f(
-                        &uplo_char,
-                        &trans_char,
-                        &n,
-                        &k,
-                        alpha,
-                        a,
-                        &lda,
-                        b,
-                        &ldb,
-                        &beta,
-                        c,
-                        &ldc,
-                    );
-                }
-                CblasRowMajor => {
-                    let new_uplo = match uplo {
-                        CblasUpper => CblasLower,
-                        CblasLower => CblasUpper,
-                    };
-                    let new_trans = match trans {
-                        CblasNoTrans => CblasConjTrans,
-                        CblasConjTrans => CblasNoTrans,
-                        _ => CblasNoTrans,
-                    };
-                    let alpha_val = *alpha;
-                    let conj_alpha = Complex64::new(alpha_val.re, -alpha_val.im);
-                    let uplo_char = uplo_to_char(new_uplo);
-                    let trans_char = transpose_to_char(new_trans);
-                    f(
-                        &uplo_char,
-                        &trans_char,
-                        &n,
-                        &k,
-                        &conj_alpha,
-                        a,
-                        &lda,
-                        b,
-                        &ldb,
-                        &beta,
-                        c,
-                        &ldc,
-                    );
+            // k blocks accumulate into C; only the first one applies beta.
+            for (p0, k) in lp64_split::rank_k(k) {
+                let beta = if p0 == 0 { beta } else { 1.0 };
+                let a = a.offset(lp64_split::rank_k_offset(order, trans, p0, lda));
+                let b = b.offset(lp64_split::rank_k_offset(order, trans, p0, ldb));
+                let n = n as i32;
+                let lda = lda as i32;
+                let ldb = ldb as i32;
+                let ldc = ldc as i32;
+                match order {
+                    CblasColMajor => {
+                        let uplo_char = uplo_to_char(uplo);
+                        let trans_char = transpose_to_char(trans);
+                        f(
+                            &uplo_char,
+                            &trans_char,
+                            &n,
+                            &k,
+                            alpha,
+                            a,
+                            &lda,
+                            b,
+                            &ldb,
+                            &beta,
+                            c,
+                            &ldc,
+                        );
+                    }
+                    CblasRowMajor => {
+                        let new_uplo = match uplo {
+                            CblasUpper => CblasLower,
+                            CblasLower => CblasUpper,
+                        };
+                        let new_trans = match trans {
+                            CblasNoTrans => CblasConjTrans,
+                            CblasConjTrans => CblasNoTrans,
+                            _ => CblasNoTrans,
+                        };
+                        let alpha_val = *alpha;
+                        let conj_alpha = Complex64::new(alpha_val.re, -alpha_val.im);
+                        let uplo_char = uplo_to_char(new_uplo);
+                        let trans_char = transpose_to_char(new_trans);
+                        f(
+                            &uplo_char,
+                            &trans_char,
+                            &n,
+                            &k,
+                            &conj_alpha,
+                            a,
+                            &lda,
+                            b,
+                            &ldb,
+                            &beta,
+                            c,
+                            &ldc,
+                        );
+                    }
                 }
             }
         }
@@ -14,6 +14,9 @@ use crate::backend::{
     get_cherk_for_ilp64_cblas, get_cherk_for_lp64_cblas, get_zherk_for_ilp64_cblas,
     get_zherk_for_lp64_cblas, CherkProvider, ZherkProvider,
 };
+use crate::dispatch;
+use crate::lp64_split;
+use crate::stats::Routine;
 use crate::types::{
     transpose_to_char, uplo_to_char, CblasColMajor, CblasConjTrans, CblasLower, CblasNoTrans,
     CblasRowMajor, CblasUpper, CBLAS_ORDER, CBLAS_TRANSPOSE, CBLAS_UPLO,
@@ -47,6 +50,13 @@ pub unsafe extern "C" fn cblas_cherk(
     c: *mut Complex32,
     ldc: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Cherk,
+        Some(order),
+        [uplo as u8, trans as u8],
+        [n, k],
+        [lda, ldc],
+    );
     let p = get_cherk_for_lp64_cblas();
     match p {
         CherkProvider::Lp64(f) => match order {
@@ -168,13 +178,16 @@ pub unsafe extern "C" fn cblas_cherk_64(
     c: *mut Complex32,
     ldc: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Cherk,
+        Some(order),
+        [uplo as u8, trans as u8],
+        [n, k],
+        [lda, ldc],
+    );
     let p = get_cherk_for_ilp64_cblas();
     if matches!(p, CherkProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(
-            b"cblas_cherk_64\0",
-            [(4, n), (5, k), (8, lda), (11, ldc)],
-        )
-        .is_none()
+        && !lp64_split::check_i64(b"cblas_cherk_64\0", [(4, n), (8, lda), (11, ldc)], [(5, k)])
     {
         return;
     }
@@ -224,51 +237,55 @@ pub unsafe extern "C" fn cblas_cherk_64(
             }
         },
         CherkProvider::Lp64(f) => {
-            let n = n as i32;
-            let k = k as i32;
-            let lda = lda as i32;
-            let ldc = ldc as i32;
-            match order {
-                CblasColMajor => {
-                    let uplo_char = uplo_to_char(uplo);
-                    let trans_char = transpose_to_char(trans);
-                    f(
-                        &uplo_char,
-                        &trans_char,
-                        &n,
-                        &k,
-                        &alpha,
-                        a,
-                        &lda,
-                        &beta,
-                        c,
-                        &ldc,
-                    );
-                }
-                CblasRowMajor => {
-                    let new_uplo = match uplo {
-                        CblasUpper => CblasLower,
-                        CblasLower => CblasUpper,
-                    };
-                    let new_trans = match trans {
-                        CblasNoTrans => CblasConjTrans,
-                        CblasConjTrans => CblasNoTrans,
-                        _ => CblasConjTrans,
-                    };
-                    let uplo_char = uplo_to_char(new_uplo);
-                    let trans_char = transpose_to_char(new_trans);
-                    f(
-                        &uplo_char,
-                        &trans_char,
-                        &n,
-                        &k,
-                        &alpha,
-                        a,
-                        &lda,
-                        &beta,
-                        c,
-                        &ldc,
-                    );
+            // k blocks accumulate into C; only the first one applies beta.
+            for (p0, k) in lp64_split::rank_k(k) {
+                let beta = if p0 == 0 { beta } else { 1.0 };
+                let a = a.offset(lp64_split::rank_k_offset(order, trans, p0, lda));
+                let n = n as i32;
+                let lda = lda as i32;
+                let ldc = ldc as i32;
+                match order {
+                    CblasColMajor => {
+                        let uplo_char = uplo_to_char(uplo);
+                        let trans_char = transpose_to_char(trans);
+                        f(
+                            &uplo_char,
+                            &trans_char,
+                            &n,
+                            &k,
+                            &alpha,
+                            a,
+                            &lda,
+                            &beta,
+                            c,
+                            &ldc,
+                        );
+                    }
+                    CblasRowMajor => {
+                        let new_uplo = match uplo {
+                            CblasUpper => CblasLower,
+                            CblasLower => CblasUpper,
+                        };
+                        let new_trans = match trans {
+                            CblasNoTrans => CblasConjTrans,
+                            CblasConjTrans => CblasNoTrans,
+                            _ => CblasConjTrans,
+                        };
+                        let uplo_char = uplo_to_char(new_uplo);
+                        let trans_char = transpose_to_char(new_trans);
+                        f(
+                            &uplo_char,
+                            &trans_char,
+                            &n,
+                            &k,
+                            &alpha,
+                            a,
+                            &lda,
+                            &beta,
+                            c,
+                            &ldc,
+                        );
+                    }
                 }
             }
         }
@@ -302,6 +319,13 @@ pub unsafe extern "C" fn cblas_zherk(
     c: *mut Complex64,
     ldc: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Zherk,
+        Some(order),
+        [uplo as u8, trans as u8],
+        [n, k],
+        [lda, ldc],
+    );
     let p = get_zherk_for_lp64_cblas();
     match p {
         ZherkProvider::Lp64(f) => match order {
@@ -423,13 +447,16 @@ pub unsafe extern "C" fn cblas_zherk_64(
     c: *mut Complex64,
     ldc: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Zherk,
+        Some(order),
+        [uplo as u8, trans as u8],
+        [n, k],
+        [lda, ldc],
+    );
     let p = get_zherk_for_ilp64_cblas();
     if matches!(p, ZherkProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(
-            b"cblas_zherk_64\0",
-            [(4, n), (5, k), (8, lda), (11, ldc)],
-        )
-        .is_none()
+        && !lp64_split::check_i64(b"cblas_zherk_64\0", [(4, n), (8, lda), (11, ldc)], [(5, k)])
     {
         return;
     }
@@ -479,51 +506,55 @@ pub unsafe extern "C" fn cblas_zherk_64(
             }
         },
         ZherkProvider::Lp64(f) => {
-            let n = n as i32;
-            let k = k as i32;
-            let lda = lda as i32;
-            let ldc = ldc as i32;
-            match order {
-                CblasColMajor => {
-                    let uplo_char = uplo_to_char(uplo);
-                    let trans_char = transpose_to_char(trans);
-                    f(
-                        &uplo_char,
-                        &trans_char,
-                        &n,
-                        &k,
-                        &alpha,
-                        a,
-                        &lda,
-                        &beta,
-                        c,
-                        &ldc,
-                    );
-                }
-                CblasRowMajor => {
-                    let new_uplo = match uplo {
-                        CblasUpper => CblasLower,
-                        CblasLower => CblasUpper,
-                    };
-                    let new_trans = match trans {
-                        CblasNoTrans => CblasConjTrans,
-                        CblasConjTrans => CblasNoTrans,
-                        _ => CblasConjTrans,
-                    };
-                    let uplo_char = uplo_to_char(new_uplo);
-                    let trans_char = transpose_to_char(new_trans);
-                    f(
-                        &uplo_char,
-                        &trans_char,
-                        &n,
-                        &k,
-                        &alpha,
-                        a,
-                        &lda,
-                        &beta,
-                        c,
-                        &ldc,
-                    );
+            // k blocks accumulate into C; only the first one applies beta.
+            for (p0, k) in lp64_split::rank_k(k) {
+                let beta = if p0 == 0 { beta } else { 1.0 };
+                let a = a.offset(lp64_split::rank_k_offset(order, trans, p0, lda));
+                let n = n as i32;
+                let lda = lda as i32;
+                let ldc = ldc as i32;
+                match order {
+                    CblasColMajor => {
+                        let uplo_char = uplo_to_char(uplo);
+                        let trans_char = transpose_to_char(trans);
+                        f(
+                            &uplo_char,
+                            &trans_char,
+                            &n,
+                            &k,
+                            &alpha,
+                            a,
+                            &lda,
+                            &beta,
+                            c,
+                            &ldc,
+                        );
+                    }
+                    CblasRowMajor => {
+                        let new_uplo = match uplo {
+                            CblasUpper => CblasLower,
+                            CblasLower => CblasUpper,
+                        };
+                        let new_trans = match trans {
+                            CblasNoTrans => CblasConjTrans,
+                            CblasConjTrans => CblasNoTrans,
+                            _ => CblasConjTrans,
+                        };
+                        let uplo_char = uplo_to_char(new_uplo);
+                        let trans_char = transpose_to_char(new_trans);
+                        f(
+                            &uplo_char,
+                            &trans_char,
+                            &n,
+                            &k,
+                            &alpha,
+                            a,
+                            &lda,
+                            &beta,
+                            c,
+                            &ldc,
+                        );
+                    }
                 }
             }
         }
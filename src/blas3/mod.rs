@@ -1,9 +1,14 @@
 //! BLAS Level 3 operations (matrix-matrix).
 
 pub mod gemm;
+pub mod gemm3m;
+pub mod gemm_batch;
+pub mod gemmt;
 pub mod hemm;
 pub mod her2k;
 pub mod herk;
+pub(crate) mod parallel;
+pub mod queue;
 pub mod symm;
 pub mod syr2k;
 pub mod syrk;
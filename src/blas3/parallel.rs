@@ -0,0 +1,312 @@
+//! Opt-in tile-parallel Level-3 driver for single-threaded providers.
+//!
+//! A provider with its own threading disabled (a reference BLAS, or
+//! OpenBLAS inside a multiprocessing worker) runs every call on one core.
+//! With a tile size set through `cblas_inject_set_parallel_tile` and more
+//! than one worker thread (`cblas_inject_set_worker_threads`), the LP64
+//! GEMM, TRSM and TRMM entry points split the work themselves:
+//!
+//! - GEMM partitions C into `tile x tile` blocks. Each block is one provider
+//!   call over the full `k`, and blocks run on the worker pool.
+//! - TRSM and TRMM walk the triangle in `tile`-sized diagonal blocks. Each
+//!   step applies the provider's TRSM or TRMM to one panel of B, tiled along
+//!   the other dimension, and folds the panel into the rest of B with a
+//!   tiled provider GEMM. Without a GEMM of the same precision registered,
+//!   the triangle stays one block and only the other dimension is tiled.
+//!
+//! Pool threads claim tiles from a shared counter, so a thread that finishes
+//! early keeps taking tiles until none are left.
+
+use std::ffi::c_char;
+use std::sync::atomic::{AtomicI32, Ordering};
+
+use crate::backend::{BlasInt32, CBLAS_INJECT_STATUS_INVALID_ARGUMENT, CBLAS_INJECT_STATUS_OK};
+use crate::lp64_split::{self, transposed, Blocks, GemmBlock, Shared};
+use crate::pool;
+use crate::types::{
+    side_to_char, uplo_to_char, CblasColMajor, CblasLeft, CblasLower, CblasRight, CblasRowMajor,
+    CblasUpper, CBLAS_ORDER, CBLAS_SIDE, CBLAS_UPLO,
+};
+
+/// Tile edge of the parallel driver; 0 leaves calls to the provider.
+static PARALLEL_TILE: AtomicI32 = AtomicI32::new(0);
+
+/// Set the tile edge of the parallel GEMM/TRSM/TRMM driver.
+///
+/// 0 (the default) turns the driver off. A positive `tile` takes effect
+/// while more than one worker thread is configured; calls whose output fits
+/// in one tile still go to the provider whole. Returns
+/// `CBLAS_INJECT_STATUS_INVALID_ARGUMENT` for a negative tile.
+#[no_mangle]
+pub extern "C" fn cblas_inject_set_parallel_tile(tile: i32) -> i32 {
+    if tile < 0 {
+        return CBLAS_INJECT_STATUS_INVALID_ARGUMENT;
+    }
+    PARALLEL_TILE.store(tile, Ordering::Relaxed);
+    CBLAS_INJECT_STATUS_OK
+}
+
+/// Current value set with `cblas_inject_set_parallel_tile`.
+#[no_mangle]
+pub extern "C" fn cblas_inject_parallel_tile() -> i32 {
+    PARALLEL_TILE.load(Ordering::Relaxed)
+}
+
+/// Tile edge for a call whose column-major output is `m x n`, or `None`
+/// when it goes to the provider whole.
+#[inline]
+pub(crate) fn tile_for(m: i64, n: i64) -> Option<i64> {
+    let tile = i64::from(PARALLEL_TILE.load(Ordering::Relaxed));
+    (tile > 0 && pool::worker_threads() > 1 && (m > tile || n > tile)).then_some(tile)
+}
+
+/// Run a column-major GEMM as `tile x tile` blocks of C in parallel.
+#[allow(clippy::too_many_arguments)]
+pub(crate) unsafe fn gemm<T: Copy + Sync>(
+    transa: c_char,
+    transb: c_char,
+    m: BlasInt32,
+    n: BlasInt32,
+    k: BlasInt32,
+    a: *const T,
+    lda: BlasInt32,
+    b: *const T,
+    ldb: BlasInt32,
+    beta: T,
+    c: *mut T,
+    ldc: BlasInt32,
+    tile: i64,
+    call: &(dyn Fn(GemmBlock<T>) + Sync),
+) {
+    // `k` is not split, so every block applies `beta`.
+    unsafe {
+        lp64_split::gemm_blocks(
+            transa,
+            transb,
+            m.into(),
+            n.into(),
+            k.into(),
+            a,
+            lda.into(),
+            b,
+            ldb.into(),
+            beta,
+            beta,
+            c,
+            ldc.into(),
+            tile,
+            i64::MAX,
+            call,
+        )
+    }
+}
+
+/// Fortran side and uplo flags and `(m, n)` of a TRSM/TRMM in column-major
+/// terms, where a row-major B is transposed: the side and triangle flip and
+/// `m`, `n` swap.
+pub(crate) fn col_major_view(
+    order: CBLAS_ORDER,
+    side: CBLAS_SIDE,
+    uplo: CBLAS_UPLO,
+    m: i64,
+    n: i64,
+) -> (c_char, c_char, i64, i64) {
+    let (side, uplo, m, n) = match order {
+        CblasColMajor => (side, uplo, m, n),
+        CblasRowMajor => (
+            match side {
+                CblasLeft => CblasRight,
+                CblasRight => CblasLeft,
+            },
+            match uplo {
+                CblasUpper => CblasLower,
+                CblasLower => CblasUpper,
+            },
+            n,
+            m,
+        ),
+    };
+    (side_to_char(side), uplo_to_char(uplo), m, n)
+}
+
+/// A column-major TRSM (`solve`) or TRMM for [`triangular`].
+pub(crate) struct Triangular<T> {
+    pub solve: bool,
+    pub side: c_char,
+    pub uplo: c_char,
+    pub trans: c_char,
+    pub m: i64,
+    pub n: i64,
+    pub alpha: T,
+    pub one: T,
+    pub minus_one: T,
+    pub a: *const T,
+    pub lda: i64,
+    pub b: *mut T,
+    pub ldb: i64,
+}
+
+/// Provider TRSM/TRMM `(m, n, alpha, a, b)` on a diagonal block of A and a
+/// block of B, with the operation's flags and leading dimensions.
+pub(crate) type TriangularCall<'a, T> =
+    dyn Fn(BlasInt32, BlasInt32, T, *const T, *mut T) + Sync + 'a;
+
+/// Provider GEMM `(transa, transb, alpha, block)`.
+pub(crate) type UpdateCall<'a, T> = dyn Fn(c_char, c_char, T, GemmBlock<T>) + Sync + 'a;
+
+/// Run a column-major TRSM or TRMM as diagonal-block steps.
+///
+/// Each step applies `tri` to the panel of B facing one diagonal block,
+/// tiled along the other dimension in parallel, then `update` folds the
+/// panel into the part of B not yet processed (TRSM) or folds that part
+/// into the panel (TRMM). The steps run in the order that keeps every
+/// operand of a step final (TRSM) or still original (TRMM).
+pub(crate) unsafe fn triangular<T: Copy + Sync>(
+    op: Triangular<T>,
+    tile: i64,
+    tri: &TriangularCall<'_, T>,
+    update: Option<&UpdateCall<'_, T>>,
+) {
+    let Triangular {
+        solve,
+        side,
+        uplo,
+        trans,
+        m,
+        n,
+        alpha,
+        one,
+        minus_one,
+        a,
+        lda,
+        b,
+        ldb,
+    } = op;
+    let left = side == b'L' as c_char;
+    let (order, free) = if left { (m, n) } else { (n, m) };
+    // op(A) is lower when exactly one of the stored triangle and the
+    // transpose says so.
+    let op_lower = (uplo == b'L' as c_char) != transposed(trans);
+    let forward = (left == op_lower) == solve;
+    let diagonal = Blocks::new(order, if update.is_some() { tile } else { order });
+    let panels = Blocks::new(free, tile);
+    let (a, b) = (Shared::new(a), Shared::new(b));
+    // Element (i, j) of op(A).
+    let op_a = |i: i64, j: i64| unsafe {
+        if transposed(trans) {
+            a.at(j, i, lda)
+        } else {
+            a.at(i, j, lda)
+        }
+    };
+
+    for step in 0..diagonal.count {
+        let (s, len) = diagonal.get(if forward {
+            step
+        } else {
+            diagonal.count - 1 - step
+        });
+        let step_alpha = if !solve || step == 0 { alpha } else { one };
+        pool::parallel_for(panels.count, &|p| {
+            let (f0, fl) = panels.get(p);
+            let diag = unsafe { a.at(s, s, lda) };
+            if left {
+                tri(len, fl, step_alpha, diag, unsafe { b.at(s, f0, ldb) });
+            } else {
+                tri(fl, len, step_alpha, diag, unsafe { b.at(f0, s, ldb) });
+            }
+        });
+
+        let Some(update) = update else {
+            continue;
+        };
+        let end = s + i64::from(len);
+        let (r0, rl) = if forward { (end, order - end) } else { (0, s) };
+        if rl == 0 {
+            continue;
+        }
+        let len = i64::from(len);
+        let no_trans = b'N' as c_char;
+        // (transa, transb, m, n, k, a, lda, b, ldb, c) of the update, whose
+        // alpha and beta are fixed by the operation.
+        let (transa, transb, um, un, uk, ua, ulda, ub, uldb, uc) = match (solve, left) {
+            // B[R, :] = step_alpha * B[R, :] - op(A)[R, i] * X[i, :]
+            (true, true) => (
+                trans,
+                no_trans,
+                rl,
+                free,
+                len,
+                op_a(r0, s),
+                lda,
+                unsafe { b.at(s, 0, ldb) },
+                ldb,
+                unsafe { b.at(r0, 0, ldb) },
+            ),
+            // B[:, R] = step_alpha * B[:, R] - X[:, i] * op(A)[i, R]
+            (true, false) => (
+                no_trans,
+                trans,
+                free,
+                rl,
+                len,
+                unsafe { b.at(0, s, ldb) },
+                ldb,
+                op_a(s, r0),
+                lda,
+                unsafe { b.at(0, r0, ldb) },
+            ),
+            // B[i, :] += alpha * op(A)[i, R] * B[R, :]
+            (false, true) => (
+                trans,
+                no_trans,
+                len,
+                free,
+                rl,
+                op_a(s, r0),
+                lda,
+                unsafe { b.at(r0, 0, ldb) },
+                ldb,
+                unsafe { b.at(s, 0, ldb) },
+            ),
+            // B[:, i] += alpha * B[:, R] * op(A)[R, i]
+            (false, false) => (
+                no_trans,
+                trans,
+                free,
+                len,
+                rl,
+                unsafe { b.at(0, r0, ldb) },
+                ldb,
+                op_a(r0, s),
+                lda,
+                unsafe { b.at(0, s, ldb) },
+            ),
+        };
+        let (update_alpha, beta) = if solve {
+            (minus_one, step_alpha)
+        } else {
+            (alpha, one)
+        };
+        unsafe {
+            lp64_split::gemm_blocks(
+                transa,
+                transb,
+                um,
+                un,
+                uk,
+                ua.cast_const(),
+                ulda,
+                ub.cast_const(),
+                uldb,
+                beta,
+                beta,
+                uc,
+                ldb,
+                tile,
+                i64::MAX,
+                &|blk| update(transa, transb, update_alpha, blk),
+            );
+        }
+    }
+}
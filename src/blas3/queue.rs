@@ -0,0 +1,672 @@
+//! Asynchronous GEMM/TRSM submission queue - cblas-inject extension.
+//!
+//! `cblas_inject_?gemm_async` and `cblas_inject_?trsm_async` take the
+//! arguments of the matching CBLAS routine, queue the call and return at
+//! once. Queued calls run on background threads through the ordinary `_64`
+//! entry points, so routing, the native small GEMM and the row-major
+//! conversion behave as for a direct call, batched or not. The queue uses
+//! `cblas_inject_worker_threads` threads (at least one); they are spawned on
+//! first use and never exit. Provider scopes of the submitting thread do not
+//! carry over to queued calls.
+//!
+//! Calls are ordered by the memory they touch: a call waits for every earlier
+//! unfinished call that writes memory it reads or writes, or that reads
+//! memory it writes. A matrix covers the addresses from its first to its last
+//! stored element, so matrices interleaved within one allocation are ordered
+//! conservatively.
+//!
+//! Ready GEMMs or TRSMs of one precision with equal transposes, shapes,
+//! leading dimensions and scalars are spread over the worker pool together,
+//! each still through its own `_64` entry point.
+
+use std::ffi::c_void;
+use std::sync::atomic::{AtomicBool, Ordering};
+use std::sync::{Arc, Condvar, Mutex};
+
+use num_complex::Complex64;
+
+use crate::backend::{CBLAS_INJECT_STATUS_NULL_POINTER, CBLAS_INJECT_STATUS_OK};
+use crate::blas3::gemm::{cblas_dgemm_64, cblas_zgemm_64};
+use crate::blas3::trsm::{cblas_dtrsm_64, cblas_ztrsm_64};
+use crate::pool;
+use crate::types::{
+    CblasColMajor, CblasConjNoTrans, CblasLeft, CblasNoTrans, CblasRowMajor, CBLAS_DIAG,
+    CBLAS_ORDER, CBLAS_SIDE, CBLAS_TRANSPOSE, CBLAS_UPLO,
+};
+
+/// Largest number of queued calls run as one batch.
+const MAX_BATCH: usize = 64;
+
+/// Completion handle of a queued call.
+pub struct CblasInjectAsync {
+    done: AtomicBool,
+}
+
+#[derive(Clone, Copy, PartialEq)]
+enum Op {
+    Gemm {
+        transa: CBLAS_TRANSPOSE,
+        transb: CBLAS_TRANSPOSE,
+    },
+    Trsm {
+        side: CBLAS_SIDE,
+        uplo: CBLAS_UPLO,
+        trans: CBLAS_TRANSPOSE,
+        diag: CBLAS_DIAG,
+    },
+}
+
+/// Everything about a call but its matrices; calls with equal shapes batch.
+#[derive(Clone, Copy, PartialEq)]
+struct Shape {
+    op: Op,
+    complex: bool,
+    order: CBLAS_ORDER,
+    /// m, n, k for GEMM; m, n, 0 for TRSM.
+    dims: [i64; 3],
+    /// lda, ldb, ldc for GEMM; lda, ldb, 0 for TRSM.
+    ld: [i64; 3],
+    /// Real scalars are stored with a zero imaginary part.
+    alpha: Complex64,
+    beta: Complex64,
+}
+
+/// A, B, C for GEMM; A, B, null for TRSM. The caller keeps them valid until
+/// the call completes.
+#[derive(Clone, Copy)]
+struct Matrices([*mut c_void; 3]);
+
+unsafe impl Send for Matrices {}
+unsafe impl Sync for Matrices {}
+
+/// Half-open address range; empty ranges never overlap.
+#[derive(Clone, Copy)]
+struct Span(usize, usize);
+
+impl Span {
+    fn overlaps(self, other: Span) -> bool {
+        self.0 < other.1 && other.0 < self.1
+    }
+}
+
+impl Shape {
+    fn elem(&self) -> usize {
+        if self.complex {
+            16
+        } else {
+            8
+        }
+    }
+
+    /// Span of the `rows` x `cols` matrix at `ptr` with leading dimension `ld`.
+    fn span(&self, ptr: *mut c_void, rows: i64, cols: i64, ld: i64) -> Span {
+        let (lines, len) = match self.order {
+            CblasColMajor => (cols, rows),
+            CblasRowMajor => (rows, cols),
+        };
+        if ptr.is_null() || lines <= 0 || len <= 0 {
+            return Span(0, 0);
+        }
+        // An invalid ld is rejected when the call runs; until then assume
+        // the smallest valid one.
+        let count = (lines - 1).saturating_mul(ld.max(len)).saturating_add(len);
+        let bytes = usize::try_from(count)
+            .unwrap_or(usize::MAX)
+            .saturating_mul(self.elem());
+        let start = ptr as usize;
+        Span(start, start.saturating_add(bytes))
+    }
+
+    /// Spans read and written by the call.
+    fn spans(&self, m: Matrices) -> ([Span; 2], Span) {
+        let [a, b, c] = m.0;
+        let [rows, cols, k] = self.dims;
+        let [lda, ldb, ldc] = self.ld;
+        match self.op {
+            Op::Gemm { transa, transb } => {
+                let (ar, ac) = if matches!(transa, CblasNoTrans | CblasConjNoTrans) {
+                    (rows, k)
+                } else {
+                    (k, rows)
+                };
+                let (br, bc) = if matches!(transb, CblasNoTrans | CblasConjNoTrans) {
+                    (k, cols)
+                } else {
+                    (cols, k)
+                };
+                (
+                    [self.span(a, ar, ac, lda), self.span(b, br, bc, ldb)],
+                    self.span(c, rows, cols, ldc),
+                )
+            }
+            Op::Trsm { side, .. } => {
+                let order = if side == CblasLeft { rows } else { cols };
+                (
+                    [self.span(a, order, order, lda), Span(0, 0)],
+                    self.span(b, rows, cols, ldb),
+                )
+            }
+        }
+    }
+}
+
+/// An unfinished queued call.
+struct Call {
+    shape: Shape,
+    matrices: Matrices,
+    reads: [Span; 2],
+    write: Span,
+    /// Earlier calls this one must wait for.
+    deps: Vec<Arc<CblasInjectAsync>>,
+    handle: Arc<CblasInjectAsync>,
+    started: bool,
+}
+
+impl Call {
+    fn ready(&self) -> bool {
+        !self.started && self.deps.iter().all(|d| d.done.load(Ordering::Relaxed))
+    }
+
+    /// Whether a later call with these spans must wait for this one.
+    fn conflicts(&self, reads: &[Span; 2], write: Span) -> bool {
+        self.write.overlaps(write)
+            || reads.iter().any(|r| self.write.overlaps(*r))
+            || self.reads.iter().any(|r| r.overlaps(write))
+    }
+}
+
+struct Queue {
+    /// Unfinished calls in submission order.
+    calls: Vec<Call>,
+    executors: usize,
+}
+
+static QUEUE: Mutex<Queue> = Mutex::new(Queue {
+    calls: Vec::new(),
+    executors: 0,
+});
+/// Signalled when a call may have become ready.
+static READY: Condvar = Condvar::new();
+/// Signalled when calls complete.
+static DONE: Condvar = Condvar::new();
+
+/// Spawn executors until the configured count exist; returns how many do.
+fn ensure_executors(queue: &mut Queue) -> usize {
+    while queue.executors < pool::worker_threads() {
+        let id = queue.executors + 1;
+        let spawned = std::thread::Builder::new()
+            .name(format!("cblas-inject-async-{id}"))
+            .spawn(executor_main);
+        if spawned.is_err() {
+            break;
+        }
+        queue.executors += 1;
+    }
+    queue.executors
+}
+
+/// Mark the first ready call and up to `MAX_BATCH - 1` later ready calls of
+/// the same shape as started. Ready calls never conflict with each other: a
+/// later conflicting call depends on the earlier one, which is not done.
+fn take_ready(queue: &mut Queue) -> Option<(Shape, Vec<Matrices>, Vec<Arc<CblasInjectAsync>>)> {
+    let first = queue.calls.iter().position(Call::ready)?;
+    let shape = queue.calls[first].shape;
+    let (mut matrices, mut handles) = (Vec::new(), Vec::new());
+    for call in &mut queue.calls[first..] {
+        if handles.len() == MAX_BATCH {
+            break;
+        }
+        if call.shape == shape && call.ready() {
+            call.started = true;
+            matrices.push(call.matrices);
+            handles.push(Arc::clone(&call.handle));
+        }
+    }
+    Some((shape, matrices, handles))
+}
+
+fn executor_main() {
+    let mut queue = pool::lock(&QUEUE);
+    loop {
+        let Some((shape, matrices, handles)) = take_ready(&mut queue) else {
+            queue = pool::wait(&READY, queue);
+            continue;
+        };
+        drop(queue);
+        unsafe { run(&shape, &matrices) };
+        queue = pool::lock(&QUEUE);
+        for handle in &handles {
+            handle.done.store(true, Ordering::Release);
+        }
+        queue
+            .calls
+            .retain(|call| !call.handle.done.load(Ordering::Relaxed));
+        DONE.notify_all();
+        READY.notify_all();
+    }
+}
+
+/// Run calls of one shape, spread over the worker pool. Each goes through
+/// its `_64` entry point, so a batched call is routed exactly like a single
+/// one.
+unsafe fn run(shape: &Shape, matrices: &[Matrices]) {
+    let s = shape;
+    let [m, n, k] = s.dims;
+    let [lda, ldb, ldc] = s.ld;
+    match s.op {
+        Op::Gemm { transa, transb } => {
+            pool::parallel_for(matrices.len(), &|i| {
+                let [a, b, c] = matrices[i].0;
+                if s.complex {
+                    unsafe {
+                        cblas_zgemm_64(
+                            s.order,
+                            transa,
+                            transb,
+                            m,
+                            n,
+                            k,
+                            &s.alpha,
+                            a.cast(),
+                            lda,
+                            b.cast(),
+                            ldb,
+                            &s.beta,
+                            c.cast(),
+                            ldc,
+                        );
+                    }
+                } else {
+                    unsafe {
+                        cblas_dgemm_64(
+                            s.order,
+                            transa,
+                            transb,
+                            m,
+                            n,
+                            k,
+                            s.alpha.re,
+                            a.cast(),
+                            lda,
+                            b.cast(),
+                            ldb,
+                            s.beta.re,
+                            c.cast(),
+                            ldc,
+                        );
+                    }
+                }
+            });
+        }
+        Op::Trsm {
+            side,
+            uplo,
+            trans,
+            diag,
+        } => {
+            pool::parallel_for(matrices.len(), &|i| {
+                let [a, b, _] = matrices[i].0;
+                if s.complex {
+                    unsafe {
+                        cblas_ztrsm_64(
+                            s.order,
+                            side,
+                            uplo,
+                            trans,
+                            diag,
+                            m,
+                            n,
+                            &s.alpha,
+                            a.cast(),
+                            lda,
+                            b.cast(),
+                            ldb,
+                        );
+                    }
+                } else {
+                    unsafe {
+                        cblas_dtrsm_64(
+                            s.order,
+                            side,
+                            uplo,
+                            trans,
+                            diag,
+                            m,
+                            n,
+                            s.alpha.re,
+                            a.cast(),
+                            lda,
+                            b.cast(),
+                            ldb,
+                        );
+                    }
+                }
+            });
+        }
+    }
+}
+
+/// Queue one call and hand out its completion handle.
+unsafe fn submit(shape: Shape, matrices: Matrices, handle: *mut *mut CblasInjectAsync) -> i32 {
+    let (reads, write) = shape.spans(matrices);
+    let call = Arc::new(CblasInjectAsync {
+        done: AtomicBool::new(false),
+    });
+    let mut queue = pool::lock(&QUEUE);
+    if ensure_executors(&mut queue) == 0 {
+        // No thread could be started, so nothing was ever queued: run the
+        // call here.
+        drop(queue);
+        unsafe { run(&shape, &[matrices]) };
+        call.done.store(true, Ordering::Release);
+    } else {
+        let deps = queue
+            .calls
+            .iter()
+            .filter(|c| c.conflicts(&reads, write))
+            .map(|c| Arc::clone(&c.handle))
+            .collect();
+        queue.calls.push(Call {
+            shape,
+            matrices,
+            reads,
+            write,
+            deps,
+            handle: Arc::clone(&call),
+            started: false,
+        });
+        READY.notify_one();
+    }
+    if !handle.is_null() {
+        unsafe { *handle = Arc::into_raw(call).cast_mut() };
+    }
+    CBLAS_INJECT_STATUS_OK
+}
+
+/// A scalar argument as passed to the CBLAS routine.
+trait AsyncScalar: Copy {
+    const COMPLEX: bool;
+    /// The value, or `None` for a null pointer.
+    unsafe fn load(self) -> Option<Complex64>;
+}
+
+impl AsyncScalar for f64 {
+    const COMPLEX: bool = false;
+    #[inline]
+    unsafe fn load(self) -> Option<Complex64> {
+        Some(Complex64::new(self, 0.0))
+    }
+}
+
+impl AsyncScalar for *const Complex64 {
+    const COMPLEX: bool = true;
+    #[inline]
+    unsafe fn load(self) -> Option<Complex64> {
+        unsafe { self.as_ref().copied() }
+    }
+}
+
+#[allow(clippy::too_many_arguments)]
+unsafe fn gemm_async<S: AsyncScalar>(
+    order: CBLAS_ORDER,
+    transa: CBLAS_TRANSPOSE,
+    transb: CBLAS_TRANSPOSE,
+    dims: [i64; 3],
+    alpha: S,
+    a: *const c_void,
+    b: *const c_void,
+    beta: S,
+    c: *mut c_void,
+    ld: [i64; 3],
+    handle: *mut *mut CblasInjectAsync,
+) -> i32 {
+    if !handle.is_null() {
+        unsafe { *handle = std::ptr::null_mut() };
+    }
+    let (Some(alpha), Some(beta)) = (unsafe { alpha.load() }, unsafe { beta.load() }) else {
+        return CBLAS_INJECT_STATUS_NULL_POINTER;
+    };
+    let shape = Shape {
+        op: Op::Gemm { transa, transb },
+        complex: S::COMPLEX,
+        order,
+        dims,
+        ld,
+        alpha,
+        beta,
+    };
+    let matrices = Matrices([a.cast_mut(), b.cast_mut(), c]);
+    unsafe { submit(shape, matrices, handle) }
+}
+
+#[allow(clippy::too_many_arguments)]
+unsafe fn trsm_async<S: AsyncScalar>(
+    order: CBLAS_ORDER,
+    side: CBLAS_SIDE,
+    uplo: CBLAS_UPLO,
+    trans: CBLAS_TRANSPOSE,
+    diag: CBLAS_DIAG,
+    dims: [i64; 2],
+    alpha: S,
+    a: *const c_void,
+    b: *mut c_void,
+    ld: [i64; 2],
+    handle: *mut *mut CblasInjectAsync,
+) -> i32 {
+    if !handle.is_null() {
+        unsafe { *handle = std::ptr::null_mut() };
+    }
+    let Some(alpha) = (unsafe { alpha.load() }) else {
+        return CBLAS_INJECT_STATUS_NULL_POINTER;
+    };
+    let shape = Shape {
+        op: Op::Trsm {
+            side,
+            uplo,
+            trans,
+            diag,
+        },
+        complex: S::COMPLEX,
+        order,
+        dims: [dims[0], dims[1], 0],
+        ld: [ld[0], ld[1], 0],
+        alpha,
+        beta: Complex64::default(),
+    };
+    let matrices = Matrices([a.cast_mut(), b, std::ptr::null_mut()]);
+    unsafe { submit(shape, matrices, handle) }
+}
+
+macro_rules! define_gemm_async {
+    ($t:ty, $scalar:ty, $desc:literal, $name:ident, $int:ty) => {
+        #[doc = concat!("Queue a ", $desc, " general matrix multiply.")]
+        ///
+        /// Takes the arguments of the matching `cblas_?gemm`, plus `handle`,
+        /// which receives a completion handle when non-null (and null on
+        /// error). Scalars are copied; the matrices are used when the call
+        /// runs. Returns `CBLAS_INJECT_STATUS_NULL_POINTER` for a null
+        /// complex scalar; other argument errors are reported through
+        /// `cblas_xerbla` when the call runs.
+        ///
+        /// # Safety
+        ///
+        /// - As for the matching `cblas_?gemm`
+        /// - The matrices must stay valid, and C must not be accessed except
+        ///   by queued calls, until the call completes
+        /// - A returned handle must be released with `cblas_inject_async_wait`
+        #[no_mangle]
+        #[allow(clippy::too_many_arguments)]
+        pub unsafe extern "C" fn $name(
+            order: CBLAS_ORDER,
+            transa: CBLAS_TRANSPOSE,
+            transb: CBLAS_TRANSPOSE,
+            m: $int,
+            n: $int,
+            k: $int,
+            alpha: $scalar,
+            a: *const $t,
+            lda: $int,
+            b: *const $t,
+            ldb: $int,
+            beta: $scalar,
+            c: *mut $t,
+            ldc: $int,
+            handle: *mut *mut CblasInjectAsync,
+        ) -> i32 {
+            unsafe {
+                gemm_async(
+                    order,
+                    transa,
+                    transb,
+                    [m, n, k].map(i64::from),
+                    alpha,
+                    a.cast(),
+                    b.cast(),
+                    beta,
+                    c.cast(),
+                    [lda, ldb, ldc].map(i64::from),
+                    handle,
+                )
+            }
+        }
+    };
+}
+
+macro_rules! define_trsm_async {
+    ($t:ty, $scalar:ty, $desc:literal, $name:ident, $int:ty) => {
+        #[doc = concat!("Queue a ", $desc, " triangular solve.")]
+        ///
+        /// Takes the arguments of the matching `cblas_?trsm`, plus `handle`;
+        /// see `cblas_inject_dgemm_async`.
+        ///
+        /// # Safety
+        ///
+        /// - As for the matching `cblas_?trsm`
+        /// - A and B must stay valid, and B must not be accessed except by
+        ///   queued calls, until the call completes
+        /// - A returned handle must be released with `cblas_inject_async_wait`
+        #[no_mangle]
+        #[allow(clippy::too_many_arguments)]
+        pub unsafe extern "C" fn $name(
+            order: CBLAS_ORDER,
+            side: CBLAS_SIDE,
+            uplo: CBLAS_UPLO,
+            trans: CBLAS_TRANSPOSE,
+            diag: CBLAS_DIAG,
+            m: $int,
+            n: $int,
+            alpha: $scalar,
+            a: *const $t,
+            lda: $int,
+            b: *mut $t,
+            ldb: $int,
+            handle: *mut *mut CblasInjectAsync,
+        ) -> i32 {
+            unsafe {
+                trsm_async(
+                    order,
+                    side,
+                    uplo,
+                    trans,
+                    diag,
+                    [m, n].map(i64::from),
+                    alpha,
+                    a.cast(),
+                    b.cast(),
+                    [lda, ldb].map(i64::from),
+                    handle,
+                )
+            }
+        }
+    };
+}
+
+define_gemm_async!(f64, f64, "double precision", cblas_inject_dgemm_async, i32);
+define_gemm_async!(
+    f64,
+    f64,
+    "double precision",
+    cblas_inject_dgemm_async_64,
+    i64
+);
+define_gemm_async!(
+    Complex64,
+    *const Complex64,
+    "double precision complex",
+    cblas_inject_zgemm_async,
+    i32
+);
+define_gemm_async!(
+    Complex64,
+    *const Complex64,
+    "double precision complex",
+    cblas_inject_zgemm_async_64,
+    i64
+);
+define_trsm_async!(f64, f64, "double precision", cblas_inject_dtrsm_async, i32);
+define_trsm_async!(
+    f64,
+    f64,
+    "double precision",
+    cblas_inject_dtrsm_async_64,
+    i64
+);
+define_trsm_async!(
+    Complex64,
+    *const Complex64,
+    "double precision complex",
+    cblas_inject_ztrsm_async,
+    i32
+);
+define_trsm_async!(
+    Complex64,
+    *const Complex64,
+    "double precision complex",
+    cblas_inject_ztrsm_async_64,
+    i64
+);
+
+/// 1 if the call behind `handle` has completed (or `handle` is null), else 0.
+///
+/// # Safety
+///
+/// `handle` must be null or a handle that has not been released.
+#[no_mangle]
+pub unsafe extern "C" fn cblas_inject_async_test(handle: *const CblasInjectAsync) -> i32 {
+    match unsafe { handle.as_ref() } {
+        Some(handle) => i32::from(handle.done.load(Ordering::Acquire)),
+        None => 1,
+    }
+}
+
+/// Wait for the call behind `handle` to complete, then release the handle.
+///
+/// Returns `CBLAS_INJECT_STATUS_NULL_POINTER` for a null handle.
+///
+/// # Safety
+///
+/// `handle` must be null or a handle that has not been released.
+#[no_mangle]
+pub unsafe extern "C" fn cblas_inject_async_wait(handle: *mut CblasInjectAsync) -> i32 {
+    if handle.is_null() {
+        return CBLAS_INJECT_STATUS_NULL_POINTER;
+    }
+    let handle = unsafe { Arc::from_raw(handle.cast_const()) };
+    if !handle.done.load(Ordering::Acquire) {
+        let mut queue = pool::lock(&QUEUE);
+        while !handle.done.load(Ordering::Acquire) {
+            queue = pool::wait(&DONE, queue);
+        }
+    }
+    CBLAS_INJECT_STATUS_OK
+}
+
+/// Wait until every queued call has completed. Handles still need releasing.
+#[no_mangle]
+pub extern "C" fn cblas_inject_async_wait_all() -> i32 {
+    let mut queue = pool::lock(&QUEUE);
+    while !queue.calls.is_empty() {
+        queue = pool::wait(&DONE, queue);
+    }
+    CBLAS_INJECT_STATUS_OK
+}
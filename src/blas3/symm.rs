@@ -14,6 +14,9 @@ use crate::backend::{
     get_zsymm_for_ilp64_cblas, get_zsymm_for_lp64_cblas, CsymmProvider, DsymmProvider,
     SsymmProvider, ZsymmProvider,
 };
+use crate::dispatch;
+use crate::lp64_split::{self, Shared};
+use crate::stats::Routine;
 use crate::types::{
     side_to_char, uplo_to_char, CblasColMajor, CblasLeft, CblasLower, CblasRight, CblasRowMajor,
     CblasUpper, CBLAS_ORDER, CBLAS_SIDE, CBLAS_UPLO,
@@ -44,6 +47,13 @@ pub unsafe extern "C" fn cblas_dsymm(
     c: *mut f64,
     ldc: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Dsymm,
+        Some(order),
+        [side as u8, uplo as u8],
+        [m, n],
+        [lda, ldb, ldc],
+    );
     let p = get_dsymm_for_lp64_cblas();
     match p {
         DsymmProvider::Lp64(f) => match order {
@@ -128,13 +138,24 @@ pub unsafe extern "C" fn cblas_dsymm_64(
     c: *mut f64,
     ldc: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Dsymm,
+        Some(order),
+        [side as u8, uplo as u8],
+        [m, n],
+        [lda, ldb, ldc],
+    );
     let p = get_dsymm_for_ilp64_cblas();
+    let (fixed, split) = match side {
+        CblasLeft => ((4, m), (5, n)),
+        CblasRight => ((5, n), (4, m)),
+    };
     if matches!(p, DsymmProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(
+        && !lp64_split::check_i64(
             b"cblas_dsymm_64\0",
-            [(4, m), (5, n), (8, lda), (10, ldb), (13, ldc)],
+            [fixed, (8, lda), (10, ldb), (13, ldc)],
+            [split],
         )
-        .is_none()
     {
         return;
     }
@@ -165,35 +186,44 @@ pub unsafe extern "C" fn cblas_dsymm_64(
             }
         },
         DsymmProvider::Lp64(f) => {
-            let m = m as i32;
-            let n = n as i32;
-            let lda = lda as i32;
-            let ldb = ldb as i32;
-            let ldc = ldc as i32;
-            match order {
-                CblasColMajor => {
-                    let side_char = side_to_char(side);
-                    let uplo_char = uplo_to_char(uplo);
-                    f(
-                        &side_char, &uplo_char, &m, &n, &alpha, a, &lda, b, &ldb, &beta, c, &ldc,
-                    );
-                }
-                CblasRowMajor => {
-                    let new_side = match side {
+            // Blocks are cut from the column-major view, where row-major B
+            // and C are transposed: the side and triangle flip and m, n swap.
+            let (side, uplo, m, n) = match order {
+                CblasColMajor => (side, uplo, m, n),
+                CblasRowMajor => (
+                    match side {
                         CblasLeft => CblasRight,
                         CblasRight => CblasLeft,
-                    };
-                    let new_uplo = match uplo {
+                    },
+                    match uplo {
                         CblasUpper => CblasLower,
                         CblasLower => CblasUpper,
-                    };
-                    let side_char = side_to_char(new_side);
-                    let uplo_char = uplo_to_char(new_uplo);
-                    f(
-                        &side_char, &uplo_char, &n, &m, &alpha, a, &lda, b, &ldb, &beta, c, &ldc,
-                    );
-                }
-            }
+                    },
+                    n,
+                    m,
+                ),
+            };
+            let side_char = side_to_char(side);
+            let uplo_char = uplo_to_char(uplo);
+            let (a, lda32) = (Shared::new(a), lda as i32);
+            let (b, ldb32) = (Shared::new(b), ldb as i32);
+            let (c, ldc32) = (Shared::new(c), ldc as i32);
+            lp64_split::side(side == CblasLeft, m, n, &|i0, mb, j0, nb| {
+                f(
+                    &side_char,
+                    &uplo_char,
+                    &mb,
+                    &nb,
+                    &alpha,
+                    a.get(),
+                    &lda32,
+                    b.at(i0, j0, ldb),
+                    &ldb32,
+                    &beta,
+                    c.at(i0, j0, ldc),
+                    &ldc32,
+                )
+            });
         }
     }
 }
@@ -222,6 +252,13 @@ pub unsafe extern "C" fn cblas_ssymm(
     c: *mut f32,
     ldc: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ssymm,
+        Some(order),
+        [side as u8, uplo as u8],
+        [m, n],
+        [lda, ldb, ldc],
+    );
     let p = get_ssymm_for_lp64_cblas();
     match p {
         SsymmProvider::Lp64(f) => match order {
@@ -306,13 +343,24 @@ pub unsafe extern "C" fn cblas_ssymm_64(
     c: *mut f32,
     ldc: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ssymm,
+        Some(order),
+        [side as u8, uplo as u8],
+        [m, n],
+        [lda, ldb, ldc],
+    );
     let p = get_ssymm_for_ilp64_cblas();
+    let (fixed, split) = match side {
+        CblasLeft => ((4, m), (5, n)),
+        CblasRight => ((5, n), (4, m)),
+    };
     if matches!(p, SsymmProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(
+        && !lp64_split::check_i64(
             b"cblas_ssymm_64\0",
-            [(4, m), (5, n), (8, lda), (10, ldb), (13, ldc)],
+            [fixed, (8, lda), (10, ldb), (13, ldc)],
+            [split],
         )
-        .is_none()
     {
         return;
     }
@@ -343,35 +391,44 @@ pub unsafe extern "C" fn cblas_ssymm_64(
             }
         },
         SsymmProvider::Lp64(f) => {
-            let m = m as i32;
-            let n = n as i32;
-            let lda = lda as i32;
-            let ldb = ldb as i32;
-            let ldc = ldc as i32;
-            match order {
-                CblasColMajor => {
-                    let side_char = side_to_char(side);
-                    let uplo_char = uplo_to_char(uplo);
-                    f(
-                        &side_char, &uplo_char, &m, &n, &alpha, a, &lda, b, &ldb, &beta, c, &ldc,
-                    );
-                }
-                CblasRowMajor => {
-                    let new_side = match side {
+            // Blocks are cut from the column-major view, where row-major B
+            // and C are transposed: the side and triangle flip and m, n swap.
+            let (side, uplo, m, n) = match order {
+                CblasColMajor => (side, uplo, m, n),
+                CblasRowMajor => (
+                    match side {
                         CblasLeft => CblasRight,
                         CblasRight => CblasLeft,
-                    };
-                    let new_uplo = match uplo {
+                    },
+                    match uplo {
                         CblasUpper => CblasLower,
                         CblasLower => CblasUpper,
-                    };
-                    let side_char = side_to_char(new_side);
-                    let uplo_char = uplo_to_char(new_uplo);
-                    f(
-                        &side_char, &uplo_char, &n, &m, &alpha, a, &lda, b, &ldb, &beta, c, &ldc,
-                    );
-                }
-            }
+                    },
+                    n,
+                    m,
+                ),
+            };
+            let side_char = side_to_char(side);
+            let uplo_char = uplo_to_char(uplo);
+            let (a, lda32) = (Shared::new(a), lda as i32);
+            let (b, ldb32) = (Shared::new(b), ldb as i32);
+            let (c, ldc32) = (Shared::new(c), ldc as i32);
+            lp64_split::side(side == CblasLeft, m, n, &|i0, mb, j0, nb| {
+                f(
+                    &side_char,
+                    &uplo_char,
+                    &mb,
+                    &nb,
+                    &alpha,
+                    a.get(),
+                    &lda32,
+                    b.at(i0, j0, ldb),
+                    &ldb32,
+                    &beta,
+                    c.at(i0, j0, ldc),
+                    &ldc32,
+                )
+            });
         }
     }
 }
@@ -400,6 +457,13 @@ pub unsafe extern "C" fn cblas_csymm(
     c: *mut Complex32,
     ldc: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Csymm,
+        Some(order),
+        [side as u8, uplo as u8],
+        [m, n],
+        [lda, ldb, ldc],
+    );
     let p = get_csymm_for_lp64_cblas();
     match p {
         CsymmProvider::Lp64(f) => match order {
@@ -484,13 +548,24 @@ pub unsafe extern "C" fn cblas_csymm_64(
     c: *mut Complex32,
     ldc: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Csymm,
+        Some(order),
+        [side as u8, uplo as u8],
+        [m, n],
+        [lda, ldb, ldc],
+    );
     let p = get_csymm_for_ilp64_cblas();
+    let (fixed, split) = match side {
+        CblasLeft => ((4, m), (5, n)),
+        CblasRight => ((5, n), (4, m)),
+    };
     if matches!(p, CsymmProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(
+        && !lp64_split::check_i64(
             b"cblas_csymm_64\0",
-            [(4, m), (5, n), (8, lda), (10, ldb), (13, ldc)],
+            [fixed, (8, lda), (10, ldb), (13, ldc)],
+            [split],
         )
-        .is_none()
     {
         return;
     }
@@ -521,35 +596,45 @@ pub unsafe extern "C" fn cblas_csymm_64(
             }
         },
         CsymmProvider::Lp64(f) => {
-            let m = m as i32;
-            let n = n as i32;
-            let lda = lda as i32;
-            let ldb = ldb as i32;
-            let ldc = ldc as i32;
-            match order {
-                CblasColMajor => {
-                    let side_char = side_to_char(side);
-                    let uplo_char = uplo_to_char(uplo);
-                    f(
-                        &side_char, &uplo_char, &m, &n, alpha, a, &lda, b, &ldb, beta, c, &ldc,
-                    );
-                }
-                CblasRowMajor => {
-                    let new_side = match side {
+            // Blocks are cut from the column-major view, where row-major B
+            // and C are transposed: the side and triangle flip and m, n swap.
+            let (side, uplo, m, n) = match order {
+                CblasColMajor => (side, uplo, m, n),
+                CblasRowMajor => (
+                    match side {
                         CblasLeft => CblasRight,
                         CblasRight => CblasLeft,
-                    };
-                    let new_uplo = match uplo {
+                    },
+                    match uplo {
                         CblasUpper => CblasLower,
                         CblasLower => CblasUpper,
-                    };
-                    let side_char = side_to_char(new_side);
-                    let uplo_char = uplo_to_char(new_uplo);
-                    f(
-                        &side_char, &uplo_char, &n, &m, alpha, a, &lda, b, &ldb, beta, c, &ldc,
-                    );
-                }
-            }
+                    },
+                    n,
+                    m,
+                ),
+            };
+            let side_char = side_to_char(side);
+            let uplo_char = uplo_to_char(uplo);
+            let (alpha, beta) = (*alpha, *beta);
+            let (a, lda32) = (Shared::new(a), lda as i32);
+            let (b, ldb32) = (Shared::new(b), ldb as i32);
+            let (c, ldc32) = (Shared::new(c), ldc as i32);
+            lp64_split::side(side == CblasLeft, m, n, &|i0, mb, j0, nb| {
+                f(
+                    &side_char,
+                    &uplo_char,
+                    &mb,
+                    &nb,
+                    &alpha,
+                    a.get(),
+                    &lda32,
+                    b.at(i0, j0, ldb),
+                    &ldb32,
+                    &beta,
+                    c.at(i0, j0, ldc),
+                    &ldc32,
+                )
+            });
         }
     }
 }
@@ -578,6 +663,13 @@ pub unsafe extern "C" fn cblas_zsymm(
     c: *mut Complex64,
     ldc: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Zsymm,
+        Some(order),
+        [side as u8, uplo as u8],
+        [m, n],
+        [lda, ldb, ldc],
+    );
     let p = get_zsymm_for_lp64_cblas();
     match p {
         ZsymmProvider::Lp64(f) => match order {
@@ -662,13 +754,24 @@ pub unsafe extern "C" fn cblas_zsymm_64(
     c: *mut Complex64,
     ldc: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Zsymm,
+        Some(order),
+        [side as u8, uplo as u8],
+        [m, n],
+        [lda, ldb, ldc],
+    );
     let p = get_zsymm_for_ilp64_cblas();
+    let (fixed, split) = match side {
+        CblasLeft => ((4, m), (5, n)),
+        CblasRight => ((5, n), (4, m)),
+    };
     if matches!(p, ZsymmProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(
+        && !lp64_split::check_i64(
             b"cblas_zsymm_64\0",
-            [(4, m), (5, n), (8, lda), (10, ldb), (13, ldc)],
+            [fixed, (8, lda), (10, ldb), (13, ldc)],
+            [split],
         )
-        .is_none()
     {
         return;
     }
@@ -699,35 +802,45 @@ pub unsafe extern "C" fn cblas_zsymm_64(
             }
         },
         ZsymmProvider::Lp64(f) => {
-            let m = m as i32;
-            let n = n as i32;
-            let lda = lda as i32;
-            let ldb = ldb as i32;
-            let ldc = ldc as i32;
-            match order {
-                CblasColMajor => {
-                    let side_char = side_to_char(side);
-                    let uplo_char = uplo_to_char(uplo);
-                    f(
-                        &side_char, &uplo_char, &m, &n, alpha, a, &lda, b, &ldb, beta, c, &ldc,
-                    );
-                }
-                CblasRowMajor => {
-                    let new_side = match side {
+            // Blocks are cut from the column-major view, where row-major B
+            // and C are transposed: the side and triangle flip and m, n swap.
+            let (side, uplo, m, n) = match order {
+                CblasColMajor => (side, uplo, m, n),
+                CblasRowMajor => (
+                    match side {
                         CblasLeft => CblasRight,
                         CblasRight => CblasLeft,
-                    };
-                    let new_uplo = match uplo {
+                    },
+                    match uplo {
                         CblasUpper => CblasLower,
                         CblasLower => CblasUpper,
-                    };
-                    let side_char = side_to_char(new_side);
-                    let uplo_char = uplo_to_char(new_uplo);
-                    f(
-                        &side_char, &uplo_char, &n, &m, alpha, a, &lda, b, &ldb, beta, c, &ldc,
-                    );
-                }
-            }
+                    },
+                    n,
+                    m,
+                ),
+            };
+            let side_char = side_to_char(side);
+            let uplo_char = uplo_to_char(uplo);
+            let (alpha, beta) = (*alpha, *beta);
+            let (a, lda32) = (Shared::new(a), lda as i32);
+            let (b, ldb32) = (Shared::new(b), ldb as i32);
+            let (c, ldc32) = (Shared::new(c), ldc as i32);
+            lp64_split::side(side == CblasLeft, m, n, &|i0, mb, j0, nb| {
+                f(
+                    &side_char,
+                    &uplo_char,
+                    &mb,
+                    &nb,
+                    &alpha,
+                    a.get(),
+                    &lda32,
+                    b.at(i0, j0, ldb),
+                    &ldb32,
+                    &beta,
+                    c.at(i0, j0, ldc),
+                    &ldc32,
+                )
+            });
         }
     }
 }
@@ -14,6 +14,9 @@ use crate::backend::{
     get_zsyr2k_for_ilp64_cblas, get_zsyr2k_for_lp64_cblas, Csyr2kProvider, Dsyr2kProvider,
     Ssyr2kProvider, Zsyr2kProvider,
 };
+use crate::dispatch;
+use crate::lp64_split;
+use crate::stats::Routine;
 use crate::types::{
     transpose_to_char, uplo_to_char, CblasColMajor, CblasLower, CblasNoTrans, CblasRowMajor,
     CblasTrans, CblasUpper, CBLAS_ORDER, CBLAS_TRANSPOSE, CBLAS_UPLO,
@@ -44,6 +47,13 @@ pub unsafe extern "C" fn cblas_dsyr2k(
     c: *mut f64,
     ldc: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Dsyr2k,
+        Some(order),
+        [uplo as u8, trans as u8],
+        [n, k],
+        [lda, ldb, ldc],
+    );
     let p = get_dsyr2k_for_lp64_cblas();
     match p {
         Dsyr2kProvider::Lp64(f) => match order {
@@ -174,13 +184,20 @@ pub unsafe extern "C" fn cblas_dsyr2k_64(
     c: *mut f64,
     ldc: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Dsyr2k,
+        Some(order),
+        [uplo as u8, trans as u8],
+        [n, k],
+        [lda, ldb, ldc],
+    );
     let p = get_dsyr2k_for_ilp64_cblas();
     if matches!(p, Dsyr2kProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(
+        && !lp64_split::check_i64(
             b"cblas_dsyr2k_64\0",
-            [(4, n), (5, k), (8, lda), (10, ldb), (13, ldc)],
+            [(4, n), (8, lda), (10, ldb), (13, ldc)],
+            [(5, k)],
         )
-        .is_none()
     {
         return;
     }
@@ -234,56 +251,61 @@ pub unsafe extern "C" fn cblas_dsyr2k_64(
             }
         },
         Dsyr2kProvider::Lp64(f) => {
-            let n = n as i32;
-            let k = k as i32;
-            let lda = lda as i32;
-            let ldb = ldb as i32;
-            let ldc = ldc as i32;
-            match order {
-                CblasColMajor => {
-                    let uplo_char = uplo_to_char(uplo);
-                    let trans_char = transpose_to_char(trans);
-                    f(
-                        &uplo_char,
-                        &trans_char,
-                        &n,
-                        &k,
-                        &alpha,
-                        a,
-                        &lda,
-                        b,
-                        &ldb,
-                        &beta,
-                        c,
-                        &ldc,
-                    );
-                }
-                CblasRowMajor => {
-                    let new_uplo = match uplo {
-                        CblasUpper => CblasLower,
-                        CblasLower => CblasUpper,
-                    };
-                    let new_trans = match trans {
-                        CblasNoTrans => CblasTrans,
-                        CblasTrans => CblasNoTrans,
-                        _ => CblasNoTrans,
-                    };
-                    let uplo_char = uplo_to_char(new_uplo);
-                    let trans_char = transpose_to_char(new_trans);
-                    f(
-                        &uplo_char,
-                        &trans_char,
-                        &n,
-                        &k,
-                        &alpha,
-                        a,
-                        &lda,
-                        b,
-                        &ldb,
-                        &beta,
-                        c,
-                        &ldc,
-                    );
+            // k blocks accumulate into C; only the first one applies beta.
+            for (p0, k) in lp64_split::rank_k(k) {
+                let beta = if p0 == 0 { beta } else { 1.0 };
+                let a = a.offset(lp64_split::rank_k_offset(order, trans, p0, lda));
+                let b = b.offset(lp64_split::rank_k_offset(order, trans, p0, ldb));
+                let n = n as i32;
+                let lda = lda as i32;
+                let ldb = ldb as i32;
+                let ldc = ldc as i32;
+                match order {
+                    CblasColMajor => {
+                        let uplo_char = uplo_to_char(uplo);
+                        let trans_char = transpose_to_char(trans);
+                        f(
+                            &uplo_char,
+                            &trans_char,
+                            &n,
+                            &k,
+                            &alpha,
+                            a,
+                            &lda,
+                            b,
+                            &ldb,
+                            &beta,
+                            c,
+                            &ldc,
+                        );
+                    }
+                    CblasRowMajor => {
+                        let new_uplo = match uplo {
+                            CblasUpper => CblasLower,
+                            CblasLower => CblasUpper,
+                        };
+                        let new_trans = match trans {
+                            CblasNoTrans => CblasTrans,
+                            CblasTrans => CblasNoTrans,
+                            _ => CblasNoTrans,
+                        };
+                        let uplo_char = uplo_to_char(new_uplo);
+                        let trans_char = transpose_to_char(new_trans);
+                        f(
+                            &uplo_char,
+                            &trans_char,
+                            &n,
+                            &k,
+                            &alpha,
+                            a,
+                            &lda,
+                            b,
+                            &ldb,
+                            &beta,
+                            c,
+                            &ldc,
+                        );
+                    }
                 }
             }
         }
@@ -314,6 +336,13 @@ pub unsafe extern "C" fn cblas_ssyr2k(
     c: *mut f32,
     ldc: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ssyr2k,
+        Some(order),
+        [uplo as u8, trans as u8],
+        [n, k],
+        [lda, ldb, ldc],
+    );
     let p = get_ssyr2k_for_lp64_cblas();
     match p {
         Ssyr2kProvider::Lp64(f) => match order {
@@ -444,13 +473,20 @@ pub unsafe extern "C" fn cblas_ssyr2k_64(
     c: *mut f32,
     ldc: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ssyr2k,
+        Some(order),
+        [uplo as u8, trans as u8],
+        [n, k],
+        [lda, ldb, ldc],
+    );
     let p = get_ssyr2k_for_ilp64_cblas();
     if matches!(p, Ssyr2kProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(
+        && !lp64_split::check_i64(
             b"cblas_ssyr2k_64\0",
-            [(4, n), (5, k), (8, lda), (10, ldb), (13, ldc)],
+            [(4, n), (8, lda), (10, ldb), (13, ldc)],
+            [(5, k)],
         )
-        .is_none()
     {
         return;
     }
@@ -504,56 +540,61 @@ pub unsafe extern "C" fn cblas_ssyr2k_64(
             }
         },
         Ssyr2kProvider::Lp64(f) => {
-            let n = n as i32;
-            let k = k as i32;
-            let lda = lda as i32;
-            let ldb = ldb as i32;
-            let ldc = ldc as i32;
-            match order {
-                CblasColMajor => {
-                    let uplo_char = uplo_to_char(uplo);
-                    let trans_char = transpose_to_char(trans);
-                    f(
-                        &uplo_char,
-                        &trans_char,
-                        &n,
-                        &k,
-                        &alpha,
-                        a,
-                        &lda,
-                        b,
-                        &ldb,
-                        &beta,
-                        c,
-                        &ldc,
-                    );
-                }
-                CblasRowMajor => {
-                    let new_uplo = match uplo {
-                        CblasUpper => CblasLower,
-                        CblasLower => CblasUpper,
-                    };
-                    let new_trans = match trans {
-                        CblasNoTrans => CblasTrans,
-                        CblasTrans => CblasNoTrans,
-                        _ => CblasNoTrans,
-                    };
-                    let uplo_char = uplo_to_char(new_uplo);
-                    let trans_char = transpose_to_char(new_trans);
-                    f(
-                        &uplo_char,
-                        &trans_char,
-                        &n,
-                        &k,
-                        &alpha,
-                        a,
-                        &lda,
-                        b,
-                        &ldb,
-                        &beta,
-                        c,
-                        &ldc,
-                    );
+            // k blocks accumulate into C; only the first one applies beta.
+            for (p0, k) in lp64_split::rank_k(k) {
+                let beta = if p0 == 0 { beta } else { 1.0 };
+                let a = a.offset(lp64_split::rank_k_offset(order, trans, p0, lda));
+                let b = b.offset(lp64_split::rank_k_offset(order, trans, p0, ldb));
+                let n = n as i32;
+                let lda = lda as i32;
+                let ldb = ldb as i32;
+                let ldc = ldc as i32;
+                match order {
+                    CblasColMajor => {
+                        let uplo_char = uplo_to_char(uplo);
+                        let trans_char = transpose_to_char(trans);
+                        f(
+                            &uplo_char,
+                            &trans_char,
+                            &n,
+                            &k,
+                            &alpha,
+                            a,
+                            &lda,
+                            b,
+                            &ldb,
+                            &beta,
+                            c,
+                            &ldc,
+                        );
+                    }
+                    CblasRowMajor => {
+                        let new_uplo = match uplo {
+                            CblasUpper => CblasLower,
+                            CblasLower => CblasUpper,
+                        };
+                        let new_trans = match trans {
+                            CblasNoTrans => CblasTrans,
+                            CblasTrans => CblasNoTrans,
+                            _ => CblasNoTrans,
+                        };
+                        let uplo_char = uplo_to_char(new_uplo);
+                        let trans_char = transpose_to_char(new_trans);
+                        f(
+                            &uplo_char,
+                            &trans_char,
+                            &n,
+                            &k,
+                            &alpha,
+                            a,
+                            &lda,
+                            b,
+                            &ldb,
+                            &beta,
+                            c,
+                            &ldc,
+                        );
+                    }
                 }
             }
         }
@@ -584,6 +625,13 @@ pub unsafe extern "C" fn cblas_csyr2k(
     c: *mut Complex32,
     ldc: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Csyr2k,
+        Some(order),
+        [uplo as u8, trans as u8],
+        [n, k],
+        [lda, ldb, ldc],
+    );
     let p = get_csyr2k_for_lp64_cblas();
     match p {
         Csyr2kProvider::Lp64(f) => match order {
@@ -714,13 +762,20 @@ pub unsafe extern "C" fn cblas_csyr2k_64(
     c: *mut Complex32,
     ldc: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Csyr2k,
+        Some(order),
+        [uplo as u8, trans as u8],
+        [n, k],
+        [lda, ldb, ldc],
+    );
     let p = get_csyr2k_for_ilp64_cblas();
     if matches!(p, Csyr2kProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(
+        && !lp64_split::check_i64(
             b"cblas_csyr2k_64\0",
-            [(4, n), (5, k), (8, lda), (10, ldb), (13, ldc)],
+            [(4, n), (8, lda), (10, ldb), (13, ldc)],
+            [(5, k)],
         )
-        .is_none()
     {
         return;
     }
@@ -774,56 +829,62 @@ pub unsafe extern "C" fn cblas_csyr2k_64(
             }
         },
         Csyr2kProvider::Lp64(f) => {
-            let n = n as i32;
-            let k = k as i32;
-            let lda = lda as i32;
-            let ldb = ldb as i32;
-            let ldc = ldc as i32;
-            match order {
-                CblasColMajor => {
-                    let uplo_char = uplo_to_char(uplo);
-                    let trans_char = transpose_to_char(trans);
-                    f(
-                        &uplo_char,
-                        &trans_char,
-                        &n,
-                        &k,
-                        alpha,
-                        a,
-                        &lda,
-                        b,
-                        &ldb,
-                        beta,
-                        c,
-                        &ldc,
-                    );
-                }
-                CblasRowMajor => {
-                    let new_uplo = match uplo {
-                        CblasUpper => CblasLower,
-                        CblasLower => CblasUpper,
-                    };
-                    let new_trans = match trans {
-                        CblasNoTrans => CblasTrans,
-                        CblasTrans => CblasNoTrans,
-                        _ => CblasNoTrans,
-                    };
-                    let uplo_char = uplo_to_char(new_uplo);
-                    let trans_char = transpose_to_char(new_trans);
-                    f(
-                        &uplo_char,
-                        &trans_char,
-                        &n,
-                        &k,
-                        alpha,
-                        a,
-                        &lda,
-                        b,
-                        &ldb,
-                        beta,
-                        c,
-                        &ldc,
-                    );
+            // k blocks accumulate into C; only the first one applies beta.
+            let one = Complex32::new(1.0, 0.0);
+            for (p0, k) in lp64_split::rank_k(k) {
+                let beta = if p0 == 0 { beta } else { &one };
+                let a = a.offset(lp64_split::rank_k_offset(order, trans, p0, lda));
+                let b = b.offset(lp64_split::rank_k_offset(order, trans, p0, ldb));
+                let n = n as i32;
+                let lda = lda as i32;
+                let ldb = ldb as i32;
+                let ldc = ldc as i32;
+                match order {
+                    CblasColMajor => {
+                        let uplo_char = uplo_to_char(uplo);
+                        let trans_char = transpose_to_char(trans);
+                        f(
+                            &uplo_char,
+                            &trans_char,
+                            &n,
+                            &k,
+                            alpha,
+                            a,
+                            &lda,
+                            b,
+                            &ldb,
+                            beta,
+                            c,
+                            &ldc,
+                        );
+                    }
+                    CblasRowMajor => {
+                        let new_uplo = match uplo {
+                            CblasUpper => CblasLower,
+                            CblasLower => CblasUpper,
+                        };
+                        let new_trans = match trans {
+                            CblasNoTrans => CblasTrans,
+                            CblasTrans => CblasNoTrans,
+                            _ => CblasNoTrans,
+                        };
+                        let uplo_char = uplo_to_char(new_uplo);
+                        let trans_char = transpose_to_char(new_trans);
+                        f(
+                            &uplo_char,
+                            &trans_char,
+                            &n,
+                            &k,
+                            alpha,
+                            a,
+                            &lda,
+                            b,
+                            &ldb,
+                            beta,
+                            c,
+                            &ldc,
+                        );
+                    }
                 }
             }
         }
@@ -854,6 +915,13 @@ pub unsafe extern "C" fn cblas_zsyr2k(
     c: *mut Complex64,
     ldc: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Zsyr2k,
+        Some(order),
+        [uplo as u8, trans as u8],
+        [n, k],
+        [lda, ldb, ldc],
+    );
     let p = get_zsyr2k_for_lp64_cblas();
     match p {
         Zsyr2kProvider::Lp64(f) => match order {
@@ -984,13 +1052,20 @@ pub unsafe extern "C" fn cblas_zsyr2k_64(
     c: *mut Complex64,
     ldc: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Zsyr2k,
+        Some(order),
+        [uplo as u8, trans as u8],
+        [n, k],
+        [lda, ldb, ldc],
+    );
     let p = get_zsyr2k_for_ilp64_cblas();
     if matches!(p, Zsyr2kProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(
+        && !lp64_split::check_i64(
             b"cblas_zsyr2k_64\0",
-            [(4, n), (5, k), (8, lda), (10, ldb), (13, ldc)],
+            [(4, n), (8, lda), (10, ldb), (13, ldc)],
+            [(5, k)],
         )
-        .is_none()
     {
         return;
     }
@@ -1044,56 +1119,62 @@ pub unsafe extern "C" fn cblas_zsyr2k_64(
             }
         },
         Zsyr2kProvider::Lp64(f) => {
-            let n = n as i32;
-            let k = k as i32;
-            let lda = lda as i32;
-            let ldb = ldb as i32;
-            let ldc = ldc as i32;
-            match order {
-                CblasColMajor => {
-                    let uplo_char = uplo_to_char(uplo);
-                    let trans_char = transpose_to_char(trans);
-                    f(
-                        &uplo_char,
-                        &trans_char,
-                        &n,
-                        &k,
-                        alpha,
-                        a,
-                        &lda,
-                        b,
-                        &ldb,
-                        beta,
-                        c,
-                        &ldc,
-                    );
-                }
-                CblasRowMajor => {
-                    let new_uplo = match uplo {
-                        CblasUpper => CblasLower,
-                        CblasLower => CblasUpper,
-                    };
-                    let new_trans = match trans {
-                        CblasNoTrans => CblasTrans,
-                        CblasTrans => CblasNoTrans,
-                        _ => CblasNoTrans,
-                    };
-                    let uplo_char = uplo_to_char(new_uplo);
-                    let trans_char = transpose_to_char(new_trans);
-                    f(
-                        &uplo_char,
-                        &trans_char,
-                        &n,
-                        &k,
-                        alpha,
-                        a,
-                        &lda,
-                        b,
-                        &ldb,
-                        beta,
-                        c,
-                        &ldc,
-                    );
+            // k blocks accumulate into C; only the first one applies beta.
+            let one = Complex64::new(1.0, 0.0);
+            for (p0, k) in lp64_split::rank_k(k) {
+                let beta = if p0 == 0 { beta } else { &one };
+                let a = a.offset(lp64_split::rank_k_offset(order, trans, p0, lda));
+                let b = b.offset(lp64_split::rank_k_offset(order, trans, p0, ldb));
+                let n = n as i32;
+                let lda = lda as i32;
+                let ldb = ldb as i32;
+                let ldc = ldc as i32;
+                match order {
+                    CblasColMajor => {
+                        let uplo_char = uplo_to_char(uplo);
+                        let trans_char = transpose_to_char(trans);
+                        f(
+                            &uplo_char,
+                            &trans_char,
+                            &n,
+                            &k,
+                            alpha,
+                            a,
+                            &lda,
+                            b,
+                            &ldb,
+                            beta,
+                            c,
+                            &ldc,
+                        );
+                    }
+                    CblasRowMajor => {
+                        let new_uplo = match uplo {
+                            CblasUpper => CblasLower,
+                            CblasLower => CblasUpper,
+                        };
+                        let new_trans = match trans {
+                            CblasNoTrans => CblasTrans,
+                            CblasTrans => CblasNoTrans,
+                            _ => CblasNoTrans,
+                        };
+                        let uplo_char = uplo_to_char(new_uplo);
+                        let trans_char = transpose_to_char(new_trans);
+                        f(
+                            &uplo_char,
+                            &trans_char,
+                            &n,
+                            &k,
+                            alpha,
+                            a,
+                            &lda,
+                            b,
+                            &ldb,
+                            beta,
+                            c,
+                            &ldc,
+                        );
+                    }
                 }
             }
         }
@@ -14,6 +14,11 @@ use crate::backend::{
     get_zsyrk_for_ilp64_cblas, get_zsyrk_for_lp64_cblas, CsyrkProvider, DsyrkProvider,
     SsyrkProvider, ZsyrkProvider,
 };
+use crate::degenerate;
+use crate::dispatch;
+use crate::lp64_split;
+use crate::stats::Routine;
+use crate::trace::{self, Path};
 use crate::types::{
     transpose_to_char, uplo_to_char, CblasColMajor, CblasLower, CblasNoTrans, CblasRowMajor,
     CblasTrans, CblasUpper, CBLAS_ORDER, CBLAS_TRANSPOSE, CBLAS_UPLO,
@@ -42,6 +47,31 @@ pub unsafe extern "C" fn cblas_dsyrk(
     c: *mut f64,
     ldc: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Dsyrk,
+        Some(order),
+        [uplo as u8, trans as u8],
+        [n, k],
+        [lda, ldc],
+    );
+    if unsafe {
+        degenerate::syrk(
+            order,
+            uplo,
+            trans,
+            i64::from(n),
+            i64::from(k),
+            alpha,
+            a,
+            i64::from(lda),
+            beta,
+            c,
+            i64::from(ldc),
+        )
+    } {
+        trace::dispatched(Path::Native);
+        return;
+    }
     let p = get_dsyrk_for_lp64_cblas();
     match p {
         DsyrkProvider::Lp64(f) => match order {
@@ -161,13 +191,20 @@ pub unsafe extern "C" fn cblas_dsyrk_64(
     c: *mut f64,
     ldc: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Dsyrk,
+        Some(order),
+        [uplo as u8, trans as u8],
+        [n, k],
+        [lda, ldc],
+    );
+    if unsafe { degenerate::syrk(order, uplo, trans, n, k, alpha, a, lda, beta, c, ldc) } {
+        trace::dispatched(Path::Native);
+        return;
+    }
     let p = get_dsyrk_for_ilp64_cblas();
     if matches!(p, DsyrkProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(
-            b"cblas_dsyrk_64\0",
-            [(4, n), (5, k), (8, lda), (11, ldc)],
-        )
-        .is_none()
+        && !lp64_split::check_i64(b"cblas_dsyrk_64\0", [(4, n), (8, lda), (11, ldc)], [(5, k)])
     {
         return;
     }
@@ -217,51 +254,55 @@ pub unsafe extern "C" fn cblas_dsyrk_64(
             }
         },
         DsyrkProvider::Lp64(f) => {
-            let n = n as i32;
-            let k = k as i32;
-            let lda = lda as i32;
-            let ldc = ldc as i32;
-            match order {
-                CblasColMajor => {
-                    let uplo_char = uplo_to_char(uplo);
-                    let trans_char = transpose_to_char(trans);
-                    f(
-                        &uplo_char,
-                        &trans_char,
-                        &n,
-                        &k,
-                        &alpha,
-                        a,
-                        &lda,
-                        &beta,
-                        c,
-                        &ldc,
-                    );
-                }
-                CblasRowMajor => {
-                    let new_uplo = match uplo {
-                        CblasUpper => CblasLower,
-                        CblasLower => CblasUpper,
-                    };
-                    let new_trans = match trans {
-                        CblasNoTrans => CblasTrans,
-                        CblasTrans => CblasNoTrans,
-                        _ => CblasNoTrans,
-                    };
-                    let uplo_char = uplo_to_char(new_uplo);
-                    let trans_char = transpose_to_char(new_trans);
-                    f(
-                        &uplo_char,
-                        &trans_char,
-                        &n,
-                        &k,
-                        &alpha,
-                        a,
-                        &lda,
-                        &beta,
-                        c,
-                        &ldc,
-                    );
+            // k blocks accumulate into C; only the first one applies beta.
+            for (p0, k) in lp64_split::rank_k(k) {
+                let beta = if p0 == 0 { beta } else { 1.0 };
+                let a = a.offset(lp64_split::rank_k_offset(order, trans, p0, lda));
+                let n = n as i32;
+                let lda = lda as i32;
+                let ldc = ldc as i32;
+                match order {
+                    CblasColMajor => {
+                        let uplo_char = uplo_to_char(uplo);
+                        let trans_char = transpose_to_char(trans);
+                        f(
+                            &uplo_char,
+                            &trans_char,
+                            &n,
+                            &k,
+                            &alpha,
+                            a,
+                            &lda,
+                            &beta,
+                            c,
+                            &ldc,
+                        );
+                    }
+                    CblasRowMajor => {
+                        let new_uplo = match uplo {
+                            CblasUpper => CblasLower,
+                            CblasLower => CblasUpper,
+                        };
+                        let new_trans = match trans {
+                            CblasNoTrans => CblasTrans,
+                            CblasTrans => CblasNoTrans,
+                            _ => CblasNoTrans,
+                        };
+                        let uplo_char = uplo_to_char(new_uplo);
+                        let trans_char = transpose_to_char(new_trans);
+                        f(
+                            &uplo_char,
+                            &trans_char,
+                            &n,
+                            &k,
+                            &alpha,
+                            a,
+                            &lda,
+                            &beta,
+                            c,
+                            &ldc,
+                        );
+                    }
                 }
             }
         }
@@ -290,6 +331,31 @@ pub unsafe extern "C" fn cblas_ssyrk(
     c: *mut f32,
     ldc: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ssyrk,
+        Some(order),
+        [uplo as u8, trans as u8],
+        [n, k],
+        [lda, ldc],
+    );
+    if unsafe {
+        degenerate::syrk(
+            order,
+            uplo,
+            trans,
+            i64::from(n),
+            i64::from(k),
+            alpha,
+            a,
+            i64::from(lda),
+            beta,
+            c,
+            i64::from(ldc),
+        )
+    } {
+        trace::dispatched(Path::Native);
+        return;
+    }
     let p = get_ssyrk_for_lp64_cblas();
     match p {
         SsyrkProvider::Lp64(f) => match order {
@@ -409,13 +475,20 @@ pub unsafe extern "C" fn cblas_ssyrk_64(
     c: *mut f32,
     ldc: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ssyrk,
+        Some(order),
+        [uplo as u8, trans as u8],
+        [n, k],
+        [lda, ldc],
+    );
+    if unsafe { degenerate::syrk(order, uplo, trans, n, k, alpha, a, lda, beta, c, ldc) } {
+        trace::dispatched(Path::Native);
+        return;
+    }
     let p = get_ssyrk_for_ilp64_cblas();
     if matches!(p, SsyrkProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(
-            b"cblas_ssyrk_64\0",
-            [(4, n), (5, k), (8, lda), (11, ldc)],
-        )
-        .is_none()
+        && !lp64_split::check_i64(b"cblas_ssyrk_64\0", [(4, n), (8, lda), (11, ldc)], [(5, k)])
     {
         return;
     }
@@ -465,51 +538,55 @@ pub unsafe extern "C" fn cblas_ssyrk_64(
             }
         },
         SsyrkProvider::Lp64(f) => {
-            let n = n as i32;
-            let k = k as i32;
-            let lda = lda as i32;
-            let ldc = ldc as i32;
-            match order {
-                CblasColMajor => {
-                    let uplo_char = uplo_to_char(uplo);
-                    let trans_char = transpose_to_char(trans);
-                    f(
-                        &uplo_char,
-                        &trans_char,
-                        &n,
-                        &k,
-                        &alpha,
-                        a,
-                        &lda,
-                        &beta,
-                        c,
-                        &ldc,
-                    );
-                }
-                CblasRowMajor => {
-                    let new_uplo = match uplo {
-                        CblasUpper => CblasLower,
-                        CblasLower => CblasUpper,
-                    };
-                    let new_trans = match trans {
-                        CblasNoTrans => CblasTrans,
-                        CblasTrans => CblasNoTrans,
-                        _ => CblasNoTrans,
-                    };
-                    let uplo_char = uplo_to_char(new_uplo);
-                    let trans_char = transpose_to_char(new_trans);
-                    f(
-                        &uplo_char,
-                        &trans_char,
-                        &n,
-                        &k,
-                        &alpha,
-                        a,
-                        &lda,
-                        &beta,
-                        c,
-                        &ldc,
-                    );
+            // k blocks accumulate into C; only the first one applies beta.
+            for (p0, k) in lp64_split::rank_k(k) {
+                let beta = if p0 == 0 { beta } else { 1.0 };
+                let a = a.offset(lp64_split::rank_k_offset(order, trans, p0, lda));
+                let n = n as i32;
+                let lda = lda as i32;
+                let ldc = ldc as i32;
+                match order {
+                    CblasColMajor => {
+                        let uplo_char = uplo_to_char(uplo);
+                        let trans_char = transpose_to_char(trans);
+                        f(
+                            &uplo_char,
+                            &trans_char,
+                            &n,
+                            &k,
+                            &alpha,
+                            a,
+                            &lda,
+                            &beta,
+                            c,
+                            &ldc,
+                        );
+                    }
+                    CblasRowMajor => {
+                        let new_uplo = match uplo {
+                            CblasUpper => CblasLower,
+                            CblasLower => CblasUpper,
+                        };
+                        let new_trans = match trans {
+                            CblasNoTrans => CblasTrans,
+                            CblasTrans => CblasNoTrans,
+                            _ => CblasNoTrans,
+                        };
+                        let uplo_char = uplo_to_char(new_uplo);
+                        let trans_char = transpose_to_char(new_trans);
+                        f(
+                            &uplo_char,
+                            &trans_char,
+                            &n,
+                            &k,
+                            &alpha,
+                            a,
+                            &lda,
+                            &beta,
+                            c,
+                            &ldc,
+                        );
+                    }
                 }
             }
         }
@@ -538,6 +615,31 @@ pub unsafe extern "C" fn cblas_csyrk(
     c: *mut Complex32,
     ldc: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Csyrk,
+        Some(order),
+        [uplo as u8, trans as u8],
+        [n, k],
+        [lda, ldc],
+    );
+    if unsafe {
+        degenerate::syrk(
+            order,
+            uplo,
+            trans,
+            i64::from(n),
+            i64::from(k),
+            *alpha,
+            a,
+            i64::from(lda),
+            *beta,
+            c,
+            i64::from(ldc),
+        )
+    } {
+        trace::dispatched(Path::Native);
+        return;
+    }
     let p = get_csyrk_for_lp64_cblas();
     match p {
         CsyrkProvider::Lp64(f) => match order {
@@ -657,13 +759,20 @@ pub unsafe extern "C" fn cblas_csyrk_64(
     c: *mut Complex32,
     ldc: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Csyrk,
+        Some(order),
+        [uplo as u8, trans as u8],
+        [n, k],
+        [lda, ldc],
+    );
+    if unsafe { degenerate::syrk(order, uplo, trans, n, k, *alpha, a, lda, *beta, c, ldc) } {
+        trace::dispatched(Path::Native);
+        return;
+    }
     let p = get_csyrk_for_ilp64_cblas();
     if matches!(p, CsyrkProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(
-            b"cblas_csyrk_64\0",
-            [(4, n), (5, k), (8, lda), (11, ldc)],
-        )
-        .is_none()
+        && !lp64_split::check_i64(b"cblas_csyrk_64\0", [(4, n), (8, lda), (11, ldc)], [(5, k)])
     {
         return;
     }
@@ -713,51 +822,56 @@ pub unsafe extern "C" fn cblas_csyrk_64(
             }
         },
         CsyrkProvider::Lp64(f) => {
-            let n = n as i32;
-            let k = k as i32;
-            let lda = lda as i32;
-            let ldc = ldc as i32;
-            match order {
-                CblasColMajor => {
-                    let uplo_char = uplo_to_char(uplo);
-                    let trans_char = transpose_to_char(trans);
-                    f(
-                        &uplo_char,
-                        &trans_char,
-                        &n,
-                        &k,
-                        alpha,
-                        a,
-                        &lda,
-                        beta,
-                        c,
-                        &ldc,
-                    );
-                }
-                CblasRowMajor => {
-                    let new_uplo = match uplo {
-                        CblasUpper => CblasLower,
-                        CblasLower => CblasUpper,
-                    };
-                    let new_trans = match trans {
-                        CblasNoTrans => CblasTrans,
-                        CblasTrans => CblasNoTrans,
-                        _ => CblasNoTrans,
-                    };
-                    let uplo_char = uplo_to_char(new_uplo);
-                    let trans_char = transpose_to_char(new_trans);
-                    f(
-                        &uplo_char,
-                        &trans_char,
-                        &n,
-                        &k,
-                        alpha,
-                        a,
-                        &lda,
-                        beta,
-                        c,
-                        &ldc,
-                    );
+            // k blocks accumulate into C; only the first one applies beta.
+            let one = Complex32::new(1.0, 0.0);
+            for (p0, k) in lp64_split::rank_k(k) {
+                let beta = if p0 == 0 { beta } else { &one };
+                let a = a.offset(lp64_split::rank_k_offset(order, trans, p0, lda));
+                let n = n as i32;
+                let lda = lda as i32;
+                let ldc = ldc as i32;
+                match order {
+                    CblasColMajor => {
+                        let uplo_char = uplo_to_char(uplo);
+                        let trans_char = transpose_to_char(trans);
+                        f(
+                            &uplo_char,
+                            &trans_char,
+                            &n,
+                            &k,
+                            alpha,
+                            a,
+                            &lda,
+                            beta,
+                            c,
+                            &ldc,
+                        );
+                    }
+                    CblasRowMajor => {
+                        let new_uplo = match uplo {
+                            CblasUpper => CblasLower,
+                            CblasLower => CblasUpper,
+                        };
+                        let new_trans = match trans {
+                            CblasNoTrans => CblasTrans,
+                            CblasTrans => CblasNoTrans,
+                            _ => CblasNoTrans,
+                        };
+                        let uplo_char = uplo_to_char(new_uplo);
+                        let trans_char = transpose_to_char(new_trans);
+                        f(
+                            &uplo_char,
+                            &trans_char,
+                            &n,
+                            &k,
+                            alpha,
+                            a,
+                            &lda,
+                            beta,
+                            c,
+                            &ldc,
+                        );
+                    }
                 }
             }
         }
@@ -786,6 +900,31 @@ pub unsafe extern "C" fn cblas_zsyrk(
     c: *mut Complex64,
     ldc: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Zsyrk,
+        Some(order),
+        [uplo as u8, trans as u8],
+        [n, k],
+        [lda, ldc],
+    );
+    if unsafe {
+        degenerate::syrk(
+            order,
+            uplo,
+            trans,
+            i64::from(n),
+            i64::from(k),
+            *alpha,
+            a,
+            i64::from(lda),
+            *beta,
+            c,
+            i64::from(ldc),
+        )
+    } {
+        trace::dispatched(Path::Native);
+        return;
+    }
     let p = get_zsyrk_for_lp64_cblas();
     match p {
         ZsyrkProvider::Lp64(f) => match order {
@@ -905,13 +1044,20 @@ pub unsafe extern "C" fn cblas_zsyrk_64(
     c: *mut Complex64,
     ldc: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Zsyrk,
+        Some(order),
+        [uplo as u8, trans as u8],
+        [n, k],
+        [lda, ldc],
+    );
+    if unsafe { degenerate::syrk(order, uplo, trans, n, k, *alpha, a, lda, *beta, c, ldc) } {
+        trace::dispatched(Path::Native);
+        return;
+    }
     let p = get_zsyrk_for_ilp64_cblas();
     if matches!(p, ZsyrkProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(
-            b"cblas_zsyrk_64\0",
-            [(4, n), (5, k), (8, lda), (11, ldc)],
-        )
-        .is_none()
+        && !lp64_split::check_i64(b"cblas_zsyrk_64\0", [(4, n), (8, lda), (11, ldc)], [(5, k)])
     {
         return;
     }
@@ -961,51 +1107,56 @@ pub unsafe extern "C" fn cblas_zsyrk_64(
             }
         },
         ZsyrkProvider::Lp64(f) => {
-            let n = n as i32;
-            let k = k as i32;
-            let lda = lda as i32;
-            let ldc = ldc as i32;
-            match order {
-                CblasColMajor => {
-                    let uplo_char = uplo_to_char(uplo);
-                    let trans_char = transpose_to_char(trans);
-                    f(
-                        &uplo_char,
-                        &trans_char,
-                        &n,
-                        &k,
-                        alpha,
-                        a,
-                        &lda,
-                        beta,
-                        c,
-                        &ldc,
-                    );
-                }
-                CblasRowMajor => {
-                    let new_uplo = match uplo {
-                        CblasUpper => CblasLower,
-                        CblasLower => CblasUpper,
-                    };
-                    let new_trans = match trans {
-                        CblasNoTrans => CblasTrans,
-                        CblasTrans => CblasNoTrans,
-                        _ => CblasNoTrans,
-                    };
-                    let uplo_char = uplo_to_char(new_uplo);
-                    let trans_char = transpose_to_char(new_trans);
-                    f(
-                        &uplo_char,
-                        &trans_char,
-                        &n,
-                        &k,
-                        alpha,
-                        a,
-                        &lda,
-                        beta,
-                        c,
-                        &ldc,
-                    );
+            // k blocks accumulate into C; only the first one applies beta.
+            let one = Complex64::new(1.0, 0.0);
+            for (p0, k) in lp64_split::rank_k(k) {
+                let beta = if p0 == 0 { beta } else { &one };
+                let a = a.offset(lp64_split::rank_k_offset(order, trans, p0, lda));
+                let n = n as i32;
+                let lda = lda as i32;
+                let ldc = ldc as i32;
+                match order {
+                    CblasColMajor => {
+                        let uplo_char = uplo_to_char(uplo);
+                        let trans_char = transpose_to_char(trans);
+                        f(
+                            &uplo_char,
+                            &trans_char,
+                            &n,
+                            &k,
+                            alpha,
+                            a,
+                            &lda,
+                            beta,
+                            c,
+                            &ldc,
+                        );
+                    }
+                    CblasRowMajor => {
+                        let new_uplo = match uplo {
+                            CblasUpper => CblasLower,
+                            CblasLower => CblasUpper,
+                        };
+                        let new_trans = match trans {
+                            CblasNoTrans => CblasTrans,
+                            CblasTrans => CblasNoTrans,
+                            _ => CblasNoTrans,
+                        };
+                        let uplo_char = uplo_to_char(new_uplo);
+                        let trans_char = transpose_to_char(new_trans);
+                        f(
+                            &uplo_char,
+                            &trans_char,
+                            &n,
+                            &k,
+                            alpha,
+                            a,
+                            &lda,
+                            beta,
+                            c,
+                            &ldc,
+                        );
+                    }
                 }
             }
         }
@@ -8,20 +8,191 @@
 //! Copyright (c) 2011-2014, The OpenBLAS Project. BSD-3-Clause License.
 //! <https://github.com/OpenMathLib/OpenBLAS/blob/develop/interface/trmm.c>
 
+use std::ffi::c_char;
+
 use num_complex::{Complex32, Complex64};
 
 use crate::backend::{
     get_ctrmm_for_ilp64_cblas, get_ctrmm_for_lp64_cblas, get_dtrmm_for_ilp64_cblas,
     get_dtrmm_for_lp64_cblas, get_strmm_for_ilp64_cblas, get_strmm_for_lp64_cblas,
-    get_ztrmm_for_ilp64_cblas, get_ztrmm_for_lp64_cblas, CtrmmProvider, DtrmmProvider,
+    get_ztrmm_for_ilp64_cblas, get_ztrmm_for_lp64_cblas, try_get_cgemm_for_current_cblas,
+    try_get_dgemm_for_current_cblas, try_get_sgemm_for_current_cblas,
+    try_get_zgemm_for_current_cblas, BlasInt32, BlasInt64, CtrmmProvider, DtrmmProvider,
     StrmmProvider, ZtrmmProvider,
 };
+use crate::blas3::gemm::{
+    call_cgemm_provider, call_dgemm_provider, call_sgemm_provider, call_zgemm_provider,
+};
+use crate::blas3::parallel::{self, Triangular, UpdateCall};
+use crate::dispatch;
+use crate::lp64_split::{self, GemmBlock, Shared};
+use crate::stats::Routine;
 use crate::types::{
     diag_to_char, side_to_char, transpose_to_char, uplo_to_char, CblasColMajor, CblasLeft,
     CblasLower, CblasRight, CblasRowMajor, CblasUpper, CBLAS_DIAG, CBLAS_ORDER, CBLAS_SIDE,
     CBLAS_TRANSPOSE, CBLAS_UPLO,
 };
 
+/// Call the dtrmm provider on one column-major block of the parallel driver.
+#[allow(clippy::too_many_arguments)]
+unsafe fn call_dtrmm_provider(
+    provider: DtrmmProvider,
+    side: c_char,
+    uplo: c_char,
+    trans: c_char,
+    diag: c_char,
+    m: BlasInt32,
+    n: BlasInt32,
+    alpha: f64,
+    a: *const f64,
+    lda: BlasInt32,
+    b: *mut f64,
+    ldb: BlasInt32,
+) {
+    match provider {
+        DtrmmProvider::Lp64(f) => unsafe {
+            f(
+                &side, &uplo, &trans, &diag, &m, &n, &alpha, a, &lda, b, &ldb,
+            )
+        },
+        DtrmmProvider::Ilp64(f) => unsafe {
+            f(
+                &side,
+                &uplo,
+                &trans,
+                &diag,
+                &BlasInt64::from(m),
+                &BlasInt64::from(n),
+                &alpha,
+                a,
+                &BlasInt64::from(lda),
+                b,
+                &BlasInt64::from(ldb),
+            )
+        },
+    }
+}
+
+/// Call the strmm provider on one column-major block of the parallel driver.
+#[allow(clippy::too_many_arguments)]
+unsafe fn call_strmm_provider(
+    provider: StrmmProvider,
+    side: c_char,
+    uplo: c_char,
+    trans: c_char,
+    diag: c_char,
+    m: BlasInt32,
+    n: BlasInt32,
+    alpha: f32,
+    a: *const f32,
+    lda: BlasInt32,
+    b: *mut f32,
+    ldb: BlasInt32,
+) {
+    match provider {
+        StrmmProvider::Lp64(f) => unsafe {
+            f(
+                &side, &uplo, &trans, &diag, &m, &n, &alpha, a, &lda, b, &ldb,
+            )
+        },
+        StrmmProvider::Ilp64(f) => unsafe {
+            f(
+                &side,
+                &uplo,
+                &trans,
+                &diag,
+                &BlasInt64::from(m),
+                &BlasInt64::from(n),
+                &alpha,
+                a,
+                &BlasInt64::from(lda),
+                b,
+                &BlasInt64::from(ldb),
+            )
+        },
+    }
+}
+
+/// Call the ctrmm provider on one column-major block of the parallel driver.
+#[allow(clippy::too_many_arguments)]
+unsafe fn call_ctrmm_provider(
+    provider: CtrmmProvider,
+    side: c_char,
+    uplo: c_char,
+    trans: c_char,
+    diag: c_char,
+    m: BlasInt32,
+    n: BlasInt32,
+    alpha: Complex32,
+    a: *const Complex32,
+    lda: BlasInt32,
+    b: *mut Complex32,
+    ldb: BlasInt32,
+) {
+    match provider {
+        CtrmmProvider::Lp64(f) => unsafe {
+            f(
+                &side, &uplo, &trans, &diag, &m, &n, &alpha, a, &lda, b, &ldb,
+            )
+        },
+        CtrmmProvider::Ilp64(f) => unsafe {
+            f(
+                &side,
+                &uplo,
+                &trans,
+                &diag,
+                &BlasInt64::from(m),
+                &BlasInt64::from(n),
+                &alpha,
+                a,
+                &BlasInt64::from(lda),
+                b,
+                &BlasInt64::from(ldb),
+            )
+        },
+    }
+}
+
+/// Call the ztrmm provider on one column-major block of the parallel driver.
+#[allow(clippy::too_many_arguments)]
+unsafe fn call_ztrmm_provider(
+    provider: ZtrmmProvider,
+    side: c_char,
+    uplo: c_char,
+    trans: c_char,
+    diag: c_char,
+    m: BlasInt32,
+    n: BlasInt32,
+    alpha: Complex64,
+    a: *const Complex64,
+    lda: BlasInt32,
+    b: *mut Complex64,
+    ldb: BlasInt32,
+) {
+    match provider {
+        ZtrmmProvider::Lp64(f) => unsafe {
+            f(
+                &side, &uplo, &trans, &diag, &m, &n, &alpha, a, &lda, b, &ldb,
+            )
+        },
+        ZtrmmProvider::Ilp64(f) => unsafe {
+            f(
+                &side,
+                &uplo,
+                &trans,
+                &diag,
+                &BlasInt64::from(m),
+                &BlasInt64::from(n),
+                &alpha,
+                a,
+                &BlasInt64::from(lda),
+                b,
+                &BlasInt64::from(ldb),
+            )
+        },
+    }
+}
+
 /// Double precision triangular matrix multiply.
 ///
 /// # Safety
@@ -45,7 +216,53 @@ pub unsafe extern "C" fn cblas_dtrmm(
     b: *mut f64,
     ldb: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Dtrmm,
+        Some(order),
+        [side as u8, uplo as u8, trans as u8, diag as u8],
+        [m, n],
+        [lda, ldb],
+    );
     let p = get_dtrmm_for_lp64_cblas();
+    if let Some(tile) = parallel::tile_for(i64::from(m), i64::from(n)) {
+        let (side, uplo, m, n) =
+            parallel::col_major_view(order, side, uplo, i64::from(m), i64::from(n));
+        let (trans, diag) = (transpose_to_char(trans), diag_to_char(diag));
+        // Looked up here, as for cblas_dgemm: the pool threads running the
+        // panel updates do not see this thread's provider scope.
+        let gemm = try_get_dgemm_for_current_cblas();
+        let update = |transa, transb, alpha, blk: GemmBlock<f64>| {
+            if let Some(gemm) = gemm {
+                call_dgemm_provider(
+                    gemm, transa, transb, blk.m, blk.n, blk.k, alpha, blk.a, blk.lda, blk.b,
+                    blk.ldb, blk.beta, blk.c, blk.ldc,
+                );
+            }
+        };
+        parallel::triangular(
+            Triangular {
+                solve: false,
+                side,
+                uplo,
+                trans,
+                m,
+                n,
+                alpha,
+                one: 1.0,
+                minus_one: -1.0,
+                a,
+                lda: lda.into(),
+                b,
+                ldb: ldb.into(),
+            },
+            tile,
+            &|m, n, alpha, a, b| {
+                call_dtrmm_provider(p, side, uplo, trans, diag, m, n, alpha, a, lda, b, ldb)
+            },
+            gemm.is_some().then_some(&update as &UpdateCall<'_, f64>),
+        );
+        return;
+    }
     match p {
         DtrmmProvider::Lp64(f) => match order {
             CblasColMajor => {
@@ -175,13 +392,20 @@ pub unsafe extern "C" fn cblas_dtrmm_64(
     b: *mut f64,
     ldb: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Dtrmm,
+        Some(order),
+        [side as u8, uplo as u8, trans as u8, diag as u8],
+        [m, n],
+        [lda, ldb],
+    );
     let p = get_dtrmm_for_ilp64_cblas();
+    let (fixed, split) = match side {
+        CblasLeft => ((6, m), (7, n)),
+        CblasRight => ((7, n), (6, m)),
+    };
     if matches!(p, DtrmmProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(
-            b"cblas_dtrmm_64\0",
-            [(6, m), (7, n), (10, lda), (12, ldb)],
-        )
-        .is_none()
+        && !lp64_split::check_i64(b"cblas_dtrmm_64\0", [fixed, (10, lda), (12, ldb)], [split])
     {
         return;
     }
@@ -236,58 +460,44 @@ pub unsafe extern "C" fn cblas_dtrmm_64(
             }
         },
         DtrmmProvider::Lp64(f) => {
-            let m = m as i32;
-            let n = n as i32;
-            let lda = lda as i32;
-            let ldb = ldb as i32;
-            match order {
-                CblasColMajor => {
-                    let side_char = side_to_char(side);
-                    let uplo_char = uplo_to_char(uplo);
-                    let trans_char = transpose_to_char(trans);
-                    let diag_char = diag_to_char(diag);
-                    f(
-                        &side_char,
-                        &uplo_char,
-                        &trans_char,
-                        &diag_char,
-                        &m,
-                        &n,
-                        &alpha,
-                        a,
-                        &lda,
-                        b,
-                        &ldb,
-                    );
-                }
-                CblasRowMajor => {
-                    let new_side = match side {
+            // Blocks are cut from the column-major view, where a row-major
+            // B is transposed: the side and triangle flip and m, n swap.
+            let (side, uplo, m, n) = match order {
+                CblasColMajor => (side, uplo, m, n),
+                CblasRowMajor => (
+                    match side {
                         CblasLeft => CblasRight,
                         CblasRight => CblasLeft,
-                    };
-                    let new_uplo = match uplo {
+                    },
+                    match uplo {
                         CblasUpper => CblasLower,
                         CblasLower => CblasUpper,
-                    };
-                    let side_char = side_to_char(new_side);
-                    let uplo_char = uplo_to_char(new_uplo);
-                    let trans_char = transpose_to_char(trans);
-                    let diag_char = diag_to_char(diag);
-                    f(
-                        &side_char,
-                        &uplo_char,
-                        &trans_char,
-                        &diag_char,
-                        &n,
-                        &m,
-                        &alpha,
-                        a,
-                        &lda,
-                        b,
-                        &ldb,
-                    );
-                }
-            }
+                    },
+                    n,
+                    m,
+                ),
+            };
+            let side_char = side_to_char(side);
+            let uplo_char = uplo_to_char(uplo);
+            let trans_char = transpose_to_char(trans);
+            let diag_char = diag_to_char(diag);
+            let (a, lda32) = (Shared::new(a), lda as i32);
+            let (b, ldb32) = (Shared::new(b), ldb as i32);
+            lp64_split::side(side == CblasLeft, m, n, &|i0, mb, j0, nb| {
+                f(
+                    &side_char,
+                    &uplo_char,
+                    &trans_char,
+                    &diag_char,
+                    &mb,
+                    &nb,
+                    &alpha,
+                    a.get(),
+                    &lda32,
+                    b.at(i0, j0, ldb),
+                    &ldb32,
+                )
+            });
         }
     }
 }
@@ -315,7 +525,53 @@ pub unsafe extern "C" fn cblas_strmm(
     b: *mut f32,
     ldb: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Strmm,
+        Some(order),
+        [side as u8, uplo as u8, trans as u8, diag as u8],
+        [m, n],
+        [lda, ldb],
+    );
     let p = get_strmm_for_lp64_cblas();
+    if let Some(tile) = parallel::tile_for(i64::from(m), i64::from(n)) {
+        let (side, uplo, m, n) =
+            parallel::col_major_view(order, side, uplo, i64::from(m), i64::from(n));
+        let (trans, diag) = (transpose_to_char(trans), diag_to_char(diag));
+        // Looked up here, as for cblas_sgemm: the pool threads running the
+        // panel updates do not see this thread's provider scope.
+        let gemm = try_get_sgemm_for_current_cblas();
+        let update = |transa, transb, alpha, blk: GemmBlock<f32>| {
+            if let Some(gemm) = gemm {
+                call_sgemm_provider(
+                    gemm, transa, transb, blk.m, blk.n, blk.k, alpha, blk.a, blk.lda, blk.b,
+                    blk.ldb, blk.beta, blk.c, blk.ldc,
+                );
+            }
+        };
+        parallel::triangular(
+            Triangular {
+                solve: false,
+                side,
+                uplo,
+                trans,
+                m,
+                n,
+                alpha,
+                one: 1.0,
+                minus_one: -1.0,
+                a,
+                lda: lda.into(),
+                b,
+                ldb: ldb.into(),
+            },
+            tile,
+            &|m, n, alpha, a, b| {
+                call_strmm_provider(p, side, uplo, trans, diag, m, n, alpha, a, lda, b, ldb)
+            },
+            gemm.is_some().then_some(&update as &UpdateCall<'_, f32>),
+        );
+        return;
+    }
     match p {
         StrmmProvider::Lp64(f) => match order {
             CblasColMajor => {
@@ -445,13 +701,20 @@ pub unsafe extern "C" fn cblas_strmm_64(
     b: *mut f32,
     ldb: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Strmm,
+        Some(order),
+        [side as u8, uplo as u8, trans as u8, diag as u8],
+        [m, n],
+        [lda, ldb],
+    );
     let p = get_strmm_for_ilp64_cblas();
+    let (fixed, split) = match side {
+        CblasLeft => ((6, m), (7, n)),
+        CblasRight => ((7, n), (6, m)),
+    };
     if matches!(p, StrmmProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(
-            b"cblas_strmm_64\0",
-            [(6, m), (7, n), (10, lda), (12, ldb)],
-        )
-        .is_none()
+        && !lp64_split::check_i64(b"cblas_strmm_64\0", [fixed, (10, lda), (12, ldb)], [split])
     {
         return;
     }
@@ -506,58 +769,44 @@ pub unsafe extern "C" fn cblas_strmm_64(
             }
         },
         StrmmProvider::Lp64(f) => {
-            let m = m as i32;
-            let n = n as i32;
-            let lda = lda as i32;
-            let ldb = ldb as i32;
-            match order {
-                CblasColMajor => {
-                    let side_char = side_to_char(side);
-                    let uplo_char = uplo_to_char(uplo);
-                    let trans_char = transpose_to_char(trans);
-                    let diag_char = diag_to_char(diag);
-                    f(
-                        &side_char,
-                        &uplo_char,
-                        &trans_char,
-                        &diag_char,
-                        &m,
-                        &n,
-                        &alpha,
-                        a,
-                        &lda,
-                        b,
-                        &ldb,
-                    );
-                }
-                CblasRowMajor => {
-                    let new_side = match side {
+            // Blocks are cut from the column-major view, where a row-major
+            // B is transposed: the side and triangle flip and m, n swap.
+            let (side, uplo, m, n) = match order {
+                CblasColMajor => (side, uplo, m, n),
+                CblasRowMajor => (
+                    match side {
                         CblasLeft => CblasRight,
                         CblasRight => CblasLeft,
-                    };
-                    let new_uplo = match uplo {
+                    },
+                    match uplo {
                         CblasUpper => CblasLower,
                         CblasLower => CblasUpper,
-                    };
-                    let side_char = side_to_char(new_side);
-                    let uplo_char = uplo_to_char(new_uplo);
-                    let trans_char = transpose_to_char(trans);
-                    let diag_char = diag_to_char(diag);
-                    f(
-                        &side_char,
-                        &uplo_char,
-                        &trans_char,
-                        &diag_char,
-                        &n,
-                        &m,
-                        &alpha,
-                        a,
-                        &lda,
-                        b,
-                        &ldb,
-                    );
-                }
-            }
+                    },
+                    n,
+                    m,
+                ),
+            };
+            let side_char = side_to_char(side);
+            let uplo_char = uplo_to_char(uplo);
+            let trans_char = transpose_to_char(trans);
+            let diag_char = diag_to_char(diag);
+            let (a, lda32) = (Shared::new(a), lda as i32);
+            let (b, ldb32) = (Shared::new(b), ldb as i32);
+            lp64_split::side(side == CblasLeft, m, n, &|i0, mb, j0, nb| {
+                f(
+                    &side_char,
+                    &uplo_char,
+                    &trans_char,
+                    &diag_char,
+                    &mb,
+                    &nb,
+                    &alpha,
+                    a.get(),
+                    &lda32,
+                    b.at(i0, j0, ldb),
+                    &ldb32,
+                )
+            });
         }
     }
 }
@@ -585,7 +834,54 @@ pub unsafe extern "C" fn cblas_ctrmm(
     b: *mut Complex32,
     ldb: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ctrmm,
+        Some(order),
+        [side as u8, uplo as u8, trans as u8, diag as u8],
+        [m, n],
+        [lda, ldb],
+    );
     let p = get_ctrmm_for_lp64_cblas();
+    if let Some(tile) = parallel::tile_for(i64::from(m), i64::from(n)) {
+        let (side, uplo, m, n) =
+            parallel::col_major_view(order, side, uplo, i64::from(m), i64::from(n));
+        let (trans, diag) = (transpose_to_char(trans), diag_to_char(diag));
+        // Looked up here, as for cblas_cgemm: the pool threads running the
+        // panel updates do not see this thread's provider scope.
+        let gemm = try_get_cgemm_for_current_cblas();
+        let update = |transa, transb, alpha, blk: GemmBlock<Complex32>| {
+            if let Some(gemm) = gemm {
+                call_cgemm_provider(
+                    gemm, transa, transb, blk.m, blk.n, blk.k, &alpha, blk.a, blk.lda, blk.b,
+                    blk.ldb, &blk.beta, blk.c, blk.ldc,
+                );
+            }
+        };
+        parallel::triangular(
+            Triangular {
+                solve: false,
+                side,
+                uplo,
+                trans,
+                m,
+                n,
+                alpha: unsafe { *alpha },
+                one: Complex32::new(1.0, 0.0),
+                minus_one: Complex32::new(-1.0, 0.0),
+                a,
+                lda: lda.into(),
+                b,
+                ldb: ldb.into(),
+            },
+            tile,
+            &|m, n, alpha, a, b| {
+                call_ctrmm_provider(p, side, uplo, trans, diag, m, n, alpha, a, lda, b, ldb)
+            },
+            gemm.is_some()
+                .then_some(&update as &UpdateCall<'_, Complex32>),
+        );
+        return;
+    }
     match p {
         CtrmmProvider::Lp64(f) => match order {
             CblasColMajor => {
@@ -715,13 +1011,20 @@ pub unsafe extern "C" fn cblas_ctrmm_64(
     b: *mut Complex32,
     ldb: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ctrmm,
+        Some(order),
+        [side as u8, uplo as u8, trans as u8, diag as u8],
+        [m, n],
+        [lda, ldb],
+    );
     let p = get_ctrmm_for_ilp64_cblas();
+    let (fixed, split) = match side {
+        CblasLeft => ((6, m), (7, n)),
+        CblasRight => ((7, n), (6, m)),
+    };
     if matches!(p, CtrmmProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(
-            b"cblas_ctrmm_64\0",
-            [(6, m), (7, n), (10, lda), (12, ldb)],
-        )
-        .is_none()
+        && !lp64_split::check_i64(b"cblas_ctrmm_64\0", [fixed, (10, lda), (12, ldb)], [split])
     {
         return;
     }
@@ -776,58 +1079,45 @@ pub unsafe extern "C" fn cblas_ctrmm_64(
             }
         },
         CtrmmProvider::Lp64(f) => {
-            let m = m as i32;
-            let n = n as i32;
-            let lda = lda as i32;
-            let ldb = ldb as i32;
-            match order {
-                CblasColMajor => {
-                    let side_char = side_to_char(side);
-                    let uplo_char = uplo_to_char(uplo);
-                    let trans_char = transpose_to_char(trans);
-                    let diag_char = diag_to_char(diag);
-                    f(
-                        &side_char,
-                        &uplo_char,
-                        &trans_char,
-                        &diag_char,
-                        &m,
-                        &n,
-                        alpha,
-                        a,
-                        &lda,
-                        b,
-                        &ldb,
-                    );
-                }
-                CblasRowMajor => {
-                    let new_side = match side {
+            // Blocks are cut from the column-major view, where a row-major
+            // B is transposed: the side and triangle flip and m, n swap.
+            let (side, uplo, m, n) = match order {
+                CblasColMajor => (side, uplo, m, n),
+                CblasRowMajor => (
+                    match side {
                         CblasLeft => CblasRight,
                         CblasRight => CblasLeft,
-                    };
-                    let new_uplo = match uplo {
+                    },
+                    match uplo {
                         CblasUpper => CblasLower,
                         CblasLower => CblasUpper,
-                    };
-                    let side_char = side_to_char(new_side);
-                    let uplo_char = uplo_to_char(new_uplo);
-                    let trans_char = transpose_to_char(trans);
-                    let diag_char = diag_to_char(diag);
-                    f(
-                        &side_char,
-                        &uplo_char,
-                        &trans_char,
-                        &diag_char,
-                        &n,
-                        &m,
-                        alpha,
-                        a,
-                        &lda,
-                        b,
-                        &ldb,
-                    );
-                }
-            }
+                    },
+                    n,
+                    m,
+                ),
+            };
+            let side_char = side_to_char(side);
+            let uplo_char = uplo_to_char(uplo);
+            let trans_char = transpose_to_char(trans);
+            let diag_char = diag_to_char(diag);
+            let alpha = *alpha;
+            let (a, lda32) = (Shared::new(a), lda as i32);
+            let (b, ldb32) = (Shared::new(b), ldb as i32);
+            lp64_split::side(side == CblasLeft, m, n, &|i0, mb, j0, nb| {
+                f(
+                    &side_char,
+                    &uplo_char,
+                    &trans_char,
+                    &diag_char,
+                    &mb,
+                    &nb,
+                    &alpha,
+                    a.get(),
+                    &lda32,
+                    b.at(i0, j0, ldb),
+                    &ldb32,
+                )
+            });
         }
     }
 }
@@ -855,7 +1145,54 @@ pub unsafe extern "C" fn cblas_ztrmm(
     b: *mut Complex64,
     ldb: i32,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ztrmm,
+        Some(order),
+        [side as u8, uplo as u8, trans as u8, diag as u8],
+        [m, n],
+        [lda, ldb],
+    );
     let p = get_ztrmm_for_lp64_cblas();
+    if let Some(tile) = parallel::tile_for(i64::from(m), i64::from(n)) {
+        let (side, uplo, m, n) =
+            parallel::col_major_view(order, side, uplo, i64::from(m), i64::from(n));
+        let (trans, diag) = (transpose_to_char(trans), diag_to_char(diag));
+        // Looked up here, as for cblas_zgemm: the pool threads running the
+        // panel updates do not see this thread's provider scope.
+        let gemm = try_get_zgemm_for_current_cblas();
+        let update = |transa, transb, alpha, blk: GemmBlock<Complex64>| {
+            if let Some(gemm) = gemm {
+                call_zgemm_provider(
+                    gemm, transa, transb, blk.m, blk.n, blk.k, &alpha, blk.a, blk.lda, blk.b,
+                    blk.ldb, &blk.beta, blk.c, blk.ldc,
+                );
+            }
+        };
+        parallel::triangular(
+            Triangular {
+                solve: false,
+                side,
+                uplo,
+                trans,
+                m,
+                n,
+                alpha: unsafe { *alpha },
+                one: Complex64::new(1.0, 0.0),
+                minus_one: Complex64::new(-1.0, 0.0),
+                a,
+                lda: lda.into(),
+                b,
+                ldb: ldb.into(),
+            },
+            tile,
+            &|m, n, alpha, a, b| {
+                call_ztrmm_provider(p, side, uplo, trans, diag, m, n, alpha, a, lda, b, ldb)
+            },
+            gemm.is_some()
+                .then_some(&update as &UpdateCall<'_, Complex64>),
+        );
+        return;
+    }
     match p {
         ZtrmmProvider::Lp64(f) => match order {
             CblasColMajor => {
@@ -985,13 +1322,20 @@ pub unsafe extern "C" fn cblas_ztrmm_64(
     b: *mut Complex64,
     ldb: i64,
 ) {
+    let _call = dispatch::enter(
+        Routine::Ztrmm,
+        Some(order),
+        [side as u8, uplo as u8, trans as u8, diag as u8],
+        [m, n],
+        [lda, ldb],
+    );
     let p = get_ztrmm_for_ilp64_cblas();
+    let (fixed, split) = match side {
+        CblasLeft => ((6, m), (7, n)),
+        CblasRight => ((7, n), (6, m)),
+    };
     if matches!(p, ZtrmmProvider::Lp64(_))
-        && crate::int_convert::to_lp64_array_i64(
-            b"cblas_ztrmm_64\0",
-            [(6, m), (7, n), (10, lda), (12, ldb)],
-        )
-        .is_none()
+        && !lp64_split::check_i64(b"cblas_ztrmm_64\0", [fixed, (10, lda), (12, ldb)], [split])
     {
         return;
     }
@@ -1046,58 +1390,45 @@ pub unsafe extern "C" fn cblas_ztrmm_64(
             }
         },
         ZtrmmProvider::Lp64(f) => {
-            let m = m as i32;
-            let n = n as i32;
-            let lda = lda as i32;
-            let ldb = ldb as i32;
-            match order {
-                CblasColMajor => {
-                    let side_char = side_to_char(side);
-                    let uplo_char = uplo_to_char(uplo);
-                    let trans_char = transpose_to_char(trans);
-                    let diag_char = diag_to_char(diag);
-                    f(
-                        &side_char,
-                        &uplo_char,
-                        &trans_char,
-                        &diag_char,
-                        &m,
-                        &n,
-                        alpha,
-                        a,
-                        &lda,
-                        b,
-                        &ldb,
-                    );
-                }
-                CblasRowMajor => {
-                    let new_side = match side {
+            // Blocks are cut from the column-major view, where a row-major
+            // B is transposed: the side and triangle flip and m, n swap.
+            let (side, uplo, m, n) = match order {
+                CblasColMajor => (side, uplo, m, n),
+                CblasRowMajor => (
+                    match side {
                         CblasLeft => CblasRight,
                         CblasRight => CblasLeft,
-                    };
-                    let new_uplo = match uplo {
+                    },
+                    match uplo {
                         CblasUpper => CblasLower,
                         CblasLower => CblasUpper,
-                    };
-                    let side_char = side_to_char(new_side);
-                    let uplo_char = uplo_to_char(new_uplo);
-                    let trans_char = transpose_to_char(trans);
-                    let diag_char = diag_to_char(diag);
-                    f(
-                        &side_char,
-                        &uplo_char,
-                        &trans_char,
-                        &diag_char,
-                        &n,
-                        &m,
-                        alpha,
-                        a,
-                        &lda,
-                        b,
-                        &ldb,
-                    );
-                }
-            }
+                    },
+                    n,
+                    m,
+                ),
+            };
+            let side_char = side_to_char(side);
+            let uplo_char = uplo_to_char(uplo);
+            let trans_char = transpose_to_char(trans);
+            let diag_char = diag_to_char(diag);
+            let alpha = *alpha;
+            let (a, lda32) = (Shared::new(a), lda as i32);
+            let (b, ldb32) = (Shared::new(b), ldb as i32);
+            lp64_split::side(side == CblasLeft, m, n, &|i0, mb, j0, nb| {
+                f(
+                    &side_char,
+                    &uplo_char,
+                    &trans_char,
+                    &diag_char,
+                    &mb,
+                    &nb,
+                    &alpha,
+                    a.get(),
+                    &lda32,
+                    b.at(i0, j0, ldb),
+                    &ldb32,
+                )
+            });
         }
     }
 }
@@ -0,0 +1,987 @@
+//! Coalescing of repeated same-matrix Level 2 calls - cblas-inject extension.
+//!
+//! Time-steppers and block iterations call `?gemv`, `?trsv` or `?tbsv` many
+//! times in a row with one matrix and different vectors, and every call
+//! streams the whole matrix from memory. Between
+//! `cblas_inject_begin_coalesce()` and `cblas_inject_flush_coalesce()` the
+//! calling thread defers these calls instead. Consecutive deferred calls of
+//! one routine with the same matrix and the same other arguments but the
+//! vectors form a group, and each group runs as one multi-right-hand-side
+//! call:
+//!
+//! - `?gemv` calls become one `?gemm` on the gathered vectors;
+//! - `?trsv` calls become one left-sided `?trsm`;
+//! - `?tbsv` calls, which have no Level 3 counterpart, go to the native band
+//!   solve in `native::tbsm`, which reads the band once for all of them.
+//!
+//! A group ends at the flush, after `MAX_CALLS` calls, or at a call that does
+//! not match it or that touches memory an earlier call in the group writes
+//! (or writes memory one reads). Calls of the three routines that are never
+//! deferred (invalid arguments, and `CblasConjNoTrans` on complex `?gemv` and
+//! `?trsv`, which `?gemm` and `?trsm` do not take) run the pending group
+//! first, so these routines stay in call order. Nothing else is: until the
+//! flush the caller must not read the outputs of deferred calls, nor write
+//! their inputs, by any other means. A group of one call, and a `?gemv` or
+//! `?trsv` group when no `?gemm` or `?trsm` is registered, runs as the
+//! original calls.
+//!
+//! Coalescing is per thread and deferred calls run on the thread that made
+//! them. Calls still deferred when the thread exits are dropped.
+
+use std::cell::RefCell;
+use std::ffi::c_void;
+use std::sync::atomic::{AtomicUsize, Ordering};
+
+use num_complex::{Complex32, Complex64};
+
+use crate::backend::{
+    try_get_cgemm_for_ilp64_cblas, try_get_ctrsm_for_ilp64_cblas, try_get_dgemm_for_ilp64_cblas,
+    try_get_dtrsm_for_ilp64_cblas, try_get_sgemm_for_ilp64_cblas, try_get_strsm_for_ilp64_cblas,
+    try_get_zgemm_for_ilp64_cblas, try_get_ztrsm_for_ilp64_cblas, CBLAS_INJECT_STATUS_OK,
+};
+use crate::blas2::gemv::{cblas_cgemv_64, cblas_dgemv_64, cblas_sgemv_64, cblas_zgemv_64};
+use crate::blas2::tbsv::{cblas_ctbsv_64, cblas_dtbsv_64, cblas_stbsv_64, cblas_ztbsv_64};
+use crate::blas2::trsv::{cblas_ctrsv_64, cblas_dtrsv_64, cblas_strsv_64, cblas_ztrsv_64};
+use crate::blas3::gemm::{cblas_cgemm_64, cblas_dgemm_64, cblas_sgemm_64, cblas_zgemm_64};
+use crate::blas3::trsm::{cblas_ctrsm_64, cblas_dtrsm_64, cblas_strsm_64, cblas_ztrsm_64};
+use crate::native::tbsm::{tbsm, Solve};
+use crate::scratch::{self, ScratchElem};
+use crate::trace::{self, Path};
+use crate::types::{
+    CblasColMajor, CblasConjNoTrans, CblasConjTrans, CblasLeft, CblasLower, CblasNoTrans,
+    CblasRowMajor, CblasTrans, CblasUnit, CblasUpper, CBLAS_DIAG, CBLAS_ORDER, CBLAS_TRANSPOSE,
+    CBLAS_UPLO,
+};
+
+/// Largest number of calls in one group.
+const MAX_CALLS: usize = 64;
+
+/// Threads with coalescing on; lets every other thread skip the
+/// thread-local lookup.
+static ACTIVE: AtomicUsize = AtomicUsize::new(0);
+
+#[derive(Clone, Copy, PartialEq)]
+pub(crate) enum Elem {
+    S,
+    D,
+    C,
+    Z,
+}
+
+/// Element type of a coalesced call, with the entry points a group runs
+/// through.
+#[allow(clippy::too_many_arguments)]
+pub(crate) trait Coalesce: Solve + PartialEq + ScratchElem {
+    const ELEM: Elem;
+
+    /// Scalars are kept as `Complex64` in the group key.
+    fn widen(self) -> Complex64;
+    fn narrow(v: Complex64) -> Self;
+
+    fn has_gemm() -> bool;
+    fn has_trsm() -> bool;
+
+    unsafe fn gemm(
+        order: CBLAS_ORDER,
+        transa: CBLAS_TRANSPOSE,
+        m: i64,
+        n: i64,
+        k: i64,
+        alpha: Self,
+        a: *const Self,
+        lda: i64,
+        b: *const Self,
+        ldb: i64,
+        beta: Self,
+        c: *mut Self,
+        ldc: i64,
+    );
+
+    unsafe fn trsm(
+        order: CBLAS_ORDER,
+        uplo: CBLAS_UPLO,
+        trans: CBLAS_TRANSPOSE,
+        diag: CBLAS_DIAG,
+        m: i64,
+        n: i64,
+        a: *const Self,
+        lda: i64,
+        b: *mut Self,
+        ldb: i64,
+    );
+
+    unsafe fn gemv(
+        order: CBLAS_ORDER,
+        trans: CBLAS_TRANSPOSE,
+        m: i64,
+        n: i64,
+        alpha: Self,
+        a: *const Self,
+        lda: i64,
+        x: *const Self,
+        incx: i64,
+        beta: Self,
+        y: *mut Self,
+        incy: i64,
+    );
+
+    unsafe fn trsv(
+        order: CBLAS_ORDER,
+        uplo: CBLAS_UPLO,
+        trans: CBLAS_TRANSPOSE,
+        diag: CBLAS_DIAG,
+        n: i64,
+        a: *const Self,
+        lda: i64,
+        x: *mut Self,
+        incx: i64,
+    );
+
+    unsafe fn tbsv(
+        order: CBLAS_ORDER,
+        uplo: CBLAS_UPLO,
+        trans: CBLAS_TRANSPOSE,
+        diag: CBLAS_DIAG,
+        n: i64,
+        k: i64,
+        a: *const Self,
+        lda: i64,
+        x: *mut Self,
+        incx: i64,
+    );
+}
+
+/// `$($by)?` is `&` for the complex types, whose CBLAS scalars are passed by
+/// pointer.
+macro_rules! impl_coalesce {
+    (
+        $t:ty,
+        $elem:ident,
+        [$widen:expr, $narrow:expr],
+        [$try_gemm:ident, $try_trsm:ident],
+        [$gemm:ident, $trsm:ident, $gemv:ident, $trsv:ident, $tbsv:ident]
+        $(, $by:tt)?
+    ) => {
+        impl Coalesce for $t {
+            const ELEM: Elem = Elem::$elem;
+
+            #[inline]
+            fn widen(self) -> Complex64 {
+                let widen: fn($t) -> Complex64 = $widen;
+                widen(self)
+            }
+
+            #[inline]
+            fn narrow(v: Complex64) -> Self {
+                let narrow: fn(Complex64) -> $t = $narrow;
+                narrow(v)
+            }
+
+            fn has_gemm() -> bool {
+                $try_gemm().is_some()
+            }
+
+            fn has_trsm() -> bool {
+                $try_trsm().is_some()
+            }
+
+            unsafe fn gemm(
+                order: CBLAS_ORDER,
+                transa: CBLAS_TRANSPOSE,
+                m: i64,
+                n: i64,
+                k: i64,
+                alpha: Self,
+                a: *const Self,
+                lda: i64,
+                b: *const Self,
+                ldb: i64,
+                beta: Self,
+                c: *mut Self,
+                ldc: i64,
+            ) {
+                unsafe {
+                    $gemm(
+                        order,
+                        transa,
+                        CblasNoTrans,
+                        m,
+                        n,
+                        k,
+                        $($by)? alpha,
+                        a,
+                        lda,
+                        b,
+                        ldb,
+                        $($by)? beta,
+                        c,
+                        ldc,
+                    )
+                }
+            }
+
+            unsafe fn trsm(
+                order: CBLAS_ORDER,
+                uplo: CBLAS_UPLO,
+                trans: CBLAS_TRANSPOSE,
+                diag: CBLAS_DIAG,
+                m: i64,
+                n: i64,
+                a: *const Self,
+                lda: i64,
+                b: *mut Self,
+                ldb: i64,
+            ) {
+                let one = Self::narrow(Complex64::new(1.0, 0.0));
+                unsafe {
+                    $trsm(order, CblasLeft, uplo, trans, diag, m, n, $($by)? one, a, lda, b, ldb)
+                }
+            }
+
+            unsafe fn gemv(
+                order: CBLAS_ORDER,
+                trans: CBLAS_TRANSPOSE,
+                m: i64,
+                n: i64,
+                alpha: Self,
+                a: *const Self,
+                lda: i64,
+                x: *const Self,
+                incx: i64,
+                beta: Self,
+                y: *mut Self,
+                incy: i64,
+            ) {
+                unsafe {
+                    $gemv(
+                        order,
+                        trans,
+                        m,
+                        n,
+                        $($by)? alpha,
+                        a,
+                        lda,
+                        x,
+                        incx,
+                        $($by)? beta,
+                        y,
+                        incy,
+                    )
+                }
+            }
+
+            unsafe fn trsv(
+                order: CBLAS_ORDER,
+                uplo: CBLAS_UPLO,
+                trans: CBLAS_TRANSPOSE,
+                diag: CBLAS_DIAG,
+                n: i64,
+                a: *const Self,
+                lda: i64,
+                x: *mut Self,
+                incx: i64,
+            ) {
+                unsafe { $trsv(order, uplo, trans, diag, n, a, lda, x, incx) }
+            }
+
+            unsafe fn tbsv(
+                order: CBLAS_ORDER,
+                uplo: CBLAS_UPLO,
+                trans: CBLAS_TRANSPOSE,
+                diag: CBLAS_DIAG,
+                n: i64,
+                k: i64,
+                a: *const Self,
+                lda: i64,
+                x: *mut Self,
+                incx: i64,
+            ) {
+                unsafe { $tbsv(order, uplo, trans, diag, n, k, a, lda, x, incx) }
+            }
+        }
+    };
+}
+
+impl_coalesce!(
+    f32,
+    S,
+    [|v| Complex64::new(f64::from(v), 0.0), |v| v.re as f32],
+    [try_get_sgemm_for_ilp64_cblas, try_get_strsm_for_ilp64_cblas],
+    [
+        cblas_sgemm_64,
+        cblas_strsm_64,
+        cblas_sgemv_64,
+        cblas_strsv_64,
+        cblas_stbsv_64
+    ]
+);
+impl_coalesce!(
+    f64,
+    D,
+    [|v| Complex64::new(v, 0.0), |v| v.re],
+    [try_get_dgemm_for_ilp64_cblas, try_get_dtrsm_for_ilp64_cblas],
+    [
+        cblas_dgemm_64,
+        cblas_dtrsm_64,
+        cblas_dgemv_64,
+        cblas_dtrsv_64,
+        cblas_dtbsv_64
+    ]
+);
+impl_coalesce!(
+    Complex32,
+    C,
+    [
+        |v| Complex64::new(f64::from(v.re), f64::from(v.im)),
+        |v| Complex32::new(v.re as f32, v.im as f32)
+    ],
+    [try_get_cgemm_for_ilp64_cblas, try_get_ctrsm_for_ilp64_cblas],
+    [cblas_cgemm_64, cblas_ctrsm_64, cblas_cgemv_64, cblas_ctrsv_64, cblas_ctbsv_64],
+    &
+);
+impl_coalesce!(
+    Complex64,
+    Z,
+    [|v| v, |v| v],
+    [try_get_zgemm_for_ilp64_cblas, try_get_ztrsm_for_ilp64_cblas],
+    [cblas_zgemm_64, cblas_ztrsm_64, cblas_zgemv_64, cblas_ztrsv_64, cblas_ztbsv_64],
+    &
+);
+
+/// Everything about a call but its vectors; calls with equal keys group.
+#[derive(Clone, Copy, PartialEq)]
+enum Op {
+    Gemv {
+        trans: CBLAS_TRANSPOSE,
+        m: i64,
+        n: i64,
+        alpha: Complex64,
+        beta: Complex64,
+    },
+    Trsv {
+        uplo: CBLAS_UPLO,
+        trans: CBLAS_TRANSPOSE,
+        diag: CBLAS_DIAG,
+        n: i64,
+    },
+    Tbsv {
+        uplo: CBLAS_UPLO,
+        trans: CBLAS_TRANSPOSE,
+        diag: CBLAS_DIAG,
+        n: i64,
+        k: i64,
+    },
+}
+
+#[derive(Clone, Copy, PartialEq)]
+struct Key {
+    elem: Elem,
+    order: CBLAS_ORDER,
+    op: Op,
+    a: *const c_void,
+    lda: i64,
+}
+
+/// The vectors of one call; a solve has `y == x`.
+#[derive(Clone, Copy)]
+struct Vectors {
+    x: *const c_void,
+    incx: i64,
+    y: *mut c_void,
+    incy: i64,
+}
+
+/// Half-open address range; empty ranges never overlap.
+#[derive(Clone, Copy)]
+struct Span(usize, usize);
+
+impl Span {
+    const EMPTY: Span = Span(0, 0);
+
+    fn overlaps(self, other: Span) -> bool {
+        self.0 < other.1 && other.0 < self.1
+    }
+
+    /// Span of the `len` elements `inc` apart at `ptr`.
+    fn vector<T>(ptr: *const T, len: i64, inc: i64) -> Span {
+        Span::lines::<T>(ptr, len, 1, inc.abs())
+    }
+
+    /// Span of `count` lines of `len` elements, `ld` apart, at `ptr`.
+    fn lines<T>(ptr: *const T, count: i64, len: i64, ld: i64) -> Span {
+        if ptr.is_null() || count <= 0 || len <= 0 {
+            return Span::EMPTY;
+        }
+        let elems = (count - 1).saturating_mul(ld).saturating_add(len);
+        let bytes = usize::try_from(elems)
+            .unwrap_or(usize::MAX)
+            .saturating_mul(std::mem::size_of::<T>());
+        let start = ptr as usize;
+        Span(start, start.saturating_add(bytes))
+    }
+}
+
+/// A call to defer, with the memory it reads and writes.
+struct Entry {
+    key: Key,
+    vectors: Vectors,
+    reads: [Span; 3],
+    write: Span,
+}
+
+struct Group {
+    key: Key,
+    calls: Vec<Vectors>,
+    reads: Vec<Span>,
+    writes: Vec<Span>,
+}
+
+impl Group {
+    fn new(entry: Entry) -> Group {
+        let mut group = Group {
+            key: entry.key,
+            calls: Vec::new(),
+            reads: Vec::new(),
+            writes: Vec::new(),
+        };
+        group.push(entry);
+        group
+    }
+
+    fn admits(&self, entry: &Entry) -> bool {
+        let touched = |spans: &[Span], span: Span| spans.iter().any(|s| s.overlaps(span));
+        entry.key == self.key
+            && self.calls.len() < MAX_CALLS
+            && !touched(&self.reads, entry.write)
+            && !touched(&self.writes, entry.write)
+            && !entry.reads.iter().any(|&r| touched(&self.writes, r))
+    }
+
+    fn push(&mut self, entry: Entry) {
+        self.calls.push(entry.vectors);
+        self.reads.extend(entry.reads);
+        self.writes.push(entry.write);
+    }
+}
+
+struct State {
+    active: bool,
+    /// Set while a group runs, so its calls are not deferred again.
+    flushing: bool,
+    group: Option<Group>,
+}
+
+impl Drop for State {
+    fn drop(&mut self) {
+        if self.active {
+            ACTIVE.fetch_sub(1, Ordering::Relaxed);
+        }
+    }
+}
+
+thread_local! {
+    static STATE: RefCell<State> = const {
+        RefCell::new(State {
+            active: false,
+            flushing: false,
+            group: None,
+        })
+    };
+}
+
+/// Start deferring `?gemv`, `?trsv` and `?tbsv` calls on the calling thread.
+/// Calling it while coalescing is on does nothing.
+#[no_mangle]
+pub extern "C" fn cblas_inject_begin_coalesce() -> i32 {
+    let _ = STATE.try_with(|state| {
+        let mut state = state.borrow_mut();
+        if !state.active {
+            state.active = true;
+            ACTIVE.fetch_add(1, Ordering::Relaxed);
+        }
+    });
+    CBLAS_INJECT_STATUS_OK
+}
+
+/// Run the calls deferred on the calling thread and stop deferring.
+///
+/// # Safety
+///
+/// Every pointer passed to a deferred call must still be valid.
+#[no_mangle]
+pub unsafe extern "C" fn cblas_inject_flush_coalesce() -> i32 {
+    let group = STATE
+        .try_with(|state| {
+            let mut state = state.borrow_mut();
+            if state.active {
+                state.active = false;
+                ACTIVE.fetch_sub(1, Ordering::Relaxed);
+            }
+            state.group.take()
+        })
+        .ok()
+        .flatten();
+    if let Some(group) = group {
+        unsafe { run(group) };
+    }
+    CBLAS_INJECT_STATUS_OK
+}
+
+/// Whether a deferred group is running on the calling thread. Its calls were
+/// counted and traced when they were deferred, so the wrappers it runs them
+/// through skip that.
+pub(crate) fn flushing() -> bool {
+    STATE
+        .try_with(|state| state.try_borrow().is_ok_and(|state| state.flushing))
+        .unwrap_or(false)
+}
+
+#[inline(always)]
+fn active() -> bool {
+    ACTIVE.load(Ordering::Relaxed) != 0
+}
+
+/// Defer `entry` into the current group, or, for `None`, run the group so
+/// the caller can make its call. Returns whether the call was deferred.
+unsafe fn defer(entry: Option<Entry>) -> bool {
+    let (deferred, ready) = STATE
+        .try_with(|state| {
+            let mut state = state.borrow_mut();
+            if !state.active || state.flushing {
+                return (false, None);
+            }
+            let Some(entry) = entry else {
+                return (false, state.group.take());
+            };
+            if let Some(group) = &mut state.group {
+                if group.admits(&entry) {
+                    group.push(entry);
+                    return (true, None);
+                }
+            }
+            (true, state.group.replace(Group::new(entry)))
+        })
+        .unwrap_or((false, None));
+    if let Some(group) = ready {
+        unsafe { run(group) };
+    }
+    if deferred {
+        trace::dispatched(Path::Deferred);
+    }
+    deferred
+}
+
+/// Clears `State::flushing` when the group has run, or unwound.
+struct Flushing;
+
+impl Drop for Flushing {
+    fn drop(&mut self) {
+        let _ = STATE.try_with(|state| state.borrow_mut().flushing = false);
+    }
+}
+
+unsafe fn run(group: Group) {
+    let _ = STATE.try_with(|state| state.borrow_mut().flushing = true);
+    let _flushing = Flushing;
+    unsafe {
+        match group.key.elem {
+            Elem::S => execute::<f32>(&group),
+            Elem::D => execute::<f64>(&group),
+            Elem::C => execute::<Complex32>(&group),
+            Elem::Z => execute::<Complex64>(&group),
+        }
+    }
+}
+
+/// The transpose as `?gemm` and `?trsm` take it: conjugation is dropped for
+/// real elements, and `CblasConjNoTrans` is `None` for complex ones.
+fn plain<T: Coalesce>(trans: CBLAS_TRANSPOSE) -> Option<CBLAS_TRANSPOSE> {
+    match trans {
+        CblasConjTrans if !T::IS_COMPLEX => Some(CblasTrans),
+        CblasConjNoTrans if !T::IS_COMPLEX => Some(CblasNoTrans),
+        CblasConjNoTrans => None,
+        trans => Some(trans),
+    }
+}
+
+/// Offset of element j of the `len` elements `inc` apart at a vector's
+/// pointer; a negative `inc` walks the vector from its last element.
+fn element(len: usize, inc: i64, j: usize) -> usize {
+    let step = inc.unsigned_abs() as usize;
+    if inc > 0 {
+        j * step
+    } else {
+        (len - 1 - j) * step
+    }
+}
+
+/// Index of element j of column c in a `len x cols` block laid out in
+/// `order`.
+fn slot(order: CBLAS_ORDER, len: usize, cols: usize, j: usize, c: usize) -> usize {
+    match order {
+        CblasColMajor => j + c * len,
+        CblasRowMajor => j * cols + c,
+    }
+}
+
+/// Leading dimension of that block.
+fn ld(order: CBLAS_ORDER, len: usize, cols: usize) -> i64 {
+    match order {
+        CblasColMajor => len.max(1) as i64,
+        CblasRowMajor => cols as i64,
+    }
+}
+
+/// Copy each call's vector (`x` or, with `y`, `y`) into a column of `block`.
+unsafe fn gather<T: Coalesce>(
+    order: CBLAS_ORDER,
+    len: usize,
+    calls: &[Vectors],
+    y: bool,
+    block: &mut [T],
+) {
+    for (c, v) in calls.iter().enumerate() {
+        let (ptr, inc) = if y {
+            (v.y.cast_const().cast::<T>(), v.incy)
+        } else {
+            (v.x.cast::<T>(), v.incx)
+        };
+        for j in 0..len {
+            block[slot(order, len, calls.len(), j, c)] = unsafe { *ptr.add(element(len, inc, j)) };
+        }
+    }
+}
+
+/// Copy the columns of `block` back to each call's `y`.
+unsafe fn scatter<T: Coalesce>(order: CBLAS_ORDER, len: usize, calls: &[Vectors], block: &[T]) {
+    for (c, v) in calls.iter().enumerate() {
+        let ptr = v.y.cast::<T>();
+        for j in 0..len {
+            unsafe {
+                *ptr.add(element(len, v.incy, j)) = block[slot(order, len, calls.len(), j, c)]
+            };
+        }
+    }
+}
+
+unsafe fn execute<T: Coalesce>(group: &Group) {
+    let Key { order, op, lda, .. } = group.key;
+    let a = group.key.a.cast::<T>();
+    let calls = &group.calls[..];
+    let nrhs = calls.len();
+    match op {
+        Op::Gemv {
+            trans,
+            m,
+            n,
+            alpha,
+            beta,
+        } => {
+            let (alpha, beta) = (T::narrow(alpha), T::narrow(beta));
+            if nrhs == 1 || !T::has_gemm() {
+                for v in calls {
+                    let (x, y) = (v.x.cast(), v.y.cast());
+                    unsafe {
+                        T::gemv(
+                            order, trans, m, n, alpha, a, lda, x, v.incx, beta, y, v.incy,
+                        )
+                    };
+                }
+                return;
+            }
+            let (lenx, leny) = if trans == CblasNoTrans {
+                (n, m)
+            } else {
+                (m, n)
+            };
+            let (lenx, leny) = (lenx as usize, leny as usize);
+            let mut block = scratch::take::<T>((lenx + leny) * nrhs);
+            let (xs, ys) = block.split_at_mut(lenx * nrhs);
+            unsafe { gather(order, lenx, calls, false, xs) };
+            if beta.is_zero() {
+                ys.fill(T::ZERO);
+            } else {
+                unsafe { gather(order, leny, calls, true, ys) };
+            }
+            unsafe {
+                T::gemm(
+                    order,
+                    trans,
+                    leny as i64,
+                    nrhs as i64,
+                    lenx as i64,
+                    alpha,
+                    a,
+                    lda,
+                    xs.as_ptr(),
+                    ld(order, lenx, nrhs),
+                    beta,
+                    ys.as_mut_ptr(),
+                    ld(order, leny, nrhs),
+                );
+                scatter(order, leny, calls, ys);
+            }
+        }
+        Op::Trsv {
+            uplo,
+            trans,
+            diag,
+            n,
+        } => {
+            if nrhs == 1 || !T::has_trsm() {
+                for v in calls {
+                    unsafe { T::trsv(order, uplo, trans, diag, n, a, lda, v.y.cast(), v.incy) };
+                }
+                return;
+            }
+            let len = n as usize;
+            let mut block = scratch::take::<T>(len * nrhs);
+            unsafe {
+                gather(order, len, calls, true, &mut block);
+                T::trsm(
+                    order,
+                    uplo,
+                    trans,
+                    diag,
+                    n,
+                    nrhs as i64,
+                    a,
+                    lda,
+                    block.as_mut_ptr(),
+                    ld(order, len, nrhs),
+                );
+                scatter(order, len, calls, &block);
+            }
+        }
+        Op::Tbsv {
+            uplo,
+            trans,
+            diag,
+            n,
+            k,
+        } => {
+            if nrhs == 1 {
+                let v = calls[0];
+                unsafe { T::tbsv(order, uplo, trans, diag, n, k, a, lda, v.y.cast(), v.incy) };
+                return;
+            }
+            // Column-major frame: a row-major band is that of the transpose.
+            let (upper, transposed, conj) = match (order, trans) {
+                (CblasColMajor, CblasNoTrans) => (uplo == CblasUpper, false, false),
+                (CblasColMajor, CblasTrans) => (uplo == CblasUpper, true, false),
+                (CblasColMajor, CblasConjTrans) => (uplo == CblasUpper, true, true),
+                (CblasColMajor, CblasConjNoTrans) => (uplo == CblasUpper, false, true),
+                (CblasRowMajor, CblasNoTrans) => (uplo == CblasLower, true, false),
+                (CblasRowMajor, CblasTrans) => (uplo == CblasLower, false, false),
+                (CblasRowMajor, CblasConjTrans) => (uplo == CblasLower, false, true),
+                (CblasRowMajor, CblasConjNoTrans) => (uplo == CblasLower, true, true),
+            };
+            let len = n as usize;
+            let mut block = scratch::take::<T>(len * nrhs);
+            unsafe {
+                gather(CblasRowMajor, len, calls, true, &mut block);
+                tbsm(
+                    upper,
+                    transposed,
+                    conj,
+                    diag == CblasUnit,
+                    len,
+                    k as usize,
+                    a,
+                    lda as usize,
+                    block.as_mut_ptr(),
+                    nrhs,
+                );
+                scatter(CblasRowMajor, len, calls, &block);
+            }
+        }
+    }
+}
+
+/// Defer a `?gemv` call; returns whether it was deferred, in which case the
+/// caller returns at once.
+#[allow(clippy::too_many_arguments)]
+pub(crate) unsafe fn gemv<T: Coalesce>(
+    order: CBLAS_ORDER,
+    trans: CBLAS_TRANSPOSE,
+    m: i64,
+    n: i64,
+    alpha: T,
+    a: *const T,
+    lda: i64,
+    x: *const T,
+    incx: i64,
+    beta: T,
+    y: *mut T,
+    incy: i64,
+) -> bool {
+    if !active() {
+        return false;
+    }
+    let entry = || {
+        let trans = plain::<T>(trans)?;
+        let (lines, len) = match order {
+            CblasColMajor => (n, m),
+            CblasRowMajor => (m, n),
+        };
+        // An empty gemv leaves y alone, which the k = 0 GEMM of a group
+        // would not, so it goes straight to the provider.
+        if m <= 0 || n <= 0 || lda < len.max(1) || incx == 0 || incy == 0 {
+            return None;
+        }
+        let (lenx, leny) = if trans == CblasNoTrans {
+            (n, m)
+        } else {
+            (m, n)
+        };
+        let y_read = if beta.is_zero() {
+            Span::EMPTY
+        } else {
+            Span::vector(y, leny, incy)
+        };
+        Some(Entry {
+            key: Key {
+                elem: T::ELEM,
+                order,
+                op: Op::Gemv {
+                    trans,
+                    m,
+                    n,
+                    alpha: alpha.widen(),
+                    beta: beta.widen(),
+                },
+                a: a.cast(),
+                lda,
+            },
+            vectors: Vectors {
+                x: x.cast(),
+                incx,
+                y: y.cast(),
+                incy,
+            },
+            reads: [
+                Span::lines(a, lines, len, lda),
+                Span::vector(x, lenx, incx),
+                y_read,
+            ],
+            write: Span::vector(y, leny, incy),
+        })
+    };
+    unsafe { defer(entry()) }
+}
+
+/// Defer a `?trsv` call; returns whether it was deferred.
+#[allow(clippy::too_many_arguments)]
+pub(crate) unsafe fn trsv<T: Coalesce>(
+    order: CBLAS_ORDER,
+    uplo: CBLAS_UPLO,
+    trans: CBLAS_TRANSPOSE,
+    diag: CBLAS_DIAG,
+    n: i64,
+    a: *const T,
+    lda: i64,
+    x: *mut T,
+    incx: i64,
+) -> bool {
+    if !active() {
+        return false;
+    }
+    let entry = || {
+        let trans = plain::<T>(trans)?;
+        if n < 0 || lda < n.max(1) || incx == 0 {
+            return None;
+        }
+        let op = Op::Trsv {
+            uplo,
+            trans,
+            diag,
+            n,
+        };
+        Some(solve_entry(
+            order,
+            op,
+            Span::lines(a, n, n, lda),
+            a,
+            lda,
+            x,
+            n,
+            incx,
+        ))
+    };
+    unsafe { defer(entry()) }
+}
+
+/// Defer a `?tbsv` call; returns whether it was deferred.
+#[allow(clippy::too_many_arguments)]
+pub(crate) unsafe fn tbsv<T: Coalesce>(
+    order: CBLAS_ORDER,
+    uplo: CBLAS_UPLO,
+    trans: CBLAS_TRANSPOSE,
+    diag: CBLAS_DIAG,
+    n: i64,
+    k: i64,
+    a: *const T,
+    lda: i64,
+    x: *mut T,
+    incx: i64,
+) -> bool {
+    if !active() {
+        return false;
+    }
+    let entry = || {
+        if n < 0 || k < 0 || lda < k + 1 || incx == 0 {
+            return None;
+        }
+        // The native band solve takes every transpose.
+        let trans = plain::<T>(trans).unwrap_or(trans);
+        let op = Op::Tbsv {
+            uplo,
+            trans,
+            diag,
+            n,
+            k,
+        };
+        Some(solve_entry(
+            order,
+            op,
+            Span::lines(a, n, k + 1, lda),
+            a,
+            lda,
+            x,
+            n,
+            incx,
+        ))
+    };
+    unsafe { defer(entry()) }
+}
+
+#[allow(clippy::too_many_arguments)]
+fn solve_entry<T: Coalesce>(
+    order: CBLAS_ORDER,
+    op: Op,
+    a_span: Span,
+    a: *const T,
+    lda: i64,
+    x: *mut T,
+    n: i64,
+    incx: i64,
+) -> Entry {
+    let x_span = Span::vector(x, n, incx);
+    Entry {
+        key: Key {
+            elem: T::ELEM,
+            order,
+            op,
+            a: a.cast(),
+            lda,
+        },
+        vectors: Vectors {
+            x: x.cast_const().cast(),
+            incx,
+            y: x.cast(),
+            incy: incx,
+        },
+        reads: [a_span, x_span, Span::EMPTY],
+        write: x_span,
+    }
+}
@@ -0,0 +1,521 @@
+//! Rewriting of degenerate Level 2/3 shapes onto cheaper routines.
+//!
+//! Generic tensor code issues GEMMs with `n == 1` or `m == 1` (a GEMV),
+//! `m == n == 1` (a dot product), or `k == 0` or `alpha == 0` (a scaling of
+//! C), and GEMVs, GERs and SYRKs whose matrix is one row or one column wide.
+//! Providers run such shapes through their general kernels and pay for
+//! packing and thread start-up. With `cblas_inject_set_shape_rewrite(1)` the
+//! wrappers catch them in front of the provider call:
+//!
+//! - empty outputs return at once, and `k == 0` or `alpha == 0` scales the
+//!   output by `beta` natively;
+//! - one-row or one-column GEMMs go to the registered `?gemv` (if any);
+//! - real 1 x 1 GEMM and SYRK outputs and real one-row GEMVs become native
+//!   dot products;
+//! - one-column GEMVs and real one-row or one-column GERs become native
+//!   `axpby` / `axpy` updates.
+//!
+//! Reference BLAS semantics are kept: `beta == 0` overwrites the output
+//! without reading it, so NaN or Inf there does not propagate, and
+//! `alpha == 0` reads neither A nor B. Calls with invalid arguments are left
+//! to the provider, which reports them, and so are shapes that would need a
+//! conjugated vector.
+
+use std::ffi::c_char;
+use std::sync::atomic::{AtomicBool, Ordering};
+
+use num_complex::{Complex32, Complex64};
+
+use crate::backend::{
+    route_cgemv_for_ilp64_cblas, route_cgemv_for_lp64_cblas, route_dgemv_for_ilp64_cblas,
+    route_dgemv_for_lp64_cblas, route_sgemv_for_ilp64_cblas, route_sgemv_for_lp64_cblas,
+    route_zgemv_for_ilp64_cblas, route_zgemv_for_lp64_cblas, try_get_cgemv_for_ilp64_cblas,
+    try_get_cgemv_for_lp64_cblas, try_get_dgemv_for_ilp64_cblas, try_get_dgemv_for_lp64_cblas,
+    try_get_sgemv_for_ilp64_cblas, try_get_sgemv_for_lp64_cblas, try_get_zgemv_for_ilp64_cblas,
+    try_get_zgemv_for_lp64_cblas, CgemvProvider, DgemvProvider, SgemvProvider, ZgemvProvider,
+    CBLAS_INJECT_STATUS_OK,
+};
+use crate::native::blas1::{self, Real};
+use crate::native::Scalar;
+use crate::trace::Path;
+use crate::types::{
+    CblasColMajor, CblasConjNoTrans, CblasConjTrans, CblasLower, CblasNoTrans, CblasRowMajor,
+    CblasTrans, CblasUpper, CBLAS_ORDER, CBLAS_TRANSPOSE, CBLAS_UPLO,
+};
+
+static SHAPE_REWRITE: AtomicBool = AtomicBool::new(false);
+
+/// Turn the rewriting of degenerate shapes on (nonzero) or off (0, the
+/// default).
+#[no_mangle]
+pub extern "C" fn cblas_inject_set_shape_rewrite(on: i32) -> i32 {
+    SHAPE_REWRITE.store(on != 0, Ordering::Relaxed);
+    CBLAS_INJECT_STATUS_OK
+}
+
+/// Whether degenerate shapes are rewritten.
+#[no_mangle]
+pub extern "C" fn cblas_inject_shape_rewrite() -> i32 {
+    i32::from(SHAPE_REWRITE.load(Ordering::Relaxed))
+}
+
+#[inline(always)]
+fn enabled() -> bool {
+    SHAPE_REWRITE.load(Ordering::Relaxed)
+}
+
+/// Element type of a rewritten call.
+pub(crate) trait Rewrite: Scalar + PartialEq {
+    const ONE: Self;
+
+    /// Native dot product; `None` for complex elements, which are left to
+    /// the provider.
+    unsafe fn dot(n: i64, x: *const Self, incx: i64, y: *const Self, incy: i64) -> Option<Self>;
+
+    /// Column-major call to the registered `?gemv`, for an LP64 (or, with
+    /// `ilp64`, a `_64`) entry point. `None` when no gemv is registered or
+    /// the arguments do not fit an LP64 provider.
+    #[allow(clippy::too_many_arguments)]
+    unsafe fn gemv(
+        ilp64: bool,
+        trans: c_char,
+        m: i64,
+        n: i64,
+        alpha: Self,
+        a: *const Self,
+        lda: i64,
+        x: *const Self,
+        incx: i64,
+        beta: Self,
+        y: *mut Self,
+        incy: i64,
+    ) -> Option<Path>;
+}
+
+macro_rules! impl_rewrite {
+    (
+        $t:ty,
+        $one:expr,
+        $provider:ident,
+        $try_lp64:ident,
+        $try_ilp64:ident,
+        $route_lp64:ident,
+        $route_ilp64:ident,
+        $dot:expr
+    ) => {
+        impl Rewrite for $t {
+            const ONE: Self = $one;
+
+            #[inline]
+            unsafe fn dot(
+                n: i64,
+                x: *const Self,
+                incx: i64,
+                y: *const Self,
+                incy: i64,
+            ) -> Option<Self> {
+                let dot: unsafe fn(i64, *const Self, i64, *const Self, i64) -> Option<Self> = $dot;
+                unsafe { dot(n, x, incx, y, incy) }
+            }
+
+            unsafe fn gemv(
+                ilp64: bool,
+                trans: c_char,
+                m: i64,
+                n: i64,
+                alpha: Self,
+                a: *const Self,
+                lda: i64,
+                x: *const Self,
+                incx: i64,
+                beta: Self,
+                y: *mut Self,
+                incy: i64,
+            ) -> Option<Path> {
+                // Only rewrite onto a registered gemv; the size routes then
+                // pick among the gemv providers as usual.
+                let p = if ilp64 {
+                    $try_ilp64()?;
+                    $route_ilp64(m, n)
+                } else {
+                    $try_lp64()?;
+                    $route_lp64(m, n)
+                };
+                match p {
+                    $provider::Lp64(f) => {
+                        let narrow = |v: i64| i32::try_from(v).ok();
+                        let (m, n, lda) = (narrow(m)?, narrow(n)?, narrow(lda)?);
+                        let (incx, incy) = (narrow(incx)?, narrow(incy)?);
+                        unsafe { f(&trans, &m, &n, &alpha, a, &lda, x, &incx, &beta, y, &incy) };
+                        Some(if ilp64 { Path::Narrowed } else { Path::Lp64 })
+                    }
+                    $provider::Ilp64(f) => {
+                        unsafe { f(&trans, &m, &n, &alpha, a, &lda, x, &incx, &beta, y, &incy) };
+                        Some(if ilp64 { Path::Ilp64 } else { Path::Widened })
+                    }
+                }
+            }
+        }
+    };
+}
+
+unsafe fn real_dot<T: Real>(n: i64, x: *const T, incx: i64, y: *const T, incy: i64) -> Option<T> {
+    Some(unsafe { blas1::dot(n, x, incx, y, incy) })
+}
+
+unsafe fn no_dot<T>(_: i64, _: *const T, _: i64, _: *const T, _: i64) -> Option<T> {
+    None
+}
+
+impl_rewrite!(
+    f32,
+    1.0,
+    SgemvProvider,
+    try_get_sgemv_for_lp64_cblas,
+    try_get_sgemv_for_ilp64_cblas,
+    route_sgemv_for_lp64_cblas,
+    route_sgemv_for_ilp64_cblas,
+    real_dot::<f32>
+);
+impl_rewrite!(
+    f64,
+    1.0,
+    DgemvProvider,
+    try_get_dgemv_for_lp64_cblas,
+    try_get_dgemv_for_ilp64_cblas,
+    route_dgemv_for_lp64_cblas,
+    route_dgemv_for_ilp64_cblas,
+    real_dot::<f64>
+);
+impl_rewrite!(
+    Complex32,
+    Complex32::new(1.0, 0.0),
+    CgemvProvider,
+    try_get_cgemv_for_lp64_cblas,
+    try_get_cgemv_for_ilp64_cblas,
+    route_cgemv_for_lp64_cblas,
+    route_cgemv_for_ilp64_cblas,
+    no_dot::<Complex32>
+);
+impl_rewrite!(
+    Complex64,
+    Complex64::new(1.0, 0.0),
+    ZgemvProvider,
+    try_get_zgemv_for_lp64_cblas,
+    try_get_zgemv_for_ilp64_cblas,
+    route_zgemv_for_lp64_cblas,
+    route_zgemv_for_ilp64_cblas,
+    no_dot::<Complex64>
+);
+
+/// Operand transform in column-major terms.
+#[derive(Clone, Copy, PartialEq, Eq)]
+enum Op {
+    NoTrans,
+    Trans,
+    ConjTrans,
+}
+
+impl Op {
+    /// `CblasConjNoTrans` is left to the provider, as in the native small
+    /// GEMM.
+    fn of<T: Scalar>(trans: CBLAS_TRANSPOSE) -> Option<Op> {
+        match trans {
+            CblasNoTrans => Some(Op::NoTrans),
+            CblasTrans => Some(Op::Trans),
+            CblasConjTrans if T::IS_COMPLEX => Some(Op::ConjTrans),
+            CblasConjTrans => Some(Op::Trans),
+            CblasConjNoTrans => None,
+        }
+    }
+
+    /// The transform of the transposed operand in a row-major swap; `None`
+    /// for a conjugate transpose, whose flip is not a CBLAS transpose.
+    fn flip(self) -> Option<Op> {
+        match self {
+            Op::NoTrans => Some(Op::Trans),
+            Op::Trans => Some(Op::NoTrans),
+            Op::ConjTrans => None,
+        }
+    }
+
+    fn to_char(self) -> c_char {
+        match self {
+            Op::NoTrans => b'N' as c_char,
+            Op::Trans => b'T' as c_char,
+            Op::ConjTrans => b'C' as c_char,
+        }
+    }
+
+    /// Element steps along a row and along a column of `op(A)` for a
+    /// column-major A with leading dimension `ld`.
+    fn steps(self, ld: i64) -> (i64, i64) {
+        match self {
+            Op::NoTrans => (ld, 1),
+            Op::Trans | Op::ConjTrans => (1, ld),
+        }
+    }
+}
+
+/// `y = beta * y` for `len` elements `inc` apart; zero beta overwrites.
+unsafe fn scale<T: Rewrite>(len: i64, beta: T, y: *mut T, inc: i64) {
+    if beta == T::ONE {
+        return;
+    }
+    // Every element is scaled, so the traversal direction does not matter.
+    let step = inc.unsigned_abs() as usize;
+    for i in 0..len as usize {
+        let yi = unsafe { &mut *y.add(i * step) };
+        *yi = if beta.is_zero() { T::ZERO } else { beta * *yi };
+    }
+}
+
+/// `c = alpha * dot + beta * c` for one element; zero beta overwrites.
+unsafe fn update<T: Rewrite>(c: *mut T, alpha: T, dot: T, beta: T) {
+    unsafe {
+        *c = if beta.is_zero() {
+            alpha * dot
+        } else {
+            alpha * dot + beta * *c
+        };
+    }
+}
+
+/// Rewrite a GEMM call; returns the path it took, or `None` to leave it to
+/// the provider.
+#[allow(clippy::too_many_arguments)]
+pub(crate) unsafe fn gemm<T: Rewrite>(
+    ilp64: bool,
+    order: CBLAS_ORDER,
+    transa: CBLAS_TRANSPOSE,
+    transb: CBLAS_TRANSPOSE,
+    m: i64,
+    n: i64,
+    k: i64,
+    alpha: T,
+    a: *const T,
+    lda: i64,
+    b: *const T,
+    ldb: i64,
+    beta: T,
+    c: *mut T,
+    ldc: i64,
+) -> Option<Path> {
+    if !enabled() {
+        return None;
+    }
+    let (opa, opb) = (Op::of::<T>(transa)?, Op::of::<T>(transb)?);
+    // Column-major view: a row-major call swaps A and B, and m and n.
+    let (opa, opb, m, n, a, lda, b, ldb) = match order {
+        CblasColMajor => (opa, opb, m, n, a, lda, b, ldb),
+        CblasRowMajor => (opb, opa, n, m, b, ldb, a, lda),
+    };
+    let (rows_a, cols_a) = if opa == Op::NoTrans { (m, k) } else { (k, m) };
+    let (rows_b, cols_b) = if opb == Op::NoTrans { (k, n) } else { (n, k) };
+    if m < 0 || n < 0 || k < 0 || lda < rows_a.max(1) || ldb < rows_b.max(1) || ldc < m.max(1) {
+        return None;
+    }
+    if m == 0 || n == 0 {
+        return Some(Path::Native);
+    }
+    if k == 0 || alpha.is_zero() {
+        for j in 0..n {
+            unsafe { scale(m, beta, c.add((j * ldc) as usize), 1) };
+        }
+        return Some(Path::Native);
+    }
+    let (a_row, _) = opa.steps(lda);
+    let (_, b_col) = opb.steps(ldb);
+    if m == 1 && n == 1 {
+        if let Some(dot) = unsafe { T::dot(k, a, a_row, b, b_col) } {
+            unsafe { update(c, alpha, dot, beta) };
+            return Some(Path::Native);
+        }
+    }
+    if n == 1 && opb != Op::ConjTrans {
+        // C(:, 0) = alpha * op(A) * op(B)(:, 0) + beta * C(:, 0)
+        return unsafe {
+            T::gemv(
+                ilp64,
+                opa.to_char(),
+                rows_a,
+                cols_a,
+                alpha,
+                a,
+                lda,
+                b,
+                b_col,
+                beta,
+                c,
+                1,
+            )
+        };
+    }
+    if m == 1 && opa != Op::ConjTrans {
+        // C(0, :)^T = alpha * op(B)^T * op(A)(0, :)^T + beta * C(0, :)^T
+        return unsafe {
+            T::gemv(
+                ilp64,
+                opb.flip()?.to_char(),
+                rows_b,
+                cols_b,
+                alpha,
+                b,
+                ldb,
+                a,
+                a_row,
+                beta,
+                c,
+                ldc,
+            )
+        };
+    }
+    None
+}
+
+/// Rewrite a GEMV call; returns `true` if it was handled.
+#[allow(clippy::too_many_arguments)]
+pub(crate) unsafe fn gemv<T: Rewrite>(
+    order: CBLAS_ORDER,
+    trans: CBLAS_TRANSPOSE,
+    m: i64,
+    n: i64,
+    alpha: T,
+    a: *const T,
+    lda: i64,
+    x: *const T,
+    incx: i64,
+    beta: T,
+    y: *mut T,
+    incy: i64,
+) -> bool {
+    if !enabled() {
+        return false;
+    }
+    let Some(op) = Op::of::<T>(trans) else {
+        return false;
+    };
+    // Column-major view: a row-major A is its transpose in column-major.
+    let (op, m, n) = match order {
+        CblasColMajor => (op, m, n),
+        CblasRowMajor => match op.flip() {
+            Some(op) => (op, n, m),
+            None => return false,
+        },
+    };
+    if m < 0 || n < 0 || lda < m.max(1) || incx == 0 || incy == 0 {
+        return false;
+    }
+    if m == 0 || n == 0 {
+        return true;
+    }
+    let (len_y, len_x) = if op == Op::NoTrans { (m, n) } else { (n, m) };
+    if alpha.is_zero() {
+        unsafe { scale(len_y, beta, y, incy) };
+        return true;
+    }
+    let (row, col) = op.steps(lda);
+    if len_x == 1 && op != Op::ConjTrans {
+        // y = alpha * x[0] * op(A)(:, 0) + beta * y
+        unsafe { blas1::axpby(len_y, alpha * *x, a, col, beta, y, incy) };
+        return true;
+    }
+    if len_y == 1 {
+        if let Some(dot) = unsafe { T::dot(len_x, a, row, x, incx) } {
+            unsafe { update(y, alpha, dot, beta) };
+            return true;
+        }
+    }
+    false
+}
+
+/// Rewrite a real GER call; returns `true` if it was handled.
+#[allow(clippy::too_many_arguments)]
+pub(crate) unsafe fn ger<T: Real>(
+    order: CBLAS_ORDER,
+    m: i64,
+    n: i64,
+    alpha: T,
+    x: *const T,
+    incx: i64,
+    y: *const T,
+    incy: i64,
+    a: *mut T,
+    lda: i64,
+) -> bool {
+    if !enabled() {
+        return false;
+    }
+    // Column-major view: a row-major A^T gets y * x^T.
+    let (m, n, x, incx, y, incy) = match order {
+        CblasColMajor => (m, n, x, incx, y, incy),
+        CblasRowMajor => (n, m, y, incy, x, incx),
+    };
+    if m < 0 || n < 0 || incx == 0 || incy == 0 || lda < m.max(1) {
+        return false;
+    }
+    if m == 0 || n == 0 || alpha.is_zero() {
+        return true;
+    }
+    if n == 1 {
+        unsafe { blas1::axpy(m, alpha * *y, x, incx, a, 1) };
+        return true;
+    }
+    if m == 1 {
+        unsafe { blas1::axpy(n, alpha * *x, y, incy, a, lda) };
+        return true;
+    }
+    false
+}
+
+/// Rewrite a SYRK call; returns `true` if it was handled.
+#[allow(clippy::too_many_arguments)]
+pub(crate) unsafe fn syrk<T: Rewrite>(
+    order: CBLAS_ORDER,
+    uplo: CBLAS_UPLO,
+    trans: CBLAS_TRANSPOSE,
+    n: i64,
+    k: i64,
+    alpha: T,
+    a: *const T,
+    lda: i64,
+    beta: T,
+    c: *mut T,
+    ldc: i64,
+) -> bool {
+    if !enabled() {
+        return false;
+    }
+    // Complex SYRK has no conjugate transpose; leave it to the provider.
+    let op = match Op::of::<T>(trans) {
+        Some(Op::ConjTrans) | None => return false,
+        Some(op) => op,
+    };
+    // Column-major view: the row-major upper triangle is the lower one.
+    let (upper, op) = match order {
+        CblasColMajor => (uplo == CblasUpper, op),
+        CblasRowMajor => (uplo == CblasLower, op.flip().unwrap_or(op)),
+    };
+    let rows_a = if op == Op::NoTrans { n } else { k };
+    if n < 0 || k < 0 || lda < rows_a.max(1) || ldc < n.max(1) {
+        return false;
+    }
+    if n == 0 {
+        return true;
+    }
+    if k == 0 || alpha.is_zero() {
+        for j in 0..n {
+            let (first, len) = if upper { (0, j + 1) } else { (j, n - j) };
+            unsafe { scale(len, beta, c.add((first + j * ldc) as usize), 1) };
+        }
+        return true;
+    }
+    if n == 1 {
+        let (row, _) = op.steps(lda);
+        if let Some(dot) = unsafe { T::dot(k, a, row, a, row) } {
+            unsafe { update(c, alpha, dot, beta) };
+            return true;
+        }
+    }
+    false
+}
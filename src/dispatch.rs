@@ -0,0 +1,523 @@
+//! Frozen dispatch table.
+//!
+//! Until [`cblas_inject_finalize`] is called, every CBLAS wrapper resolves its
+//! provider on each call: it probes the LP64 and ILP64 `OnceLock` slots in
+//! priority order and, for the complex dot products, also reads the configured
+//! `ComplexReturnStyle` and transmutes the raw pointer.
+//!
+//! `cblas_inject_finalize` performs that resolution once for every routine and
+//! both CBLAS integer ABIs, and publishes the result as a single immutable,
+//! leaked [`DispatchTable`]. Afterwards a wrapper does one atomic load of the
+//! table pointer and one indirect call through an already-resolved,
+//! correctly-typed function pointer.
+//!
+//! Slots that were not registered at finalize time are stored as `None`; the
+//! getters fall back to the regular `OnceLock` lookup for them, so a late
+//! registration of a previously missing routine still takes effect. Slots that
+//! were resolved are never re-resolved.
+//!
+//! A thread can also push a provider scope: a [`DispatchTable`] built from a
+//! [`CblasInjectProviderTable`] that the getters consult before the frozen
+//! table and the `OnceLock` slots, for calls on that thread only. A global
+//! count of active scopes keeps the check to one relaxed load and branch
+//! while no thread has a scope, so the thread-local is only read once some
+//! thread pushed one.
+//!
+//! Every `cblas_*` wrapper starts with [`enter`], the one place where a call
+//! is counted for [`crate::stats`], starts its [`crate::trace`] record and
+//! enters the nested-parallelism guard of [`crate::threads`].
+
+use std::cell::{Cell, RefCell};
+use std::ffi::c_void;
+use std::sync::atomic::{AtomicPtr, AtomicUsize, Ordering};
+
+use crate::backend::*;
+use crate::provider::{
+    CblasInjectProviderTable, CBLAS_INJECT_ABI_ILP64, CBLAS_INJECT_ABI_LP64,
+    CBLAS_INJECT_PROVIDER_TABLE_NATIVE, CBLAS_INJECT_PROVIDER_TABLE_VERSION,
+};
+use crate::stats::{self, Routine, Timer};
+use crate::threads::{self, SingleThreaded};
+use crate::trace::{self, Pending};
+use crate::types::CBLAS_ORDER;
+
+/// Resolved provider for one routine, for both CBLAS integer ABIs.
+#[derive(Clone, Copy)]
+pub(crate) struct Resolved<P> {
+    /// Provider used by the unprefixed (LP64) `cblas_*` symbol.
+    pub(crate) lp64_cblas: Option<P>,
+    /// Provider used by the `cblas_*_64` (ILP64) symbol.
+    pub(crate) ilp64_cblas: Option<P>,
+}
+
+macro_rules! define_dispatch_table {
+    ($($name:ident => $provider:ident,)*) => {
+        paste::paste! {
+            /// Immutable snapshot of every registered provider.
+            pub(crate) struct DispatchTable {
+                $(pub(crate) [<$name:lower>]: Resolved<$provider>,)*
+                pub(crate) sgemm: Resolved<SgemmProvider>,
+                pub(crate) dgemm: Resolved<DgemmProvider>,
+                pub(crate) cgemm: Resolved<CgemmProvider>,
+                pub(crate) zgemm: Resolved<ZgemmProvider>,
+                pub(crate) cdotu: Resolved<CdotuDispatch>,
+                pub(crate) zdotu: Resolved<ZdotuDispatch>,
+                pub(crate) cdotc: Resolved<CdotcDispatch>,
+                pub(crate) zdotc: Resolved<ZdotcDispatch>,
+            }
+
+            /// Resolve `table` into a scope's dispatch table, taking its null
+            /// slots from the enclosing scope `outer`.
+            unsafe fn build_scope_table(
+                table: &CblasInjectProviderTable,
+                outer: Option<&DispatchTable>,
+            ) -> DispatchTable {
+                let ilp64 = table.abi == CBLAS_INJECT_ABI_ILP64;
+                unsafe {
+                    DispatchTable {
+                        $([<$name:lower>]: scope_slot(
+                            table.[<$name:lower>],
+                            ilp64,
+                            outer.map(|o| o.[<$name:lower>]),
+                        ),)*
+                        sgemm: scope_slot(table.sgemm, ilp64, outer.map(|o| o.sgemm)),
+                        dgemm: scope_slot(table.dgemm, ilp64, outer.map(|o| o.dgemm)),
+                        cgemm: scope_slot(table.cgemm, ilp64, outer.map(|o| o.cgemm)),
+                        zgemm: scope_slot(table.zgemm, ilp64, outer.map(|o| o.zgemm)),
+                        cdotu: scope_slot(table.cdotu, ilp64, outer.map(|o| o.cdotu)),
+                        zdotu: scope_slot(table.zdotu, ilp64, outer.map(|o| o.zdotu)),
+                        cdotc: scope_slot(table.cdotc, ilp64, outer.map(|o| o.cdotc)),
+                        zdotc: scope_slot(table.zdotc, ilp64, outer.map(|o| o.zdotc)),
+                    }
+                }
+            }
+
+            fn build_dispatch_table() -> DispatchTable {
+                DispatchTable {
+                    $([<$name:lower>]: Resolved {
+                        lp64_cblas: [<resolve_ $name:lower _for_lp64_cblas>](),
+                        ilp64_cblas: [<resolve_ $name:lower _for_ilp64_cblas>](),
+                    },)*
+                    sgemm: Resolved {
+                        lp64_cblas: resolve_sgemm_for_current_cblas(),
+                        ilp64_cblas: resolve_sgemm_for_ilp64_cblas(),
+                    },
+                    dgemm: Resolved {
+                        lp64_cblas: resolve_dgemm_for_current_cblas(),
+                        ilp64_cblas: resolve_dgemm_for_ilp64_cblas(),
+                    },
+                    cgemm: Resolved {
+                        lp64_cblas: resolve_cgemm_for_current_cblas(),
+                        ilp64_cblas: resolve_cgemm_for_ilp64_cblas(),
+                    },
+                    zgemm: Resolved {
+                        lp64_cblas: resolve_zgemm_for_current_cblas(),
+                        ilp64_cblas: resolve_zgemm_for_ilp64_cblas(),
+                    },
+                    cdotu: Resolved {
+                        lp64_cblas: resolve_cdotu_dispatch_for_lp64_cblas(),
+                        ilp64_cblas: resolve_cdotu_dispatch_for_ilp64_cblas(),
+                    },
+                    zdotu: Resolved {
+                        lp64_cblas: resolve_zdotu_dispatch_for_lp64_cblas(),
+                        ilp64_cblas: resolve_zdotu_dispatch_for_ilp64_cblas(),
+                    },
+                    cdotc: Resolved {
+                        lp64_cblas: resolve_cdotc_dispatch_for_lp64_cblas(),
+                        ilp64_cblas: resolve_cdotc_dispatch_for_ilp64_cblas(),
+                    },
+                    zdotc: Resolved {
+                        lp64_cblas: resolve_zdotc_dispatch_for_lp64_cblas(),
+                        ilp64_cblas: resolve_zdotc_dispatch_for_ilp64_cblas(),
+                    },
+                }
+            }
+        }
+    };
+}
+
+define_dispatch_table! {
+    Sswap => SswapProvider,
+    Dswap => DswapProvider,
+    Cswap => CswapProvider,
+    Zswap => ZswapProvider,
+    Scopy => ScopyProvider,
+    Dcopy => DcopyProvider,
+    Ccopy => CcopyProvider,
+    Zcopy => ZcopyProvider,
+    Saxpy => SaxpyProvider,
+    Daxpy => DaxpyProvider,
+    Caxpy => CaxpyProvider,
+    Zaxpy => ZaxpyProvider,
+    Sscal => SscalProvider,
+    Dscal => DscalProvider,
+    Cscal => CscalProvider,
+    Zscal => ZscalProvider,
+    Csscal => CsscalProvider,
+    Zdscal => ZdscalProvider,
+    Srot => SrotProvider,
+    Drot => DrotProvider,
+    Srotg => SrotgProvider,
+    Drotg => DrotgProvider,
+    Srotm => SrotmProvider,
+    Drotm => DrotmProvider,
+    Srotmg => SrotmgProvider,
+    Drotmg => DrotmgProvider,
+    Scabs1 => Scabs1Provider,
+    Dcabs1 => Dcabs1Provider,
+    Sdot => SdotProvider,
+    Ddot => DdotProvider,
+    Sdsdot => SdsdotProvider,
+    Dsdot => DsdotProvider,
+    Snrm2 => Snrm2Provider,
+    Dnrm2 => Dnrm2Provider,
+    Scnrm2 => Scnrm2Provider,
+    Dznrm2 => Dznrm2Provider,
+    Sasum => SasumProvider,
+    Dasum => DasumProvider,
+    Scasum => ScasumProvider,
+    Dzasum => DzasumProvider,
+    Isamax => IsamaxProvider,
+    Idamax => IdamaxProvider,
+    Icamax => IcamaxProvider,
+    Izamax => IzamaxProvider,
+    Sgemv => SgemvProvider,
+    Dgemv => DgemvProvider,
+    Cgemv => CgemvProvider,
+    Zgemv => ZgemvProvider,
+    Sgbmv => SgbmvProvider,
+    Dgbmv => DgbmvProvider,
+    Cgbmv => CgbmvProvider,
+    Zgbmv => ZgbmvProvider,
+    Ssymv => SsymvProvider,
+    Dsymv => DsymvProvider,
+    Chemv => ChemvProvider,
+    Zhemv => ZhemvProvider,
+    Ssbmv => SsbmvProvider,
+    Dsbmv => DsbmvProvider,
+    Chbmv => ChbmvProvider,
+    Zhbmv => ZhbmvProvider,
+    Strmv => StrmvProvider,
+    Dtrmv => DtrmvProvider,
+    Ctrmv => CtrmvProvider,
+    Ztrmv => ZtrmvProvider,
+    Strsv => StrsvProvider,
+    Dtrsv => DtrsvProvider,
+    Ctrsv => CtrsvProvider,
+    Ztrsv => ZtrsvProvider,
+    Stbmv => StbmvProvider,
+    Dtbmv => DtbmvProvider,
+    Ctbmv => CtbmvProvider,
+    Ztbmv => ZtbmvProvider,
+    Stbsv => StbsvProvider,
+    Dtbsv => DtbsvProvider,
+    Ctbsv => CtbsvProvider,
+    Ztbsv => ZtbsvProvider,
+    Sger => SgerProvider,
+    Dger => DgerProvider,
+    Cgeru => CgeruProvider,
+    Cgerc => CgercProvider,
+    Zgeru => ZgeruProvider,
+    Zgerc => ZgercProvider,
+    Ssyr => SsyrProvider,
+    Dsyr => DsyrProvider,
+    Cher => CherProvider,
+    Zher => ZherProvider,
+    Ssyr2 => Ssyr2Provider,
+    Dsyr2 => Dsyr2Provider,
+    Cher2 => Cher2Provider,
+    Zher2 => Zher2Provider,
+    Sspmv => SspmvProvider,
+    Dspmv => DspmvProvider,
+    Chpmv => ChpmvProvider,
+    Zhpmv => ZhpmvProvider,
+    Stpmv => StpmvProvider,
+    Dtpmv => DtpmvProvider,
+    Ctpmv => CtpmvProvider,
+    Ztpmv => ZtpmvProvider,
+    Stpsv => StpsvProvider,
+    Dtpsv => DtpsvProvider,
+    Ctpsv => CtpsvProvider,
+    Ztpsv => ZtpsvProvider,
+    Sspr => SsprProvider,
+    Dspr => DsprProvider,
+    Chpr => ChprProvider,
+    Zhpr => ZhprProvider,
+    Sspr2 => Sspr2Provider,
+    Dspr2 => Dspr2Provider,
+    Chpr2 => Chpr2Provider,
+    Zhpr2 => Zhpr2Provider,
+    Ssymm => SsymmProvider,
+    Dsymm => DsymmProvider,
+    Csymm => CsymmProvider,
+    Zsymm => ZsymmProvider,
+    Chemm => ChemmProvider,
+    Zhemm => ZhemmProvider,
+    Ssyrk => SsyrkProvider,
+    Dsyrk => DsyrkProvider,
+    Csyrk => CsyrkProvider,
+    Zsyrk => ZsyrkProvider,
+    Cherk => CherkProvider,
+    Zherk => ZherkProvider,
+    Ssyr2k => Ssyr2kProvider,
+    Dsyr2k => Dsyr2kProvider,
+    Csyr2k => Csyr2kProvider,
+    Zsyr2k => Zsyr2kProvider,
+    Cher2k => Cher2kProvider,
+    Zher2k => Zher2kProvider,
+    Strmm => StrmmProvider,
+    Dtrmm => DtrmmProvider,
+    Ctrmm => CtrmmProvider,
+    Ztrmm => ZtrmmProvider,
+    Strsm => StrsmProvider,
+    Dtrsm => DtrsmProvider,
+    Ctrsm => CtrsmProvider,
+    Ztrsm => ZtrsmProvider,
+    Cgemm3m => Cgemm3mProvider,
+    Zgemm3m => Zgemm3mProvider,
+    Sgemmt => SgemmtProvider,
+    Dgemmt => DgemmtProvider,
+    Cgemmt => CgemmtProvider,
+    Zgemmt => ZgemmtProvider,
+    Somatcopy => SomatcopyProvider,
+    Domatcopy => DomatcopyProvider,
+    Comatcopy => ComatcopyProvider,
+    Zomatcopy => ZomatcopyProvider,
+    Simatcopy => SimatcopyProvider,
+    Dimatcopy => DimatcopyProvider,
+    Cimatcopy => CimatcopyProvider,
+    Zimatcopy => ZimatcopyProvider,
+    Saxpby => SaxpbyProvider,
+    Daxpby => DaxpbyProvider,
+    Caxpby => CaxpbyProvider,
+    Zaxpby => ZaxpbyProvider,
+}
+
+/// Published table; null until `cblas_inject_finalize` succeeds.
+static FROZEN_DISPATCH: AtomicPtr<DispatchTable> = AtomicPtr::new(std::ptr::null_mut());
+
+/// Return the frozen dispatch table, if `cblas_inject_finalize` has run.
+#[inline(always)]
+pub(crate) fn frozen_dispatch() -> Option<&'static DispatchTable> {
+    let table = FROZEN_DISPATCH.load(Ordering::Acquire);
+    if table.is_null() {
+        None
+    } else {
+        // Safety: the table is leaked on publication and never freed or mutated.
+        Some(unsafe { &*table })
+    }
+}
+
+/// Freeze the current registrations into an immutable dispatch table.
+///
+/// Call this once after all providers (and the complex return style) have
+/// been registered. Every subsequent CBLAS call dispatches through the frozen
+/// table without probing the per-routine `OnceLock` slots.
+///
+/// Returns `CBLAS_INJECT_STATUS_OK` on success and
+/// `CBLAS_INJECT_STATUS_ALREADY_FINALIZED` if the table was already frozen.
+#[no_mangle]
+pub extern "C" fn cblas_inject_finalize() -> i32 {
+    // Outside the lock, so a concurrent environment load can finish first.
+    crate::provider::load_env_provider();
+    // A frozen table would otherwise miss every routine not yet called.
+    #[cfg(feature = "openblas-lazy")]
+    crate::autoregister::register_all_lazy();
+    let _guard = registration_guard();
+    finalize_locked()
+}
+
+/// Publish the dispatch table; the caller holds the registration lock.
+pub(crate) fn finalize_locked() -> i32 {
+    if !FROZEN_DISPATCH.load(Ordering::Acquire).is_null() {
+        return CBLAS_INJECT_STATUS_ALREADY_FINALIZED;
+    }
+    let table = Box::leak(Box::new(build_dispatch_table()));
+    FROZEN_DISPATCH.store(table, Ordering::Release);
+    CBLAS_INJECT_STATUS_OK
+}
+
+/// Return 1 if `cblas_inject_finalize` has frozen the dispatch table, 0 otherwise.
+#[no_mangle]
+pub extern "C" fn cblas_inject_is_finalized() -> i32 {
+    i32::from(frozen_dispatch().is_some())
+}
+
+/// A slot of a scope table: the scope's own provider, else the enclosing one.
+unsafe fn scope_slot<P: FromRaw + Copy>(
+    f: *const c_void,
+    ilp64: bool,
+    outer: Option<Resolved<P>>,
+) -> Resolved<P> {
+    if f.is_null() {
+        return outer.unwrap_or(Resolved {
+            lp64_cblas: None,
+            ilp64_cblas: None,
+        });
+    }
+    let p = Some(unsafe { P::from_raw(ilp64, f) });
+    Resolved {
+        lp64_cblas: p,
+        ilp64_cblas: p,
+    }
+}
+
+/// One pushed provider scope.
+pub(crate) struct Scope {
+    pub(crate) table: DispatchTable,
+    /// Prefer the native kernels at every size they support.
+    pub(crate) native: bool,
+}
+
+/// Provider scopes pushed on any thread and not yet popped.
+static ACTIVE_SCOPES: AtomicUsize = AtomicUsize::new(0);
+
+/// This thread's scopes, innermost last. A thread that exits inside scopes
+/// still takes them out of the global count.
+struct Scopes(Vec<Box<Scope>>);
+
+impl Drop for Scopes {
+    fn drop(&mut self) {
+        ACTIVE_SCOPES.fetch_sub(self.0.len(), Ordering::Relaxed);
+    }
+}
+
+thread_local! {
+    static SCOPES: RefCell<Scopes> = const { RefCell::new(Scopes(Vec::new())) };
+    /// Innermost scope of this thread, or null.
+    static CURRENT_SCOPE: Cell<*const Scope> = const { Cell::new(std::ptr::null()) };
+}
+
+#[inline(never)]
+fn with_current_scope<R>(f: impl FnOnce(&Scope) -> Option<R>) -> Option<R> {
+    let scope = CURRENT_SCOPE.with(Cell::get);
+    if scope.is_null() {
+        return None;
+    }
+    // Safety: the scope is boxed in this thread's SCOPES and only freed by a
+    // pop on this thread, which cannot run during a CBLAS call.
+    f(unsafe { &*scope })
+}
+
+/// Look up a provider in this thread's innermost provider scope.
+#[inline(always)]
+pub(crate) fn scoped<P>(f: impl FnOnce(&DispatchTable) -> Option<P>) -> Option<P> {
+    if ACTIVE_SCOPES.load(Ordering::Relaxed) == 0 {
+        return None;
+    }
+    with_current_scope(|scope| f(&scope.table))
+}
+
+/// Whether this thread's innermost scope prefers the native kernels.
+#[inline(always)]
+pub(crate) fn scope_prefers_native() -> bool {
+    if ACTIVE_SCOPES.load(Ordering::Relaxed) == 0 {
+        return false;
+    }
+    with_current_scope(|scope| scope.native.then_some(())).is_some()
+}
+
+/// Route the calling thread's CBLAS calls through `table` until the matching
+/// `cblas_inject_pop_provider_scope`, without affecting other threads.
+///
+/// `table` is laid out as for `cblas_inject_register_table` (`size` is the
+/// caller's `sizeof`). Null slots keep the provider of the enclosing scope,
+/// or the global one. With `CBLAS_INJECT_PROVIDER_TABLE_NATIVE` in `flags`,
+/// routines that have built-in kernels use them at every size they support.
+/// Scopes nest; the table is resolved on push, so the caller may free it
+/// afterwards.
+///
+/// Returns `CBLAS_INJECT_STATUS_NULL_POINTER` for a null `table` and
+/// `CBLAS_INJECT_STATUS_INVALID_ARGUMENT` for an unknown version, ABI or a
+/// `size` smaller than the header.
+///
+/// # Safety
+///
+/// As for `cblas_inject_register_table`; the slot functions must stay
+/// callable until the scope is popped.
+#[no_mangle]
+pub unsafe extern "C" fn cblas_inject_push_provider_scope(
+    table: *const CblasInjectProviderTable,
+    size: usize,
+) -> i32 {
+    if table.is_null() {
+        return CBLAS_INJECT_STATUS_NULL_POINTER;
+    }
+    let Some(table) = (unsafe { CblasInjectProviderTable::read(table, size) }) else {
+        return CBLAS_INJECT_STATUS_INVALID_ARGUMENT;
+    };
+    if table.version != CBLAS_INJECT_PROVIDER_TABLE_VERSION
+        || !matches!(table.abi, CBLAS_INJECT_ABI_LP64 | CBLAS_INJECT_ABI_ILP64)
+    {
+        return CBLAS_INJECT_STATUS_INVALID_ARGUMENT;
+    }
+    SCOPES.with(|scopes| {
+        let mut scopes = scopes.borrow_mut();
+        let outer = scopes.0.last().map(|scope| &**scope);
+        let scope = Box::new(Scope {
+            table: unsafe { build_scope_table(&table, outer.map(|o| &o.table)) },
+            native: table.flags & CBLAS_INJECT_PROVIDER_TABLE_NATIVE != 0
+                || outer.is_some_and(|o| o.native),
+        });
+        CURRENT_SCOPE.with(|current| current.set(&*scope));
+        scopes.0.push(scope);
+    });
+    ACTIVE_SCOPES.fetch_add(1, Ordering::Relaxed);
+    CBLAS_INJECT_STATUS_OK
+}
+
+/// End the calling thread's innermost provider scope.
+///
+/// Returns `CBLAS_INJECT_STATUS_INVALID_ARGUMENT` if the thread has none.
+#[no_mangle]
+pub extern "C" fn cblas_inject_pop_provider_scope() -> i32 {
+    let popped = SCOPES.with(|scopes| {
+        let mut scopes = scopes.borrow_mut();
+        let popped = scopes.0.pop().is_some();
+        let current = scopes.0.last().map_or(std::ptr::null(), |scope| &**scope);
+        CURRENT_SCOPE.with(|c| c.set(current));
+        popped
+    });
+    if !popped {
+        return CBLAS_INJECT_STATUS_INVALID_ARGUMENT;
+    }
+    ACTIVE_SCOPES.fetch_sub(1, Ordering::Relaxed);
+    CBLAS_INJECT_STATUS_OK
+}
+
+/// Number of provider scopes active on the calling thread.
+#[no_mangle]
+pub extern "C" fn cblas_inject_provider_scope_depth() -> i32 {
+    SCOPES.with(|scopes| i32::try_from(scopes.borrow().0.len()).unwrap_or(i32::MAX))
+}
+
+/// Returned by [`enter`]; on drop it records the call's time and trace
+/// record and ends its single-threaded region, if any.
+pub(crate) struct Call {
+    _timer: Option<Timer>,
+    _trace: Option<Pending>,
+    _threads: Option<SingleThreaded>,
+}
+
+/// Start a call to `routine`; keep the result alive for the whole call.
+///
+/// The arguments are those of [`crate::trace::CblasInjectTraceRecord`], as
+/// the caller passed them: `order` (`None` for Level 1), the enum `flags`,
+/// the `dims`, and the leading dimensions and increments `lds`. With
+/// statistics, tracing and the nested guard off, the defaults, this is three
+/// relaxed atomic loads and predicted branches.
+#[inline(always)]
+pub(crate) fn enter<I: Copy + Into<i64>, const F: usize, const D: usize, const L: usize>(
+    routine: Routine,
+    order: Option<CBLAS_ORDER>,
+    flags: [u8; F],
+    dims: [I; D],
+    lds: [I; L],
+) -> Call {
+    let order = order.map_or(0, |o| o as u8);
+    Call {
+        _timer: stats::count(routine, &flags, &dims),
+        _trace: trace::begin(routine, order, &flags, &dims, &lds),
+        _threads: threads::call(),
+    }
+}
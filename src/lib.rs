@@ -40,19 +40,70 @@ compile_error!(
      disable openblas and register ILP64 providers explicitly"
 );
 
+mod autotune;
 mod backend;
+mod coalesce;
+mod degenerate;
+mod dispatch;
 mod int_convert;
+mod lp64_split;
+mod native;
+mod pool;
+mod provider;
+mod scratch;
+mod stats;
+mod threads;
+mod trace;
 mod types;
 mod xerbla;
 
 #[cfg(feature = "openblas")]
 mod autoregister;
 
+pub mod blas;
 pub mod blas1;
 pub mod blas2;
 pub mod blas3;
 
+pub use autotune::cblas_inject_autotune;
 pub use backend::*;
+pub use coalesce::{cblas_inject_begin_coalesce, cblas_inject_flush_coalesce};
+pub use degenerate::{cblas_inject_set_shape_rewrite, cblas_inject_shape_rewrite};
+pub use dispatch::{
+    cblas_inject_finalize, cblas_inject_is_finalized, cblas_inject_pop_provider_scope,
+    cblas_inject_provider_scope_depth, cblas_inject_push_provider_scope,
+};
+pub use native::blas1::{cblas_inject_native_blas1_max_n, cblas_inject_set_native_blas1_max_n};
+pub use native::gemm::{
+    cblas_inject_set_small_gemm_max_dim, cblas_inject_small_gemm_max_dim,
+    CBLAS_INJECT_SMALL_GEMM_DIM_LIMIT,
+};
+pub use pool::{cblas_inject_set_worker_threads, cblas_inject_worker_threads};
+pub use provider::{
+    cblas_inject_load_provider, cblas_inject_register_table, CblasInjectProviderTable,
+    CBLAS_INJECT_ABI_ILP64, CBLAS_INJECT_ABI_LP64, CBLAS_INJECT_PROVIDER_TABLE_FINALIZE,
+    CBLAS_INJECT_PROVIDER_TABLE_NATIVE, CBLAS_INJECT_PROVIDER_TABLE_SLOTS,
+    CBLAS_INJECT_PROVIDER_TABLE_VERSION,
+};
+pub use stats::{
+    cblas_inject_set_stats_mode, cblas_inject_stats_mode, cblas_inject_stats_reset,
+    cblas_inject_stats_snapshot, CblasInjectRoutineStats, CBLAS_INJECT_STATS_BUCKETS,
+    CBLAS_INJECT_STATS_COUNTS, CBLAS_INJECT_STATS_OFF, CBLAS_INJECT_STATS_TIMING,
+};
+pub use threads::{
+    cblas_inject_begin_single_threaded, cblas_inject_end_single_threaded,
+    cblas_inject_nested_guard, cblas_inject_num_threads, cblas_inject_register_get_num_threads,
+    cblas_inject_register_parallel_probe, cblas_inject_register_set_num_threads,
+    cblas_inject_register_set_num_threads_local, cblas_inject_set_nested_guard,
+    cblas_inject_set_num_threads,
+};
+pub use trace::{
+    cblas_inject_trace_active, cblas_inject_trace_start, cblas_inject_trace_stop,
+    CblasInjectTraceHeader, CblasInjectTraceRecord, CBLAS_INJECT_TRACE_MAGIC,
+    CBLAS_INJECT_TRACE_NAME_LEN, CBLAS_INJECT_TRACE_PATH_DEFERRED, CBLAS_INJECT_TRACE_PATH_ILP64,
+    CBLAS_INJECT_TRACE_PATH_LP64, CBLAS_INJECT_TRACE_PATH_NARROWED, CBLAS_INJECT_TRACE_PATH_NATIVE,
+    CBLAS_INJECT_TRACE_PATH_WIDENED, CBLAS_INJECT_TRACE_VERSION,
+};
 pub use types::*;
 
 // Re-export commonly used functions at crate root
@@ -61,10 +112,18 @@ pub use blas1::dot::{
     cblas_cdotc_sub, cblas_cdotc_sub_64, cblas_cdotu_sub, cblas_cdotu_sub_64, cblas_dasum,
     cblas_dasum_64, cblas_ddot, cblas_ddot_64, cblas_dnrm2, cblas_dnrm2_64, cblas_dsdot,
     cblas_dsdot_64, cblas_dzasum, cblas_dzasum_64, cblas_dznrm2, cblas_dznrm2_64, cblas_icamax,
-    cblas_icamax_64, cblas_idamax, cblas_idamax_64, cblas_isamax, cblas_isamax_64, cblas_izamax,
-    cblas_izamax_64, cblas_sasum, cblas_sasum_64, cblas_scasum, cblas_scasum_64, cblas_scnrm2,
-    cblas_scnrm2_64, cblas_sdot, cblas_sdot_64, cblas_sdsdot, cblas_sdsdot_64, cblas_snrm2,
-    cblas_snrm2_64, cblas_zdotc_sub, cblas_zdotc_sub_64, cblas_zdotu_sub, cblas_zdotu_sub_64,
+    cblas_icamax_64, cblas_idamax, cblas_idamax_64, cblas_inject_daxpy_dot,
+    cblas_inject_daxpy_dot_64, cblas_inject_saxpy_dot, cblas_inject_saxpy_dot_64, cblas_isamax,
+    cblas_isamax_64, cblas_izamax, cblas_izamax_64, cblas_sasum, cblas_sasum_64, cblas_scasum,
+    cblas_scasum_64, cblas_scnrm2, cblas_scnrm2_64, cblas_sdot, cblas_sdot_64, cblas_sdsdot,
+    cblas_sdsdot_64, cblas_snrm2, cblas_snrm2_64, cblas_zdotc_sub, cblas_zdotc_sub_64,
+    cblas_zdotu_sub, cblas_zdotu_sub_64,
+};
+pub use blas1::matcopy::{
+    cblas_cimatcopy, cblas_cimatcopy_64, cblas_comatcopy, cblas_comatcopy_64, cblas_dimatcopy,
+    cblas_dimatcopy_64, cblas_domatcopy, cblas_domatcopy_64, cblas_simatcopy, cblas_simatcopy_64,
+    cblas_somatcopy, cblas_somatcopy_64, cblas_zimatcopy, cblas_zimatcopy_64, cblas_zomatcopy,
+    cblas_zomatcopy_64,
 };
 pub use blas1::rot::{
     cblas_dcabs1, cblas_drot, cblas_drot_64, cblas_drotg, cblas_drotm, cblas_drotm_64,
@@ -72,12 +131,14 @@ pub use blas1::rot::{
     cblas_srotm_64, cblas_srotmg,
 };
 pub use blas1::vector::{
-    cblas_caxpy, cblas_caxpy_64, cblas_ccopy, cblas_ccopy_64, cblas_cscal, cblas_cscal_64,
-    cblas_csscal, cblas_csscal_64, cblas_cswap, cblas_cswap_64, cblas_daxpy, cblas_daxpy_64,
-    cblas_dcopy, cblas_dcopy_64, cblas_dscal, cblas_dscal_64, cblas_dswap, cblas_dswap_64,
+    cblas_caxpby, cblas_caxpby_64, cblas_caxpy, cblas_caxpy_64, cblas_ccopy, cblas_ccopy_64,
+    cblas_cscal, cblas_cscal_64, cblas_csscal, cblas_csscal_64, cblas_cswap, cblas_cswap_64,
+    cblas_daxpby, cblas_daxpby_64, cblas_daxpy, cblas_daxpy_64, cblas_dcopy, cblas_dcopy_64,
+    cblas_dscal, cblas_dscal_64, cblas_dswap, cblas_dswap_64, cblas_saxpby, cblas_saxpby_64,
     cblas_saxpy, cblas_saxpy_64, cblas_scopy, cblas_scopy_64, cblas_sscal, cblas_sscal_64,
-    cblas_sswap, cblas_sswap_64, cblas_zaxpy, cblas_zaxpy_64, cblas_zcopy, cblas_zcopy_64,
-    cblas_zdscal, cblas_zdscal_64, cblas_zscal, cblas_zscal_64, cblas_zswap, cblas_zswap_64,
+    cblas_sswap, cblas_sswap_64, cblas_zaxpby, cblas_zaxpby_64, cblas_zaxpy, cblas_zaxpy_64,
+    cblas_zcopy, cblas_zcopy_64, cblas_zdscal, cblas_zdscal_64, cblas_zscal, cblas_zscal_64,
+    cblas_zswap, cblas_zswap_64,
 };
 
 // BLAS Level 2
@@ -93,6 +154,24 @@ pub use blas2::ger::{
     cblas_cgerc, cblas_cgerc_64, cblas_cgeru, cblas_cgeru_64, cblas_dger, cblas_dger_64,
     cblas_sger, cblas_sger_64, cblas_zgerc, cblas_zgerc_64, cblas_zgeru, cblas_zgeru_64,
 };
+pub use blas2::pack::{
+    cblas_inject_cpack_gb, cblas_inject_cpack_gb_64, cblas_inject_cpack_tb,
+    cblas_inject_cpack_tb_64, cblas_inject_cpack_tp, cblas_inject_cpack_tp_64,
+    cblas_inject_cunpack_gb, cblas_inject_cunpack_gb_64, cblas_inject_cunpack_tb,
+    cblas_inject_cunpack_tb_64, cblas_inject_cunpack_tp, cblas_inject_cunpack_tp_64,
+    cblas_inject_dpack_gb, cblas_inject_dpack_gb_64, cblas_inject_dpack_tb,
+    cblas_inject_dpack_tb_64, cblas_inject_dpack_tp, cblas_inject_dpack_tp_64,
+    cblas_inject_dunpack_gb, cblas_inject_dunpack_gb_64, cblas_inject_dunpack_tb,
+    cblas_inject_dunpack_tb_64, cblas_inject_dunpack_tp, cblas_inject_dunpack_tp_64,
+    cblas_inject_spack_gb, cblas_inject_spack_gb_64, cblas_inject_spack_tb,
+    cblas_inject_spack_tb_64, cblas_inject_spack_tp, cblas_inject_spack_tp_64,
+    cblas_inject_sunpack_gb, cblas_inject_sunpack_gb_64, cblas_inject_sunpack_tb,
+    cblas_inject_sunpack_tb_64, cblas_inject_sunpack_tp, cblas_inject_sunpack_tp_64,
+    cblas_inject_zpack_gb, cblas_inject_zpack_gb_64, cblas_inject_zpack_tb,
+    cblas_inject_zpack_tb_64, cblas_inject_zpack_tp, cblas_inject_zpack_tp_64,
+    cblas_inject_zunpack_gb, cblas_inject_zunpack_gb_64, cblas_inject_zunpack_tb,
+    cblas_inject_zunpack_tb_64, cblas_inject_zunpack_tp, cblas_inject_zunpack_tp_64,
+};
 pub use blas2::sbmv::{
     cblas_chbmv, cblas_chbmv_64, cblas_dsbmv, cblas_dsbmv_64, cblas_ssbmv, cblas_ssbmv_64,
     cblas_zhbmv, cblas_zhbmv_64,
@@ -142,9 +221,32 @@ pub use blas3::gemm::{
     cblas_cgemm, cblas_cgemm_64, cblas_dgemm, cblas_dgemm_64, cblas_sgemm, cblas_sgemm_64,
     cblas_zgemm, cblas_zgemm_64,
 };
+pub use blas3::gemm3m::{
+    cblas_cgemm3m, cblas_cgemm3m_64, cblas_inject_gemm3m_min_flops,
+    cblas_inject_set_gemm3m_min_flops, cblas_zgemm3m, cblas_zgemm3m_64,
+};
+pub use blas3::gemm_batch::{
+    cblas_cgemm_batch, cblas_cgemm_batch_64, cblas_cgemm_batch_strided,
+    cblas_cgemm_batch_strided_64, cblas_dgemm_batch, cblas_dgemm_batch_64,
+    cblas_dgemm_batch_strided, cblas_dgemm_batch_strided_64, cblas_sgemm_batch,
+    cblas_sgemm_batch_64, cblas_sgemm_batch_strided, cblas_sgemm_batch_strided_64,
+    cblas_zgemm_batch, cblas_zgemm_batch_64, cblas_zgemm_batch_strided,
+    cblas_zgemm_batch_strided_64,
+};
+pub use blas3::gemmt::{
+    cblas_cgemmt, cblas_cgemmt_64, cblas_dgemmt, cblas_dgemmt_64, cblas_sgemmt, cblas_sgemmt_64,
+    cblas_zgemmt, cblas_zgemmt_64,
+};
 pub use blas3::hemm::{cblas_chemm, cblas_chemm_64, cblas_zhemm, cblas_zhemm_64};
 pub use blas3::her2k::{cblas_cher2k, cblas_cher2k_64, cblas_zher2k, cblas_zher2k_64};
 pub use blas3::herk::{cblas_cherk, cblas_cherk_64, cblas_zherk, cblas_zherk_64};
+pub use blas3::parallel::{cblas_inject_parallel_tile, cblas_inject_set_parallel_tile};
+pub use blas3::queue::{
+    cblas_inject_async_test, cblas_inject_async_wait, cblas_inject_async_wait_all,
+    cblas_inject_dgemm_async, cblas_inject_dgemm_async_64, cblas_inject_dtrsm_async,
+    cblas_inject_dtrsm_async_64, cblas_inject_zgemm_async, cblas_inject_zgemm_async_64,
+    cblas_inject_ztrsm_async, cblas_inject_ztrsm_async_64, CblasInjectAsync,
+};
 pub use blas3::symm::{
     cblas_csymm, cblas_csymm_64, cblas_dsymm, cblas_dsymm_64, cblas_ssymm, cblas_ssymm_64,
     cblas_zsymm, cblas_zsymm_64,
@@ -165,6 +267,7 @@ pub use blas3::trsm::{
     cblas_ctrsm, cblas_ctrsm_64, cblas_dtrsm, cblas_dtrsm_64, cblas_strsm, cblas_strsm_64,
     cblas_ztrsm, cblas_ztrsm_64,
 };
+pub use lp64_split::{cblas_inject_lp64_split_max, cblas_inject_set_lp64_split_max};
 
 // Error handling
 pub use xerbla::cblas_xerbla;
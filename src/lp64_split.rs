@@ -0,0 +1,338 @@
+//! Splitting `_64` calls into LP64-sized blocks.
+//!
+//! When only an LP64 provider is registered, a `cblas_*_64` call whose
+//! dimensions do not fit in 32 bits cannot be narrowed as a whole. The
+//! Level-1 reductions and each Level-3 operation decompose along some of
+//! their dimensions instead:
+//!
+//! - DOT, NRM2, ASUM and I?AMAX split `n` into chunks whose partial results
+//!   are merged: sums add, norms combine with `hypot` so the merge cannot
+//!   overflow, and I?AMAX offsets each chunk's index and keeps the first
+//!   chunk holding the largest magnitude.
+//! - GEMM splits `m`, `n` and `k`. The C blocks are independent, and the
+//!   `k` blocks of one C block accumulate, with `beta` applied only by the
+//!   first.
+//! - TRSM, TRMM, SYMM and HEMM split the dimension of B/C that is not the
+//!   order of A (`n` for `Left`, `m` for `Right`). Those blocks are independent.
+//! - SYRK, HERK, SYR2K and HER2K split `k`, accumulating as GEMM does.
+//!
+//! Leading dimensions are strides into the caller's storage, so they cannot
+//! be split and still go through `xerbla` when they overflow. The same goes
+//! for the order of a triangular or symmetric A, which never exceeds `lda`.
+//! In column-major storage a row count never exceeds its leading dimension,
+//! so the dimensions that can overflow on their own are exactly those that
+//! can be split.
+//!
+//! Increments are strides as well and are never split.
+//!
+//! Independent blocks run on the worker pool (`cblas_inject_set_worker_threads`).
+//! `cblas_inject_set_lp64_split_max` lowers the block extent, for example to
+//! bound the size of each provider call.
+
+use std::ffi::{c_char, c_int};
+use std::sync::atomic::{AtomicI32, Ordering};
+use std::sync::OnceLock;
+
+use crate::backend::{BlasInt32, CBLAS_INJECT_STATUS_INVALID_ARGUMENT, CBLAS_INJECT_STATUS_OK};
+use crate::int_convert::{to_lp64_i64, unchecked_lp64_i64};
+use crate::pool;
+use crate::types::{CblasColMajor, CblasConjNoTrans, CblasNoTrans, CBLAS_ORDER, CBLAS_TRANSPOSE};
+
+/// Largest extent of a split dimension in one LP64 provider call.
+static SPLIT_MAX: AtomicI32 = AtomicI32::new(BlasInt32::MAX);
+
+/// Set the largest extent of a split dimension in one LP64 provider call.
+///
+/// Dimensions of a `cblas_*_64` call that can be split and exceed
+/// `max` are cut into blocks of at most `max`. The default is `INT32_MAX`,
+/// which only splits calls that could not be narrowed otherwise. Returns
+/// `CBLAS_INJECT_STATUS_INVALID_ARGUMENT` unless `max` is positive.
+#[no_mangle]
+pub extern "C" fn cblas_inject_set_lp64_split_max(max: i32) -> i32 {
+    if max < 1 {
+        return CBLAS_INJECT_STATUS_INVALID_ARGUMENT;
+    }
+    SPLIT_MAX.store(max, Ordering::Relaxed);
+    CBLAS_INJECT_STATUS_OK
+}
+
+/// Current value set with `cblas_inject_set_lp64_split_max`.
+#[no_mangle]
+pub extern "C" fn cblas_inject_lp64_split_max() -> i32 {
+    SPLIT_MAX.load(Ordering::Relaxed)
+}
+
+#[inline]
+fn split_max() -> i64 {
+    i64::from(SPLIT_MAX.load(Ordering::Relaxed))
+}
+
+/// Check a `_64` call for an LP64 provider.
+///
+/// `fixed` values must narrow as they are. Positive `split` values may take
+/// any size, and negative ones must narrow for the provider to report.
+/// Returns false after reporting the lowest offending parameter through
+/// `xerbla`.
+#[inline]
+pub(crate) fn check_i64<const F: usize, const S: usize>(
+    routine: &[u8],
+    fixed: [(c_int, i64); F],
+    split: [(c_int, i64); S],
+) -> bool {
+    let offending = fixed
+        .into_iter()
+        .filter(|&(_, value)| BlasInt32::try_from(value).is_err())
+        .chain(
+            split
+                .into_iter()
+                .filter(|&(_, value)| value < i64::from(BlasInt32::MIN)),
+        )
+        .min_by_key(|&(param, _)| param);
+    match offending {
+        Some((param, value)) => to_lp64_i64(routine, param, value).is_some(),
+        None => true,
+    }
+}
+
+/// `count` blocks of at most `max` covering `0..extent`.
+#[derive(Clone, Copy)]
+pub(crate) struct Blocks {
+    extent: i64,
+    max: i64,
+    pub(crate) count: usize,
+}
+
+impl Blocks {
+    /// At least one block, so an empty extent still makes one call.
+    pub(crate) fn new(extent: i64, max: i64) -> Self {
+        let count = if extent <= max {
+            1
+        } else {
+            ((extent - 1) / max + 1) as usize
+        };
+        Blocks { extent, max, count }
+    }
+
+    /// Start and length of block `i`.
+    pub(crate) fn get(self, i: usize) -> (i64, BlasInt32) {
+        let start = i as i64 * self.max;
+        (
+            start,
+            unchecked_lp64_i64((self.extent - start).min(self.max)),
+        )
+    }
+
+    fn iter(self) -> impl Iterator<Item = (i64, BlasInt32)> {
+        (0..self.count).map(move |i| self.get(i))
+    }
+}
+
+/// Operand pointer shared by block tasks; the blocks a task writes are
+/// disjoint from every other task's.
+pub(crate) struct Shared<T>(*mut T);
+
+impl<T> Clone for Shared<T> {
+    fn clone(&self) -> Self {
+        *self
+    }
+}
+
+impl<T> Copy for Shared<T> {}
+
+unsafe impl<T> Sync for Shared<T> {}
+
+impl<T> Shared<T> {
+    pub(crate) fn new(p: *const T) -> Self {
+        Shared(p.cast_mut())
+    }
+
+    pub(crate) fn get(self) -> *mut T {
+        self.0
+    }
+
+    /// Element `(row, col)` of the column-major matrix with leading
+    /// dimension `ld`.
+    pub(crate) unsafe fn at(self, row: i64, col: i64, ld: i64) -> *mut T {
+        unsafe { self.0.offset((row + col * ld) as isize) }
+    }
+
+    /// First element in memory of elements `start..start + len` of a
+    /// length-`n` vector with increment `inc`, which BLAS walks from the end
+    /// when `inc` is negative.
+    pub(crate) unsafe fn chunk(self, n: i64, inc: i64, start: i64, len: BlasInt32) -> *mut T {
+        let first = if inc < 0 {
+            n - start - i64::from(len)
+        } else {
+            start
+        };
+        unsafe { self.0.offset((first * inc.abs()) as isize) }
+    }
+}
+
+/// Reduce a length-`n` vector as LP64 chunks.
+///
+/// `call(start, len)` returns the partial result of elements
+/// `start..start + len`, and `merge` folds the partials in order. A vector
+/// within the split extent is one call; a longer one is cut into chunks of
+/// at most the split extent, and at least one per worker thread, which run
+/// in parallel.
+pub(crate) fn vector<R: Send + Sync>(
+    n: i64,
+    call: &(dyn Fn(i64, BlasInt32) -> R + Sync),
+    merge: impl Fn(R, R) -> R,
+) -> R {
+    let max = split_max();
+    if n <= max {
+        return call(0, unchecked_lp64_i64(n));
+    }
+    let threads = pool::worker_threads() as i64;
+    let chunks = Blocks::new(n, max.min((n - 1) / threads + 1));
+    let partials: Vec<OnceLock<R>> = (0..chunks.count).map(|_| OnceLock::new()).collect();
+    pool::parallel_for(chunks.count, &|i| {
+        let (start, len) = chunks.get(i);
+        let _ = partials[i].set(call(start, len));
+    });
+    partials
+        .into_iter()
+        .filter_map(OnceLock::into_inner)
+        .reduce(merge)
+        .expect("every chunk produces a partial result")
+}
+
+/// Whether a Fortran transpose flag stores the operand transposed.
+#[inline]
+pub(crate) fn transposed(trans: c_char) -> bool {
+    trans == b'T' as c_char || trans == b'C' as c_char
+}
+
+/// One LP64 provider call of a split GEMM, in column-major terms.
+pub(crate) struct GemmBlock<T> {
+    pub m: BlasInt32,
+    pub n: BlasInt32,
+    pub k: BlasInt32,
+    pub a: *const T,
+    pub lda: BlasInt32,
+    pub b: *const T,
+    pub ldb: BlasInt32,
+    pub beta: T,
+    pub c: *mut T,
+    pub ldc: BlasInt32,
+}
+
+/// Run a column-major GEMM as LP64 blocks of at most the split extent.
+///
+/// C blocks run in parallel; the `k` blocks of each run in order, the first
+/// with `beta` and the rest with `one`.
+#[allow(clippy::too_many_arguments)]
+pub(crate) unsafe fn gemm<T: Copy + Sync>(
+    transa: c_char,
+    transb: c_char,
+    m: i64,
+    n: i64,
+    k: i64,
+    a: *const T,
+    lda: i64,
+    b: *const T,
+    ldb: i64,
+    beta: T,
+    one: T,
+    c: *mut T,
+    ldc: i64,
+    call: &(dyn Fn(GemmBlock<T>) + Sync),
+) {
+    let max = split_max();
+    unsafe {
+        gemm_blocks(
+            transa, transb, m, n, k, a, lda, b, ldb, beta, one, c, ldc, max, max, call,
+        )
+    }
+}
+
+/// Run a column-major GEMM as blocks of C of at most `tile` rows and
+/// columns, each covering at most `depth` of `k`; see [`gemm`].
+#[allow(clippy::too_many_arguments)]
+pub(crate) unsafe fn gemm_blocks<T: Copy + Sync>(
+    transa: c_char,
+    transb: c_char,
+    m: i64,
+    n: i64,
+    k: i64,
+    a: *const T,
+    lda: i64,
+    b: *const T,
+    ldb: i64,
+    beta: T,
+    one: T,
+    c: *mut T,
+    ldc: i64,
+    tile: i64,
+    depth: i64,
+    call: &(dyn Fn(GemmBlock<T>) + Sync),
+) {
+    let (rows, cols, depth) = (
+        Blocks::new(m, tile),
+        Blocks::new(n, tile),
+        Blocks::new(k, depth),
+    );
+    let (a, b, c) = (Shared::new(a), Shared::new(b), Shared::new(c));
+    let (trans_a, trans_b) = (transposed(transa), transposed(transb));
+    pool::parallel_for(rows.count * cols.count, &|block| {
+        let (i0, mb) = rows.get(block % rows.count);
+        let (j0, nb) = cols.get(block / rows.count);
+        for (p0, kb) in depth.iter() {
+            let (ai, aj) = if trans_a { (p0, i0) } else { (i0, p0) };
+            let (bi, bj) = if trans_b { (j0, p0) } else { (p0, j0) };
+            call(GemmBlock {
+                m: mb,
+                n: nb,
+                k: kb,
+                a: unsafe { a.at(ai, aj, lda) },
+                lda: unchecked_lp64_i64(lda),
+                b: unsafe { b.at(bi, bj, ldb) },
+                ldb: unchecked_lp64_i64(ldb),
+                beta: if p0 == 0 { beta } else { one },
+                c: unsafe { c.at(i0, j0, ldc) },
+                ldc: unchecked_lp64_i64(ldc),
+            });
+        }
+    });
+}
+
+/// Run `call(row, rows, col, cols)` on blocks of a column-major `m x n`
+/// operand, in parallel.
+///
+/// `left` splits the columns, as for `Side=Left` where A acts on the rows,
+/// and otherwise the rows.
+pub(crate) fn side(
+    left: bool,
+    m: i64,
+    n: i64,
+    call: &(dyn Fn(i64, BlasInt32, i64, BlasInt32) + Sync),
+) {
+    let max = split_max();
+    let (rows, cols) = if left {
+        (Blocks::new(m, i64::MAX), Blocks::new(n, max))
+    } else {
+        (Blocks::new(m, max), Blocks::new(n, i64::MAX))
+    };
+    pool::parallel_for(rows.count * cols.count, &|tile| {
+        let (i0, mb) = rows.get(tile % rows.count);
+        let (j0, nb) = cols.get(tile / rows.count);
+        call(i0, mb, j0, nb);
+    });
+}
+
+/// `(start, len)` blocks of the `k` dimension of a rank-k update, in order.
+///
+/// The first block applies `beta` and later ones accumulate with one.
+pub(crate) fn rank_k(k: i64) -> impl Iterator<Item = (i64, BlasInt32)> {
+    Blocks::new(k, split_max()).iter()
+}
+
+/// Element offset of the `k` block starting at `p0` in a rank-k operand,
+/// which is `n x k` for `NoTrans` and `k x n` otherwise, in `order` layout.
+#[inline]
+pub(crate) fn rank_k_offset(order: CBLAS_ORDER, trans: CBLAS_TRANSPOSE, p0: i64, ld: i64) -> isize {
+    let columns = (order == CblasColMajor) == matches!(trans, CblasNoTrans | CblasConjNoTrans);
+    (if columns { p0 * ld } else { p0 }) as isize
+}
@@ -0,0 +1,572 @@
+//! Native BLAS Level 1 kernels for short vectors.
+//!
+//! For short vectors the provider call (arguments by reference, the
+//! provider's dispatch and its threading checks) costs more than the loop
+//! itself. The real-valued CBLAS wrappers for swap, copy, axpy, axpby, scal,
+//! dot, nrm2, asum and i?amax use these kernels when `n` is at most the threshold
+//! set with `cblas_inject_set_native_blas1_max_n`. They also use them,
+//! whatever `n` is, when no provider is registered for the routine.
+//!
+//! The complex `?axpby` skips the threshold and runs here only when no
+//! provider is registered. The fused [`axpy_dot`] behind
+//! `cblas_inject_?axpy_dot` always runs here, since no provider offers it.
+//!
+//! Increment semantics follow the reference BLAS: swap, copy, axpy, axpby and
+//! dot start from the far end for negative increments, while scal, nrm2, asum
+//! and i?amax do nothing (or return 0) for non-positive `incx`.
+
+use std::ops::{Div, Sub};
+use std::slice;
+use std::sync::atomic::{AtomicI64, Ordering};
+
+use crate::backend::{CBLAS_INJECT_STATUS_INVALID_ARGUMENT, CBLAS_INJECT_STATUS_OK};
+use crate::native::{multiversion, Scalar};
+use crate::trace::{self, Path};
+
+/// Vector length threshold; calls with `n <= NATIVE_BLAS1_MAX_N` run natively.
+static NATIVE_BLAS1_MAX_N: AtomicI64 = AtomicI64::new(0);
+
+/// Number of independent accumulators in the unit-stride reductions.
+const LANES: usize = 8;
+
+/// Run real BLAS Level 1 calls with `n <= max_n` natively.
+///
+/// 0 (the default) keeps every call on the registered provider. Returns
+/// `CBLAS_INJECT_STATUS_INVALID_ARGUMENT` when `max_n` is negative.
+#[no_mangle]
+pub extern "C" fn cblas_inject_set_native_blas1_max_n(max_n: i64) -> i32 {
+    if max_n < 0 {
+        return CBLAS_INJECT_STATUS_INVALID_ARGUMENT;
+    }
+    NATIVE_BLAS1_MAX_N.store(max_n, Ordering::Relaxed);
+    CBLAS_INJECT_STATUS_OK
+}
+
+/// Current native BLAS Level 1 threshold.
+#[no_mangle]
+pub extern "C" fn cblas_inject_native_blas1_max_n() -> i64 {
+    NATIVE_BLAS1_MAX_N.load(Ordering::Relaxed)
+}
+
+/// Return the provider to call, or `None` when the native kernel should run.
+#[inline]
+pub(crate) fn select_provider<P>(n: i64, resolve: impl FnOnce() -> Option<P>) -> Option<P> {
+    let p = if n <= NATIVE_BLAS1_MAX_N.load(Ordering::Relaxed)
+        || crate::dispatch::scope_prefers_native()
+    {
+        None
+    } else {
+        resolve()
+    };
+    if p.is_none() {
+        trace::dispatched(Path::Native);
+    }
+    p
+}
+
+/// Real element type accepted by the Level 1 kernels.
+pub(crate) trait Real:
+    Scalar + PartialOrd + Sub<Output = Self> + Div<Output = Self>
+{
+    const ONE: Self;
+    const MIN_POSITIVE: Self;
+    const EPSILON: Self;
+
+    fn abs(self) -> Self;
+    fn sqrt(self) -> Self;
+    fn is_finite(self) -> bool;
+    fn is_nan(self) -> bool;
+}
+
+macro_rules! impl_real {
+    ($t:ident) => {
+        impl Real for $t {
+            const ONE: Self = 1.0;
+            const MIN_POSITIVE: Self = $t::MIN_POSITIVE;
+            const EPSILON: Self = $t::EPSILON;
+
+            #[inline(always)]
+            fn abs(self) -> Self {
+                $t::abs(self)
+            }
+
+            #[inline(always)]
+            fn sqrt(self) -> Self {
+                $t::sqrt(self)
+            }
+
+            #[inline(always)]
+            fn is_finite(self) -> bool {
+                $t::is_finite(self)
+            }
+
+            #[inline(always)]
+            fn is_nan(self) -> bool {
+                $t::is_nan(self)
+            }
+        }
+    };
+}
+
+impl_real!(f32);
+impl_real!(f64);
+
+/// Offset of the first element visited for a (possibly negative) increment.
+#[inline(always)]
+fn start(n: usize, inc: isize) -> isize {
+    if inc < 0 {
+        (1 - n as isize) * inc
+    } else {
+        0
+    }
+}
+
+#[inline(always)]
+fn lanes_sum<T: Real>(acc: [T; LANES]) -> T {
+    acc.iter().fold(T::ZERO, |s, &v| s + v)
+}
+
+#[inline(always)]
+unsafe fn swap_kernel<T: Real>(n: usize, x: *mut T, incx: isize, y: *mut T, incy: isize) {
+    if incx == 1 && incy == 1 {
+        let (x, y) = unsafe {
+            (
+                slice::from_raw_parts_mut(x, n),
+                slice::from_raw_parts_mut(y, n),
+            )
+        };
+        x.swap_with_slice(y);
+        return;
+    }
+    let (mut ix, mut iy) = (start(n, incx), start(n, incy));
+    for _ in 0..n {
+        unsafe { std::ptr::swap(x.offset(ix), y.offset(iy)) };
+        ix += incx;
+        iy += incy;
+    }
+}
+
+#[inline(always)]
+unsafe fn copy_kernel<T: Real>(n: usize, x: *const T, incx: isize, y: *mut T, incy: isize) {
+    if incx == 1 && incy == 1 {
+        let (x, y) = unsafe { (slice::from_raw_parts(x, n), slice::from_raw_parts_mut(y, n)) };
+        y.copy_from_slice(x);
+        return;
+    }
+    let (mut ix, mut iy) = (start(n, incx), start(n, incy));
+    for _ in 0..n {
+        unsafe { *y.offset(iy) = *x.offset(ix) };
+        ix += incx;
+        iy += incy;
+    }
+}
+
+#[inline(always)]
+unsafe fn axpy_kernel<T: Real>(
+    n: usize,
+    alpha: T,
+    x: *const T,
+    incx: isize,
+    y: *mut T,
+    incy: isize,
+) {
+    if incx == 1 && incy == 1 {
+        let (x, y) = unsafe { (slice::from_raw_parts(x, n), slice::from_raw_parts_mut(y, n)) };
+        for (yi, &xi) in y.iter_mut().zip(x) {
+            *yi = *yi + alpha * xi;
+        }
+        return;
+    }
+    let (mut ix, mut iy) = (start(n, incx), start(n, incy));
+    for _ in 0..n {
+        unsafe { *y.offset(iy) = *y.offset(iy) + alpha * *x.offset(ix) };
+        ix += incx;
+        iy += incy;
+    }
+}
+
+/// `y[i] = f(x[i], y[i])` over both vectors.
+#[inline(always)]
+unsafe fn zip_update<T: Scalar>(
+    n: usize,
+    x: *const T,
+    incx: isize,
+    y: *mut T,
+    incy: isize,
+    f: impl Fn(T, T) -> T,
+) {
+    if incx == 1 && incy == 1 {
+        let (x, y) = unsafe { (slice::from_raw_parts(x, n), slice::from_raw_parts_mut(y, n)) };
+        for (yi, &xi) in y.iter_mut().zip(x) {
+            *yi = f(xi, *yi);
+        }
+        return;
+    }
+    let (mut ix, mut iy) = (start(n, incx), start(n, incy));
+    for _ in 0..n {
+        unsafe { *y.offset(iy) = f(*x.offset(ix), *y.offset(iy)) };
+        ix += incx;
+        iy += incy;
+    }
+}
+
+#[inline(always)]
+unsafe fn axpby_kernel<T: Scalar>(
+    n: usize,
+    alpha: T,
+    x: *const T,
+    incx: isize,
+    beta: T,
+    y: *mut T,
+    incy: isize,
+) {
+    // As in OpenBLAS, a zero alpha or beta drops its term, so NaN or Inf in
+    // the unused vector does not reach y.
+    unsafe {
+        match (alpha.is_zero(), beta.is_zero()) {
+            (true, true) => zip_update(n, x, incx, y, incy, |_, _| T::ZERO),
+            (false, true) => zip_update(n, x, incx, y, incy, |xi, _| alpha * xi),
+            (true, false) => zip_update(n, x, incx, y, incy, |_, yi| beta * yi),
+            (false, false) => zip_update(n, x, incx, y, incy, |xi, yi| alpha * xi + beta * yi),
+        }
+    }
+}
+
+/// `y += alpha * x` over contiguous slices, returning the sum of
+/// `term(i, y[i])` over the updated elements.
+#[inline(always)]
+fn axpy_then_sum<T: Real>(alpha: T, x: &[T], y: &mut [T], term: impl Fn(usize, T) -> T) -> T {
+    let n = y.len();
+    let x = &x[..n];
+    let full = n - n % LANES;
+    let mut acc = [T::ZERO; LANES];
+    for i in (0..full).step_by(LANES) {
+        for l in 0..LANES {
+            let v = y[i + l] + alpha * x[i + l];
+            y[i + l] = v;
+            acc[l] = acc[l] + term(i + l, v);
+        }
+    }
+    let mut sum = lanes_sum(acc);
+    for i in full..n {
+        let v = y[i] + alpha * x[i];
+        y[i] = v;
+        sum = sum + term(i, v);
+    }
+    sum
+}
+
+#[inline(always)]
+#[allow(clippy::too_many_arguments)]
+unsafe fn axpy_dot_kernel<T: Real>(
+    n: usize,
+    alpha: T,
+    x: *const T,
+    incx: isize,
+    y: *mut T,
+    incy: isize,
+    z: *const T,
+    incz: isize,
+) -> T {
+    if incx == 1 && incy == 1 && incz == 1 {
+        let (x, y) = unsafe { (slice::from_raw_parts(x, n), slice::from_raw_parts_mut(y, n)) };
+        if std::ptr::eq(z, y.as_ptr()) {
+            return axpy_then_sum(alpha, x, y, |_, v| v * v);
+        }
+        let z = unsafe { slice::from_raw_parts(z, n) };
+        return axpy_then_sum(alpha, x, y, |i, v| z[i] * v);
+    }
+    // z is read after y is written, which also covers z aliasing y.
+    let (mut ix, mut iy, mut iz) = (start(n, incx), start(n, incy), start(n, incz));
+    let mut sum = T::ZERO;
+    for _ in 0..n {
+        unsafe {
+            let v = *y.offset(iy) + alpha * *x.offset(ix);
+            *y.offset(iy) = v;
+            sum = sum + *z.offset(iz) * v;
+        }
+        ix += incx;
+        iy += incy;
+        iz += incz;
+    }
+    sum
+}
+
+#[inline(always)]
+unsafe fn scal_kernel<T: Real>(n: usize, alpha: T, x: *mut T, incx: usize) {
+    if incx == 1 {
+        for xi in unsafe { slice::from_raw_parts_mut(x, n) } {
+            *xi = alpha * *xi;
+        }
+        return;
+    }
+    for i in 0..n {
+        unsafe { *x.add(i * incx) = alpha * *x.add(i * incx) };
+    }
+}
+
+#[inline(always)]
+unsafe fn dot_kernel<T: Real>(n: usize, x: *const T, incx: isize, y: *const T, incy: isize) -> T {
+    if incx == 1 && incy == 1 {
+        let (x, y) = unsafe { (slice::from_raw_parts(x, n), slice::from_raw_parts(y, n)) };
+        let mut acc = [T::ZERO; LANES];
+        let (xc, yc) = (x.chunks_exact(LANES), y.chunks_exact(LANES));
+        let tail = xc.remainder().iter().zip(yc.remainder());
+        for (xs, ys) in xc.zip(yc) {
+            for l in 0..LANES {
+                acc[l] = acc[l] + xs[l] * ys[l];
+            }
+        }
+        return tail.fold(lanes_sum(acc), |s, (&xi, &yi)| s + xi * yi);
+    }
+    let (mut ix, mut iy) = (start(n, incx), start(n, incy));
+    let mut sum = T::ZERO;
+    for _ in 0..n {
+        sum = sum + unsafe { *x.offset(ix) * *y.offset(iy) };
+        ix += incx;
+        iy += incy;
+    }
+    sum
+}
+
+#[inline(always)]
+unsafe fn asum_kernel<T: Real>(n: usize, x: *const T, incx: usize) -> T {
+    if incx == 1 {
+        let x = unsafe { slice::from_raw_parts(x, n) };
+        let mut acc = [T::ZERO; LANES];
+        let xc = x.chunks_exact(LANES);
+        let tail = xc.remainder();
+        for xs in xc {
+            for l in 0..LANES {
+                acc[l] = acc[l] + xs[l].abs();
+            }
+        }
+        return tail.iter().fold(lanes_sum(acc), |s, &xi| s + xi.abs());
+    }
+    (0..n).fold(T::ZERO, |s, i| s + unsafe { *x.add(i * incx) }.abs())
+}
+
+#[inline(always)]
+unsafe fn sumsq_kernel<T: Real>(n: usize, x: *const T, incx: usize, scale: T) -> T {
+    if incx == 1 {
+        let x = unsafe { slice::from_raw_parts(x, n) };
+        let mut acc = [T::ZERO; LANES];
+        let xc = x.chunks_exact(LANES);
+        let tail = xc.remainder();
+        for xs in xc {
+            for l in 0..LANES {
+                let v = xs[l] * scale;
+                acc[l] = acc[l] + v * v;
+            }
+        }
+        return tail
+            .iter()
+            .fold(lanes_sum(acc), |s, &xi| s + xi * scale * (xi * scale));
+    }
+    (0..n).fold(T::ZERO, |s, i| {
+        let v = unsafe { *x.add(i * incx) } * scale;
+        s + v * v
+    })
+}
+
+#[inline(always)]
+unsafe fn iamax_kernel<T: Real>(n: usize, x: *const T, incx: usize) -> usize {
+    let mut best = 0;
+    let mut max = unsafe { *x }.abs();
+    for i in 1..n {
+        let v = unsafe { *x.add(i * incx) }.abs();
+        if v > max {
+            best = i;
+            max = v;
+        }
+    }
+    best
+}
+
+multiversion! {
+    unsafe fn swap_dispatch<T: Real>(n: usize, x: *mut T, incx: isize, y: *mut T, incy: isize)
+        => swap_kernel
+}
+multiversion! {
+    unsafe fn copy_dispatch<T: Real>(n: usize, x: *const T, incx: isize, y: *mut T, incy: isize)
+        => copy_kernel
+}
+multiversion! {
+    unsafe fn axpy_dispatch<T: Real>(
+        n: usize,
+        alpha: T,
+        x: *const T,
+        incx: isize,
+        y: *mut T,
+        incy: isize,
+    ) => axpy_kernel
+}
+multiversion! {
+    unsafe fn axpby_dispatch<T: Scalar>(
+        n: usize,
+        alpha: T,
+        x: *const T,
+        incx: isize,
+        beta: T,
+        y: *mut T,
+        incy: isize,
+    ) => axpby_kernel
+}
+multiversion! {
+    unsafe fn axpy_dot_dispatch<T: Real>(
+        n: usize,
+        alpha: T,
+        x: *const T,
+        incx: isize,
+        y: *mut T,
+        incy: isize,
+        z: *const T,
+        incz: isize,
+    ) -> T => axpy_dot_kernel
+}
+multiversion! {
+    unsafe fn scal_dispatch<T: Real>(n: usize, alpha: T, x: *mut T, incx: usize) => scal_kernel
+}
+multiversion! {
+    unsafe fn dot_dispatch<T: Real>(n: usize, x: *const T, incx: isize, y: *const T, incy: isize)
+        -> T => dot_kernel
+}
+multiversion! {
+    unsafe fn asum_dispatch<T: Real>(n: usize, x: *const T, incx: usize) -> T => asum_kernel
+}
+multiversion! {
+    unsafe fn sumsq_dispatch<T: Real>(n: usize, x: *const T, incx: usize, scale: T) -> T
+        => sumsq_kernel
+}
+multiversion! {
+    unsafe fn iamax_dispatch<T: Real>(n: usize, x: *const T, incx: usize) -> usize => iamax_kernel
+}
+
+/// Native `?swap`.
+pub(crate) unsafe fn swap<T: Real>(n: i64, x: *mut T, incx: i64, y: *mut T, incy: i64) {
+    if n <= 0 {
+        return;
+    }
+    unsafe { swap_dispatch(n as usize, x, incx as isize, y, incy as isize) }
+}
+
+/// Native `?copy`.
+pub(crate) unsafe fn copy<T: Real>(n: i64, x: *const T, incx: i64, y: *mut T, incy: i64) {
+    if n <= 0 {
+        return;
+    }
+    unsafe { copy_dispatch(n as usize, x, incx as isize, y, incy as isize) }
+}
+
+/// Native `?axpy`.
+pub(crate) unsafe fn axpy<T: Real>(n: i64, alpha: T, x: *const T, incx: i64, y: *mut T, incy: i64) {
+    if n <= 0 || alpha.is_zero() {
+        return;
+    }
+    unsafe { axpy_dispatch(n as usize, alpha, x, incx as isize, y, incy as isize) }
+}
+
+/// Native `?axpby`, for real and complex elements.
+pub(crate) unsafe fn axpby<T: Scalar>(
+    n: i64,
+    alpha: T,
+    x: *const T,
+    incx: i64,
+    beta: T,
+    y: *mut T,
+    incy: i64,
+) {
+    if n <= 0 {
+        return;
+    }
+    unsafe { axpby_dispatch(n as usize, alpha, x, incx as isize, beta, y, incy as isize) }
+}
+
+/// `y += alpha * x` followed by `dot(z, y)` on the updated `y`, in one pass.
+///
+/// `z` may be `y` with the same increment; otherwise it must not overlap `y`.
+#[allow(clippy::too_many_arguments)]
+pub(crate) unsafe fn axpy_dot<T: Real>(
+    n: i64,
+    alpha: T,
+    x: *const T,
+    incx: i64,
+    y: *mut T,
+    incy: i64,
+    z: *const T,
+    incz: i64,
+) -> T {
+    if n <= 0 {
+        return T::ZERO;
+    }
+    unsafe {
+        axpy_dot_dispatch(
+            n as usize,
+            alpha,
+            x,
+            incx as isize,
+            y,
+            incy as isize,
+            z,
+            incz as isize,
+        )
+    }
+}
+
+/// Native `?scal`.
+pub(crate) unsafe fn scal<T: Real>(n: i64, alpha: T, x: *mut T, incx: i64) {
+    if n <= 0 || incx <= 0 {
+        return;
+    }
+    unsafe { scal_dispatch(n as usize, alpha, x, incx as usize) }
+}
+
+/// Native `?dot`.
+pub(crate) unsafe fn dot<T: Real>(n: i64, x: *const T, incx: i64, y: *const T, incy: i64) -> T {
+    if n <= 0 {
+        return T::ZERO;
+    }
+    unsafe { dot_dispatch(n as usize, x, incx as isize, y, incy as isize) }
+}
+
+/// Native `?asum`.
+pub(crate) unsafe fn asum<T: Real>(n: i64, x: *const T, incx: i64) -> T {
+    if n <= 0 || incx <= 0 {
+        return T::ZERO;
+    }
+    unsafe { asum_dispatch(n as usize, x, incx as usize) }
+}
+
+/// Native `?nrm2`.
+///
+/// The plain sum of squares is used when it neither overflows nor loses
+/// precision to underflow; otherwise the vector is rescaled by its largest
+/// magnitude and summed again.
+pub(crate) unsafe fn nrm2<T: Real>(n: i64, x: *const T, incx: i64) -> T {
+    if n <= 0 || incx <= 0 {
+        return T::ZERO;
+    }
+    let (n, incx) = (n as usize, incx as usize);
+    let ssq = unsafe { sumsq_dispatch(n, x, incx, T::ONE) };
+    if ssq.is_finite() && ssq >= T::MIN_POSITIVE / T::EPSILON {
+        return ssq.sqrt();
+    }
+    if ssq.is_nan() {
+        return ssq;
+    }
+
+    let amax = unsafe { (*x.add(iamax_dispatch(n, x, incx) * incx)).abs() };
+    if amax.is_zero() || !amax.is_finite() {
+        return amax;
+    }
+    let ssq = unsafe { sumsq_dispatch(n, x, incx, T::ONE / amax) };
+    amax * ssq.sqrt()
+}
+
+/// Native `i?amax`, returning the 0-based CBLAS index.
+pub(crate) unsafe fn iamax<T: Real>(n: i64, x: *const T, incx: i64) -> i64 {
+    if n <= 0 || incx <= 0 {
+        return 0;
+    }
+    unsafe { iamax_dispatch(n as usize, x, incx as usize) as i64 }
+}
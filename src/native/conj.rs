@@ -0,0 +1,146 @@
+//! Conjugation passes for the row-major complex Hermitian wrappers.
+//!
+//! A row-major Hermitian matrix is the column-major storage of its conjugate,
+//! so the row-major `hemv`/`hbmv`/`hpmv` and `her`/`her2`/`hpr`/`hpr2`
+//! wrappers conjugate their vectors around the provider call. These kernels
+//! do that in as few sweeps as possible: the input copy and the in-place
+//! pre-conjugation of `y` share one pass, and unit strides get a contiguous
+//! loop that LLVM turns into a sign-flip on the imaginary lanes.
+//!
+//! Increments follow BLAS: for a negative `inc` the first logical element is
+//! at `x + (n - 1) * |inc|`.
+
+use std::slice;
+
+use crate::native::{multiversion, Scalar};
+
+/// Pointer to logical element 0 of a vector with increment `inc`.
+#[inline(always)]
+fn first<T>(x: *const T, n: usize, inc: isize) -> *const T {
+    if inc < 0 {
+        x.wrapping_offset(-(n as isize - 1) * inc)
+    } else {
+        x
+    }
+}
+
+#[inline(always)]
+unsafe fn conj_in_place_kernel<T: Scalar>(n: usize, y: *mut T, incy: isize) {
+    // Conjugating every element does not depend on the traversal order.
+    let step = incy.unsigned_abs();
+    if step == 1 {
+        for v in unsafe { slice::from_raw_parts_mut(y, n) } {
+            *v = v.conj();
+        }
+    } else {
+        for i in 0..n {
+            unsafe {
+                let p = y.add(i * step);
+                *p = (*p).conj();
+            }
+        }
+    }
+}
+
+#[inline(always)]
+unsafe fn conj_copy_kernel<T: Scalar>(n: usize, x: *const T, incx: isize, dst: *mut T) {
+    let dst = unsafe { slice::from_raw_parts_mut(dst, n) };
+    if incx == 1 {
+        let x = unsafe { slice::from_raw_parts(x, n) };
+        for (d, &v) in dst.iter_mut().zip(x) {
+            *d = v.conj();
+        }
+    } else {
+        let x = first(x, n, incx);
+        for (i, d) in dst.iter_mut().enumerate() {
+            *d = unsafe { *x.offset(i as isize * incx) }.conj();
+        }
+    }
+}
+
+#[inline(always)]
+unsafe fn conj_copy_and_conj_kernel<T: Scalar>(
+    n: usize,
+    x: *const T,
+    incx: isize,
+    dst: *mut T,
+    y: *mut T,
+    incy: isize,
+) {
+    let dst = unsafe { slice::from_raw_parts_mut(dst, n) };
+    let step = incy.unsigned_abs();
+    if incx == 1 && step == 1 {
+        let x = unsafe { slice::from_raw_parts(x, n) };
+        let y = unsafe { slice::from_raw_parts_mut(y, n) };
+        for ((d, &v), w) in dst.iter_mut().zip(x).zip(y) {
+            *d = v.conj();
+            *w = w.conj();
+        }
+    } else {
+        let x = first(x, n, incx);
+        for (i, d) in dst.iter_mut().enumerate() {
+            unsafe {
+                *d = (*x.offset(i as isize * incx)).conj();
+                let p = y.add(i * step);
+                *p = (*p).conj();
+            }
+        }
+    }
+}
+
+multiversion! {
+    unsafe fn conj_in_place_dispatch<T: Scalar>(n: usize, y: *mut T, incy: isize)
+        => conj_in_place_kernel
+}
+
+multiversion! {
+    unsafe fn conj_copy_dispatch<T: Scalar>(n: usize, x: *const T, incx: isize, dst: *mut T)
+        => conj_copy_kernel
+}
+
+multiversion! {
+    unsafe fn conj_copy_and_conj_dispatch<T: Scalar>(
+        n: usize,
+        x: *const T,
+        incx: isize,
+        dst: *mut T,
+        y: *mut T,
+        incy: isize,
+    ) => conj_copy_and_conj_kernel
+}
+
+/// Conjugate the `n` elements of `y` in place.
+#[inline]
+pub(crate) unsafe fn conj_in_place<T: Scalar>(n: i64, y: *mut T, incy: i64) {
+    if n <= 0 {
+        return;
+    }
+    unsafe { conj_in_place_dispatch(n as usize, y, incy as isize) }
+}
+
+/// Write `conj(x)` into the contiguous `dst`, which holds at least `n` elements.
+#[inline]
+pub(crate) unsafe fn conj_copy<T: Scalar>(n: i64, x: *const T, incx: i64, dst: &mut [T]) {
+    if n <= 0 {
+        return;
+    }
+    let n = (n as usize).min(dst.len());
+    unsafe { conj_copy_dispatch(n, x, incx as isize, dst.as_mut_ptr()) }
+}
+
+/// Write `conj(x)` into `dst` and conjugate `y` in place, in a single pass.
+#[inline]
+pub(crate) unsafe fn conj_copy_and_conj<T: Scalar>(
+    n: i64,
+    x: *const T,
+    incx: i64,
+    dst: &mut [T],
+    y: *mut T,
+    incy: i64,
+) {
+    if n <= 0 {
+        return;
+    }
+    let n = (n as usize).min(dst.len());
+    unsafe { conj_copy_and_conj_dispatch(n, x, incx as isize, dst.as_mut_ptr(), y, incy as isize) }
+}
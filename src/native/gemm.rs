@@ -0,0 +1,289 @@
+//! Native small GEMM path.
+//!
+//! Block-sparse workloads issue many GEMMs with every dimension around 4 to
+//! 16, where the by-reference Fortran call and the provider's own argument
+//! checking and packing cost more than the arithmetic. When enabled with
+//! `cblas_inject_set_small_gemm_max_dim`, shapes whose `m`, `n` and `k` all fit
+//! under the crossover are computed here and larger ones go to the provider.
+//!
+//! Row-major conversion logic derived from OpenBLAS.
+//! Copyright (c) 2011-2014, The OpenBLAS Project. BSD-3-Clause License.
+//! <https://github.com/OpenMathLib/OpenBLAS/blob/develop/interface/gemm.c>
+
+use std::slice;
+use std::sync::atomic::{AtomicI32, Ordering};
+
+use crate::backend::{CBLAS_INJECT_STATUS_INVALID_ARGUMENT, CBLAS_INJECT_STATUS_OK};
+use crate::native::{multiversion, Scalar};
+use crate::types::{
+    CblasColMajor, CblasConjNoTrans, CblasConjTrans, CblasNoTrans, CblasRowMajor, CblasTrans,
+    CBLAS_ORDER, CBLAS_TRANSPOSE,
+};
+
+/// Largest crossover accepted by `cblas_inject_set_small_gemm_max_dim`.
+pub const CBLAS_INJECT_SMALL_GEMM_DIM_LIMIT: i32 = 32;
+
+/// Crossover dimension; 0 disables the native path.
+static SMALL_GEMM_MAX_DIM: AtomicI32 = AtomicI32::new(0);
+
+/// Enable the native small GEMM path for shapes with `m, n, k <= max_dim`.
+///
+/// Pass 0 to disable it again (the default). Returns
+/// `CBLAS_INJECT_STATUS_INVALID_ARGUMENT` when `max_dim` is negative or larger
+/// than `CBLAS_INJECT_SMALL_GEMM_DIM_LIMIT`.
+#[no_mangle]
+pub extern "C" fn cblas_inject_set_small_gemm_max_dim(max_dim: i32) -> i32 {
+    if !(0..=CBLAS_INJECT_SMALL_GEMM_DIM_LIMIT).contains(&max_dim) {
+        return CBLAS_INJECT_STATUS_INVALID_ARGUMENT;
+    }
+    SMALL_GEMM_MAX_DIM.store(max_dim, Ordering::Relaxed);
+    CBLAS_INJECT_STATUS_OK
+}
+
+/// Current small GEMM crossover dimension (0 when disabled).
+#[no_mangle]
+pub extern "C" fn cblas_inject_small_gemm_max_dim() -> i32 {
+    SMALL_GEMM_MAX_DIM.load(Ordering::Relaxed)
+}
+
+/// Operand transform after real/complex normalization.
+#[derive(Clone, Copy, PartialEq, Eq)]
+enum Op {
+    NoTrans,
+    Trans,
+    ConjTrans,
+}
+
+/// Map a CBLAS transpose onto the kernel's operand transform.
+///
+/// `CblasConjNoTrans` is left to the provider, which owns its semantics and
+/// error reporting.
+#[inline]
+fn op_for<T: Scalar>(trans: CBLAS_TRANSPOSE) -> Option<Op> {
+    match trans {
+        CblasNoTrans => Some(Op::NoTrans),
+        CblasTrans => Some(Op::Trans),
+        CblasConjTrans if T::IS_COMPLEX => Some(Op::ConjTrans),
+        CblasConjTrans => Some(Op::Trans),
+        CblasConjNoTrans => None,
+    }
+}
+
+#[inline(always)]
+fn apply<T: Scalar>(op: Op, x: T) -> T {
+    if op == Op::ConjTrans {
+        x.conj()
+    } else {
+        x
+    }
+}
+
+/// Column-major `C = alpha * op(A) * op(B) + beta * C` for `m <= LIMIT`.
+///
+/// Each column of C is accumulated in a stack buffer: for `op(A) = A` as an
+/// axpy over contiguous columns of A, otherwise as dot products over
+/// contiguous columns of A. Both inner loops are unit stride.
+#[allow(clippy::too_many_arguments)]
+#[inline(always)]
+unsafe fn gemm_kernel<T: Scalar>(
+    ta: Op,
+    tb: Op,
+    m: usize,
+    n: usize,
+    k: usize,
+    alpha: T,
+    a: *const T,
+    lda: usize,
+    b: *const T,
+    ldb: usize,
+    beta: T,
+    c: *mut T,
+    ldc: usize,
+) {
+    let mut buf = [T::ZERO; CBLAS_INJECT_SMALL_GEMM_DIM_LIMIT as usize];
+    let acc = &mut buf[..m];
+    let b_at = |l: usize, j: usize| unsafe {
+        match tb {
+            Op::NoTrans => *b.add(l + j * ldb),
+            _ => apply(tb, *b.add(j + l * ldb)),
+        }
+    };
+
+    for j in 0..n {
+        acc.fill(T::ZERO);
+        if !alpha.is_zero() {
+            if ta == Op::NoTrans {
+                for l in 0..k {
+                    let t = alpha * b_at(l, j);
+                    let a_col = unsafe { slice::from_raw_parts(a.add(l * lda), m) };
+                    for (acc_i, &a_il) in acc.iter_mut().zip(a_col) {
+                        *acc_i = *acc_i + a_il * t;
+                    }
+                }
+            } else {
+                for (i, acc_i) in acc.iter_mut().enumerate() {
+                    let a_row = unsafe { slice::from_raw_parts(a.add(i * lda), k) };
+                    let mut sum = T::ZERO;
+                    for (l, &a_li) in a_row.iter().enumerate() {
+                        sum = sum + apply(ta, a_li) * b_at(l, j);
+                    }
+                    *acc_i = alpha * sum;
+                }
+            }
+        }
+
+        let c_col = unsafe { slice::from_raw_parts_mut(c.add(j * ldc), m) };
+        if beta.is_zero() {
+            c_col.copy_from_slice(acc);
+        } else {
+            for (c_ij, &acc_i) in c_col.iter_mut().zip(acc.iter()) {
+                *c_ij = beta * *c_ij + acc_i;
+            }
+        }
+    }
+}
+
+multiversion! {
+    unsafe fn gemm_dispatch<T: Scalar>(
+        ta: Op,
+        tb: Op,
+        m: usize,
+        n: usize,
+        k: usize,
+        alpha: T,
+        a: *const T,
+        lda: usize,
+        b: *const T,
+        ldb: usize,
+        beta: T,
+        c: *mut T,
+        ldc: usize,
+    ) => gemm_kernel
+}
+
+/// Whether a GEMM of this shape is within the crossover and well formed.
+///
+/// `false` means the call must go to the registered provider: the path is
+/// disabled, a dimension is above the crossover, or an argument is invalid
+/// (so that the provider reports it through `xerbla`). Inside a provider
+/// scope that prefers native kernels the crossover is
+/// `CBLAS_INJECT_SMALL_GEMM_DIM_LIMIT`.
+#[allow(clippy::too_many_arguments)]
+#[inline]
+pub(crate) fn small_gemm_eligible<T: Scalar>(
+    order: CBLAS_ORDER,
+    transa: CBLAS_TRANSPOSE,
+    transb: CBLAS_TRANSPOSE,
+    m: i64,
+    n: i64,
+    k: i64,
+    lda: i64,
+    ldb: i64,
+    ldc: i64,
+) -> bool {
+    let mut max_dim = i64::from(SMALL_GEMM_MAX_DIM.load(Ordering::Relaxed));
+    if crate::dispatch::scope_prefers_native() {
+        max_dim = i64::from(CBLAS_INJECT_SMALL_GEMM_DIM_LIMIT);
+    }
+    if max_dim == 0 || m > max_dim || n > max_dim || k > max_dim {
+        return false;
+    }
+    if m < 0 || n < 0 || k < 0 {
+        return false;
+    }
+
+    let (transa, transb, m, n, lda, ldb) = match order {
+        CblasColMajor => (transa, transb, m, n, lda, ldb),
+        CblasRowMajor => (transb, transa, n, m, ldb, lda),
+    };
+    let (Some(ta), Some(tb)) = (op_for::<T>(transa), op_for::<T>(transb)) else {
+        return false;
+    };
+    let nrowa = if ta == Op::NoTrans { m } else { k };
+    let nrowb = if tb == Op::NoTrans { k } else { n };
+    lda >= nrowa.max(1) && ldb >= nrowb.max(1) && ldc >= m.max(1)
+}
+
+/// Run a GEMM that `small_gemm_eligible` accepted.
+#[allow(clippy::too_many_arguments)]
+#[inline]
+pub(crate) unsafe fn small_gemm<T: Scalar>(
+    order: CBLAS_ORDER,
+    transa: CBLAS_TRANSPOSE,
+    transb: CBLAS_TRANSPOSE,
+    m: i64,
+    n: i64,
+    k: i64,
+    alpha: T,
+    a: *const T,
+    lda: i64,
+    b: *const T,
+    ldb: i64,
+    beta: T,
+    c: *mut T,
+    ldc: i64,
+) {
+    // Row-major: swap A↔B, m↔n, lda↔ldb, TransA↔TransB
+    // Following OpenBLAS: https://github.com/OpenMathLib/OpenBLAS/blob/develop/interface/gemm.c#L489-L537
+    let (transa, transb, m, n, a, lda, b, ldb) = match order {
+        CblasColMajor => (transa, transb, m, n, a, lda, b, ldb),
+        CblasRowMajor => (transb, transa, n, m, b, ldb, a, lda),
+    };
+    let (Some(ta), Some(tb)) = (op_for::<T>(transa), op_for::<T>(transb)) else {
+        return;
+    };
+    if m <= 0 || n <= 0 {
+        return;
+    }
+
+    unsafe {
+        gemm_dispatch(
+            ta,
+            tb,
+            m as usize,
+            n as usize,
+            k as usize,
+            alpha,
+            a,
+            lda as usize,
+            b,
+            ldb as usize,
+            beta,
+            c,
+            ldc as usize,
+        );
+    }
+}
+
+/// Run the GEMM natively if it is within the crossover and well formed.
+///
+/// Returns `false` when the call must go to the registered provider; see
+/// `small_gemm_eligible`.
+#[allow(clippy::too_many_arguments)]
+#[inline]
+pub(crate) unsafe fn try_small_gemm<T: Scalar>(
+    order: CBLAS_ORDER,
+    transa: CBLAS_TRANSPOSE,
+    transb: CBLAS_TRANSPOSE,
+    m: i64,
+    n: i64,
+    k: i64,
+    alpha: T,
+    a: *const T,
+    lda: i64,
+    b: *const T,
+    ldb: i64,
+    beta: T,
+    c: *mut T,
+    ldc: i64,
+) -> bool {
+    if !small_gemm_eligible::<T>(order, transa, transb, m, n, k, lda, ldb, ldc) {
+        return false;
+    }
+    unsafe {
+        small_gemm(
+            order, transa, transb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc,
+        );
+    }
+    true
+}
@@ -0,0 +1,137 @@
+//! Built-in kernels that bypass the registered Fortran provider.
+//!
+//! The kernels are plain Rust loops laid out so that LLVM vectorizes them.
+//! Each entry point is compiled once per instruction set (AVX-512F, AVX2+FMA,
+//! and the target baseline, which already includes NEON on aarch64) and the
+//! variant is chosen once at runtime from CPU feature detection.
+
+use std::ops::{Add, Mul};
+use std::sync::OnceLock;
+
+use num_complex::{Complex32, Complex64};
+
+/// Instruction set a multiversioned kernel runs with.
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub(crate) enum Isa {
+    Baseline,
+    #[cfg(target_arch = "x86_64")]
+    Avx2,
+    #[cfg(target_arch = "x86_64")]
+    Avx512,
+}
+
+static ISA: OnceLock<Isa> = OnceLock::new();
+
+fn detect_isa() -> Isa {
+    #[cfg(target_arch = "x86_64")]
+    {
+        let avx2 = is_x86_feature_detected!("avx2") && is_x86_feature_detected!("fma");
+        if avx2 && is_x86_feature_detected!("avx512f") {
+            return Isa::Avx512;
+        }
+        if avx2 {
+            return Isa::Avx2;
+        }
+    }
+    Isa::Baseline
+}
+
+#[inline]
+pub(crate) fn isa() -> Isa {
+    *ISA.get_or_init(detect_isa)
+}
+
+/// Element type accepted by the native kernels.
+pub(crate) trait Scalar: Copy + Add<Output = Self> + Mul<Output = Self> {
+    const ZERO: Self;
+    const IS_COMPLEX: bool;
+
+    fn conj(self) -> Self;
+    fn is_zero(self) -> bool;
+}
+
+macro_rules! impl_real_scalar {
+    ($t:ty) => {
+        impl Scalar for $t {
+            const ZERO: Self = 0.0;
+            const IS_COMPLEX: bool = false;
+
+            #[inline(always)]
+            fn conj(self) -> Self {
+                self
+            }
+
+            #[inline(always)]
+            fn is_zero(self) -> bool {
+                self == 0.0
+            }
+        }
+    };
+}
+
+macro_rules! impl_complex_scalar {
+    ($t:ty) => {
+        impl Scalar for $t {
+            const ZERO: Self = <$t>::new(0.0, 0.0);
+            const IS_COMPLEX: bool = true;
+
+            #[inline(always)]
+            fn conj(self) -> Self {
+                <$t>::new(self.re, -self.im)
+            }
+
+            #[inline(always)]
+            fn is_zero(self) -> bool {
+                self.re == 0.0 && self.im == 0.0
+            }
+        }
+    };
+}
+
+impl_real_scalar!(f32);
+impl_real_scalar!(f64);
+impl_complex_scalar!(Complex32);
+impl_complex_scalar!(Complex64);
+
+/// Define `$name`, which runs the `#[inline(always)]` kernel `$kernel`
+/// compiled for the ISA reported by [`isa`].
+macro_rules! multiversion {
+    (
+        $vis:vis unsafe fn $name:ident<$t:ident: $bound:path>($($arg:ident: $ty:ty),* $(,)?)
+            $(-> $ret:ty)? => $kernel:path
+    ) => {
+        #[allow(clippy::too_many_arguments)]
+        $vis unsafe fn $name<$t: $bound>($($arg: $ty),*) $(-> $ret)? {
+            #[cfg(target_arch = "x86_64")]
+            {
+                #[target_feature(enable = "avx512f,avx2,fma")]
+                #[allow(clippy::too_many_arguments)]
+                unsafe fn avx512<$t: $bound>($($arg: $ty),*) $(-> $ret)? {
+                    unsafe { $kernel($($arg),*) }
+                }
+
+                #[target_feature(enable = "avx2,fma")]
+                #[allow(clippy::too_many_arguments)]
+                unsafe fn avx2<$t: $bound>($($arg: $ty),*) $(-> $ret)? {
+                    unsafe { $kernel($($arg),*) }
+                }
+
+                match crate::native::isa() {
+                    crate::native::Isa::Avx512 => return unsafe { avx512($($arg),*) },
+                    crate::native::Isa::Avx2 => return unsafe { avx2($($arg),*) },
+                    crate::native::Isa::Baseline => {}
+                }
+            }
+            unsafe { $kernel($($arg),*) }
+        }
+    };
+}
+
+pub(crate) use multiversion;
+
+pub(crate) mod blas1;
+pub(crate) mod conj;
+pub(crate) mod gemm;
+pub(crate) mod pack;
+pub(crate) mod tbsm;
+pub(crate) mod transpose;
@@ -0,0 +1,212 @@
+//! Native conversion between dense and packed or band storage for the
+//! `cblas_inject_?pack_*` / `cblas_inject_?unpack_*` entry points.
+//!
+//! The compact storage is column-major here: a row-major packed or band
+//! matrix is the column-major one of the transpose, with uplo flipped or
+//! `kl` and `ku` swapped, exactly as the Level 2 wrappers pass it on. Column
+//! j of the compact matrix holds a contiguous run of rows of dense column j.
+//! When the dense matrix is column-major in that frame, each run is a plain
+//! column copy. Otherwise the dense columns are its rows and the copy walks
+//! both sides in `TILE x TILE` tiles, as the transposes in `transpose` do,
+//! so the dense rows touched by one tile stay in L1 while it is done.
+
+use crate::native::{multiversion, Scalar};
+
+/// Edge of the square tiles a transposing conversion is done in.
+const TILE: usize = 32;
+
+/// Compact storage of an n-column matrix, column-major.
+#[derive(Clone, Copy, Debug)]
+pub(crate) enum Shape {
+    /// Packed upper triangle of an `n x n` matrix.
+    Upper { n: usize },
+    /// Packed lower triangle of an `n x n` matrix.
+    Lower { n: usize },
+    /// `kl` sub- and `ku` superdiagonals of an `m x n` matrix, in columns of
+    /// `ldab >= kl + ku + 1` elements.
+    Band {
+        m: usize,
+        n: usize,
+        kl: usize,
+        ku: usize,
+        ldab: usize,
+    },
+}
+
+impl Shape {
+    #[inline(always)]
+    fn cols(self) -> usize {
+        match self {
+            Shape::Upper { n } | Shape::Lower { n } | Shape::Band { n, .. } => n,
+        }
+    }
+
+    /// Rows `lo..hi` of column j that are stored, and the offset of row i's
+    /// element from the start of the compact array.
+    #[inline(always)]
+    fn stored(self, j: usize) -> (usize, usize, usize) {
+        match self {
+            Shape::Upper { .. } => (0, j + 1, j * (j + 1) / 2),
+            Shape::Lower { n } => (j, n, j * (2 * n - j - 1) / 2),
+            Shape::Band {
+                m, kl, ku, ldab, ..
+            } => {
+                let hi = m.min(j + kl + 1);
+                (j.saturating_sub(ku).min(hi), hi, j * ldab + ku - j)
+            }
+        }
+    }
+
+    /// Rows of dense column j that are written when unpacking: the triangle
+    /// for packed storage and the whole column for a band, whose elements
+    /// outside the band are zero.
+    #[inline(always)]
+    fn unpacked(self, j: usize) -> (usize, usize) {
+        match self {
+            Shape::Band { m, .. } => (0, m),
+            _ => {
+                let (lo, hi, _) = self.stored(j);
+                (lo, hi)
+            }
+        }
+    }
+
+    /// Rows of dense column j a conversion touches. Both ends never decrease
+    /// with j.
+    #[inline(always)]
+    fn touched<const UNPACK: bool>(self, j: usize) -> (usize, usize) {
+        if UNPACK {
+            self.unpacked(j)
+        } else {
+            let (lo, hi, _) = self.stored(j);
+            (lo, hi)
+        }
+    }
+}
+
+/// Convert rows `i0..i1` of column j between the dense `a` and the compact
+/// `p`. The source is only read.
+#[inline(always)]
+unsafe fn column<T: Scalar, const UNPACK: bool, const ACROSS: bool>(
+    shape: Shape,
+    j: usize,
+    i0: usize,
+    i1: usize,
+    a: *mut T,
+    lda: usize,
+    p: *mut T,
+) {
+    let dense = |i: usize| unsafe {
+        if ACROSS {
+            a.add(j + i * lda)
+        } else {
+            a.add(i + j * lda)
+        }
+    };
+    let (lo, hi, offset) = shape.stored(j);
+    let (lo, hi) = (lo.clamp(i0, i1), hi.clamp(i0, i1));
+    if UNPACK {
+        let (fill_lo, fill_hi) = shape.unpacked(j);
+        for i in fill_lo.clamp(i0, i1)..lo {
+            unsafe { *dense(i) = T::ZERO };
+        }
+        for i in lo..hi {
+            unsafe { *dense(i) = *p.add(offset + i) };
+        }
+        for i in hi..fill_hi.clamp(i0, i1) {
+            unsafe { *dense(i) = T::ZERO };
+        }
+    } else {
+        for i in lo..hi {
+            unsafe { *p.add(offset + i) = *dense(i) };
+        }
+    }
+}
+
+#[inline(always)]
+unsafe fn convert_loop<T: Scalar, const UNPACK: bool, const ACROSS: bool>(
+    shape: Shape,
+    a: *mut T,
+    lda: usize,
+    p: *mut T,
+) {
+    let cols = shape.cols();
+    if !ACROSS {
+        for j in 0..cols {
+            let (i0, i1) = shape.touched::<UNPACK>(j);
+            unsafe { column::<T, UNPACK, ACROSS>(shape, j, i0, i1, a, lda, p) };
+        }
+        return;
+    }
+    for j0 in (0..cols).step_by(TILE) {
+        let j1 = (j0 + TILE).min(cols);
+        // Only the rows some column of the block touches; for a narrow band
+        // that is a few tiles rather than all of them.
+        let (first, _) = shape.touched::<UNPACK>(j0);
+        let (_, last) = shape.touched::<UNPACK>(j1 - 1);
+        for i0 in (first..last).step_by(TILE) {
+            let i1 = (i0 + TILE).min(last);
+            for j in j0..j1 {
+                unsafe { column::<T, UNPACK, ACROSS>(shape, j, i0, i1, a, lda, p) };
+            }
+        }
+    }
+}
+
+#[inline(always)]
+unsafe fn convert_kernel<T: Scalar>(
+    shape: Shape,
+    unpack: bool,
+    across: bool,
+    a: *mut T,
+    lda: usize,
+    p: *mut T,
+) {
+    unsafe {
+        match (unpack, across) {
+            (false, false) => convert_loop::<T, false, false>(shape, a, lda, p),
+            (false, true) => convert_loop::<T, false, true>(shape, a, lda, p),
+            (true, false) => convert_loop::<T, true, false>(shape, a, lda, p),
+            (true, true) => convert_loop::<T, true, true>(shape, a, lda, p),
+        }
+    }
+}
+
+multiversion! {
+    unsafe fn convert_dispatch<T: Scalar>(
+        shape: Shape,
+        unpack: bool,
+        across: bool,
+        a: *mut T,
+        lda: usize,
+        p: *mut T,
+    ) => convert_kernel
+}
+
+/// Copy the stored part of the dense `a` into the compact `p`. The dense
+/// matrix is column-major with leading dimension `lda`, or row-major when
+/// `across` is set.
+///
+/// The caller has checked the arguments against `shape`.
+pub(crate) unsafe fn pack<T: Scalar>(
+    shape: Shape,
+    across: bool,
+    a: *const T,
+    lda: usize,
+    p: *mut T,
+) {
+    unsafe { convert_dispatch(shape, false, across, a.cast_mut(), lda, p) }
+}
+
+/// Copy the compact `p` into the dense `a`, laid out as for [`pack`],
+/// zeroing the elements of a band matrix outside the band. The other
+/// triangle of a packed matrix is left as it is.
+pub(crate) unsafe fn unpack<T: Scalar>(
+    shape: Shape,
+    across: bool,
+    p: *const T,
+    a: *mut T,
+    lda: usize,
+) {
+    unsafe { convert_dispatch(shape, true, across, a, lda, p.cast_mut()) }
+}
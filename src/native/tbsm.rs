@@ -0,0 +1,118 @@
+//! Native triangular band solve with several right-hand sides, for the
+//! `?tbsv` calls that `cblas_inject_begin_coalesce` groups.
+//!
+//! BLAS has no band counterpart of `?trsm`, so a group of `?tbsv` calls on
+//! one matrix is solved here instead. The band is column-major (a row-major
+//! call arrives with uplo and the transpose flipped, as the Level 2 wrappers
+//! pass it on), and the right-hand sides are the columns of an
+//! `n x nrhs` row-major block, so every band element is read once and
+//! applied to a contiguous row of `nrhs` values.
+
+use std::ops::{Div, Sub};
+
+use crate::native::{multiversion, Scalar};
+
+/// Element type of the band solve.
+pub(crate) trait Solve: Scalar + Sub<Output = Self> + Div<Output = Self> {}
+
+impl<T: Scalar + Sub<Output = T> + Div<Output = T>> Solve for T {}
+
+/// Solve `op(A) * X = B` in place, B being the `n x nrhs` row-major block
+/// at `x`. A is the triangular band with `k` off-diagonals above (`upper`)
+/// or below the diagonal, column-major with leading dimension `lda`;
+/// `trans` transposes it and `conj` conjugates it. The operations are those
+/// of the reference `?tbsv`, applied to each right-hand side, including its
+/// skip of column `j` in the untransposed case when `x_j` is zero.
+#[inline(always)]
+#[allow(clippy::too_many_arguments)]
+unsafe fn tbsm_kernel<T: Solve>(
+    upper: bool,
+    trans: bool,
+    conj: bool,
+    unit: bool,
+    n: usize,
+    k: usize,
+    a: *const T,
+    lda: usize,
+    x: *mut T,
+    nrhs: usize,
+) {
+    let at = |i: usize, j: usize| {
+        let offset = if upper { k + i - j } else { i - j };
+        let v = unsafe { *a.add(offset + j * lda) };
+        if conj {
+            v.conj()
+        } else {
+            v
+        }
+    };
+    let row = |i: usize| unsafe { std::slice::from_raw_parts_mut(x.add(i * nrhs), nrhs) };
+    let divide = |j: usize| {
+        if !unit {
+            let d = at(j, j);
+            for v in row(j) {
+                if trans || !v.is_zero() {
+                    *v = *v / d;
+                }
+            }
+        }
+    };
+    // x_i -= a * x_j over every right-hand side, for i != j.
+    let update = |i: usize, a: T, j: usize| {
+        let (xi, xj) = (row(i), row(j));
+        for r in 0..nrhs {
+            if trans || !xj[r].is_zero() {
+                xi[r] = xi[r] - a * xj[r];
+            }
+        }
+    };
+    match (upper, trans) {
+        (true, false) => {
+            for j in (0..n).rev() {
+                divide(j);
+                for i in j.saturating_sub(k)..j {
+                    update(i, at(i, j), j);
+                }
+            }
+        }
+        (false, false) => {
+            for j in 0..n {
+                divide(j);
+                for i in j + 1..n.min(j + k + 1) {
+                    update(i, at(i, j), j);
+                }
+            }
+        }
+        (true, true) => {
+            for j in 0..n {
+                for i in j.saturating_sub(k)..j {
+                    update(j, at(i, j), i);
+                }
+                divide(j);
+            }
+        }
+        (false, true) => {
+            for j in (0..n).rev() {
+                for i in j + 1..n.min(j + k + 1) {
+                    update(j, at(i, j), i);
+                }
+                divide(j);
+            }
+        }
+    }
+}
+
+multiversion! {
+    pub(crate) unsafe fn tbsm<T: Solve>(
+        upper: bool,
+        trans: bool,
+        conj: bool,
+        unit: bool,
+        n: usize,
+        k: usize,
+        a: *const T,
+        lda: usize,
+        x: *mut T,
+        nrhs: usize,
+    ) => tbsm_kernel
+}
@@ -0,0 +1,302 @@
+//! Native scaled matrix copy and transpose for `?omatcopy` / `?imatcopy`.
+//!
+//! Matrices are column-major here; the CBLAS wrappers map row-major calls by
+//! swapping `rows` and `cols`. A transpose reads A down its columns and
+//! writes B across its rows, so it walks both in `TILE x TILE` tiles: the
+//! columns of A and of B touched by one tile stay in L1 while it is done.
+//! In the tile loops the scaling and conjugation are compile-time choices,
+//! leaving LLVM a plain multiply-and-store loop to vectorize.
+//!
+//! In place, a square transpose with `lda == ldb` swaps mirrored tiles. Any
+//! other in-place transpose goes through a contiguous copy of A in the
+//! thread's scratch buffer, and a non-transposing copy with `lda != ldb`
+//! moves the columns in the order in which no unread element is overwritten.
+
+use crate::native::{multiversion, Scalar};
+use crate::scratch::{self, ScratchElem};
+
+/// Edge of the square tiles a transpose is done in.
+const TILE: usize = 32;
+
+#[inline(always)]
+fn scaled<T: Scalar, const CONJ: bool>(alpha: T, v: T) -> T {
+    if CONJ {
+        alpha * v.conj()
+    } else {
+        alpha * v
+    }
+}
+
+/// Zero the `rows x cols` B; alpha = 0 must not read A, which may hold NaN.
+#[inline(always)]
+unsafe fn zero_loop<T: Scalar>(rows: usize, cols: usize, b: *mut T, ldb: usize) {
+    for j in 0..cols {
+        let b = unsafe { b.add(j * ldb) };
+        for i in 0..rows {
+            unsafe { *b.add(i) = T::ZERO };
+        }
+    }
+}
+
+/// `B = alpha * op(A)` for the `rows x cols` A, without transposing.
+#[inline(always)]
+unsafe fn copy_loop<T: Scalar, const CONJ: bool>(
+    rows: usize,
+    cols: usize,
+    alpha: T,
+    a: *const T,
+    lda: usize,
+    b: *mut T,
+    ldb: usize,
+) {
+    for j in 0..cols {
+        let (a, b) = unsafe { (a.add(j * lda), b.add(j * ldb)) };
+        for i in 0..rows {
+            unsafe { *b.add(i) = scaled::<T, CONJ>(alpha, *a.add(i)) };
+        }
+    }
+}
+
+/// `B = alpha * op(A)^T` for the `rows x cols` A; B is `cols x rows`.
+#[inline(always)]
+unsafe fn transpose_loop<T: Scalar, const CONJ: bool>(
+    rows: usize,
+    cols: usize,
+    alpha: T,
+    a: *const T,
+    lda: usize,
+    b: *mut T,
+    ldb: usize,
+) {
+    for j0 in (0..cols).step_by(TILE) {
+        let j1 = (j0 + TILE).min(cols);
+        for i0 in (0..rows).step_by(TILE) {
+            let i1 = (i0 + TILE).min(rows);
+            for j in j0..j1 {
+                let a = unsafe { a.add(j * lda) };
+                for i in i0..i1 {
+                    unsafe { *b.add(j + i * ldb) = scaled::<T, CONJ>(alpha, *a.add(i)) };
+                }
+            }
+        }
+    }
+}
+
+/// `A = alpha * op(A)^T` for the square `n x n` A.
+#[inline(always)]
+unsafe fn square_transpose_loop<T: Scalar, const CONJ: bool>(
+    n: usize,
+    alpha: T,
+    a: *mut T,
+    lda: usize,
+) {
+    // Tile (i0, j0) on or above the diagonal swaps with its mirror; the
+    // diagonal tiles only swap their upper and lower halves.
+    for j0 in (0..n).step_by(TILE) {
+        let j1 = (j0 + TILE).min(n);
+        for i0 in (0..=j0).step_by(TILE) {
+            let i1 = (i0 + TILE).min(n);
+            for j in j0..j1 {
+                for i in i0..i1.min(j + 1) {
+                    unsafe {
+                        let (p, q) = (a.add(i + j * lda), a.add(j + i * lda));
+                        let (u, l) = (*p, *q);
+                        *p = scaled::<T, CONJ>(alpha, l);
+                        *q = scaled::<T, CONJ>(alpha, u);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/// In-place `A = alpha * op(A)` that changes the leading dimension from `lda`
+/// to `ldb`.
+#[inline(always)]
+unsafe fn copy_in_place_loop<T: Scalar, const CONJ: bool>(
+    rows: usize,
+    cols: usize,
+    alpha: T,
+    a: *mut T,
+    lda: usize,
+    ldb: usize,
+) {
+    if ldb <= lda {
+        // Every destination is at or before its source.
+        unsafe { copy_loop::<T, CONJ>(rows, cols, alpha, a, lda, a, ldb) };
+    } else {
+        // Every destination is at or after its source: walk backwards.
+        for j in (0..cols).rev() {
+            let (src, dst) = unsafe { (a.add(j * lda), a.add(j * ldb)) };
+            for i in (0..rows).rev() {
+                unsafe { *dst.add(i) = scaled::<T, CONJ>(alpha, *src.add(i)) };
+            }
+        }
+    }
+}
+
+#[inline(always)]
+#[allow(clippy::too_many_arguments)]
+unsafe fn omatcopy_kernel<T: Scalar>(
+    rows: usize,
+    cols: usize,
+    alpha: T,
+    trans: bool,
+    conj: bool,
+    a: *const T,
+    lda: usize,
+    b: *mut T,
+    ldb: usize,
+) {
+    if alpha.is_zero() {
+        let (rows, cols) = if trans { (cols, rows) } else { (rows, cols) };
+        return unsafe { zero_loop(rows, cols, b, ldb) };
+    }
+    unsafe {
+        match (trans, conj) {
+            (false, false) => copy_loop::<T, false>(rows, cols, alpha, a, lda, b, ldb),
+            (false, true) => copy_loop::<T, true>(rows, cols, alpha, a, lda, b, ldb),
+            (true, false) => transpose_loop::<T, false>(rows, cols, alpha, a, lda, b, ldb),
+            (true, true) => transpose_loop::<T, true>(rows, cols, alpha, a, lda, b, ldb),
+        }
+    }
+}
+
+#[inline(always)]
+unsafe fn imatcopy_square_kernel<T: Scalar>(n: usize, alpha: T, conj: bool, a: *mut T, lda: usize) {
+    unsafe {
+        if conj {
+            square_transpose_loop::<T, true>(n, alpha, a, lda)
+        } else {
+            square_transpose_loop::<T, false>(n, alpha, a, lda)
+        }
+    }
+}
+
+#[inline(always)]
+unsafe fn imatcopy_copy_kernel<T: Scalar>(
+    rows: usize,
+    cols: usize,
+    alpha: T,
+    conj: bool,
+    a: *mut T,
+    lda: usize,
+    ldb: usize,
+) {
+    unsafe {
+        if conj {
+            copy_in_place_loop::<T, true>(rows, cols, alpha, a, lda, ldb)
+        } else {
+            copy_in_place_loop::<T, false>(rows, cols, alpha, a, lda, ldb)
+        }
+    }
+}
+
+multiversion! {
+    unsafe fn omatcopy_dispatch<T: Scalar>(
+        rows: usize,
+        cols: usize,
+        alpha: T,
+        trans: bool,
+        conj: bool,
+        a: *const T,
+        lda: usize,
+        b: *mut T,
+        ldb: usize,
+    ) => omatcopy_kernel
+}
+
+multiversion! {
+    unsafe fn imatcopy_square_dispatch<T: Scalar>(
+        n: usize,
+        alpha: T,
+        conj: bool,
+        a: *mut T,
+        lda: usize,
+    ) => imatcopy_square_kernel
+}
+
+multiversion! {
+    unsafe fn imatcopy_copy_dispatch<T: Scalar>(
+        rows: usize,
+        cols: usize,
+        alpha: T,
+        conj: bool,
+        a: *mut T,
+        lda: usize,
+        ldb: usize,
+    ) => imatcopy_copy_kernel
+}
+
+/// Column-major `B = alpha * op(A)` for the `rows x cols` A, where op
+/// transposes when `trans` is set and conjugates when `conj` is set.
+///
+/// The caller has checked the arguments: `lda >= rows` and `ldb` covers the
+/// rows of op(A).
+#[allow(clippy::too_many_arguments)]
+pub(crate) unsafe fn omatcopy<T: Scalar>(
+    rows: i64,
+    cols: i64,
+    alpha: T,
+    trans: bool,
+    conj: bool,
+    a: *const T,
+    lda: i64,
+    b: *mut T,
+    ldb: i64,
+) {
+    if rows <= 0 || cols <= 0 {
+        return;
+    }
+    unsafe {
+        omatcopy_dispatch(
+            rows as usize,
+            cols as usize,
+            alpha,
+            trans,
+            conj,
+            a,
+            lda as usize,
+            b,
+            ldb as usize,
+        )
+    }
+}
+
+/// Column-major in-place `A = alpha * op(A)` for the `rows x cols` A, stored
+/// with leading dimension `lda` on entry and `ldb` on return.
+///
+/// The caller has checked the arguments as for [`omatcopy`].
+#[allow(clippy::too_many_arguments)]
+pub(crate) unsafe fn imatcopy<T: Scalar + ScratchElem>(
+    rows: i64,
+    cols: i64,
+    alpha: T,
+    trans: bool,
+    conj: bool,
+    a: *mut T,
+    lda: i64,
+    ldb: i64,
+) {
+    if rows <= 0 || cols <= 0 {
+        return;
+    }
+    let (rows, cols, lda, ldb) = (rows as usize, cols as usize, lda as usize, ldb as usize);
+    unsafe {
+        if alpha.is_zero() {
+            let (rows, cols) = if trans { (cols, rows) } else { (rows, cols) };
+            omatcopy_dispatch(rows, cols, alpha, false, false, a, ldb, a, ldb);
+        } else if !trans {
+            imatcopy_copy_dispatch(rows, cols, alpha, conj, a, lda, ldb);
+        } else if rows == cols && lda == ldb {
+            imatcopy_square_dispatch(rows, alpha, conj, a, lda);
+        } else {
+            let mut copy = scratch::take::<T>(rows * cols);
+            for j in 0..cols {
+                copy[j * rows..(j + 1) * rows]
+                    .copy_from_slice(std::slice::from_raw_parts(a.add(j * lda), rows));
+            }
+            omatcopy_dispatch(rows, cols, alpha, true, conj, copy.as_ptr(), rows, a, ldb);
+        }
+    }
+}
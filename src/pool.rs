@@ -0,0 +1,219 @@
+//! Persistent worker pool for cblas-inject's own parallel drivers.
+//!
+//! Only used for work that cblas-inject splits itself (e.g. the items of a
+//! batched GEMM), which pays off when the registered provider is
+//! single-threaded. The pool is sized with `cblas_inject_set_worker_threads`
+//! and is off by default. Workers are spawned on first use and never exit.
+//!
+//! One job runs at a time. A job submitted while another is running (from a
+//! different host thread, or from inside a task) runs inline on the caller,
+//! so nested use cannot deadlock.
+//!
+//! A panicking task does not take its worker down: the panic is caught, the
+//! remaining indices are abandoned, and it is resumed on the submitting
+//! thread once every worker has left the job.
+
+use std::any::Any;
+use std::panic::{self, AssertUnwindSafe};
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::sync::{Condvar, Mutex, MutexGuard};
+
+use crate::backend::{CBLAS_INJECT_STATUS_INVALID_ARGUMENT, CBLAS_INJECT_STATUS_OK};
+
+/// Configured number of threads, including the caller; 0 and 1 run inline.
+static WORKER_THREADS: AtomicUsize = AtomicUsize::new(0);
+
+/// Set the number of threads cblas-inject uses for its own parallel work.
+///
+/// The count includes the calling thread. 0 or 1 (the default) keeps all
+/// work on the caller. Returns `CBLAS_INJECT_STATUS_INVALID_ARGUMENT` for a
+/// negative count.
+#[no_mangle]
+pub extern "C" fn cblas_inject_set_worker_threads(threads: i32) -> i32 {
+    let Ok(threads) = usize::try_from(threads) else {
+        return CBLAS_INJECT_STATUS_INVALID_ARGUMENT;
+    };
+    WORKER_THREADS.store(threads, Ordering::Relaxed);
+    CBLAS_INJECT_STATUS_OK
+}
+
+/// Number of threads configured with `cblas_inject_set_worker_threads`.
+#[no_mangle]
+pub extern "C" fn cblas_inject_worker_threads() -> i32 {
+    i32::try_from(WORKER_THREADS.load(Ordering::Relaxed)).unwrap_or(i32::MAX)
+}
+
+type Task<'a> = dyn Fn(usize) + Sync + 'a;
+
+/// A running job. `task` borrows from the submitting stack frame, which
+/// does not return before every worker that picked the job up is done.
+#[derive(Clone, Copy)]
+struct Job {
+    task: *const Task<'static>,
+    len: usize,
+    width: usize,
+}
+
+unsafe impl Send for Job {}
+
+struct State {
+    job: Option<Job>,
+    generation: u64,
+    busy: usize,
+    spawned: usize,
+    /// First panic raised by a worker during the current job.
+    panic: Option<Box<dyn Any + Send>>,
+}
+
+struct Pool {
+    state: Mutex<State>,
+    wake: Condvar,
+    idle: Condvar,
+    submit: Mutex<()>,
+    next: AtomicUsize,
+}
+
+static POOL: Pool = Pool {
+    state: Mutex::new(State {
+        job: None,
+        generation: 0,
+        busy: 0,
+        spawned: 0,
+        panic: None,
+    }),
+    wake: Condvar::new(),
+    idle: Condvar::new(),
+    submit: Mutex::new(()),
+    next: AtomicUsize::new(0),
+};
+
+pub(crate) fn lock<T>(mutex: &Mutex<T>) -> MutexGuard<'_, T> {
+    match mutex.lock() {
+        Ok(guard) => guard,
+        Err(poisoned) => poisoned.into_inner(),
+    }
+}
+
+pub(crate) fn wait<'a, T>(cv: &Condvar, guard: MutexGuard<'a, T>) -> MutexGuard<'a, T> {
+    match cv.wait(guard) {
+        Ok(guard) => guard,
+        Err(poisoned) => poisoned.into_inner(),
+    }
+}
+
+/// Claim and run indices of `task` until none are left.
+fn drain(task: &Task<'_>, len: usize) {
+    // With the nested guard on, a threaded provider called from a task must
+    // not start its own threads on top of the pool's.
+    let _threads = crate::threads::pool_job();
+    loop {
+        let i = POOL.next.fetch_add(1, Ordering::Relaxed);
+        if i >= len {
+            return;
+        }
+        task(i);
+    }
+}
+
+/// [`drain`], catching a panic so the caller can still leave the job. The
+/// indices nobody claimed yet are skipped.
+fn drain_caught(task: &Task<'_>, len: usize) -> Result<(), Box<dyn Any + Send>> {
+    panic::catch_unwind(AssertUnwindSafe(|| drain(task, len))).inspect_err(|_| {
+        POOL.next.store(len, Ordering::Relaxed);
+    })
+}
+
+fn worker_main(id: usize) {
+    let mut seen = 0;
+    loop {
+        let job = {
+            let mut state = lock(&POOL.state);
+            loop {
+                if state.generation != seen {
+                    seen = state.generation;
+                    if let Some(job) = state.job {
+                        // Slot 0 is the submitting thread.
+                        if id < job.width {
+                            state.busy += 1;
+                            break job;
+                        }
+                    }
+                }
+                state = wait(&POOL.wake, state);
+            }
+        };
+
+        let result = drain_caught(unsafe { &*job.task }, job.len);
+
+        let mut state = lock(&POOL.state);
+        if let Err(payload) = result {
+            state.panic.get_or_insert(payload);
+        }
+        state.busy -= 1;
+        if state.busy == 0 {
+            POOL.idle.notify_all();
+        }
+    }
+}
+
+/// Spawn workers until `wanted` exist; returns how many are available.
+fn ensure_workers(state: &mut State, wanted: usize) -> usize {
+    while state.spawned < wanted {
+        let id = state.spawned + 1;
+        let spawned = std::thread::Builder::new()
+            .name(format!("cblas-inject-{id}"))
+            .spawn(move || worker_main(id));
+        if spawned.is_err() {
+            break;
+        }
+        state.spawned += 1;
+    }
+    state.spawned
+}
+
+/// Configured thread count for parallel drivers (at least 1).
+#[inline]
+pub(crate) fn worker_threads() -> usize {
+    WORKER_THREADS.load(Ordering::Relaxed).max(1)
+}
+
+/// Run `task(i)` for every `i` in `0..len`, spread across the pool.
+pub(crate) fn parallel_for(len: usize, task: &Task<'_>) {
+    let threads = worker_threads().min(len);
+    let submit = if threads > 1 {
+        POOL.submit.try_lock().ok()
+    } else {
+        None
+    };
+    let Some(_submit) = submit else {
+        (0..len).for_each(task);
+        return;
+    };
+
+    {
+        let mut state = lock(&POOL.state);
+        let width = threads.min(ensure_workers(&mut state, threads - 1) + 1);
+        POOL.next.store(0, Ordering::Relaxed);
+        // Erase the borrow's lifetime; see `Job`.
+        let task: *const Task<'static> =
+            unsafe { std::mem::transmute::<&Task<'_>, &'static Task<'static>>(task) };
+        state.job = Some(Job { task, len, width });
+        state.generation += 1;
+    }
+    POOL.wake.notify_all();
+
+    // The workers borrow `task`, so even a panic here waits for them.
+    let result = drain_caught(task, len);
+
+    let mut state = lock(&POOL.state);
+    while state.busy > 0 {
+        state = wait(&POOL.idle, state);
+    }
+    state.job = None;
+    let payload = result.err().or_else(|| state.panic.take());
+    state.panic = None;
+    drop(state);
+    if let Some(payload) = payload {
+        panic::resume_unwind(payload);
+    }
+}
@@ -0,0 +1,423 @@
+//! Bulk provider registration: whole shared libraries and C tables.
+//!
+//! `cblas_inject_load_provider(path, abi)` opens a Fortran BLAS library once,
+//! resolves the symbol of every routine under a single suffix (`dgemm_`, or
+//! `dgemm_64_` / `dgemm_64` / `dgemm_` for ILP64), detects the
+//! complex-return convention from `zdotc`, and registers everything it
+//! found in one pass, along with the library's thread-count controls
+//! (`openblas_set_num_threads` and the like). Slots that were already
+//! registered keep their provider, as with the per-routine registration
+//! functions.
+//!
+//! `CBLAS_INJECT_PROVIDER=path` (with `CBLAS_INJECT_PROVIDER_ABI=ilp64` for
+//! 64-bit integer libraries) does the same on the first call that finds a
+//! routine unregistered. The lookup only runs on that cold path, so
+//! registered providers pay nothing for it.
+//!
+//! `cblas_inject_register_table(table, size)` registers a caller-filled
+//! [`CblasInjectProviderTable`], one pointer per routine, under a single
+//! acquisition of the registration lock, and can finalize the dispatch table
+//! before releasing it.
+
+use std::ffi::{c_char, c_int, c_void, CStr, OsStr, OsString};
+use std::sync::atomic::{AtomicBool, Ordering};
+use std::sync::{Once, OnceLock};
+
+use num_complex::Complex64;
+
+use crate::backend::*;
+use crate::types::ComplexReturnStyle;
+
+/// `abi` value for providers with 32-bit integers (`dgemm_`).
+pub const CBLAS_INJECT_ABI_LP64: c_int = 32;
+/// `abi` value for providers with 64-bit integers (`dgemm_64_`).
+pub const CBLAS_INJECT_ABI_ILP64: c_int = 64;
+
+/// Environment variable naming a provider library to load on first use.
+const PROVIDER_ENV: &str = "CBLAS_INJECT_PROVIDER";
+/// `lp64` (the default) or `ilp64`.
+const PROVIDER_ABI_ENV: &str = "CBLAS_INJECT_PROVIDER_ABI";
+
+/// Version of the [`CblasInjectProviderTable`] layout.
+pub const CBLAS_INJECT_PROVIDER_TABLE_VERSION: u32 = 1;
+/// `flags` bit: finalize the dispatch table after registering, under the same
+/// lock acquisition.
+pub const CBLAS_INJECT_PROVIDER_TABLE_FINALIZE: u32 = 1;
+/// `flags` bit for `cblas_inject_push_provider_scope`: inside the scope,
+/// routines with built-in kernels use them at every size they support.
+pub const CBLAS_INJECT_PROVIDER_TABLE_NATIVE: u32 = 2;
+
+type RegisterFn = unsafe extern "C" fn(*const c_void) -> i32;
+
+/// Fortran routine name and its two registration entry points.
+struct Slot {
+    name: &'static str,
+    lp64: RegisterFn,
+    ilp64: RegisterFn,
+}
+
+impl Slot {
+    unsafe fn register(&self, abi: c_int, f: *const c_void) -> i32 {
+        unsafe {
+            if abi == CBLAS_INJECT_ABI_ILP64 {
+                (self.ilp64)(f)
+            } else {
+                (self.lp64)(f)
+            }
+        }
+    }
+}
+
+/// Registered by the loader only once the complex-return convention is known.
+const COMPLEX_DOTS: [&str; 4] = ["cdotu", "zdotu", "cdotc", "zdotc"];
+
+macro_rules! define_provider_table {
+    ($($name:ident)*) => {
+        paste::paste! {
+            /// Provider pointers for every routine, registered in one call.
+            ///
+            /// Null slots are skipped. New routines are only ever appended,
+            /// so the `size` passed with the table tells which slots the
+            /// caller knows about.
+            #[repr(C)]
+            #[derive(Clone, Copy, Debug)]
+            pub struct CblasInjectProviderTable {
+                /// `CBLAS_INJECT_PROVIDER_TABLE_VERSION`.
+                pub version: u32,
+                /// `CBLAS_INJECT_ABI_LP64` or `CBLAS_INJECT_ABI_ILP64`.
+                pub abi: c_int,
+                /// `CBLAS_INJECT_PROVIDER_TABLE_*` bits.
+                pub flags: u32,
+                pub reserved: u32,
+                /// Null, or room for `CBLAS_INJECT_PROVIDER_TABLE_SLOTS`
+                /// statuses, written in slot order.
+                pub status: *mut i32,
+                $(pub $name: *const c_void,)*
+            }
+
+            const SLOTS: &[Slot] = &[$(Slot {
+                name: stringify!($name),
+                lp64: [<cblas_inject_register_ $name _lp64>],
+                ilp64: [<cblas_inject_register_ $name _ilp64>],
+            },)*];
+
+            impl CblasInjectProviderTable {
+                fn slots(&self) -> [*const c_void; CBLAS_INJECT_PROVIDER_TABLE_SLOTS] {
+                    [$(self.$name,)*]
+                }
+
+                fn slots_mut(&mut self) -> [&mut *const c_void; CBLAS_INJECT_PROVIDER_TABLE_SLOTS] {
+                    [$(&mut self.$name,)*]
+                }
+            }
+        }
+    };
+}
+
+define_provider_table! {
+    sswap dswap cswap zswap scopy dcopy ccopy zcopy
+    saxpy daxpy caxpy zaxpy sscal dscal cscal zscal csscal zdscal
+    srot drot srotg drotg srotm drotm srotmg drotmg scabs1 dcabs1
+    sdot ddot sdsdot dsdot snrm2 dnrm2 scnrm2 dznrm2
+    sasum dasum scasum dzasum isamax idamax icamax izamax
+    sgemv dgemv cgemv zgemv sgbmv dgbmv cgbmv zgbmv
+    ssymv dsymv chemv zhemv ssbmv dsbmv chbmv zhbmv
+    strmv dtrmv ctrmv ztrmv strsv dtrsv ctrsv ztrsv
+    stbmv dtbmv ctbmv ztbmv stbsv dtbsv ctbsv ztbsv
+    sger dger cgeru cgerc zgeru zgerc ssyr dsyr cher zher ssyr2 dsyr2 cher2 zher2
+    sspmv dspmv chpmv zhpmv stpmv dtpmv ctpmv ztpmv stpsv dtpsv ctpsv ztpsv
+    sspr dspr chpr zhpr sspr2 dspr2 chpr2 zhpr2
+    sgemm dgemm cgemm zgemm ssymm dsymm csymm zsymm chemm zhemm
+    ssyrk dsyrk csyrk zsyrk cherk zherk ssyr2k dsyr2k csyr2k zsyr2k cher2k zher2k
+    strmm dtrmm ctrmm ztrmm strsm dtrsm ctrsm ztrsm
+    cdotu zdotu cdotc zdotc
+    cgemm3m zgemm3m sgemmt dgemmt cgemmt zgemmt
+    somatcopy domatcopy comatcopy zomatcopy simatcopy dimatcopy cimatcopy zimatcopy
+    saxpby daxpby caxpby zaxpby
+}
+
+/// Number of routine slots in [`CblasInjectProviderTable`].
+pub const CBLAS_INJECT_PROVIDER_TABLE_SLOTS: usize = 162;
+
+/// Bytes before the first routine slot.
+const TABLE_HEADER_SIZE: usize = 16 + std::mem::size_of::<*mut i32>();
+
+impl CblasInjectProviderTable {
+    /// Copy a caller's table of `size` bytes; slots past `size` are null.
+    /// `None` for a null `table` or a `size` smaller than the header.
+    ///
+    /// # Safety
+    ///
+    /// `table` must be null or point to `size` readable bytes.
+    pub(crate) unsafe fn read(table: *const Self, size: usize) -> Option<Self> {
+        if table.is_null() || size < TABLE_HEADER_SIZE {
+            return None;
+        }
+        let mut copy = Self::empty(0);
+        let len = size.min(std::mem::size_of::<Self>());
+        // Safety: the caller provides `size` readable bytes.
+        unsafe {
+            std::ptr::copy_nonoverlapping(
+                table.cast::<u8>(),
+                std::ptr::addr_of_mut!(copy).cast::<u8>(),
+                len,
+            );
+        }
+        Some(copy)
+    }
+
+    fn empty(abi: c_int) -> Self {
+        // Safety: every field is an integer or a raw pointer, so all-zero is
+        // a valid table with every slot null.
+        let mut table: Self = unsafe { std::mem::zeroed() };
+        table.version = CBLAS_INJECT_PROVIDER_TABLE_VERSION;
+        table.abi = abi;
+        table
+    }
+}
+
+/// Register every non-null slot of `table` under one lock acquisition.
+///
+/// Fills `status` in slot order and returns `CBLAS_INJECT_STATUS_OK`, or the
+/// status of the first slot that failed.
+unsafe fn register_table(table: &CblasInjectProviderTable, status: &mut [i32]) -> i32 {
+    let _guard = registration_guard();
+    let mut result = CBLAS_INJECT_STATUS_OK;
+    for ((slot, f), status) in SLOTS.iter().zip(table.slots()).zip(status) {
+        *status = if f.is_null() {
+            CBLAS_INJECT_STATUS_NULL_POINTER
+        } else {
+            let s = unsafe { slot.register(table.abi, f) };
+            if result == CBLAS_INJECT_STATUS_OK {
+                result = s;
+            }
+            s
+        };
+    }
+    if table.flags & CBLAS_INJECT_PROVIDER_TABLE_FINALIZE != 0 {
+        let finalized = crate::dispatch::finalize_locked();
+        if result == CBLAS_INJECT_STATUS_OK {
+            result = finalized;
+        }
+    }
+    result
+}
+
+type ZdotcHiddenFn<I> = unsafe extern "C" fn(
+    *mut Complex64,
+    *const I,
+    *const Complex64,
+    *const I,
+    *const Complex64,
+    *const I,
+);
+
+/// Detect the complex-return convention by calling `zdotc` with `n = 0`.
+///
+/// The call uses the hidden-argument signature with the result slot preset
+/// to `-1 - i`. A hidden-argument implementation stores `0` there. A
+/// return-value implementation instead reads `n` from the slot, whose
+/// integer view is `0` (low word of `-1.0`) or negative, and returns
+/// without touching memory, leaving the slot unchanged.
+unsafe fn detect_complex_return_style<I: Default>(zdotc: *const c_void) -> ComplexReturnStyle {
+    let zdotc: ZdotcHiddenFn<I> = unsafe { std::mem::transmute(zdotc) };
+    let marker = Complex64::new(-1.0, -1.0);
+    let mut result = marker;
+    let zero = I::default();
+    let x = [Complex64::new(0.0, 0.0); 2];
+    unsafe { zdotc(&mut result, &zero, x.as_ptr(), &zero, x.as_ptr(), &zero) };
+    if result == marker {
+        ComplexReturnStyle::ReturnValue
+    } else {
+        ComplexReturnStyle::HiddenArgument
+    }
+}
+
+unsafe fn load(path: &OsStr, abi: c_int) -> i32 {
+    let suffixes: &[&str] = match abi {
+        CBLAS_INJECT_ABI_LP64 => &["_"],
+        CBLAS_INJECT_ABI_ILP64 => &["_64_", "_64", "_"],
+        _ => return CBLAS_INJECT_STATUS_INVALID_ARGUMENT,
+    };
+    let Ok(lib) = (unsafe { libloading::Library::new(path) }) else {
+        return CBLAS_INJECT_STATUS_LOAD_FAILED;
+    };
+    let lookup = |name: &str, suffix: &str| -> Option<*const c_void> {
+        let symbol = format!("{name}{suffix}\0");
+        let f = unsafe { lib.get::<*const c_void>(symbol.as_bytes()) }.ok()?;
+        Some(*f).filter(|f| !f.is_null())
+    };
+
+    // Every routine comes from the first suffix that resolves anything, so an
+    // ILP64 lookup never mixes in an LP64 symbol of the same library.
+    let Some(table) = suffixes.iter().find_map(|&suffix| {
+        let mut table = CblasInjectProviderTable::empty(abi);
+        let mut found = false;
+        // A differing style set by the host would make the dot calls unsound.
+        let dots_usable = lookup("zdotc", suffix).is_some_and(|zdotc| {
+            try_set_complex_return_style(unsafe {
+                if abi == CBLAS_INJECT_ABI_ILP64 {
+                    detect_complex_return_style::<BlasInt64>(zdotc)
+                } else {
+                    detect_complex_return_style::<BlasInt32>(zdotc)
+                }
+            })
+        });
+        for (slot, ptr) in SLOTS.iter().zip(table.slots_mut()) {
+            if COMPLEX_DOTS.contains(&slot.name) && !dots_usable {
+                continue;
+            }
+            if let Some(f) = lookup(slot.name, suffix) {
+                *ptr = f;
+                found = true;
+            }
+        }
+        found.then_some(table)
+    }) else {
+        return CBLAS_INJECT_STATUS_LOAD_FAILED;
+    };
+
+    // Already registered slots keep their provider, so their status is moot.
+    let mut status = [CBLAS_INJECT_STATUS_OK; CBLAS_INJECT_PROVIDER_TABLE_SLOTS];
+    unsafe { register_table(&table, &mut status) };
+    unsafe { crate::threads::register_from(|name| lookup(name, "")) };
+
+    // The registered pointers must stay callable for the rest of the process.
+    std::mem::forget(lib);
+    let _ = LOADED_LIBRARY.set(path.to_owned());
+    CBLAS_INJECT_STATUS_OK
+}
+
+/// Path of the first library loaded by [`cblas_inject_load_provider`] or
+/// `CBLAS_INJECT_PROVIDER`.
+static LOADED_LIBRARY: OnceLock<OsString> = OnceLock::new();
+
+pub(crate) fn loaded_library() -> Option<&'static OsStr> {
+    LOADED_LIBRARY.get().map(OsString::as_os_str)
+}
+
+/// Load every Fortran BLAS routine exported by the shared library at `path`.
+///
+/// `abi` is `CBLAS_INJECT_ABI_LP64` or `CBLAS_INJECT_ABI_ILP64`. Routines the
+/// library does not export, and slots that already have a provider, are left
+/// as they are; the library stays loaded for the rest of the process.
+///
+/// Returns `CBLAS_INJECT_STATUS_OK` if any routine was found,
+/// `CBLAS_INJECT_STATUS_NULL_POINTER` for a null `path`,
+/// `CBLAS_INJECT_STATUS_INVALID_ARGUMENT` for an unknown `abi`, and
+/// `CBLAS_INJECT_STATUS_LOAD_FAILED` if the library cannot be opened or
+/// exports no BLAS symbol.
+///
+/// # Safety
+///
+/// `path` must be null or a NUL-terminated string. The library's symbols
+/// must have the Fortran BLAS signatures for the given `abi`.
+#[no_mangle]
+pub unsafe extern "C" fn cblas_inject_load_provider(path: *const c_char, abi: c_int) -> i32 {
+    if path.is_null() {
+        return CBLAS_INJECT_STATUS_NULL_POINTER;
+    }
+    let path = unsafe { CStr::from_ptr(path) }
+        .to_string_lossy()
+        .into_owned();
+    unsafe { load(path.as_ref(), abi) }
+}
+
+/// Register every non-null slot of a caller-filled provider table.
+///
+/// `size` is `sizeof(cblas_inject_provider_table)` as the caller compiled it;
+/// slots past it are treated as null. All slots are registered under one
+/// acquisition of the registration lock. With
+/// `CBLAS_INJECT_PROVIDER_TABLE_FINALIZE` set in `flags`, the dispatch table
+/// is also finalized before the lock is released, so it is a consistent
+/// snapshot of this table. Complex dot slots use the complex return style
+/// configured beforehand.
+///
+/// Writes one status per slot to `table->status` when it is non-null
+/// (`CBLAS_INJECT_STATUS_NULL_POINTER` for null slots). Returns
+/// `CBLAS_INJECT_STATUS_OK` if every non-null slot was registered (and, when
+/// requested, the table finalized). Otherwise it returns the status of the
+/// first failure, `CBLAS_INJECT_STATUS_NULL_POINTER` for a null `table`, or
+/// `CBLAS_INJECT_STATUS_INVALID_ARGUMENT` for an unknown version, ABI or a
+/// `size` smaller than the header.
+///
+/// # Safety
+///
+/// `table` must be null or point to `size` readable bytes laid out as
+/// [`CblasInjectProviderTable`]. Every non-null slot must be a Fortran
+/// function of that routine for `abi`, callable for the rest of the process.
+#[no_mangle]
+pub unsafe extern "C" fn cblas_inject_register_table(
+    table: *const CblasInjectProviderTable,
+    size: usize,
+) -> i32 {
+    if table.is_null() {
+        return CBLAS_INJECT_STATUS_NULL_POINTER;
+    }
+    let Some(copy) = (unsafe { CblasInjectProviderTable::read(table, size) }) else {
+        return CBLAS_INJECT_STATUS_INVALID_ARGUMENT;
+    };
+    if copy.version != CBLAS_INJECT_PROVIDER_TABLE_VERSION
+        || !matches!(copy.abi, CBLAS_INJECT_ABI_LP64 | CBLAS_INJECT_ABI_ILP64)
+    {
+        return CBLAS_INJECT_STATUS_INVALID_ARGUMENT;
+    }
+    let mut status = [CBLAS_INJECT_STATUS_NULL_POINTER; CBLAS_INJECT_PROVIDER_TABLE_SLOTS];
+    let result = unsafe { register_table(&copy, &mut status) };
+    if !copy.status.is_null() {
+        unsafe {
+            std::ptr::copy_nonoverlapping(status.as_ptr(), copy.status, status.len());
+        }
+    }
+    result
+}
+
+static ENV_LOAD: Once = Once::new();
+static ENV_LOADED: AtomicBool = AtomicBool::new(false);
+
+/// Load the `CBLAS_INJECT_PROVIDER` library once; true if it was loaded.
+#[cold]
+pub(crate) fn load_env_provider() -> bool {
+    ENV_LOAD.call_once(|| {
+        let Some(path) = std::env::var_os(PROVIDER_ENV) else {
+            return;
+        };
+        let abi = match std::env::var(PROVIDER_ABI_ENV).as_deref() {
+            Ok("ilp64") | Ok("ILP64") | Ok("64") => CBLAS_INJECT_ABI_ILP64,
+            _ => CBLAS_INJECT_ABI_LP64,
+        };
+        let status = unsafe { load(&path, abi) };
+        ENV_LOADED.store(status == CBLAS_INJECT_STATUS_OK, Ordering::Release);
+    });
+    ENV_LOADED.load(Ordering::Acquire)
+}
+
+/// Retry a failed lookup of routine `name` once a provider may be available.
+///
+/// With `openblas-lazy` this registers the routine's OpenBLAS symbol first;
+/// otherwise, or if that fails, it loads `CBLAS_INJECT_PROVIDER`.
+#[cold]
+pub(crate) fn resolve_missing<P>(name: &str, lookup: impl Fn() -> Option<P>) -> Option<P> {
+    #[cfg(feature = "openblas-lazy")]
+    if crate::autoregister::register_lazy(name) {
+        if let Some(p) = lookup() {
+            return Some(p);
+        }
+    }
+    #[cfg(not(feature = "openblas-lazy"))]
+    let _ = name;
+    if load_env_provider() {
+        lookup()
+    } else {
+        None
+    }
+}
+
+/// Register `f` as the LP64 provider of routine `name`.
+#[cfg(feature = "openblas-lazy")]
+pub(crate) unsafe fn register_lp64(name: &str, f: *const c_void) -> i32 {
+    match SLOTS.iter().find(|slot| slot.name == name) {
+        Some(slot) => unsafe { slot.register(CBLAS_INJECT_ABI_LP64, f) },
+        None => CBLAS_INJECT_STATUS_INVALID_ARGUMENT,
+    }
+}
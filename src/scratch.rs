@@ -0,0 +1,91 @@
+//! Per-thread reusable scratch buffers.
+//!
+//! Row-major complex Hermitian Level 2 routines need a conjugated copy of `x`
+//! on every call. Taking it from here instead of allocating keeps repeated
+//! calls (e.g. a Lanczos loop) allocation-free once the buffer has grown to
+//! the largest `n` seen on the thread. Coalesced Level 2 calls gather their
+//! vectors into these buffers as well, blocked `?gemmt` computes its
+//! diagonal blocks in them, and in-place `?imatcopy` transposes copy A into
+//! them.
+
+use std::cell::Cell;
+use std::ops::{Deref, DerefMut};
+use std::thread::LocalKey;
+
+use num_complex::{Complex32, Complex64};
+
+pub(crate) trait ScratchElem: Copy + Default + 'static {
+    fn slot() -> &'static LocalKey<Cell<Vec<Self>>>;
+}
+
+macro_rules! impl_scratch_elem {
+    ($t:ty, $slot:ident) => {
+        thread_local! {
+            static $slot: Cell<Vec<$t>> = const { Cell::new(Vec::new()) };
+        }
+
+        impl ScratchElem for $t {
+            #[inline]
+            fn slot() -> &'static LocalKey<Cell<Vec<Self>>> {
+                &$slot
+            }
+        }
+    };
+}
+
+impl_scratch_elem!(f32, F32_SCRATCH);
+impl_scratch_elem!(f64, F64_SCRATCH);
+impl_scratch_elem!(Complex32, COMPLEX32_SCRATCH);
+impl_scratch_elem!(Complex64, COMPLEX64_SCRATCH);
+
+/// A borrowed scratch buffer of `len` elements, returned to the thread on drop.
+///
+/// The contents are unspecified on entry; callers overwrite every element.
+pub(crate) struct Scratch<T: ScratchElem> {
+    buf: Vec<T>,
+    len: usize,
+}
+
+/// Borrow this thread's scratch buffer for `T`, growing it to `len`.
+///
+/// A nested borrow on the same thread gets a fresh buffer, so it is always
+/// safe, just not allocation-free.
+#[inline]
+pub(crate) fn take<T: ScratchElem>(len: usize) -> Scratch<T> {
+    let mut buf = T::slot().try_with(Cell::take).unwrap_or_default();
+    if buf.len() < len {
+        buf.resize(len, T::default());
+    }
+    Scratch { buf, len }
+}
+
+impl<T: ScratchElem> Drop for Scratch<T> {
+    fn drop(&mut self) {
+        let buf = std::mem::take(&mut self.buf);
+        let _ = T::slot().try_with(|slot| {
+            // Keep the larger buffer if a nested borrow returned first.
+            let other = slot.take();
+            slot.set(if other.capacity() > buf.capacity() {
+                other
+            } else {
+                buf
+            });
+        });
+    }
+}
+
+impl<T: ScratchElem> Deref for Scratch<T> {
+    type Target = [T];
+
+    #[inline]
+    fn deref(&self) -> &[T] {
+        &self.buf[..self.len]
+    }
+}
+
+impl<T: ScratchElem> DerefMut for Scratch<T> {
+    #[inline]
+    fn deref_mut(&mut self) -> &mut [T] {
+        &mut self.buf[..self.len]
+    }
+}
@@ -0,0 +1,437 @@
+//! Opt-in call statistics for the BLAS entry points.
+//!
+//! Every `cblas_*` wrapper (both integer widths) is counted by
+//! [`crate::dispatch::enter`]. With statistics off, the default, that costs
+//! one relaxed atomic load and a predicted branch. With
+//! `CBLAS_INJECT_STATS_COUNTS` the call count, flop count and a histogram of
+//! the largest dimension are updated with relaxed atomics;
+//! `CBLAS_INJECT_STATS_TIMING` also records a wall-time histogram.
+//!
+//! Dimensions are those the caller passed, before any row-major swap, so the
+//! numbers describe the application's view of its BLAS use. Calls served by
+//! the native kernels, deferred by `cblas_inject_begin_coalesce`, or made
+//! through the batched GEMM entry points are counted too.
+
+use std::ffi::{c_char, c_int};
+use std::sync::atomic::{AtomicU64, AtomicU8, Ordering};
+use std::time::Instant;
+
+use crate::backend::{CBLAS_INJECT_STATUS_INVALID_ARGUMENT, CBLAS_INJECT_STATUS_OK};
+use crate::coalesce;
+use crate::types::CblasLeft;
+
+/// Statistics disabled (default).
+pub const CBLAS_INJECT_STATS_OFF: i32 = 0;
+/// Record call counts, flops and shape histograms.
+pub const CBLAS_INJECT_STATS_COUNTS: i32 = 1;
+/// Additionally record a wall-time histogram.
+pub const CBLAS_INJECT_STATS_TIMING: i32 = 2;
+
+/// Number of buckets in each histogram.
+pub const CBLAS_INJECT_STATS_BUCKETS: usize = 16;
+
+static MODE: AtomicU8 = AtomicU8::new(CBLAS_INJECT_STATS_OFF as u8);
+
+/// How the dimensions a call is traced with give the points its flop count
+/// scales: `d[i]` are the dims of [`crate::trace::CblasInjectTraceRecord`].
+#[derive(Clone, Copy)]
+enum Points {
+    /// No flops (the rotation setup and `?cabs1`).
+    None,
+    /// `d0`: vectors.
+    N,
+    /// `d0 * d1`: general matrices.
+    Mn,
+    /// `d0 * d0`: square matrices.
+    Nn,
+    /// `d0 * d1 * d2`: gemm.
+    Mnk,
+    /// `d0 * d0 * d1`: rank-k updates and gemmt.
+    Nnk,
+    /// `d0 * d1 * (d0 or d1)` by the side in the first flag.
+    Side,
+    /// `d1 * (d2 + d3 + 1)`: general band.
+    GeBand,
+    /// `d0 * (d1 + 1)`: triangular band.
+    Band,
+    /// `d0 * (2 * d1 + 1)`: symmetric or Hermitian band.
+    SyBand,
+}
+
+impl Points {
+    fn of(self, flags: &[u8], d: [f64; 4]) -> f64 {
+        match self {
+            Points::None => 0.0,
+            Points::N => d[0],
+            Points::Mn => d[0] * d[1],
+            Points::Nn => d[0] * d[0],
+            Points::Mnk => d[0] * d[1] * d[2],
+            Points::Nnk => d[0] * d[0] * d[1],
+            Points::Side => {
+                let left = flags.first() == Some(&(CblasLeft as u8));
+                d[0] * d[1] * if left { d[0] } else { d[1] }
+            }
+            Points::GeBand => d[1] * (d[2] + d[3] + 1.0),
+            Points::Band => d[0] * (d[1] + 1.0),
+            Points::SyBand => d[0] * (2.0 * d[1] + 1.0),
+        }
+    }
+}
+
+macro_rules! define_routines {
+    ($($variant:ident => $name:literal, $points:ident, $flops_per_point:expr;)+) => {
+        /// A `cblas_*` routine; the `_64` symbol shares its entry.
+        #[derive(Clone, Copy, Debug, PartialEq, Eq)]
+        #[repr(usize)]
+        pub(crate) enum Routine {
+            $($variant,)+
+        }
+
+        pub(crate) const ROUTINE_NAMES: &[&[u8]] = &[$(concat!($name, "\0").as_bytes()),+];
+
+        const POINTS: &[Points] = &[$(Points::$points),+];
+
+        /// Real flops per point.
+        const FLOPS_PER_POINT: &[f64] = &[$($flops_per_point),+];
+    };
+}
+
+// Complex multiply-adds count as four real ones.
+define_routines! {
+    // Level 1
+    Srot => "srot", N, 6.0;
+    Drot => "drot", N, 6.0;
+    Srotm => "srotm", N, 6.0;
+    Drotm => "drotm", N, 6.0;
+    Srotg => "srotg", None, 0.0;
+    Drotg => "drotg", None, 0.0;
+    Srotmg => "srotmg", None, 0.0;
+    Drotmg => "drotmg", None, 0.0;
+    Scabs1 => "scabs1", None, 0.0;
+    Dcabs1 => "dcabs1", None, 0.0;
+    Sswap => "sswap", N, 0.0;
+    Dswap => "dswap", N, 0.0;
+    Cswap => "cswap", N, 0.0;
+    Zswap => "zswap", N, 0.0;
+    Scopy => "scopy", N, 0.0;
+    Dcopy => "dcopy", N, 0.0;
+    Ccopy => "ccopy", N, 0.0;
+    Zcopy => "zcopy", N, 0.0;
+    Saxpy => "saxpy", N, 2.0;
+    Daxpy => "daxpy", N, 2.0;
+    Caxpy => "caxpy", N, 8.0;
+    Zaxpy => "zaxpy", N, 8.0;
+    Saxpby => "saxpby", N, 3.0;
+    Daxpby => "daxpby", N, 3.0;
+    Caxpby => "caxpby", N, 14.0;
+    Zaxpby => "zaxpby", N, 14.0;
+    Sscal => "sscal", N, 1.0;
+    Dscal => "dscal", N, 1.0;
+    Cscal => "cscal", N, 6.0;
+    Zscal => "zscal", N, 6.0;
+    Csscal => "csscal", N, 2.0;
+    Zdscal => "zdscal", N, 2.0;
+    Sdot => "sdot", N, 2.0;
+    Ddot => "ddot", N, 2.0;
+    Sdsdot => "sdsdot", N, 2.0;
+    Dsdot => "dsdot", N, 2.0;
+    CdotuSub => "cdotu_sub", N, 8.0;
+    CdotcSub => "cdotc_sub", N, 8.0;
+    ZdotuSub => "zdotu_sub", N, 8.0;
+    ZdotcSub => "zdotc_sub", N, 8.0;
+    Snrm2 => "snrm2", N, 2.0;
+    Dnrm2 => "dnrm2", N, 2.0;
+    Scnrm2 => "scnrm2", N, 4.0;
+    Dznrm2 => "dznrm2", N, 4.0;
+    Sasum => "sasum", N, 1.0;
+    Dasum => "dasum", N, 1.0;
+    Scasum => "scasum", N, 2.0;
+    Dzasum => "dzasum", N, 2.0;
+    Isamax => "isamax", N, 1.0;
+    Idamax => "idamax", N, 1.0;
+    Icamax => "icamax", N, 2.0;
+    Izamax => "izamax", N, 2.0;
+    // Matrix copies
+    Somatcopy => "somatcopy", Mn, 1.0;
+    Domatcopy => "domatcopy", Mn, 1.0;
+    Comatcopy => "comatcopy", Mn, 6.0;
+    Zomatcopy => "zomatcopy", Mn, 6.0;
+    Simatcopy => "simatcopy", Mn, 1.0;
+    Dimatcopy => "dimatcopy", Mn, 1.0;
+    Cimatcopy => "cimatcopy", Mn, 6.0;
+    Zimatcopy => "zimatcopy", Mn, 6.0;
+    // Level 2
+    Sgemv => "sgemv", Mn, 2.0;
+    Dgemv => "dgemv", Mn, 2.0;
+    Cgemv => "cgemv", Mn, 8.0;
+    Zgemv => "zgemv", Mn, 8.0;
+    Sgbmv => "sgbmv", GeBand, 2.0;
+    Dgbmv => "dgbmv", GeBand, 2.0;
+    Cgbmv => "cgbmv", GeBand, 8.0;
+    Zgbmv => "zgbmv", GeBand, 8.0;
+    Ssymv => "ssymv", Nn, 2.0;
+    Dsymv => "dsymv", Nn, 2.0;
+    Chemv => "chemv", Nn, 8.0;
+    Zhemv => "zhemv", Nn, 8.0;
+    Ssbmv => "ssbmv", SyBand, 2.0;
+    Dsbmv => "dsbmv", SyBand, 2.0;
+    Chbmv => "chbmv", SyBand, 8.0;
+    Zhbmv => "zhbmv", SyBand, 8.0;
+    Sspmv => "sspmv", Nn, 2.0;
+    Dspmv => "dspmv", Nn, 2.0;
+    Chpmv => "chpmv", Nn, 8.0;
+    Zhpmv => "zhpmv", Nn, 8.0;
+    Sger => "sger", Mn, 2.0;
+    Dger => "dger", Mn, 2.0;
+    Cgeru => "cgeru", Mn, 8.0;
+    Cgerc => "cgerc", Mn, 8.0;
+    Zgeru => "zgeru", Mn, 8.0;
+    Zgerc => "zgerc", Mn, 8.0;
+    Ssyr => "ssyr", Nn, 1.0;
+    Dsyr => "dsyr", Nn, 1.0;
+    Cher => "cher", Nn, 4.0;
+    Zher => "zher", Nn, 4.0;
+    Ssyr2 => "ssyr2", Nn, 2.0;
+    Dsyr2 => "dsyr2", Nn, 2.0;
+    Cher2 => "cher2", Nn, 8.0;
+    Zher2 => "zher2", Nn, 8.0;
+    Sspr => "sspr", Nn, 1.0;
+    Dspr => "dspr", Nn, 1.0;
+    Chpr => "chpr", Nn, 4.0;
+    Zhpr => "zhpr", Nn, 4.0;
+    Sspr2 => "sspr2", Nn, 2.0;
+    Dspr2 => "dspr2", Nn, 2.0;
+    Chpr2 => "chpr2", Nn, 8.0;
+    Zhpr2 => "zhpr2", Nn, 8.0;
+    Strmv => "strmv", Nn, 1.0;
+    Dtrmv => "dtrmv", Nn, 1.0;
+    Ctrmv => "ctrmv", Nn, 4.0;
+    Ztrmv => "ztrmv", Nn, 4.0;
+    Strsv => "strsv", Nn, 1.0;
+    Dtrsv => "dtrsv", Nn, 1.0;
+    Ctrsv => "ctrsv", Nn, 4.0;
+    Ztrsv => "ztrsv", Nn, 4.0;
+    Stpmv => "stpmv", Nn, 1.0;
+    Dtpmv => "dtpmv", Nn, 1.0;
+    Ctpmv => "ctpmv", Nn, 4.0;
+    Ztpmv => "ztpmv", Nn, 4.0;
+    Stpsv => "stpsv", Nn, 1.0;
+    Dtpsv => "dtpsv", Nn, 1.0;
+    Ctpsv => "ctpsv", Nn, 4.0;
+    Ztpsv => "ztpsv", Nn, 4.0;
+    Stbmv => "stbmv", Band, 2.0;
+    Dtbmv => "dtbmv", Band, 2.0;
+    Ctbmv => "ctbmv", Band, 8.0;
+    Ztbmv => "ztbmv", Band, 8.0;
+    Stbsv => "stbsv", Band, 2.0;
+    Dtbsv => "dtbsv", Band, 2.0;
+    Ctbsv => "ctbsv", Band, 8.0;
+    Ztbsv => "ztbsv", Band, 8.0;
+    // Level 3
+    Sgemm => "sgemm", Mnk, 2.0;
+    Dgemm => "dgemm", Mnk, 2.0;
+    Cgemm => "cgemm", Mnk, 8.0;
+    Zgemm => "zgemm", Mnk, 8.0;
+    Ssymm => "ssymm", Side, 2.0;
+    Dsymm => "dsymm", Side, 2.0;
+    Csymm => "csymm", Side, 8.0;
+    Zsymm => "zsymm", Side, 8.0;
+    Chemm => "chemm", Side, 8.0;
+    Zhemm => "zhemm", Side, 8.0;
+    Ssyrk => "ssyrk", Nnk, 1.0;
+    Dsyrk => "dsyrk", Nnk, 1.0;
+    Csyrk => "csyrk", Nnk, 4.0;
+    Zsyrk => "zsyrk", Nnk, 4.0;
+    Cherk => "cherk", Nnk, 4.0;
+    Zherk => "zherk", Nnk, 4.0;
+    Ssyr2k => "ssyr2k", Nnk, 2.0;
+    Dsyr2k => "dsyr2k", Nnk, 2.0;
+    Csyr2k => "csyr2k", Nnk, 8.0;
+    Zsyr2k => "zsyr2k", Nnk, 8.0;
+    Cher2k => "cher2k", Nnk, 8.0;
+    Zher2k => "zher2k", Nnk, 8.0;
+    Strmm => "strmm", Side, 1.0;
+    Dtrmm => "dtrmm", Side, 1.0;
+    Ctrmm => "ctrmm", Side, 4.0;
+    Ztrmm => "ztrmm", Side, 4.0;
+    Strsm => "strsm", Side, 1.0;
+    Dtrsm => "dtrsm", Side, 1.0;
+    Ctrsm => "ctrsm", Side, 4.0;
+    Ztrsm => "ztrsm", Side, 4.0;
+    Sgemmt => "sgemmt", Nnk, 1.0;
+    Dgemmt => "dgemmt", Nnk, 1.0;
+    Cgemmt => "cgemmt", Nnk, 4.0;
+    Zgemmt => "zgemmt", Nnk, 4.0;
+}
+
+const ROUTINE_COUNT: usize = ROUTINE_NAMES.len();
+
+struct Counters {
+    calls: AtomicU64,
+    flops: AtomicU64,
+    time_ns: AtomicU64,
+    shape_hist: [AtomicU64; CBLAS_INJECT_STATS_BUCKETS],
+    time_hist: [AtomicU64; CBLAS_INJECT_STATS_BUCKETS],
+}
+
+#[allow(clippy::declare_interior_mutable_const)]
+const ZERO: AtomicU64 = AtomicU64::new(0);
+#[allow(clippy::declare_interior_mutable_const)]
+const EMPTY: Counters = Counters {
+    calls: ZERO,
+    flops: ZERO,
+    time_ns: ZERO,
+    shape_hist: [ZERO; CBLAS_INJECT_STATS_BUCKETS],
+    time_hist: [ZERO; CBLAS_INJECT_STATS_BUCKETS],
+};
+
+static COUNTERS: [Counters; ROUTINE_COUNT] = [EMPTY; ROUTINE_COUNT];
+
+/// Statistics for one routine, as returned by `cblas_inject_stats_snapshot`.
+#[repr(C)]
+#[derive(Clone, Copy, Debug)]
+pub struct CblasInjectRoutineStats {
+    /// NUL-terminated routine name without the `cblas_` prefix (e.g. "dgemm").
+    pub name: *const c_char,
+    pub calls: u64,
+    /// Real floating-point operations implied by the dimensions.
+    pub flops: u64,
+    /// Total wall time in nanoseconds (timing mode only).
+    pub time_ns: u64,
+    /// Bucket `b` counts calls whose largest dimension `d` has
+    /// `2^(b-1) <= d < 2^b` (bucket 0 is `d == 0`); the last bucket is open.
+    pub shape_hist: [u64; CBLAS_INJECT_STATS_BUCKETS],
+    /// Bucket `b` counts calls that took `2^(b-1) <= t < 2^b` microseconds
+    /// (bucket 0 is under 1 us); the last bucket is open.
+    pub time_hist: [u64; CBLAS_INJECT_STATS_BUCKETS],
+}
+
+#[inline]
+fn bucket(value: u64) -> usize {
+    ((u64::BITS - value.leading_zeros()) as usize).min(CBLAS_INJECT_STATS_BUCKETS - 1)
+}
+
+/// Records the wall time of a call on drop.
+pub(crate) struct Timer {
+    routine: Routine,
+    start: Instant,
+}
+
+impl Drop for Timer {
+    fn drop(&mut self) {
+        let ns = u64::try_from(self.start.elapsed().as_nanos()).unwrap_or(u64::MAX);
+        let c = &COUNTERS[self.routine as usize];
+        c.time_ns.fetch_add(ns, Ordering::Relaxed);
+        c.time_hist[bucket(ns / 1000)].fetch_add(1, Ordering::Relaxed);
+    }
+}
+
+#[cold]
+#[inline(never)]
+fn record<I: Copy + Into<i64>>(
+    routine: Routine,
+    flags: &[u8],
+    dims: &[I],
+    timing: bool,
+) -> Option<Timer> {
+    if coalesce::flushing() {
+        return None;
+    }
+    let c = &COUNTERS[routine as usize];
+    let mut d = [0.0; 4];
+    let mut max_dim = 0;
+    for (d, &v) in d.iter_mut().zip(dims) {
+        let v = v.into().max(0);
+        *d = v as f64;
+        max_dim = max_dim.max(v as u64);
+    }
+    let points = POINTS[routine as usize].of(flags, d);
+    c.calls.fetch_add(1, Ordering::Relaxed);
+    c.flops.fetch_add(
+        (points * FLOPS_PER_POINT[routine as usize]) as u64,
+        Ordering::Relaxed,
+    );
+    c.shape_hist[bucket(max_dim)].fetch_add(1, Ordering::Relaxed);
+    timing.then(|| Timer {
+        routine,
+        start: Instant::now(),
+    })
+}
+
+/// Count a call to `routine` with the flags and dims it is traced with;
+/// keep the result alive for the whole call.
+#[inline(always)]
+pub(crate) fn count<I: Copy + Into<i64>>(
+    routine: Routine,
+    flags: &[u8],
+    dims: &[I],
+) -> Option<Timer> {
+    match i32::from(MODE.load(Ordering::Relaxed)) {
+        CBLAS_INJECT_STATS_OFF => None,
+        mode => record(routine, flags, dims, mode == CBLAS_INJECT_STATS_TIMING),
+    }
+}
+
+/// Select what is recorded: `CBLAS_INJECT_STATS_OFF`, `_COUNTS` or `_TIMING`.
+///
+/// Returns `CBLAS_INJECT_STATUS_INVALID_ARGUMENT` for any other value.
+/// Counters keep their values across mode changes.
+#[no_mangle]
+pub extern "C" fn cblas_inject_set_stats_mode(mode: i32) -> i32 {
+    if !(CBLAS_INJECT_STATS_OFF..=CBLAS_INJECT_STATS_TIMING).contains(&mode) {
+        return CBLAS_INJECT_STATUS_INVALID_ARGUMENT;
+    }
+    MODE.store(mode as u8, Ordering::Relaxed);
+    CBLAS_INJECT_STATUS_OK
+}
+
+/// Current statistics mode.
+#[no_mangle]
+pub extern "C" fn cblas_inject_stats_mode() -> i32 {
+    i32::from(MODE.load(Ordering::Relaxed))
+}
+
+/// Copy the statistics of up to `len` routines into `out`.
+///
+/// Returns the total number of routines, so a caller can pass
+/// `out = NULL, len = 0` first to size its buffer. Each counter is read
+/// atomically, but a snapshot taken during concurrent calls is not a single
+/// consistent cut.
+///
+/// # Safety
+///
+/// `out` must be valid for writing `len` entries (or `len <= 0`).
+#[no_mangle]
+pub unsafe extern "C" fn cblas_inject_stats_snapshot(
+    out: *mut CblasInjectRoutineStats,
+    len: c_int,
+) -> c_int {
+    let len = usize::try_from(len).unwrap_or(0).min(ROUTINE_COUNT);
+    for (i, c) in COUNTERS.iter().enumerate().take(len) {
+        let load = |a: &AtomicU64| a.load(Ordering::Relaxed);
+        let stats = CblasInjectRoutineStats {
+            name: ROUTINE_NAMES[i].as_ptr().cast(),
+            calls: load(&c.calls),
+            flops: load(&c.flops),
+            time_ns: load(&c.time_ns),
+            shape_hist: c.shape_hist.each_ref().map(load),
+            time_hist: c.time_hist.each_ref().map(load),
+        };
+        unsafe { out.add(i).write(stats) };
+    }
+    ROUTINE_COUNT as c_int
+}
+
+/// Reset every counter to zero.
+#[no_mangle]
+pub extern "C" fn cblas_inject_stats_reset() {
+    for c in &COUNTERS {
+        let all = [&c.calls, &c.flops, &c.time_ns]
+            .into_iter()
+            .chain(&c.shape_hist)
+            .chain(&c.time_hist);
+        for a in all {
+            a.store(0, Ordering::Relaxed);
+        }
+    }
+}
@@ -0,0 +1,379 @@
+//! Provider thread-count control and the nested-parallelism guard.
+//!
+//! Threaded providers size their own thread pools, and cblas-inject cannot
+//! reach those controls through the BLAS symbols. The host (or the library
+//! loader) registers them here instead:
+//!
+//! - a global setter such as `openblas_set_num_threads` or
+//!   `omp_set_num_threads` (`void f(int)`),
+//! - a per-thread setter such as `mkl_set_num_threads_local`
+//!   (`int f(int)`, returning the previous per-thread value),
+//! - a getter such as `openblas_get_num_threads` (`int f(void)`),
+//! - a probe such as `omp_in_parallel` (`int f(void)`) that is nonzero on
+//!   threads that are already part of a parallel region.
+//!
+//! BLIS' `bli_thread_set_num_threads` and `bli_thread_get_num_threads` take
+//! and return a `dim_t` (int64) instead; the library loader registers them
+//! as such, and counts are converted on the way.
+//!
+//! A single-threaded region makes the provider use one thread on the calling
+//! thread until the region ends. With a per-thread setter that is exact;
+//! with only a global setter the provider runs single-threaded for every
+//! caller while any thread is in a region, and the previous count is restored
+//! when the last region ends.
+//!
+//! With the nested guard on, regions are entered automatically: by the jobs
+//! of cblas-inject's own worker pool, and by every `cblas_*` call (through
+//! [`crate::dispatch::enter`]) on threads for which the probe reports a
+//! parallel region.
+
+use std::cell::Cell;
+use std::ffi::{c_int, c_void};
+use std::sync::atomic::{AtomicBool, AtomicI32, Ordering};
+use std::sync::{Mutex, OnceLock};
+
+use crate::backend::{
+    CBLAS_INJECT_STATUS_ALREADY_REGISTERED, CBLAS_INJECT_STATUS_INVALID_ARGUMENT,
+    CBLAS_INJECT_STATUS_NOT_REGISTERED, CBLAS_INJECT_STATUS_NULL_POINTER, CBLAS_INJECT_STATUS_OK,
+};
+
+type SetNumThreadsFn = unsafe extern "C" fn(c_int);
+type SetNumThreadsLocalFn = unsafe extern "C" fn(c_int) -> c_int;
+type QueryFn = unsafe extern "C" fn() -> c_int;
+type SetNumThreadsDimFn = unsafe extern "C" fn(i64);
+type QueryDimFn = unsafe extern "C" fn() -> i64;
+
+/// A global thread-count setter, taking an `int` or a BLIS `dim_t`.
+#[derive(Clone, Copy)]
+enum Setter {
+    Int(SetNumThreadsFn),
+    Dim(SetNumThreadsDimFn),
+}
+
+impl Setter {
+    unsafe fn set(self, threads: c_int) {
+        match self {
+            Setter::Int(f) => unsafe { f(threads) },
+            Setter::Dim(f) => unsafe { f(i64::from(threads)) },
+        }
+    }
+}
+
+/// A thread-count getter, returning an `int` or a BLIS `dim_t`.
+#[derive(Clone, Copy)]
+enum Getter {
+    Int(QueryFn),
+    Dim(QueryDimFn),
+}
+
+impl Getter {
+    unsafe fn get(self) -> c_int {
+        match self {
+            Getter::Int(f) => unsafe { f() },
+            Getter::Dim(f) => c_int::try_from(unsafe { f() }).unwrap_or(c_int::MAX),
+        }
+    }
+}
+
+static SET_NUM_THREADS: OnceLock<Setter> = OnceLock::new();
+static SET_NUM_THREADS_LOCAL: OnceLock<SetNumThreadsLocalFn> = OnceLock::new();
+static GET_NUM_THREADS: OnceLock<Getter> = OnceLock::new();
+static IN_PARALLEL: OnceLock<QueryFn> = OnceLock::new();
+
+/// Count last passed to `cblas_inject_set_num_threads`; 0 if never called.
+static NUM_THREADS: AtomicI32 = AtomicI32::new(0);
+static NESTED_GUARD: AtomicBool = AtomicBool::new(false);
+
+/// Threads inside a region that went through the global setter, and the
+/// count to restore when the last of them leaves.
+struct GlobalRegions {
+    depth: usize,
+    restore: c_int,
+}
+
+static GLOBAL_REGIONS: Mutex<GlobalRegions> = Mutex::new(GlobalRegions {
+    depth: 0,
+    restore: 0,
+});
+
+/// How the outermost region on this thread was applied.
+#[derive(Clone, Copy)]
+enum Applied {
+    /// Through the per-thread setter, which returned this previous value.
+    Local(c_int),
+    /// Through the global setter.
+    Global,
+}
+
+thread_local! {
+    static DEPTH: Cell<u32> = const { Cell::new(0) };
+    static APPLIED: Cell<Applied> = const { Cell::new(Applied::Global) };
+}
+
+fn global_regions() -> std::sync::MutexGuard<'static, GlobalRegions> {
+    match GLOBAL_REGIONS.lock() {
+        Ok(guard) => guard,
+        Err(poisoned) => poisoned.into_inner(),
+    }
+}
+
+unsafe fn register<F: Copy>(slot: &OnceLock<F>, f: *const c_void) -> i32 {
+    unsafe { register_as(slot, f, |f: F| f) }
+}
+
+/// Register `f` as a function of type `F`, stored in the slot as `wrap(f)`.
+unsafe fn register_as<F: Copy, S>(
+    slot: &OnceLock<S>,
+    f: *const c_void,
+    wrap: impl FnOnce(F) -> S,
+) -> i32 {
+    if f.is_null() {
+        return CBLAS_INJECT_STATUS_NULL_POINTER;
+    }
+    // Safety: the caller passes a function of signature `F`.
+    let f = unsafe { std::mem::transmute_copy::<*const c_void, F>(&f) };
+    match slot.set(wrap(f)) {
+        Ok(()) => CBLAS_INJECT_STATUS_OK,
+        Err(_) => CBLAS_INJECT_STATUS_ALREADY_REGISTERED,
+    }
+}
+
+/// Register the provider's global thread-count setter, `void f(int)`.
+///
+/// # Safety
+///
+/// `f` must be such a function, callable from any thread for the rest of
+/// the process.
+#[no_mangle]
+pub unsafe extern "C" fn cblas_inject_register_set_num_threads(f: *const c_void) -> i32 {
+    unsafe { register_as(&SET_NUM_THREADS, f, Setter::Int) }
+}
+
+/// Register the provider's per-thread setter, `int f(int)`, which returns
+/// the previous per-thread value (0 meaning the global count).
+///
+/// # Safety
+///
+/// As for [`cblas_inject_register_set_num_threads`].
+#[no_mangle]
+pub unsafe extern "C" fn cblas_inject_register_set_num_threads_local(f: *const c_void) -> i32 {
+    unsafe { register(&SET_NUM_THREADS_LOCAL, f) }
+}
+
+/// Register the provider's thread-count getter, `int f(void)`.
+///
+/// # Safety
+///
+/// As for [`cblas_inject_register_set_num_threads`].
+#[no_mangle]
+pub unsafe extern "C" fn cblas_inject_register_get_num_threads(f: *const c_void) -> i32 {
+    unsafe { register_as(&GET_NUM_THREADS, f, Getter::Int) }
+}
+
+/// Register a probe, `int f(void)`, that is nonzero on threads already
+/// running inside a parallel region (e.g. `omp_in_parallel`).
+///
+/// # Safety
+///
+/// As for [`cblas_inject_register_set_num_threads`].
+#[no_mangle]
+pub unsafe extern "C" fn cblas_inject_register_parallel_probe(f: *const c_void) -> i32 {
+    unsafe { register(&IN_PARALLEL, f) }
+}
+
+/// Register whichever thread controls the library exports, looked up by
+/// unsuffixed symbol name. Slots that are already registered are kept.
+pub(crate) unsafe fn register_from(lookup: impl Fn(&str) -> Option<*const c_void>) {
+    let first = |names: &[&str]| names.iter().find_map(|name| lookup(name));
+    unsafe {
+        if let Some(f) = first(&["openblas_set_num_threads", "mkl_set_num_threads"]) {
+            register_as(&SET_NUM_THREADS, f, Setter::Int);
+        } else if let Some(f) = lookup("bli_thread_set_num_threads") {
+            register_as(&SET_NUM_THREADS, f, Setter::Dim);
+        }
+        if let Some(f) = first(&["mkl_set_num_threads_local"]) {
+            register(&SET_NUM_THREADS_LOCAL, f);
+        }
+        if let Some(f) = first(&["openblas_get_num_threads", "mkl_get_max_threads"]) {
+            register_as(&GET_NUM_THREADS, f, Getter::Int);
+        } else if let Some(f) = lookup("bli_thread_get_num_threads") {
+            register_as(&GET_NUM_THREADS, f, Getter::Dim);
+        }
+    }
+}
+
+/// Set the provider's global thread count through the registered setter.
+///
+/// While a single-threaded region that uses the global setter is active, the
+/// count takes effect when the last such region ends. Returns
+/// `CBLAS_INJECT_STATUS_INVALID_ARGUMENT` for a count below 1 and
+/// `CBLAS_INJECT_STATUS_NOT_REGISTERED` without a global setter.
+#[no_mangle]
+pub extern "C" fn cblas_inject_set_num_threads(threads: i32) -> i32 {
+    if threads < 1 {
+        return CBLAS_INJECT_STATUS_INVALID_ARGUMENT;
+    }
+    let Some(&set) = SET_NUM_THREADS.get() else {
+        return CBLAS_INJECT_STATUS_NOT_REGISTERED;
+    };
+    let mut regions = global_regions();
+    NUM_THREADS.store(threads, Ordering::Relaxed);
+    if regions.depth > 0 {
+        regions.restore = threads;
+    } else {
+        unsafe { set.set(threads) };
+    }
+    CBLAS_INJECT_STATUS_OK
+}
+
+/// The provider's thread count: the registered getter's answer, else the
+/// last count set with `cblas_inject_set_num_threads`, else 0 (unknown).
+#[no_mangle]
+pub extern "C" fn cblas_inject_num_threads() -> i32 {
+    match GET_NUM_THREADS.get() {
+        Some(&get) => unsafe { get.get() },
+        None => NUM_THREADS.load(Ordering::Relaxed),
+    }
+}
+
+/// Count the global setter should return to once no region needs it. Without
+/// a getter or an earlier count, assume the usual default of one thread per
+/// core.
+fn current_global_count() -> c_int {
+    match cblas_inject_num_threads() {
+        0 => std::thread::available_parallelism()
+            .map_or(1, |n| c_int::try_from(n.get()).unwrap_or(c_int::MAX)),
+        n => n,
+    }
+}
+
+/// Enter a region on this thread; false if no setter is registered.
+fn begin() -> bool {
+    let depth = DEPTH.with(Cell::get);
+    if depth > 0 {
+        DEPTH.with(|d| d.set(depth + 1));
+        return true;
+    }
+    let applied = if let Some(&local) = SET_NUM_THREADS_LOCAL.get() {
+        Applied::Local(unsafe { local(1) })
+    } else if let Some(&set) = SET_NUM_THREADS.get() {
+        let mut regions = global_regions();
+        if regions.depth == 0 {
+            regions.restore = current_global_count();
+            unsafe { set.set(1) };
+        }
+        regions.depth += 1;
+        Applied::Global
+    } else {
+        return false;
+    };
+    APPLIED.with(|a| a.set(applied));
+    DEPTH.with(|d| d.set(1));
+    true
+}
+
+/// Leave a region on this thread; false if none is active.
+fn end() -> bool {
+    let depth = DEPTH.with(Cell::get);
+    if depth == 0 {
+        return false;
+    }
+    DEPTH.with(|d| d.set(depth - 1));
+    if depth > 1 {
+        return true;
+    }
+    match APPLIED.with(Cell::get) {
+        Applied::Local(previous) => {
+            if let Some(&local) = SET_NUM_THREADS_LOCAL.get() {
+                unsafe { local(previous) };
+            }
+        }
+        Applied::Global => {
+            let mut regions = global_regions();
+            regions.depth -= 1;
+            if regions.depth == 0 {
+                if let Some(&set) = SET_NUM_THREADS.get() {
+                    unsafe { set.set(regions.restore) };
+                }
+            }
+        }
+    }
+    true
+}
+
+/// Make the provider single-threaded on the calling thread until the
+/// matching `cblas_inject_end_single_threaded`. Regions nest.
+///
+/// Returns `CBLAS_INJECT_STATUS_NOT_REGISTERED` (and enters no region) when
+/// neither a per-thread nor a global setter is registered.
+#[no_mangle]
+pub extern "C" fn cblas_inject_begin_single_threaded() -> i32 {
+    if begin() {
+        CBLAS_INJECT_STATUS_OK
+    } else {
+        CBLAS_INJECT_STATUS_NOT_REGISTERED
+    }
+}
+
+/// End the innermost single-threaded region of the calling thread.
+///
+/// Returns `CBLAS_INJECT_STATUS_INVALID_ARGUMENT` if the thread is not in one.
+#[no_mangle]
+pub extern "C" fn cblas_inject_end_single_threaded() -> i32 {
+    if end() {
+        CBLAS_INJECT_STATUS_OK
+    } else {
+        CBLAS_INJECT_STATUS_INVALID_ARGUMENT
+    }
+}
+
+/// Turn the nested-parallelism guard on (nonzero) or off (0, the default).
+#[no_mangle]
+pub extern "C" fn cblas_inject_set_nested_guard(on: i32) -> i32 {
+    NESTED_GUARD.store(on != 0, Ordering::Relaxed);
+    CBLAS_INJECT_STATUS_OK
+}
+
+/// Whether the nested-parallelism guard is on.
+#[no_mangle]
+pub extern "C" fn cblas_inject_nested_guard() -> i32 {
+    i32::from(NESTED_GUARD.load(Ordering::Relaxed))
+}
+
+/// Ends the region it was created for on drop.
+pub(crate) struct SingleThreaded(());
+
+impl Drop for SingleThreaded {
+    fn drop(&mut self) {
+        end();
+    }
+}
+
+/// A region for a job of the worker pool, when the nested guard is on.
+#[inline]
+pub(crate) fn pool_job() -> Option<SingleThreaded> {
+    if !NESTED_GUARD.load(Ordering::Relaxed) {
+        return None;
+    }
+    begin().then_some(SingleThreaded(()))
+}
+
+#[cold]
+#[inline(never)]
+fn probe_region() -> Option<SingleThreaded> {
+    let &probe = IN_PARALLEL.get()?;
+    if DEPTH.with(Cell::get) > 0 || unsafe { probe() } == 0 {
+        return None;
+    }
+    begin().then_some(SingleThreaded(()))
+}
+
+/// A region for one provider call, when the nested guard is on and the
+/// probe reports that the caller is already in a parallel region.
+#[inline(always)]
+pub(crate) fn call() -> Option<SingleThreaded> {
+    if !NESTED_GUARD.load(Ordering::Relaxed) {
+        return None;
+    }
+    probe_region()
+}
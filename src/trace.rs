@@ -0,0 +1,445 @@
+//! Binary call-trace recorder for the BLAS entry points.
+//!
+//! While a trace is active every `cblas_*` wrapper appends one fixed-size
+//! [`CblasInjectTraceRecord`] to a per-thread buffer when it returns. A full
+//! buffer is written to the trace file in one batch, so the calling thread
+//! takes the file lock once every [`RECORDS_PER_FLUSH`] calls;
+//! `cblas_inject_trace_stop` drains every thread's buffer and closes the
+//! file. With tracing off, the default, a wrapper pays one relaxed atomic
+//! load, and so does each provider lookup.
+//!
+//! The record is started by [`crate::dispatch::enter`]. Its path is the one
+//! of the last provider lookup made during the call (the getters report it
+//! through [`lp64_provider`] and [`ilp64_provider`]), or whatever the code
+//! serving the call reports with [`dispatched`]; a call that looks up no
+//! provider is recorded as native.
+//!
+//! A trace starts with `cblas_inject_trace_start(path)`, or at the first
+//! call when `CBLAS_INJECT_TRACE` names a file; an environment-started trace
+//! is flushed at process exit.
+//!
+//! File layout (native endianness): a [`CblasInjectTraceHeader`], then
+//! `routine_count` NUL-padded names of `name_len` bytes indexed by
+//! [`CblasInjectTraceRecord::routine`], then the records. Records from
+//! different threads are grouped by flush, not sorted; order them by
+//! `timestamp_ns` to recover the global interleaving.
+
+use std::cell::Cell;
+use std::ffi::{c_char, c_int, CStr};
+use std::fs::File;
+use std::io::{BufWriter, Write};
+use std::sync::atomic::{AtomicU32, AtomicU64, AtomicU8, Ordering};
+use std::sync::{Arc, Mutex, MutexGuard, Once, OnceLock};
+use std::time::Instant;
+use std::{mem, slice};
+
+use crate::backend::{
+    ProviderAbi, CBLAS_INJECT_STATUS_IO_ERROR, CBLAS_INJECT_STATUS_NULL_POINTER,
+    CBLAS_INJECT_STATUS_OK,
+};
+use crate::coalesce;
+use crate::stats::{self, Routine};
+
+/// Served by a built-in kernel; no provider was called.
+pub const CBLAS_INJECT_TRACE_PATH_NATIVE: u8 = 0;
+/// LP64 symbol dispatched to an LP64 provider.
+pub const CBLAS_INJECT_TRACE_PATH_LP64: u8 = 1;
+/// `_64` symbol dispatched to an ILP64 provider.
+pub const CBLAS_INJECT_TRACE_PATH_ILP64: u8 = 2;
+/// LP64 symbol widened to an ILP64 provider.
+pub const CBLAS_INJECT_TRACE_PATH_WIDENED: u8 = 3;
+/// `_64` symbol narrowed to an LP64 provider.
+pub const CBLAS_INJECT_TRACE_PATH_NARROWED: u8 = 4;
+/// Deferred by `cblas_inject_begin_coalesce`; the group is run at a flush.
+pub const CBLAS_INJECT_TRACE_PATH_DEFERRED: u8 = 5;
+
+/// First eight bytes of every trace file.
+pub const CBLAS_INJECT_TRACE_MAGIC: [u8; 8] = *b"CBITRACE";
+/// Version of the layout described by [`CblasInjectTraceHeader`].
+pub const CBLAS_INJECT_TRACE_VERSION: u32 = 2;
+/// Size of each routine name slot following the header.
+pub const CBLAS_INJECT_TRACE_NAME_LEN: usize = 16;
+
+/// Records buffered per thread before they are written out.
+pub(crate) const RECORDS_PER_FLUSH: usize = 4096;
+
+/// Environment variable naming a file to trace into from the first call.
+const TRACE_ENV: &str = "CBLAS_INJECT_TRACE";
+
+/// Start of a trace file.
+#[repr(C)]
+#[derive(Clone, Copy, Debug)]
+pub struct CblasInjectTraceHeader {
+    pub magic: [u8; 8],
+    pub version: u32,
+    /// `sizeof(cblas_inject_trace_record)`.
+    pub record_size: u32,
+    pub routine_count: u32,
+    pub name_len: u32,
+}
+
+/// One traced call, as the caller passed it (before any row-major swap).
+///
+/// Each field lists the routine's arguments of one kind in signature order,
+/// with unused slots zero: `flags` the CBLAS enum values after `order` (e.g.
+/// `side, uplo, trans, diag` for trsm), `dims` the sizes (`m, n, k`; `m, n,
+/// kl, ku` for gbmv; `n, k` for the band and rank-k routines; `rows, cols`
+/// for the matrix copies) and `lds` the leading dimensions and increments
+/// (`lda, incx, incy` for gemv, `incx, incy` for axpy). `order` is zero for
+/// the Level 1 routines, which take none.
+#[repr(C)]
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub struct CblasInjectTraceRecord {
+    /// Nanoseconds since the trace started.
+    pub timestamp_ns: u64,
+    /// Small per-thread id, assigned in order of each thread's first record.
+    pub thread: u32,
+    /// Index into the routine names following the header.
+    pub routine: u16,
+    /// One of `CBLAS_INJECT_TRACE_PATH_*`.
+    pub path: u8,
+    /// `CblasRowMajor`, `CblasColMajor`, or 0 without an order argument.
+    pub order: u8,
+    pub flags: [u8; 4],
+    pub reserved: u32,
+    pub dims: [i64; 4],
+    pub lds: [i64; 3],
+}
+
+/// How a traced call was dispatched.
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+#[repr(u8)]
+pub(crate) enum Path {
+    Native = CBLAS_INJECT_TRACE_PATH_NATIVE,
+    Lp64 = CBLAS_INJECT_TRACE_PATH_LP64,
+    Ilp64 = CBLAS_INJECT_TRACE_PATH_ILP64,
+    Widened = CBLAS_INJECT_TRACE_PATH_WIDENED,
+    Narrowed = CBLAS_INJECT_TRACE_PATH_NARROWED,
+    Deferred = CBLAS_INJECT_TRACE_PATH_DEFERRED,
+}
+
+impl Path {
+    /// Path of an LP64 symbol whose provider is ILP64 when `ilp64_provider`.
+    #[inline(always)]
+    pub(crate) fn lp64(ilp64_provider: bool) -> Self {
+        if ilp64_provider {
+            Path::Widened
+        } else {
+            Path::Lp64
+        }
+    }
+
+    /// Path of a `_64` symbol whose provider is ILP64 when `ilp64_provider`.
+    #[inline(always)]
+    pub(crate) fn ilp64(ilp64_provider: bool) -> Self {
+        if ilp64_provider {
+            Path::Ilp64
+        } else {
+            Path::Narrowed
+        }
+    }
+}
+
+const UNINIT: u8 = 0;
+const OFF: u8 = 1;
+const ON: u8 = 2;
+
+static STATE: AtomicU8 = AtomicU8::new(UNINIT);
+static ENV_INIT: Once = Once::new();
+
+/// Monotonic origin for timestamps; a trace stores its start as an offset.
+static EPOCH: OnceLock<Instant> = OnceLock::new();
+static START_NS: AtomicU64 = AtomicU64::new(0);
+static NEXT_THREAD: AtomicU32 = AtomicU32::new(0);
+
+struct Sink {
+    file: BufWriter<File>,
+    failed: bool,
+}
+
+type Buffer = Arc<Mutex<Vec<CblasInjectTraceRecord>>>;
+
+// Lock order: a thread buffer, then SINK. BUFFERS is taken before either.
+static SINK: Mutex<Option<Sink>> = Mutex::new(None);
+static BUFFERS: Mutex<Vec<Buffer>> = Mutex::new(Vec::new());
+
+struct Local {
+    thread: u32,
+    buffer: Buffer,
+}
+
+thread_local! {
+    static LOCAL: Local = {
+        let buffer = Buffer::default();
+        lock(&BUFFERS).push(Arc::clone(&buffer));
+        Local {
+            thread: NEXT_THREAD.fetch_add(1, Ordering::Relaxed),
+            buffer,
+        }
+    };
+}
+
+fn lock<T>(m: &Mutex<T>) -> MutexGuard<'_, T> {
+    m.lock().unwrap_or_else(|e| e.into_inner())
+}
+
+fn now_ns() -> u64 {
+    let epoch = EPOCH.get_or_init(Instant::now);
+    u64::try_from(epoch.elapsed().as_nanos()).unwrap_or(u64::MAX)
+}
+
+fn write_records(sink: &mut Option<Sink>, records: &[CblasInjectTraceRecord]) {
+    let Some(sink) = sink else { return };
+    // SAFETY: the record is `repr(C)` plain data with explicit padding.
+    let bytes =
+        unsafe { slice::from_raw_parts(records.as_ptr().cast::<u8>(), mem::size_of_val(records)) };
+    sink.failed |= sink.file.write_all(bytes).is_err();
+}
+
+/// Value of `CALL_PATH` while no record is pending on the thread.
+const NO_CALL: u8 = u8::MAX;
+
+thread_local! {
+    /// Path of the innermost pending call on this thread.
+    static CALL_PATH: Cell<u8> = const { Cell::new(NO_CALL) };
+}
+
+/// A started record, written with the call's path when dropped.
+pub(crate) struct Pending {
+    record: CblasInjectTraceRecord,
+    /// Path of an enclosing call on this thread.
+    outer: u8,
+}
+
+fn widen<I: Copy + Into<i64>, const N: usize>(values: &[I]) -> [i64; N] {
+    let mut out = [0; N];
+    for (o, &v) in out.iter_mut().zip(values) {
+        *o = v.into();
+    }
+    out
+}
+
+#[cold]
+#[inline(never)]
+fn begin_slow<I: Copy + Into<i64>>(
+    routine: Routine,
+    order: u8,
+    flags: &[u8],
+    dims: &[I],
+    lds: &[I],
+) -> Option<Pending> {
+    if STATE.load(Ordering::Relaxed) == UNINIT {
+        init_from_env();
+    }
+    if STATE.load(Ordering::Acquire) != ON || coalesce::flushing() {
+        return None;
+    }
+    let mut record = CblasInjectTraceRecord {
+        timestamp_ns: now_ns().saturating_sub(START_NS.load(Ordering::Relaxed)),
+        routine: routine as u16,
+        order,
+        flags: [0; 4],
+        dims: widen(dims),
+        lds: widen(lds),
+        ..Default::default()
+    };
+    record.flags[..flags.len()].copy_from_slice(flags);
+    Some(Pending {
+        record,
+        outer: CALL_PATH.replace(Path::Native as u8),
+    })
+}
+
+/// Start recording a call to `routine` if a trace is active.
+#[inline(always)]
+pub(crate) fn begin<I: Copy + Into<i64>>(
+    routine: Routine,
+    order: u8,
+    flags: &[u8],
+    dims: &[I],
+    lds: &[I],
+) -> Option<Pending> {
+    if STATE.load(Ordering::Relaxed) == OFF {
+        return None;
+    }
+    begin_slow(routine, order, flags, dims, lds)
+}
+
+impl Drop for Pending {
+    fn drop(&mut self) {
+        self.record.path = CALL_PATH.replace(self.outer);
+        if STATE.load(Ordering::Acquire) != ON {
+            return;
+        }
+        let _ = LOCAL.try_with(|local| {
+            let mut buffer = lock(&local.buffer);
+            if buffer.capacity() == 0 {
+                buffer.reserve_exact(RECORDS_PER_FLUSH);
+            }
+            buffer.push(CblasInjectTraceRecord {
+                thread: local.thread,
+                ..self.record
+            });
+            if buffer.len() >= RECORDS_PER_FLUSH {
+                write_records(&mut lock(&SINK), &buffer);
+                buffer.clear();
+            }
+        });
+    }
+}
+
+/// Report how the current call is served; the last report wins.
+#[inline(always)]
+pub(crate) fn dispatched(path: Path) {
+    if STATE.load(Ordering::Relaxed) == ON {
+        CALL_PATH.with(|p| {
+            if p.get() != NO_CALL {
+                p.set(path as u8);
+            }
+        });
+    }
+}
+
+/// Report that a `cblas_*` call goes to provider `p`; returns `p`.
+#[inline(always)]
+pub(crate) fn lp64_provider<P: ProviderAbi>(p: P) -> P {
+    dispatched(Path::lp64(p.ilp64()));
+    p
+}
+
+/// Report that a `cblas_*_64` call goes to provider `p`; returns `p`.
+#[inline(always)]
+pub(crate) fn ilp64_provider<P: ProviderAbi>(p: P) -> P {
+    dispatched(Path::ilp64(p.ilp64()));
+    p
+}
+
+extern "C" {
+    fn atexit(f: extern "C" fn()) -> c_int;
+}
+
+extern "C" fn stop_at_exit() {
+    stop();
+}
+
+fn init_from_env() {
+    ENV_INIT.call_once(|| {
+        let path = std::env::var_os(TRACE_ENV).filter(|p| !p.is_empty());
+        match path {
+            Some(path) if start(&path) == CBLAS_INJECT_STATUS_OK => {
+                unsafe { atexit(stop_at_exit) };
+            }
+            _ => {
+                let _ = STATE.compare_exchange(UNINIT, OFF, Ordering::Relaxed, Ordering::Relaxed);
+            }
+        }
+    });
+}
+
+fn start(path: &std::ffi::OsStr) -> i32 {
+    stop();
+    let Ok(file) = File::create(path) else {
+        STATE.store(OFF, Ordering::Relaxed);
+        return CBLAS_INJECT_STATUS_IO_ERROR;
+    };
+    let mut file = BufWriter::new(file);
+    let header = CblasInjectTraceHeader {
+        magic: CBLAS_INJECT_TRACE_MAGIC,
+        version: CBLAS_INJECT_TRACE_VERSION,
+        record_size: mem::size_of::<CblasInjectTraceRecord>() as u32,
+        routine_count: stats::ROUTINE_NAMES.len() as u32,
+        name_len: CBLAS_INJECT_TRACE_NAME_LEN as u32,
+    };
+    // SAFETY: the header is `repr(C)` plain data without padding.
+    let mut failed = file
+        .write_all(unsafe {
+            slice::from_raw_parts(
+                (&header as *const CblasInjectTraceHeader).cast::<u8>(),
+                mem::size_of::<CblasInjectTraceHeader>(),
+            )
+        })
+        .is_err();
+    for name in stats::ROUTINE_NAMES {
+        let mut slot = [0u8; CBLAS_INJECT_TRACE_NAME_LEN];
+        slot[..name.len()].copy_from_slice(name);
+        failed |= file.write_all(&slot).is_err();
+    }
+    if failed {
+        STATE.store(OFF, Ordering::Relaxed);
+        return CBLAS_INJECT_STATUS_IO_ERROR;
+    }
+
+    // Drop anything recorded after the previous trace was drained.
+    for buffer in lock(&BUFFERS).iter() {
+        lock(buffer).clear();
+    }
+    *lock(&SINK) = Some(Sink {
+        file,
+        failed: false,
+    });
+    START_NS.store(now_ns(), Ordering::Relaxed);
+    STATE.store(ON, Ordering::Release);
+    CBLAS_INJECT_STATUS_OK
+}
+
+fn stop() -> i32 {
+    if STATE.load(Ordering::Relaxed) == ON {
+        STATE.store(OFF, Ordering::Relaxed);
+    }
+    let mut buffers = lock(&BUFFERS);
+    for buffer in buffers.iter() {
+        let mut buffer = lock(buffer);
+        write_records(&mut lock(&SINK), &buffer);
+        buffer.clear();
+    }
+    // Forget buffers of threads that have exited.
+    buffers.retain(|b| Arc::strong_count(b) > 1);
+    drop(buffers);
+
+    let Some(mut sink) = lock(&SINK).take() else {
+        return CBLAS_INJECT_STATUS_OK;
+    };
+    if sink.file.flush().is_err() || sink.failed {
+        CBLAS_INJECT_STATUS_IO_ERROR
+    } else {
+        CBLAS_INJECT_STATUS_OK
+    }
+}
+
+/// Start tracing into `path`, truncating it.
+///
+/// An active trace is stopped first. Returns `CBLAS_INJECT_STATUS_OK`,
+/// `CBLAS_INJECT_STATUS_NULL_POINTER`, or `CBLAS_INJECT_STATUS_IO_ERROR` if
+/// the file cannot be created (tracing is then off).
+///
+/// # Safety
+///
+/// `path` must be NULL or a NUL-terminated string.
+#[no_mangle]
+pub unsafe extern "C" fn cblas_inject_trace_start(path: *const c_char) -> i32 {
+    if path.is_null() {
+        return CBLAS_INJECT_STATUS_NULL_POINTER;
+    }
+    // An explicit start wins over CBLAS_INJECT_TRACE.
+    ENV_INIT.call_once(|| {});
+    let path = unsafe { CStr::from_ptr(path) }
+        .to_string_lossy()
+        .into_owned();
+    start(path.as_ref())
+}
+
+/// Stop tracing, write every thread's buffered records and close the file.
+///
+/// Returns `CBLAS_INJECT_STATUS_IO_ERROR` if any write failed, otherwise
+/// `CBLAS_INJECT_STATUS_OK` (also when no trace was active). Calls racing with
+/// the stop on other threads may be missing from the file.
+#[no_mangle]
+pub extern "C" fn cblas_inject_trace_stop() -> i32 {
+    stop()
+}
+
+/// Whether a trace is being recorded.
+#[no_mangle]
+pub extern "C" fn cblas_inject_trace_active() -> c_int {
+    c_int::from(STATE.load(Ordering::Relaxed) == ON)
+}
@@ -0,0 +1,496 @@
+#![cfg(not(feature = "openblas"))]
+
+use std::ffi::{c_char, c_void};
+use std::ptr;
+use std::sync::atomic::{AtomicBool, AtomicUsize, Ordering};
+
+use cblas_inject::{
+    cblas_inject_async_test, cblas_inject_async_wait, cblas_inject_async_wait_all,
+    cblas_inject_dgemm_async, cblas_inject_dgemm_async_64, cblas_inject_dtrsm_async,
+    cblas_inject_register_dgemm_lp64, cblas_inject_register_dtrsm_lp64,
+    cblas_inject_register_zgemm3m_lp64, cblas_inject_register_zgemm_lp64,
+    cblas_inject_set_gemm3m_min_flops, cblas_inject_set_worker_threads, cblas_inject_zgemm_async,
+    BlasInt32, CblasColMajor, CblasConjNoTrans, CblasInjectAsync, CblasLeft, CblasLower,
+    CblasNoTrans, CblasNonUnit, CBLAS_INJECT_STATUS_NULL_POINTER, CBLAS_INJECT_STATUS_OK,
+};
+use num_complex::Complex64;
+
+mod common;
+use common::generate_vector_f64;
+
+/// Scalar that makes the mock dgemm block until `RELEASE` is set.
+const GATE: f64 = 7.0;
+static RELEASE: AtomicBool = AtomicBool::new(false);
+static DGEMM_CALLS: AtomicUsize = AtomicUsize::new(0);
+static ZGEMM_CALLS: AtomicUsize = AtomicUsize::new(0);
+static ZGEMM3M_CALLS: AtomicUsize = AtomicUsize::new(0);
+
+/// Column-major `C = alpha * A * B + beta * C`.
+#[allow(clippy::too_many_arguments)]
+fn reference_gemm(
+    m: usize,
+    n: usize,
+    k: usize,
+    alpha: f64,
+    a: &[f64],
+    b: &[f64],
+    beta: f64,
+    c: &mut [f64],
+) {
+    for j in 0..n {
+        for i in 0..m {
+            let dot: f64 = (0..k).map(|p| a[i + p * m] * b[p + j * k]).sum();
+            c[i + j * m] = alpha * dot + beta * c[i + j * m];
+        }
+    }
+}
+
+/// Column-major lower, non-unit `B = alpha * inv(L) * B`.
+fn reference_trsm(m: usize, n: usize, alpha: f64, l: &[f64], b: &mut [f64]) {
+    for j in 0..n {
+        let col = &mut b[j * m..(j + 1) * m];
+        for i in 0..m {
+            let sum: f64 = (0..i).map(|p| l[i + p * m] * col[p]).sum();
+            col[i] = (alpha * col[i] - sum) / l[i + i * m];
+        }
+    }
+}
+
+unsafe extern "C" fn mock_dgemm(
+    transa: *const c_char,
+    transb: *const c_char,
+    m: *const BlasInt32,
+    n: *const BlasInt32,
+    k: *const BlasInt32,
+    alpha: *const f64,
+    a: *const f64,
+    lda: *const BlasInt32,
+    b: *const f64,
+    ldb: *const BlasInt32,
+    beta: *const f64,
+    c: *mut f64,
+    ldc: *const BlasInt32,
+) {
+    unsafe {
+        // 'R' (ConjNoTrans) is NoTrans for real data.
+        assert!(matches!(*transa as u8, b'N' | b'R'));
+        assert_eq!(*transb, b'N' as c_char);
+        let (m, n, k) = (*m as usize, *n as usize, *k as usize);
+        let (lda, ldb, ldc) = (*lda as usize, *ldb as usize, *ldc as usize);
+        if *alpha == GATE {
+            while !RELEASE.load(Ordering::SeqCst) {
+                std::thread::yield_now();
+            }
+        }
+        DGEMM_CALLS.fetch_add(1, Ordering::SeqCst);
+        for j in 0..n {
+            for i in 0..m {
+                let dot: f64 = (0..k)
+                    .map(|p| *a.add(i + p * lda) * *b.add(p + j * ldb))
+                    .sum();
+                let cij = c.add(i + j * ldc);
+                *cij = *alpha * dot + *beta * *cij;
+            }
+        }
+    }
+}
+
+macro_rules! mock_zgemm {
+    ($name:ident, $calls:ident) => {
+        unsafe extern "C" fn $name(
+            _transa: *const c_char,
+            _transb: *const c_char,
+            _m: *const BlasInt32,
+            _n: *const BlasInt32,
+            _k: *const BlasInt32,
+            _alpha: *const Complex64,
+            _a: *const Complex64,
+            _lda: *const BlasInt32,
+            _b: *const Complex64,
+            _ldb: *const BlasInt32,
+            _beta: *const Complex64,
+            _c: *mut Complex64,
+            _ldc: *const BlasInt32,
+        ) {
+            $calls.fetch_add(1, Ordering::SeqCst);
+        }
+    };
+}
+
+mock_zgemm!(mock_zgemm, ZGEMM_CALLS);
+mock_zgemm!(mock_zgemm3m, ZGEMM3M_CALLS);
+
+unsafe extern "C" fn mock_dtrsm(
+    side: *const c_char,
+    uplo: *const c_char,
+    transa: *const c_char,
+    diag: *const c_char,
+    m: *const BlasInt32,
+    n: *const BlasInt32,
+    alpha: *const f64,
+    a: *const f64,
+    _lda: *const BlasInt32,
+    b: *mut f64,
+    _ldb: *const BlasInt32,
+) {
+    unsafe {
+        assert_eq!(
+            [*side, *uplo, *transa, *diag].map(|c| c as u8),
+            [b'L', b'L', b'N', b'N']
+        );
+        let (m, n) = (*m as usize, *n as usize);
+        reference_trsm(
+            m,
+            n,
+            *alpha,
+            std::slice::from_raw_parts(a, m * m),
+            std::slice::from_raw_parts_mut(b, m * n),
+        );
+    }
+}
+
+/// Queue column-major `C = alpha * A * B + beta * C` for n x n matrices.
+fn dgemm_async(
+    n: usize,
+    alpha: f64,
+    a: *const f64,
+    b: *const f64,
+    beta: f64,
+    c: *mut f64,
+    handle: *mut *mut CblasInjectAsync,
+) {
+    let n = n as i32;
+    let status = unsafe {
+        cblas_inject_dgemm_async(
+            CblasColMajor,
+            CblasNoTrans,
+            CblasNoTrans,
+            n,
+            n,
+            n,
+            alpha,
+            a,
+            n,
+            b,
+            n,
+            beta,
+            c,
+            n,
+            handle,
+        )
+    };
+    assert_eq!(status, CBLAS_INJECT_STATUS_OK);
+}
+
+// The queue and provider slots are process-global, so everything runs in one
+// test.
+#[test]
+fn async_calls_follow_data_dependencies() {
+    unsafe {
+        assert_eq!(
+            cblas_inject_register_dgemm_lp64(mock_dgemm as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(
+            cblas_inject_register_dtrsm_lp64(mock_dtrsm as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+    }
+    let n = 24usize;
+    let a = generate_vector_f64(n * n, 1);
+    let b = generate_vector_f64(n * n, 2);
+    let mut l = generate_vector_f64(n * n, 3);
+    for i in 0..n {
+        l[i + i * n] = 4.0 + i as f64;
+    }
+
+    // Reference: C = gate * A * B, D = C * B + D, D = inv(L) * (2 * D).
+    let mut want_c = vec![0.0; n * n];
+    reference_gemm(n, n, n, GATE, &a, &b, 0.0, &mut want_c);
+    let mut want_d = generate_vector_f64(n * n, 4);
+    reference_gemm(n, n, n, 1.0, &want_c, &b, 1.0, &mut want_d);
+    reference_trsm(n, n, 2.0, &l, &mut want_d);
+
+    // The first call blocks until released, so everything queued behind it
+    // that touches C has to wait.
+    let mut c = vec![0.0; n * n];
+    let mut d = generate_vector_f64(n * n, 4);
+    let mut gate = ptr::null_mut();
+    dgemm_async(
+        n,
+        GATE,
+        a.as_ptr(),
+        b.as_ptr(),
+        0.0,
+        c.as_mut_ptr(),
+        &mut gate,
+    );
+    dgemm_async(
+        n,
+        1.0,
+        c.as_ptr(),
+        b.as_ptr(),
+        1.0,
+        d.as_mut_ptr(),
+        ptr::null_mut(),
+    );
+    let mut solved = ptr::null_mut();
+    let status = unsafe {
+        cblas_inject_dtrsm_async(
+            CblasColMajor,
+            CblasLeft,
+            CblasLower,
+            CblasNoTrans,
+            CblasNonUnit,
+            n as i32,
+            n as i32,
+            2.0,
+            l.as_ptr(),
+            n as i32,
+            d.as_mut_ptr(),
+            n as i32,
+            &mut solved,
+        )
+    };
+    assert_eq!(status, CBLAS_INJECT_STATUS_OK);
+
+    // Independent same-shape calls queue up behind the gate as well.
+    let mut outs: Vec<Vec<f64>> = (0..8).map(|_| vec![0.0; n * n]).collect();
+    let mut handles = Vec::new();
+    for out in &mut outs {
+        let mut handle = ptr::null_mut();
+        dgemm_async(
+            n,
+            1.0,
+            a.as_ptr(),
+            b.as_ptr(),
+            0.0,
+            out.as_mut_ptr(),
+            &mut handle,
+        );
+        handles.push(handle);
+    }
+
+    std::thread::sleep(std::time::Duration::from_millis(20));
+    assert_eq!(unsafe { cblas_inject_async_test(gate) }, 0);
+    assert_eq!(unsafe { cblas_inject_async_test(solved) }, 0);
+    assert_eq!(DGEMM_CALLS.load(Ordering::SeqCst), 0);
+    RELEASE.store(true, Ordering::SeqCst);
+
+    assert_eq!(
+        unsafe { cblas_inject_async_wait(solved) },
+        CBLAS_INJECT_STATUS_OK
+    );
+    assert_eq!(unsafe { cblas_inject_async_test(gate) }, 1);
+    assert_eq!(
+        unsafe { cblas_inject_async_wait(gate) },
+        CBLAS_INJECT_STATUS_OK
+    );
+    assert_eq!(c, want_c);
+    assert_eq!(d, want_d);
+    for handle in handles {
+        assert_eq!(
+            unsafe { cblas_inject_async_wait(handle) },
+            CBLAS_INJECT_STATUS_OK
+        );
+    }
+    let mut want = vec![0.0; n * n];
+    reference_gemm(n, n, n, 1.0, &a, &b, 0.0, &mut want);
+    for out in &outs {
+        assert_eq!(*out, want);
+    }
+    assert_eq!(DGEMM_CALLS.load(Ordering::SeqCst), 10);
+
+    // A chain of accumulations into one C runs in submission order.
+    let mut acc = vec![0.0; n * n];
+    let mut want_acc = vec![0.0; n * n];
+    for step in 0..16 {
+        let beta = if step == 0 { 0.0 } else { 0.5 };
+        let status = unsafe {
+            cblas_inject_dgemm_async_64(
+                CblasColMajor,
+                CblasNoTrans,
+                CblasNoTrans,
+                n as i64,
+                n as i64,
+                n as i64,
+                1.0,
+                a.as_ptr(),
+                n as i64,
+                b.as_ptr(),
+                n as i64,
+                beta,
+                acc.as_mut_ptr(),
+                n as i64,
+                ptr::null_mut(),
+            )
+        };
+        assert_eq!(status, CBLAS_INJECT_STATUS_OK);
+        reference_gemm(n, n, n, 1.0, &a, &b, beta, &mut want_acc);
+    }
+    assert_eq!(cblas_inject_async_wait_all(), CBLAS_INJECT_STATUS_OK);
+    assert_eq!(acc, want_acc);
+
+    // A ConjNoTrans A spans k columns like NoTrans: a call reading the far
+    // columns of a wide A waits for the call writing them, even with a free
+    // executor.
+    RELEASE.store(false, Ordering::SeqCst);
+    assert_eq!(cblas_inject_set_worker_threads(2), CBLAS_INJECT_STATUS_OK);
+    let (m, k, ld) = (4usize, 24usize, 32usize);
+    let (a4, b4) = (generate_vector_f64(m * m, 5), generate_vector_f64(m * m, 6));
+    let bk = generate_vector_f64(k * m, 7);
+    let mut wide = vec![0.0; ld * k];
+    let mut out = vec![0.0; m * m];
+    let (mut tail, mut product) = (ptr::null_mut(), ptr::null_mut());
+    let status = unsafe {
+        cblas_inject_dgemm_async(
+            CblasColMajor,
+            CblasNoTrans,
+            CblasNoTrans,
+            m as i32,
+            m as i32,
+            m as i32,
+            GATE,
+            a4.as_ptr(),
+            m as i32,
+            b4.as_ptr(),
+            m as i32,
+            0.0,
+            wide.as_mut_ptr().add((k - m) * ld),
+            ld as i32,
+            &mut tail,
+        )
+    };
+    assert_eq!(status, CBLAS_INJECT_STATUS_OK);
+    let status = unsafe {
+        cblas_inject_dgemm_async(
+            CblasColMajor,
+            CblasConjNoTrans,
+            CblasNoTrans,
+            m as i32,
+            m as i32,
+            k as i32,
+            1.0,
+            wide.as_ptr(),
+            ld as i32,
+            bk.as_ptr(),
+            k as i32,
+            0.0,
+            out.as_mut_ptr(),
+            m as i32,
+            &mut product,
+        )
+    };
+    assert_eq!(status, CBLAS_INJECT_STATUS_OK);
+    std::thread::sleep(std::time::Duration::from_millis(20));
+    assert_eq!(unsafe { cblas_inject_async_test(product) }, 0);
+    RELEASE.store(true, Ordering::SeqCst);
+    for handle in [tail, product] {
+        assert_eq!(
+            unsafe { cblas_inject_async_wait(handle) },
+            CBLAS_INJECT_STATUS_OK
+        );
+    }
+    let mut packed = vec![0.0; m * k];
+    reference_gemm(m, m, m, GATE, &a4, &b4, 0.0, &mut packed[(k - m) * m..]);
+    let mut want = vec![0.0; m * m];
+    reference_gemm(m, m, k, 1.0, &packed, &bk, 0.0, &mut want);
+    assert_eq!(out, want);
+    assert_eq!(cblas_inject_set_worker_threads(0), CBLAS_INJECT_STATUS_OK);
+
+    // Same-shape ZGEMMs above the 3M threshold run together, and each takes
+    // the 3M route as it would when called directly.
+    unsafe {
+        assert_eq!(
+            cblas_inject_register_zgemm_lp64(mock_zgemm as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(
+            cblas_inject_register_zgemm3m_lp64(mock_zgemm3m as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+    }
+    assert_eq!(
+        cblas_inject_set_gemm3m_min_flops(1.0),
+        CBLAS_INJECT_STATUS_OK
+    );
+    let one = Complex64::new(1.0, 0.0);
+    let z = [one; 16];
+    let mut zcs = [[Complex64::default(); 16]; 4];
+    // Both executors are held by gated calls while the ZGEMMs queue up.
+    RELEASE.store(false, Ordering::SeqCst);
+    let mut gated = vec![vec![0.0; n * n]; 2];
+    for g in &mut gated {
+        dgemm_async(
+            n,
+            GATE,
+            a.as_ptr(),
+            b.as_ptr(),
+            0.0,
+            g.as_mut_ptr(),
+            ptr::null_mut(),
+        );
+    }
+    std::thread::sleep(std::time::Duration::from_millis(20));
+    for zc in &mut zcs {
+        let status = unsafe {
+            cblas_inject_zgemm_async(
+                CblasColMajor,
+                CblasNoTrans,
+                CblasNoTrans,
+                4,
+                4,
+                4,
+                &one,
+                z.as_ptr(),
+                4,
+                z.as_ptr(),
+                4,
+                &one,
+                zc.as_mut_ptr(),
+                4,
+                ptr::null_mut(),
+            )
+        };
+        assert_eq!(status, CBLAS_INJECT_STATUS_OK);
+    }
+    RELEASE.store(true, Ordering::SeqCst);
+    assert_eq!(cblas_inject_async_wait_all(), CBLAS_INJECT_STATUS_OK);
+    assert_eq!(ZGEMM3M_CALLS.load(Ordering::SeqCst), 4);
+    assert_eq!(ZGEMM_CALLS.load(Ordering::SeqCst), 0);
+    assert_eq!(
+        cblas_inject_set_gemm3m_min_flops(0.0),
+        CBLAS_INJECT_STATUS_OK
+    );
+
+    // Errors.
+    let mut handle = ptr::dangling_mut::<CblasInjectAsync>();
+    let z = [Complex64::default(); 4];
+    let mut zc = z;
+    let status = unsafe {
+        cblas_inject_zgemm_async(
+            CblasColMajor,
+            CblasNoTrans,
+            CblasNoTrans,
+            2,
+            2,
+            2,
+            ptr::null(),
+            z.as_ptr(),
+            2,
+            z.as_ptr(),
+            2,
+            &Complex64::default(),
+            zc.as_mut_ptr(),
+            2,
+            &mut handle,
+        )
+    };
+    assert_eq!(status, CBLAS_INJECT_STATUS_NULL_POINTER);
+    assert!(handle.is_null());
+    assert_eq!(unsafe { cblas_inject_async_test(ptr::null()) }, 1);
+    assert_eq!(
+        unsafe { cblas_inject_async_wait(ptr::null_mut()) },
+        CBLAS_INJECT_STATUS_NULL_POINTER
+    );
+}
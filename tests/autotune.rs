@@ -0,0 +1,137 @@
+#![cfg(not(feature = "openblas"))]
+
+use std::ffi::{c_char, c_void, CString};
+use std::fs;
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::time::{Duration, Instant};
+
+use cblas_inject::{
+    cblas_inject_autotune, cblas_inject_native_blas1_max_n, cblas_inject_register_ddot_lp64,
+    cblas_inject_register_dgemm_lp64, cblas_inject_set_native_blas1_max_n,
+    cblas_inject_set_small_gemm_max_dim, cblas_inject_small_gemm_max_dim, BlasInt32,
+    CBLAS_INJECT_SMALL_GEMM_DIM_LIMIT, CBLAS_INJECT_STATUS_IO_ERROR, CBLAS_INJECT_STATUS_OK,
+};
+
+static PROVIDER_CALLS: AtomicUsize = AtomicUsize::new(0);
+
+/// A provider slower than the built-in kernels at every tuned size.
+fn slow_provider() {
+    PROVIDER_CALLS.fetch_add(1, Ordering::SeqCst);
+    let start = Instant::now();
+    while start.elapsed() < Duration::from_millis(5) {
+        std::hint::spin_loop();
+    }
+}
+
+unsafe extern "C" fn mock_dgemm(
+    _transa: *const c_char,
+    _transb: *const c_char,
+    _m: *const BlasInt32,
+    _n: *const BlasInt32,
+    _k: *const BlasInt32,
+    _alpha: *const f64,
+    _a: *const f64,
+    _lda: *const BlasInt32,
+    _b: *const f64,
+    _ldb: *const BlasInt32,
+    _beta: *const f64,
+    _c: *mut f64,
+    _ldc: *const BlasInt32,
+) {
+    slow_provider();
+}
+
+unsafe extern "C" fn mock_ddot(
+    _n: *const BlasInt32,
+    _x: *const f64,
+    _incx: *const BlasInt32,
+    _y: *const f64,
+    _incy: *const BlasInt32,
+) -> f64 {
+    slow_provider();
+    0.0
+}
+
+fn autotune(path: &std::path::Path) -> i32 {
+    let path = CString::new(path.to_str().unwrap()).unwrap();
+    unsafe { cblas_inject_autotune(path.as_ptr()) }
+}
+
+fn thresholds() -> (i32, i64) {
+    (
+        cblas_inject_small_gemm_max_dim(),
+        cblas_inject_native_blas1_max_n(),
+    )
+}
+
+fn reset() {
+    assert_eq!(
+        cblas_inject_set_small_gemm_max_dim(0),
+        CBLAS_INJECT_STATUS_OK
+    );
+    assert_eq!(
+        cblas_inject_set_native_blas1_max_n(0),
+        CBLAS_INJECT_STATUS_OK
+    );
+}
+
+// Thresholds and provider slots are process-global, so everything runs in
+// one test.
+#[test]
+fn autotune_measures_once_and_caches() {
+    unsafe {
+        assert_eq!(
+            cblas_inject_register_dgemm_lp64(mock_dgemm as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(
+            cblas_inject_register_ddot_lp64(mock_ddot as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+    }
+    let cache = std::env::temp_dir().join(format!("cblas-inject-autotune-{}", std::process::id()));
+    let _ = fs::remove_file(&cache);
+
+    // No cache yet: measure, apply, and write it.
+    assert_eq!(autotune(&cache), CBLAS_INJECT_STATUS_OK);
+    let tuned = (CBLAS_INJECT_SMALL_GEMM_DIM_LIMIT, 4096);
+    assert_eq!(thresholds(), tuned);
+    let text = fs::read_to_string(&cache).unwrap();
+    assert!(text.starts_with("format=1\ncpu="), "{text}");
+    assert!(text.contains("\nprovider=-\n"), "{text}");
+    assert!(text.contains("\nsmall_gemm_max_dim=32\n"), "{text}");
+    assert!(text.contains("\nnative_blas1_max_n=4096\n"), "{text}");
+
+    // A matching cache is applied without running anything.
+    reset();
+    let edited = text
+        .replace("small_gemm_max_dim=32", "small_gemm_max_dim=7")
+        .replace("native_blas1_max_n=4096", "native_blas1_max_n=100");
+    fs::write(&cache, &edited).unwrap();
+    let calls = PROVIDER_CALLS.load(Ordering::SeqCst);
+    assert_eq!(autotune(&cache), CBLAS_INJECT_STATUS_OK);
+    assert_eq!(thresholds(), (7, 100));
+    assert_eq!(PROVIDER_CALLS.load(Ordering::SeqCst), calls);
+
+    // A cache from another CPU, or one missing a tunable family, is redone.
+    for stale in [
+        edited.replacen("cpu=", "cpu=other ", 1),
+        edited.replace("native_blas1_max_n=100\n", ""),
+    ] {
+        reset();
+        fs::write(&cache, stale).unwrap();
+        assert_eq!(autotune(&cache), CBLAS_INJECT_STATUS_OK);
+        assert_eq!(thresholds(), tuned);
+        assert!(PROVIDER_CALLS.load(Ordering::SeqCst) > calls);
+        assert_eq!(fs::read_to_string(&cache).unwrap(), text);
+    }
+    fs::remove_file(&cache).unwrap();
+
+    // An unwritable cache still applies the tuned thresholds.
+    reset();
+    assert_eq!(
+        autotune(&cache.join("missing-dir")),
+        CBLAS_INJECT_STATUS_IO_ERROR
+    );
+    assert_eq!(thresholds(), tuned);
+}
@@ -0,0 +1,201 @@
+#![cfg(not(feature = "openblas"))]
+
+use std::ffi::c_void;
+use std::sync::atomic::{AtomicI64, AtomicUsize, Ordering};
+
+use cblas_inject::{
+    cblas_caxpby, cblas_daxpby, cblas_daxpby_64, cblas_inject_daxpy_dot, cblas_inject_daxpy_dot_64,
+    cblas_inject_register_zaxpby_lp64, cblas_inject_saxpy_dot, cblas_saxpby, cblas_zaxpby,
+    cblas_zaxpby_64, BlasInt32, CBLAS_INJECT_STATUS_OK,
+};
+use num_complex::{Complex32, Complex64};
+
+mod common;
+use common::{assert_f64_eq, generate_vector_f64};
+
+/// Element `i` of a vector of length `n` stored with increment `inc`.
+fn at(n: usize, inc: isize, i: usize) -> usize {
+    if inc >= 0 {
+        i * inc as usize
+    } else {
+        (n - 1 - i) * inc.unsigned_abs()
+    }
+}
+
+static ZAXPBY_CALLS: AtomicUsize = AtomicUsize::new(0);
+static LAST_N: AtomicI64 = AtomicI64::new(0);
+
+unsafe extern "C" fn mock_zaxpby(
+    n: *const BlasInt32,
+    _alpha: *const Complex64,
+    _x: *const Complex64,
+    _incx: *const BlasInt32,
+    _beta: *const Complex64,
+    _y: *mut Complex64,
+    _incy: *const BlasInt32,
+) {
+    ZAXPBY_CALLS.fetch_add(1, Ordering::SeqCst);
+    LAST_N.store(i64::from(unsafe { *n }), Ordering::SeqCst);
+}
+
+// Provider slots are process-global, so everything runs in one test.
+#[test]
+fn axpby_and_fused_axpy_dot() {
+    // 37 elements exercise both the unrolled body and the tail.
+    let n = 37usize;
+    for (incx, incy) in [(1isize, 1isize), (2, 3), (-2, 1), (1, -3)] {
+        let x = generate_vector_f64(n * 3, 1);
+        let y = generate_vector_f64(n * 3, 2);
+        let mut got = y.clone();
+        let mut got_64 = y.clone();
+        unsafe {
+            cblas_daxpby(
+                n as i32,
+                0.75,
+                x.as_ptr(),
+                incx as i32,
+                -1.5,
+                got.as_mut_ptr(),
+                incy as i32,
+            );
+            cblas_daxpby_64(
+                n as i64,
+                0.75,
+                x.as_ptr(),
+                incx as i64,
+                -1.5,
+                got_64.as_mut_ptr(),
+                incy as i64,
+            );
+        }
+        let mut want = y.clone();
+        for i in 0..n {
+            let (ix, iy) = (at(n, incx, i), at(n, incy, i));
+            want[iy] = 0.75 * x[ix] - 1.5 * y[iy];
+        }
+        assert_eq!(want, got, "daxpby incx {incx} incy {incy}");
+        assert_eq!(want, got_64, "daxpby_64 incx {incx} incy {incy}");
+
+        let xc: Vec<Complex64> = x.iter().map(|&v| Complex64::new(v, 1.0 - v)).collect();
+        let yc: Vec<Complex64> = y.iter().map(|&v| Complex64::new(-v, 0.5)).collect();
+        let (alpha, beta) = (Complex64::new(0.5, -0.25), Complex64::new(-1.0, 0.75));
+        let mut got = yc.clone();
+        unsafe {
+            cblas_zaxpby(
+                n as i32,
+                &alpha,
+                xc.as_ptr(),
+                incx as i32,
+                &beta,
+                got.as_mut_ptr(),
+                incy as i32,
+            );
+        }
+        let mut want = yc.clone();
+        for i in 0..n {
+            let (ix, iy) = (at(n, incx, i), at(n, incy, i));
+            want[iy] = alpha * xc[ix] + beta * yc[iy];
+        }
+        assert_eq!(want, got, "zaxpby incx {incx} incy {incy}");
+    }
+
+    // A zero alpha or beta drops its term, so NaN in that vector is ignored.
+    let nan = [f32::NAN; 8];
+    let mut y = [2.0f32; 8];
+    unsafe { cblas_saxpby(8, 0.0, nan.as_ptr(), 1, 3.0, y.as_mut_ptr(), 1) };
+    assert_eq!(y, [6.0; 8]);
+    let mut y = [f32::NAN; 8];
+    unsafe { cblas_saxpby(8, 2.0, [1.0f32; 8].as_ptr(), 1, 0.0, y.as_mut_ptr(), 1) };
+    assert_eq!(y, [2.0; 8]);
+    let zero = Complex32::default();
+    let mut y = [Complex32::new(f32::NAN, 1.0); 4];
+    unsafe {
+        cblas_caxpby(
+            4,
+            &zero,
+            [Complex32::new(f32::NAN, 0.0); 4].as_ptr(),
+            1,
+            &zero,
+            y.as_mut_ptr(),
+            1,
+        )
+    };
+    assert_eq!(y, [zero; 4]);
+
+    // The fused routine matches axpy followed by dot, for a separate z and
+    // for z = y.
+    for (incx, incy, incz) in [(1isize, 1isize, 1isize), (2, -1, 3), (1, 2, 2)] {
+        let x = generate_vector_f64(n * 3, 3);
+        let z = generate_vector_f64(n * 3, 4);
+        let y = generate_vector_f64(n * 3, 5);
+        let mut want_y = y.clone();
+        for i in 0..n {
+            want_y[at(n, incy, i)] += -0.5 * x[at(n, incx, i)];
+        }
+        let dot: f64 = (0..n)
+            .map(|i| z[at(n, incz, i)] * want_y[at(n, incy, i)])
+            .sum();
+        let norm: f64 = (0..n).map(|i| want_y[at(n, incy, i)].powi(2)).sum();
+
+        let mut got_y = y.clone();
+        let got = unsafe {
+            cblas_inject_daxpy_dot(
+                n as i32,
+                -0.5,
+                x.as_ptr(),
+                incx as i32,
+                got_y.as_mut_ptr(),
+                incy as i32,
+                z.as_ptr(),
+                incz as i32,
+            )
+        };
+        assert_eq!(want_y, got_y, "daxpy_dot y {incx} {incy} {incz}");
+        assert_f64_eq(
+            &[got],
+            &[dot],
+            1e-12,
+            &format!("daxpy_dot {incx} {incy} {incz}"),
+        );
+
+        let mut got_y = y.clone();
+        let got = unsafe {
+            cblas_inject_daxpy_dot_64(
+                n as i64,
+                -0.5,
+                x.as_ptr(),
+                incx as i64,
+                got_y.as_mut_ptr(),
+                incy as i64,
+                got_y.as_ptr(),
+                incy as i64,
+            )
+        };
+        assert_eq!(want_y, got_y, "daxpy_dot_64 y = z {incx} {incy}");
+        assert_f64_eq(&[got], &[norm], 1e-12, "daxpy_dot_64 y = z");
+    }
+    let x = [1.0f32; 10];
+    let mut y = [2.0f32; 10];
+    let got =
+        unsafe { cblas_inject_saxpy_dot(10, 1.0, x.as_ptr(), 1, y.as_mut_ptr(), 1, x.as_ptr(), 1) };
+    assert_eq!((got, y), (30.0, [3.0; 10]));
+    assert_eq!(
+        unsafe { cblas_inject_saxpy_dot(0, 1.0, x.as_ptr(), 1, y.as_mut_ptr(), 1, x.as_ptr(), 1) },
+        0.0
+    );
+
+    // A registered provider gets the call; the ILP64 entry point narrows
+    // onto it.
+    unsafe {
+        assert_eq!(
+            cblas_inject_register_zaxpby_lp64(mock_zaxpby as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+    }
+    let one = Complex64::new(1.0, 0.0);
+    let (x, mut y) = ([one; 4], [one; 4]);
+    unsafe { cblas_zaxpby_64(3, &one, x.as_ptr(), 1, &one, y.as_mut_ptr(), 1) };
+    assert_eq!(ZAXPBY_CALLS.load(Ordering::SeqCst), 1);
+    assert_eq!(LAST_N.load(Ordering::SeqCst), 3);
+    assert_eq!(y, [one; 4]);
+}
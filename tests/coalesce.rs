@@ -0,0 +1,693 @@
+#![cfg(not(feature = "openblas"))]
+
+use std::ffi::{c_char, c_void};
+use std::sync::atomic::{AtomicUsize, Ordering};
+
+use cblas_inject::{
+    cblas_dgemv, cblas_dtrsv, cblas_dtrsv_64, cblas_inject_begin_coalesce,
+    cblas_inject_flush_coalesce, cblas_inject_register_dgemm_lp64,
+    cblas_inject_register_dgemv_lp64, cblas_inject_register_dtrsm_lp64,
+    cblas_inject_register_dtrsv_lp64, cblas_ztbsv, BlasInt32, CblasColMajor, CblasConjNoTrans,
+    CblasConjTrans, CblasLower, CblasNoTrans, CblasNonUnit, CblasRowMajor, CblasTrans, CblasUnit,
+    CblasUpper, CBLAS_DIAG, CBLAS_INJECT_STATUS_OK, CBLAS_ORDER, CBLAS_TRANSPOSE, CBLAS_UPLO,
+};
+use num_complex::Complex64;
+
+mod common;
+use common::{assert_f64_eq, generate_vector_f64, index};
+
+static DGEMM_CALLS: AtomicUsize = AtomicUsize::new(0);
+static DGEMV_CALLS: AtomicUsize = AtomicUsize::new(0);
+static DTRSM_CALLS: AtomicUsize = AtomicUsize::new(0);
+static DTRSV_CALLS: AtomicUsize = AtomicUsize::new(0);
+
+/// Storage index of element j of a `len`-element vector with increment `inc`.
+fn element(len: usize, inc: i64, j: usize) -> usize {
+    let step = inc.unsigned_abs() as usize;
+    if inc > 0 {
+        j * step
+    } else {
+        (len - 1 - j) * step
+    }
+}
+
+fn vector(len: usize, inc: i64, seed: usize) -> Vec<f64> {
+    generate_vector_f64((len.max(1) - 1) * inc.unsigned_abs() as usize + 1, seed)
+}
+
+fn is_trans(t: c_char) -> bool {
+    t as u8 != b'N'
+}
+
+/// Reference `y = alpha * op(A) * x + beta * y` in `order`.
+#[allow(clippy::too_many_arguments)]
+fn gemv_ref(
+    order: CBLAS_ORDER,
+    trans: bool,
+    (m, n): (usize, usize),
+    alpha: f64,
+    a: &[f64],
+    lda: usize,
+    x: &[f64],
+    incx: i64,
+    beta: f64,
+    y: &mut [f64],
+    incy: i64,
+) {
+    let (lenx, leny) = if trans { (m, n) } else { (n, m) };
+    for i in 0..leny {
+        let dot: f64 = (0..lenx)
+            .map(|p| {
+                let (r, c) = if trans { (p, i) } else { (i, p) };
+                a[index(order, r, c, lda)] * x[element(lenx, incx, p)]
+            })
+            .sum();
+        let yi = &mut y[element(leny, incy, i)];
+        *yi = if beta == 0.0 {
+            alpha * dot
+        } else {
+            alpha * dot + beta * *yi
+        };
+    }
+}
+
+/// Reference solve of `op(A) * x = b` in `order` for a triangular A.
+#[allow(clippy::too_many_arguments)]
+fn trsv_ref(
+    order: CBLAS_ORDER,
+    upper: bool,
+    trans: bool,
+    unit: bool,
+    n: usize,
+    a: &[f64],
+    lda: usize,
+    x: &mut [f64],
+    incx: i64,
+) {
+    let op = |i: usize, j: usize| {
+        let (r, c) = if trans { (j, i) } else { (i, j) };
+        a[index(order, r, c, lda)]
+    };
+    // op(A) is lower triangular when exactly one of these holds.
+    let forward = upper == trans;
+    let rows: Vec<usize> = if forward {
+        (0..n).collect()
+    } else {
+        (0..n).rev().collect()
+    };
+    for (step, &i) in rows.iter().enumerate() {
+        let mut v = x[element(n, incx, i)];
+        for &j in &rows[..step] {
+            v -= op(i, j) * x[element(n, incx, j)];
+        }
+        x[element(n, incx, i)] = if unit { v } else { v / op(i, i) };
+    }
+}
+
+unsafe extern "C" fn mock_dgemv(
+    trans: *const c_char,
+    m: *const BlasInt32,
+    n: *const BlasInt32,
+    alpha: *const f64,
+    a: *const f64,
+    lda: *const BlasInt32,
+    x: *const f64,
+    incx: *const BlasInt32,
+    beta: *const f64,
+    y: *mut f64,
+    incy: *const BlasInt32,
+) {
+    DGEMV_CALLS.fetch_add(1, Ordering::SeqCst);
+    unsafe {
+        let (m, n, lda) = (*m as usize, *n as usize, *lda as usize);
+        if m == 0 || n == 0 {
+            return;
+        }
+        let (incx, incy) = (i64::from(*incx), i64::from(*incy));
+        let t = is_trans(*trans);
+        let (lenx, leny) = if t { (m, n) } else { (n, m) };
+        let span = |len: usize, inc: i64| (len.max(1) - 1) * inc.unsigned_abs() as usize + 1;
+        gemv_ref(
+            CblasColMajor,
+            t,
+            (m, n),
+            *alpha,
+            std::slice::from_raw_parts(a, lda * n),
+            lda,
+            std::slice::from_raw_parts(x, span(lenx, incx)),
+            incx,
+            *beta,
+            std::slice::from_raw_parts_mut(y, span(leny, incy)),
+            incy,
+        );
+    }
+}
+
+unsafe extern "C" fn mock_dgemm(
+    transa: *const c_char,
+    transb: *const c_char,
+    m: *const BlasInt32,
+    n: *const BlasInt32,
+    k: *const BlasInt32,
+    alpha: *const f64,
+    a: *const f64,
+    lda: *const BlasInt32,
+    b: *const f64,
+    ldb: *const BlasInt32,
+    beta: *const f64,
+    c: *mut f64,
+    ldc: *const BlasInt32,
+) {
+    DGEMM_CALLS.fetch_add(1, Ordering::SeqCst);
+    unsafe {
+        let (m, n, k) = (*m as usize, *n as usize, *k as usize);
+        let (lda, ldb, ldc) = (*lda as usize, *ldb as usize, *ldc as usize);
+        let (ta, tb) = (is_trans(*transa), is_trans(*transb));
+        for j in 0..n {
+            for i in 0..m {
+                let dot: f64 = (0..k)
+                    .map(|p| {
+                        let aip = if ta {
+                            *a.add(p + i * lda)
+                        } else {
+                            *a.add(i + p * lda)
+                        };
+                        let bpj = if tb {
+                            *b.add(j + p * ldb)
+                        } else {
+                            *b.add(p + j * ldb)
+                        };
+                        aip * bpj
+                    })
+                    .sum();
+                let cij = &mut *c.add(i + j * ldc);
+                *cij = if *beta == 0.0 {
+                    *alpha * dot
+                } else {
+                    *alpha * dot + *beta * *cij
+                };
+            }
+        }
+    }
+}
+
+unsafe extern "C" fn mock_dtrsv(
+    uplo: *const c_char,
+    trans: *const c_char,
+    diag: *const c_char,
+    n: *const BlasInt32,
+    a: *const f64,
+    lda: *const BlasInt32,
+    x: *mut f64,
+    incx: *const BlasInt32,
+) {
+    DTRSV_CALLS.fetch_add(1, Ordering::SeqCst);
+    unsafe {
+        let (n, lda, incx) = (*n as usize, *lda as usize, i64::from(*incx));
+        trsv_ref(
+            CblasColMajor,
+            *uplo as u8 == b'U',
+            is_trans(*trans),
+            *diag as u8 == b'U',
+            n,
+            std::slice::from_raw_parts(a, lda * n),
+            lda,
+            std::slice::from_raw_parts_mut(x, (n.max(1) - 1) * incx.unsigned_abs() as usize + 1),
+            incx,
+        );
+    }
+}
+
+unsafe extern "C" fn mock_dtrsm(
+    side: *const c_char,
+    uplo: *const c_char,
+    transa: *const c_char,
+    diag: *const c_char,
+    m: *const BlasInt32,
+    n: *const BlasInt32,
+    alpha: *const f64,
+    a: *const f64,
+    lda: *const BlasInt32,
+    b: *mut f64,
+    ldb: *const BlasInt32,
+) {
+    DTRSM_CALLS.fetch_add(1, Ordering::SeqCst);
+    unsafe {
+        let (m, n, lda, ldb) = (*m as usize, *n as usize, *lda as usize, *ldb as usize);
+        let left = *side as u8 == b'L';
+        let (upper, unit) = (*uplo as u8 == b'U', *diag as u8 == b'U');
+        let dim = if left { m } else { n };
+        let a = std::slice::from_raw_parts(a, lda * dim);
+        let b = std::slice::from_raw_parts_mut(b, ldb * n);
+        b.iter_mut().for_each(|v| *v *= *alpha);
+        if left {
+            // op(A) * X = B, one column of B at a time.
+            for j in 0..n {
+                let col = &mut b[j * ldb..j * ldb + m];
+                trsv_ref(
+                    CblasColMajor,
+                    upper,
+                    is_trans(*transa),
+                    unit,
+                    m,
+                    a,
+                    lda,
+                    col,
+                    1,
+                );
+            }
+        } else {
+            // X * op(A) = B is op(A)^T * x = b for each row of B.
+            for i in 0..m {
+                let row = &mut b[i..];
+                trsv_ref(
+                    CblasColMajor,
+                    upper,
+                    !is_trans(*transa),
+                    unit,
+                    n,
+                    a,
+                    lda,
+                    row,
+                    ldb as i64,
+                );
+            }
+        }
+    }
+}
+
+fn counts() -> [usize; 4] {
+    [&DGEMM_CALLS, &DGEMV_CALLS, &DTRSM_CALLS, &DTRSV_CALLS].map(|c| c.load(Ordering::SeqCst))
+}
+
+// Provider slots are process-global, so every provider-backed case runs in
+// one test; the band solve below needs no provider.
+#[test]
+fn same_matrix_calls_run_as_level3() {
+    unsafe {
+        for (register, f) in [
+            (
+                cblas_inject_register_dgemv_lp64 as unsafe extern "C" fn(*const c_void) -> i32,
+                mock_dgemv as *const c_void,
+            ),
+            (
+                cblas_inject_register_dgemm_lp64,
+                mock_dgemm as *const c_void,
+            ),
+            (
+                cblas_inject_register_dtrsv_lp64,
+                mock_dtrsv as *const c_void,
+            ),
+            (
+                cblas_inject_register_dtrsm_lp64,
+                mock_dtrsm as *const c_void,
+            ),
+        ] {
+            assert_eq!(register(f), CBLAS_INJECT_STATUS_OK);
+        }
+    }
+    let incs: [(i64, i64); 4] = [(1, 1), (2, -1), (-3, 2), (1, 3)];
+
+    // GEMV: four calls, one GEMM.
+    for order in [CblasColMajor, CblasRowMajor] {
+        for trans in [CblasNoTrans, CblasTrans] {
+            let (m, n) = (7usize, 5usize);
+            let lda = if order == CblasColMajor { m } else { n } + 2;
+            let a = generate_vector_f64(lda * if order == CblasColMajor { n } else { m }, 1);
+            let t = trans == CblasTrans;
+            let (lenx, leny) = if t { (m, n) } else { (n, m) };
+            let xs: Vec<Vec<f64>> = incs.iter().map(|&(ix, _)| vector(lenx, ix, 2)).collect();
+            let mut ys: Vec<Vec<f64>> = incs.iter().map(|&(_, iy)| vector(leny, iy, 3)).collect();
+            let mut want = ys.clone();
+            for (c, &(incx, incy)) in incs.iter().enumerate() {
+                gemv_ref(
+                    order,
+                    t,
+                    (m, n),
+                    1.5,
+                    &a,
+                    lda,
+                    &xs[c],
+                    incx,
+                    0.5,
+                    &mut want[c],
+                    incy,
+                );
+            }
+            let before = ys.clone();
+            let [gemm, gemv, ..] = counts();
+            assert_eq!(cblas_inject_begin_coalesce(), CBLAS_INJECT_STATUS_OK);
+            for (c, &(incx, incy)) in incs.iter().enumerate() {
+                unsafe {
+                    cblas_dgemv(
+                        order,
+                        trans,
+                        m as i32,
+                        n as i32,
+                        1.5,
+                        a.as_ptr(),
+                        lda as i32,
+                        xs[c].as_ptr(),
+                        incx as i32,
+                        0.5,
+                        ys[c].as_mut_ptr(),
+                        incy as i32,
+                    )
+                };
+            }
+            assert_eq!(ys, before, "deferred until the flush");
+            assert_eq!(
+                unsafe { cblas_inject_flush_coalesce() },
+                CBLAS_INJECT_STATUS_OK
+            );
+            assert_eq!(counts()[..2], [gemm + 1, gemv]);
+            for c in 0..incs.len() {
+                assert_f64_eq(
+                    &ys[c],
+                    &want[c],
+                    1e-12,
+                    &format!("gemv {order:?} {trans:?} call {c}"),
+                );
+            }
+        }
+    }
+
+    // A call reading an earlier call's output, or with another alpha, starts
+    // a new group; single-call groups run as the original GEMV.
+    let n = 6usize;
+    let a = generate_vector_f64(n * n, 4);
+    let x = generate_vector_f64(n, 5);
+    let (mut y1, mut y2, mut y3) = (vec![0.0; n], vec![0.0; n], vec![0.0; n]);
+    let [gemm, gemv, ..] = counts();
+    cblas_inject_begin_coalesce();
+    unsafe {
+        let (n, ap) = (n as i32, a.as_ptr());
+        cblas_dgemv(
+            CblasColMajor,
+            CblasNoTrans,
+            n,
+            n,
+            1.0,
+            ap,
+            n,
+            x.as_ptr(),
+            1,
+            0.0,
+            y1.as_mut_ptr(),
+            1,
+        );
+        cblas_dgemv(
+            CblasColMajor,
+            CblasNoTrans,
+            n,
+            n,
+            1.0,
+            ap,
+            n,
+            y1.as_ptr(),
+            1,
+            0.0,
+            y2.as_mut_ptr(),
+            1,
+        );
+        cblas_dgemv(
+            CblasColMajor,
+            CblasNoTrans,
+            n,
+            n,
+            2.0,
+            ap,
+            n,
+            x.as_ptr(),
+            1,
+            0.0,
+            y3.as_mut_ptr(),
+            1,
+        );
+        cblas_inject_flush_coalesce();
+    }
+    assert_eq!(counts()[..2], [gemm, gemv + 3]);
+    let mut want1 = vec![0.0; n];
+    gemv_ref(
+        CblasColMajor,
+        false,
+        (n, n),
+        1.0,
+        &a,
+        n,
+        &x,
+        1,
+        0.0,
+        &mut want1,
+        1,
+    );
+    let mut want2 = vec![0.0; n];
+    gemv_ref(
+        CblasColMajor,
+        false,
+        (n, n),
+        1.0,
+        &a,
+        n,
+        &want1,
+        1,
+        0.0,
+        &mut want2,
+        1,
+    );
+    assert_f64_eq(&y1, &want1, 1e-12, "chained gemv 1");
+    assert_f64_eq(&y2, &want2, 1e-12, "chained gemv 2");
+    assert_f64_eq(
+        &y3,
+        &want1.iter().map(|v| 2.0 * v).collect::<Vec<_>>(),
+        1e-12,
+        "alpha 2",
+    );
+
+    // Outside a region calls run at once.
+    unsafe {
+        let (n, ap) = (n as i32, a.as_ptr());
+        cblas_dgemv(
+            CblasColMajor,
+            CblasNoTrans,
+            n,
+            n,
+            1.0,
+            ap,
+            n,
+            x.as_ptr(),
+            1,
+            0.0,
+            y1.as_mut_ptr(),
+            1,
+        );
+    }
+    assert_eq!(counts()[1], gemv + 4);
+
+    // An empty gemv leaves y alone, as a direct call does, whatever beta.
+    for beta in [0.0, 2.0] {
+        let mut ys = [vector(n, 1, 8), vector(n, 1, 9)];
+        let want = ys.clone();
+        let [gemm, gemv, ..] = counts();
+        cblas_inject_begin_coalesce();
+        unsafe {
+            for y in &mut ys {
+                let ap = a.as_ptr();
+                let (n, yp) = (n as i32, y.as_mut_ptr());
+                cblas_dgemv(
+                    CblasColMajor,
+                    CblasNoTrans,
+                    n,
+                    0,
+                    1.0,
+                    ap,
+                    n,
+                    x.as_ptr(),
+                    1,
+                    beta,
+                    yp,
+                    1,
+                );
+            }
+            cblas_inject_flush_coalesce();
+        }
+        assert_eq!(counts()[..2], [gemm, gemv + 2]);
+        assert_eq!(ys, want, "n = 0 gemv, beta {beta}");
+    }
+
+    // TRSV: three calls, one TRSM, through both integer widths.
+    for order in [CblasColMajor, CblasRowMajor] {
+        for (uplo, trans) in [(CblasLower, CblasNoTrans), (CblasUpper, CblasTrans)] {
+            for diag in [CblasNonUnit, CblasUnit] {
+                let n = 9usize;
+                let lda = n + 1;
+                let mut a = generate_vector_f64(lda * n, 6);
+                for i in 0..n {
+                    a[index(order, i, i, lda)] = 3.0 + i as f64;
+                }
+                let incs = [1i64, -2, 3];
+                let mut xs: Vec<Vec<f64>> = incs.iter().map(|&inc| vector(n, inc, 7)).collect();
+                let mut want = xs.clone();
+                for (c, &inc) in incs.iter().enumerate() {
+                    let (upper, t, unit) =
+                        (uplo == CblasUpper, trans == CblasTrans, diag == CblasUnit);
+                    trsv_ref(order, upper, t, unit, n, &a, lda, &mut want[c], inc);
+                }
+                let [.., trsm, trsv] = counts();
+                cblas_inject_begin_coalesce();
+                unsafe {
+                    let ap = a.as_ptr();
+                    let x0 = xs[0].as_mut_ptr();
+                    cblas_dtrsv(order, uplo, trans, diag, n as i32, ap, lda as i32, x0, 1);
+                    let x1 = xs[1].as_mut_ptr();
+                    cblas_dtrsv_64(order, uplo, trans, diag, n as i64, ap, lda as i64, x1, -2);
+                    let x2 = xs[2].as_mut_ptr();
+                    cblas_dtrsv(order, uplo, trans, diag, n as i32, ap, lda as i32, x2, 3);
+                    cblas_inject_flush_coalesce();
+                }
+                assert_eq!(counts()[2..], [trsm + 1, trsv]);
+                for c in 0..incs.len() {
+                    let what = format!("trsv {order:?} {uplo:?} {trans:?} {diag:?} call {c}");
+                    assert_f64_eq(&xs[c], &want[c], 1e-12, &what);
+                }
+            }
+        }
+    }
+}
+
+/// Reference `?tbsv` on a band in CBLAS layout, through the dense matrix.
+#[allow(clippy::too_many_arguments)]
+fn ztbsv_ref(
+    order: CBLAS_ORDER,
+    uplo: CBLAS_UPLO,
+    trans: CBLAS_TRANSPOSE,
+    diag: CBLAS_DIAG,
+    (n, k): (usize, usize),
+    ab: &[Complex64],
+    lda: usize,
+    x: &mut [Complex64],
+    inc: i64,
+) {
+    let upper = uplo == CblasUpper;
+    let dense = |i: usize, j: usize| {
+        let inside = if upper {
+            i <= j && j <= i + k
+        } else {
+            j <= i && i <= j + k
+        };
+        if !inside {
+            return Complex64::new(0.0, 0.0);
+        }
+        let offset = match (order, upper) {
+            (CblasColMajor, true) => k + i - j + j * lda,
+            (CblasColMajor, false) => i - j + j * lda,
+            (CblasRowMajor, true) => j - i + i * lda,
+            (CblasRowMajor, false) => k + j - i + i * lda,
+        };
+        ab[offset]
+    };
+    let (transposed, conj) = match trans {
+        CblasNoTrans => (false, false),
+        CblasTrans => (true, false),
+        CblasConjTrans => (true, true),
+        CblasConjNoTrans => (false, true),
+    };
+    let op = |i: usize, j: usize| {
+        let v = if transposed { dense(j, i) } else { dense(i, j) };
+        if conj {
+            v.conj()
+        } else {
+            v
+        }
+    };
+    let rows: Vec<usize> = if upper == transposed {
+        (0..n).collect()
+    } else {
+        (0..n).rev().collect()
+    };
+    for (step, &i) in rows.iter().enumerate() {
+        let mut v = x[element(n, inc, i)];
+        for &j in &rows[..step] {
+            v -= op(i, j) * x[element(n, inc, j)];
+        }
+        x[element(n, inc, i)] = if diag == CblasUnit { v } else { v / op(i, i) };
+    }
+}
+
+#[test]
+fn band_solves_run_natively() {
+    let (n, k) = (11usize, 3usize);
+    let lda = k + 2;
+    let incs = [1i64, -2, 3];
+    for order in [CblasColMajor, CblasRowMajor] {
+        for uplo in [CblasUpper, CblasLower] {
+            for trans in [CblasNoTrans, CblasTrans, CblasConjTrans, CblasConjNoTrans] {
+                for diag in [CblasNonUnit, CblasUnit] {
+                    let mut ab: Vec<Complex64> = generate_vector_f64(2 * lda * n, 8)
+                        .chunks(2)
+                        .map(|c| Complex64::new(c[0], c[1]))
+                        .collect();
+                    // The diagonal: dominant, or never read for a unit one.
+                    let diagonal = match (order, uplo) {
+                        (CblasColMajor, CblasUpper) | (CblasRowMajor, CblasLower) => k,
+                        _ => 0,
+                    };
+                    for i in 0..n {
+                        ab[diagonal + i * lda] = if diag == CblasUnit {
+                            Complex64::new(f64::NAN, f64::NAN)
+                        } else {
+                            Complex64::new(4.0, 1.0 + i as f64)
+                        };
+                    }
+                    let mut xs: Vec<Vec<Complex64>> = incs
+                        .iter()
+                        .map(|&inc| {
+                            let v = vector(n, inc, 9);
+                            v.iter().map(|&re| Complex64::new(re, 0.5 - re)).collect()
+                        })
+                        .collect();
+                    let mut want = xs.clone();
+                    for (c, &inc) in incs.iter().enumerate() {
+                        ztbsv_ref(
+                            order,
+                            uplo,
+                            trans,
+                            diag,
+                            (n, k),
+                            &ab,
+                            lda,
+                            &mut want[c],
+                            inc,
+                        );
+                    }
+                    cblas_inject_begin_coalesce();
+                    for (c, &inc) in incs.iter().enumerate() {
+                        unsafe {
+                            cblas_ztbsv(
+                                order,
+                                uplo,
+                                trans,
+                                diag,
+                                n as i32,
+                                k as i32,
+                                ab.as_ptr().cast(),
+                                lda as i32,
+                                xs[c].as_mut_ptr().cast(),
+                                inc as i32,
+                            )
+                        };
+                    }
+                    unsafe { cblas_inject_flush_coalesce() };
+                    for c in 0..incs.len() {
+                        for (j, (g, w)) in xs[c].iter().zip(&want[c]).enumerate() {
+                            assert!(
+                                (g - w).norm() <= 1e-12 * w.norm().max(1.0),
+                                "{order:?} {uplo:?} {trans:?} {diag:?} call {c} [{j}]: {g:?} != {w:?}"
+                            );
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -160,6 +160,22 @@ pub fn calc_vector_storage_size(len: usize, inc: blasint) -> usize {
     }
 }
 
+/// Storage index of element (i, j) for `order` and leading dimension `ld`.
+pub fn index(order: CBLAS_ORDER, i: usize, j: usize, ld: usize) -> usize {
+    match order {
+        CblasColMajor => i + j * ld,
+        CblasRowMajor => i * ld + j,
+    }
+}
+
+/// Whether element (i, j) is in the `uplo` triangle.
+pub fn in_triangle(uplo: CBLAS_UPLO, i: usize, j: usize) -> bool {
+    match uplo {
+        cblas_inject::CblasUpper => i <= j,
+        cblas_inject::CblasLower => i >= j,
+    }
+}
+
 /// Compare two f64 slices with tolerance
 #[allow(dead_code)]
 pub fn assert_f64_eq(got: &[f64], expected: &[f64], tol: f64, context: &str) {
@@ -276,6 +292,43 @@ pub fn assert_complex32_eq_strided(
     }
 }
 
+// =============================================================================
+// Provider helpers
+// =============================================================================
+
+/// An LP64 Fortran BLAS to load: `CBLAS_INJECT_TEST_PROVIDER`, or OpenBLAS.
+pub fn provider_library() -> Option<String> {
+    if let Ok(path) = std::env::var("CBLAS_INJECT_TEST_PROVIDER") {
+        return Some(path);
+    }
+    ["libopenblas.so.0", "libopenblas.so", "libopenblas.dylib"]
+        .into_iter()
+        .find(|name| unsafe { libloading::Library::new(name) }.is_ok())
+        .map(str::to_owned)
+}
+
+/// Run `call` on a copy of `c` after `set(values[0])` and on another copy
+/// after `set(values[1])`, checking that both settings are accepted, and
+/// return both results.
+pub fn run_with_settings<T: Clone>(
+    c: &[T],
+    set: extern "C" fn(i32) -> i32,
+    values: [i32; 2],
+    call: impl Fn(&mut [T]),
+) -> (Vec<T>, Vec<T>) {
+    let [before, after] = values.map(|value| {
+        assert_eq!(
+            set(value),
+            cblas_inject::CBLAS_INJECT_STATUS_OK,
+            "setting {value}"
+        );
+        let mut out = c.to_vec();
+        call(&mut out);
+        out
+    });
+    (before, after)
+}
+
 // =============================================================================
 // Macro helpers
 // =============================================================================
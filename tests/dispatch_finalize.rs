@@ -0,0 +1,123 @@
+#![cfg(not(feature = "openblas"))]
+
+use std::ffi::c_void;
+use std::sync::atomic::{AtomicI64, AtomicUsize, Ordering};
+
+use cblas_inject::{
+    cblas_ddot, cblas_ddot_64, cblas_dnrm2, cblas_inject_finalize, cblas_inject_is_finalized,
+    cblas_inject_register_ddot_ilp64, cblas_inject_register_ddot_lp64,
+    cblas_inject_register_dnrm2_lp64, cblas_inject_register_zdotc_ilp64, cblas_zdotc_sub,
+    set_complex_return_style, BlasInt32, BlasInt64, ComplexReturnStyle,
+    CBLAS_INJECT_STATUS_ALREADY_FINALIZED, CBLAS_INJECT_STATUS_OK,
+};
+use num_complex::Complex64;
+
+static DDOT_LP64_CALLS: AtomicUsize = AtomicUsize::new(0);
+static DDOT_ILP64_CALLS: AtomicUsize = AtomicUsize::new(0);
+static DNRM2_CALLS: AtomicUsize = AtomicUsize::new(0);
+static ZDOTC_CALLS: AtomicUsize = AtomicUsize::new(0);
+static ZDOTC_N: AtomicI64 = AtomicI64::new(0);
+
+unsafe extern "C" fn mock_ddot_lp64(
+    n: *const BlasInt32,
+    _x: *const f64,
+    _incx: *const BlasInt32,
+    _y: *const f64,
+    _incy: *const BlasInt32,
+) -> f64 {
+    DDOT_LP64_CALLS.fetch_add(1, Ordering::SeqCst);
+    f64::from(unsafe { *n }) * 2.0
+}
+
+unsafe extern "C" fn mock_ddot_ilp64(
+    _n: *const BlasInt64,
+    _x: *const f64,
+    _incx: *const BlasInt64,
+    _y: *const f64,
+    _incy: *const BlasInt64,
+) -> f64 {
+    DDOT_ILP64_CALLS.fetch_add(1, Ordering::SeqCst);
+    -1.0
+}
+
+unsafe extern "C" fn mock_dnrm2_lp64(
+    _n: *const BlasInt32,
+    _x: *const f64,
+    _incx: *const BlasInt32,
+) -> f64 {
+    DNRM2_CALLS.fetch_add(1, Ordering::SeqCst);
+    5.0
+}
+
+unsafe extern "C" fn mock_zdotc_hidden_ilp64(
+    ret: *mut Complex64,
+    n: *const BlasInt64,
+    _x: *const Complex64,
+    _incx: *const BlasInt64,
+    _y: *const Complex64,
+    _incy: *const BlasInt64,
+) {
+    ZDOTC_CALLS.fetch_add(1, Ordering::SeqCst);
+    ZDOTC_N.store(unsafe { *n }, Ordering::SeqCst);
+    unsafe {
+        *ret = Complex64::new(3.0, -4.0);
+    }
+}
+
+#[test]
+fn finalize_freezes_resolved_providers_and_keeps_late_slots_lazy() {
+    let x = [1.0f64; 4];
+    let zx = [Complex64::new(1.0, 0.0); 4];
+    let mut dot = Complex64::new(0.0, 0.0);
+
+    unsafe {
+        set_complex_return_style(ComplexReturnStyle::HiddenArgument);
+        assert_eq!(
+            cblas_inject_register_ddot_lp64(mock_ddot_lp64 as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(
+            cblas_inject_register_zdotc_ilp64(mock_zdotc_hidden_ilp64 as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+
+        assert_eq!(cblas_inject_is_finalized(), 0);
+        assert_eq!(cblas_ddot(4, x.as_ptr(), 1, x.as_ptr(), 1), 8.0);
+        cblas_zdotc_sub(4, zx.as_ptr(), 1, zx.as_ptr(), 1, &mut dot);
+        assert_eq!(dot, Complex64::new(3.0, -4.0));
+        assert_eq!(ZDOTC_N.load(Ordering::SeqCst), 4);
+
+        assert_eq!(cblas_inject_finalize(), CBLAS_INJECT_STATUS_OK);
+        assert_eq!(cblas_inject_is_finalized(), 1);
+        assert_eq!(
+            cblas_inject_finalize(),
+            CBLAS_INJECT_STATUS_ALREADY_FINALIZED
+        );
+
+        // Frozen slots dispatch through the table with the ABI and style applied.
+        assert_eq!(cblas_ddot(3, x.as_ptr(), 1, x.as_ptr(), 1), 6.0);
+        dot = Complex64::new(0.0, 0.0);
+        cblas_zdotc_sub(2, zx.as_ptr(), 1, zx.as_ptr(), 1, &mut dot);
+        assert_eq!(dot, Complex64::new(3.0, -4.0));
+        assert_eq!(ZDOTC_N.load(Ordering::SeqCst), 2);
+        assert_eq!(ZDOTC_CALLS.load(Ordering::SeqCst), 2);
+
+        // A resolved slot is never re-resolved: the ILP64 CBLAS ddot was frozen
+        // onto the LP64 provider, so a later ILP64 registration is not used.
+        assert_eq!(
+            cblas_inject_register_ddot_ilp64(mock_ddot_ilp64 as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(cblas_ddot_64(2, x.as_ptr(), 1, x.as_ptr(), 1), 4.0);
+        assert_eq!(DDOT_ILP64_CALLS.load(Ordering::SeqCst), 0);
+        assert_eq!(DDOT_LP64_CALLS.load(Ordering::SeqCst), 3);
+
+        // A slot that was empty at finalize time still resolves lazily.
+        assert_eq!(
+            cblas_inject_register_dnrm2_lp64(mock_dnrm2_lp64 as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(cblas_dnrm2(4, x.as_ptr(), 1), 5.0);
+        assert_eq!(DNRM2_CALLS.load(Ordering::SeqCst), 1);
+    }
+}
@@ -0,0 +1,259 @@
+#![cfg(not(feature = "openblas"))]
+
+use std::ffi::{c_char, c_void};
+use std::mem;
+use std::sync::atomic::{AtomicI32, AtomicUsize, Ordering};
+
+use cblas_inject::{
+    cblas_cgemm, cblas_cgemm3m, cblas_inject_gemm3m_min_flops, cblas_inject_pop_provider_scope,
+    cblas_inject_push_provider_scope, cblas_inject_register_cgemm3m_lp64,
+    cblas_inject_register_cgemm_lp64, cblas_inject_register_zgemm3m_lp64,
+    cblas_inject_register_zgemm_lp64, cblas_inject_set_gemm3m_min_flops, cblas_zgemm,
+    cblas_zgemm3m, cblas_zgemm3m_64, BlasInt32, CblasColMajor, CblasInjectProviderTable,
+    CblasNoTrans, CblasRowMajor, CblasTrans, CBLAS_INJECT_ABI_LP64,
+    CBLAS_INJECT_PROVIDER_TABLE_VERSION, CBLAS_INJECT_STATUS_INVALID_ARGUMENT,
+    CBLAS_INJECT_STATUS_OK,
+};
+use num_complex::{Complex32, Complex64};
+
+static CGEMM_CALLS: AtomicUsize = AtomicUsize::new(0);
+static CGEMM3M_CALLS: AtomicUsize = AtomicUsize::new(0);
+static ZGEMM_CALLS: AtomicUsize = AtomicUsize::new(0);
+static ZGEMM3M_CALLS: AtomicUsize = AtomicUsize::new(0);
+static SCOPED_ZGEMM_CALLS: AtomicUsize = AtomicUsize::new(0);
+static LAST_M: AtomicI32 = AtomicI32::new(0);
+static LAST_TRANSA: AtomicI32 = AtomicI32::new(0);
+
+macro_rules! mock_gemm {
+    ($name:ident, $t:ty, $calls:ident) => {
+        unsafe extern "C" fn $name(
+            transa: *const c_char,
+            _transb: *const c_char,
+            m: *const BlasInt32,
+            _n: *const BlasInt32,
+            _k: *const BlasInt32,
+            _alpha: *const $t,
+            _a: *const $t,
+            _lda: *const BlasInt32,
+            _b: *const $t,
+            _ldb: *const BlasInt32,
+            _beta: *const $t,
+            _c: *mut $t,
+            _ldc: *const BlasInt32,
+        ) {
+            $calls.fetch_add(1, Ordering::SeqCst);
+            LAST_M.store(unsafe { *m }, Ordering::SeqCst);
+            LAST_TRANSA.store(i32::from(unsafe { *transa } as u8), Ordering::SeqCst);
+        }
+    };
+}
+
+mock_gemm!(mock_cgemm, Complex32, CGEMM_CALLS);
+mock_gemm!(mock_cgemm3m, Complex32, CGEMM3M_CALLS);
+mock_gemm!(mock_zgemm, Complex64, ZGEMM_CALLS);
+mock_gemm!(mock_zgemm3m, Complex64, ZGEMM3M_CALLS);
+mock_gemm!(scoped_zgemm, Complex64, SCOPED_ZGEMM_CALLS);
+
+fn zgemm(m: i32, n: i32, k: i32, three_m: bool) {
+    let one = Complex64::new(1.0, 0.0);
+    let a = vec![one; 64];
+    let b = vec![one; 64];
+    let mut c = vec![Complex64::default(); 64];
+    let f = if three_m { cblas_zgemm3m } else { cblas_zgemm };
+    unsafe {
+        f(
+            CblasColMajor,
+            CblasNoTrans,
+            CblasNoTrans,
+            m,
+            n,
+            k,
+            &one,
+            a.as_ptr(),
+            8,
+            b.as_ptr(),
+            8,
+            &one,
+            c.as_mut_ptr(),
+            8,
+        );
+    }
+}
+
+fn calls() -> [usize; 4] {
+    [&CGEMM_CALLS, &CGEMM3M_CALLS, &ZGEMM_CALLS, &ZGEMM3M_CALLS].map(|c| c.load(Ordering::SeqCst))
+}
+
+#[test]
+fn gemm3m_entry_points_and_flop_policy() {
+    unsafe {
+        assert_eq!(
+            cblas_inject_register_cgemm_lp64(mock_cgemm as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(
+            cblas_inject_register_zgemm_lp64(mock_zgemm as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+    }
+
+    // Without a 3M provider the 3M entry point runs the regular GEMM.
+    zgemm(4, 4, 4, true);
+    assert_eq!(calls(), [0, 0, 1, 0]);
+
+    unsafe {
+        assert_eq!(
+            cblas_inject_register_cgemm3m_lp64(mock_cgemm3m as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(
+            cblas_inject_register_zgemm3m_lp64(mock_zgemm3m as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+    }
+    zgemm(4, 4, 4, true);
+    assert_eq!(calls(), [0, 0, 1, 1]);
+    // The policy is off by default.
+    zgemm(8, 8, 8, false);
+    assert_eq!(calls(), [0, 0, 2, 1]);
+
+    assert_eq!(cblas_inject_gemm3m_min_flops(), 0.0);
+    assert_eq!(
+        cblas_inject_set_gemm3m_min_flops(-1.0),
+        CBLAS_INJECT_STATUS_INVALID_ARGUMENT
+    );
+    assert_eq!(
+        cblas_inject_set_gemm3m_min_flops(f64::NAN),
+        CBLAS_INJECT_STATUS_INVALID_ARGUMENT
+    );
+    assert_eq!(
+        cblas_inject_set_gemm3m_min_flops(8.0 * 64.0),
+        CBLAS_INJECT_STATUS_OK
+    );
+    assert_eq!(cblas_inject_gemm3m_min_flops(), 512.0);
+
+    zgemm(4, 4, 4, false);
+    assert_eq!(calls(), [0, 0, 2, 2]);
+    zgemm(4, 4, 3, false);
+    assert_eq!(calls(), [0, 0, 3, 2]);
+
+    // A provider scope with its own zgemm but no 3M routine keeps its zgemm
+    // above the threshold; one without a zgemm still gets the global 3M.
+    let mut scope: CblasInjectProviderTable = unsafe { mem::zeroed() };
+    scope.version = CBLAS_INJECT_PROVIDER_TABLE_VERSION;
+    scope.abi = CBLAS_INJECT_ABI_LP64;
+    scope.zgemm = scoped_zgemm as *const c_void;
+    let size = mem::size_of::<CblasInjectProviderTable>();
+    assert_eq!(
+        unsafe { cblas_inject_push_provider_scope(&scope, size) },
+        CBLAS_INJECT_STATUS_OK
+    );
+    zgemm(4, 4, 4, false);
+    assert_eq!(calls(), [0, 0, 3, 2]);
+    assert_eq!(SCOPED_ZGEMM_CALLS.load(Ordering::SeqCst), 1);
+    let empty = CblasInjectProviderTable {
+        zgemm: std::ptr::null(),
+        ..scope
+    };
+    assert_eq!(
+        unsafe { cblas_inject_push_provider_scope(&empty, size) },
+        CBLAS_INJECT_STATUS_OK
+    );
+    zgemm(4, 4, 4, false);
+    assert_eq!(SCOPED_ZGEMM_CALLS.load(Ordering::SeqCst), 2);
+    assert_eq!(cblas_inject_pop_provider_scope(), CBLAS_INJECT_STATUS_OK);
+    assert_eq!(cblas_inject_pop_provider_scope(), CBLAS_INJECT_STATUS_OK);
+
+    let empty = CblasInjectProviderTable {
+        zgemm: std::ptr::null(),
+        ..scope
+    };
+    assert_eq!(
+        unsafe { cblas_inject_push_provider_scope(&empty, size) },
+        CBLAS_INJECT_STATUS_OK
+    );
+    zgemm(4, 4, 4, false);
+    assert_eq!(calls(), [0, 0, 3, 3]);
+    assert_eq!(cblas_inject_pop_provider_scope(), CBLAS_INJECT_STATUS_OK);
+    zgemm(4, 4, 4, false);
+    assert_eq!(calls(), [0, 0, 3, 4]);
+
+    // Row-major calls reach the 3M provider with the GEMM operand swap.
+    let one = Complex32::new(1.0, 0.0);
+    let a = vec![one; 64];
+    let b = vec![one; 64];
+    let mut c = vec![Complex32::default(); 64];
+    unsafe {
+        cblas_cgemm(
+            CblasRowMajor,
+            CblasTrans,
+            CblasNoTrans,
+            8,
+            6,
+            4,
+            &one,
+            a.as_ptr(),
+            8,
+            b.as_ptr(),
+            8,
+            &one,
+            c.as_mut_ptr(),
+            8,
+        );
+    }
+    assert_eq!(calls(), [0, 1, 3, 4]);
+    assert_eq!(LAST_M.load(Ordering::SeqCst), 6);
+    assert_eq!(LAST_TRANSA.load(Ordering::SeqCst), i32::from(b'N'));
+    unsafe {
+        cblas_cgemm3m(
+            CblasColMajor,
+            CblasNoTrans,
+            CblasNoTrans,
+            1,
+            1,
+            1,
+            &one,
+            a.as_ptr(),
+            8,
+            b.as_ptr(),
+            8,
+            &one,
+            c.as_mut_ptr(),
+            8,
+        );
+    }
+    assert_eq!(calls(), [0, 2, 3, 4]);
+
+    // The ILP64 entry point narrows onto the LP64 3M provider.
+    let one = Complex64::new(1.0, 0.0);
+    let a = vec![one; 64];
+    let b = vec![one; 64];
+    let mut c = vec![Complex64::default(); 64];
+    unsafe {
+        cblas_zgemm3m_64(
+            CblasColMajor,
+            CblasNoTrans,
+            CblasNoTrans,
+            5,
+            2,
+            2,
+            &one,
+            a.as_ptr(),
+            8,
+            b.as_ptr(),
+            8,
+            &one,
+            c.as_mut_ptr(),
+            8,
+        );
+    }
+    assert_eq!(calls(), [0, 2, 3, 5]);
+    assert_eq!(LAST_M.load(Ordering::SeqCst), 5);
+
+    assert_eq!(
+        cblas_inject_set_gemm3m_min_flops(0.0),
+        CBLAS_INJECT_STATUS_OK
+    );
+    zgemm(8, 8, 8, false);
+    assert_eq!(calls(), [0, 2, 4, 5]);
+}
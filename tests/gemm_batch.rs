@@ -0,0 +1,359 @@
+#![cfg(not(feature = "openblas"))]
+
+use std::ffi::{c_char, c_void};
+use std::sync::atomic::{AtomicUsize, Ordering};
+
+use cblas_inject::{
+    cblas_dgemm_batch, cblas_dgemm_batch_strided_64, cblas_inject_register_dgemm_lp64,
+    cblas_inject_set_small_gemm_max_dim, cblas_inject_set_worker_threads,
+    cblas_inject_worker_threads, cblas_zgemm_batch_strided, BlasInt32, CblasColMajor, CblasNoTrans,
+    CblasRowMajor, CblasTrans, CBLAS_INJECT_STATUS_INVALID_ARGUMENT, CBLAS_INJECT_STATUS_OK,
+    CBLAS_ORDER, CBLAS_TRANSPOSE,
+};
+use num_complex::Complex64;
+
+mod common;
+use common::generate_vector_f64;
+
+static DGEMM_CALLS: AtomicUsize = AtomicUsize::new(0);
+
+/// Reference column-major Fortran dgemm for 'N' and 'T'.
+unsafe extern "C" fn mock_dgemm_lp64(
+    transa: *const c_char,
+    transb: *const c_char,
+    m: *const BlasInt32,
+    n: *const BlasInt32,
+    k: *const BlasInt32,
+    alpha: *const f64,
+    a: *const f64,
+    lda: *const BlasInt32,
+    b: *const f64,
+    ldb: *const BlasInt32,
+    beta: *const f64,
+    c: *mut f64,
+    ldc: *const BlasInt32,
+) {
+    DGEMM_CALLS.fetch_add(1, Ordering::SeqCst);
+    let (m, n, k) = (*m as usize, *n as usize, *k as usize);
+    let (lda, ldb, ldc) = (*lda as usize, *ldb as usize, *ldc as usize);
+    let ta = *transa as u8 == b'T';
+    let tb = *transb as u8 == b'T';
+    for j in 0..n {
+        for i in 0..m {
+            let mut sum = 0.0;
+            for l in 0..k {
+                let a_il = if ta {
+                    *a.add(l + i * lda)
+                } else {
+                    *a.add(i + l * lda)
+                };
+                let b_lj = if tb {
+                    *b.add(j + l * ldb)
+                } else {
+                    *b.add(l + j * ldb)
+                };
+                sum += a_il * b_lj;
+            }
+            let c_ij = c.add(i + j * ldc);
+            *c_ij = *alpha * sum + *beta * *c_ij;
+        }
+    }
+}
+
+/// `C = alpha * op(A) * op(B) + beta * C` with entries fetched through `at`.
+#[allow(clippy::too_many_arguments)]
+fn reference<T>(
+    order: CBLAS_ORDER,
+    ta: CBLAS_TRANSPOSE,
+    tb: CBLAS_TRANSPOSE,
+    m: usize,
+    n: usize,
+    k: usize,
+    alpha: T,
+    a: &[T],
+    lda: usize,
+    b: &[T],
+    ldb: usize,
+    beta: T,
+    c: &mut [T],
+    ldc: usize,
+) where
+    T: Copy + Default + std::ops::Add<Output = T> + std::ops::Mul<Output = T>,
+{
+    let at = |x: &[T], trans: CBLAS_TRANSPOSE, ld: usize, i: usize, j: usize| {
+        let (r, c) = if trans == CblasNoTrans {
+            (i, j)
+        } else {
+            (j, i)
+        };
+        if order == CblasColMajor {
+            x[r + c * ld]
+        } else {
+            x[r * ld + c]
+        }
+    };
+    for i in 0..m {
+        for j in 0..n {
+            let mut sum = T::default();
+            for l in 0..k {
+                sum = sum + at(a, ta, lda, i, l) * at(b, tb, ldb, l, j);
+            }
+            let idx = if order == CblasColMajor {
+                i + j * ldc
+            } else {
+                i * ldc + j
+            };
+            c[idx] = alpha * sum + beta * c[idx];
+        }
+    }
+}
+
+// Worker threads and the small GEMM crossover are process-global, so the
+// checks run in sequence.
+#[test]
+fn batched_gemm_matches_per_item_reference() {
+    unsafe {
+        assert_eq!(
+            cblas_inject_register_dgemm_lp64(mock_dgemm_lp64 as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        grouped_row_major_batch();
+        strided_batch_on_worker_pool();
+        strided_complex_batch_runs_natively();
+    }
+}
+
+unsafe fn grouped_row_major_batch() {
+    // Group 0: two 3x2 products of A (3x4) and B (4x2).
+    // Group 1: three 2x3 products of A^T (A is 2x2) and B (2x3).
+    let transa = [CblasNoTrans, CblasTrans];
+    let transb = [CblasNoTrans, CblasNoTrans];
+    let (m, n, k) = ([3, 2], [2, 3], [4, 2]);
+    let (lda, ldb, ldc) = ([4, 2], [2, 3], [2, 3]);
+    let alpha = [1.5, -1.0];
+    let beta = [0.0, 0.5];
+    let group_size = [2, 3];
+
+    let sizes = [(12, 8, 6), (12, 8, 6), (4, 6, 6), (4, 6, 6), (4, 6, 6)];
+    let a: Vec<Vec<f64>> = sizes
+        .iter()
+        .enumerate()
+        .map(|(i, s)| generate_vector_f64(s.0, i))
+        .collect();
+    let b: Vec<Vec<f64>> = sizes
+        .iter()
+        .enumerate()
+        .map(|(i, s)| generate_vector_f64(s.1, i + 3))
+        .collect();
+    let c0: Vec<Vec<f64>> = sizes
+        .iter()
+        .enumerate()
+        .map(|(i, s)| generate_vector_f64(s.2, i + 5))
+        .collect();
+    let mut c = c0.clone();
+
+    let a_ptrs: Vec<*const f64> = a.iter().map(|x| x.as_ptr()).collect();
+    let b_ptrs: Vec<*const f64> = b.iter().map(|x| x.as_ptr()).collect();
+    let c_ptrs: Vec<*mut f64> = c.iter_mut().map(|x| x.as_mut_ptr()).collect();
+
+    let before = DGEMM_CALLS.load(Ordering::SeqCst);
+    cblas_dgemm_batch(
+        CblasRowMajor,
+        transa.as_ptr(),
+        transb.as_ptr(),
+        m.as_ptr(),
+        n.as_ptr(),
+        k.as_ptr(),
+        alpha.as_ptr(),
+        a_ptrs.as_ptr(),
+        lda.as_ptr(),
+        b_ptrs.as_ptr(),
+        ldb.as_ptr(),
+        beta.as_ptr(),
+        c_ptrs.as_ptr(),
+        ldc.as_ptr(),
+        2,
+        group_size.as_ptr(),
+    );
+    assert_eq!(DGEMM_CALLS.load(Ordering::SeqCst), before + 5);
+
+    for item in 0..5 {
+        let g = usize::from(item >= 2);
+        let mut expected = c0[item].clone();
+        reference(
+            CblasRowMajor,
+            transa[g],
+            transb[g],
+            m[g] as usize,
+            n[g] as usize,
+            k[g] as usize,
+            alpha[g],
+            &a[item],
+            lda[g] as usize,
+            &b[item],
+            ldb[g] as usize,
+            beta[g],
+            &mut expected,
+            ldc[g] as usize,
+        );
+        assert_eq!(c[item], expected, "item {item}");
+    }
+
+    // A negative group count is reported and nothing runs.
+    cblas_dgemm_batch(
+        CblasRowMajor,
+        transa.as_ptr(),
+        transb.as_ptr(),
+        m.as_ptr(),
+        n.as_ptr(),
+        k.as_ptr(),
+        alpha.as_ptr(),
+        a_ptrs.as_ptr(),
+        lda.as_ptr(),
+        b_ptrs.as_ptr(),
+        ldb.as_ptr(),
+        beta.as_ptr(),
+        c_ptrs.as_ptr(),
+        ldc.as_ptr(),
+        -1,
+        group_size.as_ptr(),
+    );
+    assert_eq!(DGEMM_CALLS.load(Ordering::SeqCst), before + 5);
+}
+
+unsafe fn strided_batch_on_worker_pool() {
+    assert_eq!(cblas_inject_worker_threads(), 0);
+    assert_eq!(
+        cblas_inject_set_worker_threads(-1),
+        CBLAS_INJECT_STATUS_INVALID_ARGUMENT
+    );
+    assert_eq!(cblas_inject_set_worker_threads(4), CBLAS_INJECT_STATUS_OK);
+    assert_eq!(cblas_inject_worker_threads(), 4);
+
+    let (m, n, k) = (5usize, 4usize, 3usize);
+    let (stridea, strideb, stridec) = (m * k + 1, k * n, m * n + 2);
+    let batch = 37;
+    let a = generate_vector_f64(stridea * batch, 1);
+    let b = generate_vector_f64(strideb * batch, 2);
+    let c0 = generate_vector_f64(stridec * batch, 3);
+
+    for _ in 0..3 {
+        let mut c = c0.clone();
+        let before = DGEMM_CALLS.load(Ordering::SeqCst);
+        cblas_dgemm_batch_strided_64(
+            CblasColMajor,
+            CblasTrans,
+            CblasNoTrans,
+            m as i64,
+            n as i64,
+            k as i64,
+            2.0,
+            a.as_ptr(),
+            k as i64,
+            stridea as i64,
+            b.as_ptr(),
+            k as i64,
+            strideb as i64,
+            -1.0,
+            c.as_mut_ptr(),
+            m as i64,
+            stridec as i64,
+            batch as i64,
+        );
+        assert_eq!(DGEMM_CALLS.load(Ordering::SeqCst), before + batch);
+
+        let mut expected = c0.clone();
+        for i in 0..batch {
+            reference(
+                CblasColMajor,
+                CblasTrans,
+                CblasNoTrans,
+                m,
+                n,
+                k,
+                2.0,
+                &a[i * stridea..],
+                k,
+                &b[i * strideb..],
+                k,
+                -1.0,
+                &mut expected[i * stridec..],
+                m,
+            );
+        }
+        assert_eq!(c, expected);
+    }
+
+    assert_eq!(cblas_inject_set_worker_threads(0), CBLAS_INJECT_STATUS_OK);
+}
+
+unsafe fn strided_complex_batch_runs_natively() {
+    // No zgemm is registered: every item must take the native path.
+    assert_eq!(
+        cblas_inject_set_small_gemm_max_dim(8),
+        CBLAS_INJECT_STATUS_OK
+    );
+    let (m, n, k) = (3usize, 2usize, 4usize);
+    let batch = 4;
+    let z = |v: Vec<f64>| -> Vec<Complex64> {
+        v.chunks(2).map(|p| Complex64::new(p[0], p[1])).collect()
+    };
+    let a = z(generate_vector_f64(2 * m * k * batch, 4));
+    let b = z(generate_vector_f64(2 * k * n * batch, 5));
+    let c0 = z(generate_vector_f64(2 * m * n * batch, 6));
+    let alpha = Complex64::new(0.5, 1.0);
+    let beta = Complex64::new(-1.0, 0.25);
+
+    let mut c = c0.clone();
+    cblas_zgemm_batch_strided(
+        CblasRowMajor,
+        CblasNoTrans,
+        CblasNoTrans,
+        m as i32,
+        n as i32,
+        k as i32,
+        &alpha,
+        a.as_ptr(),
+        k as i32,
+        (m * k) as i32,
+        b.as_ptr(),
+        n as i32,
+        (k * n) as i32,
+        &beta,
+        c.as_mut_ptr(),
+        n as i32,
+        (m * n) as i32,
+        batch as i32,
+    );
+
+    let mut expected = c0.clone();
+    for i in 0..batch {
+        reference(
+            CblasRowMajor,
+            CblasNoTrans,
+            CblasNoTrans,
+            m,
+            n,
+            k,
+            alpha,
+            &a[i * m * k..],
+            k,
+            &b[i * k * n..],
+            n,
+            beta,
+            &mut expected[i * m * n..],
+            n,
+        );
+    }
+    for (idx, (got, want)) in c.iter().zip(&expected).enumerate() {
+        assert!(
+            (got - want).norm_sqr() < 1e-20,
+            "at {idx}: {got:?} != {want:?}"
+        );
+    }
+
+    assert_eq!(
+        cblas_inject_set_small_gemm_max_dim(0),
+        CBLAS_INJECT_STATUS_OK
+    );
+}
@@ -0,0 +1,247 @@
+#![cfg(not(feature = "openblas"))]
+
+use std::ffi::{c_char, c_void, CString};
+use std::sync::atomic::{AtomicI32, AtomicUsize, Ordering};
+
+use cblas_inject::{
+    cblas_dgemm, cblas_dgemmt, cblas_dgemmt_64, cblas_inject_load_provider,
+    cblas_inject_register_sgemmt_lp64, cblas_inject_set_worker_threads, cblas_sgemmt, cblas_zgemm,
+    cblas_zgemmt, BlasInt32, CblasColMajor, CblasConjTrans, CblasLower, CblasNoTrans,
+    CblasRowMajor, CblasTrans, CblasUpper, CBLAS_INJECT_ABI_LP64, CBLAS_INJECT_STATUS_OK,
+};
+use num_complex::Complex64;
+
+mod common;
+use common::{
+    generate_vector_complex64, generate_vector_f64, in_triangle, index, provider_library,
+};
+
+static SGEMMT_CALLS: AtomicUsize = AtomicUsize::new(0);
+static LAST_FLAGS: AtomicI32 = AtomicI32::new(0);
+static LAST_LDA: AtomicI32 = AtomicI32::new(0);
+
+unsafe extern "C" fn mock_sgemmt(
+    uplo: *const c_char,
+    transa: *const c_char,
+    transb: *const c_char,
+    _n: *const BlasInt32,
+    _k: *const BlasInt32,
+    _alpha: *const f32,
+    _a: *const f32,
+    lda: *const BlasInt32,
+    _b: *const f32,
+    _ldb: *const BlasInt32,
+    _beta: *const f32,
+    _c: *mut f32,
+    _ldc: *const BlasInt32,
+) {
+    SGEMMT_CALLS.fetch_add(1, Ordering::SeqCst);
+    let flags = unsafe { [*uplo, *transa, *transb] }.map(|f| f as u8);
+    LAST_FLAGS.store(
+        i32::from_be_bytes([0, flags[0], flags[1], flags[2]]),
+        Ordering::SeqCst,
+    );
+    LAST_LDA.store(unsafe { *lda }, Ordering::SeqCst);
+}
+
+// The provider slots and worker pool are process-global, so everything runs
+// in one test.
+#[test]
+fn gemmt_updates_one_triangle() {
+    unsafe {
+        assert_eq!(
+            cblas_inject_register_sgemmt_lp64(mock_sgemmt as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+    }
+    // A registered gemmt gets the call as is; row-major flips the triangle
+    // and swaps the operands.
+    let (a, b, mut c) = (vec![1.0f32; 64], vec![1.0f32; 64], vec![0.0f32; 64]);
+    unsafe {
+        cblas_sgemmt(
+            CblasRowMajor,
+            CblasUpper,
+            CblasTrans,
+            CblasNoTrans,
+            4,
+            3,
+            1.0,
+            a.as_ptr(),
+            5,
+            b.as_ptr(),
+            6,
+            0.0,
+            c.as_mut_ptr(),
+            8,
+        );
+    }
+    assert_eq!(SGEMMT_CALLS.load(Ordering::SeqCst), 1);
+    assert_eq!(
+        LAST_FLAGS.load(Ordering::SeqCst),
+        i32::from_be_bytes([0, b'L', b'N', b'T'])
+    );
+    assert_eq!(LAST_LDA.load(Ordering::SeqCst), 6);
+
+    let Some(library) = provider_library() else {
+        eprintln!("no Fortran BLAS library found; skipping the gemm fallback");
+        return;
+    };
+    let library = CString::new(library).unwrap();
+    assert_eq!(
+        unsafe { cblas_inject_load_provider(library.as_ptr(), CBLAS_INJECT_ABI_LP64) },
+        CBLAS_INJECT_STATUS_OK
+    );
+    assert_eq!(cblas_inject_set_worker_threads(3), CBLAS_INJECT_STATUS_OK);
+
+    // n = 300 spans two full blocks and a partial one.
+    let (n, k) = (300usize, 5usize);
+    let ld = n + 1;
+    for order in [CblasColMajor, CblasRowMajor] {
+        for uplo in [CblasUpper, CblasLower] {
+            for (transa, transb) in [
+                (CblasNoTrans, CblasNoTrans),
+                (CblasTrans, CblasNoTrans),
+                (CblasNoTrans, CblasTrans),
+            ] {
+                let context = format!("dgemmt {order:?} {uplo:?} {transa:?} {transb:?}");
+                let a = generate_vector_f64(ld * n, 1);
+                let b = generate_vector_f64(ld * n, 2);
+                let c = generate_vector_f64(ld * n, 3);
+                for beta in [-0.5, 0.0] {
+                    let mut full = c.clone();
+                    let mut tri = c.clone();
+                    let mut tri_64 = c.clone();
+                    unsafe {
+                        cblas_dgemm(
+                            order,
+                            transa,
+                            transb,
+                            n as i32,
+                            n as i32,
+                            k as i32,
+                            0.75,
+                            a.as_ptr(),
+                            ld as i32,
+                            b.as_ptr(),
+                            ld as i32,
+                            beta,
+                            full.as_mut_ptr(),
+                            ld as i32,
+                        );
+                        cblas_dgemmt(
+                            order,
+                            uplo,
+                            transa,
+                            transb,
+                            n as i32,
+                            k as i32,
+                            0.75,
+                            a.as_ptr(),
+                            ld as i32,
+                            b.as_ptr(),
+                            ld as i32,
+                            beta,
+                            tri.as_mut_ptr(),
+                            ld as i32,
+                        );
+                        cblas_dgemmt_64(
+                            order,
+                            uplo,
+                            transa,
+                            transb,
+                            n as i64,
+                            k as i64,
+                            0.75,
+                            a.as_ptr(),
+                            ld as i64,
+                            b.as_ptr(),
+                            ld as i64,
+                            beta,
+                            tri_64.as_mut_ptr(),
+                            ld as i64,
+                        );
+                    }
+                    for j in 0..n {
+                        for i in 0..n {
+                            let at = index(order, i, j, ld);
+                            let want = if in_triangle(uplo, i, j) {
+                                full[at]
+                            } else {
+                                c[at]
+                            };
+                            for got in [tri[at], tri_64[at]] {
+                                assert!(
+                                    (want - got).abs() <= 1e-10,
+                                    "{context} beta {beta}: ({i}, {j}) {want} != {got}"
+                                );
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    let (alpha, beta) = (Complex64::new(0.5, -0.25), Complex64::new(-1.0, 0.5));
+    for order in [CblasColMajor, CblasRowMajor] {
+        for uplo in [CblasUpper, CblasLower] {
+            for (transa, transb) in [(CblasNoTrans, CblasNoTrans), (CblasConjTrans, CblasTrans)] {
+                let context = format!("zgemmt {order:?} {uplo:?} {transa:?} {transb:?}");
+                let a = generate_vector_complex64(ld * n, 4);
+                let b = generate_vector_complex64(ld * n, 5);
+                let c = generate_vector_complex64(ld * n, 6);
+                let mut full = c.clone();
+                let mut tri = c.clone();
+                unsafe {
+                    cblas_zgemm(
+                        order,
+                        transa,
+                        transb,
+                        n as i32,
+                        n as i32,
+                        k as i32,
+                        &alpha,
+                        a.as_ptr(),
+                        ld as i32,
+                        b.as_ptr(),
+                        ld as i32,
+                        &beta,
+                        full.as_mut_ptr(),
+                        ld as i32,
+                    );
+                    cblas_zgemmt(
+                        order,
+                        uplo,
+                        transa,
+                        transb,
+                        n as i32,
+                        k as i32,
+                        &alpha,
+                        a.as_ptr(),
+                        ld as i32,
+                        b.as_ptr(),
+                        ld as i32,
+                        &beta,
+                        tri.as_mut_ptr(),
+                        ld as i32,
+                    );
+                }
+                for j in 0..n {
+                    for i in 0..n {
+                        let at = index(order, i, j, ld);
+                        let want = if in_triangle(uplo, i, j) {
+                            full[at]
+                        } else {
+                            c[at]
+                        };
+                        assert!(
+                            (want - tri[at]).norm() <= 1e-10,
+                            "{context}: ({i}, {j}) {want:?} != {:?}",
+                            tri[at]
+                        );
+                    }
+                }
+            }
+        }
+    }
+}
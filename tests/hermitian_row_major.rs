@@ -0,0 +1,202 @@
+#![cfg(not(feature = "openblas"))]
+
+use std::ffi::{c_char, c_void};
+use std::sync::Mutex;
+
+use cblas_inject::{
+    cblas_inject_register_zhemv_lp64, cblas_inject_register_zher2_lp64,
+    cblas_inject_register_zher_lp64, cblas_zhemv, cblas_zher, cblas_zher2, BlasInt32, CblasLower,
+    CblasRowMajor, CblasUpper, CBLAS_INJECT_STATUS_OK,
+};
+use num_complex::Complex64;
+
+mod common;
+use common::in_triangle;
+
+/// The `x` pointer and values seen by each provider call.
+static SEEN: Mutex<Vec<(usize, Vec<Complex64>)>> = Mutex::new(Vec::new());
+
+unsafe extern "C" fn mock_zhemv_lp64(
+    _uplo: *const c_char,
+    n: *const BlasInt32,
+    _alpha: *const Complex64,
+    _a: *const Complex64,
+    _lda: *const BlasInt32,
+    x: *const Complex64,
+    incx: *const BlasInt32,
+    _beta: *const Complex64,
+    _y: *mut Complex64,
+    _incy: *const BlasInt32,
+) {
+    assert_eq!(*incx, 1);
+    let values = (0..*n as usize).map(|i| *x.add(i)).collect();
+    SEEN.lock().unwrap().push((x as usize, values));
+}
+
+#[test]
+fn row_major_hemv_reuses_conjugated_x_buffer() {
+    let a = [Complex64::new(0.0, 0.0); 16];
+    let one = Complex64::new(1.0, 0.0);
+    let mut y = [Complex64::new(0.0, 0.0); 4];
+
+    unsafe {
+        assert_eq!(
+            cblas_inject_register_zhemv_lp64(mock_zhemv_lp64 as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        for (n, incx) in [(4, 1), (3, -2), (4, 1)] {
+            let x: Vec<Complex64> = (0..8)
+                .map(|i| Complex64::new(i as f64, 1.0 + i as f64))
+                .collect();
+            cblas_zhemv(
+                CblasRowMajor,
+                CblasUpper,
+                n,
+                &one,
+                a.as_ptr(),
+                4,
+                x.as_ptr(),
+                incx,
+                &one,
+                y.as_mut_ptr(),
+                1,
+            );
+
+            let (_, seen) = SEEN.lock().unwrap().last().cloned().unwrap();
+            let step = incx.unsigned_abs() as usize;
+            let expected: Vec<Complex64> = (0..n as usize)
+                .map(|i| {
+                    let idx = if incx < 0 { n as usize - 1 - i } else { i } * step;
+                    Complex64::new(x[idx].re, -x[idx].im)
+                })
+                .collect();
+            assert_eq!(seen, expected);
+        }
+    }
+
+    // Every call after the first reuses the same per-thread buffer.
+    let seen = SEEN.lock().unwrap();
+    assert!(seen.iter().all(|(ptr, _)| *ptr == seen[0].0));
+}
+
+/// Reference column-major Fortran zher2 for unit increments.
+unsafe extern "C" fn mock_zher2_lp64(
+    uplo: *const c_char,
+    n: *const BlasInt32,
+    alpha: *const Complex64,
+    x: *const Complex64,
+    incx: *const BlasInt32,
+    y: *const Complex64,
+    incy: *const BlasInt32,
+    a: *mut Complex64,
+    lda: *const BlasInt32,
+) {
+    assert_eq!((*incx, *incy), (1, 1));
+    let (n, lda, alpha) = (*n as usize, *lda as usize, *alpha);
+    for c in 0..n {
+        let rows = if *uplo as u8 == b'U' { 0..c + 1 } else { c..n };
+        for r in rows {
+            *a.add(r + c * lda) += alpha * *x.add(r) * (*y.add(c)).conj()
+                + alpha.conj() * *y.add(r) * (*x.add(c)).conj();
+        }
+    }
+}
+
+/// Reference column-major Fortran zher for unit increments.
+unsafe extern "C" fn mock_zher_lp64(
+    uplo: *const c_char,
+    n: *const BlasInt32,
+    alpha: *const f64,
+    x: *const Complex64,
+    incx: *const BlasInt32,
+    a: *mut Complex64,
+    lda: *const BlasInt32,
+) {
+    assert_eq!(*incx, 1);
+    let (n, lda) = (*n as usize, *lda as usize);
+    for c in 0..n {
+        let rows = if *uplo as u8 == b'U' { 0..c + 1 } else { c..n };
+        for r in rows {
+            *a.add(r + c * lda) += *x.add(r) * (*x.add(c)).conj() * *alpha;
+        }
+    }
+}
+
+#[test]
+fn row_major_her_and_her2_update_the_hermitian_matrix() {
+    const N: usize = 3;
+    let h = |i: usize, j: usize| {
+        let re = (i + j) as f64;
+        let im = if i == j {
+            0.0
+        } else {
+            (j as f64 - i as f64) * 0.5
+        };
+        Complex64::new(re, im)
+    };
+    let x = [
+        Complex64::new(1.0, 2.0),
+        Complex64::new(-1.0, 0.5),
+        Complex64::new(0.0, -3.0),
+    ];
+    let y = [
+        Complex64::new(2.0, -1.0),
+        Complex64::new(0.5, 0.5),
+        Complex64::new(-2.0, 1.0),
+    ];
+    // Logical vector for incx = -1.
+    let x_rev: Vec<Complex64> = x.iter().rev().copied().collect();
+    let alpha = Complex64::new(0.5, -1.5);
+
+    unsafe {
+        assert_eq!(
+            cblas_inject_register_zher_lp64(mock_zher_lp64 as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(
+            cblas_inject_register_zher2_lp64(mock_zher2_lp64 as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+
+        for uplo in [CblasUpper, CblasLower] {
+            let mut a: Vec<Complex64> = (0..N * N).map(|idx| h(idx / N, idx % N)).collect();
+            cblas_zher(
+                CblasRowMajor,
+                uplo,
+                N as i32,
+                2.0,
+                x_rev.as_ptr(),
+                -1,
+                a.as_mut_ptr(),
+                N as i32,
+            );
+            for i in 0..N {
+                for j in (0..N).filter(|&j| in_triangle(uplo, i, j)) {
+                    let want = h(i, j) + x[i] * x[j].conj() * 2.0;
+                    assert_eq!(a[i * N + j], want, "zher {uplo:?} ({i}, {j})");
+                }
+            }
+
+            let mut a: Vec<Complex64> = (0..N * N).map(|idx| h(idx / N, idx % N)).collect();
+            cblas_zher2(
+                CblasRowMajor,
+                uplo,
+                N as i32,
+                &alpha,
+                x.as_ptr(),
+                1,
+                y.as_ptr(),
+                1,
+                a.as_mut_ptr(),
+                N as i32,
+            );
+            for i in 0..N {
+                for j in (0..N).filter(|&j| in_triangle(uplo, i, j)) {
+                    let want =
+                        h(i, j) + alpha * x[i] * y[j].conj() + alpha.conj() * y[i] * x[j].conj();
+                    assert_eq!(a[i * N + j], want, "zher2 {uplo:?} ({i}, {j})");
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,414 @@
+#![cfg(not(feature = "openblas"))]
+
+use std::ffi::CString;
+
+use cblas_inject::{
+    cblas_dasum_64, cblas_ddot_64, cblas_dgemm_64, cblas_dnrm2_64, cblas_dsymm_64, cblas_dsyr2k_64,
+    cblas_dsyrk_64, cblas_dtrsm_64, cblas_dzasum_64, cblas_idamax_64, cblas_inject_load_provider,
+    cblas_inject_lp64_split_max, cblas_inject_set_lp64_split_max, cblas_inject_set_worker_threads,
+    cblas_izamax_64, cblas_zdotc_sub_64, cblas_zgemm_64, cblas_zher2k_64, cblas_zherk_64,
+    cblas_ztrmm_64, CblasColMajor, CblasConjTrans, CblasLeft, CblasLower, CblasNoTrans,
+    CblasNonUnit, CblasRight, CblasRowMajor, CblasTrans, CblasUnit, CblasUpper,
+    CBLAS_INJECT_ABI_LP64, CBLAS_INJECT_STATUS_INVALID_ARGUMENT, CBLAS_INJECT_STATUS_OK,
+    CBLAS_ORDER, CBLAS_TRANSPOSE,
+};
+use num_complex::Complex64;
+
+mod common;
+use common::{
+    assert_complex64_eq, assert_f64_eq, generate_vector_complex64, generate_vector_f64,
+    provider_library, run_with_settings,
+};
+
+/// Leading dimension of a `rows x cols` matrix in `order` layout, padded by one.
+fn ld(order: CBLAS_ORDER, rows: i64, cols: i64) -> i64 {
+    if order == CblasColMajor {
+        rows + 1
+    } else {
+        cols + 1
+    }
+}
+
+fn shape(trans: CBLAS_TRANSPOSE, rows: i64, cols: i64) -> (i64, i64) {
+    if trans == CblasNoTrans {
+        (rows, cols)
+    } else {
+        (cols, rows)
+    }
+}
+
+// The split extent, worker pool and provider slots are process-global, so
+// everything runs in one test.
+#[test]
+fn lp64_blocks_match_one_call() {
+    assert_eq!(
+        cblas_inject_set_lp64_split_max(0),
+        CBLAS_INJECT_STATUS_INVALID_ARGUMENT
+    );
+    assert_eq!(cblas_inject_lp64_split_max(), i32::MAX);
+
+    let Some(library) = provider_library() else {
+        eprintln!("no Fortran BLAS library found; skipping LP64 splitting");
+        return;
+    };
+    let library = CString::new(library).unwrap();
+    assert_eq!(
+        unsafe { cblas_inject_load_provider(library.as_ptr(), CBLAS_INJECT_ABI_LP64) },
+        CBLAS_INJECT_STATUS_OK
+    );
+    assert_eq!(cblas_inject_set_worker_threads(3), CBLAS_INJECT_STATUS_OK);
+
+    let (m, n, k) = (5i64, 7i64, 9i64);
+    for order in [CblasColMajor, CblasRowMajor] {
+        for transa in [CblasNoTrans, CblasTrans] {
+            for transb in [CblasNoTrans, CblasConjTrans] {
+                let (ar, ac) = shape(transa, m, k);
+                let (br, bc) = shape(transb, k, n);
+                let (lda, ldb, ldc) = (ld(order, ar, ac), ld(order, br, bc), ld(order, m, n));
+                let context = format!("gemm {order:?} {transa:?} {transb:?}");
+
+                let a = generate_vector_f64(((ar.max(ac) + 1) * ar.max(ac)) as usize, 1);
+                let b = generate_vector_f64(((br.max(bc) + 1) * br.max(bc)) as usize, 2);
+                let c = generate_vector_f64(((m.max(n) + 1) * m.max(n)) as usize, 3);
+                let (whole, split) = run_with_settings(
+                    &c,
+                    cblas_inject_set_lp64_split_max,
+                    [i32::MAX, 2],
+                    |c| unsafe {
+                        cblas_dgemm_64(
+                            order,
+                            transa,
+                            transb,
+                            m,
+                            n,
+                            k,
+                            0.75,
+                            a.as_ptr(),
+                            lda,
+                            b.as_ptr(),
+                            ldb,
+                            -0.5,
+                            c.as_mut_ptr(),
+                            ldc,
+                        )
+                    },
+                );
+                assert_f64_eq(&split, &whole, 1e-12, &context);
+
+                let a = generate_vector_complex64(a.len(), 4);
+                let b = generate_vector_complex64(b.len(), 5);
+                let c = generate_vector_complex64(c.len(), 6);
+                let (alpha, beta) = (Complex64::new(0.5, -1.0), Complex64::new(0.25, 0.5));
+                let (whole, split) = run_with_settings(
+                    &c,
+                    cblas_inject_set_lp64_split_max,
+                    [i32::MAX, 2],
+                    |c| unsafe {
+                        cblas_zgemm_64(
+                            order,
+                            transa,
+                            transb,
+                            m,
+                            n,
+                            k,
+                            &alpha,
+                            a.as_ptr(),
+                            lda,
+                            b.as_ptr(),
+                            ldb,
+                            &beta,
+                            c.as_mut_ptr(),
+                            ldc,
+                        )
+                    },
+                );
+                assert_complex64_eq(&split, &whole, 1e-12, &context);
+            }
+        }
+    }
+
+    for order in [CblasColMajor, CblasRowMajor] {
+        for side in [CblasLeft, CblasRight] {
+            let dim = if side == CblasLeft { m } else { n };
+            let ldb = ld(order, m, n);
+            let context = format!("side {order:?} {side:?}");
+
+            // Diagonally dominant, so the solve is well conditioned.
+            let mut a = generate_vector_f64(((dim + 1) * dim) as usize, 7);
+            for i in 0..dim {
+                a[(i * (dim + 1) + i) as usize] = 4.0;
+            }
+            let b = generate_vector_f64(((m.max(n) + 1) * m.max(n)) as usize, 8);
+            let (whole, split) = run_with_settings(
+                &b,
+                cblas_inject_set_lp64_split_max,
+                [i32::MAX, 2],
+                |b| unsafe {
+                    cblas_dtrsm_64(
+                        order,
+                        side,
+                        CblasLower,
+                        CblasTrans,
+                        CblasNonUnit,
+                        m,
+                        n,
+                        1.5,
+                        a.as_ptr(),
+                        dim + 1,
+                        b.as_mut_ptr(),
+                        ldb,
+                    )
+                },
+            );
+            assert_f64_eq(&split, &whole, 1e-12, &format!("trsm {context}"));
+
+            let c = generate_vector_f64(b.len(), 9);
+            let (whole, split) = run_with_settings(
+                &c,
+                cblas_inject_set_lp64_split_max,
+                [i32::MAX, 2],
+                |c| unsafe {
+                    cblas_dsymm_64(
+                        order,
+                        side,
+                        CblasUpper,
+                        m,
+                        n,
+                        1.25,
+                        a.as_ptr(),
+                        dim + 1,
+                        b.as_ptr(),
+                        ldb,
+                        0.5,
+                        c.as_mut_ptr(),
+                        ldb,
+                    )
+                },
+            );
+            assert_f64_eq(&split, &whole, 1e-12, &format!("symm {context}"));
+
+            let az = generate_vector_complex64(a.len(), 10);
+            let bz = generate_vector_complex64(b.len(), 11);
+            let alpha = Complex64::new(1.0, 0.5);
+            let (whole, split) = run_with_settings(
+                &bz,
+                cblas_inject_set_lp64_split_max,
+                [i32::MAX, 2],
+                |b| unsafe {
+                    cblas_ztrmm_64(
+                        order,
+                        side,
+                        CblasUpper,
+                        CblasConjTrans,
+                        CblasUnit,
+                        m,
+                        n,
+                        &alpha,
+                        az.as_ptr(),
+                        dim + 1,
+                        b.as_mut_ptr(),
+                        ldb,
+                    )
+                },
+            );
+            assert_complex64_eq(&split, &whole, 1e-12, &format!("trmm {context}"));
+        }
+    }
+
+    for order in [CblasColMajor, CblasRowMajor] {
+        for (trans, ctrans) in [(CblasNoTrans, CblasNoTrans), (CblasTrans, CblasConjTrans)] {
+            let (ar, ac) = shape(trans, n, k);
+            let lda = ld(order, ar, ac);
+            let ldc = n + 1;
+            let context = format!("rank-k {order:?} {trans:?}");
+
+            let a = generate_vector_f64(((ar.max(ac) + 1) * ar.max(ac)) as usize, 12);
+            let b = generate_vector_f64(a.len(), 13);
+            let c = generate_vector_f64(((ldc + 1) * ldc) as usize, 14);
+            let (whole, split) = run_with_settings(
+                &c,
+                cblas_inject_set_lp64_split_max,
+                [i32::MAX, 2],
+                |c| unsafe {
+                    cblas_dsyrk_64(
+                        order,
+                        CblasUpper,
+                        trans,
+                        n,
+                        k,
+                        0.5,
+                        a.as_ptr(),
+                        lda,
+                        -1.0,
+                        c.as_mut_ptr(),
+                        ldc,
+                    )
+                },
+            );
+            assert_f64_eq(&split, &whole, 1e-12, &format!("syrk {context}"));
+            let (whole, split) = run_with_settings(
+                &c,
+                cblas_inject_set_lp64_split_max,
+                [i32::MAX, 2],
+                |c| unsafe {
+                    cblas_dsyr2k_64(
+                        order,
+                        CblasLower,
+                        trans,
+                        n,
+                        k,
+                        0.5,
+                        a.as_ptr(),
+                        lda,
+                        b.as_ptr(),
+                        lda,
+                        2.0,
+                        c.as_mut_ptr(),
+                        ldc,
+                    )
+                },
+            );
+            assert_f64_eq(&split, &whole, 1e-12, &format!("syr2k {context}"));
+
+            let a = generate_vector_complex64(a.len(), 15);
+            let b = generate_vector_complex64(a.len(), 16);
+            let c = generate_vector_complex64(c.len(), 17);
+            let (whole, split) = run_with_settings(
+                &c,
+                cblas_inject_set_lp64_split_max,
+                [i32::MAX, 2],
+                |c| unsafe {
+                    cblas_zherk_64(
+                        order,
+                        CblasLower,
+                        ctrans,
+                        n,
+                        k,
+                        0.5,
+                        a.as_ptr(),
+                        lda,
+                        0.25,
+                        c.as_mut_ptr(),
+                        ldc,
+                    )
+                },
+            );
+            assert_complex64_eq(&split, &whole, 1e-12, &format!("herk {context}"));
+            let alpha = Complex64::new(0.5, 0.75);
+            let (whole, split) = run_with_settings(
+                &c,
+                cblas_inject_set_lp64_split_max,
+                [i32::MAX, 2],
+                |c| unsafe {
+                    cblas_zher2k_64(
+                        order,
+                        CblasUpper,
+                        ctrans,
+                        n,
+                        k,
+                        &alpha,
+                        a.as_ptr(),
+                        lda,
+                        b.as_ptr(),
+                        lda,
+                        0.0,
+                        c.as_mut_ptr(),
+                        ldc,
+                    )
+                },
+            );
+            assert_complex64_eq(&split, &whole, 1e-12, &format!("her2k {context}"));
+        }
+    }
+
+    // Eleven elements run as chunks of two, so every reduction merges
+    // partial results, including any negative increment.
+    let n = 11i64;
+    for (incx, incy) in [(1i64, 1i64), (2, -1), (-3, 2)] {
+        let context = format!("blas1 incx={incx} incy={incy}");
+        let x = generate_vector_f64((n * incx.abs()) as usize, 18);
+        let y = generate_vector_f64((n * incy.abs()) as usize, 19);
+        let (whole, split) = run_with_settings(
+            &[0.0],
+            cblas_inject_set_lp64_split_max,
+            [i32::MAX, 2],
+            |r| unsafe {
+                r[0] = cblas_ddot_64(n, x.as_ptr(), incx, y.as_ptr(), incy);
+            },
+        );
+        assert_f64_eq(&split, &whole, 1e-12, &format!("ddot {context}"));
+
+        let xz = generate_vector_complex64(x.len(), 20);
+        let yz = generate_vector_complex64(y.len(), 21);
+        let (whole, split) = run_with_settings(
+            &[Complex64::new(0.0, 0.0)],
+            cblas_inject_set_lp64_split_max,
+            [i32::MAX, 2],
+            |r| unsafe {
+                cblas_zdotc_sub_64(n, xz.as_ptr(), incx, yz.as_ptr(), incy, &mut r[0]);
+            },
+        );
+        assert_complex64_eq(&split, &whole, 1e-12, &format!("zdotc {context}"));
+
+        if incx > 0 {
+            let (whole, split) = run_with_settings(
+                &[0.0, 0.0],
+                cblas_inject_set_lp64_split_max,
+                [i32::MAX, 2],
+                |r| unsafe {
+                    r[0] = cblas_dasum_64(n, x.as_ptr(), incx);
+                    r[1] = cblas_dzasum_64(n, xz.as_ptr(), incx);
+                },
+            );
+            assert_f64_eq(&split, &whole, 1e-12, &format!("asum {context}"));
+        }
+    }
+
+    // Partial norms near the overflow threshold still merge to a finite norm.
+    let x: Vec<f64> = generate_vector_f64(n as usize, 22)
+        .iter()
+        .map(|v| v * 1e300)
+        .collect();
+    let (whole, split) = run_with_settings(
+        &[0.0],
+        cblas_inject_set_lp64_split_max,
+        [i32::MAX, 2],
+        |r| unsafe {
+            r[0] = cblas_dnrm2_64(n, x.as_ptr(), 1);
+        },
+    );
+    assert!(split[0].is_finite(), "dnrm2 overflowed: {}", split[0]);
+    assert!(
+        (whole[0] - split[0]).abs() <= 1e-12 * whole[0],
+        "dnrm2: {} != {}",
+        whole[0],
+        split[0]
+    );
+
+    // The largest magnitude appears in the second and fourth chunks; the
+    // first occurrence wins.
+    let mut x = generate_vector_f64(n as usize, 23);
+    x[3] = -9.0;
+    x[6] = 9.0;
+    let (whole, split) = run_with_settings(
+        &[0],
+        cblas_inject_set_lp64_split_max,
+        [i32::MAX, 2],
+        |r| unsafe {
+            r[0] = cblas_idamax_64(n, x.as_ptr(), 1);
+        },
+    );
+    assert_eq!((whole[0], split[0]), (3, 3));
+    let mut xz = generate_vector_complex64(n as usize, 24);
+    xz[9] = Complex64::new(-5.0, 4.0);
+    xz[10] = Complex64::new(4.0, -5.0);
+    let (whole, split) = run_with_settings(
+        &[0],
+        cblas_inject_set_lp64_split_max,
+        [i32::MAX, 2],
+        |r| unsafe {
+            r[0] = cblas_izamax_64(n, xz.as_ptr(), 1);
+        },
+    );
+    assert_eq!((whole[0], split[0]), (9, 9));
+}
@@ -0,0 +1,253 @@
+#![cfg(not(feature = "openblas"))]
+
+use std::ffi::{c_char, c_void};
+use std::sync::atomic::{AtomicI32, AtomicUsize, Ordering};
+
+use cblas_inject::{
+    cblas_dimatcopy, cblas_domatcopy, cblas_domatcopy_64, cblas_inject_register_somatcopy_lp64,
+    cblas_somatcopy_64, cblas_zimatcopy, cblas_zimatcopy_64, cblas_zomatcopy, BlasInt32,
+    CblasColMajor, CblasConjNoTrans, CblasConjTrans, CblasNoTrans, CblasRowMajor, CblasTrans,
+    CBLAS_INJECT_STATUS_OK, CBLAS_ORDER, CBLAS_TRANSPOSE,
+};
+use num_complex::Complex64;
+
+mod common;
+use common::{generate_vector_complex64, generate_vector_f64, index};
+
+/// `alpha * op(A)` element by element, stored like B with `ldb`.
+#[allow(clippy::too_many_arguments)]
+fn reference(
+    order: CBLAS_ORDER,
+    trans: CBLAS_TRANSPOSE,
+    rows: usize,
+    cols: usize,
+    alpha: Complex64,
+    a: &[Complex64],
+    lda: usize,
+    b: &mut [Complex64],
+    ldb: usize,
+) {
+    for i in 0..rows {
+        for j in 0..cols {
+            let v = a[index(order, i, j, lda)];
+            let v = match trans {
+                CblasConjTrans | CblasConjNoTrans => v.conj(),
+                CblasNoTrans | CblasTrans => v,
+            };
+            let at = match trans {
+                CblasTrans | CblasConjTrans => index(order, j, i, ldb),
+                CblasNoTrans | CblasConjNoTrans => index(order, i, j, ldb),
+            };
+            b[at] = alpha * v;
+        }
+    }
+}
+
+static SOMATCOPY_CALLS: AtomicUsize = AtomicUsize::new(0);
+static LAST_ORDER: AtomicI32 = AtomicI32::new(0);
+static LAST_ROWS: AtomicI32 = AtomicI32::new(0);
+
+unsafe extern "C" fn mock_somatcopy(
+    order: *const c_char,
+    _trans: *const c_char,
+    rows: *const BlasInt32,
+    _cols: *const BlasInt32,
+    _alpha: *const f32,
+    _a: *const f32,
+    _lda: *const BlasInt32,
+    _b: *mut f32,
+    _ldb: *const BlasInt32,
+) {
+    SOMATCOPY_CALLS.fetch_add(1, Ordering::SeqCst);
+    LAST_ORDER.store(i32::from(unsafe { *order } as u8), Ordering::SeqCst);
+    LAST_ROWS.store(unsafe { *rows }, Ordering::SeqCst);
+}
+
+// Provider slots are process-global, so everything runs in one test.
+#[test]
+fn matcopy_matches_reference() {
+    // 37 x 70 needs partial tiles in both dimensions.
+    let (rows, cols) = (37usize, 70usize);
+    let ld = 75usize;
+    let alpha = Complex64::new(0.5, -1.25);
+    let a = generate_vector_complex64(ld * ld, 1);
+    let trans_all = [CblasNoTrans, CblasTrans, CblasConjTrans, CblasConjNoTrans];
+    for order in [CblasColMajor, CblasRowMajor] {
+        for trans in trans_all {
+            let context = format!("{order:?} {trans:?}");
+            let mut want = generate_vector_complex64(ld * ld, 2);
+            let mut got = want.clone();
+            reference(order, trans, rows, cols, alpha, &a, ld, &mut want, ld - 1);
+            unsafe {
+                cblas_zomatcopy(
+                    order,
+                    trans,
+                    rows as i32,
+                    cols as i32,
+                    &alpha,
+                    a.as_ptr(),
+                    ld as i32,
+                    got.as_mut_ptr(),
+                    (ld - 1) as i32,
+                );
+            }
+            assert_eq!(want, got, "zomatcopy {context}");
+
+            // In place: rectangular with a new leading dimension, and square.
+            for (rows, cols, lda, ldb) in [(rows, cols, ld, ld - 4), (40, 40, ld, ld)] {
+                let mut want = a.clone();
+                reference(order, trans, rows, cols, alpha, &a, lda, &mut want, ldb);
+                let mut got = a.clone();
+                unsafe {
+                    cblas_zimatcopy_64(
+                        order,
+                        trans,
+                        rows as i64,
+                        cols as i64,
+                        &alpha,
+                        got.as_mut_ptr(),
+                        lda as i64,
+                        ldb as i64,
+                    );
+                }
+                let (b_rows, b_cols) = match trans {
+                    CblasTrans | CblasConjTrans => (cols, rows),
+                    CblasNoTrans | CblasConjNoTrans => (rows, cols),
+                };
+                for i in 0..b_rows {
+                    for j in 0..b_cols {
+                        let at = index(order, i, j, ldb);
+                        assert_eq!(
+                            want[at], got[at],
+                            "zimatcopy {context} {rows}x{cols}: ({i}, {j})"
+                        );
+                    }
+                }
+            }
+        }
+    }
+
+    // Real routines, including a leading dimension that grows in place.
+    let a_real = generate_vector_f64(ld * ld, 3);
+    for order in [CblasColMajor, CblasRowMajor] {
+        for trans in [CblasNoTrans, CblasTrans] {
+            let a_complex: Vec<Complex64> =
+                a_real.iter().map(|&v| Complex64::new(v, 0.0)).collect();
+            let mut want = vec![Complex64::default(); ld * ld];
+            reference(
+                order,
+                trans,
+                rows,
+                cols,
+                Complex64::new(-2.0, 0.0),
+                &a_complex,
+                ld,
+                &mut want,
+                ld,
+            );
+            let mut got = vec![0.0; ld * ld];
+            unsafe {
+                cblas_domatcopy_64(
+                    order,
+                    trans,
+                    rows as i64,
+                    cols as i64,
+                    -2.0,
+                    a_real.as_ptr(),
+                    ld as i64,
+                    got.as_mut_ptr(),
+                    ld as i64,
+                );
+            }
+            let got: Vec<Complex64> = got.iter().map(|&v| Complex64::new(v, 0.0)).collect();
+            assert_eq!(want, got, "domatcopy {order:?} {trans:?}");
+
+            let (lda, ldb) = match order {
+                CblasColMajor => (rows, rows + 3),
+                CblasRowMajor => (cols, cols + 3),
+            };
+            let mut got = a_real.clone();
+            unsafe {
+                cblas_dimatcopy(
+                    order,
+                    CblasNoTrans,
+                    rows as i32,
+                    cols as i32,
+                    3.0,
+                    got.as_mut_ptr(),
+                    lda as i32,
+                    ldb as i32,
+                );
+            }
+            for i in 0..rows {
+                for j in 0..cols {
+                    assert_eq!(
+                        got[index(order, i, j, ldb)],
+                        3.0 * a_real[index(order, i, j, lda)],
+                        "dimatcopy {order:?}: ({i}, {j})"
+                    );
+                }
+            }
+        }
+    }
+
+    // alpha = 0 writes zeros without reading A.
+    let nan = [f64::NAN; 16];
+    let mut b = vec![1.0; 16];
+    unsafe {
+        cblas_domatcopy(
+            CblasColMajor,
+            CblasTrans,
+            4,
+            4,
+            0.0,
+            nan.as_ptr(),
+            4,
+            b.as_mut_ptr(),
+            4,
+        );
+    }
+    assert_eq!(b, vec![0.0; 16]);
+    let mut c = vec![Complex64::new(f64::NAN, 0.0); 16];
+    let zero = Complex64::default();
+    unsafe {
+        cblas_zimatcopy(
+            CblasRowMajor,
+            CblasConjTrans,
+            4,
+            4,
+            &zero,
+            c.as_mut_ptr(),
+            4,
+            4,
+        )
+    };
+    assert_eq!(c, vec![zero; 16]);
+
+    // A registered provider gets the call with the storage order as a
+    // character; the ILP64 entry point narrows onto it.
+    unsafe {
+        assert_eq!(
+            cblas_inject_register_somatcopy_lp64(mock_somatcopy as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+    }
+    let (a, mut b) = (vec![1.0f32; 16], vec![0.0f32; 16]);
+    unsafe {
+        cblas_somatcopy_64(
+            CblasRowMajor,
+            CblasTrans,
+            3,
+            4,
+            1.0,
+            a.as_ptr(),
+            4,
+            b.as_mut_ptr(),
+            4,
+        );
+    }
+    assert_eq!(SOMATCOPY_CALLS.load(Ordering::SeqCst), 1);
+    assert_eq!(LAST_ORDER.load(Ordering::SeqCst), i32::from(b'R'));
+    assert_eq!(LAST_ROWS.load(Ordering::SeqCst), 3);
+    assert_eq!(b, vec![0.0f32; 16]);
+}
@@ -0,0 +1,147 @@
+#![cfg(not(feature = "openblas"))]
+
+use std::ffi::c_void;
+use std::sync::atomic::{AtomicUsize, Ordering};
+
+use cblas_inject::{
+    cblas_dasum, cblas_daxpy, cblas_daxpy_64, cblas_dcopy, cblas_ddot, cblas_ddot_64, cblas_dnrm2,
+    cblas_dscal, cblas_dswap, cblas_idamax, cblas_idamax_64, cblas_inject_native_blas1_max_n,
+    cblas_inject_register_ddot_lp64, cblas_inject_set_native_blas1_max_n, cblas_isamax,
+    cblas_sasum, cblas_saxpy, cblas_sdot, cblas_snrm2, cblas_sscal, BlasInt32,
+    CBLAS_INJECT_STATUS_INVALID_ARGUMENT, CBLAS_INJECT_STATUS_OK,
+};
+
+mod common;
+use common::assert_f64_eq;
+
+static DDOT_CALLS: AtomicUsize = AtomicUsize::new(0);
+
+unsafe extern "C" fn mock_ddot_lp64(
+    _n: *const BlasInt32,
+    _x: *const f64,
+    _incx: *const BlasInt32,
+    _y: *const f64,
+    _incy: *const BlasInt32,
+) -> f64 {
+    DDOT_CALLS.fetch_add(1, Ordering::SeqCst);
+    -1.0
+}
+
+// Registration is process-global, so the unregistered checks must run first.
+#[test]
+fn native_blas1_kernels_and_threshold() {
+    unregistered_real_blas1_routines_run_natively();
+    threshold_selects_between_native_and_provider();
+}
+
+fn unregistered_real_blas1_routines_run_natively() {
+    // Odd lengths exercise both the unrolled body and the tail.
+    let x: Vec<f64> = (0..37).map(|i| (i as f64 - 18.5) * 0.25).collect();
+    let y: Vec<f64> = (0..37).map(|i| 1.0 + i as f64 * 0.5).collect();
+    let n = x.len() as i32;
+
+    unsafe {
+        let dot: f64 = x.iter().zip(&y).map(|(a, b)| a * b).sum();
+        let got = cblas_ddot(n, x.as_ptr(), 1, y.as_ptr(), 1);
+        assert_f64_eq(&[got], &[dot], 1e-12, "ddot");
+        let got = cblas_ddot_64(n as i64, x.as_ptr(), 1, y.as_ptr(), 1);
+        assert_f64_eq(&[got], &[dot], 1e-12, "ddot_64");
+
+        // Negative increments walk the vector from the far end.
+        let rev: f64 = x.iter().zip(y[..19].iter().rev()).map(|(a, b)| a * b).sum();
+        let strided: f64 = x
+            .iter()
+            .step_by(2)
+            .zip(y[..19].iter().rev())
+            .map(|(a, b)| a * b)
+            .sum();
+        let got = cblas_ddot(19, x.as_ptr(), 2, y.as_ptr(), -1);
+        assert_f64_eq(&[got], &[strided], 1e-12, "ddot incx 2, incy -1");
+        let got = cblas_ddot(19, x.as_ptr(), 1, y.as_ptr(), -1);
+        assert_f64_eq(&[got], &[rev], 1e-12, "ddot incy -1");
+
+        let mut got = y.clone();
+        cblas_daxpy(n, 1.5, x.as_ptr(), 1, got.as_mut_ptr(), 1);
+        let want: Vec<f64> = y.iter().zip(&x).map(|(y, x)| y + 1.5 * x).collect();
+        assert_f64_eq(&got, &want, 1e-12, "daxpy");
+        let mut got = y.clone();
+        cblas_daxpy_64(3, 2.0, x.as_ptr(), 3, got.as_mut_ptr(), -2);
+        assert_eq!(got[4], y[4] + 2.0 * x[0]);
+        assert_eq!(got[0], y[0] + 2.0 * x[6]);
+
+        let mut got = x.clone();
+        cblas_dscal(n, -2.0, got.as_mut_ptr(), 1);
+        assert!(got.iter().zip(&x).all(|(g, v)| *g == -2.0 * v));
+        let before = got.clone();
+        cblas_dscal(n, 0.0, got.as_mut_ptr(), 0);
+        assert_eq!(got, before);
+
+        let asum: f64 = x.iter().map(|v| v.abs()).sum();
+        assert_f64_eq(&[cblas_dasum(n, x.as_ptr(), 1)], &[asum], 1e-12, "dasum");
+        assert_eq!(cblas_dasum(n, x.as_ptr(), -1), 0.0);
+
+        let nrm2 = x.iter().map(|v| v * v).sum::<f64>().sqrt();
+        assert_f64_eq(&[cblas_dnrm2(n, x.as_ptr(), 1)], &[nrm2], 1e-12, "dnrm2");
+        // Values whose squares overflow or underflow are rescaled.
+        let huge = [3e200, 4e200];
+        let got = cblas_dnrm2(2, huge.as_ptr(), 1) / 1e200;
+        assert_f64_eq(&[got], &[5.0], 1e-12, "dnrm2 huge");
+        let tiny = [3e-200, 4e-200];
+        let got = cblas_dnrm2(2, tiny.as_ptr(), 1) / 1e-200;
+        assert_f64_eq(&[got], &[5.0], 1e-12, "dnrm2 tiny");
+
+        // 0-based index of the first maximum.
+        let v = [1.0, -7.0, 3.0, 7.0];
+        assert_eq!(cblas_idamax(4, v.as_ptr(), 1), 1);
+        assert_eq!(cblas_idamax_64(2, v.as_ptr(), 2), 1);
+        assert_eq!(cblas_idamax(0, v.as_ptr(), 1), 0);
+
+        let mut a = x.clone();
+        let mut b = y.clone();
+        cblas_dswap(n, a.as_mut_ptr(), 1, b.as_mut_ptr(), 1);
+        assert_eq!((a.as_slice(), b.as_slice()), (y.as_slice(), x.as_slice()));
+        let mut c = vec![0.0; 3];
+        cblas_dcopy(3, x.as_ptr(), 1, c.as_mut_ptr(), -1);
+        assert_eq!(c, [x[2], x[1], x[0]]);
+
+        let xs: Vec<f32> = x.iter().map(|&v| v as f32).collect();
+        let ys: Vec<f32> = y.iter().map(|&v| v as f32).collect();
+        let dot32: f32 = xs.iter().zip(&ys).map(|(a, b)| a * b).sum();
+        assert!((cblas_sdot(n, xs.as_ptr(), 1, ys.as_ptr(), 1) - dot32).abs() < 1e-3);
+        let mut ys2 = ys.clone();
+        cblas_saxpy(n, 2.0, xs.as_ptr(), 1, ys2.as_mut_ptr(), 1);
+        assert_eq!(ys2[5], ys[5] + 2.0 * xs[5]);
+        let mut xs2 = xs.clone();
+        cblas_sscal(n, 0.5, xs2.as_mut_ptr(), 1);
+        assert_eq!(xs2[3], xs[3] * 0.5);
+        assert!((cblas_snrm2(n, xs.as_ptr(), 1) - nrm2 as f32).abs() < 1e-3);
+        assert!((cblas_sasum(n, xs.as_ptr(), 1) - asum as f32).abs() < 1e-3);
+        assert_eq!(cblas_isamax(n, xs.as_ptr(), 1), 0);
+    }
+}
+
+fn threshold_selects_between_native_and_provider() {
+    let x = [1.0f64; 64];
+
+    unsafe {
+        assert_eq!(
+            cblas_inject_register_ddot_lp64(mock_ddot_lp64 as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(
+            cblas_inject_set_native_blas1_max_n(-1),
+            CBLAS_INJECT_STATUS_INVALID_ARGUMENT
+        );
+        assert_eq!(cblas_inject_native_blas1_max_n(), 0);
+
+        assert_eq!(cblas_ddot(16, x.as_ptr(), 1, x.as_ptr(), 1), -1.0);
+        assert_eq!(
+            cblas_inject_set_native_blas1_max_n(32),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(cblas_ddot(16, x.as_ptr(), 1, x.as_ptr(), 1), 16.0);
+        assert_eq!(cblas_ddot_64(32, x.as_ptr(), 1, x.as_ptr(), 1), 32.0);
+        assert_eq!(cblas_ddot(64, x.as_ptr(), 1, x.as_ptr(), 1), -1.0);
+        assert_eq!(DDOT_CALLS.load(Ordering::SeqCst), 2);
+    }
+}
@@ -0,0 +1,74 @@
+#![cfg(feature = "openblas-lazy")]
+
+use std::ffi::c_void;
+
+use cblas_inject::{
+    cblas_ddot, cblas_dgemm, cblas_dscal, cblas_inject_finalize, cblas_inject_register_ddot_lp64,
+    cblas_inject_register_dscal_lp64, cblas_zdotc_sub, BlasInt32, CblasNoTrans, CblasRowMajor,
+    CBLAS_INJECT_STATUS_ALREADY_REGISTERED, CBLAS_INJECT_STATUS_OK,
+};
+use num_complex::Complex64;
+
+unsafe extern "C" fn mock_dscal(
+    _n: *const BlasInt32,
+    _alpha: *const f64,
+    x: *mut f64,
+    _incx: *const BlasInt32,
+) {
+    unsafe { *x = -1.0 };
+}
+
+// Slots are process-global and finalization is one-way, so everything runs
+// in one test.
+#[test]
+fn openblas_symbols_register_on_first_use() {
+    // Nothing was registered at load time, so the host can still fill a slot.
+    assert_eq!(
+        unsafe { cblas_inject_register_dscal_lp64(mock_dscal as *const c_void) },
+        CBLAS_INJECT_STATUS_OK
+    );
+    let mut x = [1.0f64; 1];
+    unsafe { cblas_dscal(1, 2.0, x.as_mut_ptr(), 1) };
+    assert_eq!(x[0], -1.0);
+
+    // The first ddot call registers OpenBLAS ddot_.
+    let a = [1.0, 2.0, 3.0];
+    let b = [4.0, 5.0, 6.0];
+    assert_eq!(unsafe { cblas_ddot(3, a.as_ptr(), 1, b.as_ptr(), 1) }, 32.0);
+    assert_eq!(
+        unsafe { cblas_inject_register_ddot_lp64(mock_dscal as *const c_void) },
+        CBLAS_INJECT_STATUS_ALREADY_REGISTERED
+    );
+
+    let x = [Complex64::new(1.0, 2.0), Complex64::new(3.0, -1.0)];
+    let y = [Complex64::new(2.0, 1.0), Complex64::new(0.5, 4.0)];
+    let mut dot = Complex64::new(0.0, 0.0);
+    unsafe { cblas_zdotc_sub(2, x.as_ptr(), 1, y.as_ptr(), 1, &mut dot) };
+    let expected: Complex64 = x.iter().zip(&y).map(|(x, y)| x.conj() * *y).sum();
+    assert_eq!(dot, expected);
+
+    // Finalizing registers the routines no call has reached yet.
+    assert_eq!(cblas_inject_finalize(), CBLAS_INJECT_STATUS_OK);
+    let a = [1.0, 2.0, 3.0, 4.0];
+    let b = [5.0, 6.0, 7.0, 8.0];
+    let mut c = [0.0; 4];
+    unsafe {
+        cblas_dgemm(
+            CblasRowMajor,
+            CblasNoTrans,
+            CblasNoTrans,
+            2,
+            2,
+            2,
+            1.0,
+            a.as_ptr(),
+            2,
+            b.as_ptr(),
+            2,
+            0.0,
+            c.as_mut_ptr(),
+            2,
+        );
+    }
+    assert_eq!(c, [19.0, 22.0, 43.0, 50.0]);
+}
@@ -0,0 +1,269 @@
+#![cfg(not(feature = "openblas"))]
+
+use cblas_inject::{
+    cblas_inject_dpack_gb, cblas_inject_dpack_gb_64, cblas_inject_dpack_tb, cblas_inject_dpack_tp,
+    cblas_inject_dpack_tp_64, cblas_inject_dunpack_gb, cblas_inject_dunpack_tb,
+    cblas_inject_dunpack_tp, cblas_inject_zpack_tp, cblas_inject_zunpack_gb, CblasColMajor,
+    CblasLower, CblasRowMajor, CblasUpper, CBLAS_ORDER, CBLAS_UPLO,
+};
+use num_complex::Complex64;
+
+mod common;
+use common::index;
+
+const ORDERS: [CBLAS_ORDER; 2] = [CblasColMajor, CblasRowMajor];
+const UPLOS: [CBLAS_UPLO; 2] = [CblasUpper, CblasLower];
+/// Sentinel for elements a conversion must not write.
+const UNTOUCHED: f64 = -99.0;
+
+/// Distinct value of dense element (i, j).
+fn element(i: usize, j: usize) -> f64 {
+    (i * 100 + j) as f64
+}
+
+fn dense(order: CBLAS_ORDER, m: usize, n: usize, lda: usize) -> Vec<f64> {
+    let mut a = vec![UNTOUCHED; lda * if order == CblasColMajor { n } else { m }];
+    for i in 0..m {
+        for j in 0..n {
+            a[index(order, i, j, lda)] = element(i, j);
+        }
+    }
+    a
+}
+
+/// Packed index of (i, j) in the uplo triangle, as the CBLAS reference
+/// defines it for each order.
+fn tp_index(order: CBLAS_ORDER, uplo: CBLAS_UPLO, n: usize, i: usize, j: usize) -> usize {
+    match (order, uplo) {
+        (CblasColMajor, CblasUpper) => i + j * (j + 1) / 2,
+        (CblasColMajor, CblasLower) => i + j * (2 * n - j - 1) / 2,
+        (CblasRowMajor, CblasUpper) => j + i * (2 * n - i - 1) / 2,
+        (CblasRowMajor, CblasLower) => j + i * (i + 1) / 2,
+    }
+}
+
+/// Band index of (i, j) for `?gbmv` called with `order`.
+fn gb_index(order: CBLAS_ORDER, kl: usize, ku: usize, ldab: usize, i: usize, j: usize) -> usize {
+    match order {
+        CblasColMajor => ku + i - j + j * ldab,
+        CblasRowMajor => kl + j - i + i * ldab,
+    }
+}
+
+fn in_band(kl: usize, ku: usize, i: usize, j: usize) -> bool {
+    i <= j + kl && j <= i + ku
+}
+
+fn check_tp(a_order: CBLAS_ORDER, p_order: CBLAS_ORDER, uplo: CBLAS_UPLO, n: usize) {
+    let lda = n + 3;
+    let a = dense(a_order, n, n, lda);
+    let in_triangle = |i: usize, j: usize| if uplo == CblasUpper { i <= j } else { i >= j };
+    let mut ap = vec![UNTOUCHED; n * (n + 1) / 2];
+    unsafe {
+        cblas_inject_dpack_tp(
+            a_order,
+            p_order,
+            uplo,
+            n as i32,
+            a.as_ptr(),
+            lda as i32,
+            ap.as_mut_ptr(),
+        )
+    };
+    let mut want = vec![UNTOUCHED; ap.len()];
+    for i in 0..n {
+        for j in (0..n).filter(|&j| in_triangle(i, j)) {
+            want[tp_index(p_order, uplo, n, i, j)] = element(i, j);
+        }
+    }
+    assert_eq!(ap, want, "{a_order:?} {p_order:?} {uplo:?} n={n}");
+
+    let mut back = vec![UNTOUCHED; a.len()];
+    unsafe {
+        cblas_inject_dunpack_tp(
+            a_order,
+            p_order,
+            uplo,
+            n as i32,
+            ap.as_ptr(),
+            back.as_mut_ptr(),
+            lda as i32,
+        )
+    };
+    let mut want = vec![UNTOUCHED; a.len()];
+    for i in 0..n {
+        for j in (0..n).filter(|&j| in_triangle(i, j)) {
+            want[index(a_order, i, j, lda)] = element(i, j);
+        }
+    }
+    assert_eq!(back, want, "{a_order:?} {p_order:?} {uplo:?} n={n}");
+}
+
+#[allow(clippy::too_many_arguments)]
+fn check_gb(
+    a_order: CBLAS_ORDER,
+    p_order: CBLAS_ORDER,
+    m: usize,
+    n: usize,
+    kl: usize,
+    ku: usize,
+    pack: impl Fn(*const f64, usize, *mut f64, usize),
+    unpack: impl Fn(*const f64, usize, *mut f64, usize),
+) {
+    let lda = if a_order == CblasColMajor { m } else { n } + 2;
+    let ldab = kl + ku + 2;
+    let a = dense(a_order, m, n, lda);
+    let mut ab = vec![UNTOUCHED; ldab * if p_order == CblasColMajor { n } else { m }];
+    pack(a.as_ptr(), lda, ab.as_mut_ptr(), ldab);
+    let mut want = vec![UNTOUCHED; ab.len()];
+    for i in 0..m {
+        for j in (0..n).filter(|&j| in_band(kl, ku, i, j)) {
+            want[gb_index(p_order, kl, ku, ldab, i, j)] = element(i, j);
+        }
+    }
+    let what = format!("{a_order:?} {p_order:?} {m}x{n} kl={kl} ku={ku}");
+    assert_eq!(ab, want, "{what}");
+
+    let mut back = vec![UNTOUCHED; a.len()];
+    unpack(ab.as_ptr(), ldab, back.as_mut_ptr(), lda);
+    let mut want = vec![UNTOUCHED; a.len()];
+    for i in 0..m {
+        for j in 0..n {
+            let v = if in_band(kl, ku, i, j) {
+                element(i, j)
+            } else {
+                0.0
+            };
+            want[index(a_order, i, j, lda)] = v;
+        }
+    }
+    assert_eq!(back, want, "{what}");
+}
+
+#[test]
+fn packed_storage_matches_reference() {
+    for a_order in ORDERS {
+        for p_order in ORDERS {
+            for uplo in UPLOS {
+                for n in [0, 1, 5, 37, 70] {
+                    check_tp(a_order, p_order, uplo, n);
+                }
+            }
+        }
+    }
+
+    // The ILP64 entry point and a complex element type.
+    let n = 40;
+    let a = dense(CblasRowMajor, n, n, n);
+    let (mut lp64, mut ilp64) = (vec![0.0; n * (n + 1) / 2], vec![0.0; n * (n + 1) / 2]);
+    unsafe {
+        cblas_inject_dpack_tp(
+            CblasRowMajor,
+            CblasColMajor,
+            CblasLower,
+            n as i32,
+            a.as_ptr(),
+            n as i32,
+            lp64.as_mut_ptr(),
+        );
+        cblas_inject_dpack_tp_64(
+            CblasRowMajor,
+            CblasColMajor,
+            CblasLower,
+            n as i64,
+            a.as_ptr(),
+            n as i64,
+            ilp64.as_mut_ptr(),
+        );
+    }
+    assert_eq!(lp64, ilp64);
+    let z: Vec<Complex64> = a.iter().map(|&v| Complex64::new(v, -v)).collect();
+    let mut zp = vec![Complex64::new(0.0, 0.0); lp64.len()];
+    unsafe {
+        cblas_inject_zpack_tp(
+            CblasRowMajor,
+            CblasColMajor,
+            CblasLower,
+            n as i32,
+            z.as_ptr().cast(),
+            n as i32,
+            zp.as_mut_ptr().cast(),
+        )
+    };
+    assert!(zp
+        .iter()
+        .zip(&lp64)
+        .all(|(z, &v)| *z == Complex64::new(v, -v)));
+}
+
+#[test]
+fn band_storage_matches_reference() {
+    for a_order in ORDERS {
+        for p_order in ORDERS {
+            for (m, n, kl, ku) in [
+                (0, 0, 1, 1),
+                (1, 1, 0, 0),
+                (45, 37, 2, 3),
+                (37, 45, 0, 5),
+                (70, 70, 40, 1),
+                (10, 80, 3, 90),
+            ] {
+                let pack = |a: *const f64, lda, ab: *mut f64, ldab| unsafe {
+                    let [m, n, kl, ku, lda, ldab] = [m, n, kl, ku, lda, ldab].map(|v| v as i32);
+                    cblas_inject_dpack_gb(a_order, p_order, m, n, kl, ku, a, lda, ab, ldab)
+                };
+                let unpack = |ab: *const f64, ldab, a: *mut f64, lda| unsafe {
+                    let [m, n, kl, ku, lda, ldab] = [m, n, kl, ku, lda, ldab].map(|v| v as i32);
+                    cblas_inject_dunpack_gb(a_order, p_order, m, n, kl, ku, ab, ldab, a, lda)
+                };
+                check_gb(a_order, p_order, m, n, kl, ku, pack, unpack);
+
+                let pack_64 = |a: *const f64, lda, ab: *mut f64, ldab| unsafe {
+                    let [m, n, kl, ku, lda, ldab] = [m, n, kl, ku, lda, ldab].map(|v| v as i64);
+                    cblas_inject_dpack_gb_64(a_order, p_order, m, n, kl, ku, a, lda, ab, ldab)
+                };
+                check_gb(a_order, p_order, m, n, kl, ku, pack_64, unpack);
+            }
+
+            // A triangular band is the general band with kl = 0 or ku = 0.
+            for uplo in UPLOS {
+                for (n, k) in [(1, 0), (37, 4), (70, 69)] {
+                    let pack = |a: *const f64, lda, ab: *mut f64, ldab| unsafe {
+                        let [n, k, lda, ldab] = [n, k, lda, ldab].map(|v| v as i32);
+                        cblas_inject_dpack_tb(a_order, p_order, uplo, n, k, a, lda, ab, ldab)
+                    };
+                    let unpack = |ab: *const f64, ldab, a: *mut f64, lda| unsafe {
+                        let [n, k, lda, ldab] = [n, k, lda, ldab].map(|v| v as i32);
+                        cblas_inject_dunpack_tb(a_order, p_order, uplo, n, k, ab, ldab, a, lda)
+                    };
+                    let (kl, ku) = if uplo == CblasUpper { (0, k) } else { (k, 0) };
+                    check_gb(a_order, p_order, n, n, kl, ku, pack, unpack);
+                }
+            }
+        }
+    }
+
+    // Complex unpack touches whole elements.
+    let (m, n, kl, ku) = (3, 4, 1, 0);
+    let ab: Vec<Complex64> = (0..2 * n).map(|i| Complex64::new(i as f64, 1.0)).collect();
+    let mut a = vec![Complex64::new(9.0, 9.0); m * n];
+    unsafe {
+        cblas_inject_zunpack_gb(
+            CblasColMajor,
+            CblasColMajor,
+            m as i32,
+            n as i32,
+            kl,
+            ku,
+            ab.as_ptr().cast(),
+            2,
+            a.as_mut_ptr().cast(),
+            m as i32,
+        )
+    };
+    let zero = Complex64::new(0.0, 0.0);
+    assert_eq!(
+        a,
+        [ab[0], ab[1], zero, zero, ab[2], ab[3], zero, zero, ab[4], zero, zero, zero]
+    );
+}
@@ -0,0 +1,239 @@
+#![cfg(not(feature = "openblas"))]
+
+use std::ffi::CString;
+
+use cblas_inject::{
+    cblas_dgemm, cblas_dtrmm, cblas_dtrsm, cblas_inject_load_provider, cblas_inject_parallel_tile,
+    cblas_inject_set_parallel_tile, cblas_inject_set_worker_threads, cblas_sgemm, cblas_zgemm,
+    cblas_ztrmm, cblas_ztrsm, CblasColMajor, CblasConjTrans, CblasLeft, CblasLower, CblasNoTrans,
+    CblasNonUnit, CblasRight, CblasRowMajor, CblasTrans, CblasUnit, CblasUpper,
+    CBLAS_INJECT_ABI_LP64, CBLAS_INJECT_STATUS_INVALID_ARGUMENT, CBLAS_INJECT_STATUS_OK,
+};
+use num_complex::Complex64;
+
+mod common;
+use common::{
+    assert_complex64_eq, assert_f64_eq, generate_vector_complex64, generate_vector_f64,
+    provider_library, run_with_settings,
+};
+
+/// Diagonally dominant square matrix of order `dim` with leading dimension
+/// `dim + 1`, so solves are well conditioned.
+fn triangle(dim: usize, seed: usize) -> Vec<f64> {
+    let mut a = generate_vector_f64((dim + 1) * dim, seed);
+    for i in 0..dim {
+        a[i * (dim + 1) + i] = 4.0;
+    }
+    a
+}
+
+// The tile size, worker pool and provider slots are process-global, so
+// everything runs in one test.
+#[test]
+fn parallel_tiles_match_one_call() {
+    assert_eq!(
+        cblas_inject_set_parallel_tile(-1),
+        CBLAS_INJECT_STATUS_INVALID_ARGUMENT
+    );
+    assert_eq!(cblas_inject_parallel_tile(), 0);
+
+    let Some(library) = provider_library() else {
+        eprintln!("no Fortran BLAS library found; skipping the parallel driver");
+        return;
+    };
+    let library = CString::new(library).unwrap();
+    assert_eq!(
+        unsafe { cblas_inject_load_provider(library.as_ptr(), CBLAS_INJECT_ABI_LP64) },
+        CBLAS_INJECT_STATUS_OK
+    );
+    assert_eq!(cblas_inject_set_worker_threads(3), CBLAS_INJECT_STATUS_OK);
+
+    // 8 x 7 needs partial tiles in both dimensions; ld = 9 fits either
+    // layout.
+    let (m, n, k) = (8i32, 7i32, 5i32);
+    let ld = 9i32;
+    for order in [CblasColMajor, CblasRowMajor] {
+        for (transa, transb) in [(CblasNoTrans, CblasNoTrans), (CblasTrans, CblasConjTrans)] {
+            let context = format!("gemm {order:?} {transa:?} {transb:?}");
+            let a = generate_vector_f64((ld * ld) as usize, 1);
+            let b = generate_vector_f64((ld * ld) as usize, 2);
+            let c = generate_vector_f64((ld * ld) as usize, 3);
+            let (whole, tiled) =
+                run_with_settings(&c, cblas_inject_set_parallel_tile, [0, 3], |c| unsafe {
+                    cblas_dgemm(
+                        order,
+                        transa,
+                        transb,
+                        m,
+                        n,
+                        k,
+                        0.75,
+                        a.as_ptr(),
+                        ld,
+                        b.as_ptr(),
+                        ld,
+                        -0.5,
+                        c.as_mut_ptr(),
+                        ld,
+                    )
+                });
+            assert_f64_eq(&tiled, &whole, 1e-10, &context);
+
+            let (a32, b32): (Vec<f32>, Vec<f32>) = (
+                a.iter().map(|&v| v as f32).collect(),
+                b.iter().map(|&v| v as f32).collect(),
+            );
+            let c32: Vec<f32> = c.iter().map(|&v| v as f32).collect();
+            let (whole, tiled) =
+                run_with_settings(&c32, cblas_inject_set_parallel_tile, [0, 3], |c| unsafe {
+                    cblas_sgemm(
+                        order,
+                        transa,
+                        transb,
+                        m,
+                        n,
+                        k,
+                        0.75,
+                        a32.as_ptr(),
+                        ld,
+                        b32.as_ptr(),
+                        ld,
+                        -0.5,
+                        c.as_mut_ptr(),
+                        ld,
+                    )
+                });
+            for (i, (w, t)) in whole.iter().zip(&tiled).enumerate() {
+                assert!((w - t).abs() <= 1e-4, "s{context}: [{i}] {w} != {t}");
+            }
+
+            let a = generate_vector_complex64(a.len(), 4);
+            let b = generate_vector_complex64(b.len(), 5);
+            let c = generate_vector_complex64(c.len(), 6);
+            let (alpha, beta) = (Complex64::new(0.5, -1.0), Complex64::new(0.25, 0.5));
+            let (whole, tiled) =
+                run_with_settings(&c, cblas_inject_set_parallel_tile, [0, 3], |c| unsafe {
+                    cblas_zgemm(
+                        order,
+                        transa,
+                        transb,
+                        m,
+                        n,
+                        k,
+                        &alpha,
+                        a.as_ptr(),
+                        ld,
+                        b.as_ptr(),
+                        ld,
+                        &beta,
+                        c.as_mut_ptr(),
+                        ld,
+                    )
+                });
+            assert_complex64_eq(&tiled, &whole, 1e-10, &format!("z{context}"));
+        }
+    }
+
+    // Every combination of side, triangle and transpose steps through the
+    // diagonal blocks in a different order.
+    for order in [CblasColMajor, CblasRowMajor] {
+        for side in [CblasLeft, CblasRight] {
+            for uplo in [CblasUpper, CblasLower] {
+                for (trans, ctrans) in [(CblasNoTrans, CblasNoTrans), (CblasTrans, CblasConjTrans)]
+                {
+                    let dim = if side == CblasLeft { m } else { n } as usize;
+                    let context = format!("{order:?} {side:?} {uplo:?} {trans:?}");
+                    let a = triangle(dim, 7);
+                    let b = generate_vector_f64((ld * ld) as usize, 8);
+                    let (whole, tiled) =
+                        run_with_settings(&b, cblas_inject_set_parallel_tile, [0, 3], |b| unsafe {
+                            cblas_dtrsm(
+                                order,
+                                side,
+                                uplo,
+                                trans,
+                                CblasNonUnit,
+                                m,
+                                n,
+                                1.5,
+                                a.as_ptr(),
+                                dim as i32 + 1,
+                                b.as_mut_ptr(),
+                                ld,
+                            )
+                        });
+                    assert_f64_eq(&tiled, &whole, 1e-10, &format!("dtrsm {context}"));
+                    let (whole, tiled) =
+                        run_with_settings(&b, cblas_inject_set_parallel_tile, [0, 3], |b| unsafe {
+                            cblas_dtrmm(
+                                order,
+                                side,
+                                uplo,
+                                trans,
+                                CblasUnit,
+                                m,
+                                n,
+                                -0.5,
+                                a.as_ptr(),
+                                dim as i32 + 1,
+                                b.as_mut_ptr(),
+                                ld,
+                            )
+                        });
+                    assert_f64_eq(&tiled, &whole, 1e-10, &format!("dtrmm {context}"));
+
+                    let mut az = generate_vector_complex64(a.len(), 9);
+                    for i in 0..dim {
+                        az[i * (dim + 1) + i] = Complex64::new(4.0, 1.0);
+                    }
+                    let bz = generate_vector_complex64(b.len(), 10);
+                    let alpha = Complex64::new(1.0, 0.5);
+                    let (whole, tiled) = run_with_settings(
+                        &bz,
+                        cblas_inject_set_parallel_tile,
+                        [0, 3],
+                        |b| unsafe {
+                            cblas_ztrsm(
+                                order,
+                                side,
+                                uplo,
+                                ctrans,
+                                CblasNonUnit,
+                                m,
+                                n,
+                                &alpha,
+                                az.as_ptr(),
+                                dim as i32 + 1,
+                                b.as_mut_ptr(),
+                                ld,
+                            )
+                        },
+                    );
+                    assert_complex64_eq(&tiled, &whole, 1e-10, &format!("ztrsm {context}"));
+                    let (whole, tiled) = run_with_settings(
+                        &bz,
+                        cblas_inject_set_parallel_tile,
+                        [0, 3],
+                        |b| unsafe {
+                            cblas_ztrmm(
+                                order,
+                                side,
+                                uplo,
+                                ctrans,
+                                CblasNonUnit,
+                                m,
+                                n,
+                                &alpha,
+                                az.as_ptr(),
+                                dim as i32 + 1,
+                                b.as_mut_ptr(),
+                                ld,
+                            )
+                        },
+                    );
+                    assert_complex64_eq(&tiled, &whole, 1e-10, &format!("ztrmm {context}"));
+                }
+            }
+        }
+    }
+}
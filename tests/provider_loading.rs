@@ -0,0 +1,87 @@
+#![cfg(not(feature = "openblas"))]
+
+use std::ffi::CString;
+use std::ptr;
+
+use cblas_inject::{
+    cblas_dgemm, cblas_inject_load_provider, cblas_zdotc_sub, get_complex_return_style,
+    CblasNoTrans, CblasRowMajor, ComplexReturnStyle, CBLAS_INJECT_ABI_LP64,
+    CBLAS_INJECT_STATUS_INVALID_ARGUMENT, CBLAS_INJECT_STATUS_LOAD_FAILED,
+    CBLAS_INJECT_STATUS_NULL_POINTER, CBLAS_INJECT_STATUS_OK,
+};
+use num_complex::Complex64;
+
+mod common;
+use common::provider_library;
+
+// Provider slots and the environment lookup are process-global, so
+// everything runs in one test.
+#[test]
+fn load_provider_registers_every_routine() {
+    let missing = CString::new("/nonexistent-dir/libblas.so").unwrap();
+    unsafe {
+        assert_eq!(
+            cblas_inject_load_provider(ptr::null(), CBLAS_INJECT_ABI_LP64),
+            CBLAS_INJECT_STATUS_NULL_POINTER
+        );
+        assert_eq!(
+            cblas_inject_load_provider(missing.as_ptr(), 16),
+            CBLAS_INJECT_STATUS_INVALID_ARGUMENT
+        );
+        assert_eq!(
+            cblas_inject_load_provider(missing.as_ptr(), CBLAS_INJECT_ABI_LP64),
+            CBLAS_INJECT_STATUS_LOAD_FAILED
+        );
+    }
+
+    let Some(library) = provider_library() else {
+        eprintln!("no Fortran BLAS library found; skipping provider loading");
+        return;
+    };
+
+    // Nothing is registered, so the first call loads CBLAS_INJECT_PROVIDER.
+    std::env::set_var("CBLAS_INJECT_PROVIDER", &library);
+    let a = [1.0, 2.0, 3.0, 4.0];
+    let b = [5.0, 6.0, 7.0, 8.0];
+    let mut c = [0.0; 4];
+    unsafe {
+        cblas_dgemm(
+            CblasRowMajor,
+            CblasNoTrans,
+            CblasNoTrans,
+            2,
+            2,
+            2,
+            1.0,
+            a.as_ptr(),
+            2,
+            b.as_ptr(),
+            2,
+            0.0,
+            c.as_mut_ptr(),
+            2,
+        );
+    }
+    assert_eq!(c, [19.0, 22.0, 43.0, 50.0]);
+
+    // The complex return convention was detected before the dots were
+    // registered.
+    let x = [Complex64::new(1.0, 2.0), Complex64::new(3.0, -1.0)];
+    let y = [Complex64::new(2.0, 1.0), Complex64::new(0.5, 4.0)];
+    let mut dot = Complex64::new(0.0, 0.0);
+    unsafe { cblas_zdotc_sub(2, x.as_ptr(), 1, y.as_ptr(), 1, &mut dot) };
+    let expected: Complex64 = x.iter().zip(&y).map(|(x, y)| x.conj() * *y).sum();
+    assert_eq!(dot, expected);
+    if cfg!(any(target_arch = "x86_64", target_arch = "aarch64")) && library.contains("openblas") {
+        assert_eq!(get_complex_return_style(), ComplexReturnStyle::ReturnValue);
+    }
+
+    // Loading again keeps the registered providers.
+    let library = CString::new(library).unwrap();
+    unsafe {
+        assert_eq!(
+            cblas_inject_load_provider(library.as_ptr(), CBLAS_INJECT_ABI_LP64),
+            CBLAS_INJECT_STATUS_OK
+        );
+    }
+}
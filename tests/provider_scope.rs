@@ -0,0 +1,197 @@
+#![cfg(not(feature = "openblas"))]
+
+use std::ffi::{c_char, c_void};
+use std::mem;
+use std::ptr;
+
+use cblas_inject::{
+    cblas_ddot, cblas_dgemm, cblas_inject_finalize, cblas_inject_pop_provider_scope,
+    cblas_inject_provider_scope_depth, cblas_inject_push_provider_scope,
+    cblas_inject_register_ddot_lp64, cblas_inject_register_dgemm_lp64,
+    cblas_inject_register_dgemm_route_lp64, BlasInt32, BlasInt64, CblasColMajor,
+    CblasInjectProviderTable, CblasNoTrans, CBLAS_INJECT_ABI_ILP64, CBLAS_INJECT_ABI_LP64,
+    CBLAS_INJECT_PROVIDER_TABLE_NATIVE, CBLAS_INJECT_PROVIDER_TABLE_VERSION,
+    CBLAS_INJECT_STATUS_INVALID_ARGUMENT, CBLAS_INJECT_STATUS_NULL_POINTER, CBLAS_INJECT_STATUS_OK,
+};
+
+macro_rules! mock_ddot {
+    ($name:ident, $int:ty, $value:expr) => {
+        unsafe extern "C" fn $name(
+            _n: *const $int,
+            _x: *const f64,
+            _incx: *const $int,
+            _y: *const f64,
+            _incy: *const $int,
+        ) -> f64 {
+            $value
+        }
+    };
+}
+
+mock_ddot!(global_ddot, BlasInt32, -1.0);
+mock_ddot!(scoped_ddot, BlasInt32, -2.0);
+mock_ddot!(inner_ddot, BlasInt64, -3.0);
+
+/// Mock dgemms that tag `c[0]` with the provider that ran.
+macro_rules! mock_dgemm {
+    ($name:ident, $value:expr) => {
+        unsafe extern "C" fn $name(
+            _transa: *const c_char,
+            _transb: *const c_char,
+            _m: *const BlasInt32,
+            _n: *const BlasInt32,
+            _k: *const BlasInt32,
+            _alpha: *const f64,
+            _a: *const f64,
+            _lda: *const BlasInt32,
+            _b: *const f64,
+            _ldb: *const BlasInt32,
+            _beta: *const f64,
+            c: *mut f64,
+            _ldc: *const BlasInt32,
+        ) {
+            unsafe { *c = $value };
+        }
+    };
+}
+
+mock_dgemm!(global_dgemm, 1.0);
+mock_dgemm!(route_dgemm, 2.0);
+mock_dgemm!(scoped_dgemm, 3.0);
+
+fn table(abi: i32) -> CblasInjectProviderTable {
+    // All-zero is a table with every slot null.
+    let mut t: CblasInjectProviderTable = unsafe { mem::zeroed() };
+    t.version = CBLAS_INJECT_PROVIDER_TABLE_VERSION;
+    t.abi = abi;
+    t
+}
+
+const SIZE: usize = mem::size_of::<CblasInjectProviderTable>();
+
+fn ddot() -> f64 {
+    let x = [1.0, 2.0, 3.0, 4.0];
+    unsafe { cblas_ddot(4, x.as_ptr(), 1, x.as_ptr(), 1) }
+}
+
+/// `c[0]` after a square dgemm of order `n`, i.e. which provider ran it.
+fn dgemm(n: usize) -> f64 {
+    let (a, b) = (vec![1.0; n * n], vec![1.0; n * n]);
+    let mut c = vec![0.0; n * n];
+    unsafe {
+        cblas_dgemm(
+            CblasColMajor,
+            CblasNoTrans,
+            CblasNoTrans,
+            n as i32,
+            n as i32,
+            n as i32,
+            1.0,
+            a.as_ptr(),
+            n as i32,
+            b.as_ptr(),
+            n as i32,
+            0.0,
+            c.as_mut_ptr(),
+            n as i32,
+        );
+    }
+    c[0]
+}
+
+fn on_other_thread<R: Send + 'static>(f: fn() -> R) -> R {
+    std::thread::spawn(f).join().unwrap()
+}
+
+// Registration and finalization are process-global, so everything runs in
+// one test.
+#[test]
+fn provider_scopes_are_thread_local() {
+    unsafe {
+        assert_eq!(
+            cblas_inject_register_ddot_lp64(global_ddot as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(
+            cblas_inject_register_dgemm_lp64(global_dgemm as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        // Calls of at least 2 * 8^3 flops go to the route.
+        assert_eq!(
+            cblas_inject_register_dgemm_route_lp64(route_dgemm as *const c_void, 1024.0),
+            CBLAS_INJECT_STATUS_OK
+        );
+    }
+    assert_eq!(cblas_inject_finalize(), CBLAS_INJECT_STATUS_OK);
+
+    unsafe {
+        assert_eq!(
+            cblas_inject_push_provider_scope(ptr::null(), SIZE),
+            CBLAS_INJECT_STATUS_NULL_POINTER
+        );
+        let mut bad = table(CBLAS_INJECT_ABI_LP64);
+        assert_eq!(
+            cblas_inject_push_provider_scope(&bad, 8),
+            CBLAS_INJECT_STATUS_INVALID_ARGUMENT
+        );
+        bad.version = 0;
+        assert_eq!(
+            cblas_inject_push_provider_scope(&bad, SIZE),
+            CBLAS_INJECT_STATUS_INVALID_ARGUMENT
+        );
+    }
+    assert_eq!(
+        cblas_inject_pop_provider_scope(),
+        CBLAS_INJECT_STATUS_INVALID_ARGUMENT
+    );
+    assert_eq!((ddot(), dgemm(2), dgemm(8)), (-1.0, 1.0, 2.0));
+
+    // A scope overrides the frozen table and the size routes.
+    let mut outer = table(CBLAS_INJECT_ABI_LP64);
+    outer.ddot = scoped_ddot as *const c_void;
+    outer.dgemm = scoped_dgemm as *const c_void;
+    assert_eq!(
+        unsafe { cblas_inject_push_provider_scope(&outer, SIZE) },
+        CBLAS_INJECT_STATUS_OK
+    );
+    assert_eq!((ddot(), dgemm(2), dgemm(8)), (-2.0, 3.0, 3.0));
+    assert_eq!(on_other_thread(ddot), -1.0);
+    assert_eq!(on_other_thread(|| dgemm(8)), 2.0);
+
+    // Inner scopes may use the other ABI, and inherit their null slots.
+    let mut inner = table(CBLAS_INJECT_ABI_ILP64);
+    inner.ddot = inner_ddot as *const c_void;
+    assert_eq!(
+        unsafe { cblas_inject_push_provider_scope(&inner, SIZE) },
+        CBLAS_INJECT_STATUS_OK
+    );
+    assert_eq!(cblas_inject_provider_scope_depth(), 2);
+    assert_eq!((ddot(), dgemm(2)), (-3.0, 3.0));
+
+    // Native scopes compute with the built-in kernels where they exist.
+    let mut native = table(CBLAS_INJECT_ABI_LP64);
+    native.flags = CBLAS_INJECT_PROVIDER_TABLE_NATIVE;
+    assert_eq!(
+        unsafe { cblas_inject_push_provider_scope(&native, SIZE) },
+        CBLAS_INJECT_STATUS_OK
+    );
+    assert_eq!((ddot(), dgemm(2), dgemm(40)), (30.0, 2.0, 3.0));
+
+    for depth in [2, 1, 0] {
+        assert_eq!(cblas_inject_pop_provider_scope(), CBLAS_INJECT_STATUS_OK);
+        assert_eq!(cblas_inject_provider_scope_depth(), depth);
+    }
+    assert_eq!((ddot(), dgemm(2), dgemm(8)), (-1.0, 1.0, 2.0));
+
+    // A thread that exits inside a scope does not leak it.
+    on_other_thread(|| {
+        let mut t = table(CBLAS_INJECT_ABI_LP64);
+        t.ddot = scoped_ddot as *const c_void;
+        assert_eq!(
+            unsafe { cblas_inject_push_provider_scope(&t, SIZE) },
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(ddot(), -2.0);
+    });
+    assert_eq!(ddot(), -1.0);
+}
@@ -0,0 +1,161 @@
+#![cfg(not(feature = "openblas"))]
+
+use std::ffi::{c_char, c_void};
+use std::mem;
+use std::ptr;
+
+use cblas_inject::{
+    cblas_dgemm, cblas_dscal, cblas_inject_is_finalized, cblas_inject_register_table, BlasInt32,
+    BlasInt64, CblasColMajor, CblasInjectProviderTable, CblasNoTrans, CBLAS_INJECT_ABI_ILP64,
+    CBLAS_INJECT_ABI_LP64, CBLAS_INJECT_PROVIDER_TABLE_FINALIZE, CBLAS_INJECT_PROVIDER_TABLE_SLOTS,
+    CBLAS_INJECT_PROVIDER_TABLE_VERSION, CBLAS_INJECT_STATUS_ALREADY_FINALIZED,
+    CBLAS_INJECT_STATUS_ALREADY_REGISTERED, CBLAS_INJECT_STATUS_INVALID_ARGUMENT,
+    CBLAS_INJECT_STATUS_NULL_POINTER, CBLAS_INJECT_STATUS_OK,
+};
+
+unsafe extern "C" fn mock_dgemm_lp64(
+    _transa: *const c_char,
+    _transb: *const c_char,
+    _m: *const BlasInt32,
+    _n: *const BlasInt32,
+    _k: *const BlasInt32,
+    _alpha: *const f64,
+    _a: *const f64,
+    _lda: *const BlasInt32,
+    _b: *const f64,
+    _ldb: *const BlasInt32,
+    _beta: *const f64,
+    c: *mut f64,
+    _ldc: *const BlasInt32,
+) {
+    unsafe { *c = 42.0 };
+}
+
+unsafe extern "C" fn mock_dscal_ilp64(
+    n: *const BlasInt64,
+    alpha: *const f64,
+    x: *mut f64,
+    _incx: *const BlasInt64,
+) {
+    unsafe { *x = *n as f64 * *alpha };
+}
+
+fn table(abi: i32) -> CblasInjectProviderTable {
+    // All-zero is a table with every slot null.
+    let mut t: CblasInjectProviderTable = unsafe { mem::zeroed() };
+    t.version = CBLAS_INJECT_PROVIDER_TABLE_VERSION;
+    t.abi = abi;
+    t
+}
+
+const SIZE: usize = mem::size_of::<CblasInjectProviderTable>();
+
+// Registration and finalization are process-global, so everything runs in
+// one test.
+#[test]
+fn register_table_fills_slots_under_one_call() {
+    unsafe {
+        assert_eq!(
+            cblas_inject_register_table(ptr::null(), SIZE),
+            CBLAS_INJECT_STATUS_NULL_POINTER
+        );
+        let mut bad = table(CBLAS_INJECT_ABI_LP64);
+        bad.dgemm = mock_dgemm_lp64 as *const c_void;
+        assert_eq!(
+            cblas_inject_register_table(&bad, 8),
+            CBLAS_INJECT_STATUS_INVALID_ARGUMENT
+        );
+        bad.abi = 16;
+        assert_eq!(
+            cblas_inject_register_table(&bad, SIZE),
+            CBLAS_INJECT_STATUS_INVALID_ARGUMENT
+        );
+        bad.abi = CBLAS_INJECT_ABI_LP64;
+        bad.version = 0;
+        assert_eq!(
+            cblas_inject_register_table(&bad, SIZE),
+            CBLAS_INJECT_STATUS_INVALID_ARGUMENT
+        );
+
+        // A caller that only knows the header registers nothing.
+        bad.version = CBLAS_INJECT_PROVIDER_TABLE_VERSION;
+        let mut status = [-1; CBLAS_INJECT_PROVIDER_TABLE_SLOTS];
+        bad.status = status.as_mut_ptr();
+        let header = ptr::addr_of!(bad.sswap) as usize - ptr::addr_of!(bad) as usize;
+        assert_eq!(
+            cblas_inject_register_table(&bad, header),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert!(status
+            .iter()
+            .all(|&s| s == CBLAS_INJECT_STATUS_NULL_POINTER));
+    }
+
+    let mut lp64 = table(CBLAS_INJECT_ABI_LP64);
+    lp64.dgemm = mock_dgemm_lp64 as *const c_void;
+    lp64.flags = CBLAS_INJECT_PROVIDER_TABLE_FINALIZE;
+    let mut status = [-1; CBLAS_INJECT_PROVIDER_TABLE_SLOTS];
+    lp64.status = status.as_mut_ptr();
+    assert_eq!(
+        unsafe { cblas_inject_register_table(&lp64, SIZE) },
+        CBLAS_INJECT_STATUS_OK
+    );
+    assert_eq!(cblas_inject_is_finalized(), 1);
+    let slot = |t: &CblasInjectProviderTable, field: *const *const c_void| {
+        (field as usize - ptr::addr_of!(t.sswap) as usize) / mem::size_of::<*const c_void>()
+    };
+    let dgemm = slot(&lp64, ptr::addr_of!(lp64.dgemm));
+    assert_eq!(status[dgemm], CBLAS_INJECT_STATUS_OK);
+    assert_eq!(
+        status
+            .iter()
+            .filter(|&&s| s == CBLAS_INJECT_STATUS_NULL_POINTER)
+            .count(),
+        CBLAS_INJECT_PROVIDER_TABLE_SLOTS - 1
+    );
+
+    let mut c = [0.0f64; 1];
+    unsafe {
+        cblas_dgemm(
+            CblasColMajor,
+            CblasNoTrans,
+            CblasNoTrans,
+            33,
+            1,
+            1,
+            1.0,
+            c.as_ptr(),
+            33,
+            c.as_ptr(),
+            1,
+            0.0,
+            c.as_mut_ptr(),
+            33,
+        );
+    }
+    assert_eq!(c[0], 42.0);
+
+    // Slots missing from the frozen table still pick up a later table.
+    let mut ilp64 = table(CBLAS_INJECT_ABI_ILP64);
+    ilp64.dscal = mock_dscal_ilp64 as *const c_void;
+    ilp64.flags = CBLAS_INJECT_PROVIDER_TABLE_FINALIZE;
+    ilp64.status = status.as_mut_ptr();
+    assert_eq!(
+        unsafe { cblas_inject_register_table(&ilp64, SIZE) },
+        CBLAS_INJECT_STATUS_ALREADY_FINALIZED
+    );
+    let dscal = slot(&ilp64, ptr::addr_of!(ilp64.dscal));
+    assert_eq!(status[dscal], CBLAS_INJECT_STATUS_OK);
+
+    // Registering a filled slot again reports it per slot.
+    ilp64.flags = 0;
+    assert_eq!(
+        unsafe { cblas_inject_register_table(&ilp64, SIZE) },
+        CBLAS_INJECT_STATUS_ALREADY_REGISTERED
+    );
+    assert_eq!(status[dscal], CBLAS_INJECT_STATUS_ALREADY_REGISTERED);
+
+    let mut x = [1.0f64; 1];
+    unsafe { cblas_dscal(64, 0.5, x.as_mut_ptr(), 1) };
+    assert_eq!(x[0], 32.0);
+}
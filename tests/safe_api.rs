@@ -0,0 +1,334 @@
+#![cfg(not(feature = "openblas"))]
+
+use std::ffi::{c_char, c_void};
+
+use cblas_inject::blas::{self, ColMajor, Layout, MatMut, MatRef, RowMajor, VecMut, VecRef};
+use cblas_inject::{
+    cblas_inject_register_dgemm_lp64, cblas_inject_register_dgemv_lp64,
+    cblas_inject_register_dtrmv_lp64, cblas_inject_register_zgemm_lp64, BlasInt32, CblasNonUnit,
+    CblasUnit, CblasUpper, CBLAS_INJECT_STATUS_OK,
+};
+use num_complex::Complex64;
+
+/// Element `(i, j)` of `op(A)` for a column-major A and Fortran flag `t`.
+unsafe fn op<T: Copy>(a: *const T, lda: usize, t: c_char, i: usize, j: usize) -> T {
+    unsafe {
+        match t as u8 {
+            b'N' => *a.add(i + j * lda),
+            _ => *a.add(j + i * lda),
+        }
+    }
+}
+
+/// Reference Fortran dgemm.
+unsafe extern "C" fn mock_dgemm(
+    transa: *const c_char,
+    transb: *const c_char,
+    m: *const BlasInt32,
+    n: *const BlasInt32,
+    k: *const BlasInt32,
+    alpha: *const f64,
+    a: *const f64,
+    lda: *const BlasInt32,
+    b: *const f64,
+    ldb: *const BlasInt32,
+    beta: *const f64,
+    c: *mut f64,
+    ldc: *const BlasInt32,
+) {
+    unsafe {
+        let (lda, ldb, ldc) = (*lda as usize, *ldb as usize, *ldc as usize);
+        for j in 0..*n as usize {
+            for i in 0..*m as usize {
+                let dot: f64 = (0..*k as usize)
+                    .map(|p| op(a, lda, *transa, i, p) * op(b, ldb, *transb, p, j))
+                    .sum();
+                let cij = &mut *c.add(i + j * ldc);
+                *cij = *alpha * dot + *beta * *cij;
+            }
+        }
+    }
+}
+
+/// Reference Fortran zgemm; `C` conjugates.
+unsafe extern "C" fn mock_zgemm(
+    transa: *const c_char,
+    transb: *const c_char,
+    m: *const BlasInt32,
+    n: *const BlasInt32,
+    k: *const BlasInt32,
+    alpha: *const Complex64,
+    a: *const Complex64,
+    lda: *const BlasInt32,
+    b: *const Complex64,
+    ldb: *const BlasInt32,
+    beta: *const Complex64,
+    c: *mut Complex64,
+    ldc: *const BlasInt32,
+) {
+    unsafe {
+        let (lda, ldb, ldc) = (*lda as usize, *ldb as usize, *ldc as usize);
+        let get = |x: *const Complex64, ld: usize, t: c_char, i: usize, j: usize| {
+            let v = op(x, ld, t, i, j);
+            if t as u8 == b'C' {
+                v.conj()
+            } else {
+                v
+            }
+        };
+        for j in 0..*n as usize {
+            for i in 0..*m as usize {
+                let dot: Complex64 = (0..*k as usize)
+                    .map(|p| get(a, lda, *transa, i, p) * get(b, ldb, *transb, p, j))
+                    .sum();
+                let cij = &mut *c.add(i + j * ldc);
+                *cij = *alpha * dot + *beta * *cij;
+            }
+        }
+    }
+}
+
+/// Reference Fortran dgemv.
+unsafe extern "C" fn mock_dgemv(
+    trans: *const c_char,
+    m: *const BlasInt32,
+    n: *const BlasInt32,
+    alpha: *const f64,
+    a: *const f64,
+    lda: *const BlasInt32,
+    x: *const f64,
+    incx: *const BlasInt32,
+    beta: *const f64,
+    y: *mut f64,
+    incy: *const BlasInt32,
+) {
+    unsafe {
+        let (m, n, lda) = (*m as usize, *n as usize, *lda as usize);
+        let (rows, cols) = if *trans as u8 == b'N' { (m, n) } else { (n, m) };
+        for i in 0..rows {
+            let dot: f64 = (0..cols)
+                .map(|p| op(a, lda, *trans, i, p) * *x.add(p * *incx as usize))
+                .sum();
+            let yi = &mut *y.add(i * *incy as usize);
+            *yi = *alpha * dot + *beta * *yi;
+        }
+    }
+}
+
+/// Reference Fortran dtrmv.
+unsafe extern "C" fn mock_dtrmv(
+    uplo: *const c_char,
+    trans: *const c_char,
+    diag: *const c_char,
+    n: *const BlasInt32,
+    a: *const f64,
+    lda: *const BlasInt32,
+    x: *mut f64,
+    incx: *const BlasInt32,
+) {
+    unsafe {
+        let (n, lda, incx) = (*n as usize, *lda as usize, *incx as usize);
+        let upper = *uplo as u8 == b'U';
+        let unit = *diag as u8 == b'U';
+        let x0: Vec<f64> = (0..n).map(|i| *x.add(i * incx)).collect();
+        for i in 0..n {
+            // Element (i, p) of op(A), where A is triangular in storage.
+            let dot: f64 = (0..n)
+                .map(|p| {
+                    let (r, c) = if *trans as u8 == b'N' { (i, p) } else { (p, i) };
+                    let inside = if upper { r <= c } else { r >= c };
+                    let aip = match (r == c && unit, inside) {
+                        (true, _) => 1.0,
+                        (false, true) => *a.add(r + c * lda),
+                        (false, false) => 0.0,
+                    };
+                    aip * x0[p]
+                })
+                .sum();
+            *x.add(i * incx) = dot;
+        }
+    }
+}
+
+fn value(i: usize, j: usize, seed: usize) -> f64 {
+    ((i * 5 + j * 3 + seed * 7) % 11) as f64 / 4.0 - 1.0
+}
+
+/// `rows x cols` storage with leading dimension `ld`, padding set to NaN.
+fn store(col_major: bool, rows: usize, cols: usize, ld: usize, seed: usize) -> Vec<f64> {
+    let minor = if col_major { cols } else { rows };
+    let mut data = vec![f64::NAN; ld * minor];
+    for i in 0..rows {
+        for j in 0..cols {
+            let at = if col_major { i + j * ld } else { i * ld + j };
+            data[at] = value(i, j, seed);
+        }
+    }
+    data
+}
+
+fn at(col_major: bool, ld: usize, i: usize, j: usize) -> usize {
+    if col_major {
+        i + j * ld
+    } else {
+        i * ld + j
+    }
+}
+
+/// Check `C = 2 A B + 0.5 C` for one combination of layouts.
+fn check_gemm<LA: Layout, LB: Layout, LC: Layout>(ca: bool, cb: bool, cc: bool) {
+    let (m, n, k) = (3, 4, 5);
+    let ld = |col: bool, rows: usize, cols: usize| if col { rows + 1 } else { cols + 2 };
+    let (lda, ldb, ldc) = (ld(ca, m, k), ld(cb, k, n), ld(cc, m, n));
+    let a = store(ca, m, k, lda, 1);
+    let b = store(cb, k, n, ldb, 2);
+    let mut c = store(cc, m, n, ldc, 3);
+    let mut want = c.clone();
+    for i in 0..m {
+        for j in 0..n {
+            let dot: f64 = (0..k).map(|p| value(i, p, 1) * value(p, j, 2)).sum();
+            let cij = &mut want[at(cc, ldc, i, j)];
+            *cij = 2.0 * dot + 0.5 * *cij;
+        }
+    }
+    blas::gemm(
+        2.0,
+        MatRef::<_, LA>::with_ld(&a, m, k, lda),
+        MatRef::<_, LB>::with_ld(&b, k, n, ldb),
+        0.5,
+        MatMut::<_, LC>::with_ld(&mut c, m, n, ldc),
+    );
+    for (i, (got, want)) in c.iter().zip(&want).enumerate() {
+        assert!(
+            got == want || (got.is_nan() && want.is_nan()),
+            "layouts {ca} {cb} {cc}, element {i}: {got} != {want}"
+        );
+    }
+}
+
+// Provider slots are process-global, so everything that calls one runs in
+// one test.
+#[test]
+fn safe_api_matches_reference() {
+    unsafe {
+        for (register, f) in [
+            (
+                cblas_inject_register_dgemm_lp64 as unsafe extern "C" fn(*const c_void) -> i32,
+                mock_dgemm as *const c_void,
+            ),
+            (
+                cblas_inject_register_zgemm_lp64,
+                mock_zgemm as *const c_void,
+            ),
+            (
+                cblas_inject_register_dgemv_lp64,
+                mock_dgemv as *const c_void,
+            ),
+            (
+                cblas_inject_register_dtrmv_lp64,
+                mock_dtrmv as *const c_void,
+            ),
+        ] {
+            assert_eq!(register(f), CBLAS_INJECT_STATUS_OK);
+        }
+    }
+
+    check_gemm::<ColMajor, ColMajor, ColMajor>(true, true, true);
+    check_gemm::<ColMajor, ColMajor, RowMajor>(true, true, false);
+    check_gemm::<ColMajor, RowMajor, ColMajor>(true, false, true);
+    check_gemm::<ColMajor, RowMajor, RowMajor>(true, false, false);
+    check_gemm::<RowMajor, ColMajor, ColMajor>(false, true, true);
+    check_gemm::<RowMajor, ColMajor, RowMajor>(false, true, false);
+    check_gemm::<RowMajor, RowMajor, ColMajor>(false, false, true);
+    check_gemm::<RowMajor, RowMajor, RowMajor>(false, false, false);
+
+    // A transposed view reads the same storage: C = A^T * A.
+    let a = [1.0, 2.0, 3.0, 4.0, 5.0, 6.0];
+    let mut c = [0.0; 4];
+    let view = MatRef::<_, RowMajor>::new(&a, 3, 2);
+    blas::gemm(
+        1.0,
+        view.t(),
+        view,
+        0.0,
+        MatMut::<_, RowMajor>::new(&mut c, 2, 2),
+    );
+    assert_eq!(c, [35.0, 44.0, 44.0, 56.0]);
+
+    // C = A^H * B, with A^H a view of storage in the order of C.
+    let z = |re: f64, im: f64| Complex64::new(re, im);
+    let a = [z(1.0, 1.0), z(0.0, 2.0)];
+    let b = [z(3.0, 0.0), z(1.0, -1.0)];
+    let want: Complex64 = a.iter().zip(&b).map(|(a, b)| a.conj() * *b).sum();
+    let mut c = [z(0.0, 0.0)];
+    blas::gemm(
+        z(1.0, 0.0),
+        MatRef::<_, ColMajor>::new(&a, 2, 1).h(),
+        MatRef::<_, ColMajor>::new(&b, 2, 1),
+        z(0.0, 0.0),
+        MatMut::<_, ColMajor>::new(&mut c, 1, 1),
+    );
+    assert_eq!(c, [want]);
+    c[0] = z(0.0, 0.0);
+    blas::gemm(
+        z(1.0, 0.0),
+        MatRef::<_, RowMajor>::new(&a, 2, 1).h(),
+        MatRef::<_, RowMajor>::new(&b, 2, 1),
+        z(0.0, 0.0),
+        MatMut::<_, RowMajor>::new(&mut c, 1, 1),
+    );
+    assert_eq!(c, [want]);
+
+    // y = A x with a row-major A and strided vectors.
+    let a = [1.0, 2.0, 3.0, 4.0, 5.0, 6.0];
+    let x = [1.0, -9.0, 1.0, -9.0, 1.0];
+    let mut y = [10.0, -9.0, 20.0];
+    blas::gemv(
+        1.0,
+        MatRef::<_, RowMajor>::new(&a, 2, 3),
+        VecRef::strided(&x, 3, 2),
+        1.0,
+        VecMut::strided(&mut y, 2, 2),
+    );
+    assert_eq!(y, [16.0, -9.0, 35.0]);
+
+    // x = U x with a row-major upper triangle, then with a unit diagonal.
+    let u = [2.0, 1.0, 1.0, f64::NAN, 3.0, 1.0, f64::NAN, f64::NAN, 4.0];
+    let mut x = [1.0, 1.0, 1.0];
+    let view = MatRef::<_, RowMajor>::new(&u, 3, 3);
+    blas::trmv(CblasUpper, CblasNonUnit, view, VecMut::from(&mut x[..]));
+    assert_eq!(x, [4.0, 4.0, 4.0]);
+    blas::trmv(CblasUpper, CblasUnit, view, VecMut::from(&mut x[..]));
+    assert_eq!(x, [12.0, 8.0, 4.0]);
+
+    // axpy without a provider uses the built-in kernel.
+    let mut y = [1.0, 1.0, 1.0];
+    blas::axpy(
+        2.0,
+        VecRef::from(&[1.0, 2.0, 3.0][..]),
+        VecMut::from(&mut y[..]),
+    );
+    assert_eq!(y, [3.0, 5.0, 7.0]);
+}
+
+#[test]
+#[should_panic(expected = "conjugated column-major operand")]
+fn conjugated_column_major_operand_panics() {
+    let a = [Complex64::new(1.0, 0.0)];
+    let mut c = [Complex64::new(0.0, 0.0)];
+    let view = MatRef::<_, RowMajor>::new(&a, 1, 1);
+    let one = Complex64::new(1.0, 0.0);
+    blas::gemm(
+        one,
+        view.h(),
+        view,
+        one,
+        MatMut::<_, ColMajor>::new(&mut c, 1, 1),
+    );
+}
+
+#[test]
+#[should_panic(expected = "cannot hold")]
+fn short_storage_panics() {
+    MatRef::<f64, ColMajor>::with_ld(&[0.0; 5], 2, 3, 2);
+}
@@ -0,0 +1,443 @@
+#![cfg(not(feature = "openblas"))]
+
+use std::ffi::{c_char, c_void};
+use std::sync::atomic::{AtomicUsize, Ordering};
+
+use cblas_inject::{
+    cblas_dgemm, cblas_dgemm_64, cblas_dgemv, cblas_dger, cblas_dsyrk,
+    cblas_inject_register_dgemm_lp64, cblas_inject_register_dgemv_lp64,
+    cblas_inject_register_dger_lp64, cblas_inject_register_dsyrk_lp64,
+    cblas_inject_set_shape_rewrite, cblas_inject_shape_rewrite, cblas_zgemm, BlasInt32,
+    CblasColMajor, CblasLower, CblasNoTrans, CblasRowMajor, CblasTrans, CblasUpper,
+    CBLAS_INJECT_STATUS_OK, CBLAS_ORDER, CBLAS_TRANSPOSE,
+};
+use num_complex::Complex64;
+
+mod common;
+use common::{generate_vector_f64, index};
+
+static DGEMM_CALLS: AtomicUsize = AtomicUsize::new(0);
+static DGEMV_CALLS: AtomicUsize = AtomicUsize::new(0);
+static OTHER_CALLS: AtomicUsize = AtomicUsize::new(0);
+
+unsafe extern "C" fn mock_dgemm(
+    _transa: *const c_char,
+    _transb: *const c_char,
+    _m: *const BlasInt32,
+    _n: *const BlasInt32,
+    _k: *const BlasInt32,
+    _alpha: *const f64,
+    _a: *const f64,
+    _lda: *const BlasInt32,
+    _b: *const f64,
+    _ldb: *const BlasInt32,
+    _beta: *const f64,
+    _c: *mut f64,
+    _ldc: *const BlasInt32,
+) {
+    DGEMM_CALLS.fetch_add(1, Ordering::SeqCst);
+}
+
+/// Reference column-major dgemv for positive increments.
+unsafe extern "C" fn mock_dgemv(
+    trans: *const c_char,
+    m: *const BlasInt32,
+    n: *const BlasInt32,
+    alpha: *const f64,
+    a: *const f64,
+    lda: *const BlasInt32,
+    x: *const f64,
+    incx: *const BlasInt32,
+    beta: *const f64,
+    y: *mut f64,
+    incy: *const BlasInt32,
+) {
+    DGEMV_CALLS.fetch_add(1, Ordering::SeqCst);
+    unsafe {
+        let (m, n, lda) = (*m as usize, *n as usize, *lda as usize);
+        let (incx, incy) = (*incx as usize, *incy as usize);
+        let t = *trans as u8 != b'N';
+        let (len_y, len_x) = if t { (n, m) } else { (m, n) };
+        for i in 0..len_y {
+            let dot: f64 = (0..len_x)
+                .map(|p| {
+                    let aij = if t {
+                        *a.add(p + i * lda)
+                    } else {
+                        *a.add(i + p * lda)
+                    };
+                    aij * *x.add(p * incx)
+                })
+                .sum();
+            let yi = &mut *y.add(i * incy);
+            *yi = if *beta == 0.0 {
+                *alpha * dot
+            } else {
+                *alpha * dot + *beta * *yi
+            };
+        }
+    }
+}
+
+unsafe extern "C" fn mock_dger(
+    _m: *const BlasInt32,
+    _n: *const BlasInt32,
+    _alpha: *const f64,
+    _x: *const f64,
+    _incx: *const BlasInt32,
+    _y: *const f64,
+    _incy: *const BlasInt32,
+    _a: *mut f64,
+    _lda: *const BlasInt32,
+) {
+    OTHER_CALLS.fetch_add(1, Ordering::SeqCst);
+}
+
+unsafe extern "C" fn mock_dsyrk(
+    _uplo: *const c_char,
+    _trans: *const c_char,
+    _n: *const BlasInt32,
+    _k: *const BlasInt32,
+    _alpha: *const f64,
+    _a: *const f64,
+    _lda: *const BlasInt32,
+    _beta: *const f64,
+    _c: *mut f64,
+    _ldc: *const BlasInt32,
+) {
+    OTHER_CALLS.fetch_add(1, Ordering::SeqCst);
+}
+
+/// Run a dgemm with padded leading dimensions and compare with a reference.
+fn check_dgemm(
+    order: CBLAS_ORDER,
+    transa: CBLAS_TRANSPOSE,
+    transb: CBLAS_TRANSPOSE,
+    (m, n, k): (usize, usize, usize),
+    alpha: f64,
+    beta: f64,
+) {
+    let stored =
+        |t: CBLAS_TRANSPOSE, r: usize, c: usize| if t == CblasNoTrans { (r, c) } else { (c, r) };
+    let (ra, ca) = stored(transa, m, k);
+    let (rb, cb) = stored(transb, k, n);
+    let major = |r: usize, c: usize| if order == CblasColMajor { r } else { c };
+    let (lda, ldb, ldc) = (major(ra, ca) + 1, major(rb, cb) + 2, major(m, n) + 1);
+    let minor = |r: usize, c: usize| if order == CblasColMajor { c } else { r };
+    let a = generate_vector_f64(lda * minor(ra, ca), 1);
+    let b = generate_vector_f64(ldb * minor(rb, cb), 2);
+    let mut c = generate_vector_f64(ldc * minor(m, n), 3);
+    if beta == 0.0 {
+        c.fill(f64::NAN);
+    }
+
+    let mut want = c.clone();
+    for i in 0..m {
+        for j in 0..n {
+            let dot: f64 = (0..k)
+                .map(|p| {
+                    let (ai, aj) = if transa == CblasNoTrans {
+                        (i, p)
+                    } else {
+                        (p, i)
+                    };
+                    let (bi, bj) = if transb == CblasNoTrans {
+                        (p, j)
+                    } else {
+                        (j, p)
+                    };
+                    a[index(order, ai, aj, lda)] * b[index(order, bi, bj, ldb)]
+                })
+                .sum();
+            let cij = &mut want[index(order, i, j, ldc)];
+            *cij = if beta == 0.0 {
+                alpha * dot
+            } else {
+                alpha * dot + beta * *cij
+            };
+        }
+    }
+
+    unsafe {
+        cblas_dgemm(
+            order,
+            transa,
+            transb,
+            m as i32,
+            n as i32,
+            k as i32,
+            alpha,
+            a.as_ptr(),
+            lda as i32,
+            b.as_ptr(),
+            ldb as i32,
+            beta,
+            c.as_mut_ptr(),
+            ldc as i32,
+        );
+    }
+    for (i, (got, want)) in c.iter().zip(&want).enumerate() {
+        assert!(
+            got == want || (got.is_nan() && want.is_nan()),
+            "{order:?} {transa:?} {transb:?} {m}x{n}x{k} element {i}: {got} != {want}"
+        );
+    }
+}
+
+/// Square column-major dgemm of order `n` on all-ones operands.
+fn dgemm_ones(n: usize) {
+    let (a, b, mut c) = (vec![1.0; n * n], vec![1.0; n * n], vec![0.0; n * n]);
+    unsafe {
+        cblas_dgemm(
+            CblasColMajor,
+            CblasNoTrans,
+            CblasNoTrans,
+            n as i32,
+            n as i32,
+            n as i32,
+            1.0,
+            a.as_ptr(),
+            n as i32,
+            b.as_ptr(),
+            n as i32,
+            0.0,
+            c.as_mut_ptr(),
+            n as i32,
+        );
+    }
+}
+
+fn counts() -> (usize, usize, usize) {
+    (
+        DGEMM_CALLS.load(Ordering::SeqCst),
+        DGEMV_CALLS.load(Ordering::SeqCst),
+        OTHER_CALLS.load(Ordering::SeqCst),
+    )
+}
+
+// The rewrite switch and provider slots are process-global, so everything
+// runs in one test.
+#[test]
+fn degenerate_shapes_are_rewritten() {
+    unsafe {
+        assert_eq!(
+            cblas_inject_register_dgemm_lp64(mock_dgemm as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(
+            cblas_inject_register_dgemv_lp64(mock_dgemv as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(
+            cblas_inject_register_dger_lp64(mock_dger as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(
+            cblas_inject_register_dsyrk_lp64(mock_dsyrk as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+    }
+
+    // Off by default: even an empty GEMM reaches the provider.
+    assert_eq!(cblas_inject_shape_rewrite(), 0);
+    let mut c = [1.0];
+    unsafe {
+        cblas_dgemm(
+            CblasColMajor,
+            CblasNoTrans,
+            CblasNoTrans,
+            1,
+            1,
+            0,
+            1.0,
+            [].as_ptr(),
+            1,
+            [].as_ptr(),
+            1,
+            0.0,
+            c.as_mut_ptr(),
+            1,
+        );
+    }
+    assert_eq!(counts(), (1, 0, 0));
+
+    assert_eq!(cblas_inject_set_shape_rewrite(1), CBLAS_INJECT_STATUS_OK);
+    assert_eq!(cblas_inject_shape_rewrite(), 1);
+
+    // One-column and one-row GEMMs become a GEMV, in either layout.
+    let mut gemvs = 0;
+    for order in [CblasColMajor, CblasRowMajor] {
+        for transa in [CblasNoTrans, CblasTrans] {
+            for transb in [CblasNoTrans, CblasTrans] {
+                for beta in [0.0, 0.5] {
+                    check_dgemm(order, transa, transb, (5, 1, 4), 2.0, beta);
+                    check_dgemm(order, transa, transb, (1, 6, 3), -1.0, beta);
+                    gemvs += 2;
+                    // 1 x 1 outputs, k == 0 and alpha == 0 stay native.
+                    check_dgemm(order, transa, transb, (1, 1, 7), 0.5, beta);
+                    check_dgemm(order, transa, transb, (3, 4, 0), 1.5, beta);
+                    check_dgemm(order, transa, transb, (3, 4, 2), 0.0, beta);
+                }
+            }
+        }
+    }
+    assert_eq!(counts(), (1, gemvs, 0));
+    // Other shapes still reach the provider.
+    dgemm_ones(2);
+    assert_eq!(counts(), (2, gemvs, 0));
+
+    // alpha == 0 reads neither A nor B.
+    let nan = [f64::NAN; 4];
+    let mut c = [1.0, 2.0, 3.0, 4.0];
+    unsafe {
+        cblas_dgemm_64(
+            CblasColMajor,
+            CblasNoTrans,
+            CblasNoTrans,
+            2,
+            2,
+            2,
+            0.0,
+            nan.as_ptr(),
+            2,
+            nan.as_ptr(),
+            2,
+            2.0,
+            c.as_mut_ptr(),
+            2,
+        );
+    }
+    assert_eq!(c, [2.0, 4.0, 6.0, 8.0]);
+
+    // Complex k == 0 needs no provider at all.
+    let mut z = [Complex64::new(f64::NAN, 0.0); 4];
+    unsafe {
+        cblas_zgemm(
+            CblasRowMajor,
+            CblasNoTrans,
+            CblasNoTrans,
+            2,
+            2,
+            0,
+            &Complex64::new(1.0, 0.0),
+            [].as_ptr(),
+            1,
+            [].as_ptr(),
+            2,
+            &Complex64::default(),
+            z.as_mut_ptr(),
+            2,
+        );
+    }
+    assert_eq!(z, [Complex64::default(); 4]);
+
+    // A one-column GEMV is an axpby, a one-row GEMV a dot product.
+    let a = [1.0, 2.0, 3.0, 0.0, 0.0];
+    let mut y = [f64::NAN, 0.0, f64::NAN];
+    unsafe {
+        cblas_dgemv(
+            CblasColMajor,
+            CblasNoTrans,
+            3,
+            1,
+            2.0,
+            a.as_ptr(),
+            3,
+            [0.5].as_ptr(),
+            1,
+            0.0,
+            y.as_mut_ptr(),
+            1,
+        );
+    }
+    assert_eq!(y, [1.0, 2.0, 3.0]);
+    let mut y = [1.0];
+    unsafe {
+        cblas_dgemv(
+            CblasRowMajor,
+            CblasNoTrans,
+            1,
+            3,
+            1.0,
+            a.as_ptr(),
+            3,
+            [1.0, 1.0, 1.0].as_ptr(),
+            1,
+            1.0,
+            y.as_mut_ptr(),
+            1,
+        );
+    }
+    assert_eq!(y, [7.0]);
+
+    // Rank-1 updates with one row or one column are axpys.
+    let mut a = [0.0; 6];
+    unsafe {
+        cblas_dger(
+            CblasRowMajor,
+            2,
+            1,
+            1.0,
+            [1.0, 2.0].as_ptr(),
+            1,
+            [3.0].as_ptr(),
+            1,
+            a.as_mut_ptr(),
+            3,
+        );
+        cblas_dger(
+            CblasColMajor,
+            1,
+            3,
+            1.0,
+            [2.0].as_ptr(),
+            1,
+            [1.0, 1.0, 1.0].as_ptr(),
+            1,
+            a.as_mut_ptr().add(1),
+            2,
+        );
+    }
+    assert_eq!(a, [3.0, 2.0, 0.0, 8.0, 0.0, 2.0]);
+
+    // SYRK with k == 0 scales only the referenced triangle.
+    let mut c = [1.0, 2.0, 3.0, 4.0];
+    unsafe {
+        cblas_dsyrk(
+            CblasColMajor,
+            CblasUpper,
+            CblasNoTrans,
+            2,
+            0,
+            1.0,
+            [].as_ptr(),
+            2,
+            0.5,
+            c.as_mut_ptr(),
+            2,
+        );
+    }
+    assert_eq!(c, [0.5, 2.0, 1.5, 2.0]);
+    let mut c = [f64::NAN];
+    unsafe {
+        cblas_dsyrk(
+            CblasRowMajor,
+            CblasLower,
+            CblasTrans,
+            1,
+            3,
+            2.0,
+            [1.0, 2.0, 3.0].as_ptr(),
+            1,
+            0.0,
+            c.as_mut_ptr(),
+            1,
+        );
+    }
+    assert_eq!(c, [28.0]);
+    assert_eq!(counts(), (2, gemvs, 0));
+
+    assert_eq!(cblas_inject_set_shape_rewrite(0), CBLAS_INJECT_STATUS_OK);
+    dgemm_ones(1);
+    assert_eq!(counts(), (3, gemvs, 0));
+}
@@ -0,0 +1,241 @@
+#![cfg(not(feature = "openblas"))]
+
+use std::ffi::{c_char, c_void};
+use std::ptr;
+use std::sync::atomic::{AtomicI64, AtomicUsize, Ordering};
+
+use cblas_inject::{
+    cblas_dgemm, cblas_dgemm_64, cblas_dgemv, cblas_inject_register_dgemm_lp64,
+    cblas_inject_register_dgemm_route_ilp64, cblas_inject_register_dgemm_route_lp64,
+    cblas_inject_register_dgemv_lp64, cblas_inject_register_dgemv_route_lp64, BlasInt32, BlasInt64,
+    CblasColMajor, CblasNoTrans, CblasRowMajor, CBLAS_INJECT_STATUS_ALREADY_REGISTERED,
+    CBLAS_INJECT_STATUS_INVALID_ARGUMENT, CBLAS_INJECT_STATUS_NULL_POINTER, CBLAS_INJECT_STATUS_OK,
+    CBLAS_INJECT_STATUS_ROUTE_TABLE_FULL,
+};
+
+static SMALL_DGEMM_CALLS: AtomicUsize = AtomicUsize::new(0);
+static MEDIUM_DGEMM_CALLS: AtomicUsize = AtomicUsize::new(0);
+static LARGE_DGEMM_CALLS: AtomicUsize = AtomicUsize::new(0);
+static LARGE_DGEMM_M: AtomicI64 = AtomicI64::new(0);
+static SMALL_DGEMV_CALLS: AtomicUsize = AtomicUsize::new(0);
+static LARGE_DGEMV_CALLS: AtomicUsize = AtomicUsize::new(0);
+
+macro_rules! mock_dgemm {
+    ($name:ident, $int:ty, $calls:ident) => {
+        unsafe extern "C" fn $name(
+            _transa: *const c_char,
+            _transb: *const c_char,
+            _m: *const $int,
+            _n: *const $int,
+            _k: *const $int,
+            _alpha: *const f64,
+            _a: *const f64,
+            _lda: *const $int,
+            _b: *const f64,
+            _ldb: *const $int,
+            _beta: *const f64,
+            _c: *mut f64,
+            _ldc: *const $int,
+        ) {
+            $calls.fetch_add(1, Ordering::SeqCst);
+        }
+    };
+}
+
+mock_dgemm!(mock_small_dgemm_lp64, BlasInt32, SMALL_DGEMM_CALLS);
+mock_dgemm!(mock_medium_dgemm_lp64, BlasInt32, MEDIUM_DGEMM_CALLS);
+
+unsafe extern "C" fn mock_large_dgemm_ilp64(
+    _transa: *const c_char,
+    _transb: *const c_char,
+    m: *const BlasInt64,
+    _n: *const BlasInt64,
+    _k: *const BlasInt64,
+    _alpha: *const f64,
+    _a: *const f64,
+    _lda: *const BlasInt64,
+    _b: *const f64,
+    _ldb: *const BlasInt64,
+    _beta: *const f64,
+    _c: *mut f64,
+    _ldc: *const BlasInt64,
+) {
+    LARGE_DGEMM_CALLS.fetch_add(1, Ordering::SeqCst);
+    LARGE_DGEMM_M.store(unsafe { *m }, Ordering::SeqCst);
+}
+
+macro_rules! mock_dgemv {
+    ($name:ident, $calls:ident) => {
+        unsafe extern "C" fn $name(
+            _trans: *const c_char,
+            _m: *const BlasInt32,
+            _n: *const BlasInt32,
+            _alpha: *const f64,
+            _a: *const f64,
+            _lda: *const BlasInt32,
+            _x: *const f64,
+            _incx: *const BlasInt32,
+            _beta: *const f64,
+            _y: *mut f64,
+            _incy: *const BlasInt32,
+        ) {
+            $calls.fetch_add(1, Ordering::SeqCst);
+        }
+    };
+}
+
+mock_dgemv!(mock_small_dgemv_lp64, SMALL_DGEMV_CALLS);
+mock_dgemv!(mock_large_dgemv_lp64, LARGE_DGEMV_CALLS);
+
+unsafe fn dgemm_square(n: i32) {
+    unsafe {
+        cblas_dgemm(
+            CblasColMajor,
+            CblasNoTrans,
+            CblasNoTrans,
+            n,
+            n,
+            n,
+            1.0,
+            ptr::null(),
+            n,
+            ptr::null(),
+            n,
+            0.0,
+            ptr::null_mut(),
+            n,
+        );
+    }
+}
+
+fn calls() -> (usize, usize, usize) {
+    (
+        SMALL_DGEMM_CALLS.load(Ordering::SeqCst),
+        MEDIUM_DGEMM_CALLS.load(Ordering::SeqCst),
+        LARGE_DGEMM_CALLS.load(Ordering::SeqCst),
+    )
+}
+
+#[test]
+fn gemm_and_gemv_route_by_flop_count() {
+    unsafe {
+        assert_eq!(
+            cblas_inject_register_dgemm_lp64(mock_small_dgemm_lp64 as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(
+            cblas_inject_register_dgemm_route_lp64(mock_medium_dgemm_lp64 as *const c_void, 1e3),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(
+            cblas_inject_register_dgemm_route_ilp64(mock_large_dgemm_ilp64 as *const c_void, 1e6),
+            CBLAS_INJECT_STATUS_OK
+        );
+
+        // 2 * 4^3 = 128 flops stays on the regular provider.
+        dgemm_square(4);
+        assert_eq!(calls(), (1, 0, 0));
+        // 2 * 8^3 = 1024 flops crosses the first threshold.
+        dgemm_square(8);
+        assert_eq!(calls(), (1, 1, 0));
+        // 2 * 100^3 = 2e6 flops picks the largest qualifying threshold.
+        dgemm_square(100);
+        assert_eq!(calls(), (1, 1, 1));
+
+        // Row-major swaps m and n before calling the routed ILP64 provider.
+        cblas_dgemm(
+            CblasRowMajor,
+            CblasNoTrans,
+            CblasNoTrans,
+            200,
+            100,
+            100,
+            1.0,
+            ptr::null(),
+            100,
+            ptr::null(),
+            100,
+            0.0,
+            ptr::null_mut(),
+            100,
+        );
+        assert_eq!(calls(), (1, 1, 2));
+        assert_eq!(LARGE_DGEMM_M.load(Ordering::SeqCst), 100);
+
+        // The ILP64 CBLAS entry point shares the same routes.
+        cblas_dgemm_64(
+            CblasColMajor,
+            CblasNoTrans,
+            CblasNoTrans,
+            2,
+            2,
+            2,
+            1.0,
+            ptr::null(),
+            2,
+            ptr::null(),
+            2,
+            0.0,
+            ptr::null_mut(),
+            2,
+        );
+        assert_eq!(calls(), (2, 1, 2));
+
+        assert_eq!(
+            cblas_inject_register_dgemv_lp64(mock_small_dgemv_lp64 as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(
+            cblas_inject_register_dgemv_route_lp64(mock_large_dgemv_lp64 as *const c_void, 5e3),
+            CBLAS_INJECT_STATUS_OK
+        );
+        for n in [10, 100] {
+            cblas_dgemv(
+                CblasColMajor,
+                CblasNoTrans,
+                n,
+                n,
+                1.0,
+                ptr::null(),
+                n,
+                ptr::null(),
+                1,
+                0.0,
+                ptr::null_mut(),
+                1,
+            );
+        }
+        assert_eq!(SMALL_DGEMV_CALLS.load(Ordering::SeqCst), 1);
+        assert_eq!(LARGE_DGEMV_CALLS.load(Ordering::SeqCst), 1);
+
+        let f = mock_medium_dgemm_lp64 as *const c_void;
+        assert_eq!(
+            cblas_inject_register_dgemm_route_lp64(ptr::null(), 1.0),
+            CBLAS_INJECT_STATUS_NULL_POINTER
+        );
+        assert_eq!(
+            cblas_inject_register_dgemm_route_lp64(f, -1.0),
+            CBLAS_INJECT_STATUS_INVALID_ARGUMENT
+        );
+        assert_eq!(
+            cblas_inject_register_dgemm_route_lp64(f, f64::NAN),
+            CBLAS_INJECT_STATUS_INVALID_ARGUMENT
+        );
+        assert_eq!(
+            cblas_inject_register_dgemm_route_lp64(f, 1e3),
+            CBLAS_INJECT_STATUS_ALREADY_REGISTERED
+        );
+        assert_eq!(
+            cblas_inject_register_dgemm_route_lp64(f, 1e12),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(
+            cblas_inject_register_dgemm_route_lp64(f, 1e13),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(
+            cblas_inject_register_dgemm_route_lp64(f, 1e14),
+            CBLAS_INJECT_STATUS_ROUTE_TABLE_FULL
+        );
+    }
+}
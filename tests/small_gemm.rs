@@ -0,0 +1,338 @@
+#![cfg(not(feature = "openblas"))]
+
+use std::ffi::{c_char, c_void};
+use std::sync::atomic::{AtomicUsize, Ordering};
+
+use cblas_inject::{
+    cblas_dgemm, cblas_dgemm_64, cblas_inject_register_dgemm_lp64,
+    cblas_inject_register_zgemm_lp64, cblas_inject_set_small_gemm_max_dim,
+    cblas_inject_small_gemm_max_dim, cblas_zgemm, BlasInt32, CblasColMajor, CblasConjTrans,
+    CblasNoTrans, CblasRowMajor, CblasTrans, CBLAS_INJECT_SMALL_GEMM_DIM_LIMIT,
+    CBLAS_INJECT_STATUS_INVALID_ARGUMENT, CBLAS_INJECT_STATUS_OK, CBLAS_ORDER, CBLAS_TRANSPOSE,
+};
+use num_complex::Complex64;
+
+static DGEMM_CALLS: AtomicUsize = AtomicUsize::new(0);
+static ZGEMM_CALLS: AtomicUsize = AtomicUsize::new(0);
+
+unsafe extern "C" fn mock_dgemm_lp64(
+    _transa: *const c_char,
+    _transb: *const c_char,
+    _m: *const BlasInt32,
+    _n: *const BlasInt32,
+    _k: *const BlasInt32,
+    _alpha: *const f64,
+    _a: *const f64,
+    _lda: *const BlasInt32,
+    _b: *const f64,
+    _ldb: *const BlasInt32,
+    _beta: *const f64,
+    _c: *mut f64,
+    _ldc: *const BlasInt32,
+) {
+    DGEMM_CALLS.fetch_add(1, Ordering::SeqCst);
+}
+
+unsafe extern "C" fn mock_zgemm_lp64(
+    _transa: *const c_char,
+    _transb: *const c_char,
+    _m: *const BlasInt32,
+    _n: *const BlasInt32,
+    _k: *const BlasInt32,
+    _alpha: *const Complex64,
+    _a: *const Complex64,
+    _lda: *const BlasInt32,
+    _b: *const Complex64,
+    _ldb: *const BlasInt32,
+    _beta: *const Complex64,
+    _c: *mut Complex64,
+    _ldc: *const BlasInt32,
+) {
+    ZGEMM_CALLS.fetch_add(1, Ordering::SeqCst);
+}
+
+/// Element (i, j) of op(X), where X is stored in `order` with leading dimension `ld`.
+fn op_at(
+    x: &[Complex64],
+    order: CBLAS_ORDER,
+    trans: CBLAS_TRANSPOSE,
+    ld: usize,
+    i: usize,
+    j: usize,
+) -> Complex64 {
+    let (r, c) = if trans == CblasNoTrans {
+        (i, j)
+    } else {
+        (j, i)
+    };
+    let v = if order == CblasColMajor {
+        x[r + c * ld]
+    } else {
+        x[r * ld + c]
+    };
+    if trans == CblasConjTrans {
+        v.conj()
+    } else {
+        v
+    }
+}
+
+fn stored_dims(order: CBLAS_ORDER, trans: CBLAS_TRANSPOSE, rows: usize, cols: usize) -> usize {
+    let (r, c) = if trans == CblasNoTrans {
+        (rows, cols)
+    } else {
+        (cols, rows)
+    };
+    if order == CblasColMajor {
+        r
+    } else {
+        c
+    }
+}
+
+fn value(seed: usize) -> Complex64 {
+    Complex64::new(
+        ((seed * 7) % 11) as f64 - 5.0,
+        ((seed * 3) % 7) as f64 - 3.0,
+    )
+}
+
+#[allow(clippy::too_many_arguments)]
+fn reference(
+    order: CBLAS_ORDER,
+    ta: CBLAS_TRANSPOSE,
+    tb: CBLAS_TRANSPOSE,
+    m: usize,
+    n: usize,
+    k: usize,
+    alpha: Complex64,
+    a: &[Complex64],
+    lda: usize,
+    b: &[Complex64],
+    ldb: usize,
+    beta: Complex64,
+    c: &[Complex64],
+    ldc: usize,
+) -> Vec<Complex64> {
+    let mut out = c.to_vec();
+    for i in 0..m {
+        for j in 0..n {
+            let mut sum = Complex64::new(0.0, 0.0);
+            for l in 0..k {
+                sum += op_at(a, order, ta, lda, i, l) * op_at(b, order, tb, ldb, l, j);
+            }
+            let idx = if order == CblasColMajor {
+                i + j * ldc
+            } else {
+                i * ldc + j
+            };
+            out[idx] = alpha * sum + beta * c[idx];
+        }
+    }
+    out
+}
+
+#[test]
+fn small_gemm_matches_reference_without_calling_provider() {
+    let transposes = [CblasNoTrans, CblasTrans, CblasConjTrans];
+    let (m, n, k) = (5usize, 3usize, 4usize);
+
+    unsafe {
+        assert_eq!(
+            cblas_inject_register_dgemm_lp64(mock_dgemm_lp64 as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(
+            cblas_inject_register_zgemm_lp64(mock_zgemm_lp64 as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(cblas_inject_small_gemm_max_dim(), 0);
+        assert_eq!(
+            cblas_inject_set_small_gemm_max_dim(-1),
+            CBLAS_INJECT_STATUS_INVALID_ARGUMENT
+        );
+        assert_eq!(
+            cblas_inject_set_small_gemm_max_dim(CBLAS_INJECT_SMALL_GEMM_DIM_LIMIT + 1),
+            CBLAS_INJECT_STATUS_INVALID_ARGUMENT
+        );
+        assert_eq!(
+            cblas_inject_set_small_gemm_max_dim(8),
+            CBLAS_INJECT_STATUS_OK
+        );
+
+        for order in [CblasColMajor, CblasRowMajor] {
+            for ta in transposes {
+                for tb in transposes {
+                    // Pad every leading dimension to check that strides are honoured.
+                    let lda = stored_dims(order, ta, m, k) + 1;
+                    let ldb = stored_dims(order, tb, k, n) + 2;
+                    let ldc = stored_dims(order, CblasNoTrans, m, n) + 1;
+                    let a: Vec<Complex64> = (0..lda * m.max(k)).map(value).collect();
+                    let b: Vec<Complex64> = (0..ldb * k.max(n)).map(|s| value(s + 5)).collect();
+                    let c0: Vec<Complex64> = (0..ldc * m.max(n)).map(|s| value(s + 9)).collect();
+                    let alpha = Complex64::new(1.5, -0.5);
+                    let beta = Complex64::new(-0.25, 2.0);
+
+                    let expected = reference(
+                        order, ta, tb, m, n, k, alpha, &a, lda, &b, ldb, beta, &c0, ldc,
+                    );
+                    let mut c = c0.clone();
+                    cblas_zgemm(
+                        order,
+                        ta,
+                        tb,
+                        m as i32,
+                        n as i32,
+                        k as i32,
+                        &alpha,
+                        a.as_ptr(),
+                        lda as i32,
+                        b.as_ptr(),
+                        ldb as i32,
+                        &beta,
+                        c.as_mut_ptr(),
+                        ldc as i32,
+                    );
+                    for (idx, (got, want)) in c.iter().zip(&expected).enumerate() {
+                        assert!(
+                            (got - want).norm_sqr() < 1e-20,
+                            "zgemm {order:?} {ta:?} {tb:?} at {idx}: {got:?} != {want:?}"
+                        );
+                    }
+
+                    // The real path treats ConjTrans as Trans.
+                    let re = |v: &[Complex64]| v.iter().map(|z| z.re).collect::<Vec<f64>>();
+                    let to_c = |v: &[f64]| {
+                        v.iter()
+                            .map(|&x| Complex64::new(x, 0.0))
+                            .collect::<Vec<_>>()
+                    };
+                    let (ar, br, cr0) = (re(&a), re(&b), re(&c0));
+                    let expected = reference(
+                        order,
+                        ta,
+                        tb,
+                        m,
+                        n,
+                        k,
+                        Complex64::new(1.5, 0.0),
+                        &to_c(&ar),
+                        lda,
+                        &to_c(&br),
+                        ldb,
+                        Complex64::new(0.0, 0.0),
+                        &to_c(&cr0),
+                        ldc,
+                    );
+                    let mut cr = cr0.clone();
+                    cblas_dgemm(
+                        order,
+                        ta,
+                        tb,
+                        m as i32,
+                        n as i32,
+                        k as i32,
+                        1.5,
+                        ar.as_ptr(),
+                        lda as i32,
+                        br.as_ptr(),
+                        ldb as i32,
+                        0.0,
+                        cr.as_mut_ptr(),
+                        ldc as i32,
+                    );
+                    for (idx, (got, want)) in cr.iter().zip(&expected).enumerate() {
+                        assert!(
+                            (got - want.re).abs() < 1e-10,
+                            "dgemm {order:?} {ta:?} {tb:?} at {idx}: {got} != {}",
+                            want.re
+                        );
+                    }
+                }
+            }
+        }
+        assert_eq!(DGEMM_CALLS.load(Ordering::SeqCst), 0);
+        assert_eq!(ZGEMM_CALLS.load(Ordering::SeqCst), 0);
+
+        // beta == 0 overwrites C without reading it.
+        let a = [1.0f64; 4];
+        let mut c = [f64::NAN; 4];
+        cblas_dgemm_64(
+            CblasColMajor,
+            CblasNoTrans,
+            CblasNoTrans,
+            2,
+            2,
+            2,
+            1.0,
+            a.as_ptr(),
+            2,
+            a.as_ptr(),
+            2,
+            0.0,
+            c.as_mut_ptr(),
+            2,
+        );
+        assert_eq!(c, [2.0; 4]);
+
+        // Above the crossover, and for invalid leading dimensions, the provider is used.
+        let big = vec![0.0f64; 9 * 9];
+        let mut big_c = big.clone();
+        cblas_dgemm(
+            CblasColMajor,
+            CblasNoTrans,
+            CblasNoTrans,
+            9,
+            9,
+            9,
+            1.0,
+            big.as_ptr(),
+            9,
+            big.as_ptr(),
+            9,
+            0.0,
+            big_c.as_mut_ptr(),
+            9,
+        );
+        assert_eq!(DGEMM_CALLS.load(Ordering::SeqCst), 1);
+        cblas_dgemm(
+            CblasColMajor,
+            CblasNoTrans,
+            CblasNoTrans,
+            2,
+            2,
+            2,
+            1.0,
+            a.as_ptr(),
+            1,
+            a.as_ptr(),
+            2,
+            0.0,
+            c.as_mut_ptr(),
+            2,
+        );
+        assert_eq!(DGEMM_CALLS.load(Ordering::SeqCst), 2);
+
+        assert_eq!(
+            cblas_inject_set_small_gemm_max_dim(0),
+            CBLAS_INJECT_STATUS_OK
+        );
+        cblas_dgemm(
+            CblasColMajor,
+            CblasNoTrans,
+            CblasNoTrans,
+            2,
+            2,
+            2,
+            1.0,
+            a.as_ptr(),
+            2,
+            a.as_ptr(),
+            2,
+            0.0,
+            c.as_mut_ptr(),
+            2,
+        );
+        assert_eq!(DGEMM_CALLS.load(Ordering::SeqCst), 3);
+    }
+}
@@ -0,0 +1,210 @@
+#![cfg(not(feature = "openblas"))]
+
+use std::ffi::{c_char, c_void, CStr};
+use std::ptr;
+
+use cblas_inject::{
+    cblas_daxpy, cblas_dgemm, cblas_dgemm_64, cblas_dtrmv_64, cblas_inject_register_dgemm_lp64,
+    cblas_inject_register_dtrmv_lp64, cblas_inject_set_small_gemm_max_dim,
+    cblas_inject_set_stats_mode, cblas_inject_stats_mode, cblas_inject_stats_reset,
+    cblas_inject_stats_snapshot, cblas_zgemm_batch_strided, BlasInt32, CblasColMajor,
+    CblasInjectRoutineStats, CblasNoTrans, CblasNonUnit, CblasRowMajor, CblasUpper,
+    CBLAS_INJECT_STATS_COUNTS, CBLAS_INJECT_STATS_OFF, CBLAS_INJECT_STATS_TIMING,
+    CBLAS_INJECT_STATUS_INVALID_ARGUMENT, CBLAS_INJECT_STATUS_OK,
+};
+use num_complex::Complex64;
+
+unsafe extern "C" fn mock_dgemm_lp64(
+    _transa: *const c_char,
+    _transb: *const c_char,
+    _m: *const BlasInt32,
+    _n: *const BlasInt32,
+    _k: *const BlasInt32,
+    _alpha: *const f64,
+    _a: *const f64,
+    _lda: *const BlasInt32,
+    _b: *const f64,
+    _ldb: *const BlasInt32,
+    _beta: *const f64,
+    _c: *mut f64,
+    _ldc: *const BlasInt32,
+) {
+}
+
+unsafe extern "C" fn mock_dtrmv_lp64(
+    _uplo: *const c_char,
+    _trans: *const c_char,
+    _diag: *const c_char,
+    _n: *const BlasInt32,
+    _a: *const f64,
+    _lda: *const BlasInt32,
+    _x: *mut f64,
+    _incx: *const BlasInt32,
+) {
+}
+
+fn snapshot() -> Vec<CblasInjectRoutineStats> {
+    unsafe {
+        let len = cblas_inject_stats_snapshot(ptr::null_mut(), 0);
+        let mut out = Vec::with_capacity(len as usize);
+        let written = cblas_inject_stats_snapshot(out.as_mut_ptr(), len);
+        assert_eq!(written, len);
+        out.set_len(len as usize);
+        out
+    }
+}
+
+fn routine(stats: &[CblasInjectRoutineStats], name: &str) -> CblasInjectRoutineStats {
+    *stats
+        .iter()
+        .find(|s| unsafe { CStr::from_ptr(s.name) }.to_str() == Ok(name))
+        .unwrap()
+}
+
+fn dgemm(m: i32, n: i32, k: i32) {
+    let a = vec![0.0f64; 1024];
+    let mut c = vec![0.0f64; 1024];
+    unsafe {
+        cblas_dgemm(
+            CblasRowMajor,
+            CblasNoTrans,
+            CblasNoTrans,
+            m,
+            n,
+            k,
+            1.0,
+            a.as_ptr(),
+            k.max(1),
+            a.as_ptr(),
+            n.max(1),
+            0.0,
+            c.as_mut_ptr(),
+            n.max(1),
+        );
+    }
+}
+
+// The statistics mode is process-global, so everything runs in one test.
+#[test]
+fn stats_count_calls_flops_and_shapes() {
+    unsafe {
+        assert_eq!(
+            cblas_inject_register_dgemm_lp64(mock_dgemm_lp64 as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(
+            cblas_inject_register_dtrmv_lp64(mock_dtrmv_lp64 as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+    }
+    assert_eq!(cblas_inject_stats_mode(), CBLAS_INJECT_STATS_OFF);
+    assert_eq!(
+        cblas_inject_set_stats_mode(3),
+        CBLAS_INJECT_STATUS_INVALID_ARGUMENT
+    );
+
+    // Nothing is recorded while disabled.
+    dgemm(4, 4, 4);
+    assert_eq!(routine(&snapshot(), "dgemm").calls, 0);
+
+    assert_eq!(
+        cblas_inject_set_stats_mode(CBLAS_INJECT_STATS_COUNTS),
+        CBLAS_INJECT_STATUS_OK
+    );
+    dgemm(2, 3, 4);
+    dgemm(16, 16, 1);
+    let a = [0.0f64; 4];
+    let mut c = [0.0f64; 4];
+    unsafe {
+        cblas_dgemm_64(
+            CblasColMajor,
+            CblasNoTrans,
+            CblasNoTrans,
+            1,
+            1,
+            1,
+            1.0,
+            a.as_ptr(),
+            1,
+            a.as_ptr(),
+            1,
+            0.0,
+            c.as_mut_ptr(),
+            1,
+        );
+    }
+    let d = routine(&snapshot(), "dgemm");
+    assert_eq!(d.calls, 3);
+    assert_eq!(d.flops, 2 * (2 * 3 * 4 + 16 * 16 + 1));
+    // Largest dimensions 4, 16 and 1 land in buckets 3, 5 and 1.
+    assert_eq!(
+        (d.shape_hist[1], d.shape_hist[3], d.shape_hist[5]),
+        (1, 1, 1)
+    );
+    assert_eq!(d.time_hist.iter().sum::<u64>(), 0);
+
+    // Batched items are counted under the element routine. No zgemm is
+    // registered, so the empty items take the native path.
+    let alpha = Complex64::new(1.0, 0.0);
+    let z = [Complex64::new(0.0, 0.0); 8];
+    let mut zc = z;
+    unsafe {
+        cblas_inject_set_small_gemm_max_dim(4);
+        cblas_inject_set_stats_mode(CBLAS_INJECT_STATS_TIMING);
+        cblas_zgemm_batch_strided(
+            CblasColMajor,
+            CblasNoTrans,
+            CblasNoTrans,
+            0,
+            2,
+            2,
+            &alpha,
+            z.as_ptr(),
+            1,
+            0,
+            z.as_ptr(),
+            2,
+            0,
+            &alpha,
+            zc.as_mut_ptr(),
+            1,
+            1,
+            3,
+        );
+    }
+    cblas_inject_set_small_gemm_max_dim(0);
+    let zs = routine(&snapshot(), "zgemm");
+    assert_eq!((zs.calls, zs.flops), (3, 0));
+    assert_eq!(zs.time_hist.iter().sum::<u64>(), 3);
+
+    // Level 1 and the other Level 2 routines are counted too: a native daxpy
+    // and a narrowed dtrmv_64.
+    let x = [1.0f64; 9];
+    let mut y = [0.0f64; 9];
+    unsafe {
+        cblas_daxpy(5, 2.0, x.as_ptr(), 1, y.as_mut_ptr(), 1);
+        cblas_dtrmv_64(
+            CblasColMajor,
+            CblasUpper,
+            CblasNoTrans,
+            CblasNonUnit,
+            3,
+            x.as_ptr(),
+            3,
+            y.as_mut_ptr(),
+            1,
+        );
+    }
+    let stats = snapshot();
+    let (axpy, trmv) = (routine(&stats, "daxpy"), routine(&stats, "dtrmv"));
+    assert_eq!((axpy.calls, axpy.flops), (1, 2 * 5));
+    assert_eq!((trmv.calls, trmv.flops), (1, 3 * 3));
+    assert_eq!(trmv.shape_hist[2], 1);
+
+    cblas_inject_stats_reset();
+    assert!(snapshot().iter().all(|s| s.calls == 0 && s.flops == 0));
+    assert_eq!(
+        cblas_inject_set_stats_mode(CBLAS_INJECT_STATS_OFF),
+        CBLAS_INJECT_STATUS_OK
+    );
+}
@@ -0,0 +1,208 @@
+#![cfg(not(feature = "openblas"))]
+
+use std::cell::Cell;
+use std::ffi::{c_char, c_int, c_void};
+use std::sync::atomic::{AtomicI32, AtomicUsize, Ordering};
+
+use cblas_inject::{
+    cblas_dgemm, cblas_dgemm_batch_strided, cblas_inject_begin_single_threaded,
+    cblas_inject_end_single_threaded, cblas_inject_nested_guard, cblas_inject_num_threads,
+    cblas_inject_register_dgemm_lp64, cblas_inject_register_get_num_threads,
+    cblas_inject_register_parallel_probe, cblas_inject_register_set_num_threads,
+    cblas_inject_set_nested_guard, cblas_inject_set_num_threads, cblas_inject_set_worker_threads,
+    BlasInt32, CblasColMajor, CblasNoTrans, CBLAS_INJECT_STATUS_ALREADY_REGISTERED,
+    CBLAS_INJECT_STATUS_INVALID_ARGUMENT, CBLAS_INJECT_STATUS_NOT_REGISTERED,
+    CBLAS_INJECT_STATUS_OK,
+};
+
+/// The mock provider's global thread count.
+static PROVIDER_THREADS: AtomicI32 = AtomicI32::new(8);
+/// Largest thread count any dgemm call ran with since the last reset.
+static MAX_SEEN: AtomicI32 = AtomicI32::new(0);
+static DGEMM_CALLS: AtomicUsize = AtomicUsize::new(0);
+
+thread_local! {
+    static IN_PARALLEL: Cell<bool> = const { Cell::new(false) };
+}
+
+unsafe extern "C" fn mock_set_num_threads(threads: c_int) {
+    PROVIDER_THREADS.store(threads, Ordering::SeqCst);
+}
+
+unsafe extern "C" fn mock_get_num_threads() -> c_int {
+    PROVIDER_THREADS.load(Ordering::SeqCst)
+}
+
+unsafe extern "C" fn mock_in_parallel() -> c_int {
+    c_int::from(IN_PARALLEL.with(Cell::get))
+}
+
+unsafe extern "C" fn mock_dgemm(
+    _transa: *const c_char,
+    _transb: *const c_char,
+    _m: *const BlasInt32,
+    _n: *const BlasInt32,
+    _k: *const BlasInt32,
+    _alpha: *const f64,
+    _a: *const f64,
+    _lda: *const BlasInt32,
+    _b: *const f64,
+    _ldb: *const BlasInt32,
+    _beta: *const f64,
+    _c: *mut f64,
+    _ldc: *const BlasInt32,
+) {
+    DGEMM_CALLS.fetch_add(1, Ordering::SeqCst);
+    MAX_SEEN.fetch_max(PROVIDER_THREADS.load(Ordering::SeqCst), Ordering::SeqCst);
+}
+
+fn dgemm() {
+    let (a, b, mut c) = ([1.0; 4], [1.0; 4], [0.0; 4]);
+    unsafe {
+        cblas_dgemm(
+            CblasColMajor,
+            CblasNoTrans,
+            CblasNoTrans,
+            2,
+            2,
+            2,
+            1.0,
+            a.as_ptr(),
+            2,
+            b.as_ptr(),
+            2,
+            0.0,
+            c.as_mut_ptr(),
+            2,
+        );
+    }
+}
+
+fn threads() -> i32 {
+    PROVIDER_THREADS.load(Ordering::SeqCst)
+}
+
+// Thread controls are process-global, so everything runs in one test.
+#[test]
+fn thread_controls_and_nested_guard() {
+    // Nothing to control yet.
+    assert_eq!(
+        cblas_inject_set_num_threads(2),
+        CBLAS_INJECT_STATUS_NOT_REGISTERED
+    );
+    assert_eq!(
+        cblas_inject_begin_single_threaded(),
+        CBLAS_INJECT_STATUS_NOT_REGISTERED
+    );
+    assert_eq!(
+        cblas_inject_end_single_threaded(),
+        CBLAS_INJECT_STATUS_INVALID_ARGUMENT
+    );
+    assert_eq!(cblas_inject_num_threads(), 0);
+
+    unsafe {
+        assert_eq!(
+            cblas_inject_register_set_num_threads(mock_set_num_threads as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(
+            cblas_inject_register_set_num_threads(mock_set_num_threads as *const c_void),
+            CBLAS_INJECT_STATUS_ALREADY_REGISTERED
+        );
+        assert_eq!(
+            cblas_inject_register_get_num_threads(mock_get_num_threads as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(
+            cblas_inject_register_parallel_probe(mock_in_parallel as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(
+            cblas_inject_register_dgemm_lp64(mock_dgemm as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+    }
+    assert_eq!(cblas_inject_num_threads(), 8);
+    assert_eq!(
+        cblas_inject_set_num_threads(0),
+        CBLAS_INJECT_STATUS_INVALID_ARGUMENT
+    );
+    assert_eq!(cblas_inject_set_num_threads(4), CBLAS_INJECT_STATUS_OK);
+    assert_eq!(threads(), 4);
+
+    // Regions nest, and a count set inside one applies once it ends.
+    assert_eq!(cblas_inject_begin_single_threaded(), CBLAS_INJECT_STATUS_OK);
+    assert_eq!(threads(), 1);
+    assert_eq!(cblas_inject_begin_single_threaded(), CBLAS_INJECT_STATUS_OK);
+    assert_eq!(cblas_inject_end_single_threaded(), CBLAS_INJECT_STATUS_OK);
+    assert_eq!(threads(), 1);
+    assert_eq!(cblas_inject_set_num_threads(6), CBLAS_INJECT_STATUS_OK);
+    assert_eq!(threads(), 1);
+
+    // With the global setter, the last thread to leave restores the count.
+    std::thread::spawn(|| {
+        assert_eq!(cblas_inject_begin_single_threaded(), CBLAS_INJECT_STATUS_OK);
+        assert_eq!(cblas_inject_end_single_threaded(), CBLAS_INJECT_STATUS_OK);
+    })
+    .join()
+    .unwrap();
+    assert_eq!(threads(), 1);
+    assert_eq!(cblas_inject_end_single_threaded(), CBLAS_INJECT_STATUS_OK);
+    assert_eq!(threads(), 6);
+    assert_eq!(
+        cblas_inject_end_single_threaded(),
+        CBLAS_INJECT_STATUS_INVALID_ARGUMENT
+    );
+
+    // The probe only matters with the nested guard on.
+    IN_PARALLEL.with(|p| p.set(true));
+    dgemm();
+    assert_eq!(MAX_SEEN.swap(0, Ordering::SeqCst), 6);
+    assert_eq!(cblas_inject_set_nested_guard(1), CBLAS_INJECT_STATUS_OK);
+    assert_eq!(cblas_inject_nested_guard(), 1);
+    dgemm();
+    assert_eq!(MAX_SEEN.swap(0, Ordering::SeqCst), 1);
+    assert_eq!(threads(), 6);
+    IN_PARALLEL.with(|p| p.set(false));
+    dgemm();
+    assert_eq!(MAX_SEEN.swap(0, Ordering::SeqCst), 6);
+
+    // Items of a batch spread over the worker pool run single-threaded.
+    assert_eq!(cblas_inject_set_worker_threads(4), CBLAS_INJECT_STATUS_OK);
+    let batch = 64;
+    let (a, b, mut c) = (
+        vec![1.0; 4 * batch],
+        vec![1.0; 4 * batch],
+        vec![0.0; 4 * batch],
+    );
+    let before = DGEMM_CALLS.load(Ordering::SeqCst);
+    for guard in [1, 0] {
+        assert_eq!(cblas_inject_set_nested_guard(guard), CBLAS_INJECT_STATUS_OK);
+        unsafe {
+            cblas_dgemm_batch_strided(
+                CblasColMajor,
+                CblasNoTrans,
+                CblasNoTrans,
+                2,
+                2,
+                2,
+                1.0,
+                a.as_ptr(),
+                2,
+                4,
+                b.as_ptr(),
+                2,
+                4,
+                0.0,
+                c.as_mut_ptr(),
+                2,
+                4,
+                batch as i32,
+            );
+        }
+        let want = if guard == 1 { 1 } else { 6 };
+        assert_eq!(MAX_SEEN.swap(0, Ordering::SeqCst), want, "guard {guard}");
+        assert_eq!(threads(), 6);
+    }
+    assert_eq!(DGEMM_CALLS.load(Ordering::SeqCst), before + 2 * batch);
+}
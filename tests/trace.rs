@@ -0,0 +1,236 @@
+#![cfg(not(feature = "openblas"))]
+
+use std::ffi::{c_char, c_void, CString};
+use std::mem;
+use std::ptr;
+
+use cblas_inject::{
+    cblas_daxpy, cblas_dgemm, cblas_dgemm_64, cblas_dtrsm, cblas_inject_register_dgemm_lp64,
+    cblas_inject_register_dtrsm_ilp64, cblas_inject_set_small_gemm_max_dim,
+    cblas_inject_trace_active, cblas_inject_trace_start, cblas_inject_trace_stop, BlasInt32,
+    BlasInt64, CblasColMajor, CblasInjectTraceHeader, CblasInjectTraceRecord, CblasLeft,
+    CblasNoTrans, CblasNonUnit, CblasRowMajor, CblasTrans, CblasUpper,
+    CBLAS_INJECT_STATUS_IO_ERROR, CBLAS_INJECT_STATUS_NULL_POINTER, CBLAS_INJECT_STATUS_OK,
+    CBLAS_INJECT_TRACE_MAGIC, CBLAS_INJECT_TRACE_NAME_LEN, CBLAS_INJECT_TRACE_PATH_LP64,
+    CBLAS_INJECT_TRACE_PATH_NARROWED, CBLAS_INJECT_TRACE_PATH_NATIVE,
+    CBLAS_INJECT_TRACE_PATH_WIDENED, CBLAS_INJECT_TRACE_VERSION,
+};
+
+unsafe extern "C" fn mock_dgemm_lp64(
+    _transa: *const c_char,
+    _transb: *const c_char,
+    _m: *const BlasInt32,
+    _n: *const BlasInt32,
+    _k: *const BlasInt32,
+    _alpha: *const f64,
+    _a: *const f64,
+    _lda: *const BlasInt32,
+    _b: *const f64,
+    _ldb: *const BlasInt32,
+    _beta: *const f64,
+    _c: *mut f64,
+    _ldc: *const BlasInt32,
+) {
+}
+
+unsafe extern "C" fn mock_dtrsm_ilp64(
+    _side: *const c_char,
+    _uplo: *const c_char,
+    _transa: *const c_char,
+    _diag: *const c_char,
+    _m: *const BlasInt64,
+    _n: *const BlasInt64,
+    _alpha: *const f64,
+    _a: *const f64,
+    _lda: *const BlasInt64,
+    _b: *mut f64,
+    _ldb: *const BlasInt64,
+) {
+}
+
+fn dgemm(order: cblas_inject::CBLAS_ORDER, m: i32, n: i32, k: i32, ld: i32) {
+    let a = [0.0f64; 64];
+    let mut c = [0.0f64; 64];
+    unsafe {
+        cblas_dgemm(
+            order,
+            CblasTrans,
+            CblasNoTrans,
+            m,
+            n,
+            k,
+            1.0,
+            a.as_ptr(),
+            ld,
+            a.as_ptr(),
+            ld,
+            0.0,
+            c.as_mut_ptr(),
+            ld,
+        );
+    }
+}
+
+fn read_trace(path: &std::path::Path) -> (Vec<String>, Vec<CblasInjectTraceRecord>) {
+    let bytes = std::fs::read(path).unwrap();
+    let header_len = mem::size_of::<CblasInjectTraceHeader>();
+    let header: CblasInjectTraceHeader = unsafe { ptr::read_unaligned(bytes.as_ptr().cast()) };
+    assert_eq!(header.magic, CBLAS_INJECT_TRACE_MAGIC);
+    assert_eq!(header.version, CBLAS_INJECT_TRACE_VERSION);
+    assert_eq!(
+        header.record_size as usize,
+        mem::size_of::<CblasInjectTraceRecord>()
+    );
+    assert_eq!(header.name_len as usize, CBLAS_INJECT_TRACE_NAME_LEN);
+
+    let names_len = header.routine_count as usize * CBLAS_INJECT_TRACE_NAME_LEN;
+    let names = bytes[header_len..header_len + names_len]
+        .chunks(CBLAS_INJECT_TRACE_NAME_LEN)
+        .map(|s| {
+            let end = s.iter().position(|&b| b == 0).unwrap();
+            String::from_utf8(s[..end].to_vec()).unwrap()
+        })
+        .collect();
+    let body = &bytes[header_len + names_len..];
+    assert_eq!(body.len() % header.record_size as usize, 0);
+    let records = body
+        .chunks(header.record_size as usize)
+        .map(|r| unsafe { ptr::read_unaligned(r.as_ptr().cast()) })
+        .collect();
+    (names, records)
+}
+
+// Tracing is process-global, so everything runs in one test.
+#[test]
+fn trace_records_calls_flags_and_paths() {
+    unsafe {
+        assert_eq!(
+            cblas_inject_register_dgemm_lp64(mock_dgemm_lp64 as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(
+            cblas_inject_register_dtrsm_ilp64(mock_dtrsm_ilp64 as *const c_void),
+            CBLAS_INJECT_STATUS_OK
+        );
+        assert_eq!(
+            cblas_inject_trace_start(ptr::null()),
+            CBLAS_INJECT_STATUS_NULL_POINTER
+        );
+        let missing = CString::new("/nonexistent-dir/trace.bin").unwrap();
+        assert_eq!(
+            cblas_inject_trace_start(missing.as_ptr()),
+            CBLAS_INJECT_STATUS_IO_ERROR
+        );
+    }
+    assert_eq!(cblas_inject_trace_active(), 0);
+    cblas_inject_set_small_gemm_max_dim(0);
+
+    // Nothing is recorded while no trace is active.
+    dgemm(CblasColMajor, 8, 8, 8, 8);
+
+    let path = std::env::temp_dir().join(format!("cblas_inject_trace_{}.bin", std::process::id()));
+    let c_path = CString::new(path.to_str().unwrap()).unwrap();
+    unsafe {
+        assert_eq!(
+            cblas_inject_trace_start(c_path.as_ptr()),
+            CBLAS_INJECT_STATUS_OK
+        );
+    }
+    assert_eq!(cblas_inject_trace_active(), 1);
+
+    dgemm(CblasRowMajor, 2, 3, 4, 5);
+    cblas_inject_set_small_gemm_max_dim(4);
+    dgemm(CblasColMajor, 2, 2, 2, 2);
+    cblas_inject_set_small_gemm_max_dim(0);
+    let a = [0.0f64; 4];
+    let mut c = [0.0f64; 4];
+    unsafe {
+        cblas_dgemm_64(
+            CblasColMajor,
+            CblasNoTrans,
+            CblasNoTrans,
+            1,
+            1,
+            1,
+            1.0,
+            a.as_ptr(),
+            1,
+            a.as_ptr(),
+            1,
+            0.0,
+            c.as_mut_ptr(),
+            1,
+        );
+    }
+    // Level 1 calls are recorded too; this one runs natively.
+    let mut y = [0.0f64; 4];
+    unsafe { cblas_daxpy(2, 1.0, a.as_ptr(), 1, y.as_mut_ptr(), 2) };
+    // A second thread's buffer is drained by the stop.
+    std::thread::spawn(|| {
+        let a = [0.0f64; 4];
+        let mut b = [0.0f64; 4];
+        unsafe {
+            cblas_dtrsm(
+                CblasColMajor,
+                CblasLeft,
+                CblasUpper,
+                CblasNoTrans,
+                CblasNonUnit,
+                2,
+                1,
+                1.0,
+                a.as_ptr(),
+                2,
+                b.as_mut_ptr(),
+                2,
+            );
+        }
+    })
+    .join()
+    .unwrap();
+
+    assert_eq!(cblas_inject_trace_stop(), CBLAS_INJECT_STATUS_OK);
+    assert_eq!(cblas_inject_trace_active(), 0);
+    dgemm(CblasColMajor, 8, 8, 8, 8);
+
+    let (names, mut records) = read_trace(&path);
+    std::fs::remove_file(&path).unwrap();
+    records.sort_by_key(|r| r.timestamp_ns);
+    assert_eq!(records.len(), 5);
+    let routines: Vec<&str> = records
+        .iter()
+        .map(|r| names[r.routine as usize].as_str())
+        .collect();
+    assert_eq!(routines, ["dgemm", "dgemm", "dgemm", "daxpy", "dtrsm"]);
+
+    // The row-major call is recorded as passed, before the swap.
+    let r = records[0];
+    assert_eq!(r.path, CBLAS_INJECT_TRACE_PATH_LP64);
+    assert_eq!(r.order, CblasRowMajor as u8);
+    assert_eq!(r.flags, [CblasTrans as u8, CblasNoTrans as u8, 0, 0]);
+    assert_eq!((r.dims, r.lds), ([2, 3, 4, 0], [5, 5, 5]));
+
+    assert_eq!(records[1].path, CBLAS_INJECT_TRACE_PATH_NATIVE);
+    assert_eq!(records[2].path, CBLAS_INJECT_TRACE_PATH_NARROWED);
+
+    let v = records[3];
+    assert_eq!(
+        (v.path, v.order, v.flags),
+        (CBLAS_INJECT_TRACE_PATH_NATIVE, 0, [0; 4])
+    );
+    assert_eq!((v.dims, v.lds), ([2, 0, 0, 0], [1, 2, 0]));
+
+    let t = records[4];
+    assert_eq!(t.path, CBLAS_INJECT_TRACE_PATH_WIDENED);
+    assert_eq!(
+        t.flags,
+        [
+            CblasLeft as u8,
+            CblasUpper as u8,
+            CblasNoTrans as u8,
+            CblasNonUnit as u8
+        ]
+    );
+    assert_eq!((t.dims, t.lds), ([2, 1, 0, 0], [2, 2, 0]));
+    assert_ne!(t.thread, r.thread);
+}